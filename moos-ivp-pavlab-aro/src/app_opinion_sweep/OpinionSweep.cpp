@@ -0,0 +1,274 @@
+/************************************************************/
+/*    NAME: agent                                           */
+/*    ORGN: MIT, Cambridge MA                               */
+/*    FILE: OpinionSweep.cpp                                */
+/*    DATE: October 19th, 2026                              */
+/************************************************************/
+
+#include <iostream>
+#include <thread>
+#include <random>
+#include "MBUtils.h"
+#include "OpinionDynamics.h"
+#include "OpinionSweep.h"
+
+using namespace std;
+
+//--------------------------------------------------------
+// Constructor
+
+OpinionSweep::OpinionSweep()
+{
+  m_agents  = 10;
+  m_steps   = 600;
+  m_threads = thread::hardware_concurrency();
+  m_seed    = 1;
+  m_dt      = 0.1;
+  m_opinion_thresh = 0.1;
+  m_topology = "all";
+
+  // The defaults of OpManagerEngine
+  m_fixed["tau_u"]    = 10.0;
+  m_fixed["u_min"]    = 0.5;
+  m_fixed["u_max"]    = 1.5;
+  m_fixed["u_th"]     = 0.1;
+  m_fixed["hill"]     = 2.0;
+  m_fixed["int_gain"] = 1.0;
+
+  m_points = 0;
+}
+
+//--------------------------------------------------------
+// Procedure: setParam()
+
+bool OpinionSweep::setParam(string param, string value)
+{
+  if(param == "file")
+    return(setNonWhiteVarOnString(m_file, value));
+  if(param == "sweep")
+    return(addSweep(value));
+  if(param == "input")
+    return(addInput(value));
+  if(param == "topology") {
+    value = tolower(value);
+    if((value != "all") && (value != "ring"))
+      return(false);
+    m_topology = value;
+    return(true);
+  }
+  if(param == "thresh")
+    return(setNonNegDoubleOnString(m_opinion_thresh, value));
+  if(param == "dt")
+    return(setPosDoubleOnString(m_dt, value));
+  if(param == "agents")
+    return(setUIntOnString(m_agents, value) && (m_agents > 0));
+  if(param == "steps")
+    return(setUIntOnString(m_steps, value));
+  if(param == "threads")
+    return(setUIntOnString(m_threads, value) && (m_threads > 0));
+  if(param == "seed")
+    return(setUIntOnString(m_seed, value));
+
+  // A fixed value for a parameter that is not swept, tau_u=5
+  if(validParam(param))
+    return(setDoubleOnString(m_fixed[param], value));
+
+  return(false);
+}
+
+//--------------------------------------------------------
+// Procedure: validParam()
+
+bool OpinionSweep::validParam(string param) const
+{
+  return(m_fixed.count(param) > 0);
+}
+
+//--------------------------------------------------------
+// Procedure: addSweep()
+//   Example: tau_u:1:20:5
+
+bool OpinionSweep::addSweep(string value)
+{
+  vector<string> svector = parseString(value, ':');
+  if(svector.size() != 4)
+    return(false);
+
+  SweepAxis axis;
+  axis.param = tolower(svector[0]);
+  if(!validParam(axis.param))
+    return(false);
+  if(!setDoubleOnString(axis.lo, svector[1]) ||
+     !setDoubleOnString(axis.hi, svector[2]) ||
+     !setUIntOnString(axis.n, svector[3]) || (axis.n == 0))
+    return(false);
+
+  m_axes.push_back(axis);
+  return(true);
+}
+
+//--------------------------------------------------------
+// Procedure: addInput()
+//   Example: DANGER_LEVEL:80
+
+bool OpinionSweep::addInput(string value)
+{
+  string var = toupper(biteStringX(value, ':'));
+  double dval = 0;
+  if((var == "") || !setDoubleOnString(dval, value))
+    return(false);
+  m_inputs[var] = dval;
+  return(true);
+}
+
+//--------------------------------------------------------
+// Procedure: handle()
+
+bool OpinionSweep::handle()
+{
+  if(m_file == "") {
+    cout << "Please specify an .optn file. Exiting." << endl;
+    return(false);
+  }
+
+  string warn_msg;
+  if(!readOptionsFromFile(m_file, m_options, warn_msg)) {
+    cout << warn_msg << endl;
+    return(false);
+  }
+
+  m_points = 1;
+  for(unsigned int i=0; i<m_axes.size(); i++)
+    m_points *= m_axes[i].n;
+  m_results.assign(m_points, SweepResult());
+
+  // Each thread takes every nth point, each point is seeded on its
+  // own, so the results do not depend on the number of threads
+  unsigned int threads = m_threads;
+  if(threads > m_points)
+    threads = m_points;
+  if(threads <= 1)
+    runPoints(0, 1);
+  else {
+    vector<thread> workers;
+    for(unsigned int t=0; t<threads; t++)
+      workers.push_back(thread(&OpinionSweep::runPoints, this, t, threads));
+    for(unsigned int t=0; t<workers.size(); t++)
+      workers[t].join();
+  }
+
+  // Header, then one line per point
+  string line;
+  for(unsigned int i=0; i<m_axes.size(); i++)
+    line += m_axes[i].param + ",";
+  for(unsigned int j=0; j<m_options.size(); j++)
+    line += m_options[j].getOptionName() + ",";
+  line += "undecided,atten,decide_time";
+  cout << line << endl;
+
+  for(unsigned int p=0; p<m_points; p++) {
+    const SweepResult& result = m_results[p];
+    line = "";
+    for(unsigned int i=0; i<result.params.size(); i++)
+      line += doubleToStringX(result.params[i], 4) + ",";
+    for(unsigned int j=0; j<result.option_frac.size(); j++)
+      line += doubleToStringX(result.option_frac[j], 3) + ",";
+    line += doubleToStringX(result.undecided_frac, 3) + ",";
+    line += doubleToStringX(result.mean_atten, 3) + ",";
+    line += doubleToStringX(result.decide_time, 2);
+    cout << line << endl;
+  }
+  return(true);
+}
+
+//--------------------------------------------------------
+// Procedure: runPoints()
+
+void OpinionSweep::runPoints(unsigned int thread_ix, unsigned int threads)
+{
+  for(unsigned int p=thread_ix; p<m_points; p+=threads)
+    m_results[p] = runPoint(p);
+}
+
+//--------------------------------------------------------
+// Procedure: runPoint()
+//   Purpose: Run all agents from small random opinions for the
+//            given number of steps. All options are taken active.
+//            The decide time is the first time every agent holds
+//            the same strongest opinion above threshold, or -1.
+
+SweepResult OpinionSweep::runPoint(unsigned int point_ix)
+{
+  SweepResult result;
+  map<string, double> params = m_fixed;
+  unsigned int ix = point_ix;
+  for(unsigned int i=0; i<m_axes.size(); i++) {
+    const SweepAxis& axis = m_axes[i];
+    unsigned int k = ix % axis.n;
+    ix = ix / axis.n;
+    double val = axis.lo;
+    if(axis.n > 1)
+      val += (axis.hi - axis.lo) * k / (axis.n - 1);
+    params[axis.param] = val;
+    result.params.push_back(val);
+  }
+
+  OpinionDynamics dyn;
+  dyn.setTauU(params["tau_u"]);
+  dyn.setMinAtten(params["u_min"]);
+  dyn.setMaxAtten(params["u_max"]);
+  dyn.setUth(params["u_th"]);
+  dyn.setSatFunOrder(params["hill"]);
+  dyn.setNumIntGain(params["int_gain"]);
+  dyn.setOptions(m_options);
+  dyn.setAgents(m_agents);
+
+  if(m_topology == "ring") {
+    for(unsigned int i=0; i<m_agents; i++) {
+      dyn.setNeighbor(i, (i + 1) % m_agents);
+      dyn.setNeighbor(i, (i + m_agents - 1) % m_agents);
+    }
+  }
+  else
+    dyn.setAllNeighbors();
+
+  unsigned int no = m_options.size();
+  mt19937 rng(m_seed + point_ix);
+  uniform_real_distribution<double> dist(-0.01, 0.01);
+  for(unsigned int j=0; j<no; j++) {
+    double b = 0;
+    string var = m_options[j].getInputVar();
+    if(m_inputs.count(var))
+      b = m_options[j].computeInputB(m_inputs[var]);
+    for(unsigned int i=0; i<m_agents; i++) {
+      dyn.setInput(i, j, b);
+      dyn.setOpinion(i, j, dist(rng));
+    }
+  }
+
+  result.decide_time = -1;
+  for(unsigned int s=0; s<m_steps; s++) {
+    dyn.step(m_dt);
+    if(result.decide_time >= 0)
+      continue;
+    int first = dyn.getStrongestOption(0, m_opinion_thresh);
+    bool all_same = (first >= 0);
+    for(unsigned int i=1; (i<m_agents) && all_same; i++)
+      all_same = (dyn.getStrongestOption(i, m_opinion_thresh) == first);
+    if(all_same)
+      result.decide_time = (s + 1) * m_dt;
+  }
+
+  result.option_frac.assign(no, 0);
+  result.undecided_frac = 0;
+  result.mean_atten = 0;
+  for(unsigned int i=0; i<m_agents; i++) {
+    int best = dyn.getStrongestOption(i, m_opinion_thresh);
+    if(best >= 0)
+      result.option_frac[best] += 1.0 / m_agents;
+    else
+      result.undecided_frac += 1.0 / m_agents;
+    result.mean_atten += dyn.getAttention(i) / m_agents;
+  }
+  return(result);
+}
@@ -0,0 +1,73 @@
+/************************************************************/
+/*    NAME: agent                                           */
+/*    ORGN: MIT, Cambridge MA                               */
+/*    FILE: OpinionSweep.h                                  */
+/*    DATE: October 19th, 2026                              */
+/************************************************************/
+
+#ifndef OPINION_SWEEP_HEADER
+#define OPINION_SWEEP_HEADER
+
+#include <string>
+#include <vector>
+#include <map>
+#include "Option.h"
+
+// One swept parameter, n values evenly spaced from lo to hi
+struct SweepAxis {
+  std::string param;
+  double lo;
+  double hi;
+  unsigned int n;
+};
+
+// The outcome of one run at one point of the sweep
+struct SweepResult {
+  std::vector<double> params;
+  std::vector<double> option_frac;
+  double undecided_frac;
+  double mean_atten;
+  double decide_time;
+};
+
+class OpinionSweep
+{
+ public:
+  OpinionSweep();
+  ~OpinionSweep() {}
+
+  bool setParam(std::string param, std::string value);
+  bool handle();
+
+ protected:
+  bool addSweep(std::string value);
+  bool addInput(std::string value);
+  void runPoints(unsigned int thread_ix, unsigned int threads);
+  SweepResult runPoint(unsigned int point_ix);
+  bool validParam(std::string param) const;
+
+ protected: // Config vars
+  std::string  m_file;
+  unsigned int m_agents;
+  unsigned int m_steps;
+  unsigned int m_threads;
+  unsigned int m_seed;
+  double       m_dt;
+  double       m_opinion_thresh;
+  std::string  m_topology;
+
+  // Fixed values of parameters not swept
+  std::map<std::string, double> m_fixed;
+
+  // Raw input values, by input variable name
+  std::map<std::string, double> m_inputs;
+
+  std::vector<SweepAxis> m_axes;
+
+ protected: // State vars
+  std::vector<Option>      m_options;
+  unsigned int             m_points;
+  std::vector<SweepResult> m_results;
+};
+
+#endif
@@ -0,0 +1,92 @@
+/************************************************************/
+/*    NAME: agent                                           */
+/*    ORGN: MIT, Cambridge MA                               */
+/*    FILE: main.cpp (opinion_sweep)                        */
+/*    DATE: October 19th, 2026                              */
+/************************************************************/
+
+#include <string>
+#include <cstdlib>
+#include <iostream>
+#include "MBUtils.h"
+#include "OpinionSweep.h"
+
+using namespace std;
+
+void showHelpAndExit();
+
+//--------------------------------------------------------
+// Procedure: main
+
+int main(int argc, char *argv[])
+{
+  OpinionSweep sweep;
+
+  for(int i=1; i<argc; i++) {
+    string argi = argv[i];
+    bool handled = false;
+    if((argi=="-h") || (argi == "--help") || (argi=="-help"))
+      showHelpAndExit();
+    else if(strEnds(argi, ".optn"))
+      handled = sweep.setParam("file", argi);
+    else if(strBegins(argi, "--")) {
+      string param = biteStringX(argi, '=');
+      handled = sweep.setParam(param.substr(2), argi);
+    }
+    if(!handled) {
+      cout << "Unhandled command line argument: " << argv[i] << endl;
+      cout << "Use --help for usage. Exiting.   " << endl;
+      exit(1);
+    }
+  }
+
+  if(!sweep.handle())
+    exit(1);
+  exit(0);
+}
+
+//------------------------------------------------------------
+// Procedure: showHelpAndExit()
+
+void showHelpAndExit()
+{
+  cout << "Usage: " << endl;
+  cout << "  opinion_sweep file.optn [OPTIONS]                        " << endl;
+  cout << "                                                           " << endl;
+  cout << "Synopsis:                                                  " << endl;
+  cout << "  Runs a group of agents with the options of a             " << endl;
+  cout << "  pOpinionManager .optn file, offline, at every point of a " << endl;
+  cout << "  sweep of the attention and integration gains. Points run " << endl;
+  cout << "  in parallel. One CSV line per point: the fraction of     " << endl;
+  cout << "  agents on each option, undecided, mean attention, and    " << endl;
+  cout << "  the time all agents first agreed (-1 if never).          " << endl;
+  cout << "                                                           " << endl;
+  cout << "Options:                                                   " << endl;
+  cout << "  -h,--help             Displays this help message         " << endl;
+  cout << "  --sweep=<p>:<lo>:<hi>:<n>                                " << endl;
+  cout << "                        Sweep param p over n values. May   " << endl;
+  cout << "                        be given more than once. Params:   " << endl;
+  cout << "                        tau_u, u_min, u_max, u_th, hill,   " << endl;
+  cout << "                        int_gain                           " << endl;
+  cout << "  --<p>=<val>           Fixed value of a param not swept   " << endl;
+  cout << "  --input=<var>:<val>   Raw value of an option input var   " << endl;
+  cout << "  --agents=<n>          Number of agents (default 10)      " << endl;
+  cout << "  --steps=<n>           Steps per run (default 600)        " << endl;
+  cout << "  --dt=<secs>           Step size (default 0.1)            " << endl;
+  cout << "  --topology=all|ring   Who hears whom (default all)       " << endl;
+  cout << "  --thresh=<val>        Opinion threshold (default 0.1)    " << endl;
+  cout << "  --threads=<n>         Worker threads (default all cores) " << endl;
+  cout << "  --seed=<n>            Random seed of initial opinions    " << endl;
+  cout << "                                                           " << endl;
+  cout << "Examples:                                                  " << endl;
+  cout << "  opinion_sweep dummy.optn --sweep=tau_u:1:20:20           " << endl;
+  cout << "  opinion_sweep dummy.optn --sweep=u_th:0.05:0.5:10        " << endl;
+  cout << "                --sweep=u_max:1:3:5 --agents=50            " << endl;
+  cout << "                                                           " << endl;
+  cout << "Further Notes:                                             " << endl;
+  cout << "  (1) All options are taken active, active conditions in   " << endl;
+  cout << "      the .optn file are ignored.                          " << endl;
+  cout << "  (2) Results do not depend on the number of threads.      " << endl;
+  cout << endl;
+  exit(0);
+}
@@ -26,8 +26,11 @@ EsriBathyGrid::EsriBathyGrid() {
   m_no_data_value = 0.0;
   m_default_variance = 0.0;
 
-  generateVertices();
-  generateEdges();
+  m_obs_mask_valid = false;
+  m_obs_depth_threshold = 0.0;
+  m_obs_var_threshold = 0.0;
+
+  generateGraph();
 }
 
 //---------------------------------------------------------
@@ -51,8 +54,11 @@ EsriBathyGrid::EsriBathyGrid(XYConvexGrid new_grid, double y_origin_lat,
   m_old_grid = new_grid;
   m_cell_size = m_grid.getCellSize();
 
-  generateVertices();
-  generateEdges();
+  m_obs_mask_valid = false;
+  m_obs_depth_threshold = 0.0;
+  m_obs_var_threshold = 0.0;
+
+  generateGraph();
 }
 
 //---------------------------------------------------------
@@ -260,12 +266,27 @@ bool EsriBathyGrid::loadGridFromFile(std::string filename, double x_origin_lon,
   return true;
 }
 
+//---------------------------------------------------------
+// Procedure: generateGraph
+//            builds the vertices, edges and adjacency of the cell
+//            graph, unless it was already built for this grid layout
+void EsriBathyGrid::generateGraph() {
+
+  string config = m_grid.getConfigStr();
+  if ((config == m_graph_config) && (m_V.size() == m_grid.size()))
+    return;
+
+  generateVertices();
+  generateEdges();
+  m_graph_config = config;
+}
+
 //---------------------------------------------------------
 // Procedure: generateVertices
 //            modifies m_V to contain a map of ids to xy
-//            modifies m_reverseV to contain a map of xy to ids
 void EsriBathyGrid::generateVertices() {
 
+  m_V.clear();
   unsigned int cell_count = m_grid.size();
   for (int idx = 0; idx < cell_count; idx++) {
 
@@ -279,7 +300,6 @@ void EsriBathyGrid::generateVertices() {
     coords.push_back(y);
 
     m_V[idx] = coords;
-    m_reverseV[coords] = idx;
   }
 }
 
@@ -287,8 +307,14 @@ void EsriBathyGrid::generateVertices() {
 // Procedure: generateEdges
 //            modifies m_E to include all connections between grid cells
 //            m_E takes the form of a vector of index pairs
+//            modifies m_adj_start and m_adj to hold the neighbors
+//            of each cell in CSR form (see header)
 void EsriBathyGrid::generateEdges() {
 
+  m_E.clear();
+  m_adj.clear();
+  m_adj_start.assign(1, 0);
+
   for (int idx = 0; idx < m_grid.size(); idx++) {
 
     // get neighbors
@@ -298,7 +324,6 @@ void EsriBathyGrid::generateEdges() {
 
     double x_vals[] = {0, 0, 0, 0, 0, 0, 0, 0};
     double y_vals[] = {0, 0, 0, 0, 0, 0, 0, 0};
-    int i_vals[] = {0, 0, 0, 0, 0, 0, 0, 0};
 
     x_vals[7] = curr_x - m_cell_size; //  xoo
     y_vals[7] = curr_y + m_cell_size; //  o o
@@ -326,34 +351,19 @@ void EsriBathyGrid::generateEdges() {
 
     for (int i = 0; i < 8; i++) {
 
-      // convert to index
-      vector<double> tmp_coords;
-      tmp_coords.push_back(x_vals[i]);
-      tmp_coords.push_back(y_vals[i]);
+      // convert to index, computed directly from x,y
+      int nbr = m_grid.getCellIX(x_vals[i], y_vals[i]);
+      if ((nbr < 0) || (nbr == idx))
+        continue;
 
-      if (m_reverseV.count(tmp_coords)) {
-        i_vals[i] = m_reverseV.at(tmp_coords);
+      m_adj.push_back(nbr);
 
-        // if not in edges, add edge
-        pair<size_t, size_t> pair_a(idx, i_vals[i]);
-        pair<size_t, size_t> pair_b(i_vals[i], idx);
-
-        bool in_vector = false;
-
-        for (vector<pair<size_t, size_t> >::reverse_iterator p = m_E.rbegin();
-             p != m_E.rend(); ++p) {
-          if (*p == pair_a || *p == pair_b)
-            in_vector = true;
-        }
-
-        if (!in_vector) {
-          m_E.push_back(pair_a);
-        }
-
-      } else {
-        i_vals[i] = -1;
-      }
+      // each edge is added once, from its lower indexed cell,
+      // which is the cell that reaches it first
+      if (nbr > idx)
+        m_E.push_back(pair<size_t, size_t>(idx, nbr));
     }
+    m_adj_start.push_back(m_adj.size());
   }
 }
 
@@ -363,31 +373,84 @@ void EsriBathyGrid::generateEdges() {
 //            and we are confident that it is too shallow
 set<size_t> EsriBathyGrid::getObstacles(double depth_threshold,
                                         double var_threshold) {
-  double tmp_depth;
-  double tmp_var;
   set<size_t> obstacles;
 
-  if (m_grid.hasCellVar("depth")) {
+  const vector<unsigned char> &mask =
+      getObstacleMask(depth_threshold, var_threshold);
 
-    // cout << "getting obstacles" << endl;
+  for (size_t idx = 0; idx < mask.size(); idx++) {
+    if (mask[idx]) // confident that it's shallow
+      obstacles.insert(obstacles.end(), idx);
+  }
 
-    unsigned int cix_depth = m_grid.getCellVarIX("depth");
-    unsigned int cix_var = m_grid.getCellVarIX("var");
-    unsigned int cell_count = m_grid.size();
+  return obstacles;
+}
 
-    for (int idx = 0; idx < cell_count; idx++) {
-      tmp_depth = m_grid.getVal(idx, cix_depth);
-      tmp_var = m_grid.getVal(idx, cix_var);
+//---------------------------------------------------------
+// Procedure: getObstacleMask
+//            Returns a mask of the cells, 1 for the obstacles given
+//            by getObstacles().  The mask is kept between calls, and
+//            while the thresholds are unchanged only the cells
+//            updated since the last call are tested again.
+const vector<unsigned char> &
+EsriBathyGrid::getObstacleMask(double depth_threshold, double var_threshold) {
+
+  unsigned int cell_count = m_grid.size();
+  if (!m_grid.hasCellVar("depth")) {
+    m_obs_mask.assign(cell_count, 0);
+    m_obs_changed.clear();
+    m_obs_mask_valid = false;
+    return (m_obs_mask);
+  }
 
-      bool shallow = (tmp_depth < depth_threshold && tmp_var < var_threshold);
+  unsigned int cix_depth = m_grid.getCellVarIX("depth");
+  unsigned int cix_var = m_grid.getCellVarIX("var");
 
-      if (shallow) { // confident that it's shallow
-        obstacles.insert(idx);
-      }
+  bool same_thresholds = ((depth_threshold == m_obs_depth_threshold) &&
+                          (var_threshold == m_obs_var_threshold));
+
+  if (!m_obs_mask_valid || !same_thresholds ||
+      (m_obs_mask.size() != cell_count)) {
+    m_obs_mask.assign(cell_count, 0);
+    for (unsigned int idx = 0; idx < cell_count; idx++) {
+      double tmp_depth = m_grid.getVal(idx, cix_depth);
+      double tmp_var = m_grid.getVal(idx, cix_var);
+      m_obs_mask[idx] =
+          (tmp_depth < depth_threshold && tmp_var < var_threshold);
+    }
+  } else {
+    for (unsigned int i = 0; i < m_obs_changed.size(); i++) {
+      unsigned int idx = m_obs_changed[i];
+      double tmp_depth = m_grid.getVal(idx, cix_depth);
+      double tmp_var = m_grid.getVal(idx, cix_var);
+      m_obs_mask[idx] =
+          (tmp_depth < depth_threshold && tmp_var < var_threshold);
     }
   }
 
-  return obstacles;
+  m_obs_changed.clear();
+  m_obs_mask_valid = true;
+  m_obs_depth_threshold = depth_threshold;
+  m_obs_var_threshold = var_threshold;
+
+  return (m_obs_mask);
+}
+
+//---------------------------------------------------------
+// Procedure: markCellChanged
+//            Notes a cell to be tested again by getObstacleMask.
+//            If most of the grid changed, the mask is rebuilt.
+void EsriBathyGrid::markCellChanged(unsigned int idx) {
+
+  if (!m_obs_mask_valid || (idx >= m_obs_mask.size()))
+    return;
+
+  if (m_obs_changed.size() >= m_grid.size()) {
+    m_obs_changed.clear();
+    m_obs_mask_valid = false;
+    return;
+  }
+  m_obs_changed.push_back(idx);
 }
 
 //---------------------------------------------------------
@@ -612,23 +675,13 @@ bool EsriBathyGrid::updateCellValueXY(double x, double y,
   if (cell_vars.size() != cell_vals.size())
     return (false);
 
-  XYSquare perimeter = m_grid.getSBound();
-  if (!perimeter.containsPoint(x, y))
-    return (false);
-
-  // find the appropriate cell.
-  unsigned int cell_count = m_grid.size();
-  for (int idx = 0; idx < cell_count; idx++) {
-
-    bool contains_point = m_grid.ptIntersect(idx, x, y);
-    if (contains_point) {
+  // find the appropriate cell, computed directly from x,y
+  int idx = m_grid.getCellIX(x, y);
+  if (idx < 0)
+    return (false);  // no suitable cell for this location
 
-      bool update_ok = updateCellValueIDX(idx, cell_vars, cell_vals);
-      return (update_ok);
-    }
-  }
-  // Was NOT able to find a suitable cell for this location
-  return (false);
+  bool update_ok = updateCellValueIDX(idx, cell_vars, cell_vals);
+  return (update_ok);
 }
 
 //---------------------------------------------------------
@@ -644,6 +697,8 @@ bool EsriBathyGrid::updateCellValueIDX(unsigned int idx,
   if (cell_vars.size() != cell_vals.size())
     return (false);
 
+  markCellChanged(idx);
+
   // iterate through the cell vars to update
   unsigned int j, vsize = cell_vars.size();
   for (j = 0; j < vsize; j++) {
@@ -750,79 +805,55 @@ bool EsriBathyGrid::getCellXY(unsigned int idx, double &x, double &y) const {
 bool EsriBathyGrid::getCellDataXY(double x, double y, double &depth,
                                   double &var) const {
 
-  XYSquare perimeter = m_grid.getSBound();
-  if (!perimeter.containsPoint(x, y))
-    return (false);
+  // find the appropriate cell, computed directly from x,y
+  int idx = m_grid.getCellIX(x, y);
+  if (idx < 0)
+    return (false);  // no suitable cell for this location
 
-  // find the appropriate cell.
-  unsigned int cell_count = m_grid.size();
-  for (int idx = 0; idx < cell_count; idx++) {
-
-    bool contains_point = m_grid.ptIntersect(idx, x, y);
-    if (contains_point) {
-
-      if (m_grid.hasCellVar("depth") and m_grid.hasCellVar("var")) {
-        unsigned int cix_depth = m_grid.getCellVarIX("depth");
-        unsigned int cix_variance = m_grid.getCellVarIX("var");
-        depth = m_grid.getVal(idx, cix_depth);
-        var = m_grid.getVal(idx, cix_variance);
-      } else {
-        // Not able to set value correctly
-        cout << "Error reading from grid.  Did not find depth entry" << endl;
-        return (false);
-      }
-
-      return (true);
-    }
+  if (m_grid.hasCellVar("depth") and m_grid.hasCellVar("var")) {
+    unsigned int cix_depth = m_grid.getCellVarIX("depth");
+    unsigned int cix_variance = m_grid.getCellVarIX("var");
+    depth = m_grid.getVal(idx, cix_depth);
+    var = m_grid.getVal(idx, cix_variance);
+  } else {
+    // Not able to set value correctly
+    cout << "Error reading from grid.  Did not find depth entry" << endl;
+    return (false);
   }
-  // Was NOT able to find a suitable cell for this location
-  return (false);
+
+  return (true);
 }
 
 bool EsriBathyGrid::getCellDataXYI(double x, double y, double &depth,
                                    double &var, double &i_out) const {
 
-  XYSquare perimeter = m_grid.getSBound();
-  if (!perimeter.containsPoint(x, y))
-    return (false);
-
-  // find the appropriate cell.
-  unsigned int cell_count = m_grid.size();
-  for (int idx = 0; idx < cell_count; idx++) {
-
-    bool contains_point = m_grid.ptIntersect(idx, x, y);
-    if (contains_point) {
-
-      if (m_grid.hasCellVar("depth") and m_grid.hasCellVar("var")) {
-        unsigned int cix_depth = m_grid.getCellVarIX("depth");
-        unsigned int cix_variance = m_grid.getCellVarIX("var");
-        depth = m_grid.getVal(idx, cix_depth);
-        var = m_grid.getVal(idx, cix_variance);
-        i_out = idx;
-      } else {
-        // Not able to set value correctly
-        cout << "Error reading from grid.  Did not find depth entry" << endl;
-        return (false);
-      }
+  // find the appropriate cell, computed directly from x,y
+  int idx = m_grid.getCellIX(x, y);
+  if (idx < 0)
+    return (false);  // no suitable cell for this location
 
-      return (true);
-    }
+  if (m_grid.hasCellVar("depth") and m_grid.hasCellVar("var")) {
+    unsigned int cix_depth = m_grid.getCellVarIX("depth");
+    unsigned int cix_variance = m_grid.getCellVarIX("var");
+    depth = m_grid.getVal(idx, cix_depth);
+    var = m_grid.getVal(idx, cix_variance);
+    i_out = idx;
+  } else {
+    // Not able to set value correctly
+    cout << "Error reading from grid.  Did not find depth entry" << endl;
+    return (false);
   }
-  // Was NOT able to find a suitable cell for this location
-  return (false);
+
+  return (true);
 }
 
 bool EsriBathyGrid::getCellID(double x, double y, int &cell_id) const {
 
-  // find the appropriate cell.
-  unsigned int cell_count = m_grid.size();
-  for (int idx = 0; idx < cell_count; idx++) {
-
-    bool contains_point = m_grid.ptIntersect(idx, x, y);
-    if (contains_point) {
-      cell_id = idx;
-      return (true);
-    }
+  // find the appropriate cell, computed directly from x,y
+  int idx = m_grid.getCellIX(x, y);
+  if (idx >= 0) {
+    cell_id = idx;
+    return (true);
   }
   // Was NOT able to find a suitable cell for this location
 
@@ -839,19 +870,15 @@ bool EsriBathyGrid::getCellCenter(double x, double y, int &cell_id,
     return (false);
   }
 
-  // find the appropriate cell.
-  unsigned int cell_count = m_grid.size();
-  for (int idx = 0; idx < cell_count; idx++) {
-
-    bool contains_point = m_grid.ptIntersect(idx, x, y);
-    if (contains_point) {
-      cell_id = idx;
+  // find the appropriate cell, computed directly from x,y
+  int idx = m_grid.getCellIX(x, y);
+  if (idx >= 0) {
+    cell_id = idx;
 
-      XYSquare cell_square = m_grid.getElement(idx);
-      center_x = cell_square.getCenterX();
-      center_y = cell_square.getCenterY();
-      return (true);
-    }
+    XYSquare cell_square = m_grid.getElement(idx);
+    center_x = cell_square.getCenterX();
+    center_y = cell_square.getCenterY();
+    return (true);
   }
   // Was NOT able to find a suitable cell for this location
 
@@ -1058,8 +1085,10 @@ void EsriBathyGrid::setXYConvexGrid(XYConvexGrid new_grid) {
   m_grid = new_grid;
   m_cell_size = m_grid.getCellSize();
 
-  generateVertices();
-  generateEdges();
+  // A new grid with the same layout, e.g. the next consensus
+  // grid, keeps the cell graph. The obstacles are retested.
+  generateGraph();
+  m_obs_mask_valid = false;
 
   return;
 }
@@ -1497,39 +1526,30 @@ bool EsriBathyGrid::getBounds(double &min_x, double &min_y, double &max_x,
 }
 
 //--------------------------------------------------------
-// Procedure getDeltaSpec()
-//           returns the deltas of each grid using the
-//           XYGridUpdate format
+// Procedure getDeltaUpdate()
+//           returns the deltas of each grid as an XYGridUpdate
 //           Input: tolerance expressed as a fraction [0-1]
 //                  that is the maximum allowable difference
 //                  that is ignored.  I.e. if tolerance = 0.1
 //                  then the delta is not reported if the value
 //                  in any cell is less than 10% different than
 //                  the value in the old grid.
-//           Output (by reference) found_delta = true if found
-//                  change and need to send, false if no change
-//                  or error.
-//           Often this procedure is followed by setOldGridToNew();
+//           The update is not valid() if there was no change
+//           or on error.
 
-std::string EsriBathyGrid::getDeltaSpec(double tolerance, bool &found_delta) {
+XYGridUpdate EsriBathyGrid::getDeltaUpdate(double tolerance) {
+
+  XYGridUpdate update;
 
   unsigned int cell_count = m_grid.size();
-  if (cell_count != m_old_grid.size()) {
-    found_delta = false;
-    return ("");
-  }
+  if (cell_count != m_old_grid.size())
+    return (update);
 
-  unsigned int cix_depth;
-  unsigned int cix_variance;
-  if (m_grid.hasCellVar("depth") and m_grid.hasCellVar("var")) {
-    cix_depth = m_grid.getCellVarIX("depth");
-    cix_variance = m_grid.getCellVarIX("var");
-  } else {
-    found_delta = false;
-    return ("");
-  }
+  if (!m_grid.hasCellVar("depth") or !m_grid.hasCellVar("var"))
+    return (update);
+  unsigned int cix_depth = m_grid.getCellVarIX("depth");
+  unsigned int cix_variance = m_grid.getCellVarIX("var");
 
-  XYGridUpdate update;
   update.setGridName(m_grid.get_label());
 
   for (unsigned int idx = 0; idx < cell_count; idx++) {
@@ -1547,6 +1567,22 @@ std::string EsriBathyGrid::getDeltaSpec(double tolerance, bool &found_delta) {
     }
   }
 
+  return (update);
+}
+
+//--------------------------------------------------------
+// Procedure getDeltaSpec()
+//           returns the deltas of each grid using the
+//           XYGridUpdate format.  See getDeltaUpdate()
+//           Output (by reference) found_delta = true if found
+//                  change and need to send, false if no change
+//                  or error.
+//           Often this procedure is followed by setOldGridToNew();
+
+std::string EsriBathyGrid::getDeltaSpec(double tolerance, bool &found_delta) {
+
+  XYGridUpdate update = getDeltaUpdate(tolerance);
+
   // Check that we found any changes (deltas).  No need to send anything
   // if not
   std::string str;
@@ -1561,6 +1597,64 @@ std::string EsriBathyGrid::getDeltaSpec(double tolerance, bool &found_delta) {
   return (str);
 }
 
+//--------------------------------------------------------
+// Procedure getDeltaBinary()
+//           Same as getDeltaSpec() but in the run-length binary
+//           form of XYGridUpdate, for posting as binary mail.
+
+std::vector<unsigned char> EsriBathyGrid::getDeltaBinary(double tolerance,
+                                                         bool &found_delta) {
+
+  XYGridUpdate update = getDeltaUpdate(tolerance);
+
+  std::vector<unsigned char> data;
+  found_delta = update.valid();
+  if (found_delta)
+    data = update.getBinary();
+
+  return (data);
+}
+
+//--------------------------------------------------------
+// Procedure processGridDelta()
+//           Applies a delta received in the binary form
+
+bool EsriBathyGrid::processGridDelta(const std::vector<unsigned char>& data) {
+
+  if (data.size() == 0)
+    return (false);
+
+  XYGridUpdate update;
+  if (!update.setFromBinary(&data[0], data.size()))
+    return (false);
+
+  return (processGridDelta(update));
+}
+
+//--------------------------------------------------------
+// Procedure processGridDelta()
+//           Applies a delta received in the string form
+
+bool EsriBathyGrid::processGridDelta(std::string str) {
+  return (processGridDelta(stringToGridUpdate(str)));
+}
+
+//--------------------------------------------------------
+// Procedure processGridDelta()
+//           Applies a delta, noting the changed cells for the
+//           obstacle mask
+
+bool EsriBathyGrid::processGridDelta(const XYGridUpdate &update) {
+
+  if (!m_grid.processDelta(update))
+    return (false);
+
+  for (unsigned int i = 0; i < update.size(); i++)
+    markCellChanged(update.getCellIX(i));
+
+  return (true);
+}
+
 //-------------------------------------------------------
 // Procedure setOldGridToNew()
 void EsriBathyGrid::setOldGridToNew() {
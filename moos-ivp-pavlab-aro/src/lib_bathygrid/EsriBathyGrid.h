@@ -56,7 +56,14 @@ public:
 
   std::map<size_t, std::vector<double> > getVertices() {return m_V;}
   std::vector<std::pair<size_t,size_t> > getEdges() {return m_E;}
+
+  // Compact (CSR) form of the same graph. The neighbors of cell ix
+  // are adj[adj_start[ix]] up to, not including, adj[adj_start[ix+1]]
+  const std::vector<size_t>& getAdjStart() const {return m_adj_start;}
+  const std::vector<size_t>& getAdjacency() const {return m_adj;}
+
   std::set<size_t> getObstacles(double depth_threshold, double var_threshold);
+  const std::vector<unsigned char>& getObstacleMask(double depth_threshold, double var_threshold);
   std::set<size_t> getFinalObstacles(double depth_threshold, double var_threshold);
   std::string getObstacleGridSpec(double depth_threshold, double var_threshold);
 
@@ -92,6 +99,9 @@ public:
 
   // Grid delta support
   std::string getDeltaSpec(double tolerance, bool &found_delta); 
+  std::vector<unsigned char> getDeltaBinary(double tolerance,
+                                            bool &found_delta);
+  XYGridUpdate getDeltaUpdate(double tolerance);
  
   
   // Setters
@@ -113,7 +123,9 @@ public:
   
   // Grid delta support 
   void setOldGridToNew(); // sets the old grid to the new grid.  No more delta.
-  bool processGridDelta(std::string str) { return(m_grid.processDelta(str));}
+  bool processGridDelta(std::string str);
+  bool processGridDelta(const std::vector<unsigned char>& data);
+  bool processGridDelta(const XYGridUpdate& update);
 
  private:
   bool calculateRowsCols();
@@ -121,6 +133,8 @@ public:
 
   void generateEdges();
   void generateVertices();
+  void generateGraph();
+  void markCellChanged(unsigned int idx);
   
   //int get_max_index(double * array, int size);
   XYConvexGrid m_grid;
@@ -141,7 +155,17 @@ public:
 
   std::map<size_t, std::vector<double> > m_V;
   std::vector<std::pair<size_t,size_t> > m_E;
-  std::map<std::vector<double>, size_t> m_reverseV;
+  std::vector<size_t> m_adj_start;
+  std::vector<size_t> m_adj;
+  std::string m_graph_config;   // grid config the graph was built for
+
+  // Obstacle mask, retested only at changed cells while the
+  // thresholds stay the same
+  std::vector<unsigned char> m_obs_mask;
+  std::vector<unsigned int>  m_obs_changed;
+  bool   m_obs_mask_valid;
+  double m_obs_depth_threshold;
+  double m_obs_var_threshold;
  
 };
 
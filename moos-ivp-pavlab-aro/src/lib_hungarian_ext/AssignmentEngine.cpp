@@ -0,0 +1,333 @@
+/************************************************************/
+/*    NAME: agent                                           */
+/*    ORGN: MIT, Cambridge MA                               */
+/*    FILE: AssignmentEngine.cpp                            */
+/*    DATE: October 19th, 2026                              */
+/************************************************************/
+
+#include <limits>
+#include "AssignmentEngine.h"
+
+//---------------------------------------------------------
+// Constructor()
+
+AssignmentEngine::AssignmentEngine()
+{
+  m_rows = 0;
+  m_cols = 0;
+  m_cold = true;
+  m_nr   = 0;
+  m_nc   = 0;
+
+  m_rounds   = 0;
+  m_augments = 0;
+}
+
+//---------------------------------------------------------
+// Procedure: setSize()
+//            Clears all costs to zero, the next solve is cold.
+
+void AssignmentEngine::setSize(unsigned int rows, unsigned int cols)
+{
+  m_rows = rows;
+  m_cols = cols;
+  m_cost.assign(rows * cols, 0);
+  m_row_dirty.assign(rows, true);
+  m_row_assign.assign(rows, -1);
+  m_col_row_result.assign(cols, -1);
+  m_col_round.assign(cols, -1);
+  m_cold = true;
+}
+
+//---------------------------------------------------------
+// Procedure: setCost()
+//            A row is only marked for re-solve if a cost changed.
+
+void AssignmentEngine::setCost(unsigned int row, unsigned int col,
+			       double cost)
+{
+  if((row >= m_rows) || (col >= m_cols))
+    return;
+
+  double& cell = m_cost[(row * m_cols) + col];
+  if(cell != cost) {
+    cell = cost;
+    m_row_dirty[row] = true;
+  }
+}
+
+//---------------------------------------------------------
+// Procedure: setCosts()
+//            Same layout as HungarianAlgorithm::Solve(), one
+//            vector per row. Rows are assumed of equal length.
+
+void AssignmentEngine::setCosts(const std::vector<std::vector<double> >& costs)
+{
+  unsigned int rows = costs.size();
+  unsigned int cols = 0;
+  if(rows > 0)
+    cols = costs[0].size();
+
+  if((rows != m_rows) || (cols != m_cols))
+    setSize(rows, cols);
+
+  for(unsigned int i=0; i<rows; i++)
+    for(unsigned int j=0; (j<cols) && (j<costs[i].size()); j++)
+      setCost(i, j, costs[i][j]);
+}
+
+//---------------------------------------------------------
+// Procedure: solve()
+//   Returns: The total cost of the assignment
+//
+// On a warm start the potentials and matches of the last solve are
+// kept. Each changed row is unmatched and its potential lowered to
+// keep all reduced costs non-negative. Only these rows are then
+// augmented.
+
+double AssignmentEngine::solve()
+{
+  m_augments = 0;
+  m_row_assign.assign(m_rows, -1);
+  if((m_rows == 0) || (m_cols == 0))
+    return(0);
+
+  if(m_cold) {
+    std::vector<int> colmap(m_cols);
+    for(unsigned int j=0; j<m_cols; j++)
+      colmap[j] = j;
+    initWork(colmap, true);
+    for(unsigned int i=0; i<m_nr; i++) {
+      resetRowDual(i);
+      augmentRow(i);
+    }
+    m_cold = false;
+  }
+  else {
+    std::vector<unsigned int> freed;
+    for(unsigned int i=0; i<m_rows; i++) {
+      if(!m_row_dirty[i])
+	continue;
+      int j = m_row_col[i];
+      if(j >= 0) {
+	m_col_row[j] = -1;
+	m_row_col[i] = -1;
+      }
+      resetRowDual(i);
+      freed.push_back(i);
+    }
+    for(unsigned int k=0; k<freed.size(); k++)
+      augmentRow(freed[k]);
+  }
+  m_row_dirty.assign(m_rows, false);
+
+  double total = 0;
+  for(unsigned int i=0; i<m_rows; i++) {
+    int c = m_colmap[m_row_col[i]];
+    m_row_assign[i] = c;
+    if(c >= 0)
+      total += m_cost[(i * m_cols) + c];
+  }
+  return(total);
+}
+
+//---------------------------------------------------------
+// Procedure: solveRounds()
+//   Returns: The total cost over all rounds
+//
+// While there are at least as many columns left as rows, a round is
+// solved as a rectangular problem, augmenting only the real rows.
+// The last round, with fewer columns than rows, is padded.
+
+double AssignmentEngine::solveRounds(unsigned int max_rounds)
+{
+  m_augments = 0;
+  m_rounds   = 0;
+  m_col_row_result.assign(m_cols, -1);
+  m_col_round.assign(m_cols, -1);
+  if((m_rows == 0) || (m_cols == 0))
+    return(0);
+
+  std::vector<int> active(m_cols);
+  for(unsigned int j=0; j<m_cols; j++)
+    active[j] = j;
+
+  double total = 0;
+  while((active.size() > 0) && (m_rounds < max_rounds)) {
+    initWork(active, false);
+    for(unsigned int i=0; i<m_nr; i++) {
+      resetRowDual(i);
+      augmentRow(i);
+    }
+
+    for(unsigned int i=0; i<m_rows; i++) {
+      int c = m_colmap[m_row_col[i]];
+      if(c < 0)
+	continue;
+      m_col_row_result[c] = i;
+      m_col_round[c] = m_rounds;
+      total += m_cost[(i * m_cols) + c];
+    }
+
+    std::vector<int> next_active;
+    for(unsigned int k=0; k<active.size(); k++) {
+      if(m_col_row_result[active[k]] < 0)
+	next_active.push_back(active[k]);
+    }
+    active = next_active;
+    m_rounds++;
+  }
+
+  // The working problem no longer matches the full cost matrix
+  m_cold = true;
+  return(total);
+}
+
+//---------------------------------------------------------
+// Procedure: getAssignment()
+
+int AssignmentEngine::getAssignment(unsigned int row) const
+{
+  if(row >= m_row_assign.size())
+    return(-1);
+  return(m_row_assign[row]);
+}
+
+//---------------------------------------------------------
+// Procedure: getColumnRow()
+
+int AssignmentEngine::getColumnRow(unsigned int col) const
+{
+  if(col >= m_col_row_result.size())
+    return(-1);
+  return(m_col_row_result[col]);
+}
+
+//---------------------------------------------------------
+// Procedure: getColumnRound()
+
+int AssignmentEngine::getColumnRound(unsigned int col) const
+{
+  if(col >= m_col_round.size())
+    return(-1);
+  return(m_col_round[col]);
+}
+
+//---------------------------------------------------------
+// Procedure: initWork()
+//            Pads the given columns to at least the number of rows,
+//            and optionally the rows to square. All potentials are
+//            zero and all rows and columns unmatched.
+
+void AssignmentEngine::initWork(const std::vector<int>& colmap, bool pad_rows)
+{
+  m_nc = colmap.size();
+  if(m_rows > m_nc)
+    m_nc = m_rows;
+  m_nr = pad_rows ? m_nc : m_rows;
+
+  m_colmap = colmap;
+  m_colmap.resize(m_nc, -1);
+
+  m_u.assign(m_nr, 0);
+  m_v.assign(m_nc, 0);
+  m_col_row.assign(m_nc + 1, -1);
+  m_row_col.assign(m_nr, -1);
+
+  m_minv.resize(m_nc + 1);
+  m_way.resize(m_nc + 1);
+  m_used.resize(m_nc + 1);
+}
+
+//---------------------------------------------------------
+// Procedure: resetRowDual()
+//            Sets the row potential to its largest feasible value
+//            given the column potentials.
+
+void AssignmentEngine::resetRowDual(unsigned int row)
+{
+  double umin = std::numeric_limits<double>::infinity();
+  for(unsigned int j=0; j<m_nc; j++) {
+    double val = cellCost(row, j) - m_v[j];
+    if(val < umin)
+      umin = val;
+  }
+  m_u[row] = umin;
+}
+
+//---------------------------------------------------------
+// Procedure: cellCost()
+//            Padded rows and columns cost zero.
+
+double AssignmentEngine::cellCost(unsigned int i, unsigned int j) const
+{
+  int c = m_colmap[j];
+  if((i >= m_rows) || (c < 0))
+    return(0);
+  return(m_cost[(i * m_cols) + c]);
+}
+
+//---------------------------------------------------------
+// Procedure: augmentRow()
+//            Dijkstra over reduced costs from the given free row
+//            to the nearest free column, updating the potentials,
+//            then flipping the matches along the path. Index m_nc
+//            is a virtual column holding the free row.
+
+void AssignmentEngine::augmentRow(unsigned int row)
+{
+  const double inf = std::numeric_limits<double>::infinity();
+  unsigned int n = m_nc;
+
+  m_minv.assign(n + 1, inf);
+  m_way.assign(n + 1, -1);
+  m_used.assign(n + 1, false);
+
+  m_col_row[n] = row;
+  unsigned int j0 = n;
+  do {
+    m_used[j0] = true;
+    unsigned int i = m_col_row[j0];
+    const double *crow = 0;
+    if(i < m_rows)
+      crow = &m_cost[i * m_cols];
+    double ui = m_u[i];
+
+    double delta = inf;
+    unsigned int j1 = n;
+    for(unsigned int j=0; j<n; j++) {
+      if(m_used[j])
+	continue;
+      int c = m_colmap[j];
+      double cost = (crow && (c >= 0)) ? crow[c] : 0;
+      double cur = cost - ui - m_v[j];
+      if(cur < m_minv[j]) {
+	m_minv[j] = cur;
+	m_way[j]  = j0;
+      }
+      if(m_minv[j] < delta) {
+	delta = m_minv[j];
+	j1 = j;
+      }
+    }
+    for(unsigned int j=0; j<=n; j++) {
+      if(m_used[j]) {
+	m_u[m_col_row[j]] += delta;
+	if(j < n)
+	  m_v[j] -= delta;
+      }
+      else
+	m_minv[j] -= delta;
+    }
+    j0 = j1;
+  } while(m_col_row[j0] >= 0);
+
+  do {
+    unsigned int j1 = m_way[j0];
+    m_col_row[j0] = m_col_row[j1];
+    m_row_col[m_col_row[j0]] = j0;
+    j0 = j1;
+  } while(j0 != n);
+
+  m_augments++;
+}
@@ -0,0 +1,95 @@
+/************************************************************/
+/*    NAME: agent                                           */
+/*    ORGN: MIT, Cambridge MA                               */
+/*    FILE: AssignmentEngine.h                              */
+/*    DATE: October 19th, 2026                              */
+/************************************************************/
+
+#ifndef AssignmentEngine_HEADER
+#define AssignmentEngine_HEADER
+
+#include <vector>
+
+// Minimum cost assignment of rows (agents) to columns (tasks) by
+// shortest augmenting paths with row and column potentials. The
+// costs are kept in one flat row-major array, and the potentials are
+// kept between solves, so a re-solve after a few rows change only
+// re-augments those rows.
+//
+// For solve(), rectangular problems are padded to square with zero
+// cost rows or columns, so any row may be re-solved on its own. A row
+// matched to a padded column is unassigned (-1).
+
+class AssignmentEngine
+{
+ public:
+  AssignmentEngine();
+  ~AssignmentEngine() {}
+
+  void   setSize(unsigned int rows, unsigned int cols);
+  void   setCost(unsigned int row, unsigned int col, double cost);
+  void   setCosts(const std::vector<std::vector<double> >& costs);
+
+  // One assignment, each row to at most one column
+  double solve();
+
+  // Repeated rounds until every column is assigned. Each round is an
+  // assignment over the columns not yet assigned, so a row may get
+  // one column per round. Costs are not changed between rounds.
+  double solveRounds(unsigned int max_rounds=100);
+
+  unsigned int rows() const  {return(m_rows);}
+  unsigned int cols() const  {return(m_cols);}
+  double getCost(unsigned int row, unsigned int col) const
+  {return(m_cost[(row * m_cols) + col]);}
+
+  // Results of solve(): the column of each row, or -1
+  int    getAssignment(unsigned int row) const;
+  const std::vector<int>& getAssignments() const {return(m_row_assign);}
+
+  // Results of solveRounds(): the row and round of each column, or -1
+  int    getColumnRow(unsigned int col) const;
+  int    getColumnRound(unsigned int col) const;
+  unsigned int getRounds() const   {return(m_rounds);}
+
+  // Rows augmented in the last solve, for warm start analysis
+  unsigned int getAugments() const {return(m_augments);}
+
+ protected:
+  void   initWork(const std::vector<int>& colmap, bool pad_rows);
+  void   augmentRow(unsigned int row);
+  void   resetRowDual(unsigned int row);
+  double cellCost(unsigned int i, unsigned int j) const;
+
+ protected:
+  unsigned int m_rows;
+  unsigned int m_cols;
+  std::vector<double> m_cost;
+
+  // Rows changed since the last solve
+  std::vector<bool>   m_row_dirty;
+  bool                m_cold;
+
+  // The working problem. m_colmap maps a working column to a cost
+  // column, -1 for padding. Working rows past m_rows are padding.
+  unsigned int        m_nr;
+  unsigned int        m_nc;
+  std::vector<int>    m_colmap;
+  std::vector<double> m_u;        // row potentials
+  std::vector<double> m_v;        // column potentials
+  std::vector<int>    m_col_row;  // working row matched to column
+  std::vector<int>    m_row_col;  // working column matched to row
+
+  // Scratch for augmentRow, sized m_nc+1
+  std::vector<double> m_minv;
+  std::vector<int>    m_way;
+  std::vector<bool>   m_used;
+
+  std::vector<int>    m_row_assign;
+  std::vector<int>    m_col_row_result;
+  std::vector<int>    m_col_round;
+  unsigned int        m_rounds;
+  unsigned int        m_augments;
+};
+
+#endif
@@ -0,0 +1,352 @@
+/************************************************************/
+/*    NAME: agent                                           */
+/*    ORGN: MIT, Cambridge MA                               */
+/*    FILE: OpinionDynamics.cpp                             */
+/*    DATE: October 19th, 2026                              */
+/************************************************************/
+
+
+/* The same dynamics as OpManagerEngine::iterateOwnOpinion(),
+   lines 3a and 3b of arxiv.org/pdf/2009.04332.pdf, with the
+   neighbor terms taken as sums over a dense opinion matrix rather
+   than looked up by name in each neighbor's OpinionRecord.
+*/
+
+
+#include <cmath>
+#include <map>
+#include "OpinionDynamics.h"
+
+//---------------------------------------------------------
+// Constructor
+
+OpinionDynamics::OpinionDynamics()
+{
+  m_tau_u = 10.0;
+  m_u_min = 0.5;
+  m_u_max = 1.5;
+  m_u_th  = 0.1;
+  m_Hill_order = 2.0;
+  m_num_int_gain = 1.0;
+
+  m_options = 0;
+  m_agents  = 0;
+}
+
+//---------------------------------------------------------
+// setOptions()
+//    Builds the dense couplings. Beta and delta couplings to an
+//    option name not in the list are dropped. Clears all agents.
+
+bool OpinionDynamics::setOptions(std::vector<Option> options)
+{
+  m_options = options.size();
+  unsigned int no = m_options;
+
+  std::map<std::string, unsigned int> name_ix;
+  for (unsigned int j = 0; j < no; j++)
+    name_ix[options[j].getOptionName()] = j;
+
+  m_alpha.assign(no, 0);
+  m_gamma.assign(no, 0);
+  m_resist.assign(no, 0);
+  m_beta.assign(no * no, 0);
+  m_delta.assign(no * no, 0);
+  m_beta_ix.assign(no, std::vector<unsigned int>());
+
+  bool all_ok = true;
+  for (unsigned int j = 0; j < no; j++) {
+    m_alpha[j]  = options[j].getAlpha();
+    m_gamma[j]  = options[j].getGamma();
+    m_resist[j] = options[j].getDi();
+
+    std::map<std::string, double> beta_map = options[j].getBetaMap();
+    std::map<std::string, double>::iterator it;
+    for (it = beta_map.begin(); it != beta_map.end(); it++) {
+      if (name_ix.count(it->first) == 0) {
+	all_ok = false;
+	continue;
+      }
+      unsigned int l = name_ix[it->first];
+      m_beta[(j * no) + l] = it->second;
+      m_beta_ix[j].push_back(l);
+    }
+
+    std::map<std::string, double> delta_map = options[j].getDeltaMap();
+    for (it = delta_map.begin(); it != delta_map.end(); it++) {
+      if (name_ix.count(it->first) == 0) {
+	all_ok = false;
+	continue;
+      }
+      m_delta[(j * no) + name_ix[it->first]] = it->second;
+    }
+  }
+
+  setAgents(m_agents);
+  return(all_ok);
+}
+
+//---------------------------------------------------------
+// setAgents()
+//    All opinions zero, all options active, no neighbors.
+
+void OpinionDynamics::setAgents(unsigned int amt)
+{
+  m_agents = amt;
+  m_z.assign(amt * m_options, 0);
+  m_b.assign(amt * m_options, 0);
+  m_atten.assign(amt, m_u_min);
+  m_active.assign(amt, std::vector<bool>(m_options, true));
+  m_adj.assign(amt * amt, 0);
+}
+
+//---------------------------------------------------------
+// setNeighbor()
+//    Agent i hears agent k. Not symmetric.
+
+void OpinionDynamics::setNeighbor(unsigned int i, unsigned int k, bool val)
+{
+  if (i != k)
+    m_adj[(i * m_agents) + k] = val ? 1 : 0;
+}
+
+//---------------------------------------------------------
+// setAllNeighbors()
+
+void OpinionDynamics::setAllNeighbors()
+{
+  for (unsigned int i = 0; i < m_agents; i++)
+    for (unsigned int k = 0; k < m_agents; k++)
+      m_adj[(i * m_agents) + k] = (i == k) ? 0 : 1;
+}
+
+//---------------------------------------------------------
+// setActive()
+//    An inactive option has its opinion zeroed, as in
+//    OpManagerEngine::determineOptionActive().
+
+void OpinionDynamics::setActive(unsigned int i, unsigned int j, bool val)
+{
+  m_active[i][j] = val;
+  if (!val)
+    m_z[(i * m_options) + j] = 0;
+}
+
+//---------------------------------------------------------
+// setInput()
+
+void OpinionDynamics::setInput(unsigned int i, unsigned int j, double val)
+{
+  m_b[(i * m_options) + j] = val;
+}
+
+//---------------------------------------------------------
+// setOpinion()
+
+void OpinionDynamics::setOpinion(unsigned int i, unsigned int j, double val)
+{
+  m_z[(i * m_options) + j] = val;
+}
+
+//---------------------------------------------------------
+// resetOpinions()
+//    As OpManagerEngine::resetOpinionState(), opinions to zero and
+//    attention to the minimum.
+
+void OpinionDynamics::resetOpinions()
+{
+  m_z.assign(m_agents * m_options, 0);
+  m_atten.assign(m_agents, m_u_min);
+}
+
+//---------------------------------------------------------
+// step()
+//    One Euler step for all agents. The neighbor sums are taken
+//    first, so each agent sees its neighbors before the step, as
+//    it would from their last opinion messages.
+
+void OpinionDynamics::step(double dt)
+{
+  unsigned int no = m_options;
+  unsigned int na = m_agents;
+
+  // The projection at the end of a step can leave inactive options
+  // non-zero. Zero them, since only active options are in a message.
+  // Then each agent's mean squared opinion, as
+  // OpinionRecord::getOpinionsSquared() of its message
+  std::vector<double> rowsq(na, 0);
+  for (unsigned int k = 0; k < na; k++) {
+    double *zk = &m_z[k * no];
+    unsigned int count = 0;
+    double sq = 0;
+    for (unsigned int l = 0; l < no; l++) {
+      if (!m_active[k][l]) {
+	zk[l] = 0;
+	continue;
+      }
+      sq += zk[l] * zk[l];
+      count++;
+    }
+    if (count > 0)
+      rowsq[k] = sq / count;
+  }
+
+  m_nsum.assign(na * no, 0);
+  m_nsq.assign(na, 0);
+  for (unsigned int i = 0; i < na; i++) {
+    double *nsum = &m_nsum[i * no];
+    const double *adj = &m_adj[i * na];
+    for (unsigned int k = 0; k < na; k++) {
+      double a = adj[k];
+      if (a == 0)
+	continue;
+      const double *zk = &m_z[k * no];
+      for (unsigned int l = 0; l < no; l++)
+	nsum[l] += a * zk[l];
+      m_nsq[i] += a * rowsq[k];
+    }
+  }
+
+  for (unsigned int i = 0; i < na; i++)
+    stepAgent(&m_z[i * no], m_atten[i], m_active[i], &m_b[i * no],
+	      &m_nsum[i * no], m_nsq[i], dt);
+}
+
+//---------------------------------------------------------
+// stepAgent()
+//    One Euler step for one agent. z is the agent's opinions, u its
+//    attention, b its inputs, all of size options(). nsum is the
+//    sum of its neighbors' opinions for each option, and nsq the
+//    sum of its neighbors' mean squared opinions.
+
+void OpinionDynamics::stepAgent(double *z, double& u,
+				const std::vector<bool>& active,
+				const double *b, const double *nsum,
+				double nsq, double dt)
+{
+  unsigned int no = m_options;
+
+  unsigned int n_active = 0;
+  double sum1 = 0;
+  for (unsigned int j = 0; j < no; j++) {
+    if (active[j]) {
+      sum1 += z[j] * z[j];
+      n_active++;
+    }
+  }
+
+  // With no active options there is nothing to update, and the
+  // attention is left as is
+  if (n_active == 0) {
+    for (unsigned int j = 0; j < no; j++)
+      z[j] = 0;
+    return;
+  }
+
+  // Step 1: Attention from own and neighbors' squared opinions
+  sum1 = (sum1 / n_active) + nsq;
+  double du_dt = (-u + m_u_min + (m_u_max - m_u_min) * satFunctionHill(sum1)) / m_tau_u;
+  u += du_dt * dt;
+  if (u > m_u_max)
+    u = m_u_max;
+  if (u < m_u_min)
+    u = m_u_min;
+
+  // Step 2: F_ij for each active option
+  m_f.assign(no, 0);
+  double f_sum = 0;
+  for (unsigned int j = 0; j < no; j++) {
+    if (!active[j])
+      continue;
+    double term1 = (m_alpha[j] * z[j]) + (m_gamma[j] * nsum[j]);
+
+    double term2 = 0;
+    const double *beta  = &m_beta[j * no];
+    const double *delta = &m_delta[j * no];
+    const std::vector<unsigned int>& beta_ix = m_beta_ix[j];
+    for (unsigned int k = 0; k < beta_ix.size(); k++) {
+      unsigned int l = beta_ix[k];
+      double sum3 = delta[l] * nsum[l];
+      if (active[l])
+	sum3 += beta[l] * z[l];
+      term2 += tanh(sum3);
+    }
+    m_f[j] = -m_resist[j] * z[j] + b[j] + u * (tanh(term1) + term2);
+    f_sum += m_f[j];
+  }
+
+  // Step 3: Project onto the active options and integrate
+  double f_mean = f_sum / n_active;
+  double zdot_sum = 0;
+  for (unsigned int j = 0; j < no; j++) {
+    if (active[j]) {
+      m_f[j] -= f_mean;
+      zdot_sum += m_f[j];
+    }
+  }
+  double gain = dynamicGainCalc(zdot_sum, n_active);
+
+  double z_sum = 0;
+  for (unsigned int j = 0; j < no; j++) {
+    z[j] = active[j] ? (z[j] + (dt * gain * m_f[j])) : 0;
+    z_sum += z[j];
+  }
+
+  // Step 4: Keep the state in the simplex, over all options
+  double z_mean = z_sum / no;
+  for (unsigned int j = 0; j < no; j++)
+    z[j] -= z_mean;
+}
+
+//---------------------------------------------------------
+// getStrongestOption()
+//    Returns: index of the largest opinion of agent i, or -1 if
+//             it is under the threshold.
+
+int OpinionDynamics::getStrongestOption(unsigned int i, double thresh) const
+{
+  int best_index = -1;
+  double highest_opinion = 0.0;
+  for (unsigned int j = 0; j < m_options; j++) {
+    double val = m_z[(i * m_options) + j];
+    if (val > highest_opinion) {
+      best_index = j;
+      highest_opinion = val;
+    }
+  }
+  if (highest_opinion < thresh)
+    return(-1);
+  return(best_index);
+}
+
+//---------------------------------------------------------
+// satFunctionHill()
+
+double OpinionDynamics::satFunctionHill(double y) const
+{
+  double yn = pow(y, m_Hill_order);
+  return(yn / (pow(m_u_th, m_Hill_order) + yn));
+}
+
+//---------------------------------------------------------
+// dynamicGainCalc()
+//    As OpManagerEngine::dynamicGainCalc(), from the sum and
+//    number of the z_dot values.
+
+double OpinionDynamics::dynamicGainCalc(double z_dot_sum,
+					unsigned int amt) const
+{
+  double z_dot_ave = 1.0;
+  if (amt > 0)
+    z_dot_ave = z_dot_sum / static_cast<double>(amt);
+
+  double lower_lim = 0.00001;   // gain is 1.0 at lower limit
+  double upper_lim = 0.0001;    // gain is clamped at m_num_int_gain
+  if (z_dot_ave < lower_lim)
+    return(1.0);
+  if (z_dot_ave > upper_lim)
+    return(m_num_int_gain);
+
+  double delta = z_dot_ave - lower_lim;
+  return((delta / (upper_lim - lower_lim)) * (1.0 - m_num_int_gain) + m_num_int_gain);
+}
@@ -0,0 +1,105 @@
+/************************************************************/
+/*    NAME: agent                                           */
+/*    ORGN: MIT, Cambridge MA                               */
+/*    FILE: OpinionDynamics.h                               */
+/*    DATE: October 19th, 2026                              */
+/************************************************************/
+
+#ifndef OpinionDynamics_HEADER
+#define OpinionDynamics_HEADER
+
+#include <vector>
+#include <string>
+#include "Option.h"
+
+/* Dense form of the opinion dynamics of OpManagerEngine, for many
+   agents at once. The couplings of all options are held in option
+   by option matrices, and the opinions of all agents in one agents
+   by options matrix, both flat and row-major. Inactive options have
+   an opinion of zero, so contribute nothing to any sum.
+
+   step() integrates all agents together, each seeing the opinions
+   of its neighbors from before the step. stepAgent() is the update
+   for one agent given the sums over its neighbors, and is also used
+   by OpManagerEngine for its own opinion.
+*/
+
+class OpinionDynamics
+{
+ public:
+  OpinionDynamics();
+  ~OpinionDynamics() {}
+
+  // Setup functions:
+  bool setOptions(std::vector<Option> options);
+  void setAgents(unsigned int amt);
+
+  void setTauU(double val)        {m_tau_u = val;}
+  void setUth(double val)         {m_u_th = val;}
+  void setSatFunOrder(double val) {m_Hill_order = val;}
+  void setMinAtten(double val)    {m_u_min = val;}
+  void setMaxAtten(double val)    {m_u_max = val;}
+  void setNumIntGain(double val)  {m_num_int_gain = val;}
+
+  // Per agent state, indices are not checked
+  void setNeighbor(unsigned int i, unsigned int k, bool val=true);
+  void setAllNeighbors();
+  void setActive(unsigned int i, unsigned int j, bool val);
+  void setInput(unsigned int i, unsigned int j, double val);
+  void setOpinion(unsigned int i, unsigned int j, double val);
+  void setAttention(unsigned int i, double val) {m_atten[i] = val;}
+  void resetOpinions();
+
+  // Operational functions:
+  void step(double dt);
+  void stepAgent(double *z, double& u, const std::vector<bool>& active,
+		 const double *b, const double *nsum, double nsq,
+		 double dt);
+
+  // Getters
+  unsigned int options() const {return(m_options);}
+  unsigned int agents() const  {return(m_agents);}
+  double getOpinion(unsigned int i, unsigned int j) const
+  {return(m_z[(i * m_options) + j]);}
+  double getAttention(unsigned int i) const {return(m_atten[i]);}
+  double getMinAtten() const {return(m_u_min);}
+  int    getStrongestOption(unsigned int i, double thresh) const;
+
+ protected:
+  double satFunctionHill(double y) const;
+  double dynamicGainCalc(double z_dot_sum, unsigned int amt) const;
+
+ protected: // Dynamical parameters
+  double m_tau_u;
+  double m_u_min;
+  double m_u_max;
+  double m_u_th;
+  double m_Hill_order;
+  double m_num_int_gain;
+
+ protected: // Couplings, m_options x m_options where dense
+  unsigned int        m_options;
+  std::vector<double> m_alpha;
+  std::vector<double> m_gamma;
+  std::vector<double> m_resist;
+  std::vector<double> m_beta;
+  std::vector<double> m_delta;
+
+  // For each option, the options it has a beta coupling to
+  std::vector<std::vector<unsigned int> > m_beta_ix;
+
+ protected: // Agent state, m_agents x m_options
+  unsigned int        m_agents;
+  std::vector<double> m_z;
+  std::vector<double> m_b;
+  std::vector<double> m_atten;
+  std::vector<std::vector<bool> > m_active;
+  std::vector<double> m_adj;    // m_agents x m_agents
+
+  // Scratch for step() and stepAgent()
+  std::vector<double> m_nsum;
+  std::vector<double> m_nsq;
+  std::vector<double> m_f;
+};
+
+#endif
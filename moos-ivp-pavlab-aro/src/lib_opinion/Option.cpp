@@ -17,6 +17,7 @@ Notes:  (1) If a social mode of cooperative or competitive is
 */
 
 
+#include <fstream>
 #include "Option.h"
 
 //---------------------------------------------------------
@@ -454,3 +455,71 @@ Option buildOptionFromSpec(std::list<std::string> spec, bool& ok, std::string& w
 
 
 
+//-----------------------------------------------------------------
+// Utility to read all the social_option blocks of a config file,
+// for example the .optn file of pOpinionManager:
+//
+//   social_option
+//   {
+//      name = wide_loiter
+//      ...
+//   }
+//
+// Returns false on the first bad block, or if no block was found
+
+bool readOptionsFromFile(std::string filename, std::vector<Option>& options, std::string& warn_msg)
+{
+  std::ifstream file(filename.c_str());
+  if (!file.is_open()) {
+    warn_msg = "Opinion Manager Error: Cannot open config file";
+    return(false);
+  }
+
+  std::vector<Option> new_options;
+  std::list<std::string> config_lines;
+  bool found_config_start = false;
+
+  std::string line;
+  while (std::getline(file, line)) {
+    // remove comments
+    std::string stripped_line = biteStringX(line, '/');
+    if (stripped_line == "")
+      continue;
+
+    if (stripped_line == "social_option") {
+      // check if another block was found and not properly handled.
+      if (found_config_start) {
+	warn_msg = "Opinion Manager Error: Encountered a config block that was not closed";
+	return(false);
+      }
+      found_config_start = true;
+
+    } else if ((stripped_line != "{") && (stripped_line != "}") && found_config_start) {
+      config_lines.push_back(stripped_line);
+
+    } else if (((stripped_line == "{") || (stripped_line == "}")) && !found_config_start) {
+      warn_msg = "Opinion Manager Error: Encountered a config block that was not started properly";
+      return(false);
+
+    } else if ((stripped_line == "}") && found_config_start) {
+      // found a valid closing bracket, process this block
+      bool ok = false;
+      Option new_option = buildOptionFromSpec(config_lines, ok, warn_msg);
+      if (!ok)
+	return(false);
+      new_options.push_back(new_option);
+
+      config_lines.clear();
+      found_config_start = false;
+    }
+    // ignore the rest of the lines
+  }
+
+  if (new_options.size() < 1) {
+    warn_msg = "Opinion Manager Error: Opened file but did not find any config blocks";
+    return(false);
+  }
+
+  options = new_options;
+  return(true);
+}
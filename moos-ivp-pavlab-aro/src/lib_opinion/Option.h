@@ -107,6 +107,7 @@ class Option
 };
   
 Option buildOptionFromSpec(std::list<std::string> spec, bool& ok, std::string& warn_msg);
+bool readOptionsFromFile(std::string filename, std::vector<Option>& options, std::string& warn_msg);
 
 
 #endif
@@ -14,10 +14,10 @@
 #include <set>
 #include <math.h>
 #include <list>
+#include <queue>
 #include <iostream>
 #include <algorithm>    // std::reverse
 #include <limits>
-#include "GraphNode.h"
 
 
 
@@ -76,8 +76,24 @@ class SimpleAStar
 		    const std::set<index>& idx_start,
 		    const std::set<index>& idx_final,
 		    bool asc_cell_id = true);
+
+  // Same, but the edges are given in compact (CSR) form, as
+  // from EsriBathyGrid. The neighbors of vertex i are
+  // adj[adj_start[i]] up to, not including, adj[adj_start[i+1]].
+  // The vertices must be indexed 0 to V.size()-1.
+  bool preloadGraph(const std::map<index, vertex>& V,
+		    const std::vector<index>& adj_start,
+		    const std::vector<index>& adj,
+		    const std::set<index>& idx_start,
+		    const std::set<index>& idx_final,
+		    bool asc_cell_id = true);
   
   path searchPathFast(const std::set<index>& Obs);
+
+  // Obstacles given as a mask over the vertex indices, as from
+  // EsriBathyGrid::getObstacleMask(). Indices past the end of
+  // the mask are not obstacles.
+  path searchPathFast(const std::vector<unsigned char>& obs_mask);
   
 
   double calcCost( const vertex& Vi, const vertex& q);
@@ -89,21 +105,51 @@ class SimpleAStar
 
  private:
 
-  double minHeuristicToGoal(const std::map<index, vertex>& V,
-			    const int node_number,
-			    const std::set<index>& idx_final);
-  
-  path  recoverPath(const std::list<Node>& closed_list,
-		    const std::set<index>& idx_start,
-		    index idx_final);
-  
-  path  recoverPathFast(index idx_final);
+  // An entry of the open list. The open list is a binary heap
+  // ordered on the lowest f, then the earliest added.
+  struct OpenEntry {
+    double f;
+    unsigned long seq;
+    unsigned int node;
+    bool operator<(const OpenEntry& other) const {
+      if (f != other.f)
+	return(f > other.f);
+      return(seq > other.seq);
+    }
+  };
+
+  bool  preloadNodes(const std::map<index, vertex>& V,
+		     const std::set<index>& idx_start,
+		     const std::set<index>& idx_final,
+		     bool asc_cell_id);
 
-  //  Member variable to hold the info about the graph
-  //  A map should be fast enough per
-  //  https://www.codeproject.com/Articles/866996/Fast-Implementations-of-Maps-with-Integer-Keys-in
-  std::map<index, Node> m_node_map;
-  std::list<index> m_open_list_seed;
+  double minHeuristicToGoal(unsigned int node);
+
+  path  searchGraph(const std::vector<unsigned char>& blocked);
+  
+  path  recoverPathFast(unsigned int node_final);
+
+  //  Member variables to hold the info about the graph.
+  //  Nodes are numbered 0 to n-1 in the order of the indices
+  //  of V, and the neighbors of node i are
+  //  m_adj[m_adj_start[i]] up to m_adj[m_adj_start[i+1]].
+  std::vector<index>         m_ids;
+  std::map<index, unsigned int> m_node_of_id;
+  std::vector<vertex>        m_pos;
+  std::vector<std::size_t>   m_adj_start;
+  std::vector<unsigned int>  m_adj;
+  std::vector<bool>          m_is_start;
+  std::vector<bool>          m_is_goal;
+  std::vector<vertex>        m_goal_pos;
+  std::vector<double>        m_h;   // < 0 until first needed
+  std::vector<unsigned int>  m_open_list_seed;
+
+  //  Per search state, sized once with the graph
+  std::vector<double>        m_g;
+  std::vector<double>        m_f;
+  std::vector<unsigned int>  m_parent;
+  std::vector<unsigned long> m_seq;
+  std::vector<unsigned char> m_state;
 
   bool m_graph_preloaded;
   
@@ -114,5 +160,4 @@ class SimpleAStar
 
 
 
-
 #endif 
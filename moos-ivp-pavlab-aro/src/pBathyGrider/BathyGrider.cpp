@@ -287,12 +287,7 @@ bool BathyGrider::Iterate()
       m_gpr_time = MOOSTime();
       
       // Now send the deltas and update the old grid
-      bool found_delta = false;
-      string delta_spec_gpr = m_grid_gpr.getDeltaSpec(m_delta_thresh, found_delta);
-      if (found_delta) {
-	Notify("VIEW_GRID_GPR_LOCAL_DELTA", delta_spec_gpr);
-	m_grid_gpr.setOldGridToNew();  // no more delta, we have sent all the updates
-      }
+      postGridDelta(m_grid_gpr, "VIEW_GRID_GPR_LOCAL_DELTA");
       m_iterations_completed = 0;
       
     }
@@ -360,12 +355,7 @@ bool BathyGrider::Iterate()
 	  m_grid_cons.updateCellValueIDX(i,m_cell_vars,cell_vals);
 	}
 	// Send out the delta and update
-	bool found_delta = false;
-	string delta_spec_gpr = m_grid_cons.getDeltaSpec(m_delta_thresh, found_delta);
-	if (found_delta) {
-	  Notify("VIEW_GRID_CONS_LOCAL_DELTA", delta_spec_gpr);
-	  m_grid_cons.setOldGridToNew();  // no more delta, we have sent all the updates
-	}
+	postGridDelta(m_grid_cons, "VIEW_GRID_CONS_LOCAL_DELTA");
 	// We will handle the variance spec in pGridSwitcher..
        	this->sendOutOwnEstimate();
 	m_cons_time = MOOSTime();
@@ -472,6 +462,14 @@ bool BathyGrider::OnStartUp()
 	m_delta_thresh = stod(value);
       }
 
+      else if (param == "DELTA_FORMAT") {
+	value = tolower(value);
+	if ((value == "text") or (value == "binary"))
+	  m_delta_format = value;
+	else
+	  reportUnhandledConfigWarning(orig);
+      }
+
       else {
         reportUnhandledConfigWarning(orig);
       }
@@ -598,6 +596,10 @@ bool BathyGrider::buildReport()
   std::string  con_spec = m_consensus.replyToRequestSpec();
   m_msgs << "    Last consensus spec length = " << con_spec.size() << endl;
   m_msgs << "    Number of cells = " << m_grid_gpr.size() << endl;
+  m_msgs << " -------------Grid Deltas------------------------------------  " << endl;
+  m_msgs << "    Delta format = " << m_delta_format << endl;
+  m_msgs << "    Deltas sent  = " << m_delta_msgs_posted << " ("
+	 << m_delta_bytes_posted << " bytes)" << endl;
 
   return(true);
 }
@@ -687,6 +689,34 @@ bool BathyGrider::handleConsensusSpec(string input, string &vname,
 }
 
 
+//-----------------------------------------------------
+//  Post the delta of this grid since the last post, if any,
+//  in either the text or binary form of XYGridUpdate.
+//  The binary form is run-length encoded and is typically
+//  several times smaller than the text.
+void BathyGrider::postGridDelta(EsriBathyGrid &grid, string var)
+{
+  bool found_delta = false;
+  if (m_delta_format == "binary") {
+    vector<unsigned char> data = grid.getDeltaBinary(m_delta_thresh, found_delta);
+    if (found_delta) {
+      Notify(var, data);
+      m_delta_bytes_posted += data.size();
+    }
+  } else {
+    string spec = grid.getDeltaSpec(m_delta_thresh, found_delta);
+    if (found_delta) {
+      Notify(var, spec);
+      m_delta_bytes_posted += spec.length();
+    }
+  }
+
+  if (found_delta) {
+    grid.setOldGridToNew();  // no more delta, we have sent all the updates
+    m_delta_msgs_posted++;
+  }
+}
+
 //-----------------------------------------------------
 //  Send out own estimate
 void BathyGrider::sendOutOwnEstimate() {
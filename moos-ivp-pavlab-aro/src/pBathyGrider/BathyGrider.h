@@ -39,6 +39,7 @@ class BathyGrider : public AppCastingMOOSApp
 			    double &deg_connectedness);
 
    void sendOutOwnEstimate();
+   void postGridDelta(EsriBathyGrid &grid, string var);
    double dist(std::vector<double> v1, std::vector<double> v2);
 
    
@@ -56,6 +57,7 @@ class BathyGrider : public AppCastingMOOSApp
    double m_no_data_value = 0;
    double m_delta_thresh = 0.01;         // only send delta info if greater than this
                                          // thresh.  0.1 = 10%
+   string m_delta_format = "text";       // text or binary (see XYGridUpdate)
 
    ////////////////////////////////
    // GPR parameters
@@ -131,6 +133,10 @@ class BathyGrider : public AppCastingMOOSApp
    int m_total_requests_initiated = 0;
    int m_total_requests_recieved = 0;
 
+   // Grid delta bookkeeping
+   int m_delta_msgs_posted = 0;
+   int m_delta_bytes_posted = 0;
+
    string m_vname = "";
 
 
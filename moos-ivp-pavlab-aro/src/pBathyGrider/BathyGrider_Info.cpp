@@ -118,6 +118,7 @@ void showExampleConfigAndExit()
   blk("                                                                ");
   blk(" delta_grid_update_thresh = 0.01 // delta will be send if       ");
   blk("			          // different by more than 0.1 = 10%  ");
+  blk(" delta_format = text             // default (text or binary)    ");
   blk("                                                                ");
   blk("}                                                               ");
   blk("                                                                ");
@@ -157,9 +158,10 @@ void showInterfaceAndExit()
   blk("                                                                ");
   blk("PUBLICATIONS:                                                   ");
   blk("------------------------------------                            ");
-  blk("  VIEW_GRID_GPR_LOCAL_DELTA                                     ");
+  blk("  VIEW_GRID_GPR_LOCAL_DELTA    = Grid delta, XYGridUpdate text  ");
+  blk("                                 or binary if delta_format=binary");
   blk("  VIEW_GRID_GPR_LOCAL          = Veiw grid spec                 ");
-  blk("  VIEW_GRID_CONS_LOCAL_DELTA                                    ");
+  blk("  VIEW_GRID_CONS_LOCAL_DELTA   = Same as above, consensus grid  ");
   blk("  VIEW_GRID_CONS_LOCAL         = Veiw grid spec                 ");
   blk("  GRIDCELL_XY                  = x,y pos for each grid          ");
   blk("                                                                ");
@@ -76,7 +76,11 @@ bool BathyPath::OnNewMail(MOOSMSG_LIST &NewMail)
       if (!m_first_grid_received)
 	reportRunWarning("Mail Error: Received a grid delta message before receiving the full grid.");
       
-      bool ok = m_grid.processGridDelta(sval);
+      bool ok = false;
+      if (msg.IsBinary())
+	ok = m_grid.processGridDelta(msg.GetBinaryDataAsVector());
+      else
+	ok = m_grid.processGridDelta(sval);
       if (not ok)
 	reportRunWarning("Mail Error: Did not process grid delta correctly");
       m_grid_deltas_rcvd++;
@@ -0,0 +1,446 @@
+/************************************************************/
+/*    NAME: agent                                           */
+/*    ORGN: MIT, Cambridge MA                               */
+/*    FILE: GridPlanBench.cpp                               */
+/*    DATE: October 19th, 2026                              */
+/************************************************************/
+
+// Benchmark of the bathymetry grid graph and A* search used by
+// pRoutePlan and pBathyPath, against the prior versions:
+//
+//   graph:  EsriBathyGrid building the cell graph plus the
+//           SimpleAStar::preloadGraph. The prior edge build
+//           scanned all edges for duplicates of each new edge,
+//           and the prior preload scanned all edges per vertex.
+//   regrid: a new full grid of the same layout, as on every
+//           consensus grid message (setXYConvexGrid).
+//   mask:   the obstacles after a grid delta, all cells tested
+//           (prior) or only the changed cells.
+//   search: A* from the top row to the bottom row, with the
+//           prior list based open and closed lists, and now
+//           with the heap. Both search the same graph.
+//
+// The prior graph build is quadratic in the grid cells, so it is
+// only run up to --max_old cells on a side, and the prior search
+// up to --max_old_search cells on a side.
+//
+//   gridplan_bench
+//   gridplan_bench --max_old=100 --max_old_search=200 --replans=5
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <map>
+#include <set>
+#include <list>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <algorithm>
+#include <chrono>
+#include "MBUtils.h"
+#include "ACTable.h"
+#include "XYFormatUtilsConvexGrid.h"
+#include "EsriBathyGrid.h"
+#include "SimpleAStar.h"
+#include "GraphNode.h"
+
+using namespace std;
+
+//--------------------------------------------------------
+// Procedure: oldGenerateEdges()
+//   Purpose: The prior EsriBathyGrid edge build. Neighbors are
+//            found by exact center coordinates and each edge is
+//            checked against all the edges so far.
+
+vector<pair<size_t,size_t> > oldGenerateEdges(const map<size_t, vector<double> >& V,
+					    double cell_size)
+{
+  map<vector<double>, size_t> reverseV;
+  map<size_t, vector<double> >::const_iterator p;
+  for(p=V.begin(); p!=V.end(); p++)
+    reverseV[p->second] = p->first;
+
+  double dx[] = {0, 1, 1, 1, 0, -1, -1, -1};
+  double dy[] = {1, 1, 0, -1, -1, -1, 0, 1};
+
+  vector<pair<size_t,size_t> > E;
+  for(size_t idx=0; idx<V.size(); idx++) {
+    vector<double> curr = V.at(idx);
+    for(int i=0; i<8; i++) {
+      vector<double> tmp;
+      tmp.push_back(curr[0] + dx[i] * cell_size);
+      tmp.push_back(curr[1] + dy[i] * cell_size);
+      if(reverseV.count(tmp) == 0)
+	continue;
+      pair<size_t,size_t> pair_a(idx, reverseV.at(tmp));
+      pair<size_t,size_t> pair_b(reverseV.at(tmp), idx);
+      bool in_vector = false;
+      vector<pair<size_t,size_t> >::reverse_iterator q;
+      for(q=E.rbegin(); q!=E.rend(); ++q) {
+	if((*q == pair_a) || (*q == pair_b))
+	  in_vector = true;
+      }
+      if(!in_vector)
+	E.push_back(pair_a);
+    }
+  }
+  return(E);
+}
+
+//--------------------------------------------------------
+// Procedure: oldPreload()
+//   Purpose: The prior SimpleAStar::preloadGraph into a map of
+//            Nodes. With scan_edges, the edges are scanned once
+//            per vertex as before. Otherwise the neighbors, in the
+//            same order, come from one pass, so the prior search
+//            can be timed on grids too big for the prior preload.
+
+void oldPreload(SimpleAStar& astar, const map<size_t, vector<double> >& V,
+		const vector<pair<size_t,size_t> >& E,
+		const set<size_t>& idx_start, const set<size_t>& idx_final,
+		bool scan_edges, map<size_t, Node>& node_map,
+		list<size_t>& seed)
+{
+  node_map.clear();
+  seed.clear();
+
+  map<size_t, vector<size_t> > nbrs;
+  if(!scan_edges) {
+    for(unsigned int k=0; k<E.size(); k++) {
+      nbrs[E[k].first].push_back(E[k].second);
+      nbrs[E[k].second].push_back(E[k].first);
+    }
+  }
+
+  map<size_t, vector<double> >::const_iterator it;
+  for(it=V.begin(); it!=V.end(); it++) {
+    Node new_node;
+    new_node.setNumber(it->first);
+    new_node.setG(0.0);
+    double h_min = numeric_limits<double>::infinity();
+    set<size_t>::const_iterator g;
+    for(g=idx_final.begin(); g!=idx_final.end(); g++) {
+      double h = astar.calcHeuristic(it->second, V.at(*g));
+      if(h < h_min)
+	h_min = h;
+    }
+    new_node.setH(h_min);
+
+    vector<size_t> possible_neighbors;
+    if(scan_edges) {
+      for(unsigned int k=0; k<E.size(); k++) {
+	if(E[k].first == it->first)
+	  possible_neighbors.push_back(E[k].second);
+	else if(E[k].second == it->first)
+	  possible_neighbors.push_back(E[k].first);
+      }
+    }
+    else
+      possible_neighbors = nbrs[it->first];
+    new_node.setNeighbors(possible_neighbors);
+    new_node.setPos(it->second);
+
+    if(idx_final.count(it->first) > 0)
+      new_node.setIsGoal(true);
+    if(idx_start.count(it->first) > 0) {
+      new_node.setIsStart(true);
+      new_node.setF(new_node.getH());
+    }
+    node_map[it->first] = new_node;
+  }
+
+  set<size_t>::const_reverse_iterator r;
+  for(r=idx_start.rbegin(); r!=idx_start.rend(); r++)
+    seed.push_back(*r);
+}
+
+//--------------------------------------------------------
+// Procedure: oldSearch()
+//   Purpose: The prior SimpleAStar::searchPathFast. The open and
+//            closed lists are std::lists, scanned for the lowest
+//            f and for each neighbor.
+
+vector<size_t> oldSearch(SimpleAStar& astar, map<size_t, Node>& node_map,
+			const list<size_t>& seed, const set<size_t>& Obs)
+{
+  list<size_t> open_list;
+  list<size_t>::const_iterator s;
+  for(s=seed.begin(); s!=seed.end(); s++) {
+    if(Obs.count(*s) == 0)
+      open_list.push_back(*s);
+  }
+  list<size_t> closed_list;
+
+  while(!open_list.empty()) {
+    double f_min = numeric_limits<double>::infinity();
+    size_t q = 0;
+    list<size_t>::iterator it;
+    for(it=open_list.begin(); it!=open_list.end(); ++it) {
+      double this_node_f = node_map.at(*it).getF();
+      if(this_node_f < f_min) {
+	f_min = this_node_f;
+	q = *it;
+      }
+    }
+    open_list.remove(q);
+
+    vector<size_t> neighbors_vec = node_map.at(q).getNeighbors();
+    vector<size_t>::iterator nb;
+    for(nb=neighbors_vec.begin(); nb!=neighbors_vec.end(); ++nb) {
+      if(Obs.count(*nb) == 1)
+	continue;
+
+      if(node_map.at(*nb).isGoal()) {
+	double g_min_to_goal = numeric_limits<double>::infinity();
+	size_t best_goal_node = *nb;
+	vector<size_t>::iterator gc;
+	for(gc=neighbors_vec.begin(); gc!=neighbors_vec.end(); ++gc) {
+	  if(node_map.at(*gc).isGoal() && (Obs.count(*gc) == 0)) {
+	    double this_node_g = astar.calcCost(node_map.at(*gc).getPos(),
+						node_map.at(q).getPos());
+	    if(this_node_g < g_min_to_goal) {
+	      g_min_to_goal = this_node_g;
+	      best_goal_node = *gc;
+	    }
+	  }
+	}
+	node_map.at(best_goal_node).setParent(q);
+	vector<size_t> path;
+	size_t step = best_goal_node;
+	path.push_back(step);
+	while(!node_map.at(step).isStart()) {
+	  step = node_map.at(step).getParent();
+	  path.push_back(step);
+	}
+	reverse(path.begin(), path.end());
+	return(path);
+      }
+
+      if(node_map.at(*nb).isStart())
+	continue;
+      double g_along = node_map.at(q).getG() +
+	astar.calcCost(node_map.at(*nb).getPos(), node_map.at(q).getPos());
+      double proposed = g_along + node_map.at(*nb).getH();
+
+      bool check_closed = true;
+      for(it=open_list.begin(); it!=open_list.end(); ++it) {
+	if(*nb == *it) {
+	  if(proposed < node_map.at(*it).getF()) {
+	    node_map.at(*it).setF(proposed);
+	    node_map.at(*it).setG(g_along);
+	    node_map.at(*it).setParent(q);
+	  }
+	  check_closed = false;
+	  break;
+	}
+      }
+
+      bool found_closed = false;
+      if(check_closed) {
+	for(it=closed_list.begin(); it!=closed_list.end(); ++it) {
+	  if(*nb == *it) {
+	    if(proposed < node_map.at(*it).getF()) {
+	      node_map.at(*it).setF(proposed);
+	      node_map.at(*it).setG(g_along);
+	      node_map.at(*it).setParent(q);
+	      closed_list.erase(it);
+	      open_list.push_back(*nb);
+	    }
+	    found_closed = true;
+	    break;
+	  }
+	}
+      }
+
+      if(check_closed && !found_closed) {
+	node_map.at(*nb).setParent(q);
+	node_map.at(*nb).setG(g_along);
+	node_map.at(*nb).setF(proposed);
+	open_list.push_back(*nb);
+      }
+    }
+    closed_list.push_back(q);
+  }
+  return(vector<size_t>());
+}
+
+//--------------------------------------------------------
+// Procedure: nowMsecs()
+
+double nowMsecs()
+{
+  using namespace std::chrono;
+  return(duration<double, milli>(steady_clock::now().time_since_epoch()).count());
+}
+
+//--------------------------------------------------------
+// Procedure: addSoundings()
+//   Purpose: Change the depth of some cells, as new soundings
+//            would. Shoals are made with probability 1/3.
+
+void addSoundings(EsriBathyGrid& grid, unsigned int amt)
+{
+  vector<string> vars;
+  vars.push_back("depth");
+  vars.push_back("var");
+  for(unsigned int k=0; k<amt; k++) {
+    unsigned int ix = rand() % grid.size();
+    vector<double> vals;
+    vals.push_back((rand() % 3 == 0) ? 2 : 10);
+    vals.push_back(0.1);
+    grid.updateCellValueIDX(ix, vars, vals);
+  }
+}
+
+//--------------------------------------------------------
+// Procedure: main
+
+int main(int argc, char *argv[])
+{
+  unsigned int max_old = 100;
+  unsigned int max_old_search = 200;
+  unsigned int replans = 5;
+
+  for(int i=1; i<argc; i++) {
+    string argi = argv[i];
+    if(strBegins(argi, "--max_old="))
+      max_old = atoi(argi.substr(10).c_str());
+    else if(strBegins(argi, "--max_old_search="))
+      max_old_search = atoi(argi.substr(17).c_str());
+    else if(strBegins(argi, "--replans="))
+      replans = atoi(argi.substr(10).c_str());
+    else {
+      cout << "Usage: gridplan_bench [--max_old=N] [--max_old_search=N] ";
+      cout << "[--replans=N]" << endl;
+      return(1);
+    }
+  }
+  if(replans == 0)
+    replans = 1;
+
+  double depth_threshold = 5;
+  double var_threshold = 0.5;
+  srand(1);
+
+  ACTable actab(10,2);
+  actab << "Cells | Old Graph | New Graph | Regrid | Old Mask | New Mask |";
+  actab << "Old Search | New Search | Speedup | Same Paths";
+  actab.addHeaderLines();
+
+  bool all_same = true;
+  unsigned int sides[] = {50, 100, 200, 500};
+  for(unsigned int k=0; k<4; k++) {
+    unsigned int side = sides[k];
+    string len = uintToString(side * 5);
+    string spec = "pts={0,0:" + len + ",0:" + len + "," + len + ":0," + len + "}";
+    spec += ",cell_size=5,cell_vars=depth:10:var:1,label=cons";
+    XYConvexGrid cgrid = string2ConvexGrid(spec);
+
+    // Graph, now
+    double new_graph_start = nowMsecs();
+    EsriBathyGrid grid(cgrid, 0, 0, 0);
+    set<unsigned int> top = grid.getCellsTop();
+    set<unsigned int> bot = grid.getCellsBottom();
+    set<size_t> start_ids(top.begin(), top.end());
+    set<size_t> end_ids(bot.begin(), bot.end());
+    map<size_t, vector<double> > V = grid.getVertices();
+    SimpleAStar astar;
+    astar.preloadGraph(V, grid.getEdges(), start_ids, end_ids, false);
+    double new_graph_ms = nowMsecs() - new_graph_start;
+
+    // Graph, before
+    vector<pair<size_t,size_t> > E = grid.getEdges();
+    map<size_t, Node> node_map;
+    list<size_t> seed;
+    string old_graph = "-";
+    if(side <= max_old) {
+      double old_graph_start = nowMsecs();
+      vector<pair<size_t,size_t> > old_E = oldGenerateEdges(V, 5);
+      oldPreload(astar, V, old_E, start_ids, end_ids, true, node_map, seed);
+      double old_graph_ms = nowMsecs() - old_graph_start;
+      if(old_E != E)
+	all_same = false;
+      old_graph = doubleToString(old_graph_ms, 1);
+    }
+    else
+      oldPreload(astar, V, E, start_ids, end_ids, false, node_map, seed);
+
+    // A new full grid of the same layout
+    double regrid_start = nowMsecs();
+    grid.setXYConvexGrid(cgrid);
+    double regrid_ms = nowMsecs() - regrid_start;
+
+    double old_mask_ms = 0;
+    double new_mask_ms = 0;
+    double old_search_ms = 0;
+    double new_search_ms = 0;
+    bool same = true;
+    addSoundings(grid, side * side / 4);
+    grid.getObstacleMask(depth_threshold, var_threshold);
+    for(unsigned int r=0; r<replans; r++) {
+      addSoundings(grid, side * side / 100);
+
+      // Every cell tested, as the prior getObstacles did
+      double old_mask_start = nowMsecs();
+      set<size_t> obs;
+      for(unsigned int ix=0; ix<grid.size(); ix++) {
+	double x, y, depth, var;
+	grid.getCellData(ix, x, y, depth, var);
+	if((depth < depth_threshold) && (var < var_threshold))
+	  obs.insert(ix);
+      }
+      old_mask_ms += nowMsecs() - old_mask_start;
+
+      double new_mask_start = nowMsecs();
+      const vector<unsigned char>& mask =
+	grid.getObstacleMask(depth_threshold, var_threshold);
+      new_mask_ms += nowMsecs() - new_mask_start;
+
+      vector<size_t> old_path;
+      if(side <= max_old_search) {
+	double old_search_start = nowMsecs();
+	old_path = oldSearch(astar, node_map, seed, obs);
+	old_search_ms += nowMsecs() - old_search_start;
+      }
+
+      double new_search_start = nowMsecs();
+      vector<size_t> new_path = astar.searchPathFast(mask);
+      new_search_ms += nowMsecs() - new_search_start;
+
+      if((side <= max_old_search) && (old_path != new_path))
+	same = false;
+    }
+    if(!same)
+      all_same = false;
+
+    double old_ms = old_search_ms / replans;
+    double new_ms = new_search_ms / replans;
+    string old_search = "-";
+    string speedup = "-";
+    string same_str = "-";
+    if(side <= max_old_search) {
+      old_search = doubleToString(old_ms, 1);
+      if(new_ms > 0)
+	speedup = doubleToString(old_ms / new_ms, 1);
+      same_str = boolToString(same);
+    }
+    actab << uintToString(side) + "x" + uintToString(side) << old_graph;
+    actab << doubleToString(new_graph_ms, 1);
+    actab << doubleToString(regrid_ms, 1);
+    actab << doubleToString(old_mask_ms / replans, 2);
+    actab << doubleToString(new_mask_ms / replans, 2);
+    actab << old_search << doubleToString(new_ms, 2);
+    actab << speedup << same_str;
+  }
+
+  cout << "Bathy grid planning, times in ms, " << replans << " replans per grid";
+  cout << endl << endl << actab.getFormattedString() << endl << endl;
+
+  if(!all_same) {
+    cout << "MISMATCH: graph or paths differ from the prior version" << endl;
+    return(1);
+  }
+  cout << "Graphs and paths match the prior version." << endl;
+  return(0);
+}
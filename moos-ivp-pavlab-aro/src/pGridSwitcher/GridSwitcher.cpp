@@ -79,7 +79,11 @@ bool GridSwitcher::OnNewMail(MOOSMSG_LIST &NewMail)
 	reportRunWarning("Unhandled Mail: Error reading full grid message");
 
     } else if (m_input_vars_delta.count(key) >= 1) {
-      bool ok2 = handleDeltaGridMsg(sval);
+      bool ok2 = false;
+      if (msg.IsBinary())
+	ok2 = handleDeltaGridMsg(msg.GetBinaryDataAsVector());
+      else
+	ok2 = handleDeltaGridMsg(sval);
       if (not ok2)
 	reportRunWarning("Unhandled Mail: Error reading delta grid message");
 
@@ -640,6 +644,25 @@ bool GridSwitcher::handleDeltaGridMsg(std::string sval)
 {
   // This is one of the input delta grids
   XYGridUpdate update = stringToGridUpdate(sval);
+  return(handleDeltaGridUpdate(update));
+}
+
+//---------------------------------------------------------
+// Procedure handleDeltaGridMsg
+//     Same as above, but for a delta posted in the binary
+//     form of XYGridUpdate (pBathyGrider delta_format=binary)
+bool GridSwitcher::handleDeltaGridMsg(const std::vector<unsigned char>& data)
+{
+  XYGridUpdate update;
+  if ((data.size() == 0) or !update.setFromBinary(&data[0], data.size()))
+    return(false);
+  return(handleDeltaGridUpdate(update));
+}
+
+//---------------------------------------------------------
+// Procedure handleDeltaGridUpdate
+bool GridSwitcher::handleDeltaGridUpdate(const XYGridUpdate& update)
+{
   if(not update.valid())
     return(false);
   
@@ -647,7 +670,7 @@ bool GridSwitcher::handleDeltaGridMsg(std::string sval)
   
   // Check if we already have the full grid for this delta
   if (m_grids_received.find(delta_grid_label) != m_grids_received.end()) {
-    bool ok = m_grids_received.at(delta_grid_label).processGridDelta(sval);
+    bool ok = m_grids_received.at(delta_grid_label).processGridDelta(update);
     if (not ok)
       return(false);
     
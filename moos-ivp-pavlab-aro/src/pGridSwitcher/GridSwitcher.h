@@ -38,6 +38,8 @@ class GridSwitcher : public AppCastingMOOSApp
    bool handleConfigInputVars(std::string val);
    bool handleFullGridMsg(std::string sval);
    bool handleDeltaGridMsg(std::string sval);
+   bool handleDeltaGridMsg(const std::vector<unsigned char>& data);
+   bool handleDeltaGridUpdate(const XYGridUpdate& update);
    void mirrorPoint(double p1x, double p1y, double &p2x, double &p2y);
 
    
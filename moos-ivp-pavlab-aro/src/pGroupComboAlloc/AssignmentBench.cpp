@@ -0,0 +1,316 @@
+/************************************************************/
+/*    NAME: agent                                           */
+/*    ORGN: MIT, Cambridge MA                               */
+/*    FILE: AssignmentBench.cpp                             */
+/*    DATE: October 19th, 2026                              */
+/************************************************************/
+
+// Benchmark of AssignmentEngine against HungarianAlgorithm on
+// agent-to-intruder distance costs. Three workloads:
+//
+//   cold:   One assignment from scratch, N agents by N intruders
+//   warm:   Re-solve after two agents have moved
+//   rounds: The pGroupComboAlloc allocation, with fewer agents than
+//           intruders. Baseline is its loop of std::map cost map,
+//           vector matrix and Solve() per round, until every
+//           intruder is assigned.
+//
+//   assign_bench
+//   assign_bench --msecs=200
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <cstdlib>
+#include <cmath>
+#include <chrono>
+#include "Hungarian.h"
+#include "AssignmentEngine.h"
+
+using namespace std;
+
+static double g_msecs = 100;
+
+//---------------------------------------------------------
+// Procedure: nowMsecs()
+
+double nowMsecs()
+{
+  using namespace std::chrono;
+  return(duration<double, milli>(steady_clock::now().time_since_epoch()).count());
+}
+
+//---------------------------------------------------------
+// Procedure: randomPositions()
+
+vector<double> randomPositions(unsigned int amt)
+{
+  vector<double> vals;
+  for(unsigned int i=0; i<amt; i++)
+    vals.push_back((rand() % 20001) / 10.0);
+  return(vals);
+}
+
+//---------------------------------------------------------
+// Procedure: distMatrix()
+
+vector<vector<double> > distMatrix(const vector<double>& ax,
+				   const vector<double>& ay,
+				   const vector<double>& tx,
+				   const vector<double>& ty)
+{
+  vector<vector<double> > matrix(ax.size(), vector<double>(tx.size()));
+  for(unsigned int i=0; i<ax.size(); i++)
+    for(unsigned int j=0; j<tx.size(); j++)
+      matrix[i][j] = hypot(ax[i]-tx[j], ay[i]-ty[j]);
+  return(matrix);
+}
+
+//---------------------------------------------------------
+// Procedure: baselineRounds()
+//   Purpose: The allocation loop of pGroupComboAlloc, minus the
+//            MOOS postings. Cost map keyed on names, rebuilt to a
+//            vector matrix and solved fresh for each round.
+
+double baselineRounds(const vector<string>& agents,
+		      const vector<string>& intruders,
+		      const vector<vector<double> >& costs,
+		      map<string, vector<string> >& assignments)
+{
+  map<string, map<string, double> > cost_map;
+  for(unsigned int i=0; i<agents.size(); i++)
+    for(unsigned int j=0; j<intruders.size(); j++)
+      cost_map[agents[i]][intruders[j]] = costs[i][j];
+
+  assignments.clear();
+  set<string> allocated;
+  double total = 0;
+  unsigned int count = 0;
+  while((allocated.size() < intruders.size()) && (count++ < 100)) {
+    map<string, map<string, double> >::iterator p;
+    for(p=cost_map.begin(); p!=cost_map.end(); p++) {
+      map<string, double>::iterator q;
+      for(q=p->second.begin(); q!=p->second.end();) {
+	if(allocated.count(q->first))
+	  p->second.erase(q++);
+	else
+	  ++q;
+      }
+    }
+
+    vector<string> intruder_vec, agent_vec;
+    map<string, double>::iterator q;
+    for(q=cost_map.begin()->second.begin(); q!=cost_map.begin()->second.end(); q++)
+      intruder_vec.push_back(q->first);
+    for(p=cost_map.begin(); p!=cost_map.end(); p++)
+      agent_vec.push_back(p->first);
+
+    vector<vector<double> > matrix;
+    for(unsigned int i=0; i<agent_vec.size(); i++) {
+      vector<double> cost_vec;
+      for(unsigned int j=0; j<intruder_vec.size(); j++)
+	cost_vec.push_back(cost_map[agent_vec[i]][intruder_vec[j]]);
+      matrix.push_back(cost_vec);
+    }
+
+    HungarianAlgorithm hung_algo;
+    vector<int> assignment;
+    total += hung_algo.Solve(matrix, assignment);
+    for(unsigned int i=0; i<assignment.size(); i++) {
+      if(assignment[i] < 0)
+	continue;
+      assignments[intruder_vec[assignment[i]]].push_back(agent_vec[i]);
+      allocated.insert(intruder_vec[assignment[i]]);
+    }
+  }
+  return(total);
+}
+
+//---------------------------------------------------------
+// Procedure: engineRounds()
+
+double engineRounds(AssignmentEngine& engine,
+		    const vector<string>& agents,
+		    const vector<string>& intruders,
+		    const vector<vector<double> >& costs,
+		    map<string, vector<string> >& assignments)
+{
+  engine.setCosts(costs);
+  double total = engine.solveRounds();
+
+  assignments.clear();
+  for(unsigned int j=0; j<intruders.size(); j++) {
+    int row = engine.getColumnRow(j);
+    if(row >= 0)
+      assignments[intruders[j]].push_back(agents[row]);
+  }
+  return(total);
+}
+
+//---------------------------------------------------------
+// Procedure: printRow()
+
+void printRow(string label, double old_us, double new_us, bool same)
+{
+  cout << "  " << left << setw(10) << label << right;
+  cout << fixed << setprecision(1);
+  cout << setw(14) << old_us << setw(14) << new_us;
+  cout << setw(10) << (old_us / new_us) << "x";
+  cout << setw(8) << (same ? "yes" : "NO") << endl;
+}
+
+//---------------------------------------------------------
+// Procedure: main
+
+int main(int argc, char *argv[])
+{
+  for(int i=1; i<argc; i++) {
+    string argi = argv[i];
+    if(argi.find("--msecs=") == 0)
+      g_msecs = atof(argi.substr(8).c_str());
+    else {
+      cout << "Usage: assign_bench [--msecs=N]" << endl;
+      return(1);
+    }
+  }
+  srand(1);
+
+  unsigned int sizes[] = {8, 16, 32, 64};
+  string hdr = "              Hungarian (us)  Engine (us)   Speedup  Same";
+
+  //=========================================================
+  // Part 1: Cold solves
+  cout << "Cold solve, N agents by N intruders" << endl;
+  cout << hdr << endl;
+  for(unsigned int k=0; k<4; k++) {
+    unsigned int n = sizes[k];
+    vector<vector<double> > costs = distMatrix(randomPositions(n),
+					       randomPositions(n),
+					       randomPositions(n),
+					       randomPositions(n));
+    double old_cost = 0;
+    unsigned int reps = 0;
+    double start = nowMsecs();
+    while((nowMsecs() - start) < g_msecs) {
+      HungarianAlgorithm hung_algo;
+      vector<vector<double> > matrix = costs;
+      vector<int> assignment;
+      old_cost = hung_algo.Solve(matrix, assignment);
+      reps++;
+    }
+    double old_us = 1000 * (nowMsecs() - start) / reps;
+
+    double new_cost = 0;
+    reps = 0;
+    start = nowMsecs();
+    while((nowMsecs() - start) < g_msecs) {
+      AssignmentEngine engine;
+      engine.setCosts(costs);
+      new_cost = engine.solve();
+      reps++;
+    }
+    double new_us = 1000 * (nowMsecs() - start) / reps;
+    printRow(to_string(n) + "x" + to_string(n), old_us, new_us,
+	     fabs(old_cost - new_cost) < 1e-6);
+  }
+
+  //=========================================================
+  // Part 2: Warm re-solves, two agents moving each step
+  cout << endl << "Re-solve after 2 agents move" << endl;
+  cout << hdr << endl;
+  for(unsigned int k=0; k<4; k++) {
+    unsigned int n = sizes[k];
+    vector<double> ax = randomPositions(n);
+    vector<double> ay = randomPositions(n);
+    vector<double> tx = randomPositions(n);
+    vector<double> ty = randomPositions(n);
+
+    // Precompute the steps so both sides solve the same problems
+    unsigned int steps = 200;
+    vector<vector<vector<double> > > step_costs;
+    for(unsigned int s=0; s<steps; s++) {
+      for(unsigned int m=0; m<2; m++) {
+	unsigned int a = rand() % n;
+	ax[a] += (rand() % 201) - 100;
+	ay[a] += (rand() % 201) - 100;
+      }
+      step_costs.push_back(distMatrix(ax, ay, tx, ty));
+    }
+
+    bool same = true;
+    vector<double> old_costs(steps);
+    unsigned int reps = 0;
+    double start = nowMsecs();
+    while((nowMsecs() - start) < g_msecs) {
+      for(unsigned int s=0; s<steps; s++) {
+	HungarianAlgorithm hung_algo;
+	vector<vector<double> > matrix = step_costs[s];
+	vector<int> assignment;
+	old_costs[s] = hung_algo.Solve(matrix, assignment);
+      }
+      reps += steps;
+    }
+    double old_us = 1000 * (nowMsecs() - start) / reps;
+
+    reps = 0;
+    start = nowMsecs();
+    while((nowMsecs() - start) < g_msecs) {
+      AssignmentEngine engine;
+      for(unsigned int s=0; s<steps; s++) {
+	engine.setCosts(step_costs[s]);
+	double cost = engine.solve();
+	if(fabs(cost - old_costs[s]) > 1e-6)
+	  same = false;
+      }
+      reps += steps;
+    }
+    double new_us = 1000 * (nowMsecs() - start) / reps;
+    printRow(to_string(n) + "x" + to_string(n), old_us, new_us, same);
+  }
+
+  //=========================================================
+  // Part 3: Multi-round allocation as in pGroupComboAlloc
+  cout << endl << "Rounds until all intruders assigned, agents x intruders";
+  cout << endl << hdr << endl;
+  unsigned int agent_amts[]   = {4,  8, 16, 16, 64};
+  unsigned int intruder_amts[] = {16, 32, 32, 64, 64};
+  for(unsigned int k=0; k<5; k++) {
+    unsigned int na = agent_amts[k];
+    unsigned int nt = intruder_amts[k];
+    vector<string> agents, intruders;
+    for(unsigned int i=0; i<na; i++)
+      agents.push_back("blue_" + to_string(100 + i));
+    for(unsigned int j=0; j<nt; j++)
+      intruders.push_back("red_" + to_string(100 + j));
+    vector<vector<double> > costs = distMatrix(randomPositions(na),
+					       randomPositions(na),
+					       randomPositions(nt),
+					       randomPositions(nt));
+
+    map<string, vector<string> > old_assign, new_assign;
+    double old_cost = 0;
+    unsigned int reps = 0;
+    double start = nowMsecs();
+    while((nowMsecs() - start) < g_msecs) {
+      old_cost = baselineRounds(agents, intruders, costs, old_assign);
+      reps++;
+    }
+    double old_us = 1000 * (nowMsecs() - start) / reps;
+
+    AssignmentEngine engine;
+    double new_cost = 0;
+    reps = 0;
+    start = nowMsecs();
+    while((nowMsecs() - start) < g_msecs) {
+      new_cost = engineRounds(engine, agents, intruders, costs, new_assign);
+      reps++;
+    }
+    double new_us = 1000 * (nowMsecs() - start) / reps;
+    bool same = (fabs(old_cost - new_cost) < 1e-6) && (old_assign == new_assign);
+    printRow(to_string(na) + "x" + to_string(nt), old_us, new_us, same);
+  }
+  return(0);
+}
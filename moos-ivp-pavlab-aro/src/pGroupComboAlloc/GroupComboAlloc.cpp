@@ -543,117 +543,52 @@ void GroupComboAlloc::determineBestTargetToIntercept(bool include_own)
     return;
   }
 
-  // keep iterating until all samples have been allocated
-  // The number of samples is greater than the number of
-  // agents
-  // The cost map is recomputed each time.
-  int count = 0;
-  bool found_first_own_target = false;
-  bool rebuild_cost_map = true;
-  while (allocated_samples.size() < m_intruder_set.size()){
+  // Step 1. Build the cost matrix once. As before, the costs are
+  // not rebuilt between rounds, only the allocated intruders are
+  // dropped, so all the rounds are solved in one call.
+  buildCostMap(include_own, true, allocated_samples);
+  AssignmentEngine& engine = include_own ? m_assign_own : m_assign_others;
+  if (!loadCostsFromCostMap(engine)){
+    postAssignmentsMap(include_own, total_cost);
+    return;
+  }
 
-    count += 1;
-    if (count > 100)
-      break;
-    
-    // Step 1.  Get the cost matrix
-    // For some memory-related reason I cannot yet find, we
-    // need to copy of the Dist Matrix, clear the original, and
-    // and then reset it in this weird way. The majority of the
-    // code here is to do this process and print out the results
-    // for debugging.
-    buildCostMap(include_own, rebuild_cost_map, allocated_samples);
-
-    // Don't rebuild the cost map next time(s)
-    rebuild_cost_map = false;
-
-    std::vector<std::vector<double>> DistMatrix;
-    DistMatrix = getDistMatrixFromCostMap();
-  
-    std::vector<std::vector<double>> copyDistMatrix = DistMatrix;
-    DistMatrix.clear();
-    
-    std::vector<double> agent1_cost;
-    if (copyDistMatrix.size() > 0){
-      for (unsigned int j = 0; j < copyDistMatrix[0].size(); j++){
-	agent1_cost.push_back(copyDistMatrix[0][j]);
-      }
-    }
-    DistMatrix.push_back(agent1_cost);
-    
-    for (unsigned int i = 1; i < copyDistMatrix.size(); i++){ 
-      DistMatrix.push_back(copyDistMatrix[i]); 
-    }
-    
-    
-    // print it for debugging
-    /*
-    std::cout << "       Reallocated DistMatrix at:" << &DistMatrix << std::endl; 
-    for (unsigned int i = 0; i < DistMatrix.size(); i++){
-      std::cout << "i = " << uintToString(i) << " Cost Vec: ";
-      for (unsigned int j = 0; j < DistMatrix[i].size(); j++){
-	std::cout << doubleToStringX(DistMatrix[i][j], 2) << ", ";
-      }
-      std::cout << " the size was " << uintToString(DistMatrix[i].size()) << std::endl;
-    }
-    std::cout << std::endl;
-    */
-    
-    // Step 2. Solve it for this set of teammates 
-    std::vector<int> assignment;
-    double cost = HungAlgo.Solve(DistMatrix, assignment);
+  // Step 2. Solve, each round over the intruders not yet allocated
+  total_cost = engine.solveRounds(100);
+
+  // Step 3. Record the assignments in the same order as solved,
+  // round by round, teammates in order within a round.
+  unsigned int rounds = engine.getRounds();
+  unsigned int rows   = engine.rows();
+  std::vector<std::vector<int>> round_assignment(rounds, std::vector<int>(rows, -1));
+  for (unsigned int j = 0; j < engine.cols(); j++){
+    int row = engine.getColumnRow(j);
+    if (row >= 0)
+      round_assignment[engine.getColumnRound(j)][row] = j;
+  }
 
-    total_cost = total_cost + cost; 
-    
-    /*
-    std::cout << "  -->  Solved assignments with cost = " << doubleToStringX(cost, 4) << std::endl;
-    std::cout << "  ---> Assignments: ";
-    for (unsigned int i = 0; i < assignment.size(); i++){
-      std::cout << "i = " << uintToString(i) << " to task " << intToString(assignment[i]) << ", ";
-    }
-    std::cout << std::endl;
-    */
-    
-    // Step 3.  update the teammates that were assigned.
-    for (unsigned int i = 0; i < assignment.size(); i++){
-      if (assignment[i] == -1){
+  bool found_first_own_target = false;
+  for (unsigned int r = 0; r < rounds; r++){
+    for (unsigned int i = 0; i < rows; i++){
+      if (round_assignment[r][i] == -1){
 	// this agent was not assigned in this round
 	continue; 
       }
 
-      // this agent was assigned.  Record it
+      std::string intruder_assigned_to = m_intruder_vec[ round_assignment[r][i] ];
+      std::string name_of_teammate     = m_unalloc_teammates_vec[i];
 
-      // m_intruder_vec[ assignment[i] ] is the name of the intruder that the ith vehicle is
-      //                                 assigned to
-      std::string intruder_assigned_to =  m_intruder_vec[ assignment[i] ];
-
-      // m_unalloc_teammates_vec[i]      is the name of the ith unallocated teammate   
-      std::string name_of_teammate  = m_unalloc_teammates_vec[i];
-
-      if (m_assignments_map.count( intruder_assigned_to) == 0) {
-	// this is the first agent assigned, need something to push back to
-	std::vector<std::string> new_assignment_vec;
-	new_assignment_vec.push_back( name_of_teammate );
-	m_assignments_map[ intruder_assigned_to ] = new_assignment_vec; 
-	
-      } else {
-                       
-	m_assignments_map[ intruder_assigned_to ].push_back( name_of_teammate );
-      }
+      // The best teammate to intercept is first
+      m_assignments_map[ intruder_assigned_to ].push_back( name_of_teammate );
 
       // This sample/intruder was assigned, add it to the allocated set
       allocated_samples.insert(intruder_assigned_to);
 
       // This agent was assigned, add the extra cost
-      if (m_agent_already_assigned_cost.count(name_of_teammate) == 0){
-	m_agent_already_assigned_cost[name_of_teammate] =  m_assigned_cost;
-      } else {
-	m_agent_already_assigned_cost[name_of_teammate] = m_agent_already_assigned_cost[name_of_teammate] + m_assigned_cost;
-      }
+      m_agent_already_assigned_cost[name_of_teammate] += m_assigned_cost;
 
       // evesdrop on this for our own future reference;
       // only do so if we are actually participating
-      // This might be better to move somewhere else?
       bool actually_participating = (m_curr_option == m_active_option_name);
 
       if ((name_of_teammate == m_vname) && (actually_participating) && (!found_first_own_target)) {
@@ -664,8 +599,7 @@ void GroupComboAlloc::determineBestTargetToIntercept(bool include_own)
 	found_first_own_target = true;  // only post the first time
       }
     }
-      
-  } // end of while loop
+  }
 
   postAssignmentsMap(include_own, total_cost);
 
@@ -946,107 +880,55 @@ std::map<std::string, double>  GroupComboAlloc::getAgentCosts(std::string vname,
 
 
 //-----------------------------------------
-// Procedure:  builds the dist matrix from the current
-//             cost map.  Also updates two important vectors
-//             m_intruder_vec, and m_unalloc_teammates_vec with the
-//             if the teammate/intruder is still unallocated
-
-std::vector<std::vector<double>> GroupComboAlloc::getDistMatrixFromCostMap()
+// Procedure: loadCostsFromCostMap()
+//            Loads the current cost map into the engine. Also
+//            updates two important vectors m_intruder_vec, and
+//            m_unalloc_teammates_vec, giving the column and row
+//            order of the engine.
+//   Returns: false if there is nothing to assign, or the cost map
+//            is missing an entry
+
+bool GroupComboAlloc::loadCostsFromCostMap(AssignmentEngine& engine)
 {
+  m_intruder_vec.clear();
+  m_unalloc_teammates_vec.clear();
 
-  std::vector<std::vector<double>> new_matrix;
-  std::vector<std::vector<double>> empty_matrix;  // returned on error
-  
-  // first update the ordered vector of the set of intruders
-  // Just build from the cost map
-  std::vector<std::string> new_intruder_vec;
+  // The intruders are the keys of any one agent's costs
   std::map<std::string, std::map<std::string, double>>::iterator cm_it;
   cm_it = m_cost_map.begin();
-  if (cm_it != m_cost_map.end()){
-    // get the names of all the intruders from this map entry
-    std::map<std::string,double> first_agent_costs = cm_it->second;
-    std::map<std::string, double>::iterator it2;
-    for (it2 = first_agent_costs.begin(); it2 != first_agent_costs.end(); it2++){
-      new_intruder_vec.push_back(it2->first); 
-    }
-  }
-  
-  m_intruder_vec = new_intruder_vec;
-  Notify("INTRUDER_VEC", svectorToString(m_intruder_vec));
+  if (cm_it == m_cost_map.end())
+    return(false);
+  std::map<std::string, double>::iterator it2;
+  for (it2 = cm_it->second.begin(); it2 != cm_it->second.end(); it2++)
+    m_intruder_vec.push_back(it2->first); 
+  if (m_intruder_vec.size() == 0)
+    return(false);
 
-  // second update the ordered vector of the set of unallocated teammates.
-  // this will change as the agents are assigned and there is no longer
-  // vector of costs for them in the cost map
-  std::vector<std::string> new_unalloc_teammates_vec;
+  // Since we have already checked if each agent (and ourselves) is
+  // participating, the teammates are just the cost map keys
+  for (cm_it = m_cost_map.begin(); cm_it != m_cost_map.end(); cm_it++)
+    m_unalloc_teammates_vec.push_back(cm_it->first); 
 
-  // Just build from the cost map, since we have already checked if
-  // each agent (and ourselves) is participating
-  for (cm_it = m_cost_map.begin(); cm_it != m_cost_map.end(); cm_it++){
-    new_unalloc_teammates_vec.push_back(cm_it->first); 
-  }
-    
-  m_unalloc_teammates_vec = new_unalloc_teammates_vec;
+  Notify("INTRUDER_VEC", svectorToString(m_intruder_vec));
   Notify("UNALLOC_TEAMMATES_VEC", svectorToString(m_unalloc_teammates_vec));
-  
-  // Ok, now build the Dist Matrix
-  // at each step we check that the map contains the keys we are looking
-  // for.  This prevents unauthorized memory acces
-
-  std::vector<double> cost_vec;
-  
-  // for each teammate get the vector of costs
-  for (unsigned int i = 0; i < m_unalloc_teammates_vec.size(); i++){
-    cost_vec.clear();
-    
-    //    std::cout << "    ------ i=" << std::to_string(i) << " ------  " << std::endl;
-    // sanity check
-    if (m_cost_map.count(m_unalloc_teammates_vec[i]) == 0){
-      //std::cout << " Did not find teammate "<< m_unalloc_teammates_vec[i] << std::endl;
-      return (empty_matrix);
-    }
-    
-    for ( unsigned int j = 0; j < m_intruder_vec.size(); j++){
-      //      std::cout << "      ------ j=" << std::to_string(j) << " ------  " << std::endl;
-      
-      // another sanity check
-      if (m_cost_map[m_unalloc_teammates_vec[i]].count(m_intruder_vec[j]) == 0){
-	//std::cout << " Did not find intruder "<< m_intruder_vec[j] << std::endl;
-	return (empty_matrix);
-      }
-      
-      //            get the cost map from the ith unalloc teammate
-      //                          |                     and get the cost to
-      //                          |                     intercept the jth intruder
-      //                          |                             |
-      //                          *                             *
-      double cost = m_cost_map[m_unalloc_teammates_vec[i]][m_intruder_vec[j]];      
-      cost_vec.push_back(cost); 
-         
-    }
-    // now cost_vec is the cost for the ith teammate, so add it
-    new_matrix.push_back(cost_vec); 
-  }
 
-  // print it for debugging
-  /*
-  std::cout << " $$$ New Cost matrix  $$$ " << std::endl;
-  std::cout << "          Targets:    "; 
-  for ( unsigned int j = 0; j < m_intruder_vec.size(); j++){
-    std::cout <<  m_intruder_vec[j] << ",  "; 
-  }
-  std::cout << std::endl;
-  
-  for (unsigned int i = 0; i < new_matrix.size(); i++){
-    std::cout << "agent = " << m_unalloc_teammates_vec[i] << " Cost Vec: "; 
-
-    for (unsigned int j = 0; j < new_matrix[i].size(); j++){
-      std::cout << doubleToStringX(new_matrix[i][j], 2) << ", ";
+  // Keep the engine's storage if the team and intruders are the
+  // same size as the last iteration
+  unsigned int rows = m_unalloc_teammates_vec.size();
+  unsigned int cols = m_intruder_vec.size();
+  if ((engine.rows() != rows) || (engine.cols() != cols))
+    engine.setSize(rows, cols);
+
+  unsigned int i = 0;
+  for (cm_it = m_cost_map.begin(); cm_it != m_cost_map.end(); cm_it++, i++){
+    for (unsigned int j = 0; j < cols; j++){
+      it2 = cm_it->second.find(m_intruder_vec[j]);
+      if (it2 == cm_it->second.end())
+	return(false);
+      engine.setCost(i, j, it2->second);
     }
-    std::cout << std::endl;
   }
-  std::cout << std::endl;
-  */
-  return(new_matrix);  
+  return(true);
 }
 
 
@@ -14,7 +14,7 @@
 #include "NodeRecord.h"        // for node record
 #include "NodeRecordUtils.h"   // for processing incoming node reports
 #include "GeomUtils.h"         // for distPointToPoint
-#include "Hungarian.h"         // for HungarianAlgorithm to solve assignments
+#include "AssignmentEngine.h"  // to solve assignments
 #include "XYPoint.h"           // for waypoint updating
 #include "AngleUtils.h"        // for relAng
 #include "XYFormatUtilsPoint.h" // for string2Point
@@ -57,7 +57,7 @@ class GroupComboAlloc : public AppCastingMOOSApp
    double getCostToIntercept(std::string teammate, double intrd_x, double intrd_y);
   std::map<std::string, double>  getAgentCosts(std::string vname, std::set<std::string> allocated_samples);
 
-   std::vector<std::vector<double>> getDistMatrixFromCostMap();
+   bool   loadCostsFromCostMap(AssignmentEngine& engine);
   void postAssignmentsMap(bool include_own, double total_cost);
  
 
@@ -125,8 +125,10 @@ class GroupComboAlloc : public AppCastingMOOSApp
    //                      value is cost
    std::map<std::string, std::map<std::string, double> > m_cost_map;
 
-   std::vector<std::vector<double>> m_DistMatrix;
-   HungarianAlgorithm HungAlgo;
+   // One engine with own ship and one without, so each keeps its
+   // storage sized between iterations
+   AssignmentEngine m_assign_own;
+   AssignmentEngine m_assign_others;
 
    // assignements map
    // assignments_map:  key is the target name
@@ -0,0 +1,297 @@
+/************************************************************/
+/*    NAME: agent                                           */
+/*    ORGN: MIT, Cambridge MA                               */
+/*    FILE: OpinionBench.cpp                                */
+/*    DATE: October 19th, 2026                              */
+/************************************************************/
+
+// Benchmark of OpinionDynamics against the per-agent opinion update
+// that OpManagerEngine did before it used the dense core: every agent
+// formats its opinion message, every agent parses the messages of
+// its neighbors into OpinionRecords, and each option looks up each
+// neighbor's opinion by name. Debug output is left out of the
+// baseline. All agents hear all others.
+//
+// A check run first compares the two with messages at 10 digits,
+// where they should agree to rounding. The timed baseline uses 4
+// digits as pOpinionManager does.
+//
+//   opinion_bench
+//   opinion_bench --msecs=200
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <map>
+#include <list>
+#include <cstdlib>
+#include <cmath>
+#include <chrono>
+#include "MBUtils.h"
+#include "Option.h"
+#include "OpinionRecord.h"
+#include "OpinionDynamics.h"
+
+using namespace std;
+
+static double g_msecs = 100;
+
+// Attention parameters, the OpManagerEngine defaults
+static double g_tau_u = 10.0;
+static double g_u_min = 0.5;
+static double g_u_max = 1.5;
+static double g_u_th  = 0.1;
+static double g_hill  = 2.0;
+
+struct BaseAgent {
+  string name;
+  vector<double> z;
+  vector<double> b;
+  double u;
+  map<string, OpinionRecord> records;
+};
+
+//---------------------------------------------------------
+// Procedure: nowMsecs()
+
+double nowMsecs()
+{
+  using namespace std::chrono;
+  return(duration<double, milli>(steady_clock::now().time_since_epoch()).count());
+}
+
+//---------------------------------------------------------
+// Procedure: makeOptions()
+//   Purpose: A ring of options, each with a beta and delta
+//            coupling to the next option.
+
+vector<Option> makeOptions(unsigned int amt)
+{
+  vector<Option> options;
+  for (unsigned int j = 0; j < amt; j++) {
+    string next = "opt" + uintToString((j + 1) % amt);
+    list<string> spec;
+    spec.push_back("name = opt" + uintToString(j));
+    spec.push_back("option_output = OPTION=OPT" + uintToString(j));
+    spec.push_back("resistance_weight = 0.05");
+    spec.push_back("social_mode = custom");
+    spec.push_back("intra_agent_same_option_coupling = 0.2");
+    spec.push_back("intra_agent_inter_option_coupling = " + next + " = -0.1");
+    spec.push_back("inter_agent_same_option_coupling = 0.1");
+    spec.push_back("inter_agent_inter_option_coupling = " + next + " = -0.05");
+    spec.push_back("input = INPUT" + uintToString(j));
+    spec.push_back("input_function_type = none");
+    bool ok = false;
+    string warn;
+    options.push_back(buildOptionFromSpec(spec, ok, warn));
+  }
+  return(options);
+}
+
+//---------------------------------------------------------
+// Procedure: baselineStep()
+//   Purpose: One iteration of every agent, as OpManagerEngine did
+//            from its OpinionRecords.
+
+void baselineStep(vector<Option>& options, vector<BaseAgent>& agents,
+		  double time, double dt, int digits)
+{
+  unsigned int no = options.size();
+  map<string, unsigned int> names_hash;
+  for (unsigned int j = 0; j < no; j++)
+    names_hash[options[j].getOptionName()] = j;
+
+  // Each agent posts its message, and all others receive it
+  vector<string> msgs;
+  for (unsigned int i = 0; i < agents.size(); i++) {
+    string msg = agents[i].name + ":group:";
+    for (unsigned int j = 0; j < no; j++) {
+      msg += tolower(options[j].getOptionName()) + "=";
+      msg += doubleToString(agents[i].z[j], digits);
+      if (j < no - 1)
+	msg += ":";
+    }
+    msgs.push_back(msg);
+  }
+  for (unsigned int i = 0; i < agents.size(); i++) {
+    for (unsigned int k = 0; k < agents.size(); k++) {
+      if (k == i)
+	continue;
+      OpinionRecord record;
+      record.setRecordFromMsg(msgs[k], time);
+      agents[i].records[record.getVname()] = record;
+    }
+  }
+
+  for (unsigned int i = 0; i < agents.size(); i++) {
+    BaseAgent& agent = agents[i];
+    vector<double> F_i;
+    bool attention_updated = false;
+
+    for (unsigned int j = 0; j < no; j++) {
+      string option_name = options[j].getOptionName();
+
+      double term1 = options[j].getAlpha() * agent.z[j];
+      map<string, OpinionRecord>::iterator k;
+      for (k = agent.records.begin(); k != agent.records.end(); k++) {
+	double z_kj = 0;
+	if (!k->second.isOptionExist(option_name))
+	  continue;
+	k->second.getOpinionForOption(option_name, z_kj);
+	term1 += options[j].getGamma() * z_kj;
+      }
+
+      double term2 = 0;
+      map<string, double> betaMap = options[j].getBetaMap();
+      map<string, double>::iterator l;
+      for (l = betaMap.begin(); l != betaMap.end(); l++) {
+	double sum3 = l->second * agent.z[names_hash[l->first]];
+	map<string, double> deltaMap = options[j].getDeltaMap();
+	if (deltaMap.count(l->first)) {
+	  double delta_ik = deltaMap[l->first];
+	  for (k = agent.records.begin(); k != agent.records.end(); k++) {
+	    double z_kl = 0;
+	    if (!k->second.isOptionExist(l->first))
+	      continue;
+	    k->second.getOpinionForOption(l->first, z_kl);
+	    sum3 += delta_ik * z_kl;
+	  }
+	}
+	term2 += tanh(sum3);
+      }
+
+      if (!attention_updated) {
+	double sum1 = 0;
+	for (unsigned int m = 0; m < no; m++)
+	  sum1 += agent.z[m] * agent.z[m];
+	sum1 = sum1 / no;
+	for (k = agent.records.begin(); k != agent.records.end(); k++)
+	  sum1 += k->second.getOpinionsSquared();
+	double hill = pow(sum1, g_hill) / (pow(g_u_th, g_hill) + pow(sum1, g_hill));
+	double du_dt = (-agent.u + g_u_min + (g_u_max - g_u_min) * hill) / g_tau_u;
+	agent.u += du_dt * dt;
+	if (agent.u > g_u_max)
+	  agent.u = g_u_max;
+	if (agent.u < g_u_min)
+	  agent.u = g_u_min;
+	attention_updated = true;
+      }
+
+      double F_ij = -options[j].getDi() * agent.z[j] + agent.b[j] +
+	agent.u * (tanh(term1) + term2);
+      F_i.push_back(F_ij);
+    }
+
+    // Project, integrate with a unit gain, and project again
+    double f_mean = 0;
+    for (unsigned int j = 0; j < no; j++)
+      f_mean += F_i[j] / no;
+    double z_mean = 0;
+    for (unsigned int j = 0; j < no; j++) {
+      agent.z[j] += dt * (F_i[j] - f_mean);
+      z_mean += agent.z[j] / no;
+    }
+    for (unsigned int j = 0; j < no; j++)
+      agent.z[j] -= z_mean;
+  }
+}
+
+//---------------------------------------------------------
+// Procedure: setupBoth()
+//   Purpose: The same random start for both.
+
+void setupBoth(vector<Option>& options, unsigned int na,
+	       vector<BaseAgent>& agents, OpinionDynamics& dyn)
+{
+  unsigned int no = options.size();
+  dyn.setOptions(options);
+  dyn.setAgents(na);
+  dyn.setAllNeighbors();
+
+  agents.clear();
+  for (unsigned int i = 0; i < na; i++) {
+    BaseAgent agent;
+    agent.name = "abe" + uintToString(i);
+    agent.u = g_u_min;
+    for (unsigned int j = 0; j < no; j++) {
+      double z = ((rand() % 2001) - 1000) / 1e5;
+      double b = ((rand() % 2001) - 1000) / 1e4;
+      agent.z.push_back(z);
+      agent.b.push_back(b);
+      dyn.setOpinion(i, j, z);
+      dyn.setInput(i, j, b);
+    }
+    agents.push_back(agent);
+  }
+}
+
+//---------------------------------------------------------
+// Procedure: main
+
+int main(int argc, char *argv[])
+{
+  for (int i = 1; i < argc; i++) {
+    string argi = argv[i];
+    if (argi.find("--msecs=") == 0)
+      g_msecs = atof(argi.substr(8).c_str());
+    else {
+      cout << "Usage: opinion_bench [--msecs=N]" << endl;
+      return(1);
+    }
+  }
+  srand(1);
+  double dt = 0.1;
+
+  //=========================================================
+  // Part 1: Check, 20 agents by 6 options over 100 steps
+  vector<Option> options = makeOptions(6);
+  vector<BaseAgent> agents;
+  OpinionDynamics dyn;
+  setupBoth(options, 20, agents, dyn);
+  for (unsigned int s = 0; s < 100; s++) {
+    baselineStep(options, agents, s * dt, dt, 10);
+    dyn.step(dt);
+  }
+  double max_diff = 0;
+  for (unsigned int i = 0; i < agents.size(); i++) {
+    for (unsigned int j = 0; j < options.size(); j++)
+      max_diff = max(max_diff, fabs(agents[i].z[j] - dyn.getOpinion(i, j)));
+    max_diff = max(max_diff, fabs(agents[i].u - dyn.getAttention(i)));
+  }
+  cout << "Check: 20 agents x 6 options, 100 steps, max diff = ";
+  cout << scientific << setprecision(2) << max_diff << endl << endl;
+
+  //=========================================================
+  // Part 2: Time per step for all agents
+  cout << "One step of all agents, all hear all" << endl;
+  cout << "                  Records (us)    Dense (us)   Speedup" << endl;
+  unsigned int agent_amts[]  = {10, 50, 50, 100};
+  unsigned int option_amts[] = {4,  4,  16, 16};
+  for (unsigned int c = 0; c < 4; c++) {
+    options = makeOptions(option_amts[c]);
+    setupBoth(options, agent_amts[c], agents, dyn);
+
+    unsigned int reps = 0;
+    double start = nowMsecs();
+    while ((nowMsecs() - start) < g_msecs) {
+      baselineStep(options, agents, reps * dt, dt, 4);
+      reps++;
+    }
+    double old_us = 1000 * (nowMsecs() - start) / reps;
+
+    reps = 0;
+    start = nowMsecs();
+    while ((nowMsecs() - start) < g_msecs) {
+      dyn.step(dt);
+      reps++;
+    }
+    double new_us = 1000 * (nowMsecs() - start) / reps;
+
+    string label = uintToString(agent_amts[c]) + " x " + uintToString(option_amts[c]);
+    cout << "  " << left << setw(12) << label << right << fixed << setprecision(1);
+    cout << setw(14) << old_us << setw(14) << new_us;
+    cout << setw(9) << (old_us / new_us) << "x" << endl;
+  }
+  return(0);
+}
@@ -70,93 +70,14 @@ OpManagerEngine::~OpManagerEngine()
 //        options to the engine, and returns true if successful
 bool OpManagerEngine::handleOptConfig(std::string filename, std::string& warn_msg)
 {
-
-  std::list<std::string> config_lines;
-  bool found_config_start = false;
-
-  
-  // Step 1.  Open the file and read each line
-  std::ifstream file(filename);
-  if (file.is_open()) {
-    std::string line;
-    while (std::getline(file, line)) {
-
-      // remove comments
-      std::string stripped_line = biteStringX(line, '/');
-      std::cout << " stripped_line = " << stripped_line << std::endl;
-
-      if (stripped_line == "") {
-	continue; 
-      }
-
-      // Process the line
-      if (stripped_line == "social_option"){
-	// check if another block was found and not properly handled.
-	if (found_config_start) {
-	  warn_msg = "Opinion Manager Error: Encountered a config block that was not closed";
-	  file.close();
-	  return(false);
-	}
-	std::cout << "  Setting found_config_start = true" << std::endl;
-	found_config_start = true;
-	
-      } else if ( (stripped_line != "{") && (stripped_line != "}") && found_config_start) {
-	// must be a valid line, add this line to the vector of strings to process
-	config_lines.push_back(stripped_line);
-	std::cout << "  Pushing_back line" << std::endl;
-	
-      } else if (( stripped_line == "{") && !found_config_start) {
-	// error here, found an opening bracket, but no start
-	std::cout << "  Error here, found an opening bracket, but no start"  << std::endl;
-	warn_msg = "Opinion Manager Error: Encountered a config block that was not started properly";
-	file.close();
-	return(false);
-
-      } else if (( stripped_line == "}") && !found_config_start) {
-	// error here, found an closing bracket, but no start
-	warn_msg = "Opinion Manager Error: Encountered a config block that was not started properly";
-	file.close();
-	std::cout << "  Error here encountered a config block that was not started properly" << std::endl;
-	return(false);
-
-      }	else if (( stripped_line == "}") && found_config_start) {
-	// found a valid closing bracket, process this block
-	std::cout << "  Found a valid closing bracket, processing this block" << std::endl;
-	std::string temp_warn_msg = "";
-	bool ok = false;
-	Option new_option = buildOptionFromSpec(config_lines, ok, temp_warn_msg);
-
-	std::cout << "   Processed option ok = " << std::to_string(ok) << std::endl; 
-	if (ok)  {
-	  m_options.push_back(new_option);
-	  std::string new_option_name = new_option.getOptionName();
-	  m_option_names_hash[new_option_name] = static_cast<unsigned int>( m_options.size() -1 ); // will always be last
-	} else {
-	  warn_msg = temp_warn_msg;
-	  file.close();
-	  std::cout << "   Warn message = " << temp_warn_msg << std::endl;
-	  return(false);
-	}
-	
-	// reset
-	config_lines.clear();
-	found_config_start = false;
-	std::cout << "  Reset config" << std::endl;
-      }
-      // ignore the rest of the lines
-      
-    }  // end of while reading file
-    
-    file.close();
-  } else {
-    warn_msg = "Opinion Manager Error: Cannot open config file";
+  std::vector<Option> new_options;
+  if (!readOptionsFromFile(filename, new_options, warn_msg))
     return(false);
-  }
 
-  // Did we read at least one option?
-  if (m_options.size() < 1) {
-    warn_msg = "Opinion Manager Error: Opened file but did not find any config blocks";
-    return(false);
+  for (unsigned int i = 0; i < new_options.size(); i++) {
+    m_options.push_back(new_options[i]);
+    std::string new_option_name = new_options[i].getOptionName();
+    m_option_names_hash[new_option_name] = static_cast<unsigned int>( m_options.size() -1 ); // will always be last
   }
 
   // Run set up with a dummy time for safety
@@ -179,6 +100,9 @@ bool OpManagerEngine::setupOpinionManager(double time)
 
   // Initialize opinions to be nuetral
   resetOpinionState(time, 0.0);
+
+  // The dynamics core holds the couplings as dense matrices
+  m_dynamics.setOptions(m_options);
   
   // Initialize opinion_inputs to be zero
   for (int i = 0; i < m_options.size(); i++) {
@@ -229,6 +153,8 @@ bool OpManagerEngine::resetOpinionState(double time_now,
   // Clear out any records we have.  This is done to
   // completely reset all local messages
   m_neighbor_opinion_records.clear();
+  m_neighbor_opinion_vecs.clear();
+  m_neighbor_opinion_sqs.clear();
 
   m_reset_time_cmd = time_now;
   m_reset_time_interval = reset_time_interval;   
@@ -294,6 +220,14 @@ bool OpManagerEngine::receiveOpinionMessage(std::string optn_msg, double msg_tim
   
   std::string vname = new_record.getVname();
   m_neighbor_opinion_records[vname] = new_record;  // overwrites old, assumes unique names
+
+  // Keep the opinions by own option index, so they are looked up
+  // by name once here rather than on every iteration
+  std::vector<double> opinion_vec(m_options.size(), 0.0);
+  for (unsigned int j = 0; j < m_options.size(); j++)
+    new_record.getOpinionForOption(m_options[j].getOptionName(), opinion_vec[j]);
+  m_neighbor_opinion_vecs[vname] = opinion_vec;
+  m_neighbor_opinion_sqs[vname]  = new_record.getOpinionsSquared();
   
   if (m_neighbor_opinion_rec.count(vname)) {
     // Key exists
@@ -355,251 +289,55 @@ bool OpManagerEngine::receiveOpinionMessage(std::string optn_msg, double msg_tim
 //                  input_vars_buffer['Option Name'] = option 
 bool OpManagerEngine::iterateOwnOpinion(double time)
 {
-  // Mark when attention is updated, only update once.
-  bool attention_updated = false;
-  
   // Safety check
   if ( !(this->readyToCalculate(time)) )
       return(false);
 
   // First determine which options are active
   std::vector<bool> options_status = determineOptionActive();
+  unsigned int numb_options = options_status.size();
+  if (numb_options == 0)
+    return(false);
 
-  std::cout << " options_status = ";
-  for (int i = 0; i <options_status.size(); i++) {
-    std::cout << boolToString(options_status[i]) << ", ";
-  }
-  std::cout << ";" << std::endl;
-  
-  // initialize and book keeping
-  double F_ij;
-  std::vector<double> F_i;
-  std::vector<double> b_i; 
-
-  std::cout << " Starting to iterate through each option" << std::endl;
-  // Loop through each option
-  for (unsigned int j=0; j<options_status.size(); j++){
-    // check if active
-    if (!options_status[j]){
+  // Step 1:  Sum the opinions of all neighbors with fresh records,
+  //          for every option at once. Options not in a neighbor's
+  //          record are zero. 
+  std::vector<double> nsum(numb_options, 0.0);
+  double nsq = 0.0;
+  std::map<std::string, OpinionRecord>::iterator k; 
+  for (k=m_neighbor_opinion_records.begin(); k!=m_neighbor_opinion_records.end(); k++){
+    if ((time - k->second.getTime()) > m_stale_thresh)
       continue;
-    }
-
-    // initialize and book keeping
-    std::string option_name = m_options[j].getOptionName();
-
-    std::cout << "  -> Updating option j=" << uintToString(j) << " with name =" << option_name << std::endl;
-    
-    // Steps 1-5: Opinion dynamics 
-    //            lines 3a and 3b of arxiv.org/pdf/2009.04332.pdf
-    // 
-    // Step 1    computes the term alpha_ij * z_ij + sum( gamma_ik * z_kj)
-    // Step 2.1  computes the term: beta_ij * z_ij
-    // Step 2.2  computes each term in the summation sum( delta_ik * z_kl)
-    // Step 2.3  computes the summation sum( S_2 ( ... from Step 2.1 + from Step 2.2 ...) )
-    // Step 3    computes the active attention u_i
-    // Step 4    computes the input term b_ij
-    // Step 5    adds all the terms to compute F_ij
-    
-    
-    // Step 1: Same option coupling
-    double term1 = m_options[j].getAlpha() * m_opinions[j];
-    std::cout << " Step 1: Calculating Term1" << std::endl;
-    
-    std::map<std::string, OpinionRecord>::iterator k; 
-    for (k=m_neighbor_opinion_records.begin(); k!=m_neighbor_opinion_records.end(); k++){
-
-      double z_kj = 0;
-      bool ok = false;
-      if ( k->second.isOptionExist(option_name)){
-	ok = k->second.getOpinionForOption(option_name, z_kj); 
-      } else {
-	// this option is not in the neighbors record.
-	std::cout << "  This option is not in the neighbors record" << std::endl;
-	continue; 
-      }
-      
-      // check if stale or if not ok
-      if ( ((time - k->second.getTime()) > m_stale_thresh) || !ok ) {
-	std::cout << "  This options was found to be too stale" << std::endl;
-	continue; 
-      }
-      std::cout << "  Found neighbor opinion of z_kj = " << doubleToString(z_kj) << " and the gamma = " << doubleToString( m_options[j].getGamma() ) << std::endl;
-      term1 +=  m_options[j].getGamma() * z_kj;
-      std::cout << "  Term1 = " << doubleToString(term1) << std::endl; 
-    }
-
-
-    // Step 2  inter-option coupling
-    double term2 = 0;
-    // For all the beta couplings to other options, find the cooresponding
-    // opinion value (state) if the option is active,
-
-    std::cout << " Steps 2.1 - 2.3 Calculating Term2" << std::endl;
-
-    std::map<std::string, double> betaMap = m_options[j].getBetaMap();
-    std::map<std::string, double>::iterator l;
-    for (l = betaMap.begin(); l != betaMap.end(); l++) {
-
-      // Step 2.1  Calculate the intra agent different opinion for this
-      // opinion. 
-      double sum3 = 0.0;  // This is for the inner summation
-      std::string other_option_name = l->first;
-      double beta_il = l->second; 
-
-      std::cout << "  -> Found other option name = " << other_option_name << " with beta_il = " << doubleToString(beta_il) << std::endl;
-      // Is this option active on own vehicle? 
-      if (options_status[m_option_names_hash[other_option_name]]) {
-	std::cout << "     This other option is active on own vehicle with opinion = " << doubleToString(m_opinions[m_option_names_hash[other_option_name]]) << std::endl;
-	// add it to the sum
-	sum3 += beta_il * m_opinions[m_option_names_hash[other_option_name]];
-	std::cout << "     Added it to the sum3, which now =" << doubleToString(sum3) << std::endl;
-	
-      }
-
-      // Step 2.2 Find any neighbors who have opinions about this other option
-      // and add the influence
-
-      // Get the delta weight for this other option, if it exists, then add
-      // all the weighed opinions of the neighbors. 
-      std::map<std::string, double> deltaMap = m_options[j].getDeltaMap();
-      if (deltaMap.count(other_option_name)){
-	double delta_ik = deltaMap[other_option_name];
+    const std::vector<double>& z_k = m_neighbor_opinion_vecs[k->first];
+    for (unsigned int j = 0; (j < numb_options) && (j < z_k.size()); j++)
+      nsum[j] += z_k[j];
+    nsq += m_neighbor_opinion_sqs[k->first];
+  }
 
-	std::cout << "  -> Found other option on other vehicle = " << other_option_name << " with delta_ik = " << doubleToString(delta_ik) << std::endl;
-      
-	// Reuse iterator k here:
-	for (k=m_neighbor_opinion_records.begin(); k!=m_neighbor_opinion_records.end(); k++){
-	  
-	  double z_kl = 0;
-	  bool ok = false;
-	  if ( k->second.isOptionExist(other_option_name)){
-	    ok = k->second.getOpinionForOption(other_option_name, z_kl); 
-	  } else {
-	  // this option is not in the neighbors record.
-	    continue; 
-	  }
-	  
-	  // check if stale or if not ok
-	  if ( ((time - k->second.getTime()) > m_stale_thresh) || !ok ) {
-	    continue; 
-	  }
-
-	  std::cout << "     This other option is active on other vehicle with opinion z_kl = " << doubleToString(z_kl) << std::endl;
-	  
-	  //
-	  // Otherwise add it to the sum
-	  sum3 += delta_ik * z_kl;
-	  std::cout << "     Added it to the sum3, which now =" << doubleToString(sum3) << std::endl;
-	}
-	
-      } // end of if delta exists.  If it does not, then all the contributions from
-      // the neighbors opinions are zero anyways, so they are skipped. 
-
-
-      // Step 2.3  Now add this influence to the outer sum
-      std::cout << "     The sigmoid of sum3 is  =" << doubleToString(sigmoid(sum3)) << std::endl;
-      term2 += sigmoid(sum3); 
-
-      std::cout << "     Adding it to the term2, which now =" << doubleToString(term2) << std::endl;
-      
-    }  // end of beta map loop
-    
-    // Step 3:  Calculate the attention parameter using the dynamic update
-    //          Updates the attention parameter m_u_i;
-    std::cout << " Step 3:  Updating attention " << std::endl;
-    if ( !attention_updated ){
-      this->updateAttention(time, options_status);
-      attention_updated = true; 
-    }
-    std::cout << "   Attention was updated to m_u_i = " << m_u_i << std::endl;
-    
-    // Step 4:  Calculate the input bias for this option
-    double b_ij = 0.0;
-    std::cout << " Step 4:  Calculating the input bias " << std::endl;
-    
+  // Step 2:  Calculate the input bias for each active option
+  std::vector<double> b_i(numb_options, 0.0);
+  for (unsigned int j = 0; j < numb_options; j++){
+    if (!options_status[j])
+      continue;
     std::string input_var_for_this_option  = m_options[j].getInputVar();
     if (m_info_buff.isKnown(input_var_for_this_option)) {
-      // get the value (string only at this time
       bool found_in_buffer = false;
-      double dbl_buffer_val = 0.0;
-      dbl_buffer_val = m_info_buff.dQuery(input_var_for_this_option, found_in_buffer);
-      if ((found_in_buffer) ) {
-	std::cout << "   -> Found input variable in buffer = " << doubleToString(dbl_buffer_val) << std::endl;
-	b_ij = m_options[j].computeInputB(dbl_buffer_val);
-	
-	std::cout << "      And computed input b_ij = " << doubleToString(b_ij) << std::endl;
-      } else {
-	// not found in buffer, or something went wrong
-	b_ij = 0.0;
-      }
-    } else {
-      // value not known in the buffer
-      b_ij = 0.0; 
+      double dbl_buffer_val = m_info_buff.dQuery(input_var_for_this_option, found_in_buffer);
+      if (found_in_buffer)
+	b_i[j] = m_options[j].computeInputB(dbl_buffer_val);
     }
-    b_i.push_back(b_ij); 
-
-    std::cout << " Step 5:  Adding all terms together " << std::endl;
-    std::cout << "    *-> -m_options[j].getDi() * m_opinions[j] = " << doubleToString(-m_options[j].getDi() * m_opinions[j]) << std::endl;
-    std::cout << "    *-> b_ij = " << doubleToString(b_ij) << std::endl;
-    std::cout << "    *-> m_u_i * ( sigmoid(term1) + term2 ) = " << doubleToString(m_u_i * ( sigmoid(term1) + term2 )) << std::endl;
-    
-
-    
-    // Step 5:  All terms are calcuated, add together
-    F_ij = -m_options[j].getDi() * m_opinions[j] + b_ij + m_u_i * ( sigmoid(term1) + term2 );
-    std::cout << "    *-> F_ij = " << doubleToString(F_ij) << std::endl;
-    // push back onto the new state vector
-    F_i.push_back(F_ij);
-    std::cout << " F_i = ";
-    for (int i = 0; i <F_i.size(); i++) {
-      std::cout << doubleToString(F_i[i]) << ", "; 
-    }
-    std::cout << ";" << std::endl;
-    
-      
-  } // end of For each option loop
-
-
-  std::cout << " Last Step:  Projecting and updating " << std::endl;
-  // Last step: re-project (rescale) the opinions
-  // but only those that are active.  
-  std::vector<double> Z_dot_active = projectOp(F_i);
-  std::cout << "  -> Z_dot_active = ";
-  for (int i = 0; i <Z_dot_active.size(); i++) {
-    std::cout << doubleToString(Z_dot_active[i]) << ", ";
   }
-  std::cout << ";" << std::endl;
-    
+
+  // Step 3:  Update the attention and the opinions by Euler
+  //          integration, see OpinionDynamics::stepAgent()
   double dt = time - m_last_iter_time;
-  std::cout << "    dt = " << doubleToString(dt) << std::endl;
-
-  // Update the opinions using Euler Integration
-  // We have a record of which are active via options_status,
-  // which is used again here
-  double dyn_gain = dynamicGainCalc(Z_dot_active); 
-  unsigned int j_offset = 0;
-  for (unsigned int j=0; j<options_status.size(); j++){
-    // check if active
-    if (!options_status[j]){
-      // not active - set to zero
-      m_opinions[j] = 0.0; 
-      continue;
-    } else {
-      m_opinions[j] = m_opinions[j] + dt * dyn_gain * Z_dot_active[j_offset];
-      m_opinion_inputs[j] = b_i[j_offset];
-      j_offset++; 
-    }
-  }
-  std::cout << "    ** Updated m_opinions = ";
-  for (int i = 0; i <m_opinions.size(); i++) {
-    std::cout << doubleToString(m_opinions[i]) << ", ";
-  }
-  std::cout << ";" << std::endl;
+  m_dynamics.stepAgent(&m_opinions[0], m_u_i, options_status, &b_i[0],
+		       &nsum[0], nsq, dt);
 
-  // double check that the state is in the simplex
-  std::vector<double> simplex_opinion_state = projectOp(m_opinions);
-  m_opinions = simplex_opinion_state;
-  
+  for (unsigned int j = 0; j < numb_options; j++){
+    if (options_status[j])
+      m_opinion_inputs[j] = b_i[j];
+  }
   
   // Bookkeeping
   m_last_iter_time = time;
@@ -609,38 +347,6 @@ bool OpManagerEngine::iterateOwnOpinion(double time)
 }
 
 
-//---------------------------------------------------------------
-// dynamicGainCalc(z_dot)
-//   calculates a gain based on the current value of z_dot
-//   and other parameters
-//   assumes 
-double OpManagerEngine::dynamicGainCalc(const std::vector<double> &z_dot){
-
-  double z_dot_ave = 0.0;
-  for (int i=0; i<z_dot.size(); i++)
-    z_dot_ave = z_dot_ave + z_dot[i];
-
-  if (z_dot.size() > 0)
-    z_dot_ave = z_dot_ave / static_cast<double>(z_dot.size());
-  else
-    z_dot_ave = 1.0;
-			      
-  double lower_lim = 0.00001;   // gain is 1.0 at lower limit
-  double upper_lim = 0.0001;   // gain is clamped at m_num_int_gain
-                            // above this limit
-  if (z_dot_ave < lower_lim)
-    return(1.0);
-
-  if (z_dot_ave > upper_lim)
-    return(m_num_int_gain);
-
-  double delta = z_dot_ave - lower_lim;
-  double gain  = ( delta / (upper_lim - lower_lim)) * (1.0 - m_num_int_gain) + m_num_int_gain; 
-  return(gain); 
-}
-
-
-
 //--------------------------------------------------------------------
 // buildOwnOpinionMessage
 // build an opinion message for the current calculation
@@ -766,88 +472,6 @@ int OpManagerEngine::numberOptionsActive()
 
 
 
-// Projection operator
-// Definition in arxiv.org/pdf/2009.04332.pdf
-std::vector<double> OpManagerEngine::projectOp(const std::vector<double> in)
-{
-  std::vector<double> out;
-  unsigned int N_o = in.size();
-  if (N_o == 0) {
-    return(out); 
-  }
-  double dbl_N_o = static_cast<double>(N_o);
-  double dbl_N_o_inv = 1/dbl_N_o;  // cannot be zero; 
-  double temp_val; 
-
-  for (unsigned int i=0; i<N_o; i++) {
-    temp_val = 0;
-    for (unsigned int j=0; j<N_o; j++) {
-      if (i==j)
-	temp_val += (1.0 - dbl_N_o_inv) * in[j];
-      else
-	temp_val -= dbl_N_o_inv * in[j]; 
-    }
-    out.push_back(temp_val);
-  }
-  return(out);
-}
-
-//--------------------------------------------------
-// Procedure:  Update attention
-//             Inputs: current time as double
-//                     options_status is a vector of bools
-//                     which indicate which options are active
-void OpManagerEngine::updateAttention(double time, std::vector<bool> options_status)
-{
-  // Estimate u_a and u_d from current records.
-  //estBoundsUaUd();  // Not used at this time
-
-  
-  double sum1 = 0.0;
-  double count = 0.0;
-  // add the square of all own ACTIVE opinions
-  for (unsigned int i = 0; i < m_opinions.size(); i++){
-    if (options_status[i]){
-      sum1  += m_opinions[i]*m_opinions[i];
-      count += 1.0; 
-    }
-  }
-  // Normalize
-  sum1 = sum1 / count;
-  
-  std::cout << " Updating attention:  Normalized square of own opinions is = " << doubleToString(sum1) << std::endl;
-  
-  std::map<std::string, OpinionRecord>::iterator it;
-  for (it = m_neighbor_opinion_records.begin(); it != m_neighbor_opinion_records.end(); it++) {
-
-    // check if this record stale
-    bool stale = ( (time - it->second.getTime() ) > m_stale_thresh);
-    if (!stale) {
-      sum1 += it->second.getOpinionsSquared(); 
-    }
-    std::cout << " -> Checked vehicle " << it->second.getVname() << " and running sum of squares is now = " << doubleToString(sum1) << std::endl;
-  }
-
-  // Update attention
-  double dt = time - m_last_iter_time;
-  std::cout << " Updating attention:  dt = " << doubleToString(dt) << std::endl;
-  std::cout << " Updating attention:  m_u_min + (m_u_max - m_u_min) * satFunctionHill(sum1) = " << m_u_min + (m_u_max - m_u_min) * satFunctionHill(sum1) << std::endl;
-  
-  double du_dt = (-1.0 * m_u_i + m_u_min + (m_u_max - m_u_min) * satFunctionHill(sum1)) / m_tau_u;
-  std::cout << " Updating attention: satFunctionHill(sum1) = " << doubleToString(satFunctionHill(sum1)) << std::endl;
-  m_u_i = m_u_i + du_dt * dt;
-  std::cout << " Updating attention:  m_u_i = " << doubleToString(m_u_i) << std::endl;
-
-  // clip attention
-  if (m_u_i > m_u_max)
-    m_u_i = m_u_max;
-
-  if (m_u_i < m_u_min)
-    m_u_i = m_u_min;
-
-  return; 
-}
-
 //---------------------------------------------------------------
 // Estimate bounds for u_a and u_d
 // Definition in arxiv.org/pdf/2009.04332.pdf
@@ -10,6 +10,7 @@
 
 #include "Option.h"
 #include "OpinionRecord.h"
+#include "OpinionDynamics.h"
 #include <map>
 #include <vector>
 #include <fstream>  // to read config block
@@ -28,12 +29,12 @@ class OpManagerEngine
   ~OpManagerEngine();
 
   // Setup functions:
-  bool setTauU(double val)     {m_tau_u = val; return(true);};
-  bool setUth(double val)      {m_u_th = val; return(true);};
-  bool setSatFunOrder(double val) {m_Hill_order = val; return(true);};
-  bool setMinAtten(double val) {m_u_min = val; m_u_i = val; return(true);};
-  bool setMaxAtten(double val) {m_u_max = val; return(true);};
-  bool setNumIntGain(double val) {m_num_int_gain = val; return(true);};
+  bool setTauU(double val)     {m_tau_u = val; m_dynamics.setTauU(val); return(true);};
+  bool setUth(double val)      {m_u_th = val; m_dynamics.setUth(val); return(true);};
+  bool setSatFunOrder(double val) {m_Hill_order = val; m_dynamics.setSatFunOrder(val); return(true);};
+  bool setMinAtten(double val) {m_u_min = val; m_u_i = val; m_dynamics.setMinAtten(val); return(true);};
+  bool setMaxAtten(double val) {m_u_max = val; m_dynamics.setMaxAtten(val); return(true);};
+  bool setNumIntGain(double val) {m_num_int_gain = val; m_dynamics.setNumIntGain(val); return(true);};
   
   
   bool setName(std::string val) {m_vname = val; return(true);};
@@ -91,13 +92,7 @@ class OpManagerEngine
 
   // Operational Functions
   std::vector<bool> determineOptionActive();
-  std::vector<double> projectOp(const std::vector<double> in);
-  double sigmoid(double val) {return( tanh(val) );};
-  double satFunctionHill(double y) {return(  pow(y,m_Hill_order) /
-					     ( pow(m_u_th,m_Hill_order) + pow(y,m_Hill_order))); }; 
-  void updateAttention(double time, std::vector<bool> options_status); 
   void estBoundsUaUd();
-  double dynamicGainCalc(const std::vector<double> &z_dot); 
 
   // Dyamical parameters
   double m_u_a_upper_bound;
@@ -154,6 +149,13 @@ class OpManagerEngine
   std::map<std::string, OpinionRecord> m_neighbor_opinion_records;
   std::map<std::string, unsigned int> m_neighbor_opinion_rec;
 
+  // The same opinions indexed as m_options, and their mean square
+  std::map<std::string, std::vector<double> > m_neighbor_opinion_vecs;
+  std::map<std::string, double> m_neighbor_opinion_sqs;
+
+  // Dense dynamics core, holds the couplings of m_options
+  OpinionDynamics m_dynamics;
+
 
   // Set of options and the vehicles in the population that are
   // strongly opinionated about those options
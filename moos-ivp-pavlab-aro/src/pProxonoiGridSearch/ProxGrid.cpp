@@ -9,15 +9,29 @@
 /* except by the author(s), or those designated by the author.   */
 /*****************************************************************/
 
+#include <iostream>
+#include <algorithm>
+#include <limits>
 #include "ProxGrid.h"
 
 
 using namespace std;
 
+// The step in x and y, in cells, for each direction
+//   7 0 1
+//   6 o 2
+//   5 4 3
+static const int dir_dx[] = { 0,  1,  1,  1,  0, -1, -1, -1};
+static const int dir_dy[] = { 1,  1,  0, -1, -1, -1,  0,  1};
+
 //---------------------------------------------------------
 // Constructor
 ProxGrid::ProxGrid() {
-
+  m_no_data_value = 0;
+  m_has_cell_vars = false;
+  m_cix_val = 0;
+  m_cix_var = 0;
+  m_all_changed = false;
 }
 
 //---------------------------------------------------------
@@ -26,6 +40,40 @@ ProxGrid::ProxGrid(XYConvexGrid new_grid, double no_data_value)
 {
   m_grid = new_grid;
   m_no_data_value = no_data_value;
+
+  m_has_cell_vars = m_grid.hasCellVar("val") && m_grid.hasCellVar("var");
+  m_cix_val = 0;
+  m_cix_var = 0;
+  if(m_has_cell_vars) {
+    m_cix_val = m_grid.getCellVarIX("val");
+    m_cix_var = m_grid.getCellVarIX("var");
+  }
+
+  unsigned int cell_count = m_grid.size();
+  for(unsigned int idx=0; idx<cell_count; idx++) {
+    XYSquare cell_square = m_grid.getElement(idx);
+    m_cell_x.push_back(cell_square.getCenterX());
+    m_cell_y.push_back(cell_square.getCenterY());
+    if(m_has_cell_vars) {
+      m_vals.push_back(m_grid.getVal(idx, m_cix_val));
+      m_vars.push_back(m_grid.getVal(idx, m_cix_var));
+    }
+  }
+
+  // The neighbors are found once, from the cell centers, rather
+  // than on every expansion of the path tree
+  double cell_size = m_grid.getCellSize();
+  m_neighbors.assign(cell_count * 8, -1);
+  for(unsigned int idx=0; idx<cell_count; idx++) {
+    for(int dir=0; dir<8; dir++) {
+      double nx = m_cell_x[idx] + dir_dx[dir] * cell_size;
+      double ny = m_cell_y[idx] + dir_dy[dir] * cell_size;
+      m_neighbors[idx*8 + dir] = lookupCellID(nx, ny);
+    }
+  }
+
+  m_changed.assign(m_vals.size(), false);
+  m_all_changed = false;
 }
 
 
@@ -33,33 +81,33 @@ ProxGrid::ProxGrid(XYConvexGrid new_grid, double no_data_value)
 // getCellID
 bool ProxGrid::getCellID(double x, double y, int &cell_id) {
 
-  
-  // find the appropriate cell.
-  unsigned int cell_count = m_grid.size();
-  for (int idx = 0; idx < cell_count; idx++) {
+  int idx = lookupCellID(x, y);
+  if(idx < 0)
+    return(false);   // Not able to find a suitable cell
+  cell_id = idx;
+  return (true);
+}
 
-    bool contains_point = m_grid.ptIntersect(idx, x, y);
-    if (contains_point) {
-      cell_id = idx;
-      return (true);
-    }
-  }
-  // Was NOT able to find a suitable cell for this location
-  return (false);
+
+//----------------------------------------------------------
+// Procedure: lookupCellID
+//            The lowest index of the cells containing x,y, or
+//            -1 if none. Found directly from the grid layout.
+
+int ProxGrid::lookupCellID(double x, double y) const
+{
+  return(m_grid.getCellIX(x, y));
 }
 
 
 //-----------------------------------------------------------
 // getCellXY
 bool ProxGrid::getCellXY(int idx, double &x, double &y) {
-  if (idx > m_grid.size())
+  if((idx < 0) || (idx >= (int)(m_cell_x.size())))
     return (false);
 
-  // get x and y data
-  XYSquare cell_square = m_grid.getElement(idx);
-  x = cell_square.getCenterX();
-  y = cell_square.getCenterY();
-
+  x = m_cell_x[idx];
+  y = m_cell_y[idx];
   return (true);
 }
 
@@ -68,7 +116,7 @@ bool ProxGrid::getCellXY(int idx, double &x, double &y) {
 //---------------------------------------------------------
 // Procedure: updateCellValueIDX
 //            Updates the cell based on index
-//            with the new value 
+//            with the new value
 
 bool ProxGrid::updateCellValueIDX(int idx,
 				  double value, double variance) {
@@ -76,24 +124,34 @@ bool ProxGrid::updateCellValueIDX(int idx,
   // Skip if the cell is frozen
   if (m_frozen_cells.count(idx) > 0)
     return(true);
-  
-  if( m_grid.hasCellVar("val")){
-    unsigned int val_idx = m_grid.getCellVarIX("val");
-    m_grid.setVal( idx, value, val_idx);
-  } else
-    return (false);
 
-  if( m_grid.hasCellVar("var")){
-    unsigned int var_idx = m_grid.getCellVarIX("var");
-    m_grid.setVal(idx, variance, var_idx);
-  } else
+  if(!m_has_cell_vars)
     return (false);
-  
+  if((idx < 0) || (idx >= (int)(m_vals.size())))
+    return (true);   // As the grid would, ignore it
+
+  // Hold the limits of the grid cell vars, as setVal would
+  if(m_grid.cellVarMaxLimited(m_cix_val) && (value > m_grid.getMaxLimit(m_cix_val)))
+    value = m_grid.getMaxLimit(m_cix_val);
+  if(m_grid.cellVarMinLimited(m_cix_val) && (value < m_grid.getMinLimit(m_cix_val)))
+    value = m_grid.getMinLimit(m_cix_val);
+  if(m_grid.cellVarMaxLimited(m_cix_var) && (variance > m_grid.getMaxLimit(m_cix_var)))
+    variance = m_grid.getMaxLimit(m_cix_var);
+  if(m_grid.cellVarMinLimited(m_cix_var) && (variance < m_grid.getMinLimit(m_cix_var)))
+    variance = m_grid.getMinLimit(m_cix_var);
+
+  m_vals[idx] = value;
+  m_vars[idx] = variance;
+  noteChanged(idx);
+
   // Was able to find a suitable cell and update all vars
   return (true);
 }
 
 
+//---------------------------------------------------------
+// Procedure: headingToDirection
+
 int ProxGrid::headingToDirection(double curr_heading) {
 
   int direction = -1;
@@ -160,304 +218,49 @@ int ProxGrid::headingToDirection(double curr_heading) {
 }
 
 
+//---------------------------------------------------------
+// Procedure: getAheadIDs
+//            The three cells ahead of the cell at x,y for the
+//            given direction, and the direction of travel into
+//            each. A cell off the grid is -1.
+
 bool ProxGrid::getAheadIDs(double curr_x, double curr_y,
                                 int curr_direction, int (&ahead_i)[3],
                                 int (&directions)[3]) {
 
-  double cell_size = m_grid.getCellSize();
-  // int heading_vals[] = { 0, 45, 90, 135, 180, 225, 270, 315 };
-
-  double x_vals[] = {0, 0, 0, 0, 0, 0, 0, 0};
-  double y_vals[] = {0, 0, 0, 0, 0, 0, 0, 0};
-
-  int xy_i[] = {0, 0, 0};
-
-  x_vals[7] = curr_x - cell_size; //  xoo
-  y_vals[7] = curr_y + cell_size; //  o o
-
-  x_vals[0] = curr_x;               //  oxo
-  y_vals[0] = curr_y + cell_size; //  o o
-
-  x_vals[1] = curr_x + cell_size; //  oox
-  y_vals[1] = curr_y + cell_size; //  o o
-
-  x_vals[2] = curr_x + cell_size; //  ooo
-  y_vals[2] = curr_y;               //  o x
-
-  x_vals[3] = curr_x + cell_size; //  o o
-  y_vals[3] = curr_y - cell_size; //  oox
-
-  x_vals[4] = curr_x;               //  o o
-  y_vals[4] = curr_y - cell_size; //  oxo
-
-  x_vals[5] = curr_x - cell_size; //  o o
-  y_vals[5] = curr_y - cell_size; //  xoo
-
-  x_vals[6] = curr_x - cell_size; //  x o
-  y_vals[6] = curr_y;               //  ooo
-
-  if (curr_direction == 0) {
-    //((curr_heading >= 0 && curr_heading <= 45) || (curr_heading >= 316 &&
-    // curr_heading <= 360)) {
-    // xXx
-    // o o
-    // ooo
-
-    xy_i[0] = 7;
-    xy_i[1] = 0;
-    xy_i[2] = 1;
-
-    directions[0] = 7;
-    directions[1] = 0;
-    directions[2] = 1;
-
-  } else if (curr_direction == 1) {
-    //(curr_heading < 46 && curr_heading > 45) {
-    // oxX
-    // o x
-    // ooo
-
-    xy_i[0] = 0;
-    xy_i[1] = 1;
-    xy_i[2] = 2;
-
-    directions[0] = 0;
-    directions[1] = 1;
-    directions[2] = 2;
-
-  } else if (curr_direction == 2) {
-    //(curr_heading >= 46 && curr_heading <= 135) {
-    // oox
-    // o X
-    // oox
-
-    xy_i[0] = 1;
-    xy_i[1] = 2;
-    xy_i[2] = 3;
-
-    directions[0] = 1;
-    directions[1] = 2;
-    directions[2] = 3;
-
-  } else if (curr_direction == 3) {
-    //(curr_heading < 136 && curr_heading > 135) {
-    // ooo
-    // o x
-    // oxX
-
-    xy_i[0] = 2;
-    xy_i[1] = 3;
-    xy_i[2] = 4;
-
-    directions[0] = 2;
-    directions[1] = 3;
-    directions[2] = 4;
-
-  } else if (curr_direction == 4) {
-    //(curr_heading >= 136 && curr_heading <= 225) {
-    // ooo
-    // o o
-    // xXx
-
-    xy_i[0] = 3;
-    xy_i[1] = 4;
-    xy_i[2] = 5;
-
-    directions[0] = 3;
-    directions[1] = 4;
-    directions[2] = 5;
-
-  } else if (curr_direction == 5) {
-    //(curr_heading < 226 && curr_heading > 225) {
-    // ooo
-    // x o
-    // Xxo
-
-    xy_i[0] = 4;
-    xy_i[1] = 5;
-    xy_i[2] = 6;
-
-    directions[0] = 4;
-    directions[1] = 5;
-    directions[2] = 6;
-
-  } else if (curr_direction == 6) {
-    //(curr_heading >= 226 && curr_heading <= 315) {
-    // xoo
-    // X o
-    // xoo
-
-    xy_i[0] = 5;
-    xy_i[1] = 6;
-    xy_i[2] = 7;
-
-    directions[0] = 5;
-    directions[1] = 6;
-    directions[2] = 7;
-
-  } else if (curr_direction == 7) {
-    //(curr_heading < 316 && curr_heading > 315) {
-    // Xxo
-    // x o
-    // ooo
-
-    xy_i[0] = 6;
-    xy_i[1] = 7;
-    xy_i[2] = 0;
-
-    directions[0] = 6;
-    directions[1] = 7;
-    directions[2] = 0;
-
-  } else {
-
-    // wrong heading
-    return false;
-  }
+  if ((curr_direction < 0) || (curr_direction > 7))
+    return false;    // wrong heading
 
+  int curr_id = lookupCellID(curr_x, curr_y);
   for (int i = 0; i < 3; i++) {
-
-    if (!getCellID(x_vals[xy_i[i]], y_vals[xy_i[i]], ahead_i[i]))
+    directions[i] = (curr_direction + 7 + i) % 8;
+    if (curr_id < 0)
       ahead_i[i] = -1;
+    else
+      ahead_i[i] = m_neighbors[curr_id*8 + directions[i]];
   }
 
   return true;
 }
 
+//---------------------------------------------------------
+// Procedure: getBehindIDs
+//            The five cells beside and behind the cell at x,y
+//            for the given direction, starting to the right.
+
 bool ProxGrid::getBehindIDs(double curr_x, double curr_y,
                                  int curr_direction, int (&behind_i)[5]) {
 
-  double cell_size = m_grid.getCellSize();
-  double x_vals[] = {0, 0, 0, 0, 0, 0, 0, 0};
-  double y_vals[] = {0, 0, 0, 0, 0, 0, 0, 0};
-
-  int xy_i[] = {0, 0, 0, 0, 0};
-
-  x_vals[7] = curr_x - cell_size; //  xoo
-  y_vals[7] = curr_y + cell_size; //  o o
-
-  x_vals[0] = curr_x;               //  oxo
-  y_vals[0] = curr_y + cell_size; //  o o
-
-  x_vals[1] = curr_x + cell_size; //  oox
-  y_vals[1] = curr_y + cell_size; //  o o
-
-  x_vals[2] = curr_x + cell_size; //  ooo
-  y_vals[2] = curr_y;               //  o x
-
-  x_vals[3] = curr_x + cell_size; //  o o
-  y_vals[3] = curr_y - cell_size; //  oox
-
-  x_vals[4] = curr_x;               //  o o
-  y_vals[4] = curr_y - cell_size; //  oxo
-
-  x_vals[5] = curr_x - cell_size; //  o o
-  y_vals[5] = curr_y - cell_size; //  xoo
-
-  x_vals[6] = curr_x - cell_size; //  x o
-  y_vals[6] = curr_y;               //  ooo
-
-  if (curr_direction == 0) {
-    // xXx
-    // o o
-    // ooo
-
-    xy_i[0] = 2;
-    xy_i[1] = 3;
-    xy_i[2] = 4;
-    xy_i[3] = 5;
-    xy_i[4] = 6;
-
-  } else if (curr_direction == 1) {
-    // oxX
-    // o x
-    // ooo
-
-    xy_i[0] = 3;
-    xy_i[1] = 4;
-    xy_i[2] = 5;
-    xy_i[3] = 6;
-    xy_i[4] = 7;
-
-  } else if (curr_direction == 2) {
-    // oox
-    // o X
-    // oox
-
-    xy_i[0] = 4;
-    xy_i[1] = 5;
-    xy_i[2] = 6;
-    xy_i[3] = 7;
-    xy_i[4] = 0;
-
-  } else if (curr_direction == 3) {
-    // ooo
-    // o x
-    // oxX
-
-    xy_i[0] = 5;
-    xy_i[1] = 6;
-    xy_i[2] = 7;
-    xy_i[3] = 0;
-    xy_i[4] = 1;
-
-  } else if (curr_direction == 4) {
-    // ooo
-    // o o
-    // xXx
-
-    xy_i[0] = 6;
-    xy_i[1] = 7;
-    xy_i[2] = 0;
-    xy_i[3] = 1;
-    xy_i[4] = 2;
-
-  } else if (curr_direction == 5) {
-    // ooo
-    // x o
-    // Xxo
-
-    xy_i[0] = 7;
-    xy_i[1] = 0;
-    xy_i[2] = 1;
-    xy_i[3] = 2;
-    xy_i[4] = 3;
-
-  } else if (curr_direction == 6) {
-    // xoo
-    // X o
-    // xoo
-
-    xy_i[0] = 0;
-    xy_i[1] = 1;
-    xy_i[2] = 2;
-    xy_i[3] = 3;
-    xy_i[4] = 4;
-
-  } else if (curr_direction == 7) {
-    // Xxo
-    // x o
-    // ooo
-
-    xy_i[0] = 1;
-    xy_i[1] = 2;
-    xy_i[2] = 3;
-    xy_i[3] = 4;
-    xy_i[4] = 5;
-
-  } else {
-
-    // wrong heading
-    return false;
-  }
+  if ((curr_direction < 0) || (curr_direction > 7))
+    return false;    // wrong heading
 
+  int curr_id = lookupCellID(curr_x, curr_y);
   for (int i = 0; i < 5; i++) {
-
-    cout << "i " << i << " xy_i[i] " << xy_i[i] << " x_val " << x_vals[xy_i[i]]
-         << " y_val " << y_vals[xy_i[i]] << endl;
-
-    if (!getCellID(x_vals[xy_i[i]], y_vals[xy_i[i]], behind_i[i]))
+    int dir = (curr_direction + 2 + i) % 8;
+    if (curr_id < 0)
       behind_i[i] = -1;
+    else
+      behind_i[i] = m_neighbors[curr_id*8 + dir];
   }
 
   return true;
@@ -470,19 +273,16 @@ bool ProxGrid::getBehindIDs(double curr_x, double curr_y,
 
 bool ProxGrid::getCellData(int idx, double &x, double &y,
                                 double &val, double &var) const {
-  if (idx > m_grid.size())
+  if ((idx < 0) || (idx >= (int)(m_cell_x.size())))
     return (false);
 
   // get x and y data
-  XYSquare cell_square = m_grid.getElement(idx);
-  x = cell_square.getCenterX();
-  y = cell_square.getCenterY();
-
-  if (m_grid.hasCellVar("val") and m_grid.hasCellVar("var")) {
-    unsigned int cix_val = m_grid.getCellVarIX("val");
-    unsigned int cix_variance = m_grid.getCellVarIX("var");
-    val = m_grid.getVal(idx, cix_val);
-    var = m_grid.getVal(idx, cix_variance);
+  x = m_cell_x[idx];
+  y = m_cell_y[idx];
+
+  if (m_has_cell_vars) {
+    val = m_vals[idx];
+    var = m_vars[idx];
   } else {
     // Not able to set value correctly
     cout << "Error reading from grid.  Did not find depth entry" << endl;
@@ -499,55 +299,47 @@ bool ProxGrid::getCellData(int idx, double &x, double &y,
 //           so they approach alpha_val and alpha_var
 bool ProxGrid::coolCellsVisited(double alpha_val, double alpha_var)
 {
-  double old_val = 0.0;
-  double delta   = 0.0;
-  double new_val = 0.0;
-  unsigned int cix_val = 0;
-
-  double old_var = 0.0;
-  double new_var = 0.0;
-  unsigned int cix_var = 0;
-  
-  if( m_grid.hasCellVar("val"))
-    cix_val = m_grid.getCellVarIX("val");
-  else
+  if(!m_has_cell_vars)
     return(false);
 
-  if( m_grid.hasCellVar("var"))
-    cix_var = m_grid.getCellVarIX("var");
-  else
-    return(false);
-  
-  for (unsigned int idx=0; idx<m_grid.size(); idx++){
-
-    // cool the value
-    old_val = m_grid.getVal(idx, cix_val);
-    delta = alpha_val - old_val;
-    new_val = old_val + 0.3 * delta;
-    m_grid.setVal(idx, new_val, cix_val);
-
-    // cool the variance
-    old_var = m_grid.getVal(idx, cix_var);
-    delta = alpha_var - old_var;
-    new_var = old_var + 0.3 * delta;
-    m_grid.setVal(idx, new_var, cix_var);
-       
+  // One straight pass per cell var, limits held as setVal would
+  unsigned int cixs[]  = {m_cix_val, m_cix_var};
+  double alphas[]      = {alpha_val, alpha_var};
+  double *cells[]      = {m_vals.data(), m_vars.data()};
+  unsigned int cell_count = m_vals.size();
+  for (unsigned int k=0; k<2; k++) {
+    double max_limit = numeric_limits<double>::infinity();
+    double min_limit = -numeric_limits<double>::infinity();
+    if (m_grid.cellVarMaxLimited(cixs[k]))
+      max_limit = m_grid.getMaxLimit(cixs[k]);
+    if (m_grid.cellVarMinLimited(cixs[k]))
+      min_limit = m_grid.getMinLimit(cixs[k]);
+
+    double  alpha = alphas[k];
+    double *cell  = cells[k];
+    for (unsigned int idx=0; idx<cell_count; idx++) {
+      double new_val = cell[idx] + 0.3 * (alpha - cell[idx]);
+      new_val = (new_val > max_limit) ? max_limit : new_val;
+      new_val = (new_val < min_limit) ? min_limit : new_val;
+      cell[idx] = new_val;
+    }
   }
 
+  m_all_changed = true;
   return(true);
 }
 
 
 //--------------------------------------------------------
 // Procedure: setFrozenCell
-//            
+//
 
 bool ProxGrid::setFrozenCell(int cell_id, double time)
 {
-  if (cell_id > m_grid.size())
+  if ((cell_id < 0) || (cell_id >= (int)(m_cell_x.size())))
     return (false);
   m_frozen_cells[cell_id] = time;
-  return(true); 
+  return(true);
 }
 
 
@@ -564,44 +356,111 @@ bool ProxGrid::updateFrozenCells(double curr_time, double time_thresh)
       m_frozen_cells.erase(it++);
     }
   }
-  
-  return(true); 
+
+  return(true);
+}
+
+
+//--------------------------------------------------------
+// Procedure: noteChanged
+
+void ProxGrid::noteChanged(unsigned int idx)
+{
+  if (m_all_changed || m_changed[idx])
+    return;
+  m_changed[idx] = true;
+  m_changed_ixs.push_back(idx);
 }
 
+
 //--------------------------------------------------------
-// Procedure: getValueVector
-//            returns vector of all values
+// Procedure: getChangedCount
+//            Number of cells written since the last spec or
+//            update was taken
+
+unsigned int ProxGrid::getChangedCount() const
+{
+  if (m_all_changed)
+    return(m_vals.size());
+  return(m_changed_ixs.size());
+}
+
 
-std::vector<double> ProxGrid::getValueVector() const {
-  std::vector<double> value_vector;
+//--------------------------------------------------------
+// Procedure: syncGrid
+//            Bring the changed cells of the grid up to date
 
-  if (m_grid.hasCellVar("val")) {
-    unsigned int cix_depth = m_grid.getCellVarIX("val");
+void ProxGrid::syncGrid()
+{
+  if (!m_has_cell_vars)
+    return;
 
-    unsigned int cell_count = m_grid.size();
-    for (unsigned int idx = 0; idx < cell_count; idx++) {
-      value_vector.push_back(m_grid.getVal(idx, cix_depth));
+  if (m_all_changed) {
+    for (unsigned int idx=0; idx<m_vals.size(); idx++) {
+      m_grid.setVal(idx, m_vals[idx], m_cix_val);
+      m_grid.setVal(idx, m_vars[idx], m_cix_var);
+    }
+  }
+  else {
+    for (unsigned int i=0; i<m_changed_ixs.size(); i++) {
+      unsigned int idx = m_changed_ixs[i];
+      m_grid.setVal(idx, m_vals[idx], m_cix_val);
+      m_grid.setVal(idx, m_vars[idx], m_cix_var);
     }
   }
+}
+
 
-  return (value_vector);
+//--------------------------------------------------------
+// Procedure: clearChanged
+
+void ProxGrid::clearChanged()
+{
+  for (unsigned int i=0; i<m_changed_ixs.size(); i++)
+    m_changed[m_changed_ixs[i]] = false;
+  m_changed_ixs.clear();
+  m_all_changed = false;
 }
 
+
 //--------------------------------------------------------
-// Procedure: getVarianceVector
-//            returns vector of all variance values
+// Procedure: get_spec
+//            The full grid spec. Clears the changed cells.
 
-std::vector<double> ProxGrid::getVarianceVector() const {
-  std::vector<double> variance_vector;
+std::string ProxGrid::get_spec()
+{
+  syncGrid();
+  clearChanged();
+  return(m_grid.get_spec());
+}
 
-  if (m_grid.hasCellVar("var")) {
-    unsigned int cix_variance = m_grid.getCellVarIX("var");
 
-    unsigned int cell_count = m_grid.size();
-    for (unsigned int idx = 0; idx < cell_count; idx++) {
-      variance_vector.push_back(m_grid.getVal(idx, cix_variance));
+//--------------------------------------------------------
+// Procedure: getGridUpdate
+//            The val and var of each cell written since the last
+//            spec or update, as replacements, in index order.
+//            Clears the changed cells.
+
+XYGridUpdate ProxGrid::getGridUpdate()
+{
+  XYGridUpdate update(m_grid.get_label());
+  update.setUpdateTypeReplace();
+
+  syncGrid();
+  if (m_all_changed) {
+    for (unsigned int idx=0; idx<m_vals.size(); idx++) {
+      update.addUpdate(idx, "val", m_vals[idx]);
+      update.addUpdate(idx, "var", m_vars[idx]);
     }
   }
-
-  return (variance_vector);
+  else {
+    std::vector<unsigned int> ixs = m_changed_ixs;
+    sort(ixs.begin(), ixs.end());
+    for (unsigned int i=0; i<ixs.size(); i++) {
+      update.addUpdate(ixs[i], "val", m_vals[ixs[i]]);
+      update.addUpdate(ixs[i], "var", m_vars[ixs[i]]);
+    }
+  }
+  clearChanged();
+  return(update);
 }
@@ -14,10 +14,17 @@
 
 #include <vector>
 #include <map>
+#include <string>
 #include "XYConvexGrid.h"
+#include "XYGridUpdate.h"
 #include "XYPolygon.h"
 #include "XYSquare.h"
 
+// The val and var of each cell are kept in flat arrays, so a pass
+// over all cells (cooling, value vectors) runs over contiguous
+// memory. The XYConvexGrid is only brought up to date when its
+// spec is requested. Cells written since the last spec or update
+// are noted, so only those need be published.
 
 class ProxGrid
 {
@@ -32,31 +39,61 @@ public:
 			  double value, double variance);
 
   int  headingToDirection(double curr_heading);
-  
+
   bool getAheadIDs(double curr_x, double curr_y,
                    int curr_direction, int (&ahead_i)[3],
 		   int (&directions)[3]);
-  
+
   bool getBehindIDs(double curr_x, double curr_y,
 		    int curr_direction, int (&behind_i)[5]);
 
   bool getCellData(int idx, double &x, double &y,
 		   double &val, double &var) const;
 
-  std::vector<double> getValueVector() const;
-  std::vector<double> getVarianceVector() const;
-  
+  const std::vector<double>& getValueVector() const {return(m_vals);}
+  const std::vector<double>& getVarianceVector() const {return(m_vars);}
+
   bool coolCellsVisited(double alpha_val, double alpha_var);
   bool setFrozenCell(int cell_id, double time);
   bool updateFrozenCells(double curr_time, double time_thresh);
-  
-  std::string get_spec() const {return(m_grid.get_spec());}
+
+  // Full spec, or just the cells written since the last of either
+  std::string  get_spec();
+  XYGridUpdate getGridUpdate();
+  unsigned int getChangedCount() const;
+
   double getCellSize() const {return(m_grid.getCellSize());}
-  
+  unsigned int size() const {return(m_vals.size());}
+
+ private:
+  int  lookupCellID(double x, double y) const;
+  void noteChanged(unsigned int idx);
+  void syncGrid();
+  void clearChanged();
+
  private:
   XYConvexGrid m_grid;
   double m_no_data_value;
 
+  // Per cell, by index into m_grid
+  std::vector<double> m_vals;
+  std::vector<double> m_vars;
+  std::vector<double> m_cell_x;
+  std::vector<double> m_cell_y;
+
+  // Per cell, the cell one step in each of the 8 directions
+  // (cell*8 + direction), or -1 if off the grid
+  std::vector<int> m_neighbors;
+
+  bool         m_has_cell_vars;
+  unsigned int m_cix_val;
+  unsigned int m_cix_var;
+
+  // Cells written since the grid was last synced and published
+  std::vector<bool>         m_changed;
+  std::vector<unsigned int> m_changed_ixs;
+  bool                      m_all_changed;
+
   // keyed on cell index, double is time
   std::map<int, double> m_frozen_cells;
 
@@ -0,0 +1,329 @@
+/************************************************************/
+/*    NAME: agent                                           */
+/*    ORGN: MIT, Cambridge MA                               */
+/*    FILE: ProxGridBench.cpp                               */
+/*    DATE: October 19th, 2026                              */
+/************************************************************/
+
+// Benchmark of ProxGrid against grid size, compared with working on
+// the XYConvexGrid cell by cell as ProxGrid did before: each cell
+// id found by testing every cell, each neighbor in the path tree
+// found the same way, cooling and the value vectors done through
+// getVal/setVal, and the whole grid spec posted every iterate.
+//
+// A check run first applies the same random writes, cooling and
+// lookups to both, and compares every result.
+//
+//   proxgrid_bench
+//   proxgrid_bench --msecs=200
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <chrono>
+#include "MBUtils.h"
+#include "XYConvexGrid.h"
+#include "XYPolygon.h"
+#include "ProxGrid.h"
+
+using namespace std;
+
+static double g_msecs = 100;
+
+// Steps of each direction, in cells, as ProxGrid
+static const int dir_dx[] = { 0,  1,  1,  1,  0, -1, -1, -1};
+static const int dir_dy[] = { 1,  1,  0, -1, -1, -1,  0,  1};
+
+//---------------------------------------------------------
+// Procedure: nowMsecs()
+
+double nowMsecs()
+{
+  using namespace std::chrono;
+  return(duration<double, milli>(steady_clock::now().time_since_epoch()).count());
+}
+
+//---------------------------------------------------------
+// Procedure: makeGrid()
+//   Purpose: A square grid of n by n cells of 10m, with the val
+//            and var cell vars and limits of pProxonoiGridSearch.
+
+XYConvexGrid makeGrid(unsigned int n)
+{
+  double len = 10.0 * n;
+  XYPolygon poly;
+  poly.add_vertex(0, 0);
+  poly.add_vertex(len, 0);
+  poly.add_vertex(len, len);
+  poly.add_vertex(0, len);
+
+  vector<string> vars;
+  vars.push_back("val");
+  vars.push_back("var");
+  vector<double> inits;
+  inits.push_back(1);
+  inits.push_back(10);
+
+  XYConvexGrid grid;
+  grid.initialize(poly, 10, vars, inits);
+  grid.setMinLimit(0, 0);
+  grid.setMaxLimit(10, 0);
+  grid.setMinLimit(0.00001, 1);
+  grid.setMaxLimit(1000, 1);
+  grid.set_label("bench_grid");
+  return(grid);
+}
+
+//---------------------------------------------------------
+// Procedure: baseCellID()
+
+int baseCellID(const XYConvexGrid& grid, double x, double y)
+{
+  for(unsigned int idx=0; idx<grid.size(); idx++)
+    if(grid.ptIntersect(idx, x, y))
+      return((int)(idx));
+  return(-1);
+}
+
+//---------------------------------------------------------
+// Procedure: baseAheadIDs()
+
+void baseAheadIDs(const XYConvexGrid& grid, double x, double y,
+		  int dir, int (&ahead_i)[3])
+{
+  double cell_size = grid.getCellSize();
+  for(int i=0; i<3; i++) {
+    int d = (dir + 7 + i) % 8;
+    ahead_i[i] = baseCellID(grid, x + dir_dx[d] * cell_size,
+			    y + dir_dy[d] * cell_size);
+  }
+}
+
+//---------------------------------------------------------
+// Procedure: baseCool()
+
+void baseCool(XYConvexGrid& grid, double alpha_val, double alpha_var)
+{
+  for(unsigned int idx=0; idx<grid.size(); idx++) {
+    double old_val = grid.getVal(idx, 0);
+    grid.setVal(idx, old_val + 0.3 * (alpha_val - old_val), 0);
+    double old_var = grid.getVal(idx, 1);
+    grid.setVal(idx, old_var + 0.3 * (alpha_var - old_var), 1);
+  }
+}
+
+//---------------------------------------------------------
+// Procedure: baseVector()
+
+vector<double> baseVector(const XYConvexGrid& grid, unsigned int cix)
+{
+  vector<double> vals;
+  for(unsigned int idx=0; idx<grid.size(); idx++)
+    vals.push_back(grid.getVal(idx, cix));
+  return(vals);
+}
+
+//---------------------------------------------------------
+// Procedure: randomPoint()
+
+void randomPoint(unsigned int n, double& x, double& y)
+{
+  x = (rand() % (n * 100)) / 10.0 + 0.05;
+  y = (rand() % (n * 100)) / 10.0 + 0.05;
+}
+
+//---------------------------------------------------------
+// Procedure: check()
+//   Purpose: The same operations on both, true if all agree.
+
+bool check(unsigned int n)
+{
+  XYConvexGrid base = makeGrid(n);
+  ProxGrid prox(base, 1.0);
+
+  bool ok = true;
+  for(unsigned int s=0; s<2000; s++) {
+    double x, y;
+    randomPoint(n, x, y);
+    int base_id = baseCellID(base, x, y);
+    int prox_id = -1;
+    if(!prox.getCellID(x, y, prox_id))
+      prox_id = -1;
+    ok = ok && (base_id == prox_id);
+    if(base_id < 0)
+      continue;
+
+    // Lookahead from the cell center, as the path tree does
+    double cx = 0, cy = 0;
+    prox.getCellXY(prox_id, cx, cy);
+    int dir = rand() % 8;
+    int base_ahead[3], prox_ahead[3], directions[3];
+    baseAheadIDs(base, cx, cy, dir, base_ahead);
+    prox.getAheadIDs(cx, cy, dir, prox_ahead, directions);
+    for(int i=0; i<3; i++)
+      ok = ok && (base_ahead[i] == prox_ahead[i]);
+
+    double val = (rand() % 1200) / 100.0 - 1;
+    double var = (rand() % 20000) / 10.0;
+    base.setVal(base_id, val, 0);
+    base.setVal(base_id, var, 1);
+    prox.updateCellValueIDX(prox_id, val, var);
+
+    if((s % 97) == 0) {
+      baseCool(base, 0.1, 1.0);
+      prox.coolCellsVisited(0.1, 1.0);
+    }
+  }
+  ok = ok && (baseVector(base, 0) == prox.getValueVector());
+  ok = ok && (baseVector(base, 1) == prox.getVarianceVector());
+  ok = ok && (base.get_spec() == prox.get_spec());
+  return(ok);
+}
+
+//---------------------------------------------------------
+// Procedure: main
+
+int main(int argc, char *argv[])
+{
+  for(int i=1; i<argc; i++) {
+    string argi = argv[i];
+    if(argi.find("--msecs=") == 0)
+      g_msecs = atof(argi.substr(8).c_str());
+    else {
+      cout << "Usage: proxgrid_bench [--msecs=N]" << endl;
+      return(1);
+    }
+  }
+  srand(1);
+
+  //=========================================================
+  // Part 1: Check
+  bool ok = check(12) && check(40);
+  cout << "Check: 2000 writes, lookups and lookaheads, ";
+  cout << (ok ? "all agree" : "MISMATCH") << endl << endl;
+  if(!ok)
+    return(1);
+
+  //=========================================================
+  // Part 2: Time of each kind of work against grid size.
+  //   expand: cell id of a point, and the three cells ahead
+  //   cool:   one cooling pass over all cells
+  //   vecs:   the value and variance vectors (each path tree)
+  //   post:   the grid post after 20 cells were written, the
+  //           whole spec before, only the changed cells after
+  unsigned int sides[] = {10, 30, 100, 300};
+  cout << "                  Per cell (us)   ProxGrid (us)   Speedup" << endl;
+  for(unsigned int c=0; c<4; c++) {
+    unsigned int n = sides[c];
+    XYConvexGrid base = makeGrid(n);
+    ProxGrid prox(base, 1.0);
+    string label = uintToString(n*n) + " cells";
+    cout << label << endl;
+
+    vector<double> old_us, new_us;
+    vector<string> names;
+
+    // expand
+    unsigned int reps = 0;
+    double start = nowMsecs();
+    while((nowMsecs() - start) < g_msecs) {
+      double x, y;
+      randomPoint(n, x, y);
+      int id = baseCellID(base, x, y);
+      int ahead_i[3];
+      if(id >= 0) {
+	XYSquare cell = base.getElement(id);
+	baseAheadIDs(base, cell.getCenterX(), cell.getCenterY(), reps % 8, ahead_i);
+      }
+      reps++;
+    }
+    old_us.push_back(1000 * (nowMsecs() - start) / reps);
+    reps = 0;
+    start = nowMsecs();
+    while((nowMsecs() - start) < g_msecs) {
+      double x, y, cx, cy;
+      randomPoint(n, x, y);
+      int id, ahead_i[3], directions[3];
+      if(prox.getCellID(x, y, id) && prox.getCellXY(id, cx, cy))
+	prox.getAheadIDs(cx, cy, reps % 8, ahead_i, directions);
+      reps++;
+    }
+    new_us.push_back(1000 * (nowMsecs() - start) / reps);
+    names.push_back("expand");
+
+    // cool
+    reps = 0;
+    start = nowMsecs();
+    while((nowMsecs() - start) < g_msecs) {
+      baseCool(base, 0.1, 1.0);
+      reps++;
+    }
+    old_us.push_back(1000 * (nowMsecs() - start) / reps);
+    reps = 0;
+    start = nowMsecs();
+    while((nowMsecs() - start) < g_msecs) {
+      prox.coolCellsVisited(0.1, 1.0);
+      reps++;
+    }
+    new_us.push_back(1000 * (nowMsecs() - start) / reps);
+    names.push_back("cool");
+
+    // vecs
+    reps = 0;
+    start = nowMsecs();
+    double sum = 0;
+    while((nowMsecs() - start) < g_msecs) {
+      vector<double> vals = baseVector(base, 0);
+      vector<double> vars = baseVector(base, 1);
+      sum += vals[0] + vars[0];
+      reps++;
+    }
+    old_us.push_back(1000 * (nowMsecs() - start) / reps);
+    reps = 0;
+    start = nowMsecs();
+    while((nowMsecs() - start) < g_msecs) {
+      vector<double> vals = prox.getValueVector();
+      vector<double> vars = prox.getVarianceVector();
+      sum += vals[0] + vars[0];
+      reps++;
+    }
+    new_us.push_back(1000 * (nowMsecs() - start) / reps);
+    names.push_back("vecs");
+
+    // post
+    prox.get_spec();
+    unsigned long old_bytes = 0;
+    reps = 0;
+    start = nowMsecs();
+    while((nowMsecs() - start) < g_msecs) {
+      for(unsigned int k=0; k<20; k++)
+	base.setVal((reps * 20 + k * 7) % base.size(), 0, 0);
+      old_bytes = base.get_spec().length();
+      reps++;
+    }
+    old_us.push_back(1000 * (nowMsecs() - start) / reps);
+    unsigned long new_bytes = 0;
+    reps = 0;
+    start = nowMsecs();
+    while((nowMsecs() - start) < g_msecs) {
+      for(unsigned int k=0; k<20; k++)
+	prox.updateCellValueIDX((reps * 20 + k * 7) % prox.size(), 0, 0.1);
+      new_bytes = prox.getGridUpdate().get_spec().length();
+      reps++;
+    }
+    new_us.push_back(1000 * (nowMsecs() - start) / reps);
+    names.push_back("post");
+
+    for(unsigned int i=0; i<names.size(); i++) {
+      cout << "  " << left << setw(12) << names[i] << right << fixed << setprecision(2);
+      cout << setw(14) << old_us[i] << setw(16) << new_us[i];
+      cout << setw(9) << setprecision(1) << (old_us[i] / new_us[i]) << "x" << endl;
+    }
+    cout << "  post bytes: " << old_bytes << " whole, " << new_bytes << " delta" << endl;
+    if(sum == 0)
+      cout << endl;
+  }
+  return(0);
+}
@@ -47,6 +47,14 @@ ProxonoiGridSearch::ProxonoiGridSearch()
   m_post_grid = false;
   m_grid_posts_skipped = 0;
   m_grid_post_skip_interval = 0;
+
+  m_post_grid_deltas = false;
+  m_delta_format = "text";
+  m_full_grid_interval = 10;
+  m_last_time_full_grid_posted = -1;
+  m_full_grid_posts = 0;
+  m_delta_posts = 0;
+  m_grid_bytes_posted = 0;
 }
 
 //---------------------------------------------------------
@@ -238,7 +246,7 @@ bool ProxonoiGridSearch::Iterate()
   
   // Also post grid if configured
   if ((m_post_grid) && ((m_grid_posts_skipped % 1) ==0))
-    Notify("VIEW_GRID", m_prox_grid.get_spec());
+    postGrid();
  
   m_grid_posts_skipped += 1;
 
@@ -301,6 +309,19 @@ bool ProxonoiGridSearch::OnStartUp()
     else if(param == "post_grid") {
       handled = setBooleanOnString(m_post_grid,value);
     }
+    else if(param == "post_grid_deltas") {
+      handled = setBooleanOnString(m_post_grid_deltas,value);
+    }
+    else if(param == "delta_format") {
+      value = tolower(value);
+      if((value == "text") || (value == "binary")) {
+	m_delta_format = value;
+	handled = true;
+      }
+    }
+    else if(param == "full_grid_interval") {
+      handled = setNonNegDoubleOnString(m_full_grid_interval,value);
+    }
     else if(param == "cool_grid_value") {
       handled = setNonNegDoubleOnString(m_cool_grid_value,value);
     }
@@ -700,8 +721,8 @@ bool ProxonoiGridSearch::buildPathTree(int iterations, double curr_x, double cur
   path.setIterations(iterations);
 
   // preload the zStar function used in the MVI reward if we need
-  std::vector<double> values = m_prox_grid.getValueVector();
-  std::vector<double> variances = m_prox_grid.getVarianceVector();
+  const std::vector<double>& values = m_prox_grid.getValueVector();
+  const std::vector<double>& variances = m_prox_grid.getVarianceVector();
   double robot_noise = 0.01;
   std::vector<double> zStar = calculateZStarGumbel(20, values, variances, robot_noise);
   
@@ -1207,6 +1228,51 @@ bool ProxonoiGridSearch::didAgentJustNotifyToSample(std::string vname, double st
 
 
 
+//------------------------------------------------------------
+// Procedure: postGrid()
+//            With post_grid_deltas, only the cells written since
+//            the last post go out on VIEW_GRID_DELTA. The whole
+//            grid is still posted at first, every full_grid_interval
+//            secs for viewers that join late, and when more than
+//            half of it changed (cooling changes every cell).
+
+void ProxonoiGridSearch::postGrid()
+{
+  double curr_time = MOOSTime();
+  unsigned int changed = m_prox_grid.getChangedCount();
+
+  bool post_full = !m_post_grid_deltas;
+  post_full = post_full || (m_last_time_full_grid_posted < 0);
+  post_full = post_full || ((curr_time - m_last_time_full_grid_posted) > m_full_grid_interval);
+  post_full = post_full || ((2 * changed) > m_prox_grid.size());
+
+  if (post_full) {
+    std::string spec = m_prox_grid.get_spec();
+    Notify("VIEW_GRID", spec);
+    m_grid_bytes_posted += spec.length();
+    m_last_time_full_grid_posted = curr_time;
+    m_full_grid_posts++;
+    return;
+  }
+
+  if (changed == 0)
+    return;
+
+  XYGridUpdate update = m_prox_grid.getGridUpdate();
+  if (m_delta_format == "binary") {
+    std::vector<unsigned char> data = update.getBinary();
+    Notify("VIEW_GRID_DELTA", data);
+    m_grid_bytes_posted += data.size();
+  }
+  else {
+    std::string msg = update.get_spec();
+    Notify("VIEW_GRID_DELTA", msg);
+    m_grid_bytes_posted += msg.length();
+  }
+  m_delta_posts++;
+}
+
+
 //------------------------------------------------------------
 // Procedure: buildReport()
 
@@ -1243,6 +1309,12 @@ bool ProxonoiGridSearch::buildReport()
   }
 
 
+  if (m_post_grid) {
+    m_msgs << "                                               " << endl;
+    m_msgs << " Grid posts: " << m_full_grid_posts << " full, ";
+    m_msgs << m_delta_posts << " delta, " << m_grid_bytes_posted << " bytes" << endl;
+  }
+
   m_msgs << "                                               " << endl;
   m_msgs << " Own poly sliced pieces:                       " << endl;
   std::map<std::string, XYPolygon>::iterator it2;
@@ -70,6 +70,8 @@ class ProxonoiGridSearch : public AppCastingMOOSApp
    double calcCollectiveValue(bool assume_participation);
 
    bool didAgentJustNotifyToSample(std::string vname, double stale_thresh);
+
+   void postGrid();
    
    
  protected:
@@ -81,6 +83,12 @@ class ProxonoiGridSearch : public AppCastingMOOSApp
    int  m_grid_posts_skipped;
    int  m_grid_post_skip_interval;
 
+   // Post only the changed cells, as text or binary, with the
+   // whole grid every full_grid_interval secs
+   bool   m_post_grid_deltas;
+   std::string m_delta_format;
+   double m_full_grid_interval;
+
    double m_cool_grid_value;
    double m_cool_grid_variance;
    double m_cool_grid_interval;
@@ -119,6 +127,11 @@ class ProxonoiGridSearch : public AppCastingMOOSApp
    double m_own_max_value;
    double m_last_value;
 
+   double m_last_time_full_grid_posted;
+   unsigned int m_full_grid_posts;
+   unsigned int m_delta_posts;
+   unsigned long m_grid_bytes_posted;
+
    // The grid of where vehicles have been recently. 
    ProxGrid m_prox_grid;
 
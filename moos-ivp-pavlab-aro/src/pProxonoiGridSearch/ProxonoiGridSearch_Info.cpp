@@ -74,6 +74,10 @@ void showExampleConfigAndExit()
   blk("  AppTick   = 4                                                 ");
   blk("  CommsTick = 4                                                 ");
   blk("                                                                ");
+  blk("  post_grid          = false   // default                       ");
+  blk("  post_grid_deltas   = false   // default                       ");
+  blk("  delta_format       = text    // default (text or binary)      ");
+  blk("  full_grid_interval = 10      // default (secs)                ");
   blk("}                                                               ");
   blk("                                                                ");
   exit(0);
@@ -111,6 +115,12 @@ void showInterfaceAndExit()
   blk("------------------------------------                            ");
   blk("  Publications are determined by the node message content.      ");
   blk("                                                                ");
+  blk("  VIEW_GRID       = The whole grid, if post_grid = true          ");
+  blk("  VIEW_GRID_DELTA = me's_grid@replace@12,val,0:12,var,0.1       ");
+  blk("                    The cells changed since the last post, if   ");
+  blk("                    post_grid_deltas = true. Binary form if     ");
+  blk("                    delta_format = binary.                      ");
+  blk("                                                                ");
   exit(0);
 }
 
@@ -14,6 +14,8 @@
 #include <set>
 #include <vector>
 #include "EsriBathyGridUtils.h"
+#include "GeomUtils.h"
+#include "DubinsPath.h"
 
 using namespace std;
 
@@ -77,7 +79,6 @@ bool RoutePlan::OnNewMail(MOOSMSG_LIST &NewMail)
 	
 	  // get A* params
 	  m_vertices = m_grid.getVertices();
-	  m_edges = m_grid.getEdges();
 
 	  // add the other start and goal nodes if needed
 	  if (m_use_all_top_cells_as_start) {
@@ -91,7 +92,9 @@ bool RoutePlan::OnNewMail(MOOSMSG_LIST &NewMail)
 	  }
 
 	  bool sort_by_asc_cell_id = false;
-	  bool ok = m_astar.preloadGraph(m_vertices, m_edges, m_start_ids, m_end_ids, sort_by_asc_cell_id);
+	  // the edges come in the grid's compact (CSR) form
+	  bool ok = m_astar.preloadGraph(m_vertices, m_grid.getAdjStart(), m_grid.getAdjacency(),
+					 m_start_ids, m_end_ids, sort_by_asc_cell_id);
 	  if (not ok)
 	    reportRunWarning("Error: was not able to preload graph in A*");
 
@@ -105,7 +108,11 @@ bool RoutePlan::OnNewMail(MOOSMSG_LIST &NewMail)
       if (!m_first_grid_received)
 	reportRunWarning("Mail Error: Recieved a grid delta message before receiving the full grid.");
       
-      bool ok1 = m_grid.processGridDelta(sval);
+      bool ok1 = false;
+      if (msg.IsBinary())
+	ok1 = m_grid.processGridDelta(msg.GetBinaryDataAsVector());
+      else
+	ok1 = m_grid.processGridDelta(sval);
       if (not ok1)
 	reportRunWarning("Mail Error: Was not able to process grid delta" + sval);
 
@@ -140,6 +147,9 @@ bool RoutePlan::OnNewMail(MOOSMSG_LIST &NewMail)
       
     } else if (key == "NAV_Y") {
       m_nav_y = dval;
+      
+    } else if (key == "NAV_HEADING") {
+      m_nav_heading = dval;
 
     } else if (key == "CYCLE_INDEX") {
       // just completed a cycle of points,
@@ -505,6 +515,11 @@ bool RoutePlan::OnStartUp()
       handled = isNumber(value);
       m_max_proposal_iterations = stoul(value);
 
+    } else if(param == "turn_radius") {
+      handled = isNumber(value) and (stod(value) >= 0);
+      if (handled)
+	m_turn_radius = stod(value);
+
     } else if(param == "max_maintain_path") {
       handled = isNumber(value);
       m_path_maintained_max = stoi(value);
@@ -608,6 +623,7 @@ void RoutePlan::registerVariables()
   Register(m_proposal_var_name, 0);
   Register("NAV_X",0);
   Register("NAV_Y",0);
+  Register("NAV_HEADING",0);
   Register("CYCLE_INDEX",0);
   Register("ADD_START",0);
   Register("ADD_END",0);
@@ -1052,14 +1068,18 @@ void RoutePlan::sendOutOwnProposal(std::string spec)
 
 
 // define a cost function
-// returns the minimum cost to get to any line between
-// any two vertexes 
+// returns the cost to get to the closest point on any line
+// between any two vertexes.  The cost is the length of the
+// Dubins path from the current position and heading, which
+// with turn_radius=0 is the straight line distance.
 double RoutePlan::calcCost( const std::vector<double>& v1,
 			    const std::vector<std::vector<double> >& V2,
 			    std::size_t& index_of_closest_vertex)
 {
   double min_distance = std::numeric_limits<double>::max();
   std::vector<double> best_vertex;
+  double closest_x = v1[0];
+  double closest_y = v1[1];
 
   for (int i=0; i<(V2.size() - 1); i++){
 
@@ -1067,6 +1087,8 @@ double RoutePlan::calcCost( const std::vector<double>& v1,
 
     if (distance < min_distance) {
       min_distance = distance;
+      perpSegIntPt(V2[i][0], V2[i][1], V2[i+1][0], V2[i+1][1],
+		   v1[0], v1[1], closest_x, closest_y);
       // check if the ith vertex is closer than the i+1th vertex
       double dist_i = hypot(V2[i][0] - v1[0], V2[i][1] - v1[1]);
       double dist_i_plus_one = hypot(V2[i+1][0] - v1[0], V2[i+1][1] - v1[1]);
@@ -1082,8 +1104,10 @@ double RoutePlan::calcCost( const std::vector<double>& v1,
   int cell_id;
   m_grid.getCellID(best_vertex[0], best_vertex[1], cell_id);
   index_of_closest_vertex = static_cast<std::size_t>(cell_id);
-  
-  return (min_distance);
+
+  DubinsPath path(v1[0], v1[1], m_nav_heading, m_turn_radius);
+  path.setGoal(closest_x, closest_y);
+  return (path.getLength());
 }
 
 
@@ -76,6 +76,7 @@ class RoutePlan : public AppCastingMOOSApp
    // proposal params
    double m_proposal_wait_time = 2.0;
    unsigned int m_max_proposal_iterations = 10;
+   double m_turn_radius = 0;             // 0 bids the straight line distance
 
    
    std::map<std::string, std::string> m_path_color_map;
@@ -128,7 +129,6 @@ class RoutePlan : public AppCastingMOOSApp
    // A* variables
    SimpleAStar m_astar = SimpleAStar();
    std::map<size_t, std::vector<double> > m_vertices;
-   std::vector<std::pair<size_t,size_t> > m_edges;
    std::set<size_t> m_obstacles;
    std::set<size_t> m_final_obstacles;
    
@@ -156,6 +156,7 @@ class RoutePlan : public AppCastingMOOSApp
 
    double m_nav_x = 0.0;
    double m_nav_y = 0.0;
+   double m_nav_heading = 0.0;
    std::map<std::string, std::vector<std::size_t> > m_proposed_paths;
    std::map<std::string, double> m_proposed_costs;
    std::map<std::string, double> m_proposal_arrival_time;
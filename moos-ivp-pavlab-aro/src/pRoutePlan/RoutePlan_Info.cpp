@@ -87,6 +87,10 @@ void showExampleConfigAndExit()
   blk("                                                                ");
   blk("  max_proposal_iterations =  10  // defaults                    ");
   blk("                                                                ");
+  blk("  turn_radius = 0    // proposal cost is the Dubins path length ");
+  blk("                     // to the path at this turn radius (m).    ");
+  blk("                     // 0 (default) is the straight distance    ");
+  blk("                                                                ");
   blk("          depth_threshold = 20.0   // value threshold           ");
   blk("   variance_pct_threshold = 0.33   // dynamic variance threshold");
   blk("                                     cells with depth less than ");
@@ -155,6 +159,7 @@ void showInterfaceAndExit()
   blk("SUBSCRIPTIONS:                                                  ");
   blk("------------------------------------                            ");
   blk("  NAV_X, NAV_Y  = Vehicle position (double)                     ");
+  blk("  NAV_HEADING   = Vehicle heading, for the Dubins proposal cost  ");
   blk("  PROPOSED_PATH = Format example:                               ");
   blk("                  vname=abe;1,2,3,4,5,6;123.4  (example)        ");
   blk("                  where the path is 1,2,3,4,5,6                 ");
@@ -0,0 +1,531 @@
+/**
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//
+//   This file was written by agent, October 19th, 2026
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt  This program is distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+**/
+
+
+
+
+/*
+ * DBBench.cpp
+ *
+ *  Throughput and latency of a MOOSDB under a repeatable load. Publishers
+ *  each write one variable of a given size at a given rate, every
+ *  subscriber takes every publisher's variable (so the fan out is the
+ *  number of subscribers), either by name or with one wildcard. Clients
+ *  are synchronous (CMOOSCommClient), asynchronous (MOOSAsyncCommClient)
+ *  or a mix.
+ *
+ *  The DB is started in a child process (so its CPU can be measured on
+ *  its own), in this process, or is one already running on this machine.
+ *  A DB is started for each number of workers asked for, and against
+ *  each one every combination of the sizes, rates, fan outs and
+ *  subscription styles is run in turn. For each the rate messages were
+ *  published and delivered, how many were never delivered, the delivery
+ *  latency percentiles and the CPU the DB used are printed, as a table
+ *  or as csv.
+ */
+#ifdef _WIN32
+#define NOMINMAX
+#endif
+
+#include "MOOS/libMOOS/DB/MOOSDB.h"
+#include "MOOS/libMOOS/Comms/MOOSCommClient.h"
+#include "MOOS/libMOOS/Comms/MOOSAsyncCommClient.h"
+#include "MOOS/libMOOS/Utils/CommandLineParser.h"
+#include "MOOS/libMOOS/Utils/MOOSUtilityFunctions.h"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include <cstdlib>
+
+#ifndef _WIN32
+#include <csignal>
+#include <sys/resource.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+//only deliveries of messages written after this are counted
+std::atomic<double> gCaptureFrom(1e300);
+
+//deliveries counted so far, across all subscribers
+std::atomic<unsigned long long> gDelivered(0);
+
+struct BenchClient
+{
+	CMOOSCommClient * pComms;
+	std::vector<std::string> Subscribes;
+	std::string sWildcard;
+
+	//publishers
+	std::string sPublishes;
+	unsigned long long nSent;
+
+	//subscribers, only touched by the client's own mail thread
+	std::vector<double> Latencies;
+};
+
+bool _OnConnect(void * pParam)
+{
+	BenchClient * pC = (BenchClient*)pParam;
+	if(!pC->sWildcard.empty())
+		pC->pComms->Register(pC->sWildcard,"*",0.0);
+	for(unsigned int i = 0;i<pC->Subscribes.size();i++)
+		pC->pComms->Register(pC->Subscribes[i],0.0);
+	return true;
+}
+
+bool _OnMail(void * pParam)
+{
+	BenchClient * pC = (BenchClient*)pParam;
+	MOOSMSG_LIST M;
+	pC->pComms->Fetch(M);
+
+	double dfNow = MOOSLocalTime();
+	double dfFrom = gCaptureFrom;
+	unsigned long long n = 0;
+	MOOSMSG_LIST::iterator q;
+	for(q=M.begin();q!=M.end();++q)
+	{
+		if(q->IsType(MOOS_NOTIFY) && q->GetTime()>=dfFrom)
+		{
+			pC->Latencies.push_back((dfNow-q->GetTime())*1e3);
+			n++;
+		}
+	}
+	gDelivered+=n;
+	return true;
+}
+
+//static, MOOSDB.cpp has one of its own
+static void PrintHelpAndExit()
+{
+	MOOSTrace("\n\nMOOSDB throughput and latency benchmark\n");
+	MOOSTrace("  --db=<fork|inproc|local>  : where the DB runs (default fork, a child process)\n");
+	MOOSTrace("  --host=<string>           : host of a local DB (default 127.0.0.1)\n");
+	MOOSTrace("  --port=<numeric>          : port of the (first) DB (default 9600)\n");
+	MOOSTrace("  --db_pid=<numeric>        : pid of a local DB, to measure its CPU\n");
+	MOOSTrace("  --workers=<list>          : DB worker counts to compare, each on its own DB\n");
+	MOOSTrace("                              on the next port along (default 0). A local DB\n");
+	MOOSTrace("                              is only labelled with the first\n");
+	MOOSTrace("  --publishers=<numeric>    : publishing clients (default 4)\n");
+	MOOSTrace("  --clients=<async|sync|mixed> : kind of clients (default async)\n");
+	MOOSTrace("  --sync_hz=<numeric>       : fundamental frequency of sync clients (default 100)\n");
+	MOOSTrace("  --sizes=<list>            : payload sizes in bytes (default 8,1024,65536)\n");
+	MOOSTrace("  --rates=<list>            : writes per second per publisher (default 10,100,1000)\n");
+	MOOSTrace("  --fanouts=<list>          : subscribers per variable (default 1,4,16)\n");
+	MOOSTrace("  --wildcard=<no|yes|both>  : subscribe by name, wildcard or both (default no)\n");
+	MOOSTrace("  --period=<numeric>        : seconds to measure each case (default 5)\n");
+	MOOSTrace("  --csv                     : print csv\n");
+
+	MOOSTrace("\n\nExample Usage:\n");
+	MOOSTrace(" 1K messages at 100 and 1000Hz to 1 and 8 subscribers against a DB with 4 workers\n");
+	MOOSTrace("  ./moosdb_bench --workers=4 --sizes=1024 --rates=100,1000 --fanouts=1,8\n");
+	MOOSTrace(" 16 publishers at 1000Hz each to 16 subscribers, without workers and with 1, 2 and 4\n");
+	MOOSTrace("  ./moosdb_bench --workers=0,1,2,4 --publishers=16 --sizes=8 --rates=1000 --fanouts=16\n");
+
+	exit(0);
+}
+
+std::vector<unsigned int> ParseList(std::string sList)
+{
+	std::vector<unsigned int> Values;
+	while(!sList.empty())
+		Values.push_back(atoi(MOOSChomp(sList,",").c_str()));
+	return Values;
+}
+
+//seconds of CPU a process has used, -1 if it can't be told
+double ProcessCPU(int nPid)
+{
+#ifdef _WIN32
+	MOOS::DeliberatelyNotUsed(nPid);
+	return -1;
+#else
+	if(nPid==0)
+	{
+		struct rusage U;
+		getrusage(RUSAGE_SELF,&U);
+		return U.ru_utime.tv_sec+U.ru_utime.tv_usec*1e-6+U.ru_stime.tv_sec+U.ru_stime.tv_usec*1e-6;
+	}
+
+	std::ifstream Stat(MOOSFormat("/proc/%d/stat",nPid).c_str());
+	std::string sStat;
+	if(!Stat.is_open() || !std::getline(Stat,sStat))
+		return -1;
+
+	//utime and stime are the 14th and 15th fields, the name (2nd) may
+	//hold spaces so count from its closing bracket
+	std::string::size_type n = sStat.rfind(')');
+	if(n==std::string::npos)
+		return -1;
+	std::istringstream Fields(sStat.substr(n+2));
+	std::string sSkip;
+	for(int i = 3;i<14;i++)
+		Fields>>sSkip;
+	double dfUser = 0,dfSys = 0;
+	Fields>>dfUser>>dfSys;
+	return (dfUser+dfSys)/sysconf(_SC_CLK_TCK);
+#endif
+}
+
+struct Case
+{
+	unsigned int nSize;
+	unsigned int nRate;
+	unsigned int nFanOut;
+	bool bWildcard;
+};
+
+struct Result
+{
+	double dfPublished;
+	double dfDelivered;
+	long long nLost;
+	double dfP50,dfP99,dfP999;
+	double dfCPU;
+};
+
+CMOOSCommClient * MakeClient(const std::string & sKind,unsigned int n)
+{
+	if(sKind=="sync" || (sKind=="mixed" && n%2==1))
+		return new CMOOSCommClient;
+	return new MOOS::MOOSAsyncCommClient;
+}
+
+Result RunCase(const Case & C,unsigned int nCase,const std::string & sHost,int nPort,
+		unsigned int nPublishers,const std::string & sKind,unsigned int nSyncHz,
+		double dfPeriod,int nCPUPid)
+{
+	std::string sPrefix = MOOSFormat("BENCH%u_",nCase);
+
+	std::vector<BenchClient*> Publishers(nPublishers);
+	std::vector<BenchClient*> Subscribers(C.nFanOut);
+	std::vector<BenchClient*> All;
+
+	for(unsigned int i = 0;i<C.nFanOut;i++)
+	{
+		BenchClient * pC = new BenchClient;
+		pC->pComms = MakeClient(sKind,i);
+		pC->nSent = 0;
+		if(C.bWildcard)
+			pC->sWildcard = sPrefix+"*";
+		else
+		{
+			for(unsigned int k = 0;k<nPublishers;k++)
+				pC->Subscribes.push_back(MOOSFormat("%sP%u",sPrefix.c_str(),k));
+		}
+		pC->Latencies.reserve((size_t)(dfPeriod*C.nRate*nPublishers*1.2));
+		Subscribers[i] = pC;
+		All.push_back(pC);
+	}
+	for(unsigned int i = 0;i<nPublishers;i++)
+	{
+		BenchClient * pC = new BenchClient;
+		pC->pComms = MakeClient(sKind,i);
+		pC->nSent = 0;
+		pC->sPublishes = MOOSFormat("%sP%u",sPrefix.c_str(),i);
+		Publishers[i] = pC;
+		All.push_back(pC);
+	}
+
+	for(unsigned int i = 0;i<All.size();i++)
+	{
+		BenchClient * pC = All[i];
+		pC->pComms->SetQuiet(true);
+		pC->pComms->SetOnConnectCallBack(_OnConnect,pC);
+		pC->pComms->SetOnMailCallBack(_OnMail,pC);
+		pC->pComms->Run(sHost,nPort,MOOSFormat("bench%u_%u",nCase,i),nSyncHz);
+	}
+	for(unsigned int i = 0;i<All.size();i++)
+	{
+		while(!All[i]->pComms->IsConnected())
+			MOOSPause(10);
+	}
+
+	//let registrations settle and the publishers get going before
+	//anything is counted
+	std::atomic<bool> bGo(true);
+	std::vector<std::thread> Writers;
+	std::vector<unsigned char> Payload(C.nSize,'x');
+	double dfWarmUp = 1.0;
+	double dfStart = MOOSLocalTime()+dfWarmUp;
+	gCaptureFrom = dfStart;
+	for(unsigned int i = 0;i<nPublishers;i++)
+	{
+		Writers.push_back(std::thread([&bGo,&Payload,&C,dfStart](BenchClient * pC){
+			double dfNext = MOOSLocalTime();
+			while(bGo)
+			{
+				double dfNow = MOOSLocalTime();
+				pC->pComms->Notify(pC->sPublishes,Payload,dfNow);
+				if(dfNow>=dfStart)
+					pC->nSent++;
+
+				dfNext+=1.0/C.nRate;
+				double dfWait = dfNext-MOOSLocalTime();
+				if(dfWait>0)
+					MOOSPause((int)(dfWait*1000.0),false);
+			}
+		},Publishers[i]));
+	}
+
+	MOOSPause((int)(dfWarmUp*1000.0));
+	double dfCPU0 = ProcessCPU(nCPUPid);
+	double dfT0 = MOOSLocalTime();
+
+	MOOSPause((int)(dfPeriod*1000.0));
+	bGo = false;
+	for(unsigned int i = 0;i<Writers.size();i++)
+		Writers[i].join();
+	double dfTaken = MOOSLocalTime()-dfT0;
+	double dfCPU1 = ProcessCPU(nCPUPid);
+
+	//every subscriber should get every message written after the start,
+	//give the last of them time to arrive (sync clients only fetch at
+	//their own rate)
+	unsigned long long nSent = 0;
+	for(unsigned int i = 0;i<nPublishers;i++)
+		nSent+=Publishers[i]->nSent;
+	unsigned long long nExpected = nSent*C.nFanOut;
+	unsigned long long nDelivered = gDelivered;
+	double dfLastChange = MOOSLocalTime();
+	while(nDelivered<nExpected && MOOSLocalTime()-dfLastChange<2.0)
+	{
+		MOOSPause(100);
+		if(gDelivered!=nDelivered)
+		{
+			nDelivered = gDelivered;
+			dfLastChange = MOOSLocalTime();
+		}
+	}
+	gCaptureFrom = 1e300;
+
+	Result R;
+
+	std::vector<double> Latencies;
+	for(unsigned int i = 0;i<All.size();i++)
+	{
+		All[i]->pComms->Close(true);
+		Latencies.insert(Latencies.end(),All[i]->Latencies.begin(),All[i]->Latencies.end());
+		delete All[i]->pComms;
+		delete All[i];
+	}
+
+	R.dfPublished = nSent/dfTaken;
+	R.dfDelivered = Latencies.size()/dfTaken;
+	R.nLost = (long long)nExpected-(long long)Latencies.size();
+	R.dfP50 = R.dfP99 = R.dfP999 = -1;
+	if(!Latencies.empty())
+	{
+		std::sort(Latencies.begin(),Latencies.end());
+		R.dfP50 = Latencies[Latencies.size()/2];
+		R.dfP99 = Latencies[(Latencies.size()*99)/100];
+		R.dfP999 = Latencies[(Latencies.size()*999)/1000];
+	}
+	R.dfCPU = (dfCPU0<0 || dfCPU1<0) ? -1 : 100.0*(dfCPU1-dfCPU0)/dfTaken;
+	return R;
+}
+
+std::vector<char*> DBArgs(std::vector<std::string> & Args,int nPort,unsigned int nWorkers)
+{
+	Args.push_back("moosdb_bench");
+	Args.push_back(MOOSFormat("--moos_port=%d",nPort));
+	Args.push_back(MOOSFormat("--workers=%u",nWorkers));
+	Args.push_back("--moos_suicide_disable");
+	Args.push_back("--moos_no_colour");
+	std::vector<char*> Argv;
+	for(unsigned int i = 0;i<Args.size();i++)
+		Argv.push_back(const_cast<char*>(Args[i].c_str()));
+	return Argv;
+}
+
+int main(int argc, char * argv[])
+{
+	MOOS::CommandLineParser P(argc,argv);
+
+	if(P.GetFlag("-h","--help"))
+		PrintHelpAndExit();
+
+	std::string sDB = "fork";
+	P.GetVariable("--db",sDB);
+#ifdef _WIN32
+	if(sDB=="fork")
+		sDB = "inproc";
+#endif
+
+	std::string sHost = "127.0.0.1";
+	P.GetVariable("--host",sHost);
+
+	int nPort = 9600;
+	P.GetVariable("--port",nPort);
+
+	int nLocalPid = -1;
+	P.GetVariable("--db_pid",nLocalPid);
+
+	std::string sWorkers = "0";
+	P.GetVariable("--workers",sWorkers);
+
+	unsigned int nPublishers = 4;
+	P.GetVariable("--publishers",nPublishers);
+
+	std::string sKind = "async";
+	P.GetVariable("--clients",sKind);
+
+	unsigned int nSyncHz = 100;
+	P.GetVariable("--sync_hz",nSyncHz);
+
+	std::string sSizes = "8,1024,65536";
+	P.GetVariable("--sizes",sSizes);
+	std::string sRates = "10,100,1000";
+	P.GetVariable("--rates",sRates);
+	std::string sFanOuts = "1,4,16";
+	P.GetVariable("--fanouts",sFanOuts);
+
+	std::string sWildcard = "no";
+	P.GetVariable("--wildcard",sWildcard);
+
+	double dfPeriod = 5.0;
+	P.GetVariable("--period",dfPeriod);
+
+	bool bCSV = P.GetFlag("--csv");
+
+	std::vector<unsigned int> Workers = ParseList(sWorkers);
+	if(sDB=="local")
+		Workers.resize(1);
+
+	if(nPublishers==0 || Workers.empty() || (sKind!="async" && sKind!="sync" && sKind!="mixed"))
+		PrintHelpAndExit();
+
+	//start the DBs before this process has any threads of its own
+	std::vector<int> DBPids(Workers.size(),nLocalPid);
+	std::vector<std::unique_ptr<CMOOSDB> > DBs;
+	std::vector<std::string> Args;
+#ifndef _WIN32
+	std::vector<pid_t> Children;
+	if(sDB=="fork")
+	{
+		for(unsigned int w = 0;w<Workers.size();w++)
+		{
+			pid_t nChild = fork();
+			if(nChild==0)
+			{
+				std::vector<char*> Argv = DBArgs(Args,nPort+w,Workers[w]);
+				CMOOSDB DB;
+				DB.SetQuiet(true);
+				DB.Run((int)Argv.size(),&Argv[0]);
+				while(DB.IsRunning())
+					MOOSPause(1000);
+				_exit(0);
+			}
+			Children.push_back(nChild);
+			DBPids[w] = (int)nChild;
+		}
+		MOOSPause(500);
+	}
+#endif
+	if(sDB=="inproc")
+	{
+		for(unsigned int w = 0;w<Workers.size();w++)
+		{
+			std::vector<std::string> WorkerArgs;
+			std::vector<char*> Argv = DBArgs(WorkerArgs,nPort+w,Workers[w]);
+			DBs.push_back(std::unique_ptr<CMOOSDB>(new CMOOSDB));
+			DBs.back()->SetQuiet(true);
+			DBs.back()->Run((int)Argv.size(),&Argv[0]);
+			//all this process can say is what it used as a whole
+			DBPids[w] = 0;
+		}
+	}
+
+	std::vector<Case> Cases;
+	std::vector<unsigned int> Sizes = ParseList(sSizes);
+	std::vector<unsigned int> Rates = ParseList(sRates);
+	std::vector<unsigned int> FanOuts = ParseList(sFanOuts);
+	for(unsigned int s = 0;s<Sizes.size();s++)
+		for(unsigned int r = 0;r<Rates.size();r++)
+			for(unsigned int f = 0;f<FanOuts.size();f++)
+				for(int w = 0;w<2;w++)
+				{
+					bool bWildcard = w==1;
+					if((bWildcard && sWildcard=="no") || (!bWildcard && sWildcard=="yes"))
+						continue;
+					if(Rates[r]==0 || FanOuts[f]==0)
+						continue;
+					Case C = {Sizes[s],Rates[r],FanOuts[f],bWildcard};
+					Cases.push_back(C);
+				}
+
+	if(bCSV)
+	{
+		std::cout<<"workers,size,rate,fanout,wildcard,clients,published_per_s,delivered_per_s,lost,p50_ms,p99_ms,p999_ms,db_cpu_percent\n";
+	}
+	else
+	{
+		std::cout<<nPublishers<<" "<<sKind<<" publishers, DB "<<sDB
+				<<(DBPids[0]==0 ? " (cpu is the whole process)" : "")<<"\n";
+		std::cout<<"workers   size   rate fanout wild    published/s    delivered/s     lost    p50 ms    p99 ms   p999 ms  db cpu %\n";
+	}
+
+	std::cout<<std::fixed;
+	unsigned int nCase = 0;
+	for(unsigned int w = 0;w<Workers.size();w++)
+	{
+		for(unsigned int i = 0;i<Cases.size();i++)
+		{
+			const Case & C = Cases[i];
+			gDelivered = 0;
+			Result R = RunCase(C,nCase++,sHost,nPort+w,nPublishers,sKind,nSyncHz,dfPeriod,DBPids[w]);
+
+			if(bCSV)
+			{
+				std::cout<<std::setprecision(3)<<Workers[w]<<","<<C.nSize<<","<<C.nRate<<","<<C.nFanOut<<","<<C.bWildcard<<","<<sKind<<","
+						<<R.dfPublished<<","<<R.dfDelivered<<","<<R.nLost<<","<<R.dfP50<<","<<R.dfP99<<","<<R.dfP999<<","<<R.dfCPU<<"\n";
+			}
+			else
+			{
+				std::cout<<std::setw(7)<<Workers[w]<<std::setw(7)<<C.nSize<<std::setw(7)<<C.nRate<<std::setw(7)<<C.nFanOut
+						<<std::setw(5)<<(C.bWildcard ? "yes" : "no")
+						<<std::setprecision(0)<<std::setw(15)<<R.dfPublished<<std::setw(15)<<R.dfDelivered
+						<<std::setw(9)<<R.nLost
+						<<std::setprecision(3)<<std::setw(10)<<R.dfP50<<std::setw(10)<<R.dfP99<<std::setw(10)<<R.dfP999
+						<<std::setprecision(1)<<std::setw(10)<<R.dfCPU<<"\n";
+			}
+			std::cout.flush();
+		}
+	}
+
+#ifndef _WIN32
+	for(unsigned int i = 0;i<Children.size();i++)
+	{
+		kill(Children[i],SIGTERM);
+		waitpid(Children[i],NULL,0);
+	}
+#endif
+
+	return 0;
+}
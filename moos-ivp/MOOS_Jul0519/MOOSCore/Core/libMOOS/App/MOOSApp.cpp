@@ -37,6 +37,11 @@
 #include "MOOS/libMOOS/Utils/MOOSPlaybackStatus.h"
 #include "MOOS/libMOOS/App/MOOSApp.h"
 #include "MOOS/libMOOS/Utils/ConsoleColours.h"
+#include "MOOS/libMOOS/Utils/AppPerfStats.h"
+#include "MOOS/libMOOS/Comms/MsgTrace.h"
+#include "MOOS/libMOOS/Comms/LatestOnlySubscriptions.h"
+#include "MOOS/libMOOS/Comms/MsgPool.h"
+#include "MOOS/libMOOS/Comms/ShmTransport.h"
 #include "MOOS/libMOOS/MOOSVersion.h"
 #include "MOOS/libMOOS/GitVersion.h"
 
@@ -60,6 +65,19 @@ bool MOOSMsgTimeSorter(const CMOOSMsg  &M1, const CMOOSMsg &M2)
     return (M1.GetTime() < M2.GetTime());
 }
 
+// book keeping common to every Notify: count it and, if the variable is
+// being traced and this post is sampled, fill in a traced aux source
+static bool PrepareNotify(const std::string & sVar, const std::string & sSrcAux,
+                          std::string & sTracedAux, double dfTime)
+{
+    MOOS::AppPerfStats::Instance().CountNotify();
+
+    MOOS::MsgTrace & Trace = MOOS::MsgTrace::Instance();
+    if(!Trace.Tagging())
+        return false;
+    return Trace.Tag(sVar, sSrcAux, sTracedAux, dfTime < 0 ? MOOSTime() : dfTime);
+}
+
 //////////////////////////////////////////////////
 //  these are file-scope methods which allow
 //  redirection of a call back into the CMOOSApp Class
@@ -217,6 +235,7 @@ void CMOOSApp::PrintDefaultCommandLineSwitches()
 	std::cout<<"  --moos_quiet                : don't print banner information \n";
 	std::cout<<"  --moos_quit_on_iterate_fail : quit if iterate fails \n";
 	std::cout<<"  --moos_no_colour            : disable colour printing \n";
+	std::cout<<"  --moos_shm                  : use shared memory to a DB on this machine \n";
     std::cout<<"  --moos_suicide_disable      : disable suicide monitoring \n";
     std::cout<<"  --moos_suicide_print        : print suicide conditions \n";
 
@@ -715,6 +734,40 @@ bool CMOOSApp::DoRunWork()
             if(m_bSortMailByTime)
                 MailIn.sort(MOOSMsgTimeSorter);
             
+            MOOS::AppPerfStats & Perf = MOOS::AppPerfStats::Instance();
+            double dfMailStart = 0;
+            if(Perf.Enabled())
+            {
+                //age of each message on arrival, in real (unwarped) seconds
+                double dfNow = MOOSTime();
+                double dfWarp = GetMOOSTimeWarp();
+                MOOSMSG_LIST::iterator q;
+                for(q = MailIn.begin(); q != MailIn.end(); ++q)
+                {
+                    if(q->IsType(MOOS_NOTIFY))
+                        Perf.Record(MOOS::AppPerfStats::MAIL_AGE,
+                                    (dfNow - q->GetTime()) / dfWarp);
+                }
+                Perf.CountMail(MailIn.size());
+                dfMailStart = MOOSLocalTime(false);
+            }
+
+            //take message traces off the mail so GetSourceAux() is what
+            //the sender set, and report receipt of them (MSG_TRACE)
+            MOOS::MsgTrace & Trace = MOOS::MsgTrace::Instance();
+            if(Trace.HoldTraces(MailIn) && Trace.Reporting())
+            {
+                double dfNow = MOOSTime();
+                MOOSMSG_LIST::iterator q;
+                for(q = MailIn.begin(); q != MailIn.end(); ++q)
+                {
+                    std::string sTrace = Trace.HeldTrace(*q);
+                    if(!sTrace.empty())
+                        Notify("MSG_TRACE", Trace.ReceiptReport(q->GetKey(),
+                                                                sTrace,
+                                                                dfNow));
+                }
+            }
             
             //call our own private version
             OnNewMailPrivate(MailIn);
@@ -722,7 +775,14 @@ bool CMOOSApp::DoRunWork()
             //classes will have their own personal versions of this
             OnNewMail(MailIn);
             
+            if(dfMailStart > 0)
+                Perf.Record(MOOS::AppPerfStats::MAIL_PROCESS,
+                            MOOSLocalTime(false) - dfMailStart);
+            
             m_nMailCount++;
+
+            //hand the spent messages back for reuse by the comms thread
+            MOOS::MsgPool::Instance().Give(MailIn);
         }
         
 
@@ -741,7 +801,10 @@ bool CMOOSApp::DoRunWork()
             	if(m_bQuitOnIterateFail && !bOK)
             		return false;
 
+				double dfIterateStart = MOOSLocalTime(false);
 				bOK = Iterate();
+				MOOS::AppPerfStats::Instance().Record(MOOS::AppPerfStats::ITERATE,
+						MOOSLocalTime(false) - dfIterateStart);
 				if(m_bQuitOnIterateFail && !bOK)
 					return false;
 
@@ -764,7 +827,10 @@ bool CMOOSApp::DoRunWork()
         {
 			/////////////////////////////////////////
 			//  do application specific processing
+			double dfIterateStart = MOOSLocalTime(false);
 			bool bOK = Iterate();
+			MOOS::AppPerfStats::Instance().Record(MOOS::AppPerfStats::ITERATE,
+					MOOSLocalTime(false) - dfIterateStart);
 
 			if(m_bQuitOnIterateFail && !bOK)
 				return false;
@@ -1022,21 +1088,33 @@ bool CMOOSApp::OnDisconnectFromServer()
 /* this block of functions simply notifies the DB that a string variable has changed*/
 bool CMOOSApp::Notify(const std::string &sVar, const std::string & sVal, double dfTime)
 {
+	std::string sTracedAux;
+	if(PrepareNotify(sVar,"",sTracedAux,dfTime))
+		return m_Comms.Notify(sVar,sVal,sTracedAux,dfTime);
 	return m_Comms.Notify(sVar,sVal,dfTime);
 }
 
 bool CMOOSApp::Notify(const std::string &sVar, const std::string & sVal, const std::string & sSrcAux, double dfTime)
 {
+	std::string sTracedAux;
+	if(PrepareNotify(sVar,sSrcAux,sTracedAux,dfTime))
+		return m_Comms.Notify(sVar,sVal,sTracedAux,dfTime);
 	return m_Comms.Notify(sVar,sVal,sSrcAux,dfTime);
 }
 
 bool CMOOSApp::Notify(const std::string &sVar, const char * sVal,double dfTime)
 {
+	std::string sTracedAux;
+	if(PrepareNotify(sVar,"",sTracedAux,dfTime))
+		return m_Comms.Notify(sVar,sVal,sTracedAux,dfTime);
 	return m_Comms.Notify(sVar,sVal,dfTime);
 }
 
 bool CMOOSApp::Notify(const std::string &sVar, const char * sVal,const std::string & sSrcAux, double dfTime)
 {
+	std::string sTracedAux;
+	if(PrepareNotify(sVar,sSrcAux,sTracedAux,dfTime))
+		return m_Comms.Notify(sVar,sVal,sTracedAux,dfTime);
 	return m_Comms.Notify(sVar,sVal,sSrcAux,dfTime);
 }
 
@@ -1044,10 +1122,16 @@ bool CMOOSApp::Notify(const std::string &sVar, const char * sVal,const std::stri
 /** notify the MOOS community that something has changed (double)*/
 bool CMOOSApp::Notify(const std::string & sVar,double dfVal, double dfTime)
 {
+	std::string sTracedAux;
+	if(PrepareNotify(sVar,"",sTracedAux,dfTime))
+		return m_Comms.Notify(sVar,dfVal,sTracedAux,dfTime);
 	return m_Comms.Notify(sVar,dfVal,dfTime);
 }
 bool CMOOSApp::Notify(const std::string & sVar,double dfVal, const std::string & sSrcAux,double dfTime)
 {
+	std::string sTracedAux;
+	if(PrepareNotify(sVar,sSrcAux,sTracedAux,dfTime))
+		return m_Comms.Notify(sVar,dfVal,sTracedAux,dfTime);
 	return m_Comms.Notify(sVar,dfVal,sSrcAux,dfTime);
 }
 
@@ -1055,20 +1139,32 @@ bool CMOOSApp::Notify(const std::string & sVar,double dfVal, const std::string &
 /** notify the MOOS community that something has changed binary data*/
 bool CMOOSApp::Notify(const std::string & sVar,void *  pData, unsigned int nDataSize, double dfTime)
 {
+	std::string sTracedAux;
+	if(PrepareNotify(sVar,"",sTracedAux,dfTime))
+		return m_Comms.Notify(sVar,pData,nDataSize,sTracedAux,dfTime);
 	return m_Comms.Notify(sVar,pData,nDataSize,dfTime);
 }
 bool CMOOSApp::Notify(const std::string & sVar,void *  pData, unsigned int nDataSize, const std::string & sSrcAux,double dfTime)
 {
+	std::string sTracedAux;
+	if(PrepareNotify(sVar,sSrcAux,sTracedAux,dfTime))
+		return m_Comms.Notify(sVar,pData,nDataSize,sTracedAux,dfTime);
 	return m_Comms.Notify(sVar,pData,nDataSize,sSrcAux,dfTime);
 }
 
 bool CMOOSApp::Notify(const std::string & sVar,const std::vector<unsigned char> & vData, double dfTime)
 {
+	std::string sTracedAux;
+	if(PrepareNotify(sVar,"",sTracedAux,dfTime))
+		return m_Comms.Notify(sVar,vData,sTracedAux,dfTime);
 	return m_Comms.Notify(sVar,vData,dfTime);
 }
 
 bool CMOOSApp::Notify(const std::string & sVar,const std::vector<unsigned char> & vData,const std::string & sSrcAux, double dfTime)
 {
+	std::string sTracedAux;
+	if(PrepareNotify(sVar,sSrcAux,sTracedAux,dfTime))
+		return m_Comms.Notify(sVar,vData,sTracedAux,dfTime);
 	return m_Comms.Notify(sVar,vData,sSrcAux,dfTime);
 }
 
@@ -1152,6 +1248,19 @@ bool CMOOSApp::ConfigureComms()
     m_CommandLineParser.GetOption("--moos_comms_tick",m_nCommsFreq);
     m_nCommsFreq = m_nCommsFreq <0 ? 1 : m_nCommsFreq;
 
+    //variables we only want the latest value of (asked for when registering)
+    std::string sLatestOnly;
+    if(m_MissionReader.GetConfigurationParam("LATEST_ONLY",sLatestOnly))
+        MOOS::LatestOnlySubscriptions::Instance().Set(sLatestOnly);
+
+    //talk through shared memory if the DB is on this machine and agrees,
+    //set for the whole community (UseSharedMemory) or for this app
+    bool bSharedMemory = false;
+    m_MissionReader.GetValue("UseSharedMemory",bSharedMemory);
+    if(GetFlagFromCommandLineOrConfigurationFile("moos_shm"))
+        bSharedMemory = true;
+    MOOS::ShmTransport::Instance().Enable(bSharedMemory);
+
     //register a callback for On Connect
     m_Comms.SetOnConnectCallBack(MOOSAPP_OnConnect,this);
     
@@ -0,0 +1,247 @@
+/**
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//
+//   This file was written by agent, October 19th, 2026
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+**/
+
+/*
+ * DispatchPool.cpp
+ */
+
+#include "MOOS/libMOOS/Comms/DispatchPool.h"
+
+#include <map>
+
+namespace MOOS {
+
+//which worker the calling thread is
+static thread_local int t_worker = -1;
+
+static unsigned int HashOf(const std::string & s)
+{
+    //FNV-1a, cheap and spreads short similar names (client names) well
+    unsigned int h = 2166136261u;
+    for(std::string::size_type i = 0; i < s.size(); i++)
+    {
+        h ^= (unsigned char)s[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/**************************************************************************/
+SlotLock::SlotLock()
+{
+    num_slots_ = 0;
+    exclusive_owner_ = std::thread::id();
+}
+
+/**************************************************************************/
+void SlotLock::SetSlots(unsigned int nSlots)
+{
+    slots_.reset(nSlots ? new Slot[nSlots] : NULL);
+    num_slots_ = nSlots;
+}
+
+/**************************************************************************/
+int SlotLock::MySlot() const
+{
+    return t_worker >= 0 && (unsigned int)t_worker < num_slots_ ? t_worker : -1;
+}
+
+/**************************************************************************/
+void SlotLock::LockShared()
+{
+    int nSlot = MySlot();
+    if(nSlot < 0)
+        LockExclusive();
+    else
+        slots_[nSlot].lock.lock();
+}
+
+/**************************************************************************/
+void SlotLock::UnLockShared()
+{
+    int nSlot = MySlot();
+    if(nSlot < 0)
+        UnLockExclusive();
+    else
+        slots_[nSlot].lock.unlock();
+}
+
+/**************************************************************************/
+void SlotLock::LockExclusive()
+{
+    //always in the same order, so two of these can't deadlock
+    for(unsigned int i = 0; i < num_slots_; i++)
+        slots_[i].lock.lock();
+    exclusive_owner_ = std::this_thread::get_id();
+}
+
+/**************************************************************************/
+void SlotLock::UnLockExclusive()
+{
+    exclusive_owner_ = std::thread::id();
+    for(unsigned int i = num_slots_; i > 0; i--)
+        slots_[i-1].lock.unlock();
+}
+
+/**************************************************************************/
+bool SlotLock::IsExclusiveHere() const
+{
+    return exclusive_owner_.load() == std::this_thread::get_id();
+}
+
+/**************************************************************************/
+DispatchPool & DispatchPool::For(const CMOOSCommServer * pServer)
+{
+    //asked for with every packet, so each thread remembers the last one
+    static thread_local const CMOOSCommServer * t_last_server = NULL;
+    static thread_local DispatchPool * t_last_pool = NULL;
+    if(t_last_pool != NULL && pServer == t_last_server)
+        return *t_last_pool;
+
+    static std::mutex Lock;
+    static std::map<const CMOOSCommServer *, std::unique_ptr<DispatchPool> > Pools;
+
+    std::lock_guard<std::mutex> L(Lock);
+    std::unique_ptr<DispatchPool> & pPool = Pools[pServer];
+    if(!pPool)
+        pPool.reset(new DispatchPool);
+    t_last_server = pServer;
+    t_last_pool = pPool.get();
+    return *pPool;
+}
+
+/**************************************************************************/
+int DispatchPool::CurrentWorker()
+{
+    return t_worker;
+}
+
+/**************************************************************************/
+DispatchPool::DispatchPool()
+{
+    num_workers_ = 0;
+}
+
+/**************************************************************************/
+DispatchPool::~DispatchPool()
+{
+    Stop();
+}
+
+/**************************************************************************/
+void DispatchPool::SetWorkers(unsigned int nWorkers)
+{
+    if(IsRunning())
+        return;
+    num_workers_ = nWorkers;
+    lock_.SetSlots(nWorkers);
+}
+
+/**************************************************************************/
+bool DispatchPool::Start()
+{
+    if(num_workers_ == 0 || IsRunning())
+        return false;
+
+    for(unsigned int i = 0; i < num_workers_; i++)
+        workers_.push_back(std::unique_ptr<Worker>(new Worker));
+    for(unsigned int i = 0; i < num_workers_; i++)
+        workers_[i]->thread = std::thread(&DispatchPool::WorkerLoop, this, i);
+    return true;
+}
+
+/**************************************************************************/
+void DispatchPool::Stop()
+{
+    for(unsigned int i = 0; i < workers_.size(); i++)
+    {
+        std::lock_guard<std::mutex> L(workers_[i]->lock);
+        workers_[i]->quit = true;
+        workers_[i]->work_to_do.notify_one();
+    }
+    for(unsigned int i = 0; i < workers_.size(); i++)
+    {
+        if(workers_[i]->thread.joinable())
+            workers_[i]->thread.join();
+    }
+    workers_.clear();
+}
+
+/**************************************************************************/
+void DispatchPool::Post(const std::string & sKey, const Job & J, bool bExclusive)
+{
+    Worker & W = *workers_[HashOf(sKey) % workers_.size()];
+    std::lock_guard<std::mutex> L(W.lock);
+    W.jobs.push_back(std::make_pair(J, bExclusive));
+    W.work_to_do.notify_one();
+}
+
+/**************************************************************************/
+std::mutex & DispatchPool::DeliveryLock(const std::string & sClient)
+{
+    return delivery_locks_[HashOf(sClient) % kDeliveryStripes];
+}
+
+/**************************************************************************/
+unsigned int DispatchPool::GetBacklog()
+{
+    unsigned int nJobs = 0;
+    for(unsigned int i = 0; i < workers_.size(); i++)
+    {
+        std::lock_guard<std::mutex> L(workers_[i]->lock);
+        nJobs += (unsigned int)workers_[i]->jobs.size();
+    }
+    return nJobs;
+}
+
+/**************************************************************************/
+void DispatchPool::WorkerLoop(unsigned int nIndex)
+{
+    t_worker = (int)nIndex;
+    Worker & W = *workers_[nIndex];
+
+    for(;;)
+    {
+        std::pair<Job, bool> Next;
+        {
+            std::unique_lock<std::mutex> L(W.lock);
+            while(W.jobs.empty() && !W.quit)
+                W.work_to_do.wait(L);
+            if(W.quit)
+                return;
+            Next.first.swap(W.jobs.front().first);
+            Next.second = W.jobs.front().second;
+            W.jobs.pop_front();
+        }
+
+        if(Next.second)
+        {
+            SlotLock::Exclusive L(lock_);
+            Next.first();
+        }
+        else
+        {
+            SlotLock::Shared L(lock_);
+            Next.first();
+        }
+    }
+}
+
+}
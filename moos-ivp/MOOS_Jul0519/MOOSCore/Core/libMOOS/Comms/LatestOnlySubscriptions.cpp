@@ -0,0 +1,88 @@
+/**
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//
+//   This file was written by agent, October 19th, 2026
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+**/
+
+/*
+ * LatestOnlySubscriptions.cpp
+ */
+
+#include "MOOS/libMOOS/Comms/LatestOnlySubscriptions.h"
+
+namespace MOOS {
+
+/**************************************************************************/
+LatestOnlySubscriptions::LatestOnlySubscriptions()
+{
+}
+
+/**************************************************************************/
+LatestOnlySubscriptions & LatestOnlySubscriptions::Instance()
+{
+    static LatestOnlySubscriptions instance;
+    return instance;
+}
+
+/**************************************************************************/
+void LatestOnlySubscriptions::Set(const std::string & sVars)
+{
+    {
+        std::lock_guard<std::mutex> lock(lock_);
+        vars_.clear();
+    }
+
+    std::string::size_type nStart = 0;
+    while(nStart <= sVars.size())
+    {
+        std::string::size_type nEnd = sVars.find(',', nStart);
+        if(nEnd == std::string::npos)
+            nEnd = sVars.size();
+        Add(sVars.substr(nStart, nEnd - nStart));
+        nStart = nEnd + 1;
+    }
+}
+
+/**************************************************************************/
+void LatestOnlySubscriptions::Add(const std::string & sVar)
+{
+    std::string::size_type a = sVar.find_first_not_of(" \t");
+    std::string::size_type b = sVar.find_last_not_of(" \t");
+    if(a == std::string::npos)
+        return;
+
+    std::lock_guard<std::mutex> lock(lock_);
+    vars_.insert(sVar.substr(a, b - a + 1));
+}
+
+/**************************************************************************/
+void LatestOnlySubscriptions::Remove(const std::string & sVar)
+{
+    std::lock_guard<std::mutex> lock(lock_);
+    vars_.erase(sVar);
+}
+
+/**************************************************************************/
+bool LatestOnlySubscriptions::Applies(const std::string & sVar) const
+{
+    std::lock_guard<std::mutex> lock(lock_);
+    if(vars_.empty())
+        return false;
+    return vars_.count(sVar) != 0 || vars_.count("*") != 0;
+}
+
+}
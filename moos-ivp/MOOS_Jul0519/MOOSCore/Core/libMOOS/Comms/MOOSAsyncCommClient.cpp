@@ -45,6 +45,7 @@
 
 #include "MOOS/libMOOS/Comms/MOOSAsyncCommClient.h"
 #include "MOOS/libMOOS/Comms/XPCTcpSocket.h"
+#include "MOOS/libMOOS/Comms/MsgPool.h"
 
 #ifdef max
 #   undef min  // undefine so we can use std::min()
@@ -268,6 +269,7 @@ bool MOOSAsyncCommClient::DoWriting() {
             return false;
 
         MOOSMSG_LIST StuffToSend;
+        MOOS::ScopedMsgRecycler Recycler(StuffToSend);
 
         OutGoingQueue_.AppendToOtherInConstantTime(StuffToSend);
 
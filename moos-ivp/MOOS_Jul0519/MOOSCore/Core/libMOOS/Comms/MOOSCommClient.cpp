@@ -63,6 +63,9 @@
 #include "MOOS/libMOOS/Comms/MOOSCommClient.h"
 #include "MOOS/libMOOS/Comms/MOOSCommPkt.h"
 #include "MOOS/libMOOS/Comms/MOOSSkewFilter.h"
+#include "MOOS/libMOOS/Comms/LatestOnlySubscriptions.h"
+#include "MOOS/libMOOS/Comms/MsgPool.h"
+#include "MOOS/libMOOS/Comms/ShmTransport.h"
 
 
 #include "MOOS/libMOOS/Comms/MulticastNode.h"
@@ -680,8 +683,8 @@ bool CMOOSCommClient::DoClientWork()
 				throw CMOOSException("Serialisation Failed - this must be a lot of mail..."); 
 			}
 
-			//clear the outbox
-			m_OutBox.clear();
+			//clear the outbox (recycling the messages for incoming mail)
+			MOOS::MsgPool::Instance().Give(m_OutBox);
 
 
 		}
@@ -1085,7 +1088,8 @@ bool CMOOSCommClient::Fetch(MOOSMSG_LIST &MsgList)
 	if(!m_bMailPresent)
 		return false;
 
-	MsgList.clear();
+	//last time's mail is spent, recycle it
+	MOOS::MsgPool::Instance().Give(MsgList);
 
 	m_InLock.Lock();
 
@@ -1135,6 +1139,14 @@ bool CMOOSCommClient::HandShake()
 		//a little bit of handshaking..we need to say who we are
 		CMOOSMsg Msg(MOOS_DATA,HandShakeKey(),(char *)m_sMyName.c_str());
 
+		//and, if the DB is on this machine, ask to talk through shared memory
+		MOOS::ShmTransport & Shm = MOOS::ShmTransport::Instance();
+		bool bAskForShm = Shm.IsEnabled() &&
+				MOOSStrCmp(HandShakeKey(),"asynchronous") &&
+				MOOS::ShmTransport::IsLocalPeer(m_pSocket->iGetSocketFd());
+		if(bAskForShm)
+			MOOSAddValToString(Msg.m_sSrcAux,MOOS::ShmTransport::Field(),"request");
+
 		SendMsg(m_pSocket,Msg);
 
 		CMOOSMsg WelcomeMsg;
@@ -1161,6 +1173,22 @@ bool CMOOSCommClient::HandShake()
             m_bDBIsAsynchronous = MOOSStrCmp(WelcomeMsg.GetString(),"asynchronous");
             MOOSValFromString(m_sDBHostAsSeenByDB,WelcomeMsg.m_sSrcAux,"hostname",true);
 
+            //the DB names a segment if it agrees to shared memory. We tell
+            //it whether we could map it, and from then on both sides use it
+            std::string sShmName;
+            bool bShm = false;
+            if(bAskForShm && MOOSValFromString(sShmName,WelcomeMsg.m_sSrcAux,MOOS::ShmTransport::Field(),true))
+            {
+                std::shared_ptr<MOOS::ShmChannel> pChannel(new MOOS::ShmChannel);
+                bShm = pChannel->Open(sShmName);
+
+                CMOOSMsg Ack(MOOS_DATA,MOOS::ShmTransport::Field(),bShm ? "ok" : "fail");
+                SendMsg(m_pSocket,Ack);
+
+                if(bShm)
+                    Shm.Attach(m_pSocket->iGetSocketFd(),pChannel);
+            }
+
 			if(!m_bQuiet)
 			{
 				std::cout<<MOOS::ConsoleColours::Green()<<"[ok]\n";
@@ -1192,6 +1220,17 @@ bool CMOOSCommClient::HandShake()
                     std::cout<<MOOS::ConsoleColours::Green()<<m_sDBHostAsSeenByDB<<"\n";
                     std::cout<<MOOS::ConsoleColours::reset();
 
+                    if(bAskForShm)
+                    {
+                        std::cout<<std::left<<std::setw(40);
+                        std::cout<<"  Shared memory transport is ";
+                        if(bShm)
+                            std::cout<<MOOS::ConsoleColours::Green()<<"[on]\n";
+                        else
+                            std::cout<<MOOS::ConsoleColours::yellow()<<"[off] (using tcp)\n";
+                        std::cout<<MOOS::ConsoleColours::reset();
+                    }
+
                     std::cout<<std::left<<std::setw(40);
 
                     std::cout<<"  Timing skew estimation is ";
@@ -1243,6 +1282,8 @@ std::string CMOOSCommClient::GetCommunityName()
 
 bool CMOOSCommClient::OnCloseConnection()
 {
+	//let go of any shared memory before the descriptor can be reused
+	MOOS::ShmTransport::Instance().Detach(m_pSocket->iGetSocketFd());
 	m_pSocket->vCloseSocket();
 
 	if(m_pSocket)
@@ -1337,6 +1378,11 @@ bool CMOOSCommClient::Register(const string &sVar, double dfInterval)
 	if(1)
 	{
 		CMOOSMsg MsgR(MOOS_REGISTER,sVar.c_str(),dfInterval);
+
+		//ask the DB to only hold the latest value for us if configured
+		if(MOOS::LatestOnlySubscriptions::Instance().Applies(sVar))
+			MOOSAddValToString(MsgR.m_sVal,MOOS::LatestOnlySubscriptions::Field(),std::string("true"));
+
 		bool bSuccess =  Post(MsgR);
 		if(bSuccess)
 		{
@@ -1364,6 +1410,8 @@ bool CMOOSCommClient::Register(const std::string & sVarPattern,const std::string
 	MOOSAddValToString(sMsg,"AppPattern",sAppPattern);
 	MOOSAddValToString(sMsg,"VarPattern",sVarPattern);
 	MOOSAddValToString(sMsg,"Interval",dfInterval);
+	if(MOOS::LatestOnlySubscriptions::Instance().Applies(sVarPattern))
+		MOOSAddValToString(sMsg,MOOS::LatestOnlySubscriptions::Field(),std::string("true"));
 
 	CMOOSMsg MsgR(MOOS_WILDCARD_REGISTER,m_sMyName,sMsg);
 
@@ -32,6 +32,7 @@
 #include "MOOS/libMOOS/Comms/MOOSCommPkt.h"
 #include "MOOS/libMOOS/Comms/XPCTcpSocket.h"
 #include "MOOS/libMOOS/Comms/MOOSCommObject.h"
+#include "MOOS/libMOOS/Comms/ShmTransport.h"
 #include "MOOS/libMOOS/Utils/MOOSException.h"
 #include "MOOS/libMOOS/Utils/ConsoleColours.h"
 #include <iostream>
@@ -43,6 +44,9 @@
 
 const int kMaxBufferSizeKB = 2048;
 
+//a shared memory reader that takes nothing for this long is taken to be gone
+const double kShmSendTimeout = 10.0;
+
 
 //////////////////////////////////////////////////////////////////////
 // Construction/Destruction
@@ -157,10 +161,44 @@ void CMOOSCommObject::SimulateCommsError()
     }
 }
 
+//read a packet from a shared memory channel, with the same timeout and
+//failure rules as from the socket. The socket only tells us if the other
+//side has gone, so look at it each time the channel is quiet for a while
+static bool ReadShmPkt(MOOS::ShmChannel & Channel, int nSocketFD, CMOOSCommPkt &PktRx, int nSecondsTimeout)
+{
+    double dfGiveUp = MOOSLocalTime(false)+nSecondsTimeout;
+
+    int nRqd=0;
+    while((nRqd=PktRx.GetBytesRequired())!=0)
+    {
+        int nRxd = Channel.Read(PktRx.NextWrite(),nRqd,0.5);
+        if(nRxd<0)
+            throw CMOOSException("remote side closed....");
+
+        if(nRxd==0)
+        {
+            if(MOOS::ShmTransport::PeerHasClosed(nSocketFD))
+                throw CMOOSException("remote side closed....");
+            if(nSecondsTimeout>0 && MOOSLocalTime(false)>dfGiveUp)
+                throw CMOOSException(MOOSFormat("remote side closed or lazy client ( waited more than %ds )",nSecondsTimeout));
+            continue;
+        }
+
+        if(!PktRx.OnBytesWritten(PktRx.NextWrite(),nRxd))
+            throw CMOOSException("CMOOSCommObject::ReadPkt() Failed Rx - Packet rejects filling");
+    }
+
+    return true;
+}
+
 bool CMOOSCommObject::ReadPkt(XPCTcpSocket *pSocket, CMOOSCommPkt &PktRx, int nSecondsTimeout)
 {
     #define CHUNK_READ 8192
 
+    std::shared_ptr<MOOS::ShmChannel> pChannel = MOOS::ShmTransport::Instance().Find(pSocket->iGetSocketFd());
+    if(pChannel)
+        return ReadShmPkt(*pChannel,pSocket->iGetSocketFd(),PktRx,nSecondsTimeout);
+
     //now receive a message back..
     int nRqd=0;
     while((nRqd=PktRx.GetBytesRequired())!=0)
@@ -292,8 +330,13 @@ bool CMOOSCommObject::SendPkt(XPCTcpSocket *pSocket, CMOOSCommPkt &PktTx)
 
     try
     {
+        std::shared_ptr<MOOS::ShmChannel> pChannel = MOOS::ShmTransport::Instance().Find(pSocket->iGetSocketFd());
 
-        if(m_bFakeDodgyComms)
+        if(pChannel)
+        {
+            nSent = pChannel->Write(PktTx.Stream(),PktTx.GetStreamLength(),kShmSendTimeout);
+        }
+        else if(m_bFakeDodgyComms)
         {
             //this is some very low level cruft that is only hear to provide
         	//some gruesome testing - normal programmers should ignore this
@@ -33,6 +33,7 @@
 
 #include "MOOS/libMOOS/Utils/MOOSUtilityFunctions.h"
 #include "MOOS/libMOOS/Comms/MOOSCommPkt.h"
+#include "MOOS/libMOOS/Comms/MsgPool.h"
 
 #include <iostream>
 #include <cstring>
@@ -238,9 +239,18 @@ bool CMOOSCommPkt::Serialize(MOOSMSG_LIST &List,
         nSpaceFree -= sizeof(unsigned char);
         m_nByteCount += sizeof(unsigned char);
 
+        //unpack into recycled messages (whose strings already have space)
+        //and splice them onto the list rather than copying them in
+        MOOSMSG_LIST Spare;
+        MOOS::ScopedMsgRecycler Recycler(Spare);
+        MOOS::MsgPool::Instance().Take(Spare, nMessages);
+
         for (int i = 0; i < nMessages; i++) {
 
-            CMOOSMsg Msg;
+            if (Spare.empty())
+                Spare.push_back(CMOOSMsg());
+
+            CMOOSMsg & Msg = Spare.front();
             int nUsed = Msg.Serialize(m_pNextData, nSpaceFree, false);
 
             if (nUsed != -1) {
@@ -253,7 +263,7 @@ bool CMOOSCommPkt::Serialize(MOOSMSG_LIST &List,
                 }
 
                 if (!bOmit) {
-                    List.push_back(Msg);
+                    List.splice(List.end(), Spare, Spare.begin());
                 }
 
                 m_pNextData += nUsed;
@@ -42,6 +42,8 @@
 #include "MOOS/libMOOS/Utils/ConsoleColours.h"
 #include "MOOS/libMOOS/Comms/MOOSCommServer.h"
 #include "MOOS/libMOOS/Comms/MOOSCommPkt.h"
+#include "MOOS/libMOOS/Comms/MsgPool.h"
+#include "MOOS/libMOOS/Comms/ShmTransport.h"
 #include "MOOS/libMOOS/Utils/MOOSException.h"
 #include "MOOS/libMOOS/Comms/XPCTcpSocket.h"
 #include "MOOS/libMOOS/Utils/ThreadPriority.h"
@@ -349,6 +351,7 @@ bool  CMOOSCommServer::OnAbsentClient(XPCTcpSocket* pClient)
 
     GetMaxSocketFD();
 
+    MOOS::ShmTransport::Instance().Detach(pClient->iGetSocketFd());
     pClient->vCloseSocket();
 
     delete pClient;
@@ -657,6 +660,8 @@ bool CMOOSCommServer::ProcessClient()
 
             CMOOSCommPkt PktRx,PktTx;
             MOOSMSG_LIST MsgLstRx,MsgLstTx;
+            MOOS::ScopedMsgRecycler RxRecycler(MsgLstRx);
+            MOOS::ScopedMsgRecycler TxRecycler(MsgLstTx);
 
             //read input
             ReadPkt(m_pFocusSocket,PktRx);
@@ -760,6 +765,11 @@ bool CMOOSCommServer::OnNewClient(XPCTcpSocket * pNewClient,char * sName)
                 std::cout<<"  Type          :  "<<MOOS::ConsoleColours::green()<<"Synchronous"<<MOOS::ConsoleColours::reset()<<"\n";
             }
 
+            if(MOOS::ShmTransport::Instance().Find(pNewClient->iGetSocketFd()))
+            {
+                std::cout<<"  Transport     :  "<<MOOS::ConsoleColours::Yellow()<<"shared memory"<<MOOS::ConsoleColours::reset()<<"\n";
+            }
+
             if(m_bBoostIOThreads)
             {
                 std::cout<<"  Priority      :  "<<MOOS::ConsoleColours::Yellow()<<"raised"<<MOOS::ConsoleColours::reset()<<"\n";
@@ -827,6 +837,7 @@ bool CMOOSCommServer::OnClientDisconnect()
 
     GetMaxSocketFD();
 
+    MOOS::ShmTransport::Instance().Detach(m_pFocusSocket->iGetSocketFd());
     m_pFocusSocket->vCloseSocket();
 
     delete m_pFocusSocket;
@@ -947,6 +958,8 @@ bool CMOOSCommServer::HandShake(XPCTcpSocket *pNewClient)
 
     double dfSkew = 0;
 
+    bool bAsynchronous = false;
+
     try
     {
 		
@@ -968,6 +981,7 @@ bool CMOOSCommServer::HandShake(XPCTcpSocket *pNewClient)
                 if(MOOSStrCmp(Msg.m_sKey,"asynchronous"))
                 {
                 	m_AsynchronousClientSet.insert(Msg.m_sVal);
+                	bAsynchronous = true;
                 }
 
             }
@@ -995,10 +1009,38 @@ bool CMOOSCommServer::HandShake(XPCTcpSocket *pNewClient)
         std::string sAux;
         MOOSAddValToString(sAux,"hostname",GetLocalIPAddress());
 
+        //offer shared memory to an asynchronous client on this machine
+        //that asks for it. Old clients never ask, and ignore the offer
+        MOOS::ShmTransport & Shm = MOOS::ShmTransport::Instance();
+        std::string sShmRequest;
+        std::shared_ptr<MOOS::ShmChannel> pChannel;
+        if(Shm.IsEnabled() && bAsynchronous && SupportsAsynchronousClients() &&
+           MOOSValFromString(sShmRequest,Msg.m_sSrcAux,MOOS::ShmTransport::Field(),true) &&
+           MOOS::ShmTransport::IsLocalPeer(pNewClient->iGetSocketFd()))
+        {
+            pChannel.reset(new MOOS::ShmChannel);
+            if(pChannel->Create(Shm.NewName(),Shm.GetRingBytes()))
+                MOOSAddValToString(sAux,MOOS::ShmTransport::Field(),pChannel->GetName());
+            else
+                pChannel.reset();
+        }
+
         MsgW.m_sSrcAux = sAux;
         MsgW.m_sOriginatingCommunity = m_sCommunityName;
         SendMsg(pNewClient,MsgW);
 
+        if(pChannel)
+        {
+            //the client says whether it mapped the segment, either way
+            //the name is no longer needed
+            CMOOSMsg Ack;
+            if(!ReadMsg(pNewClient,Ack,5))
+                throw CMOOSException("no reply to shared memory offer");
+            pChannel->Unlink();
+            if(MOOSStrCmp(Ack.GetString(),"ok"))
+                Shm.Attach(pNewClient->iGetSocketFd(),pChannel);
+        }
+
         return true;
     }
     catch (CMOOSException & e)
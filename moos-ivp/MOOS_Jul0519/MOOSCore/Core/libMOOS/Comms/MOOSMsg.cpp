@@ -300,6 +300,46 @@ void  CMOOSMsg::operator >> (char & cVal)
 
 }
 
+/** unchecked little endian writes for the fast path of Serialize(). The
+caller has already made sure everything fits */
+template<class T> inline void FastWrite(unsigned char *& pBuffer, const T & Var)
+{
+    memcpy(pBuffer,&Var,sizeof(T));
+    pBuffer+=sizeof(T);
+}
+
+inline void FastWrite(unsigned char *& pBuffer, const std::string & sVal)
+{
+    int nSize = sVal.size();
+    FastWrite(pBuffer,nSize);
+    memcpy(pBuffer,sVal.data(),nSize);
+    pBuffer+=nSize;
+}
+
+/** bounds checked little endian reads for the fast path of Serialize().
+They fail quietly, the caller reports the failure once */
+template<class T> inline bool FastRead(const unsigned char *& pBuffer,
+                                       const unsigned char * pEnd, T & Var)
+{
+    if(pEnd-pBuffer<(int)sizeof(T))
+        return false;
+    memcpy(&Var,pBuffer,sizeof(T));
+    pBuffer+=sizeof(T);
+    return true;
+}
+
+inline bool FastRead(const unsigned char *& pBuffer,
+                     const unsigned char * pEnd, std::string & sVal)
+{
+    int nSize;
+    if(!FastRead(pBuffer,pEnd,nSize) || nSize<0 || pEnd-pBuffer<nSize)
+        return false;
+    //assign reuses the string's buffer if it is big enough
+    sVal.assign((const char *)pBuffer,nSize);
+    pBuffer+=nSize;
+    return true;
+}
+
 unsigned int CMOOSMsg::GetSizeInBytesWhenSerialised() const
 {
     unsigned int nInt = 2*sizeof(int);
@@ -319,6 +359,55 @@ unsigned int CMOOSMsg::GetSizeInBytesWhenSerialised() const
 
 int CMOOSMsg::Serialize(unsigned char *pBuffer, int nLen, bool bToStream)
 {
+    //on little endian machines (nearly all of them) the wire format is the
+    //memory format so we check space once and copy fields straight in/out
+    if(IsLittleEndian())
+    {
+        if(bToStream)
+        {
+            m_nLength = GetSizeInBytesWhenSerialised();
+            if(m_nLength<=nLen)
+            {
+                unsigned char * p = pBuffer;
+                FastWrite(p,m_nLength);
+                FastWrite(p,m_nID);
+                FastWrite(p,m_cMsgType);
+                FastWrite(p,m_cDataType);
+                FastWrite(p,m_sSrc);
+                FastWrite(p,m_sSrcAux);
+                FastWrite(p,m_sOriginatingCommunity);
+                FastWrite(p,m_sKey);
+                FastWrite(p,m_dfTime);
+                FastWrite(p,m_dfVal);
+                FastWrite(p,m_dfVal2);
+                FastWrite(p,m_sVal);
+                return m_nLength;
+            }
+            //otherwise fall through to the checked path which will complain
+        }
+        else
+        {
+            const unsigned char * p = pBuffer;
+            const unsigned char * pEnd = pBuffer+nLen;
+            if(FastRead(p,pEnd,m_nLength) &&
+               FastRead(p,pEnd,m_nID) &&
+               FastRead(p,pEnd,m_cMsgType) &&
+               FastRead(p,pEnd,m_cDataType) &&
+               FastRead(p,pEnd,m_sSrc) &&
+               FastRead(p,pEnd,m_sSrcAux) &&
+               FastRead(p,pEnd,m_sOriginatingCommunity) &&
+               FastRead(p,pEnd,m_sKey) &&
+               FastRead(p,pEnd,m_dfTime) &&
+               FastRead(p,pEnd,m_dfVal) &&
+               FastRead(p,pEnd,m_dfVal2) &&
+               FastRead(p,pEnd,m_sVal))
+            {
+                return m_nLength;
+            }
+            MOOSTrace("CMOOSMsg::Serialize failed: truncated or corrupt message\n");
+            return -1;
+        }
+    }
 
     if(bToStream)
     {
@@ -0,0 +1,118 @@
+/**
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//
+//   This file was written by agent, October 19th, 2026
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+**/
+
+/*
+ * MsgPool.cpp
+ */
+
+#include "MOOS/libMOOS/Comms/MsgPool.h"
+
+namespace MOOS {
+
+//strings bigger than this (usually binary payloads) are not worth keeping
+static const std::string::size_type kMaxKeptCapacity = 4096;
+
+/**************************************************************************/
+MsgPool::MsgPool()
+{
+    size_ = 0;
+    capacity_ = 8192;
+}
+
+/**************************************************************************/
+MsgPool & MsgPool::Instance()
+{
+    static MsgPool instance;
+    return instance;
+}
+
+/**************************************************************************/
+void MsgPool::Take(MOOSMSG_LIST & Spare, unsigned int nWanted)
+{
+    std::lock_guard<std::mutex> lock(lock_);
+    if(size_ == 0 || nWanted == 0)
+        return;
+
+    if(nWanted >= size_)
+    {
+        Spare.splice(Spare.end(), pool_);
+        size_ = 0;
+        return;
+    }
+
+    MOOSMSG_LIST::iterator q = pool_.begin();
+    for(unsigned int i = 0; i < nWanted; i++)
+        ++q;
+    Spare.splice(Spare.end(), pool_, pool_.begin(), q);
+    size_ -= nWanted;
+}
+
+/**************************************************************************/
+void MsgPool::Give(MOOSMSG_LIST & List)
+{
+    if(List.empty())
+        return;
+
+    //let go of any unusually large buffers before they go in the pool
+    MOOSMSG_LIST::iterator q;
+    unsigned int nGiven = 0;
+    for(q = List.begin(); q != List.end(); ++q, ++nGiven)
+    {
+        if(q->m_sVal.capacity() > kMaxKeptCapacity)
+            std::string().swap(q->m_sVal);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(lock_);
+        if(size_ + nGiven <= capacity_)
+        {
+            pool_.splice(pool_.end(), List);
+            size_ += nGiven;
+            return;
+        }
+    }
+
+    //pool is full, these go back to the heap (outside the lock)
+    List.clear();
+}
+
+/**************************************************************************/
+void MsgPool::SetCapacity(unsigned int nCapacity)
+{
+    MOOSMSG_LIST Surplus;
+    {
+        std::lock_guard<std::mutex> lock(lock_);
+        capacity_ = nCapacity;
+        while(size_ > capacity_)
+        {
+            Surplus.splice(Surplus.end(), pool_, pool_.begin());
+            size_--;
+        }
+    }
+}
+
+/**************************************************************************/
+unsigned int MsgPool::GetSize()
+{
+    std::lock_guard<std::mutex> lock(lock_);
+    return size_;
+}
+
+}
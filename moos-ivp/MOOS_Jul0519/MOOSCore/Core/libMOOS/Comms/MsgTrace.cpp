@@ -0,0 +1,210 @@
+/**
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//
+//   This file was written by agent, October 19th, 2026
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+**/
+
+/*
+ * MsgTrace.cpp
+ */
+
+#include <cstdio>
+
+#include "MOOS/libMOOS/Comms/MsgTrace.h"
+
+namespace MOOS {
+
+static const std::string kTraceMarker = "#trc:";
+
+/**************************************************************************/
+MsgTrace::MsgTrace()
+{
+    tagging_.store(false);
+    reporting_.store(false);
+    next_id_.store(0);
+    sample_interval_ = 10;
+}
+
+/**************************************************************************/
+MsgTrace & MsgTrace::Instance()
+{
+    static MsgTrace instance;
+    return instance;
+}
+
+/**************************************************************************/
+void MsgTrace::SetTracedVars(const std::string & sVars)
+{
+    std::lock_guard<std::mutex> lock(sample_lock_);
+    traced_vars_.clear();
+
+    std::string::size_type nStart = 0;
+    while(nStart <= sVars.size())
+    {
+        std::string::size_type nEnd = sVars.find(',', nStart);
+        if(nEnd == std::string::npos)
+            nEnd = sVars.size();
+
+        std::string sVar = sVars.substr(nStart, nEnd - nStart);
+        std::string::size_type a = sVar.find_first_not_of(" \t");
+        std::string::size_type b = sVar.find_last_not_of(" \t");
+        if(a != std::string::npos)
+            traced_vars_.insert(sVar.substr(a, b - a + 1));
+
+        nStart = nEnd + 1;
+    }
+    tagging_.store(!traced_vars_.empty());
+}
+
+/**************************************************************************/
+void MsgTrace::SetSampleInterval(unsigned int nEvery)
+{
+    std::lock_guard<std::mutex> lock(sample_lock_);
+    sample_interval_ = (nEvery == 0) ? 1 : nEvery;
+}
+
+/**************************************************************************/
+void MsgTrace::SetReporting(bool bReport)
+{
+    reporting_.store(bReport);
+}
+
+/**************************************************************************/
+void MsgTrace::SetName(const std::string & sCommunity, const std::string & sApp)
+{
+    std::lock_guard<std::mutex> lock(sample_lock_);
+    community_ = sCommunity;
+    app_ = sApp;
+}
+
+/**************************************************************************/
+bool MsgTrace::Tag(const std::string & sVar, const std::string & sSrcAux,
+                   std::string & sTracedAux, double dfTime)
+{
+    if(!Tagging())
+        return false;
+
+    std::string sId;
+    {
+        std::lock_guard<std::mutex> lock(sample_lock_);
+        if(traced_vars_.count(sVar) == 0)
+            return false;
+
+        // the first post is always traced, then one in every N
+        unsigned int & nPosts = post_counts_[sVar];
+        bool bSampled = (nPosts % sample_interval_) == 0;
+        nPosts++;
+        if(!bSampled)
+            return false;
+
+        char sSeq[32];
+        snprintf(sSeq, sizeof(sSeq), "%u", next_id_.fetch_add(1));
+        sId = community_ + "/" + app_ + "/" + sSeq;
+    }
+
+    // never nest a trace inside one we are already carrying
+    sTracedAux = StripTrace(sSrcAux) + kTraceMarker + sId;
+    AddHop(sTracedAux, "pub:" + sVar, dfTime);
+    return true;
+}
+
+/**************************************************************************/
+std::string MsgTrace::ReceiptReport(const std::string & sVar,
+                                    const std::string & sSrcAux,
+                                    double dfNow) const
+{
+    std::string sTrace = GetTrace(sSrcAux).substr(kTraceMarker.size());
+
+    std::string::size_type n = sTrace.find(';');
+    std::string sId = sTrace.substr(0, n);
+    std::string sHops;
+    if(n != std::string::npos)
+        sHops = sTrace.substr(n + 1);
+
+    char sTime[32];
+    snprintf(sTime, sizeof(sTime), "%.6f", dfNow);
+
+    return "id=" + sId + ",var=" + sVar + ",app=" + app_ +
+           ",rx=" + sTime + ",hops=" + sHops;
+}
+
+/**************************************************************************/
+bool MsgTrace::HoldTraces(MOOSMSG_LIST & Mail)
+{
+    std::lock_guard<std::mutex> lock(held_lock_);
+    held_.clear();
+
+    MOOSMSG_LIST::iterator q;
+    for(q = Mail.begin(); q != Mail.end(); ++q)
+    {
+        std::string::size_type n = q->m_sSrcAux.find(kTraceMarker);
+        if(n == std::string::npos)
+            continue;
+        held_[MsgId(q->m_sKey, q->m_dfTime, q->m_sSrc)] = q->m_sSrcAux.substr(n);
+        q->m_sSrcAux.erase(n);
+    }
+    return !held_.empty();
+}
+
+/**************************************************************************/
+std::string MsgTrace::HeldTrace(const CMOOSMsg & Msg) const
+{
+    std::lock_guard<std::mutex> lock(held_lock_);
+    if(held_.empty())
+        return "";
+
+    std::map<MsgId, std::string>::const_iterator p =
+        held_.find(MsgId(Msg.m_sKey, Msg.m_dfTime, Msg.m_sSrc));
+    if(p == held_.end())
+        return "";
+    return p->second;
+}
+
+/**************************************************************************/
+bool MsgTrace::IsTraced(const std::string & sSrcAux)
+{
+    return !sSrcAux.empty() && sSrcAux.find(kTraceMarker) != std::string::npos;
+}
+
+/**************************************************************************/
+void MsgTrace::AddHop(std::string & sSrcAux, const std::string & sHop,
+                      double dfTime)
+{
+    char sTime[32];
+    snprintf(sTime, sizeof(sTime), "@%.6f", dfTime);
+    sSrcAux += ";" + sHop + sTime;
+}
+
+/**************************************************************************/
+std::string MsgTrace::GetTrace(const std::string & sSrcAux)
+{
+    std::string::size_type n = sSrcAux.find(kTraceMarker);
+    if(n == std::string::npos)
+        return "";
+    return sSrcAux.substr(n);
+}
+
+/**************************************************************************/
+std::string MsgTrace::StripTrace(const std::string & sSrcAux)
+{
+    std::string::size_type n = sSrcAux.find(kTraceMarker);
+    if(n == std::string::npos)
+        return sSrcAux;
+    return sSrcAux.substr(0, n);
+}
+
+}
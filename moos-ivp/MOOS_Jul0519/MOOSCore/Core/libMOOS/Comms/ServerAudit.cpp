@@ -251,15 +251,13 @@ public:
 
 	bool GetTimingStatisticSummary(std::string & sSummary)
 	{
+	    //the DB asks from its own threads while clients are being audited
+	    MOOS::ScopedLock L(lock_);
+
 	    std::map<std::string,ClientAudit>::iterator q;
 	    for(q =Audits_.begin();q!=Audits_.end();++q )
 	    {
-	        std::string sT;
-	        if(!GetTimingStatisticSummary(q->first,sT))
-	            return false;
-
-            sSummary+=sT;
-
+            sSummary+=TimingStatisticSummary(q->first,q->second);
 	    }
 	    return true;
 	}
@@ -267,22 +265,28 @@ public:
 
     bool GetTimingStatisticSummary(const std::string & sClient,std::string & sSummary)
     {
+        MOOS::ScopedLock L(lock_);
+
         std::map<std::string,ClientAudit>::iterator q = Audits_.find(sClient);
         if(q==Audits_.end())
             return false;
 
+        sSummary=TimingStatisticSummary(sClient,q->second);
+
+        return true;
+
+    }
+
+    //call with lock_ held
+    std::string TimingStatisticSummary(const std::string & sClient,const ClientAudit & rA)
+    {
         std::stringstream ss;
-        ClientAudit & rA = q->second;
         ss<<sClient<<"=";
         ss<<rA.recent_latency_ms_<<":";
         ss<<rA.max_latency_ms_<<":";
         ss<<rA.min_latency_ms_<<":";
         ss<<rA.moving_average_latency_ms_<<",";
-
-        sSummary=ss.str();
-
-        return true;
-
+        return ss.str();
     }
 
 
@@ -0,0 +1,566 @@
+/**
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//
+//   This file was written by agent, October 19th, 2026
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+**/
+
+/*
+ * ShmTransport.cpp
+ */
+
+#include "MOOS/libMOOS/Comms/ShmTransport.h"
+
+#include <cstring>
+#include <sstream>
+
+#ifdef __linux__
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <netinet/in.h>
+#endif
+
+namespace MOOS {
+
+#ifdef __linux__
+
+static const unsigned int kShmMagic = 0x4d4f4f53;
+static const unsigned int kShmVersion = 1;
+
+//longest single wait, so a lost wake up or a peer that died
+//holding nothing costs at most this
+static const double kWaitSlice = 0.05;
+
+/* One direction. head and tail count bytes written and read since the
+ * start and only ever grow, so head-tail is what is waiting to be read.
+ * Each lives on its own cache line as each end writes only one of them.
+ * The mutex and conditions are only for sleeping, data never needs them */
+struct ShmRing
+{
+    alignas(64) std::atomic<unsigned long long> head;
+    alignas(64) std::atomic<unsigned long long> tail;
+    alignas(64) std::atomic<int> reader_waiting;
+    std::atomic<int> writer_waiting;
+    pthread_mutex_t mutex;
+    pthread_cond_t not_empty;
+    pthread_cond_t not_full;
+};
+
+/* The start of the segment, the data of both rings follows it */
+struct ShmSegment
+{
+    std::atomic<unsigned int> magic;
+    unsigned int version;
+    unsigned int ring_bytes;
+    std::atomic<int> closed;
+    ShmRing ring[2];
+};
+
+//the creator (the DB) writes ring 1 and reads ring 0, the other end
+//the reverse
+static ShmRing & WriteRing(ShmSegment * pSeg, bool bCreator)
+{
+    return pSeg->ring[bCreator ? 1 : 0];
+}
+
+static ShmRing & ReadRing(ShmSegment * pSeg, bool bCreator)
+{
+    return pSeg->ring[bCreator ? 0 : 1];
+}
+
+static unsigned char * RingData(ShmSegment * pSeg, const ShmRing & Ring)
+{
+    unsigned char * pBase = reinterpret_cast<unsigned char *>(pSeg) + sizeof(ShmSegment);
+    return &Ring == &pSeg->ring[0] ? pBase : pBase + pSeg->ring_bytes;
+}
+
+static void LockRing(ShmRing & Ring)
+{
+    //a process that died holding it leaves it for us to recover
+    if(pthread_mutex_lock(&Ring.mutex) == EOWNERDEAD)
+        pthread_mutex_consistent(&Ring.mutex);
+}
+
+static double MonotonicNow()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+//sleep on a condition for at most one slice, the mutex held
+static void TimedWait(ShmRing & Ring, pthread_cond_t & Cond, double dfSeconds)
+{
+    if(dfSeconds > kWaitSlice)
+        dfSeconds = kWaitSlice;
+    double dfUntil = MonotonicNow() + dfSeconds;
+    struct timespec ts;
+    ts.tv_sec = (time_t)dfUntil;
+    ts.tv_nsec = (long)((dfUntil - ts.tv_sec) * 1e9);
+    if(pthread_cond_timedwait(&Cond, &Ring.mutex, &ts) == EOWNERDEAD)
+        pthread_mutex_consistent(&Ring.mutex);
+}
+
+//wake a sleeper, if there might be one
+static void Wake(ShmRing & Ring, std::atomic<int> & Waiting, pthread_cond_t & Cond)
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if(Waiting.load(std::memory_order_seq_cst) == 0)
+        return;
+    LockRing(Ring);
+    pthread_cond_broadcast(&Cond);
+    pthread_mutex_unlock(&Ring.mutex);
+}
+
+/**************************************************************************/
+ShmChannel::ShmChannel()
+{
+    creator_ = false;
+    linked_ = false;
+    seg_ = NULL;
+    mapped_bytes_ = 0;
+}
+
+/**************************************************************************/
+ShmChannel::~ShmChannel()
+{
+    if(seg_ != NULL)
+    {
+        Close();
+        munmap(seg_, mapped_bytes_);
+    }
+    Unlink();
+}
+
+/**************************************************************************/
+bool ShmChannel::Supported()
+{
+    return true;
+}
+
+/**************************************************************************/
+bool ShmChannel::Map(int nFD, size_t nBytes)
+{
+    void * p = mmap(NULL, nBytes, PROT_READ | PROT_WRITE, MAP_SHARED, nFD, 0);
+    close(nFD);
+    if(p == MAP_FAILED)
+        return false;
+    seg_ = static_cast<ShmSegment *>(p);
+    mapped_bytes_ = nBytes;
+    return true;
+}
+
+/**************************************************************************/
+bool ShmChannel::Create(const std::string & sName, unsigned int nRingBytes)
+{
+    if(seg_ != NULL || nRingBytes < 4096)
+        return false;
+
+    int nFD = shm_open(sName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if(nFD < 0)
+        return false;
+
+    size_t nBytes = sizeof(ShmSegment) + 2 * (size_t)nRingBytes;
+    if(ftruncate(nFD, nBytes) != 0 || !Map(nFD, nBytes))
+    {
+        close(nFD);
+        shm_unlink(sName.c_str());
+        return false;
+    }
+    name_ = sName;
+    creator_ = true;
+    linked_ = true;
+
+    seg_->version = kShmVersion;
+    seg_->ring_bytes = nRingBytes;
+    seg_->closed.store(0);
+
+    pthread_mutexattr_t MutexAttr;
+    pthread_mutexattr_init(&MutexAttr);
+    pthread_mutexattr_setpshared(&MutexAttr, PTHREAD_PROCESS_SHARED);
+    pthread_mutexattr_setrobust(&MutexAttr, PTHREAD_MUTEX_ROBUST);
+    pthread_condattr_t CondAttr;
+    pthread_condattr_init(&CondAttr);
+    pthread_condattr_setpshared(&CondAttr, PTHREAD_PROCESS_SHARED);
+    pthread_condattr_setclock(&CondAttr, CLOCK_MONOTONIC);
+
+    for(int i = 0; i < 2; i++)
+    {
+        ShmRing & Ring = seg_->ring[i];
+        Ring.head.store(0);
+        Ring.tail.store(0);
+        Ring.reader_waiting.store(0);
+        Ring.writer_waiting.store(0);
+        pthread_mutex_init(&Ring.mutex, &MutexAttr);
+        pthread_cond_init(&Ring.not_empty, &CondAttr);
+        pthread_cond_init(&Ring.not_full, &CondAttr);
+    }
+    pthread_mutexattr_destroy(&MutexAttr);
+    pthread_condattr_destroy(&CondAttr);
+
+    //last, so whoever opens it sees a finished header
+    seg_->magic.store(kShmMagic, std::memory_order_release);
+    return true;
+}
+
+/**************************************************************************/
+bool ShmChannel::Open(const std::string & sName)
+{
+    if(seg_ != NULL)
+        return false;
+
+    int nFD = shm_open(sName.c_str(), O_RDWR, 0600);
+    if(nFD < 0)
+        return false;
+
+    struct stat st;
+    if(fstat(nFD, &st) != 0 || (size_t)st.st_size < sizeof(ShmSegment) || !Map(nFD, st.st_size))
+    {
+        close(nFD);
+        return false;
+    }
+    name_ = sName;
+    creator_ = false;
+
+    if(seg_->magic.load(std::memory_order_acquire) != kShmMagic ||
+       seg_->version != kShmVersion ||
+       sizeof(ShmSegment) + 2 * (size_t)seg_->ring_bytes != mapped_bytes_)
+    {
+        munmap(seg_, mapped_bytes_);
+        seg_ = NULL;
+        return false;
+    }
+    return true;
+}
+
+/**************************************************************************/
+void ShmChannel::Unlink()
+{
+    if(linked_)
+        shm_unlink(name_.c_str());
+    linked_ = false;
+}
+
+/**************************************************************************/
+unsigned int ShmChannel::GetRingBytes() const
+{
+    return seg_ == NULL ? 0 : seg_->ring_bytes;
+}
+
+/**************************************************************************/
+bool ShmChannel::IsClosed() const
+{
+    return seg_ == NULL || seg_->closed.load(std::memory_order_acquire) != 0;
+}
+
+/**************************************************************************/
+void ShmChannel::Close()
+{
+    if(seg_ == NULL)
+        return;
+    seg_->closed.store(1, std::memory_order_seq_cst);
+    for(int i = 0; i < 2; i++)
+    {
+        ShmRing & Ring = seg_->ring[i];
+        LockRing(Ring);
+        pthread_cond_broadcast(&Ring.not_empty);
+        pthread_cond_broadcast(&Ring.not_full);
+        pthread_mutex_unlock(&Ring.mutex);
+    }
+}
+
+/**************************************************************************/
+int ShmChannel::Write(const unsigned char * pData, int nBytes, double dfTimeout)
+{
+    if(seg_ == NULL)
+        return -1;
+
+    std::lock_guard<std::mutex> lock(write_lock_);
+
+    ShmRing & Ring = WriteRing(seg_, creator_);
+    unsigned char * pRing = RingData(seg_, Ring);
+    const unsigned long long nSize = seg_->ring_bytes;
+    double dfGiveUp = MonotonicNow() + dfTimeout;
+
+    int nSent = 0;
+    while(nSent < nBytes)
+    {
+        if(IsClosed())
+            return -1;
+
+        unsigned long long nHead = Ring.head.load(std::memory_order_relaxed);
+        unsigned long long nSpace = nSize - (nHead - Ring.tail.load(std::memory_order_acquire));
+        if(nSpace == 0)
+        {
+            double dfLeft = dfGiveUp - MonotonicNow();
+            if(dfLeft <= 0)
+                return -1;
+
+            //sleep until the reader makes room, checking again once we
+            //are seen to be waiting so a wake up can't slip past
+            LockRing(Ring);
+            Ring.writer_waiting.store(1, std::memory_order_seq_cst);
+            if(nHead - Ring.tail.load(std::memory_order_seq_cst) == nSize && !IsClosed())
+                TimedWait(Ring, Ring.not_full, dfLeft);
+            Ring.writer_waiting.store(0, std::memory_order_relaxed);
+            pthread_mutex_unlock(&Ring.mutex);
+            continue;
+        }
+
+        unsigned long long nNow = nBytes - nSent;
+        if(nNow > nSpace)
+            nNow = nSpace;
+
+        //copy in at most two pieces, either side of the wrap
+        unsigned long long nAt = nHead % nSize;
+        unsigned long long nFirst = nSize - nAt < nNow ? nSize - nAt : nNow;
+        memcpy(pRing + nAt, pData + nSent, nFirst);
+        memcpy(pRing, pData + nSent + nFirst, nNow - nFirst);
+
+        Ring.head.store(nHead + nNow, std::memory_order_release);
+        Wake(Ring, Ring.reader_waiting, Ring.not_empty);
+        nSent += (int)nNow;
+    }
+    return nSent;
+}
+
+/**************************************************************************/
+int ShmChannel::Read(unsigned char * pData, int nMax, double dfTimeout)
+{
+    if(seg_ == NULL)
+        return -1;
+
+    ShmRing & Ring = ReadRing(seg_, creator_);
+    unsigned char * pRing = RingData(seg_, Ring);
+    const unsigned long long nSize = seg_->ring_bytes;
+
+    if(!WaitForData(dfTimeout))
+        return 0;
+
+    unsigned long long nTail = Ring.tail.load(std::memory_order_relaxed);
+    unsigned long long nReady = Ring.head.load(std::memory_order_acquire) - nTail;
+    if(nReady == 0)
+        return -1; //woken because closed
+
+    unsigned long long nNow = nReady < (unsigned long long)nMax ? nReady : nMax;
+    unsigned long long nAt = nTail % nSize;
+    unsigned long long nFirst = nSize - nAt < nNow ? nSize - nAt : nNow;
+    memcpy(pData, pRing + nAt, nFirst);
+    memcpy(pData + nFirst, pRing, nNow - nFirst);
+
+    Ring.tail.store(nTail + nNow, std::memory_order_release);
+    Wake(Ring, Ring.writer_waiting, Ring.not_full);
+    return (int)nNow;
+}
+
+/**************************************************************************/
+bool ShmChannel::WaitForData(double dfTimeout)
+{
+    if(seg_ == NULL)
+        return true;
+
+    ShmRing & Ring = ReadRing(seg_, creator_);
+    double dfGiveUp = MonotonicNow() + dfTimeout;
+
+    for(;;)
+    {
+        unsigned long long nTail = Ring.tail.load(std::memory_order_relaxed);
+        if(Ring.head.load(std::memory_order_acquire) != nTail || IsClosed())
+            return true;
+
+        double dfLeft = dfGiveUp - MonotonicNow();
+        if(dfLeft <= 0)
+            return false;
+
+        LockRing(Ring);
+        Ring.reader_waiting.store(1, std::memory_order_seq_cst);
+        if(Ring.head.load(std::memory_order_seq_cst) == nTail && !IsClosed())
+            TimedWait(Ring, Ring.not_empty, dfLeft);
+        Ring.reader_waiting.store(0, std::memory_order_relaxed);
+        pthread_mutex_unlock(&Ring.mutex);
+    }
+}
+
+/**************************************************************************/
+bool ShmTransport::IsLocalPeer(int nSocketFD)
+{
+    struct sockaddr_storage Mine, Theirs;
+    socklen_t nMine = sizeof(Mine), nTheirs = sizeof(Theirs);
+    if(getsockname(nSocketFD, (struct sockaddr *)&Mine, &nMine) != 0 ||
+       getpeername(nSocketFD, (struct sockaddr *)&Theirs, &nTheirs) != 0)
+        return false;
+    if(Mine.ss_family != Theirs.ss_family)
+        return false;
+
+    if(Mine.ss_family == AF_INET)
+    {
+        return ((struct sockaddr_in *)&Mine)->sin_addr.s_addr ==
+               ((struct sockaddr_in *)&Theirs)->sin_addr.s_addr;
+    }
+    if(Mine.ss_family == AF_INET6)
+    {
+        return memcmp(&((struct sockaddr_in6 *)&Mine)->sin6_addr,
+                      &((struct sockaddr_in6 *)&Theirs)->sin6_addr,
+                      sizeof(struct in6_addr)) == 0;
+    }
+    return false;
+}
+
+/**************************************************************************/
+bool ShmTransport::PeerHasClosed(int nSocketFD)
+{
+    //nothing else is ever sent on the socket once a channel is attached,
+    //so if it is readable the other end has gone
+    fd_set fds;
+    FD_ZERO(&fds);
+    FD_SET(nSocketFD, &fds);
+    struct timeval tv = {0, 0};
+    if(select(nSocketFD + 1, &fds, NULL, NULL, &tv) <= 0)
+        return false;
+
+    char c;
+    ssize_t n = recv(nSocketFD, &c, 1, MSG_PEEK | MSG_DONTWAIT);
+    return n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR);
+}
+
+#else
+
+/* Without POSIX shared memory nothing is ever offered or accepted, so
+ * every connection stays on TCP */
+
+ShmChannel::ShmChannel() : creator_(false), linked_(false), seg_(NULL), mapped_bytes_(0) {}
+ShmChannel::~ShmChannel() {}
+bool ShmChannel::Supported() { return false; }
+bool ShmChannel::Map(int, size_t) { return false; }
+bool ShmChannel::Create(const std::string &, unsigned int) { return false; }
+bool ShmChannel::Open(const std::string &) { return false; }
+void ShmChannel::Unlink() {}
+int ShmChannel::Write(const unsigned char *, int, double) { return -1; }
+int ShmChannel::Read(unsigned char *, int, double) { return -1; }
+bool ShmChannel::WaitForData(double) { return true; }
+void ShmChannel::Close() {}
+bool ShmChannel::IsClosed() const { return true; }
+unsigned int ShmChannel::GetRingBytes() const { return 0; }
+bool ShmTransport::IsLocalPeer(int) { return false; }
+bool ShmTransport::PeerHasClosed(int) { return false; }
+
+#endif
+
+/**************************************************************************/
+ShmTransport::ShmTransport()
+{
+    count_ = 0;
+    enabled_ = false;
+    ring_bytes_ = 1024 * 1024;
+    names_made_ = 0;
+}
+
+/**************************************************************************/
+ShmTransport & ShmTransport::Instance()
+{
+    static ShmTransport instance;
+    return instance;
+}
+
+/**************************************************************************/
+void ShmTransport::Enable(bool bEnable)
+{
+    std::lock_guard<std::mutex> lock(lock_);
+    enabled_ = bEnable && ShmChannel::Supported();
+}
+
+/**************************************************************************/
+bool ShmTransport::IsEnabled() const
+{
+    std::lock_guard<std::mutex> lock(lock_);
+    return enabled_;
+}
+
+/**************************************************************************/
+void ShmTransport::SetRingSizeKB(unsigned int nKB)
+{
+    std::lock_guard<std::mutex> lock(lock_);
+    ring_bytes_ = (nKB < 4 ? 4 : nKB) * 1024;
+}
+
+/**************************************************************************/
+unsigned int ShmTransport::GetRingBytes() const
+{
+    std::lock_guard<std::mutex> lock(lock_);
+    return ring_bytes_;
+}
+
+/**************************************************************************/
+std::string ShmTransport::NewName()
+{
+    std::lock_guard<std::mutex> lock(lock_);
+    std::ostringstream ss;
+#ifdef __linux__
+    ss << "/moos_shm_" << getpid() << "_" << names_made_++;
+#else
+    ss << "/moos_shm_" << names_made_++;
+#endif
+    return ss.str();
+}
+
+/**************************************************************************/
+void ShmTransport::Attach(int nSocketFD, std::shared_ptr<ShmChannel> pChannel)
+{
+    std::lock_guard<std::mutex> lock(lock_);
+    channels_[nSocketFD] = pChannel;
+    count_ = (unsigned int)channels_.size();
+}
+
+/**************************************************************************/
+void ShmTransport::Detach(int nSocketFD)
+{
+    std::shared_ptr<ShmChannel> pChannel;
+    {
+        std::lock_guard<std::mutex> lock(lock_);
+        std::map<int, std::shared_ptr<ShmChannel> >::iterator q = channels_.find(nSocketFD);
+        if(q == channels_.end())
+            return;
+        pChannel = q->second;
+        channels_.erase(q);
+        count_ = (unsigned int)channels_.size();
+    }
+
+    //wake any thread still waiting on it, it goes when they let go
+    pChannel->Close();
+}
+
+/**************************************************************************/
+std::shared_ptr<ShmChannel> ShmTransport::Find(int nSocketFD)
+{
+    //nearly always nothing attached, so don't take the lock for that
+    if(count_ == 0)
+        return std::shared_ptr<ShmChannel>();
+
+    std::lock_guard<std::mutex> lock(lock_);
+    std::map<int, std::shared_ptr<ShmChannel> >::iterator q = channels_.find(nSocketFD);
+    if(q == channels_.end())
+        return std::shared_ptr<ShmChannel>();
+    return q->second;
+}
+
+}
@@ -41,6 +41,9 @@
 #include "MOOS/libMOOS/Utils/MOOSException.h"
 #include "MOOS/libMOOS/Comms/XPCTcpSocket.h"
 #include "MOOS/libMOOS/Comms/ThreadedCommServer.h"
+#include "MOOS/libMOOS/Comms/MsgPool.h"
+#include "MOOS/libMOOS/Comms/ShmTransport.h"
+#include "MOOS/libMOOS/Comms/DispatchPool.h"
 #include "MOOS/libMOOS/Utils/ConsoleColours.h"
 #include "MOOS/libMOOS/Utils/ThreadPrint.h"
 #include "MOOS/libMOOS/Utils/ThreadPriority.h"
@@ -104,6 +107,9 @@ bool ThreadedCommServer::Stop()
    if(m_ServerThread.IsThreadRunning())
        m_ServerThread.Stop();
 
+   //and on any workers it was handing packets to
+   DispatchPool::For(this).Stop();
+
     m_ClientThreads.clear();
 
     //maybe the base class has other business
@@ -175,8 +181,11 @@ bool ThreadedCommServer::AddAndStartClientThread(XPCTcpSocket & NewClientSocket,
     		m_dfClientTimeout,
     		m_bBoostIOThreads);
 
-    //add to map
-    m_ClientThreads[sName] = pNewClientThread;
+    //add to map (which workers may be reading)
+    {
+        SlotLock::Exclusive L(DispatchPool::For(this).Lock());
+        m_ClientThreads[sName] = pNewClientThread;
+    }
 
     return pNewClientThread->Start();
 
@@ -201,6 +210,11 @@ bool ThreadedCommServer::ServerLoop()
     	MOOS::BoostThisThread();
     }
 
+    //with workers this thread only hands each packet to the worker its
+    //client is pinned to, the workers process them
+    DispatchPool & Pool = DispatchPool::For(this);
+    bool bParallel = Pool.Start();
+
 	//eternally look at our incoming work list....
 	while(!m_ServerThread.IsQuitRequested())
     {
@@ -223,11 +237,27 @@ bool ThreadedCommServer::ServerLoop()
         switch(SDFromClient._Status){
             case ClientThreadSharedData::PKT_READ:
             {
+                if(bParallel)
+                {
+                    Pool.Post(SDFromClient._sClientName,[this,SDFromClient]() mutable {
+                        ProcessClient(SDFromClient,m_Auditor);
+                    });
+                    break;
+                }
                 ProcessClient(SDFromClient,m_Auditor);
                 break;
             }
 
             case ClientThreadSharedData::CONNECTION_CLOSED:
+                if(bParallel)
+                {
+                    //after its last packet, with no other worker running
+                    Pool.Post(SDFromClient._sClientName,[this,SDFromClient]() mutable {
+                        OnClientDisconnect(SDFromClient);
+                        m_Auditor.Remove(SDFromClient._sClientName);
+                    },true);
+                    break;
+                }
                 OnClientDisconnect(SDFromClient);
                 m_Auditor.Remove(SDFromClient._sClientName);
                 break;
@@ -278,6 +308,8 @@ bool ThreadedCommServer::ProcessClient(ClientThreadSharedData &SDFromClient,MOOS
             double dfTNow = MOOS::Time();
 
             MOOSMSG_LIST MsgLstRx,MsgLstTx;
+            MOOS::ScopedMsgRecycler RxRecycler(MsgLstRx);
+            MOOS::ScopedMsgRecycler TxRecycler(MsgLstTx);
 
             //convert to list of messages
             SDFromClient._pPkt->Serialize(MsgLstRx,false);
@@ -328,6 +360,11 @@ bool ThreadedCommServer::ProcessClient(ClientThreadSharedData &SDFromClient,MOOS
             	TimingMsg.SetDoubleAux(pClient->GetConsolidationTime());
             }
 
+            //the reply is queued before any other worker can collect mail
+            //for this client, so its mail arrives in order
+            DispatchPool & Pool = DispatchPool::For(this);
+            std::unique_lock<std::mutex> Delivery(Pool.DeliveryLock(sWho));
+
             //let owner figure out what to do !
 			//this is a user supplied call back
 			if(!(*m_pfnRxCallBack)(sWho,MsgLstRx,MsgLstTx,m_pRxCallBackParam))
@@ -375,6 +412,7 @@ bool ThreadedCommServer::ProcessClient(ClientThreadSharedData &SDFromClient,MOOS
 				//add it to the work load
 				pClient->SendToClient(SDDownStream);
             }
+            Delivery.unlock();
 
             //was there ever a notification? If not just continue
             if(bIsNotification==false)
@@ -387,8 +425,10 @@ bool ThreadedCommServer::ProcessClient(ClientThreadSharedData &SDFromClient,MOOS
             	ClientThread* pClient = q->second;
             	if(m_pfnFetchAllMailCallBack!=NULL && pClient->IsAsynchronous())
             	{
+            		std::lock_guard<std::mutex> ClientDelivery(Pool.DeliveryLock(q->first));
+
             		//OK this client can handle unsolicited pushes of data
-            		MsgLstTx.clear();
+            		MOOS::MsgPool::Instance().Give(MsgLstTx);
             		if((*m_pfnFetchAllMailCallBack)(q->first,MsgLstTx,m_pFetchAllMailCallBackParam))
                     {
                     	//any pending mail?
@@ -608,6 +648,11 @@ bool ThreadedCommServer::ClientThread::AsynchronousReadLoop()
     	MOOS::BoostThisThread();
     }
 
+    //a client talking through shared memory sends nothing more on the
+    //socket, so wait on the channel instead (the socket still tells us
+    //if the client goes)
+    std::shared_ptr<MOOS::ShmChannel> pShm = MOOS::ShmTransport::Instance().Find(m_ClientSocket.iGetSocketFd());
+
     while(!m_Reader.IsQuitRequested())
     {
 
@@ -629,11 +674,20 @@ bool ThreadedCommServer::ClientThread::AsynchronousReadLoop()
         // for reading.  If data is not available after 1000 useconds, select
         // returns with a value of 0.  If data is available on the socket,
         // the select returns and data can be retrieved off the socket.
-        int iSelectRet = select(m_ClientSocket.iGetSocketFd() + 1,
-            &fdset,
-            NULL,
-            NULL,
-            &timeout);
+        int iSelectRet = 0;
+        if(pShm)
+        {
+            iSelectRet = pShm->WaitForData(1.0) ||
+                MOOS::ShmTransport::PeerHasClosed(m_ClientSocket.iGetSocketFd()) ? 1 : 0;
+        }
+        else
+        {
+            iSelectRet = select(m_ClientSocket.iGetSocketFd() + 1,
+                &fdset,
+                NULL,
+                NULL,
+                &timeout);
+        }
 
         // If select returns a -1, then it failed and the thread exits.
         switch(iSelectRet)
@@ -0,0 +1,170 @@
+/**
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//
+//   This file was written by agent, October 19th, 2026
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+**/
+
+/*
+ * DispatchPool.h
+ *
+ *  Worker threads for ThreadedCommServer. Without workers one central
+ *  thread processes every packet from every client in turn. With them
+ *  (MOOSDB --workers=N) each client is pinned to one worker, so its
+ *  packets are still processed in the order they came, but different
+ *  clients are processed at once.
+ *
+ *  SlotLock is the reader/writer lock that goes with it. Each worker
+ *  has its own slot (a mutex), so workers sharing the lock never touch
+ *  the same cache line. Taking it exclusively takes every slot. Threads
+ *  that are not workers always take it exclusively.
+ */
+
+#ifndef DISPATCHPOOL_H_
+#define DISPATCHPOOL_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <atomic>
+
+class CMOOSCommServer;
+
+namespace MOOS {
+
+class SlotLock
+{
+public:
+    SlotLock();
+
+    /** one slot per worker, only while nobody holds the lock */
+    void SetSlots(unsigned int nSlots);
+    unsigned int GetSlots() const { return num_slots_; }
+
+    void LockShared();
+    void UnLockShared();
+    void LockExclusive();
+    void UnLockExclusive();
+
+    /** does this thread hold it exclusively */
+    bool IsExclusiveHere() const;
+
+    class Shared
+    {
+    public:
+        explicit Shared(SlotLock & L) : lock_(L) { lock_.LockShared(); }
+        ~Shared() { lock_.UnLockShared(); }
+    private:
+        SlotLock & lock_;
+    };
+
+    class Exclusive
+    {
+    public:
+        explicit Exclusive(SlotLock & L) : lock_(L) { lock_.LockExclusive(); }
+        ~Exclusive() { lock_.UnLockExclusive(); }
+    private:
+        SlotLock & lock_;
+    };
+
+private:
+    SlotLock(const SlotLock &);
+    SlotLock & operator=(const SlotLock &);
+
+    //the slot of this thread, or -1 if it has to take them all
+    int MySlot() const;
+
+    //padded so neighbouring slots sit on different cache lines (new[]
+    //doesn't honour alignas before C++17)
+    struct Slot
+    {
+        std::mutex lock;
+        char pad[64];
+    };
+    std::unique_ptr<Slot[]> slots_;
+    unsigned int num_slots_;
+    std::atomic<std::thread::id> exclusive_owner_;
+};
+
+class DispatchPool
+{
+public:
+    typedef std::function<void()> Job;
+
+    /** the pool of a server */
+    static DispatchPool & For(const CMOOSCommServer * pServer);
+
+    /** the worker this thread is, or -1 */
+    static int CurrentWorker();
+
+    /** 0 (the default) means no pool, only before Start() */
+    void SetWorkers(unsigned int nWorkers);
+    unsigned int GetWorkers() const { return num_workers_; }
+
+    bool Start();
+    void Stop();
+    bool IsRunning() const { return !workers_.empty(); }
+
+    /** run Job on the worker sKey is pinned to, in turn with the other
+     *  jobs for sKey. The worker holds Lock() shared while it runs, or
+     *  exclusively if bExclusive */
+    void Post(const std::string & sKey, const Job & J, bool bExclusive = false);
+
+    /** what the workers share (the server's client list) */
+    SlotLock & Lock() { return lock_; }
+
+    /** held while mail for sClient is collected and queued, so packets
+     *  to a client leave in the order their contents were collected */
+    std::mutex & DeliveryLock(const std::string & sClient);
+
+    /** jobs waiting across all workers */
+    unsigned int GetBacklog();
+
+    DispatchPool();
+    ~DispatchPool();
+
+private:
+    DispatchPool(const DispatchPool &);
+    DispatchPool & operator=(const DispatchPool &);
+
+    struct Worker
+    {
+        Worker() : quit(false) {}
+        std::mutex lock;
+        std::condition_variable work_to_do;
+        std::deque<std::pair<Job, bool> > jobs;
+        bool quit;
+        std::thread thread;
+    };
+
+    void WorkerLoop(unsigned int nIndex);
+
+    unsigned int num_workers_;
+    std::vector<std::unique_ptr<Worker> > workers_;
+    SlotLock lock_;
+
+    static const unsigned int kDeliveryStripes = 64;
+    std::mutex delivery_locks_[kDeliveryStripes];
+};
+
+}
+
+#endif /* DISPATCHPOOL_H_ */
@@ -0,0 +1,68 @@
+/**
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//
+//   This file was written by agent, October 19th, 2026
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+**/
+
+/*
+ * LatestOnlySubscriptions.h
+ *
+ *  Variables for which this process only wants the most recent value.
+ *  CMOOSCommClient consults this when it sends a registration so the
+ *  request travels with the subscription, and the MOOSDB then replaces
+ *  a queued notification for the variable rather than queueing another
+ *  behind it. Set with LATEST_ONLY = NAV_X,NAV_Y in an app's config
+ *  block or by calling Add() before registering. "*" means everything.
+ */
+
+#ifndef LATESTONLYSUBSCRIPTIONS_H_
+#define LATESTONLYSUBSCRIPTIONS_H_
+
+#include <mutex>
+#include <set>
+#include <string>
+
+namespace MOOS {
+
+class LatestOnlySubscriptions
+{
+public:
+    static LatestOnlySubscriptions & Instance();
+
+    /** field added to a (wildcard) registration to ask for coalescing */
+    static const char * Field() { return "LatestOnly"; }
+
+    /** comma separated list, replaces any existing list */
+    void Set(const std::string & sVars);
+    void Add(const std::string & sVar);
+    void Remove(const std::string & sVar);
+
+    /** should a registration for sVar (or a var pattern) ask for it */
+    bool Applies(const std::string & sVar) const;
+
+private:
+    LatestOnlySubscriptions();
+    LatestOnlySubscriptions(const LatestOnlySubscriptions &);
+    LatestOnlySubscriptions & operator=(const LatestOnlySubscriptions &);
+
+    mutable std::mutex lock_;
+    std::set<std::string> vars_;
+};
+
+}
+
+#endif /* LATESTONLYSUBSCRIPTIONS_H_ */
@@ -0,0 +1,78 @@
+/**
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//
+//   This file was written by agent, October 19th, 2026
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+**/
+
+/*
+ * MsgPool.h
+ *
+ *  A process wide pool of spent CMOOSMsg list nodes. Packets are
+ *  unpacked into recycled nodes whose strings keep their capacity, so
+ *  at steady state deserialising a packet makes no heap allocations.
+ *  Lists are handed back with Give() once their contents are consumed.
+ *  All transfers are list splices, so nothing is copied.
+ */
+
+#ifndef MSGPOOL_H_
+#define MSGPOOL_H_
+
+#include <mutex>
+
+#include "MOOS/libMOOS/Comms/MOOSMsg.h"
+
+namespace MOOS {
+
+class MsgPool
+{
+public:
+    static MsgPool & Instance();
+
+    /** move up to nWanted recycled messages onto the end of Spare */
+    void Take(MOOSMSG_LIST & Spare, unsigned int nWanted);
+
+    /** recycle every message in List (which is left empty) */
+    void Give(MOOSMSG_LIST & List);
+
+    /** most messages held; 0 turns pooling off. Default 8192 */
+    void SetCapacity(unsigned int nCapacity);
+    unsigned int GetSize();
+
+private:
+    MsgPool();
+    MsgPool(const MsgPool &);
+    MsgPool & operator=(const MsgPool &);
+
+    std::mutex lock_;
+    MOOSMSG_LIST pool_;
+    unsigned int size_;
+    unsigned int capacity_;
+};
+
+/** hands a list back to the pool when it goes out of scope */
+class ScopedMsgRecycler
+{
+public:
+    explicit ScopedMsgRecycler(MOOSMSG_LIST & List) : list_(List) {}
+    ~ScopedMsgRecycler() { MsgPool::Instance().Give(list_); }
+private:
+    MOOSMSG_LIST & list_;
+};
+
+}
+
+#endif /* MSGPOOL_H_ */
@@ -0,0 +1,120 @@
+/**
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//
+//   This file was written by agent, October 19th, 2026
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+**/
+
+/*
+ * MsgTrace.h
+ *
+ *  Opt-in end to end tracing of sampled messages. A publishing app
+ *  tags every Nth post of a traced variable with a trace id carried in
+ *  CMOOSMsg::m_sSrcAux. Each MOOSDB, pShare and forwarding app on the
+ *  path appends a time stamped hop, and receiving apps publish the
+ *  whole hop chain as MSG_TRACE so it lands in the alogs.
+ *
+ *  On the wire the trace is a suffix of the aux source so existing aux
+ *  content is kept intact:
+ *
+ *    <orig aux>#trc:<community>/<app>/<seq>;pub:<var>@<t>;dbrx:<db>@<t>;...
+ *
+ *  CMOOSApp takes it off again (HoldTraces) before mail reaches
+ *  OnNewMail, so GetSourceAux() is what the sender set. Apps that pass
+ *  a traced message on ask for its trace with HeldTrace().
+ */
+
+#ifndef MSGTRACE_H_
+#define MSGTRACE_H_
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <tuple>
+
+#include "MOOS/libMOOS/Comms/MOOSMsg.h"
+
+namespace MOOS {
+
+class MsgTrace
+{
+public:
+    static MsgTrace & Instance();
+
+    /** comma separated list of variables this app tags when it posts */
+    void SetTracedVars(const std::string & sVars);
+    /** tag one post in every nEvery of each traced variable */
+    void SetSampleInterval(unsigned int nEvery);
+    /** publish MSG_TRACE on receipt of any traced message */
+    void SetReporting(bool bReport);
+    void SetName(const std::string & sCommunity, const std::string & sApp);
+
+    bool Tagging() const { return tagging_.load(std::memory_order_relaxed); }
+    bool Reporting() const { return reporting_.load(std::memory_order_relaxed); }
+
+    /** if this post of sVar is sampled, sTracedAux is set to sSrcAux plus
+     *  a new trace and true is returned */
+    bool Tag(const std::string & sVar, const std::string & sSrcAux,
+             std::string & sTracedAux, double dfTime);
+
+    /** MSG_TRACE value describing the receipt of a traced message, e.g.
+     *  id=abe/uSimMarineV23/17,var=NAV_X,app=pHelmIvP,rx=1234.56,
+     *  hops=pub:NAV_X@1234.50;dbrx:abe@1234.51;dbtx:abe@1234.53 */
+    std::string ReceiptReport(const std::string & sVar,
+                              const std::string & sSrcAux,
+                              double dfNow) const;
+
+    /** take the trace off every traced message in Mail and hold it
+     *  until the next call. Returns true if any were traced */
+    bool HoldTraces(MOOSMSG_LIST & Mail);
+    /** the trace HoldTraces() took off Msg (or a copy of it), "" if none */
+    std::string HeldTrace(const CMOOSMsg & Msg) const;
+
+    // Helpers for anything on the path of a traced message
+    static bool IsTraced(const std::string & sSrcAux);
+    static void AddHop(std::string & sSrcAux, const std::string & sHop,
+                       double dfTime);
+    static std::string GetTrace(const std::string & sSrcAux);
+    static std::string StripTrace(const std::string & sSrcAux);
+
+private:
+    MsgTrace();
+    MsgTrace(const MsgTrace &);
+    MsgTrace & operator=(const MsgTrace &);
+
+    std::atomic<bool> tagging_;
+    std::atomic<bool> reporting_;
+    std::atomic<unsigned int> next_id_;
+
+    unsigned int sample_interval_;
+    std::string community_;
+    std::string app_;
+    std::set<std::string> traced_vars_;
+
+    std::mutex sample_lock_;
+    std::map<std::string, unsigned int> post_counts_;
+
+    // traces taken off the last mail, by variable, time and source
+    typedef std::tuple<std::string, double, std::string> MsgId;
+    mutable std::mutex held_lock_;
+    std::map<MsgId, std::string> held_;
+};
+
+}
+
+#endif /* MSGTRACE_H_ */
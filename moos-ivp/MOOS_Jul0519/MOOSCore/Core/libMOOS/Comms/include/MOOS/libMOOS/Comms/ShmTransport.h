@@ -0,0 +1,153 @@
+/**
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//
+//   This file was written by agent, October 19th, 2026
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+**/
+
+/*
+ * ShmTransport.h
+ *
+ *  Shared memory transport between a client and a MOOSDB on the same
+ *  host. The two still connect and handshake over TCP. If both have
+ *  the transport enabled (UseSharedMemory = true) and the socket's two
+ *  ends have the same address, the DB makes a ShmChannel, a pair of
+ *  byte rings in a POSIX shared memory segment, and names it in its
+ *  welcome. Once the client has mapped it and said so, both attach the
+ *  channel to their socket and CMOOSCommObject::SendPkt()/ReadPkt()
+ *  move packets through it instead. The socket stays open, so either
+ *  side still sees the other go away. Anything else, old peers
+ *  included, carries on over TCP.
+ *
+ *  Only built for Linux, elsewhere Supported() is false.
+ */
+
+#ifndef SHMTRANSPORT_H_
+#define SHMTRANSPORT_H_
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace MOOS {
+
+struct ShmSegment;
+
+class ShmChannel
+{
+public:
+    ShmChannel();
+    ~ShmChannel();
+
+    /** can this platform make channels at all */
+    static bool Supported();
+
+    /** make and map a new segment (the DB end) */
+    bool Create(const std::string & sName, unsigned int nRingBytes);
+
+    /** map an existing segment (the client end) */
+    bool Open(const std::string & sName);
+
+    /** remove the name, the mapping lives on until both ends let go */
+    void Unlink();
+
+    /** write all nBytes, waiting for space. Returns nBytes, or -1 if
+     *  the channel closed or no space came for dfTimeout seconds */
+    int Write(const unsigned char * pData, int nBytes, double dfTimeout);
+
+    /** read up to nMax bytes. Returns the number read, 0 if nothing
+     *  came within dfTimeout seconds, or -1 if the channel closed */
+    int Read(unsigned char * pData, int nMax, double dfTimeout);
+
+    /** wait for something to read. True if there is, or if closed */
+    bool WaitForData(double dfTimeout);
+
+    /** mark closed, waking both ends */
+    void Close();
+    bool IsClosed() const;
+
+    std::string GetName() const { return name_; }
+    unsigned int GetRingBytes() const;
+
+private:
+    ShmChannel(const ShmChannel &);
+    ShmChannel & operator=(const ShmChannel &);
+
+    bool Map(int nFD, size_t nBytes);
+
+    std::string name_;
+    bool creator_;
+    bool linked_;
+    ShmSegment * seg_;
+    size_t mapped_bytes_;
+
+    //one thread at a time writes to a ring
+    std::mutex write_lock_;
+};
+
+class ShmTransport
+{
+public:
+    static ShmTransport & Instance();
+
+    /** field carrying the request and offer in the handshake */
+    static const char * Field() { return "shm"; }
+
+    void Enable(bool bEnable);
+    bool IsEnabled() const;
+
+    /** bytes in each direction of channels this process makes */
+    void SetRingSizeKB(unsigned int nKB);
+    unsigned int GetRingBytes() const;
+
+    /** a new name for a segment, unique to this process */
+    std::string NewName();
+
+    /** send packets for this socket through pChannel from now on */
+    void Attach(int nSocketFD, std::shared_ptr<ShmChannel> pChannel);
+
+    /** back to the socket, closing any channel (before the socket) */
+    void Detach(int nSocketFD);
+
+    /** the channel attached to this socket, if any */
+    std::shared_ptr<ShmChannel> Find(int nSocketFD);
+
+    unsigned int GetNumAttached() const { return count_; }
+
+    /** are both ends of this connected socket on the same address */
+    static bool IsLocalPeer(int nSocketFD);
+
+    /** has the other end of this socket gone away (no waiting) */
+    static bool PeerHasClosed(int nSocketFD);
+
+private:
+    ShmTransport();
+    ShmTransport(const ShmTransport &);
+    ShmTransport & operator=(const ShmTransport &);
+
+    mutable std::mutex lock_;
+    std::map<int, std::shared_ptr<ShmChannel> > channels_;
+    std::atomic<unsigned int> count_;
+    bool enabled_;
+    unsigned int ring_bytes_;
+    unsigned int names_made_;
+};
+
+}
+
+#endif /* SHMTRANSPORT_H_ */
@@ -0,0 +1,118 @@
+/**
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//
+//   This file was written by agent, October 19th, 2026
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+**/
+
+/*
+ * DBConcurrency.cpp
+ */
+
+#include "MOOS/libMOOS/DB/DBConcurrency.h"
+
+namespace MOOS {
+
+static unsigned int HashOf(const std::string & s)
+{
+    unsigned int h = 2166136261u;
+    for(std::string::size_type i = 0; i < s.size(); i++)
+    {
+        h ^= (unsigned char)s[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/**************************************************************************/
+DBConcurrency::DBConcurrency()
+{
+    parallel_ = false;
+    last_summary_ = 0.0;
+}
+
+/**************************************************************************/
+void DBConcurrency::SetWorkers(unsigned int nWorkers)
+{
+    parallel_ = nWorkers > 0;
+    catalogue_.SetSlots(nWorkers);
+}
+
+/**************************************************************************/
+std::mutex & DBConcurrency::VarLock(const std::string & sVar)
+{
+    return var_locks_[HashOf(sVar) % kStripes];
+}
+
+/**************************************************************************/
+std::unique_lock<std::mutex> DBConcurrency::LockBox(const std::string & sClient)
+{
+    if(!parallel_)
+        return std::unique_lock<std::mutex>();
+    return std::unique_lock<std::mutex>(box_locks_[HashOf(sClient) % kStripes]);
+}
+
+/**************************************************************************/
+bool DBConcurrency::TakeSummaryTurn(double dfNow, double dfPeriod)
+{
+    double dfLast = last_summary_.load();
+    if(dfNow - dfLast <= dfPeriod)
+        return false;
+    return last_summary_.compare_exchange_strong(dfLast, dfNow);
+}
+
+/**************************************************************************/
+DBConcurrency::Access::Access(DBConcurrency & C, bool bExclusive) : con_(C)
+{
+    held_ = kNone;
+    if(!con_.parallel_)
+        return;
+
+    if(bExclusive)
+    {
+        con_.catalogue_.LockExclusive();
+        held_ = kExclusive;
+    }
+    else
+    {
+        con_.catalogue_.LockShared();
+        held_ = kShared;
+    }
+}
+
+/**************************************************************************/
+DBConcurrency::Access::~Access()
+{
+    if(held_ == kShared)
+        con_.catalogue_.UnLockShared();
+    else if(held_ == kExclusive)
+        con_.catalogue_.UnLockExclusive();
+}
+
+/**************************************************************************/
+void DBConcurrency::Access::Exclusive()
+{
+    if(held_ != kShared)
+        return;
+
+    //anything looked up under the shared hold must be looked up again
+    con_.catalogue_.UnLockShared();
+    held_ = kNone;
+    con_.catalogue_.LockExclusive();
+    held_ = kExclusive;
+}
+
+}
@@ -0,0 +1,147 @@
+/**
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//
+//   This file was written by agent, October 19th, 2026
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+**/
+
+/*
+ * HeldMailPolicy.cpp
+ */
+
+#include "MOOS/libMOOS/DB/HeldMailPolicy.h"
+
+namespace MOOS {
+
+/**************************************************************************/
+HeldMailPolicy::HeldMailPolicy()
+{
+}
+
+/**************************************************************************/
+void HeldMailPolicy::SetLatestOnly(const std::string & sClient,
+                                   const std::string & sVar,
+                                   bool bLatestOnly)
+{
+    if(bLatestOnly)
+    {
+        clients_[sClient].latest_only.insert(sVar);
+        return;
+    }
+
+    std::map<std::string, ClientPolicy>::iterator q = clients_.find(sClient);
+    if(q == clients_.end())
+        return;
+    q->second.latest_only.erase(sVar);
+    q->second.waiting.erase(sVar);
+}
+
+/**************************************************************************/
+bool HeldMailPolicy::IsLatestOnly(const std::string & sClient,
+                                  const std::string & sVar) const
+{
+    std::map<std::string, ClientPolicy>::const_iterator q = clients_.find(sClient);
+    if(q == clients_.end())
+        return false;
+    return q->second.latest_only.count(sVar) != 0;
+}
+
+/**************************************************************************/
+void HeldMailPolicy::SetLatestOnlyFilter(const std::string & sClient,
+                                         const std::string & sFilter,
+                                         bool bLatestOnly)
+{
+    if(bLatestOnly)
+        clients_[sClient].latest_only_filters.insert(sFilter);
+    else if(clients_.find(sClient) != clients_.end())
+        clients_[sClient].latest_only_filters.erase(sFilter);
+}
+
+/**************************************************************************/
+bool HeldMailPolicy::IsLatestOnlyFilter(const std::string & sClient,
+                                        const std::string & sFilter) const
+{
+    std::map<std::string, ClientPolicy>::const_iterator q = clients_.find(sClient);
+    if(q == clients_.end())
+        return false;
+    return q->second.latest_only_filters.count(sFilter) != 0;
+}
+
+/**************************************************************************/
+bool HeldMailPolicy::Add(const std::string & sClient, MOOSMSG_LIST & Box,
+                         const CMOOSMsg & Msg)
+{
+    //the common case, nobody asked for anything special
+    std::map<std::string, ClientPolicy>::iterator q = clients_.find(sClient);
+    if(q == clients_.end() || q->second.latest_only.empty())
+    {
+        Box.push_back(Msg);
+        return false;
+    }
+
+    ClientPolicy & rPolicy = q->second;
+    if(rPolicy.latest_only.count(Msg.m_sKey) == 0)
+    {
+        Box.push_back(Msg);
+        return false;
+    }
+
+    //drop the superseded message and append the new one at the back so
+    //the box stays in the order things were written
+    bool bCoalesced = false;
+    std::map<std::string, MOOSMSG_LIST::iterator>::iterator w =
+        rPolicy.waiting.find(Msg.m_sKey);
+    if(w != rPolicy.waiting.end())
+    {
+        Box.erase(w->second);
+        rPolicy.coalesced++;
+        bCoalesced = true;
+    }
+
+    rPolicy.waiting[Msg.m_sKey] = Box.insert(Box.end(), Msg);
+    return bCoalesced;
+}
+
+/**************************************************************************/
+void HeldMailPolicy::OnDelivered(const std::string & sClient)
+{
+    std::map<std::string, ClientPolicy>::iterator q = clients_.find(sClient);
+    if(q != clients_.end())
+        q->second.waiting.clear();
+}
+
+/**************************************************************************/
+void HeldMailPolicy::RemoveClient(const std::string & sClient)
+{
+    clients_.erase(sClient);
+}
+
+/**************************************************************************/
+void HeldMailPolicy::Clear()
+{
+    clients_.clear();
+}
+
+/**************************************************************************/
+uint64_t HeldMailPolicy::GetCoalesced(const std::string & sClient) const
+{
+    std::map<std::string, ClientPolicy>::const_iterator q = clients_.find(sClient);
+    if(q == clients_.end())
+        return 0;
+    return q->second.coalesced;
+}
+
+}
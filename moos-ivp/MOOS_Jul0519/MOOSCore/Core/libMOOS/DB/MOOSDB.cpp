@@ -41,6 +41,12 @@
 #include "MOOS/libMOOS/GitVersion.h"
 #include "MOOS/libMOOS/DB/MOOSDBLogger.h"
 #include "MOOS/libMOOS/Utils/MOOSScopedPtr.h"
+#include "MOOS/libMOOS/Comms/MsgTrace.h"
+#include "MOOS/libMOOS/Comms/LatestOnlySubscriptions.h"
+#include "MOOS/libMOOS/Comms/ShmTransport.h"
+#include "MOOS/libMOOS/DB/HeldMailPolicy.h"
+#include "MOOS/libMOOS/DB/DBConcurrency.h"
+#include "MOOS/libMOOS/Comms/DispatchPool.h"
 
 
 
@@ -51,8 +57,84 @@
 #include <sstream>
 #include <vector>
 #include <iterator>
+#include <memory>
+#include <mutex>
 using namespace std;
 
+//what each DB keeps beside its members (MOOSDB.h is not ours to extend).
+//An entry is made when a DB is constructed and removed when it is
+//destroyed, so it lives exactly as long as its DB
+struct DBExtras
+{
+    MOOS::HeldMailPolicy HeldMail;
+    MOOS::DBConcurrency Concurrency;
+};
+
+typedef std::map<const CMOOSDB *, std::unique_ptr<DBExtras> > DBEXTRAS_MAP;
+
+static DBEXTRAS_MAP & AllExtras()
+{
+    static DBEXTRAS_MAP Extras;
+    return Extras;
+}
+
+static std::mutex & AllExtrasLock()
+{
+    static std::mutex Lock;
+    return Lock;
+}
+
+static DBExtras & Extras(const CMOOSDB * pDB)
+{
+    //other DBs may come and go while this one is running
+    std::lock_guard<std::mutex> L(AllExtrasLock());
+    DBEXTRAS_MAP::iterator q = AllExtras().find(pDB);
+    assert(q!=AllExtras().end());
+    return *q->second;
+}
+
+//the held mail policy of each DB
+static MOOS::HeldMailPolicy & HeldMail(const CMOOSDB * pDB)
+{
+    return Extras(pDB).HeldMail;
+}
+
+//the locks of each DB when its server has workers (set up in Run())
+static MOOS::DBConcurrency & Concurrency(const CMOOSDB * pDB)
+{
+    return Extras(pDB).Concurrency;
+}
+
+//true if everyone subscribed to rVar already has a mail box, so it can
+//be notified without changing the catalogue
+static bool SubscribersHaveBoxes(const CMOOSDBVar & rVar,
+                                 const MOOSMSG_LIST_STRING_MAP & HeldMailMap)
+{
+    REGISTER_INFO_MAP::const_iterator p;
+    for(p = rVar.m_Subscribers.begin();p!=rVar.m_Subscribers.end();++p)
+    {
+        if(HeldMailMap.find(p->second.m_sClientName)==HeldMailMap.end())
+            return false;
+    }
+    return true;
+}
+
+//stamp any traced messages as they leave the DB for a client
+static void StampTracedMail(MOOSMSG_LIST & Mail, const std::string & sHop)
+{
+    double dfTimeNow = -1;
+    MOOSMSG_LIST::iterator p;
+    for(p = Mail.begin();p!=Mail.end();++p)
+    {
+        if(MOOS::MsgTrace::IsTraced(p->m_sSrcAux))
+        {
+            if(dfTimeNow<0)
+                dfTimeNow = HPMOOSTime();
+            MOOS::MsgTrace::AddHop(p->m_sSrcAux,sHop,dfTimeNow);
+        }
+    }
+}
+
 //////////////////////////////////////////////////////////////////////
 // Construction/Destruction
 //////////////////////////////////////////////////////////////////////
@@ -183,6 +265,11 @@ CMOOSDB::CMOOSDB()
 
 
 
+    {
+        std::lock_guard<std::mutex> L(AllExtrasLock());
+        AllExtras()[this].reset(new DBExtras);
+    }
+
     //ignore broken pipes as is standard for network apps
 #ifndef _WIN32
     signal(SIGPIPE,SIG_IGN);
@@ -196,6 +283,9 @@ CMOOSDB::~CMOOSDB()
 {
     if(m_pCommServer.get()!=NULL)
         m_pCommServer->Stop();
+
+    std::lock_guard<std::mutex> L(AllExtrasLock());
+    AllExtras().erase(this);
 }
 
 
@@ -232,6 +322,9 @@ void PrintHelpAndExit()
 	std::cout<<"--response=<string-list>           specify tolerable client latencies in ms\n";
 	std::cout<<"--warning_latency=<positive_float>    specify latency above which warning is issued in ms\n";
 	std::cout<<"--tcpnodelay                       disable nagle algorithm \n";
+	std::cout<<"--workers=<unsigned int>           process clients on this many threads at once\n";
+	std::cout<<"--shm                              offer shared memory to clients on this machine\n";
+	std::cout<<"--shm_ring_kb=<unsigned int>       size of each shared memory ring in KB\n";
 	std::cout<<"--audit_port=<unsigned int>        specify port on which to transmit statistics\n";
     std::cout<<"--event_log=<file name>            specify file in which to record events\n";
     std::cout<<"--print_heart_beat                 indicate DB heartbeat every second\n";
@@ -359,6 +452,19 @@ bool CMOOSDB::Run(int argc,  char * argv[] )
     if(P.GetFlag("--tcpnodelay"))
     	bTCPNoDelay = true;
 
+    //offer shared memory to asynchronous clients on this machine
+    //that ask for it (the rest stay on tcp)
+    bool bSharedMemory = false;
+    m_MissionReader.GetValue("UseSharedMemory",bSharedMemory);
+    if(P.GetFlag("--shm"))
+        bSharedMemory = true;
+    MOOS::ShmTransport::Instance().Enable(bSharedMemory);
+
+    unsigned int nShmRingKB = 1024;
+    m_MissionReader.GetValue("SharedMemoryRingKB",nShmRingKB);
+    P.GetVariable("--shm_ring_kb",nShmRingKB);
+    MOOS::ShmTransport::Instance().SetRingSizeKB(nShmRingKB);
+
 
 
     ///////////////////////////////////////////////////////////
@@ -374,6 +480,14 @@ bool CMOOSDB::Run(int argc,  char * argv[] )
     //are we being asked to be old skool and use a single thread?
     bool bSingleThreaded = P.GetFlag("-s","--single_threaded");
 
+    ///////////////////////////////////////////////////////////
+    //how many workers process client packets (0 is one central thread)
+    unsigned int nWorkers = 0;
+    m_MissionReader.GetValue("DBWorkers",nWorkers);
+    P.GetVariable("--workers",nWorkers);
+    if(bSingleThreaded)
+        nWorkers = 0;
+
 
     //is the community name being specified on the cli?
 	unsigned int nAuditPort=9020;
@@ -432,7 +546,12 @@ bool CMOOSDB::Run(int argc,  char * argv[] )
     {
         //std::cerr<<MOOS::ConsoleColours::green()<<"running in multi-threaded mode\n"<<MOOS::ConsoleColours::reset();
         m_pCommServer.reset(new MOOS::ThreadedCommServer);
+        MOOS::DispatchPool::For(m_pCommServer.get()).SetWorkers(nWorkers);
     }
+    Concurrency(this).SetWorkers(nWorkers);
+
+    if(nWorkers>0)
+        std::cout<<"  processing clients on "<<nWorkers<<" workers\n";
 
     m_pCommServer->SetQuiet(m_bQuiet);
 
@@ -499,9 +618,30 @@ void CMOOSDB::UpdateQoSVar()
 {
     CMOOSMsg DBQOS(MOOS_NOTIFY,"DB_QOS","");
 
-    if(!m_pCommServer->GetTimingStatisticSummary(DBQOS.m_sVal))
+    std::string sTiming;
+    if(!m_pCommServer->GetTimingStatisticSummary(sTiming))
         return;
 
+    //each client=recent:max:min:avg entry is extended with the number of
+    //messages waiting in its box and how many have been coalesced
+    while(!sTiming.empty())
+    {
+        std::string sEntry = MOOSChomp(sTiming,",");
+        if(sEntry.empty())
+            continue;
+
+        std::string sClient = sEntry.substr(0,sEntry.find('='));
+        size_t nDepth = 0;
+        MOOSMSG_LIST_STRING_MAP::iterator q = m_HeldMailMap.find(sClient);
+        if(q!=m_HeldMailMap.end())
+            nDepth = q->second.size();
+
+        DBQOS.m_sVal += MOOSFormat("%s:%u:%llu,",
+                                   sEntry.c_str(),
+                                   (unsigned int)nDepth,
+                                   (unsigned long long)HeldMail(this).GetCoalesced(sClient));
+    }
+
     DBQOS.m_sSrc = m_sDBName;
     DBQOS.m_sOriginatingCommunity = m_sCommunityName;
     OnNotify(DBQOS);
@@ -584,18 +724,56 @@ void CMOOSDB::UpdateDBTimeVars()
 /**this will be called each time a new packet is recieved*/
 bool CMOOSDB::OnRxPkt(const std::string & sClient,MOOSMSG_LIST & MsgListRx,MOOSMSG_LIST & MsgListTx)
 {
+    //when the server has workers other clients are being processed at
+    //the same time. Notifying variables that already have a value only
+    //needs the catalogue shared, anything else and the rest of the packet
+    //is processed exclusively
+    MOOS::DBConcurrency & Con = Concurrency(this);
+    MOOS::DBConcurrency::Access Catalogue(Con);
 
     MOOSMSG_LIST::iterator p;
     
     for(p = MsgListRx.begin();p!=MsgListRx.end();++p)
     {
+        if(Catalogue.IsShared() && p->m_cMsgType==MOOS_NOTIFY)
+        {
+            DBVAR_MAP::iterator v = m_VarMap.find(p->m_sKey);
+            if(v!=m_VarMap.end())
+            {
+                std::lock_guard<std::mutex> L(Con.VarLock(p->m_sKey));
+                if(v->second.m_nWrittenTo!=0 &&
+                   SubscribersHaveBoxes(v->second,m_HeldMailMap))
+                {
+                    OnNotify(*p);
+                    continue;
+                }
+            }
+            Catalogue.Exclusive();
+        }
+        else if(Catalogue.IsShared())
+        {
+            //null, command and timing messages change nothing here
+            switch(p->m_cMsgType)
+            {
+            case MOOS_NULL_MSG:
+            case MOOS_COMMAND:
+            case MOOS_TIMING:
+                continue;
+            default:
+                Catalogue.Exclusive();
+            }
+        }
+
         ProcessMsg(*p,MsgListTx);
     }
     
 
     double dfNow = MOOS::Time();
-    if(dfNow-m_dfSummaryTime>2.0)
+    bool bSummaryDue = Con.IsParallel() ? Con.TakeSummaryTurn(dfNow,2.0) : dfNow-m_dfSummaryTime>2.0;
+    if(bSummaryDue)
     {
+        Catalogue.Exclusive();
+
         m_dfSummaryTime = dfNow;
 
         //good spot to update our internal time
@@ -628,26 +806,30 @@ bool CMOOSDB::OnRxPkt(const std::string & sClient,MOOSMSG_LIST & MsgListRx,MOOSM
             //should only happen at start up...
             //string sClient = MsgListRx.front().m_sSrc;
             
-            MOOSMSG_LIST NewList;
-            
-            m_HeldMailMap[sClient] = NewList;
-            
+            //boxes are only ever made with the catalogue held exclusively
+            //and another worker may have made this one while we waited
+            Catalogue.Exclusive();
+
             q = m_HeldMailMap.find(sClient);
-            
-            assert(q!=m_HeldMailMap.end());
+            if(q==m_HeldMailMap.end())
+                q = m_HeldMailMap.insert(make_pair(sClient,MOOSMSG_LIST())).first;
         }
                 
         if(q!=m_HeldMailMap.end())
         {
             //MOOSTrace("%f OnRxPkt %d messages held for client %s\n",MOOSTime(),q->second.size(),sClient.c_str());
 
+            std::unique_lock<std::mutex> Box = Con.LockBox(sClient);
             if(!q->second.empty())
             {
+                StampTracedMail(q->second,"dbtx:"+m_sCommunityName);
+
                 //copy all the held mail to MsgListTx
                 MsgListTx.splice(MsgListTx.begin(),
                 		q->second,
                 		q->second.begin(),
                 		q->second.end());
+                HeldMail(this).OnDelivered(sClient);
             }
         }
     }
@@ -657,15 +839,21 @@ bool CMOOSDB::OnRxPkt(const std::string & sClient,MOOSMSG_LIST & MsgListRx,MOOSM
 
 bool CMOOSDB::OnFetchAllMail(const std::string & sWho,MOOSMSG_LIST & MsgListTx)
 {
+    MOOS::DBConcurrency & Con = Concurrency(this);
+    MOOS::DBConcurrency::Access Catalogue(Con);
+
 	MOOSMSG_LIST_STRING_MAP::iterator q = m_HeldMailMap.find(sWho);
 	if(q!=m_HeldMailMap.end())
 	{
+        std::unique_lock<std::mutex> Box = Con.LockBox(sWho);
 		if(!q->second.empty())
 		{
+            StampTracedMail(q->second,"dbtx:"+m_sCommunityName);
             MsgListTx.splice(MsgListTx.begin(),
             		q->second,
             		q->second.begin(),
             		q->second.end());
+            HeldMail(this).OnDelivered(sWho);
 		}
 	}
 	return true;
@@ -708,6 +896,11 @@ bool CMOOSDB::OnNotify(CMOOSMsg &Msg)
 {
     double dfTimeNow = HPMOOSTime();
     
+    //note the arrival of a traced message
+    bool bTraced = MOOS::MsgTrace::IsTraced(Msg.m_sSrcAux);
+    if(bTraced)
+        MOOS::MsgTrace::AddHop(Msg.m_sSrcAux,"dbrx:"+m_sCommunityName,dfTimeNow);
+
     CMOOSDBVar & rVar  = GetOrMakeVar(Msg);
     
     if(rVar.m_nWrittenTo==0)
@@ -729,6 +922,8 @@ bool CMOOSDB::OnNotify(CMOOSMsg &Msg)
 				{
 					//add the filter owner (client *g) as a subscriber
 					rVar.AddSubscriber(g->first, h->period());
+					if(HeldMail(this).IsLatestOnlyFilter(g->first,h->as_string()))
+						HeldMail(this).SetLatestOnly(g->first,rVar.m_sName,true);
 					if(!m_bQuiet)
 					{
                         std::cout<<"+ subs of \""<<g->first<<"\" to \""
@@ -751,6 +946,10 @@ bool CMOOSDB::OnNotify(CMOOSMsg &Msg)
         rVar.m_sWhoChangedMe = Msg.m_sSrc;
         
         rVar.m_sSrcAux       = Msg.m_sSrcAux; // Added by mikerb 5-29-12
+
+        //a trace describes one delivery, don't replay it to late subscribers
+        if(bTraced)
+            rVar.m_sSrcAux = MOOS::MsgTrace::StripTrace(Msg.m_sSrcAux);
         
         if(Msg.m_sOriginatingCommunity.empty())
         {
@@ -855,23 +1054,25 @@ bool CMOOSDB::OnNotify(CMOOSMsg &Msg)
 in they shall be informed of the change by stuffing this msg into a return packet */
 bool    CMOOSDB::AddMessageToClientBox(const string &sClient,CMOOSMsg & Msg)
 {
+    MOOS::DBConcurrency & Con = Concurrency(this);
     MOOSMSG_LIST_STRING_MAP::iterator q = m_HeldMailMap.find(sClient);
     
     if(q==m_HeldMailMap.end())
     {
         //there is no mail waiting to be sent to this client
-        //should only happen at start up...
-        MOOSMSG_LIST NewList;
-        m_HeldMailMap[sClient] = NewList;
-        
-        q = m_HeldMailMap.find(sClient);
-        
-        assert(q!=m_HeldMailMap.end());
+        //should only happen at start up... Boxes are only made with the
+        //catalogue held exclusively, OnRxPkt never notifies shared when a
+        //subscriber has no box
+        assert(!Con.IsParallel() || Con.Catalogue().IsExclusiveHere());
+
+        q = m_HeldMailMap.insert(make_pair(sClient,MOOSMSG_LIST())).first;
     }
     
     //q->second is now a reference to a list of messages that will be
-    //sent to sClient the next time it calls into the database...   
-    q->second.push_back(Msg);
+    //sent to sClient the next time it calls into the database...
+    //(unless it asked for latest values only, then stale ones are replaced)
+    std::unique_lock<std::mutex> Box = Con.LockBox(sClient);
+    HeldMail(this).Add(sClient,q->second,Msg);
     
     return true;
 }
@@ -946,6 +1147,16 @@ bool CMOOSDB::OnRegister(CMOOSMsg &Msg)
 		if(!rVar.AddSubscriber(Msg.m_sSrc,Msg.m_dfVal))
 			return false;
 
+		//make sure the subscriber has a box before anything is notified
+		if(m_HeldMailMap.find(Msg.m_sSrc)==m_HeldMailMap.end())
+			m_HeldMailMap[Msg.m_sSrc] = MOOSMSG_LIST();
+
+		//a client may ask for the latest value only (and may change its
+		//mind by registering again without asking)
+		bool bLatestOnly = false;
+		MOOSValFromString(bLatestOnly,Msg.m_sVal,MOOS::LatestOnlySubscriptions::Field());
+		HeldMail(this).SetLatestOnly(Msg.m_sSrc,rVar.m_sName,bLatestOnly);
+
         double dfActualPeriod;
         if(!rVar.GetUpdatePeriod(Msg.m_sSrc,dfActualPeriod)){
             return false;
@@ -983,6 +1194,10 @@ bool CMOOSDB::OnRegister(CMOOSMsg &Msg)
 		MOOSValFromString(period,Msg.GetString(),"Interval");
 		MOOS::MsgFilter F(app_pattern,var_pattern,period);
 
+		bool bLatestOnly = false;
+		MOOSValFromString(bLatestOnly,Msg.GetString(),MOOS::LatestOnlySubscriptions::Field());
+		HeldMail(this).SetLatestOnlyFilter(Msg.GetSource(),F.as_string(),bLatestOnly);
+
 		//store this filter we will need it later when new
 		//as yet undiscovered variables are written
 		m_ClientFilters[Msg.GetSource()].insert(F);
@@ -1004,6 +1219,7 @@ bool CMOOSDB::OnRegister(CMOOSMsg &Msg)
 				M.m_cDataType = MOOS_DOUBLE;
 				M.m_dfVal = period;
 				M.m_sSrc = Msg.GetSource();
+				M.m_sVal = bLatestOnly ? MOOSFormat("%s=true",MOOS::LatestOnlySubscriptions::Field()) : "";
 
 				if(!m_bQuiet)
 				{
@@ -1095,8 +1311,13 @@ CMOOSDBVar & CMOOSDB::GetOrMakeVar(CMOOSMsg &Msg)
 
 bool CMOOSDB::OnConnect(string &sClient)
 {
+    MOOS::DBConcurrency::Access Catalogue(Concurrency(this),true);
+
     m_EventLogger.AddEvent("connect",sClient,"client connects");
 
+    if(m_HeldMailMap.find(sClient)==m_HeldMailMap.end())
+        m_HeldMailMap[sClient] = MOOSMSG_LIST();
+
     //notify ourselves....
     CMOOSMsg DBC(MOOS_NOTIFY,"DB_EVENT",MOOSFormat("connected=%s",sClient.c_str()));
     DBC.m_sOriginatingCommunity = m_sCommunityName;
@@ -1109,6 +1330,8 @@ bool CMOOSDB::OnConnect(string &sClient)
 
 bool CMOOSDB::OnDisconnect(string &sClient)
 {
+    MOOS::DBConcurrency::Access Catalogue(Concurrency(this),true);
+
     //for all variables remove subscriptions to sClient
     if(!m_bQuiet)
     {
@@ -1129,6 +1352,7 @@ bool CMOOSDB::OnDisconnect(string &sClient)
     }
     
     m_HeldMailMap.erase(sClient);
+    HeldMail(this).RemoveClient(sClient);
     
     if(!m_bQuiet)
         std::cout<<MOOS::ConsoleColours::Green()<<"[OK]\n"<<MOOS::ConsoleColours::reset();
@@ -1403,6 +1627,7 @@ bool CMOOSDB::OnClearRequested(CMOOSMsg &Msg, MOOSMSG_LIST &MsgTxList)
     {
         MOOSMSG_LIST & rList = q->second;
         rList.clear();
+        HeldMail(this).OnDelivered(q->first);
     }
     MOOSTrace("done\n");
     
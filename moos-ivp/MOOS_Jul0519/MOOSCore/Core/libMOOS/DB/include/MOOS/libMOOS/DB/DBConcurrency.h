@@ -0,0 +1,108 @@
+/**
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//
+//   This file was written by agent, October 19th, 2026
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+**/
+
+/*
+ * DBConcurrency.h
+ *
+ *  The locking that lets the MOOSDB process packets from several clients
+ *  at once (when its server has workers, see DispatchPool.h).
+ *
+ *  - the catalogue lock guards what the DB holds: the set of variables,
+ *    their subscribers, wildcard filters and the set of mail boxes.
+ *    Notifying a variable that has been written before changes none of
+ *    that, so it only needs the lock shared. Everything else (new
+ *    variables, registration, server requests, connects, disconnects,
+ *    the periodic DB_ summaries) takes it exclusively.
+ *  - a striped lock per variable guards its value and statistics while
+ *    it is notified shared.
+ *  - a striped lock per client guards the mail held for it.
+ *
+ *  The order is always catalogue, variable, mail box. With no workers
+ *  (the default) none of this is taken at all.
+ */
+
+#ifndef DBCONCURRENCY_H_
+#define DBCONCURRENCY_H_
+
+#include <atomic>
+#include <mutex>
+#include <string>
+
+#include "MOOS/libMOOS/Comms/DispatchPool.h"
+
+namespace MOOS {
+
+class DBConcurrency
+{
+public:
+    DBConcurrency();
+
+    /** as many as the server has workers, 0 is serial */
+    void SetWorkers(unsigned int nWorkers);
+    bool IsParallel() const { return parallel_; }
+
+    SlotLock & Catalogue() { return catalogue_; }
+    std::mutex & VarLock(const std::string & sVar);
+
+    /** the mail box lock of sClient, not taken when serial */
+    std::unique_lock<std::mutex> LockBox(const std::string & sClient);
+
+    /** true for the one caller that should refresh the DB_ summaries,
+     *  at most every dfPeriod seconds */
+    bool TakeSummaryTurn(double dfNow, double dfPeriod);
+
+    /** holds the catalogue for the length of a call in, shared unless
+     *  asked otherwise, and nothing at all when serial */
+    class Access
+    {
+    public:
+        Access(DBConcurrency & C, bool bExclusive = false);
+        ~Access();
+
+        bool IsShared() const { return held_ == kShared; }
+
+        /** trade a shared hold for an exclusive one */
+        void Exclusive();
+
+    private:
+        Access(const Access &);
+        Access & operator=(const Access &);
+
+        enum Held { kNone, kShared, kExclusive };
+        DBConcurrency & con_;
+        Held held_;
+    };
+
+private:
+    DBConcurrency(const DBConcurrency &);
+    DBConcurrency & operator=(const DBConcurrency &);
+
+    bool parallel_;
+    SlotLock catalogue_;
+    std::atomic<double> last_summary_;
+
+    static const unsigned int kStripes = 256;
+    std::mutex var_locks_[kStripes];
+    std::mutex box_locks_[kStripes];
+};
+
+}
+
+#endif /* DBCONCURRENCY_H_ */
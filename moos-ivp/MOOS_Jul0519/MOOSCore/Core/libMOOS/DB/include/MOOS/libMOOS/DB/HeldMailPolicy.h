@@ -0,0 +1,89 @@
+/**
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//
+//   This file was written by agent, October 19th, 2026
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+**/
+
+/*
+ * HeldMailPolicy.h
+ *
+ *  How the MOOSDB fills the box of mail it holds for each client between
+ *  the client's calls in. By default every notification is appended.
+ *  A client may register for a variable "latest value only", in which
+ *  case a new notification replaces one for the same variable that is
+ *  still waiting in the box, so a slow client never wades through
+ *  superseded values. Box depth and coalesced counts appear in DB_QOS.
+ */
+
+#ifndef HELDMAILPOLICY_H_
+#define HELDMAILPOLICY_H_
+
+#include <map>
+#include <set>
+#include <string>
+#include <stdint.h>
+
+#include "MOOS/libMOOS/Comms/MOOSMsg.h"
+
+namespace MOOS {
+
+class HeldMailPolicy
+{
+public:
+    HeldMailPolicy();
+
+    void SetLatestOnly(const std::string & sClient, const std::string & sVar,
+                       bool bLatestOnly);
+    bool IsLatestOnly(const std::string & sClient,
+                      const std::string & sVar) const;
+
+    /** wildcard registrations are remembered so variables that appear
+     *  later and match the filter inherit the policy */
+    void SetLatestOnlyFilter(const std::string & sClient,
+                             const std::string & sFilter, bool bLatestOnly);
+    bool IsLatestOnlyFilter(const std::string & sClient,
+                            const std::string & sFilter) const;
+
+    /** put Msg in sClient's Box. Returns true if it replaced (coalesced)
+     *  a message already waiting there */
+    bool Add(const std::string & sClient, MOOSMSG_LIST & Box,
+             const CMOOSMsg & Msg);
+
+    /** the client's box has been emptied (sent) */
+    void OnDelivered(const std::string & sClient);
+    void RemoveClient(const std::string & sClient);
+    void Clear();
+
+    uint64_t GetCoalesced(const std::string & sClient) const;
+
+private:
+    struct ClientPolicy
+    {
+        ClientPolicy() : coalesced(0) {}
+        std::set<std::string> latest_only;
+        std::set<std::string> latest_only_filters;
+        // where in the box the waiting message for each latest only var is
+        std::map<std::string, MOOSMSG_LIST::iterator> waiting;
+        uint64_t coalesced;
+    };
+
+    std::map<std::string, ClientPolicy> clients_;
+};
+
+}
+
+#endif /* HELDMAILPOLICY_H_ */
@@ -23,6 +23,8 @@
 #include <algorithm>
 #include <iostream>
 #include "MOOS/libMOOS/Thirdparty/AppCasting/AppCastingMOOSApp.h"
+#include "MOOS/libMOOS/Utils/AppPerfStats.h"
+#include "MOOS/libMOOS/Comms/MsgTrace.h"
 
 #ifndef _WIN32
 #include "unistd.h"
@@ -139,6 +141,12 @@ void AppCastingMOOSApp::PostReport(const string& directive)
     Notify(var,  (iter_len / app_gap));
   }
 
+  // Periodically publish the latency histogram summary (APP_PERF)
+  MOOS::AppPerfStats& perf = MOOS::AppPerfStats::Instance();
+  double real_now = MOOSLocalTime(false);
+  if(perf.PublishDue(real_now))
+    Notify("APP_PERF", perf.GetReport(GetAppName(), real_now));
+
   if(m_time_warp <= 0)
     return;
 
@@ -226,6 +234,22 @@ void AppCastingMOOSApp::preOnStartUp()
   m_MissionReader.GetConfiguration(config_block, sParams);
 
   m_MissionReader.GetValue("COMMUNITY", m_host_community);
+
+  // APP_PERF_INTERVAL may be set globally for all apps, or per app below
+  double perf_interval = 0;
+  if(m_MissionReader.GetValue("APP_PERF_INTERVAL", perf_interval))
+    MOOS::AppPerfStats::Instance().SetPublishInterval(perf_interval);
+
+  // Message tracing. TRACE_SAMPLE and TRACE_REPORT may be set globally,
+  // TRACE_VARS only makes sense per app (the publisher of the var)
+  MOOS::MsgTrace& trace = MOOS::MsgTrace::Instance();
+  trace.SetName(m_host_community, GetAppName());
+  int trace_sample = 0;
+  if(m_MissionReader.GetValue("TRACE_SAMPLE", trace_sample) && (trace_sample > 0))
+    trace.SetSampleInterval(trace_sample);
+  bool trace_report = false;
+  if(m_MissionReader.GetValue("TRACE_REPORT", trace_report))
+    trace.SetReporting(trace_report);
     
   STRING_LIST::iterator p;
   for(p=sParams.begin(); p!=sParams.end(); ++p) {
@@ -254,6 +278,28 @@ void AppCastingMOOSApp::preOnStartUp()
 	reportConfigWarning("Invalid APP_LOGGING: " + value);
     }
 
+    else if(param == "APP_PERF_INTERVAL") {
+      if(!MOOSIsNumeric(value))
+	reportConfigWarning("Invalid APP_PERF_INTERVAL: " + value);
+      else
+	MOOS::AppPerfStats::Instance().SetPublishInterval(atof(value.c_str()));
+    }
+
+    else if(param == "TRACE_VARS")
+      MOOS::MsgTrace::Instance().SetTracedVars(value);
+    else if(param == "TRACE_SAMPLE") {
+      if(!MOOSIsNumeric(value) || (atoi(value.c_str()) < 1))
+	reportConfigWarning("Invalid TRACE_SAMPLE: " + value);
+      else
+	MOOS::MsgTrace::Instance().SetSampleInterval(atoi(value.c_str()));
+    }
+    else if(param == "TRACE_REPORT") {
+      if((lvalue != "true") && (lvalue != "false"))
+	reportConfigWarning("Invalid TRACE_REPORT: " + value);
+      else
+	MOOS::MsgTrace::Instance().SetReporting(lvalue == "true");
+    }
+
     else if(param == "DEPRECATED_OK") {
       if(lvalue == "true")
 	m_deprecated_ok = true;
@@ -600,7 +646,9 @@ void AppCastingMOOSApp::reportUnhandledConfigWarning(const string& orig)
   if((param == "APPTICK")    || (param == "APP_LOGGING")          ||
      (param == "MAXAPPTICK") || (param == "TERM_REPORT_INTERVAL") ||
      (param == "COMMSTICK")  || (param == "MAX_APPCAST_EVENTS")   ||
-     (param == "DEPRECATED_OK"))
+     (param == "DEPRECATED_OK") || (param == "APP_PERF_INTERVAL")    ||
+     (param == "TRACE_VARS") || (param == "TRACE_SAMPLE")         ||
+     (param == "TRACE_REPORT") || (param == "LATEST_ONLY"))
     return;
 
   reportConfigWarning("Unhandled config line: " + orig);
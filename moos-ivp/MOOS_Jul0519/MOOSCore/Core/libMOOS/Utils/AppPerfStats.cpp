@@ -0,0 +1,268 @@
+/**
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//
+//   This file was written by agent, October 19th, 2026
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+**/
+
+/*
+ * AppPerfStats.cpp
+ */
+
+#include <cmath>
+#include <cstdio>
+
+#include "MOOS/libMOOS/Utils/AppPerfStats.h"
+
+namespace MOOS {
+
+/**************************************************************************/
+PerfHistogram::PerfHistogram()
+{
+    for(unsigned int i = 0; i < NUM_BUCKETS; i++)
+        counts_[i].store(0, std::memory_order_relaxed);
+}
+
+/**************************************************************************/
+unsigned int PerfHistogram::BucketIndex(double dfSeconds)
+{
+    double dfMicros = dfSeconds * 1e6;
+    if(!(dfMicros > 1.0))
+        return 0;
+
+    // four buckets per doubling: bucket i holds (2^((i-1)/4), 2^(i/4)] us
+    unsigned int nBucket = (unsigned int)std::ceil(4.0 * std::log2(dfMicros));
+    if(nBucket >= NUM_BUCKETS)
+        nBucket = NUM_BUCKETS - 1;
+    return nBucket;
+}
+
+/**************************************************************************/
+double PerfHistogram::BucketUpperBound(unsigned int nBucket)
+{
+    return std::pow(2.0, nBucket / 4.0) * 1e-6;
+}
+
+/**************************************************************************/
+void PerfHistogram::Add(double dfSeconds)
+{
+    counts_[BucketIndex(dfSeconds)].fetch_add(1, std::memory_order_relaxed);
+}
+
+/**************************************************************************/
+void PerfHistogram::AccumulateInto(std::vector<uint64_t> & counts) const
+{
+    if(counts.size() != NUM_BUCKETS)
+        counts.resize(NUM_BUCKETS, 0);
+    for(unsigned int i = 0; i < NUM_BUCKETS; i++)
+        counts[i] += counts_[i].load(std::memory_order_relaxed);
+}
+
+/**************************************************************************/
+uint64_t PerfHistogram::Total(const std::vector<uint64_t> & counts)
+{
+    uint64_t nTotal = 0;
+    for(unsigned int i = 0; i < counts.size(); i++)
+        nTotal += counts[i];
+    return nTotal;
+}
+
+/**************************************************************************/
+double PerfHistogram::Percentile(const std::vector<uint64_t> & counts, double pct)
+{
+    uint64_t nTotal = Total(counts);
+    if(nTotal == 0)
+        return 0;
+
+    double dfTarget = (pct / 100.0) * nTotal;
+    uint64_t nCumulative = 0;
+    for(unsigned int i = 0; i < counts.size(); i++)
+    {
+        nCumulative += counts[i];
+        if(nCumulative >= dfTarget && nCumulative > 0)
+            return BucketUpperBound(i);
+    }
+    return BucketUpperBound(counts.size() - 1);
+}
+
+/**************************************************************************/
+double PerfHistogram::Max(const std::vector<uint64_t> & counts)
+{
+    for(unsigned int i = counts.size(); i > 0; i--)
+    {
+        if(counts[i - 1] > 0)
+            return BucketUpperBound(i - 1);
+    }
+    return 0;
+}
+
+
+/**************************************************************************/
+AppPerfStats::Shard::Shard()
+{
+    notifies.store(0, std::memory_order_relaxed);
+    mail.store(0, std::memory_order_relaxed);
+}
+
+/**************************************************************************/
+AppPerfStats::AppPerfStats()
+{
+    next_shard_.store(0);
+    publish_interval_.store(0);
+    last_publish_time_ = 0;
+    prev_notifies_ = 0;
+    prev_mail_ = 0;
+}
+
+/**************************************************************************/
+AppPerfStats & AppPerfStats::Instance()
+{
+    static AppPerfStats instance;
+    return instance;
+}
+
+/**************************************************************************/
+AppPerfStats::Shard & AppPerfStats::LocalShard()
+{
+    // each thread claims a shard the first time it records anything. If
+    // there are more threads than shards they share, which is still
+    // correct because every counter is atomic.
+    static thread_local int nMyShard = -1;
+    if(nMyShard < 0)
+        nMyShard = next_shard_.fetch_add(1) % MAX_SHARDS;
+    return shards_[nMyShard];
+}
+
+/**************************************************************************/
+void AppPerfStats::SetPublishInterval(double dfSeconds)
+{
+    publish_interval_.store(dfSeconds < 0 ? 0 : dfSeconds);
+}
+
+/**************************************************************************/
+double AppPerfStats::GetPublishInterval() const
+{
+    return publish_interval_.load(std::memory_order_relaxed);
+}
+
+/**************************************************************************/
+bool AppPerfStats::Enabled() const
+{
+    return GetPublishInterval() > 0;
+}
+
+/**************************************************************************/
+void AppPerfStats::Record(Metric eMetric, double dfSeconds)
+{
+    if(!Enabled() || eMetric >= NUM_METRICS)
+        return;
+    LocalShard().histograms[eMetric].Add(dfSeconds);
+}
+
+/**************************************************************************/
+void AppPerfStats::CountNotify()
+{
+    if(!Enabled())
+        return;
+    LocalShard().notifies.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**************************************************************************/
+void AppPerfStats::CountMail(unsigned int nMessages)
+{
+    if(!Enabled())
+        return;
+    LocalShard().mail.fetch_add(nMessages, std::memory_order_relaxed);
+}
+
+/**************************************************************************/
+bool AppPerfStats::PublishDue(double dfNow)
+{
+    if(!Enabled())
+        return false;
+
+    if(last_publish_time_ == 0)
+    {
+        // start the first window now rather than report on start up noise
+        last_publish_time_ = dfNow;
+        GetReport("", dfNow);
+        return false;
+    }
+    return (dfNow - last_publish_time_) >= GetPublishInterval();
+}
+
+/**************************************************************************/
+std::string AppPerfStats::GetReport(const std::string & sAppName, double dfNow)
+{
+    static const char * sMetricNames[NUM_METRICS] = {"mail", "iter", "age"};
+
+    std::vector<uint64_t> totals[NUM_METRICS];
+    uint64_t nNotifies = 0;
+    uint64_t nMail = 0;
+    for(unsigned int s = 0; s < MAX_SHARDS; s++)
+    {
+        for(unsigned int m = 0; m < NUM_METRICS; m++)
+            shards_[s].histograms[m].AccumulateInto(totals[m]);
+        nNotifies += shards_[s].notifies.load(std::memory_order_relaxed);
+        nMail += shards_[s].mail.load(std::memory_order_relaxed);
+    }
+
+    char sBuf[128];
+    std::string sReport = "app=" + sAppName;
+    snprintf(sBuf, sizeof(sBuf), ",win=%.1f", dfNow - last_publish_time_);
+    sReport += sBuf;
+
+    for(unsigned int m = 0; m < NUM_METRICS; m++)
+    {
+        // report on the window since the last report only
+        std::vector<uint64_t> window = totals[m];
+        if(prev_counts_[m].size() == window.size())
+        {
+            for(unsigned int i = 0; i < window.size(); i++)
+                window[i] -= prev_counts_[m][i];
+        }
+        prev_counts_[m].swap(totals[m]);
+
+        const char * sName = sMetricNames[m];
+        uint64_t nCount = PerfHistogram::Total(window);
+        if(nCount == 0)
+        {
+            snprintf(sBuf, sizeof(sBuf), ",%s_n=0", sName);
+            sReport += sBuf;
+            continue;
+        }
+        snprintf(sBuf, sizeof(sBuf),
+                 ",%s_n=%llu,%s_p50=%.3f,%s_p99=%.3f,%s_max=%.3f",
+                 sName, (unsigned long long)nCount,
+                 sName, PerfHistogram::Percentile(window, 50) * 1e3,
+                 sName, PerfHistogram::Percentile(window, 99) * 1e3,
+                 sName, PerfHistogram::Max(window) * 1e3);
+        sReport += sBuf;
+    }
+
+    snprintf(sBuf, sizeof(sBuf), ",notifies=%llu,msgs=%llu",
+             (unsigned long long)(nNotifies - prev_notifies_),
+             (unsigned long long)(nMail - prev_mail_));
+    sReport += sBuf;
+
+    prev_notifies_ = nNotifies;
+    prev_mail_ = nMail;
+    last_publish_time_ = dfNow;
+
+    return sReport;
+}
+
+}
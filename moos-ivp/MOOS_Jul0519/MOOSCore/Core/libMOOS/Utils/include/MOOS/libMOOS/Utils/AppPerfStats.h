@@ -0,0 +1,136 @@
+/**
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//
+//   This file was written by agent, October 19th, 2026
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+**/
+
+/*
+ * AppPerfStats.h
+ *
+ *  Lightweight, lock-free latency histograms for a MOOS process.
+ *  CMOOSApp records OnNewMail processing time, Iterate duration,
+ *  mail age and Notify counts; AppCastingMOOSApp periodically
+ *  publishes a compact summary as APP_PERF.
+ */
+
+#ifndef APPPERFSTATS_H_
+#define APPPERFSTATS_H_
+
+#include <atomic>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace MOOS {
+
+/** A fixed-bucket histogram of durations. Buckets are quarter-octaves
+ *  of microseconds, so any value from 1us to ~16s lands in a bucket whose
+ *  width is within 19% of the value. Add() is lock-free and wait-free. */
+class PerfHistogram
+{
+public:
+    enum { NUM_BUCKETS = 97 };
+
+    PerfHistogram();
+
+    /** record a duration (seconds) */
+    void Add(double dfSeconds);
+
+    /** accumulate bucket counts into counts (resized if needed) */
+    void AccumulateInto(std::vector<uint64_t> & counts) const;
+
+    /** bucket for a duration, and the upper edge (seconds) of a bucket */
+    static unsigned int BucketIndex(double dfSeconds);
+    static double BucketUpperBound(unsigned int nBucket);
+
+    /** value (seconds) below which pct percent of counts fall */
+    static double Percentile(const std::vector<uint64_t> & counts, double pct);
+
+    /** upper edge (seconds) of the highest non-empty bucket */
+    static double Max(const std::vector<uint64_t> & counts);
+
+    static uint64_t Total(const std::vector<uint64_t> & counts);
+
+private:
+    std::atomic<uint64_t> counts_[NUM_BUCKETS];
+};
+
+
+/** Process wide performance statistics. Each thread records into its own
+ *  shard so the hot path never takes a lock or shares a cache line with
+ *  another recording thread. GetReport() folds the shards together and
+ *  reports on the window since the previous report. */
+class AppPerfStats
+{
+public:
+    enum Metric
+    {
+        MAIL_PROCESS = 0,  // time spent in OnNewMail
+        ITERATE,           // time spent in Iterate
+        MAIL_AGE,          // time now minus CMOOSMsg::m_dfTime on receipt
+        NUM_METRICS
+    };
+
+    static AppPerfStats & Instance();
+
+    /** recording is off (and costs a single load) until an interval is set */
+    void SetPublishInterval(double dfSeconds);
+    double GetPublishInterval() const;
+    bool Enabled() const;
+
+    void Record(Metric eMetric, double dfSeconds);
+    void CountNotify();
+    void CountMail(unsigned int nMessages);
+
+    /** true if a report should be published at (real) time dfNow */
+    bool PublishDue(double dfNow);
+
+    /** compact summary of the window since the last call, e.g.
+     *  app=pHelmIvP,win=5.0,iter_n=20,iter_p50=0.9,iter_p99=3.4,... with
+     *  all durations in milliseconds */
+    std::string GetReport(const std::string & sAppName, double dfNow);
+
+private:
+    AppPerfStats();
+    AppPerfStats(const AppPerfStats &);
+    AppPerfStats & operator=(const AppPerfStats &);
+
+    struct Shard
+    {
+        Shard();
+        PerfHistogram histograms[NUM_METRICS];
+        std::atomic<uint64_t> notifies;
+        std::atomic<uint64_t> mail;
+    };
+
+    Shard & LocalShard();
+
+    enum { MAX_SHARDS = 16 };
+    Shard shards_[MAX_SHARDS];
+    std::atomic<unsigned int> next_shard_;
+    std::atomic<double> publish_interval_;
+
+    // only touched by the publishing thread
+    double last_publish_time_;
+    std::vector<uint64_t> prev_counts_[NUM_METRICS];
+    uint64_t prev_notifies_;
+    uint64_t prev_mail_;
+};
+
+}
+
+#endif /* APPPERFSTATS_H_ */
@@ -0,0 +1,119 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of 
+//   Applications and Libraries for Mobile Robotics Research 
+//
+//   This file was written by agent, October 19th, 2026
+//              
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt distributed in the hope that it will be useful, 
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of 
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+//
+////////////////////////////////////////////////////////////////////////////
+
+
+
+
+/*
+ * MsgSerialiseBench.cpp
+ *
+ *  Micro benchmark of packing and unpacking packets of messages, the
+ *  work every MOOS process does for every packet it sends or receives.
+ *  Run with --no_pool to see the cost of allocating every message (and
+ *  its strings) afresh, as was done before messages were recycled.
+ */
+#include "MOOS/libMOOS/Comms/MOOSCommPkt.h"
+#include "MOOS/libMOOS/Comms/MsgPool.h"
+#include "MOOS/libMOOS/Utils/CommandLineParser.h"
+#include "MOOS/libMOOS/Utils/MOOSUtilityFunctions.h"
+
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+
+void PrintHelpAndExit()
+{
+	std::cout<<"msg_bench [options]\n";
+	std::cout<<"  --messages=<n>   messages per packet (default 100)\n";
+	std::cout<<"  --packets=<n>    packets to pack and unpack (default 20000)\n";
+	std::cout<<"  --string_size=<n> bytes in string payloads (default 32)\n";
+	std::cout<<"  --no_pool        don't recycle messages between packets\n";
+	exit(0);
+}
+
+int main(int argc, char * argv[])
+{
+	MOOS::CommandLineParser P(argc,argv);
+
+	if(P.GetFlag("-h","--help"))
+		PrintHelpAndExit();
+
+	int nMessages = 100;
+	int nPackets = 20000;
+	int nStringSize = 32;
+	P.GetVariable("--messages",nMessages);
+	P.GetVariable("--packets",nPackets);
+	P.GetVariable("--string_size",nStringSize);
+	bool bPool = !P.GetFlag("--no_pool");
+
+	if(!bPool)
+		MOOS::MsgPool::Instance().SetCapacity(0);
+
+	//a typical mix, two thirds numeric (NAV_X etc) one third strings
+	MOOSMSG_LIST TxList;
+	std::string sPayload(nStringSize,'x');
+	for(int i = 0;i<nMessages;i++)
+	{
+		std::string sKey = MOOSFormat("VARIABLE_%d",i%20);
+		if(i%3==2)
+			TxList.push_back(CMOOSMsg(MOOS_NOTIFY,sKey,sPayload,MOOSTime()));
+		else
+			TxList.push_back(CMOOSMsg(MOOS_NOTIFY,sKey,i*1.5,MOOSTime()));
+		TxList.back().m_sSrc = "uSimMarineV22";
+		TxList.back().m_sOriginatingCommunity = "shoreside";
+	}
+
+	CMOOSCommPkt Pkt;
+	MOOSMSG_LIST RxList;
+	double dfPackTime = 0;
+	double dfUnpackTime = 0;
+	unsigned int nReceived = 0;
+
+	for(int i = 0;i<nPackets;i++)
+	{
+		double dfT0 = MOOS::Time();
+		Pkt.Serialize(TxList,true);
+		double dfT1 = MOOS::Time();
+		Pkt.Serialize(RxList,false);
+		nReceived+=RxList.size();
+		if(bPool)
+			MOOS::MsgPool::Instance().Give(RxList);
+		else
+			RxList.clear();
+		double dfT2 = MOOS::Time();
+
+		dfPackTime+=dfT1-dfT0;
+		dfUnpackTime+=dfT2-dfT1;
+	}
+
+	if(nReceived!=(unsigned int)(nMessages*nPackets))
+	{
+		std::cerr<<"lost messages! sent "<<nMessages*nPackets<<" received "<<nReceived<<"\n";
+		return 1;
+	}
+
+	std::cout<<std::fixed<<std::setprecision(0);
+	std::cout<<nPackets<<" packets of "<<nMessages<<" messages ("
+			<<Pkt.GetStreamLength()<<" bytes) pooling "<<(bPool ? "on" : "off")<<"\n";
+	std::cout<<"  pack   : "<<nPackets/dfPackTime<<" pkts/s  "
+			<<nPackets*nMessages/dfPackTime<<" msgs/s\n";
+	std::cout<<"  unpack : "<<nPackets/dfUnpackTime<<" pkts/s  "
+			<<nPackets*nMessages/dfUnpackTime<<" msgs/s\n";
+
+	return 0;
+}
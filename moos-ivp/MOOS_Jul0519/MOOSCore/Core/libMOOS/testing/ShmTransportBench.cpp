@@ -0,0 +1,267 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//
+//   This file was written by agent, October 19th, 2026
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+
+
+
+/*
+ * ShmTransportBench.cpp
+ *
+ *  Packets between two threads over a loopback socket, first as they go
+ *  over TCP and then with a shared memory channel attached to each end,
+ *  both through CMOOSCommObject::SendPkt()/ReadPkt() as a client and the
+ *  DB use them. For each payload size it measures the round trip of a
+ *  one message packet (median and 99th percentile) and the rate a stream
+ *  of packets gets across one way.
+ */
+#include "MOOS/libMOOS/Comms/MOOSCommObject.h"
+#include "MOOS/libMOOS/Comms/MOOSCommPkt.h"
+#include "MOOS/libMOOS/Comms/XPCTcpSocket.h"
+#include "MOOS/libMOOS/Comms/ShmTransport.h"
+#include "MOOS/libMOOS/Utils/CommandLineParser.h"
+#include "MOOS/libMOOS/Utils/MOOSUtilityFunctions.h"
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <thread>
+#include <vector>
+#include <cstdlib>
+
+void PrintHelpAndExit()
+{
+	std::cout<<"shm_bench [options]\n";
+	std::cout<<"  --port=<n>         first loopback port to use (default 9731)\n";
+	std::cout<<"  --round_trips=<n>  round trips per size (default 20000)\n";
+	std::cout<<"  --packets=<n>      packets per size in the stream (default 20000)\n";
+	std::cout<<"  --messages=<n>     messages per packet in the stream (default 10)\n";
+	exit(0);
+}
+
+//gives the bench the same send and read a client and the DB use
+class BenchEnd : public CMOOSCommObject
+{
+public:
+	using CMOOSCommObject::SendPkt;
+	using CMOOSCommObject::ReadPkt;
+};
+
+struct Connection
+{
+	XPCTcpSocket * pListen;
+	XPCTcpSocket * pNear;
+	XPCTcpSocket * pFar;
+};
+
+//a connected pair of sockets on loopback, shared memory on both if asked
+bool Connect(int nPort,bool bShm,Connection & C)
+{
+	C.pListen = new XPCTcpSocket(nPort);
+	C.pListen->vSetReuseAddr(1);
+	C.pListen->vBindSocket();
+	C.pListen->vListen(1);
+
+	C.pFar = NULL;
+	std::thread Acceptor([&C](){C.pFar = C.pListen->Accept();});
+
+	C.pNear = new XPCTcpSocket(nPort);
+	C.pNear->vSetNoDelay(1);
+	C.pNear->vConnect("127.0.0.1");
+	Acceptor.join();
+	C.pFar->vSetNoDelay(1);
+
+	if(!bShm)
+		return true;
+
+	if(!MOOS::ShmChannel::Supported())
+		return false;
+
+	std::shared_ptr<MOOS::ShmChannel> pFarEnd(new MOOS::ShmChannel);
+	std::shared_ptr<MOOS::ShmChannel> pNearEnd(new MOOS::ShmChannel);
+	MOOS::ShmTransport & Shm = MOOS::ShmTransport::Instance();
+	if(!pFarEnd->Create(Shm.NewName(),Shm.GetRingBytes()) || !pNearEnd->Open(pFarEnd->GetName()))
+		return false;
+	pFarEnd->Unlink();
+	Shm.Attach(C.pFar->iGetSocketFd(),pFarEnd);
+	Shm.Attach(C.pNear->iGetSocketFd(),pNearEnd);
+	return true;
+}
+
+void Disconnect(Connection & C)
+{
+	MOOS::ShmTransport::Instance().Detach(C.pNear->iGetSocketFd());
+	MOOS::ShmTransport::Instance().Detach(C.pFar->iGetSocketFd());
+	C.pNear->vCloseSocket();
+	C.pFar->vCloseSocket();
+	C.pListen->vCloseSocket();
+	delete C.pNear;
+	delete C.pFar;
+	delete C.pListen;
+}
+
+MOOSMSG_LIST MakeMessages(int nMessages,int nPayload)
+{
+	MOOSMSG_LIST List;
+	std::string sPayload(nPayload,'x');
+	for(int i = 0;i<nMessages;i++)
+		List.push_back(CMOOSMsg(MOOS_NOTIFY,"BENCH_VAR",sPayload,MOOSLocalTime()));
+	return List;
+}
+
+//the median and 99th percentile of nTrips round trips, in microseconds
+void RoundTrips(Connection & C,int nPayload,int nTrips,double & dfP50,double & dfP99)
+{
+	MOOSMSG_LIST Tx = MakeMessages(1,nPayload);
+
+	std::thread Echo([&C,nTrips](){
+		BenchEnd Far;
+		for(int i = 0;i<nTrips;i++)
+		{
+			CMOOSCommPkt In,Out;
+			MOOSMSG_LIST List;
+			Far.ReadPkt(C.pFar,In);
+			In.Serialize(List,false);
+			Out.Serialize(List,true);
+			Far.SendPkt(C.pFar,Out);
+		}
+	});
+
+	BenchEnd Near;
+	std::vector<double> Times;
+	Times.reserve(nTrips);
+	for(int i = 0;i<nTrips;i++)
+	{
+		CMOOSCommPkt Out,In;
+		Out.Serialize(Tx,true);
+		double dfT0 = MOOSLocalTime(false);
+		Near.SendPkt(C.pNear,Out);
+		Near.ReadPkt(C.pNear,In);
+		Times.push_back((MOOSLocalTime(false)-dfT0)*1e6);
+	}
+	Echo.join();
+
+	std::sort(Times.begin(),Times.end());
+	dfP50 = Times[Times.size()/2];
+	dfP99 = Times[(Times.size()*99)/100];
+}
+
+//packets (and bytes) per second of a stream of nPackets one way
+void Stream(Connection & C,int nPayload,int nMessages,int nPackets,double & dfPktRate,double & dfMBRate)
+{
+	CMOOSCommPkt Out;
+	MOOSMSG_LIST Tx = MakeMessages(nMessages,nPayload);
+	Out.Serialize(Tx,true);
+
+	std::thread Sink([&C,nPackets](){
+		BenchEnd Far;
+		for(int i = 0;i<nPackets;i++)
+		{
+			CMOOSCommPkt In;
+			MOOSMSG_LIST List;
+			Far.ReadPkt(C.pFar,In);
+			In.Serialize(List,false);
+		}
+		//say when all are in
+		CMOOSCommPkt Done;
+		MOOSMSG_LIST Empty;
+		Done.Serialize(Empty,true);
+		Far.SendPkt(C.pFar,Done);
+	});
+
+	BenchEnd Near;
+	double dfT0 = MOOSLocalTime(false);
+	for(int i = 0;i<nPackets;i++)
+		Near.SendPkt(C.pNear,Out);
+	CMOOSCommPkt Done;
+	Near.ReadPkt(C.pNear,Done);
+	double dfTaken = MOOSLocalTime(false)-dfT0;
+	Sink.join();
+
+	dfPktRate = nPackets/dfTaken;
+	dfMBRate = (double)nPackets*Out.GetStreamLength()/dfTaken/(1024*1024);
+}
+
+int main(int argc, char * argv[])
+{
+	MOOS::CommandLineParser P(argc,argv);
+
+	if(P.GetFlag("-h","--help"))
+		PrintHelpAndExit();
+
+	int nPort = 9731;
+	int nTrips = 20000;
+	int nPackets = 20000;
+	int nMessages = 10;
+	P.GetVariable("--port",nPort);
+	P.GetVariable("--round_trips",nTrips);
+	P.GetVariable("--packets",nPackets);
+	P.GetVariable("--messages",nMessages);
+
+	if(!MOOS::ShmChannel::Supported())
+		std::cout<<"shared memory is not supported here, tcp only\n";
+
+	int Sizes[] = {8,256,4096,65536};
+	const char * Names[] = {"tcp","shm"};
+
+	std::cout<<std::fixed;
+	std::cout<<"payload  transport   rtt p50 (us)  rtt p99 (us)     pkts/s      MB/s\n";
+	for(int s = 0;s<4;s++)
+	{
+		for(int t = 0;t<2;t++)
+		{
+			bool bShm = t==1;
+			if(bShm && !MOOS::ShmChannel::Supported())
+				continue;
+
+			double dfP50,dfP99,dfPktRate,dfMBRate;
+			Connection C;
+			try
+			{
+				if(!Connect(nPort++,bShm,C))
+				{
+					std::cerr<<"failed to make a shared memory channel\n";
+					return 1;
+				}
+				RoundTrips(C,Sizes[s],nTrips,dfP50,dfP99);
+				Disconnect(C);
+
+				if(!Connect(nPort++,bShm,C))
+					return 1;
+				Stream(C,Sizes[s],nMessages,Sizes[s]>4096 ? nPackets/10 : nPackets,dfPktRate,dfMBRate);
+				Disconnect(C);
+			}
+			catch(XPCException & e)
+			{
+				std::cerr<<"socket error "<<e.sGetException()<<"\n";
+				return 1;
+			}
+			catch(CMOOSException & e)
+			{
+				std::cerr<<"comms error "<<e.m_sReason<<"\n";
+				return 1;
+			}
+
+			std::cout<<std::setw(7)<<Sizes[s]<<"  "<<std::left<<std::setw(9)<<Names[t]<<std::right
+					<<std::setprecision(1)<<std::setw(14)<<dfP50<<std::setw(14)<<dfP99
+					<<std::setprecision(0)<<std::setw(11)<<dfPktRate
+					<<std::setprecision(1)<<std::setw(10)<<dfMBRate<<"\n";
+		}
+	}
+
+	return 0;
+}
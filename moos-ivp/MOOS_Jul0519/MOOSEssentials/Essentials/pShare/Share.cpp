@@ -21,6 +21,7 @@
 #include "MOOS/libMOOS/Utils/SafeList.h"
 #include "MOOS/libMOOS/Utils/ConsoleColours.h"
 #include "MOOS/libMOOS/Utils/KeyboardCapture.h"
+#include "MOOS/libMOOS/Comms/MsgTrace.h"
 
 #include "MOOS/libMOOS/App/MOOSApp.h"
 
@@ -571,6 +572,9 @@ bool Share::Impl::Iterate()
 			//new_msg.Trace();
 			if(!m_Comms.IsRegisteredFor(new_msg.GetKey()))
 			{
+				if(MOOS::MsgTrace::IsTraced(new_msg.m_sSrcAux))
+					MOOS::MsgTrace::AddHop(new_msg.m_sSrcAux,"shrx:"+GetAppName(),MOOSTime());
+
 				m_Comms.Post(new_msg,true);
 				if(verbose_)
 				{
@@ -1051,6 +1055,18 @@ bool Share::Impl::ApplyRoutes(CMOOSMsg & msg)
 
 	double now = MOOS::Time();
 
+	//traced messages take their trace back on for the wire (CMOOSApp
+	//took it off on receipt) and note when they left
+	if(!MOOS::MsgTrace::IsTraced(msg.m_sSrcAux))
+	{
+		std::string trace = MOOS::MsgTrace::Instance().HeldTrace(msg);
+		if(!trace.empty())
+		{
+			msg.m_sSrcAux+=trace;
+			MOOS::MsgTrace::AddHop(msg.m_sSrcAux,"shtx:"+GetAppName(),MOOSTime());
+		}
+	}
+
 	std::list<Route>::iterator q;
 	for(q = route_list.begin();q!=route_list.end();q++)
 	{
@@ -34,6 +34,8 @@ void showHelpAndExit()
 	 "   satisfied in an alog file.\n");
   printf("\nUsage:\n");
   printf("   %s in.log [OPTIONS]\n", "alogcheck" );
+  printf("   %s a.alog b.alog ... [OPTIONS]\n", "alogcheck" );
+  printf("   %s logdir/ [OPTIONS]\n", "alogcheck" );
   printf("\nOptions:\n");
   
   printf("   -s, --start [COND]      - Delays checking other conditions until these\n"
@@ -53,6 +55,8 @@ void showHelpAndExit()
 	 "                             in the input file.\n");
   printf("   -o, --output [file]     - Prints the output from the checker to a file\n");
   printf("   --verbose               - Sets the checker to be verbose\n");
+  printf("   --threads=N             - Threads used when checking several alog files.\n"
+	 "                             Default is one per CPU core.\n");
   printf("\nGlobal options:\n");
   printf("   -h, --help              - Displays the help contents\n");
   printf("   -v, --version           - Displays the version information\n");
@@ -70,7 +74,11 @@ void showHelpAndExit()
 	 "      For instance, on Linux if \"NAV_X>100\" is not wrapped in quotes, the\n"
 	 "      application output will be redirected to a file named '100'.\n"
 	 "   3. When using the logical-AND or logical-OR operators, expressions MUST use\n"
-	 "      parentheses: (NAV_X<0) OR (NAV_X>100)\n");
+	 "      parentheses: (NAV_X<0) OR (NAV_X>100)\n"
+	 "   4. Given several alog files, a directory (searched for .alog files) or a\n"
+	 "      quoted glob, each file is checked in parallel against the same\n"
+	 "      conditions. A PASSED/FAILED line is shown per file and the overall\n"
+	 "      check passes only if every file passes.\n");
   printf("\nExample:\n");
   printf("   alogcheck --start \"ALOG_TIMESTAMP > 20\" --end \"ALOG_TIMESTAMP > 500\"\n"
 	 "     --pass \"DEPLOY==false\" --pass \"MISSION_COMPLETE=true\" \n"
@@ -30,6 +30,8 @@
 #include "ReleaseInfo.h"
 #include "LogChecker.h"
 #include "LogChecker_Info.h"
+#include "ALogBatch.h"
+#include "ACTable.h"
 
 
 #ifndef FAIL
@@ -47,6 +49,10 @@ string g_name = "alogcheck";
 
 // Declare the needed functions
 void printVersion();
+bool configureChecker(LogChecker&, const vector<vector<string> >&,
+		      string input_file);
+bool mergeOutputFiles(string output_file, const vector<string>& alog_files,
+		      const vector<int>& results);
 
 int main(int argc, char** argv);
 
@@ -60,6 +66,64 @@ void printVersion() {
   exit(SUCCESS);
 } 
 
+/**
+ * Apply the start, end, pass and fail conditions to a checker. The
+ * conditions are kept so each file in a batch gets its own checker.
+ */
+bool configureChecker(LogChecker& checker, 
+		      const vector<vector<string> >& flags, string input_file)
+{
+  bool ok = true;
+  for(unsigned int i=0; i<flags[0].size(); i++)
+    ok = ok && checker.addStartFlag(flags[0][i]);
+  for(unsigned int i=0; i<flags[1].size(); i++)
+    ok = ok && checker.addEndFlag(flags[1][i]);
+  for(unsigned int i=0; i<flags[2].size(); i++)
+    ok = ok && checker.addPassFlag(flags[2][i]);
+  for(unsigned int i=0; i<flags[3].size(); i++)
+    ok = ok && checker.addFailFlag(flags[3][i]);
+  if(!input_file.empty())
+    checker.parseInputFile(input_file);
+  return(ok);
+}
+
+/**
+ * Gather the per-file outputs of a batch, written in parallel to
+ * output_file.<ix>, into output_file in the order files were given.
+ * Each file's output is headed by its name and followed by its
+ * result. The per-file outputs are removed.
+ */
+bool mergeOutputFiles(string output_file, const vector<string>& alog_files,
+		      const vector<int>& results)
+{
+  FILE* fout = fopen(output_file.c_str(), "w");
+  if(!fout)
+    printf("Output could not be created: %s\n", output_file.c_str());
+
+  for(unsigned int i=0; i<alog_files.size(); i++) {
+    string part = output_file + "." + uintToString(i);
+    FILE* fpart = fopen(part.c_str(), "r");
+    if(fout) {
+      fprintf(fout, "%s\n", alog_files[i].c_str());
+      if(fpart) {
+	char buff[4096];
+	size_t n;
+	while((n = fread(buff, 1, sizeof(buff), fpart)) > 0)
+	  fwrite(buff, 1, n, fout);
+      }
+      fprintf(fout, "%s\n\n", results[i] ? "PASSED" : "FAILED");
+    }
+    if(fpart) {
+      fclose(fpart);
+      remove(part.c_str());
+    }
+  }
+  if(!fout)
+    return(false);
+  fclose(fout);
+  return(true);
+}
+
 int main(int argc, char** argv) 
 {
   // Check for the version flag
@@ -70,18 +134,40 @@ int main(int argc, char** argv)
   if(scanArgs(argc, argv, "-h", "--help", "-help"))
     showHelpAndExit();
   
-  string alog_file   = "";
+  vector<string> alog_files;
   string input_file  = "";
   string output_file = "";
   LogChecker m_checker;
+
+  // Conditions in order start, end, pass, fail for batch mode
+  vector<vector<string> > flags(4);
+  unsigned int threads = 0;
+  bool batch = false;
+  bool verbose = false;
   
   // Itterate over all of the arguments and check for valid flags
   for(int i=1; i< argc; i++){
     string argi = argv[i];
-    if( strEnds(argi, ".alog") ){
-      alog_file = argi;
+    if( strEnds(argi, ".alog") && !strContains(argi, '*') &&
+	!strContains(argi, '?') ){
+      alog_files.push_back(argi);
     } 
 
+    else if( strBegins(argi, "--threads=") && isNumber(argi.substr(10)) ) {
+      threads = (unsigned int)(atoi(argi.substr(10).c_str()));
+    }
+
+    else if( !strBegins(argi, "-") ) {
+      // A directory or glob, expanded to the alog files it names
+      vector<string> files = expandALogFiles(argi);
+      if(files.empty()) {
+	printf("Unknow argument: %s\n", argi.c_str() );
+	showHelpAndExit();
+      }
+      alog_files.insert(alog_files.end(), files.begin(), files.end());
+      batch = true;
+    }
+
     else if(argi == "-i" || argi == "--input") {
       // An input file is desired - check for another argument
       if( i+1 < argc ) {
@@ -114,6 +200,7 @@ int main(int argc, char** argv)
 	  printf("ERROR: Bad Fail condition: %s\n", flag.c_str() );
 	  return FAIL;
 	} // END Check add fail flag
+	flags[3].push_back(flag);
       } 
       else 
 	showHelpAndExit(); // incorrect number of args
@@ -128,6 +215,7 @@ int main(int argc, char** argv)
 	  printf("ERROR: Bad Pass condition: %s\n", flag.c_str() );
 	  return FAIL;
 	} // END check add pass flag
+	flags[2].push_back(flag);
       } else {
 	// There is an incorrect number of arguments
 	showHelpAndExit();
@@ -143,6 +231,7 @@ int main(int argc, char** argv)
 	  printf("ERROR: Bad Start condition: %s\n", flag.c_str() );
 	  return FAIL;
 	} // END check add Start flag
+	flags[0].push_back(flag);
       } else {
 	// There is an incorrect number of arguments
 	showHelpAndExit();
@@ -158,6 +247,7 @@ int main(int argc, char** argv)
 	  printf("ERROR: Bad Start condition: %s\n", flag.c_str() );
 	  return FAIL;
 	} // END check add end flag
+	flags[1].push_back(flag);
             } else {
                 // There is an incorrect number of arguments
                 showHelpAndExit();
@@ -165,6 +255,7 @@ int main(int argc, char** argv)
         } else if (argi == "--verbose"){
             // The verbose flag has been specified - Set checker to verbose
             m_checker.setVerbose(true);
+            verbose = true;
         } else {
             // Unknow argument
             printf("Unknow argument: %s\n", argi.c_str() );
@@ -174,10 +265,12 @@ int main(int argc, char** argv)
 
 
     // Check if the log file is empty
-    if(alog_file.empty()) {
+    if(alog_files.empty()) {
       printf("No alog file given - exiting\n");
       return(FAIL);
     } 
+    if(alog_files.size() > 1)
+      batch = true;
     
     // Check if we need to parse the input file
     if(!input_file.empty() ) {
@@ -190,9 +283,56 @@ int main(int argc, char** argv)
 #ifdef DEBUG
     printf("Running in Debug mode\n");
 #endif
+
+    // Run a checker per logfile in parallel, each with the same
+    // conditions, and report one line per file
+    if(batch) {
+      unsigned int total = alog_files.size();
+      for(unsigned int i=0; i<total; i++) {
+	if(alog_files[i] == output_file) {
+	  printf("Input and output .alog files cannot be the same.\n");
+	  return(FAIL);
+	}
+      }
+
+      // Checkers run in parallel, so each writes its own output
+      // file. These are gathered into the one output file after.
+      vector<int> results(total, 0);
+      runALogBatch(total, threads, [&](unsigned int ix) {
+	LogChecker checker;
+	checker.setVerbose(verbose);
+	string part_file;
+	if(output_file != "")
+	  part_file = output_file + "." + uintToString(ix);
+	if(configureChecker(checker, flags, input_file))
+	  results[ix] = checker.check(alog_files[ix], part_file) ? 1 : 0;
+      }, alog_files);
+      if(output_file != "")
+	mergeOutputFiles(output_file, alog_files, results);
+
+      ACTable actab(2,2);
+      actab << "ALog File | Result";
+      actab.addHeaderLines();
+      unsigned int passed = 0;
+      for(unsigned int i=0; i<total; i++) {
+	actab << alog_files[i] << (results[i] ? "PASSED" : "FAILED");
+	passed += results[i];
+      }
+      vector<string> lines = actab.getTableOutput();
+      for(unsigned int i=0; i<lines.size(); i++)
+	printf("%s\n", lines[i].c_str());
+      printf("\n%u of %u files passed\n", passed, total);
+
+      if(passed == total) {
+	printf("PASSED\n");
+	return SUCCESS;
+      }
+      printf("FAILED\n");
+      return(FAIL);
+    }
     
     // Run the checker on the logfile
-    if(m_checker.check(alog_file, output_file) ) {
+    if(m_checker.check(alog_files[0], output_file) ) {
       printf("PASSED\n");
       return SUCCESS;
     } 
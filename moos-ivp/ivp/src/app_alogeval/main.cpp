@@ -21,6 +21,7 @@
 /* <http://www.gnu.org/licenses/>.                               */
 /*****************************************************************/
 
+#include <vector>
 #include <string>
 #include <cstdlib>
 #include <iostream>
@@ -28,6 +29,8 @@
 #include "OpenURL.h"
 #include "ReleaseInfo.h"
 #include "ALogEvaluator.h"
+#include "ALogBatch.h"
+#include "ACTable.h"
 
 using namespace std;
 
@@ -38,17 +41,29 @@ int main(int argc, char *argv[])
 {
   ALogEvaluator evaluator;
 
+  vector<string> alog_files;
+  string         test_file;
+  unsigned int   threads = 0;
+  bool           batch = false;
+
   for(int i=1; i<argc; i++) {
     string argi = argv[i];
     if((argi=="-h") || (argi == "--help") || (argi=="-help")) {
       cout << "Usage: " << endl;
       cout << "  alogeval in.alog criteria.txt [OPTIONS]                " << endl;
+      cout << "  alogeval a.alog b.alog ... criteria.txt [OPTIONS]      " << endl;
+      cout << "  alogeval logdir/ criteria.txt [OPTIONS]                " << endl;
       cout << "                                                         " << endl;
       cout << "Synopsis:                                                " << endl;
       cout << "  Scan the given alog file and apply the test criteria   " << endl;
       cout << "  found in criteria.txt. The criteria should be in the   " << endl;
       cout << "  same format as would be provided in pMissionEval.      " << endl;
       cout << "                                                         " << endl;
+      cout << "  Given several alog files, a directory (searched for    " << endl;
+      cout << "  .alog files) or a quoted glob, each file is evaluated  " << endl;
+      cout << "  in parallel and a fleet summary is shown. The return   " << endl;
+      cout << "  value is the worst over all files.                     " << endl;
+      cout << "                                                         " << endl;
       cout << "Standard Arguments:                                      " << endl;
       cout << "  in.alog       - The input logfile.                     " << endl;
       cout << "  criteria.txt  - The test criteria file                 " << endl;
@@ -59,6 +74,8 @@ int main(int argc, char *argv[])
       cout << "  --verbose         Verbose mode                         " << endl;
       cout << "  --show_seq, -ss   Show Logic test structure at start,  " << endl;
       cout << "                    and at finish. --verbose also needed " << endl;
+      cout << "  --threads=N       Threads for multi-file evaluation    " << endl;
+      cout << "                    (Default is one per CPU core)        " << endl;
       cout << "                                                         " << endl;
       cout << "  --web,-w   Open browser to:                            " << endl;
       cout << "             https://oceanai.mit.edu/ivpman/apps/alogeval" << endl;
@@ -84,12 +101,26 @@ int main(int argc, char *argv[])
     }
 
     bool handled = true;
-    if(strEnds(argi, ".alog"))
-      handled = evaluator.setALogFile(argi);
-    else if(strEnds(argi, ".txt"))
+    if(strEnds(argi, ".alog") && !strContains(argi, '*') &&
+       !strContains(argi, '?')) {
+      handled = okFileToRead(argi);
+      alog_files.push_back(argi);
+    }
+    else if(strEnds(argi, ".txt")) {
       handled = evaluator.setTestFile(argi);
-    else if(strBegins(argi, "--testfile="))
+      test_file = argi;
+    }
+    else if(strBegins(argi, "--testfile=")) {
       handled = evaluator.setTestFile(argi.substr(11));
+      test_file = argi.substr(11);
+    }
+    else if(strBegins(argi, "--threads=") && isNumber(argi.substr(10)))
+      threads = (unsigned int)(atoi(argi.substr(10).c_str()));
+    else if(!strBegins(argi, "-") && !expandALogFiles(argi).empty()) {
+      vector<string> files = expandALogFiles(argi);
+      alog_files.insert(alog_files.end(), files.begin(), files.end());
+      batch = true;
+    }
     else if(argi == "--verbose")
       evaluator.setVerbose();
     else if((argi == "--show_seq") || (argi == "-ss"))
@@ -107,15 +138,58 @@ int main(int argc, char *argv[])
     }
   }
 
-  if(!evaluator.okALogFile()) {
+  if(alog_files.size() == 0) {
     cout << "A valid alog file must be given. Exiting. " << endl;
     return(3);
   }    
-  if(!evaluator.okALogFile()) {
+  if(alog_files.size() > 1)
+    batch = true;
+  if(!batch)
+    evaluator.setALogFile(alog_files[0]);
+  if(!evaluator.okTestFile()) {
     cout << "A valid criteria file must be given. Exiting. " << endl;
     return(4);
   }
     
+  // Evaluate each file with its own evaluator, in parallel, and
+  // return the worst result over all files.
+  if(batch) {
+    unsigned int total = alog_files.size();
+    vector<int> results(total, 5);
+    runALogBatch(total, threads, [&](unsigned int ix) {
+      ALogEvaluator file_evaluator;
+      if(!file_evaluator.setALogFile(alog_files[ix]) ||
+	 !file_evaluator.setTestFile(test_file))
+	return;
+      if(!file_evaluator.handle())
+	return;
+      results[ix] = file_evaluator.passed() ? 0 : 1;
+    }, alog_files);
+
+    ACTable actab(2,2);
+    actab << "ALog File | Result";
+    actab.addHeaderLines();
+    unsigned int passed = 0;
+    int worst = 0;
+    for(unsigned int i=0; i<total; i++) {
+      string result = "pass";
+      if(results[i] == 1)
+	result = "fail";
+      else if(results[i] != 0)
+	result = "invalid";
+      actab << alog_files[i] << result;
+      if(results[i] == 0)
+	passed++;
+      if(results[i] > worst)
+	worst = results[i];
+    }
+    vector<string> lines = actab.getTableOutput();
+    for(unsigned int i=0; i<lines.size(); i++)
+      cout << lines[i] << endl;
+    cout << endl << passed << " of " << total << " files passed" << endl;
+    return(worst);
+  }
+
   bool handled = evaluator.handle();
   if(!handled)
     return(5);
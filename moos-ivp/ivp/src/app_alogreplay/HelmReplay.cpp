@@ -0,0 +1,789 @@
+/*****************************************************************/
+/*    NAME: agent                                                */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: HelmReplay.cpp                                       */
+/*    DATE: Oct 19th, 2026                                       */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <algorithm>
+#include "HelmReplay.h"
+#include "MBUtils.h"
+#include "AngleUtils.h"
+#include "BuildUtils.h"
+#include "BuildTally.h"
+#include "LogUtils.h"
+#include "NodeRecordUtils.h"
+#include "Populator_BehaviorSet.h"
+
+using namespace std;
+
+//-----------------------------------------------------------
+// Procedure: percentile()
+//      Note: Values are expected sorted in increasing order.
+
+static double percentile(const vector<double>& vals, double pct)
+{
+  if(vals.size() == 0)
+    return(0);
+  unsigned int ix = (unsigned int)((pct / 100.0) * (vals.size()-1) + 0.5);
+  if(ix >= vals.size())
+    ix = vals.size()-1;
+  return(vals[ix]);
+}
+
+//-----------------------------------------------------------
+// Constructor()
+
+HelmReplay::HelmReplay()
+{
+  m_helm_app  = "pHelmIvP";
+  m_tolerance = 0.001;
+  m_reps      = 1;
+  m_verbose   = false;
+
+  m_log_start = 0;
+  m_start_utc = 0;
+
+  m_info_buffer = 0;
+  m_ledger_snap = 0;
+  m_hengine     = 0;
+  m_bhv_set     = 0;
+
+  m_curr_time        = 0;
+  m_init_vars_done   = false;
+  m_info_vars_tcount = 0;
+
+  m_mismatch_iters = 0;
+  m_checked_iters  = 0;
+  m_unstable_iters = 0;
+}
+
+//-----------------------------------------------------------
+// Procedure: addDomain()
+//   Example: "course:0:359:360", as in the helm's ivp_domain
+
+bool HelmReplay::addDomain(string entry)
+{
+  entry = findReplace(stripBlankEnds(entry), ':', ',');
+  IvPDomain domain = stringToDomain(entry);
+  if(domain.size() != 1)
+    return(false);
+
+  return(m_ivp_domain.addDomain(domain.getVarName(0).c_str(),
+				domain.getVarLow(0), domain.getVarHigh(0),
+				domain.getVarPoints(0)));
+}
+
+//-----------------------------------------------------------
+// Procedure: readALog()
+//   Purpose: Read the whole log into memory up front so that file
+//            reading plays no part in the timing of the replay.
+
+bool HelmReplay::readALog(string alog_file)
+{
+  FILE *f = fopen(alog_file.c_str(), "r");
+  if(!f) {
+    cout << "Unable to open alog file: " << alog_file << endl;
+    return(false);
+  }
+  m_alog_file = alog_file;
+  m_log_start = getLogStartFromFile(alog_file);
+
+  m_entries.clear();
+  while(1) {
+    ALogEntry entry = getNextRawALogEntry(f);
+    string status = entry.getStatus();
+    if(status == "eof")
+      break;
+    if(status == "invalid")
+      continue;
+    // IvP functions are only of use to a live viewer
+    if(entry.getVarName() == "BHV_IPF")
+      continue;
+    m_entries.push_back(entry);
+  }
+  fclose(f);
+
+  findIterations();
+  findVName();
+
+  // Unless given, the domain is the one the helm posted on startup
+  for(unsigned int i=0; (i<m_entries.size()) && !m_ivp_domain.size(); i++) {
+    if((m_entries[i].getVarName() == "IVPHELM_DOMAIN") &&
+       isHelmEntry(m_entries[i]))
+      m_ivp_domain = stringToDomain(m_entries[i].getStringVal());
+  }
+
+  if(m_iter_start.size() == 0) {
+    cout << "No IVPHELM_ITER postings by " << m_helm_app << " found in ";
+    cout << alog_file << endl;
+    return(false);
+  }
+  if(m_ivp_domain.size() == 0) {
+    cout << "No IVPHELM_DOMAIN found in " << alog_file;
+    cout << ", use --domain" << endl;
+    return(false);
+  }
+  return(true);
+}
+
+//-----------------------------------------------------------
+// Procedure: findIterations()
+//   Purpose: Cut the log into the helm's iterations. The helm
+//            posts IVPHELM_CPU as an iteration begins and
+//            IVPHELM_ITER once the decision has been made. Mail
+//            logged before the former was in hand for the decision.
+
+void HelmReplay::findIterations()
+{
+  m_iter_start.clear();
+  m_iter_post.clear();
+  m_iter_logged.clear();
+
+  bool start_found = false;
+  int  last_cpu = -1;
+  for(unsigned int i=0; i<m_entries.size(); i++) {
+    if(!isHelmEntry(m_entries[i]))
+      continue;
+    if(!start_found) {
+      m_start_utc = m_log_start + m_entries[i].getTimeStamp();
+      start_found = true;
+    }
+
+    string var = m_entries[i].getVarName();
+    if(var == "IVPHELM_CPU")
+      last_cpu = (int)(i);
+    else if(var == "IVPHELM_ITER") {
+      unsigned int start = i;
+      if(last_cpu >= 0)
+	start = (unsigned int)(last_cpu);
+      m_iter_start.push_back(start);
+      m_iter_post.push_back(i);
+      m_iter_logged.push_back((unsigned int)(m_entries[i].getDoubleVal()));
+      last_cpu = -1;
+    }
+  }
+}
+
+//-----------------------------------------------------------
+// Procedure: findVName()
+
+void HelmReplay::findVName()
+{
+  if(m_vname != "")
+    return;
+
+  for(unsigned int i=0; i<m_entries.size(); i++) {
+    if(m_entries[i].getVarName() == "NODE_REPORT_LOCAL") {
+      NodeRecord record = string2NodeRecord(m_entries[i].getStringVal());
+      if(record.getName() != "") {
+	m_vname = record.getName();
+	return;
+      }
+    }
+  }
+  m_vname = "ownship";
+}
+
+//-----------------------------------------------------------
+// Procedure: isHelmEntry()
+
+bool HelmReplay::isHelmEntry(const ALogEntry& entry) const
+{
+  return(strBegins(entry.getSource(), m_helm_app));
+}
+
+//-----------------------------------------------------------
+// Procedure: run()
+//   Purpose: Replay the log m_reps times. The fastest time seen
+//            for each iteration is kept, and the decisions of each
+//            repetition are checked against those of the first.
+
+bool HelmReplay::run()
+{
+  unsigned int iters = m_iter_start.size();
+  if(iters == 0)
+    return(false);
+
+  m_create_ms.assign(iters, 0);
+  m_solve_ms.assign(iters, 0);
+  m_pcs.assign(iters, 0);
+  m_match.assign(iters, -1);
+  m_match_note.assign(iters, "");
+  m_dec_spec.assign(iters, "");
+  m_unstable.assign(iters, false);
+  m_rep_wall.clear();
+
+  for(unsigned int rep=0; rep<m_reps; rep++) {
+    if(!runOnce(rep))
+      return(false);
+    if(m_verbose)
+      cout << "Rep " << rep+1 << " of " << m_reps << ": " <<
+	doubleToString(m_rep_wall.back(), 3) << " secs" << endl;
+  }
+
+  m_mismatch_iters = 0;
+  m_checked_iters  = 0;
+  m_unstable_iters = 0;
+  for(unsigned int i=0; i<iters; i++) {
+    if(m_match[i] >= 0)
+      m_checked_iters++;
+    if(m_match[i] == 0)
+      m_mismatch_iters++;
+    if(m_unstable[i])
+      m_unstable_iters++;
+  }
+  return(true);
+}
+
+//-----------------------------------------------------------
+// Procedure: runOnce()
+
+bool HelmReplay::runOnce(unsigned int rep)
+{
+  if(!initHelm()) {
+    for(unsigned int i=0; i<m_warnings.size(); i++)
+      cout << "  " << m_warnings[i] << endl;
+    return(false);
+  }
+
+  unsigned int next = 0;
+  double wall_start = BuildTally::now();
+  for(unsigned int ix=0; ix<m_iter_start.size(); ix++) {
+    unsigned int start = m_iter_start[ix];
+    double utc = m_log_start + m_entries[start].getTimeStamp();
+
+    m_curr_time = utc;
+    m_info_buffer->setCurrTime(utc);
+    if(m_bhv_set->getTCount() != m_info_vars_tcount) {
+      m_info_vars_tcount = m_bhv_set->getTCount();
+      vector<string> info_vars = m_bhv_set->getInfoVars();
+      m_info_vars.insert(info_vars.begin(), info_vars.end());
+    }
+    for(; next<start; next++)
+      applyMail(m_entries[next]);
+
+    HelmReport report = iterateHelm(utc);
+
+    HelmProfile profile = m_hengine->getProfile();
+    double create_ms = profile.getCreateTime();
+    double solve_ms  = profile.getSolveTime();
+    if((rep == 0) || (create_ms < m_create_ms[ix]))
+      m_create_ms[ix] = create_ms;
+    if((rep == 0) || (solve_ms < m_solve_ms[ix]))
+      m_solve_ms[ix] = solve_ms;
+    m_pcs[ix] = 0;
+    for(unsigned int b=0; b<profile.size(); b++)
+      m_pcs[ix] += profile.getBehavior(b).pcs;
+
+    string spec = decisionSpec(report);
+    if(rep == 0) {
+      m_dec_spec[ix] = spec;
+      checkDecision(ix, report);
+    }
+    else if(spec != m_dec_spec[ix])
+      m_unstable[ix] = true;
+  }
+  m_rep_wall.push_back(BuildTally::now() - wall_start);
+
+  clearHelm();
+  return(true);
+}
+
+//-----------------------------------------------------------
+// Procedure: initHelm()
+//   Purpose: Build a fresh helm, following the start-up sequence
+//            of pHelmIvP.
+
+bool HelmReplay::initHelm()
+{
+  clearHelm();
+  m_warnings.clear();
+
+  m_curr_time        = m_start_utc;
+  m_init_vars_done   = false;
+  m_info_vars_tcount = 0;
+  m_info_vars.clear();
+
+  m_info_buffer = new InfoBuffer;
+  m_info_buffer->setCurrTime(m_start_utc);
+  m_info_buffer->setStartTime(m_start_utc);
+  m_info_buffer->setValue("COMMS_POLICY", "open");
+  m_ledger_snap = new LedgerSnap;
+
+  m_ledger = ContactLedger();
+  m_ledger.setCurrTimeUTC(m_start_utc);
+  m_ledger.setStaleThresh(10);
+  m_pmgen = PlatModelGenerator();
+
+  if(m_bhv_file == "") {
+    m_warnings.push_back("No behavior file given");
+    return(false);
+  }
+
+  m_hengine = new HelmEngine(m_ivp_domain, m_info_buffer, m_ledger_snap);
+
+  Populator_BehaviorSet populator(m_ivp_domain, m_info_buffer,
+				  m_ledger_snap);
+  populator.setOwnship(m_vname);
+  for(unsigned int i=0; i<m_bhv_dirs.size(); i++)
+    populator.addBehaviorDir(m_bhv_dirs[i]);
+
+  set<string> bhv_files;
+  bhv_files.insert(m_bhv_file);
+  m_bhv_set = populator.populate(bhv_files);
+
+  vector<string> config_warnings = populator.getConfigWarnings();
+  m_warnings.insert(m_warnings.end(), config_warnings.begin(),
+		    config_warnings.end());
+
+  if(!m_bhv_set) {
+    m_warnings.push_back("NULL behavior set from " + m_bhv_file);
+    return(false);
+  }
+  m_hengine->setBehaviorSet(m_bhv_set);
+
+  for(unsigned int i=0; i<m_bhv_set->size(); i++) {
+    m_bhv_set->getBehavior(i)->IvPBehavior::setParam("us", m_vname);
+    m_bhv_set->getBehavior(i)->onSetParamComplete();
+  }
+
+  vector<string> update_vars = m_bhv_set->getSpecUpdateVars();
+  m_info_vars.insert(update_vars.begin(), update_vars.end());
+
+  // Registered by pHelmIvP whether or not a behavior asks for them
+  m_info_vars.insert("NAV_X");
+  m_info_vars.insert("NAV_Y");
+  m_info_vars.insert("NAV_SPEED");
+  m_info_vars.insert("NAV_HEADING");
+  m_info_vars.insert("NAV_DEPTH");
+
+  vector<VarDataPair> init_vars = m_bhv_set->getInitialVariables();
+  for(unsigned int i=0; i<init_vars.size(); i++) {
+    VarDataPair msg = init_vars[i];
+    string var = stripBlankEnds(msg.get_var());
+    if(strContainsWhite(var) || (tolower(msg.get_key()) != "post"))
+      continue;
+    string sdata = stripBlankEnds(msg.get_sdata());
+    if(sdata != "")
+      m_info_buffer->setValue(var, sdata);
+    else
+      m_info_buffer->setValue(var, msg.get_ddata());
+  }
+
+  vector<VarDataPair> start_msgs = m_bhv_set->getHelmStartMessages();
+  for(unsigned int i=0; i<start_msgs.size(); i++) {
+    VarDataPair msg = start_msgs[i];
+    string var = stripBlankEnds(msg.get_var());
+    if(strContainsWhite(var))
+      continue;
+    string sdata = stripBlankEnds(msg.get_sdata());
+    if(sdata != "")
+      m_info_buffer->setValue(var, sdata);
+    else
+      m_info_buffer->setValue(var, msg.get_ddata());
+  }
+  return(true);
+}
+
+//-----------------------------------------------------------
+// Procedure: clearHelm()
+
+void HelmReplay::clearHelm()
+{
+  delete(m_hengine);
+  delete(m_bhv_set);
+  delete(m_info_buffer);
+  delete(m_ledger_snap);
+
+  m_hengine     = 0;
+  m_bhv_set     = 0;
+  m_info_buffer = 0;
+  m_ledger_snap = 0;
+}
+
+//-----------------------------------------------------------
+// Procedure: applyMail()
+//   Purpose: Deliver one logged posting as HelmIvP::OnNewMail()
+//            would have, if the helm was registered for it. The
+//            helm's own postings are delivered too, as they were
+//            to the running helm.
+
+void HelmReplay::applyMail(const ALogEntry& entry)
+{
+  if(entry.getSrcAux() == "HELM_VAR_INIT")
+    return;
+
+  string var = entry.getVarName();
+  double msg_time = m_log_start + entry.getTimeStamp();
+
+  if(var == "NODE_REPORT_LOCAL") {
+    processNodeReportLocal(entry.getStringVal());
+    return;
+  }
+  if(var == "NODE_REPORT") {
+    string whynot;
+    string vname = m_ledger.processNodeReport(entry.getStringVal(), whynot);
+    if(vname != "") {
+      string uvname = toupper(vname);
+      m_info_buffer->setValue(uvname+"_NAV_GROUP", m_ledger.getGroup(vname));
+      m_info_buffer->setValue(uvname+"_NAV_TYPE", m_ledger.getType(vname));
+    }
+  }
+
+  if(m_info_vars.count(var) == 0)
+    return;
+
+  if(entry.isNumerical())
+    m_info_buffer->setValue(var, entry.getDoubleVal(), msg_time);
+  else
+    m_info_buffer->setValue(var, entry.getStringVal(), msg_time);
+}
+
+//-----------------------------------------------------------
+// Procedure: processNodeReportLocal()
+
+void HelmReplay::processNodeReportLocal(const string& report)
+{
+  NodeRecord record = string2NodeRecord(report);
+  string upp_vname = toupper(record.getName());
+  if(upp_vname == "")
+    return;
+
+  if(record.getGroup() != "")
+    m_info_buffer->setValue(upp_vname+"_NAV_GROUP", record.getGroup());
+  if(record.getType() != "")
+    m_info_buffer->setValue(upp_vname+"_NAV_TYPE", record.getType());
+  if(record.getColor() != "")
+    m_info_buffer->setValue(upp_vname+"_NAV_COLOR", record.getColor());
+  if(record.getLength() != 0)
+    m_info_buffer->setValue(upp_vname+"_NAV_LENGTH", record.getLength());
+}
+
+//-----------------------------------------------------------
+// Procedure: iterateHelm()
+//   Purpose: One helm iteration, the decision portion of
+//            HelmIvP::Iterate(). Postings go only to the
+//            info_buffer, as there is no MOOSDB to receive them.
+
+HelmReport HelmReplay::iterateHelm(double utc)
+{
+  if(!m_init_vars_done)
+    handleInitialVars();
+
+  m_ledger.setCurrTimeUTC(utc);
+  vector<string> keep_vnames = m_bhv_set->getContactNames();
+  m_ledger.clearStaleNodes(keep_vnames);
+  m_ledger.extrapolate();
+  updateLedgerSnap();
+  updatePlatModel();
+
+  HelmReport report = m_hengine->determineNextDecision(m_bhv_set, utc);
+
+  postBehaviorMessages();
+  if(m_bhv_set->getLifeEvents().size() > 0)
+    m_bhv_set->clearLifeEvents();
+  postDefaultVariables();
+
+  m_bhv_set->refreshMapUpdateVars();
+  m_info_buffer->clearDeltaVectors();
+  return(report);
+}
+
+//-----------------------------------------------------------
+// Procedure: handleInitialVars()
+//   Purpose: Apply deferred initial variables not otherwise set
+//            before the first helm iteration.
+
+void HelmReplay::handleInitialVars()
+{
+  m_init_vars_done = true;
+  vector<VarDataPair> mvector = m_bhv_set->getInitialVariables();
+  for(unsigned int i=0; i<mvector.size(); i++) {
+    VarDataPair msg = mvector[i];
+    string var   = stripBlankEnds(msg.get_var());
+    string sdata = stripBlankEnds(msg.get_sdata());
+    if((tolower(msg.get_key()) != "defer") || m_info_buffer->isKnown(var))
+      continue;
+    if(sdata != "")
+      m_info_buffer->setValue(var, sdata);
+    else
+      m_info_buffer->setValue(var, msg.get_ddata());
+  }
+}
+
+//-----------------------------------------------------------
+// Procedure: updateLedgerSnap()
+
+void HelmReplay::updateLedgerSnap()
+{
+  m_ledger_snap->clear();
+
+  vector<string> vnames = m_ledger.getVNames();
+  for(unsigned int i=0; i<vnames.size(); i++) {
+    string v = vnames[i];
+    m_ledger_snap->setX(v, m_ledger.getX(v));
+    m_ledger_snap->setY(v, m_ledger.getY(v));
+    m_ledger_snap->setHdg(v, m_ledger.getHeading(v));
+    m_ledger_snap->setSpd(v, m_ledger.getSpeed(v));
+    m_ledger_snap->setDep(v, m_ledger.getDepth(v));
+    m_ledger_snap->setLat(v, m_ledger.getLat(v));
+    m_ledger_snap->setLon(v, m_ledger.getLon(v));
+    m_ledger_snap->setUTC(v, m_ledger.getUTC(v));
+    m_ledger_snap->setUTCAge(v, m_ledger.getUTCAge(v));
+    m_ledger_snap->setUTCReceived(v, m_ledger.getUTCReceived(v));
+    m_ledger_snap->setUTCAgeReceived(v, m_ledger.getUTCAgeReceived(v));
+  }
+  m_ledger_snap->setCurrTimeUTC(m_curr_time);
+}
+
+//-----------------------------------------------------------
+// Procedure: updatePlatModel()
+
+void HelmReplay::updatePlatModel()
+{
+  bool ok1, ok2, ok3, ok4;
+  double osx = m_info_buffer->dQuery("NAV_X", ok1);
+  double osy = m_info_buffer->dQuery("NAV_Y", ok2);
+  double osh = m_info_buffer->dQuery("NAV_HEADING", ok3);
+  double osv = m_info_buffer->dQuery("NAV_SPEED", ok4);
+  if(!ok1 || !ok2 || !ok3 || !ok4)
+    return;
+
+  m_pmgen.setCurrTime(m_curr_time);
+  m_hengine->setPlatModel(m_pmgen.generate(osx, osy, osh, osv));
+}
+
+//-----------------------------------------------------------
+// Procedure: postBehaviorMessages()
+
+void HelmReplay::postBehaviorMessages()
+{
+  m_bhv_set->clearWarnings();
+  for(unsigned int i=0; i<m_bhv_set->size(); i++) {
+    vector<VarDataPair> mvector = m_bhv_set->getMessages(i);
+    for(unsigned int j=0; j<mvector.size(); j++) {
+      VarDataPair msg = mvector[j];
+      if(msg.get_var() == "BHV_IPF")
+	continue;
+      if(msg.is_string())
+	m_info_buffer->setValue(msg.get_var(), msg.get_sdata());
+      else
+	m_info_buffer->setValue(msg.get_var(), msg.get_ddata());
+    }
+  }
+  m_bhv_set->updateStateSpaceVars();
+  m_bhv_set->removeCompletedBehaviors();
+}
+
+//-----------------------------------------------------------
+// Procedure: postDefaultVariables()
+//   Purpose: Post default values for any variables not written by
+//            a behavior on this iteration.
+
+void HelmReplay::postDefaultVariables()
+{
+  set<string> message_vars;
+  for(unsigned int i=0; i<m_bhv_set->size(); i++) {
+    vector<VarDataPair> mvector = m_bhv_set->getMessages(i, false);
+    for(unsigned int j=0; j<mvector.size(); j++)
+      message_vars.insert(mvector[j].get_var());
+  }
+
+  vector<VarDataPair> dvector = m_bhv_set->getDefaultVariables();
+  for(unsigned int j=0; j<dvector.size(); j++) {
+    VarDataPair msg = dvector[j];
+    if(message_vars.count(msg.get_var()))
+      continue;
+    if(msg.is_string())
+      m_info_buffer->setValue(msg.get_var(), msg.get_sdata());
+    else
+      m_info_buffer->setValue(msg.get_var(), msg.get_ddata());
+  }
+}
+
+//-----------------------------------------------------------
+// Procedure: checkDecision()
+//   Purpose: Compare the replayed decision against the DESIRED_*
+//            values the helm logged on the same iteration. When
+//            the replayed helm has no decision for a variable it
+//            would have posted zero, as on an all-stop. Iterations
+//            on which the helm logged no decision are not checked.
+
+void HelmReplay::checkDecision(unsigned int ix, const HelmReport& report)
+{
+  unsigned int end = m_entries.size();
+  if((ix+1) < m_iter_start.size())
+    end = m_iter_start[ix+1];
+
+  bool   checked = false;
+  bool   matched = true;
+  string note;
+  for(unsigned int i=m_iter_post[ix]+1; i<end; i++) {
+    const ALogEntry& entry = m_entries[i];
+    if(!entry.isNumerical() || !isHelmEntry(entry))
+      continue;
+    string var = entry.getVarName();
+    for(unsigned int j=0; j<m_ivp_domain.size(); j++) {
+      string domain_var = m_ivp_domain.getVarName(j);
+      string post_alias = "DESIRED_" + toupper(domain_var);
+      if(post_alias == "DESIRED_COURSE")
+	post_alias = "DESIRED_HEADING";
+      if(!strEnds(var, post_alias))
+	continue;
+
+      double logged = entry.getDoubleVal();
+      double replay = 0;
+      if(report.hasDecision(domain_var))
+	replay = report.getDecision(domain_var);
+
+      double diff = fabs(replay - logged);
+      if(post_alias == "DESIRED_HEADING")
+	diff = angleDiff(replay, logged);
+
+      checked = true;
+      if(diff > m_tolerance) {
+	matched = false;
+	if(note != "")
+	  note += ", ";
+	note += var + "=" + doubleToStringX(logged, 4);
+	note += " (replay=" + doubleToStringX(replay, 4) + ")";
+      }
+    }
+  }
+
+  if(checked)
+    m_match[ix] = matched ? 1 : 0;
+  m_match_note[ix] = note;
+}
+
+//-----------------------------------------------------------
+// Procedure: decisionSpec()
+
+string HelmReplay::decisionSpec(const HelmReport& report) const
+{
+  string spec;
+  for(unsigned int j=0; j<m_ivp_domain.size(); j++) {
+    string domain_var = m_ivp_domain.getVarName(j);
+    spec += domain_var + "=";
+    if(report.hasDecision(domain_var))
+      spec += doubleToString(report.getDecision(domain_var), 9);
+    spec += ",";
+  }
+  return(spec);
+}
+
+//-----------------------------------------------------------
+// Procedure: printReport()
+
+void HelmReplay::printReport() const
+{
+  unsigned int iters = m_iter_start.size();
+  if((iters == 0) || (m_rep_wall.size() == 0))
+    return;
+
+  vector<double> create_ms = m_create_ms;
+  vector<double> solve_ms  = m_solve_ms;
+  sort(create_ms.begin(), create_ms.end());
+  sort(solve_ms.begin(), solve_ms.end());
+
+  double create_total = 0;
+  double solve_total  = 0;
+  unsigned int pcs_total = 0;
+  unsigned int pcs_max   = 0;
+  for(unsigned int i=0; i<iters; i++) {
+    create_total += m_create_ms[i];
+    solve_total  += m_solve_ms[i];
+    pcs_total    += m_pcs[i];
+    if(m_pcs[i] > pcs_max)
+      pcs_max = m_pcs[i];
+  }
+
+  double wall = *min_element(m_rep_wall.begin(), m_rep_wall.end());
+  double rate = 0;
+  if(wall > 0)
+    rate = (double)(iters) / wall;
+
+  cout << "alogreplay: " << m_alog_file << endl;
+  cout << "  Vehicle:  " << m_vname << endl;
+  cout << "  Behaviors: " << m_bhv_file << endl;
+  cout << "  Domain:   " << domainToString(m_ivp_domain) << endl;
+  cout << "  Helm iterations: " << iters;
+  cout << "  (" << m_reps << " reps)" << endl;
+  cout << "  Wall time: " << doubleToString(wall, 3) << " secs, ";
+  cout << doubleToString(rate, 1) << " iterations/sec" << endl;
+
+  cout << "  Create (ms): mean=" << doubleToString(create_total/iters, 3);
+  cout << " p50=" << doubleToString(percentile(create_ms, 50), 3);
+  cout << " p99=" << doubleToString(percentile(create_ms, 99), 3);
+  cout << " max=" << doubleToString(create_ms.back(), 3) << endl;
+
+  cout << "  Solve  (ms): mean=" << doubleToString(solve_total/iters, 3);
+  cout << " p50=" << doubleToString(percentile(solve_ms, 50), 3);
+  cout << " p99=" << doubleToString(percentile(solve_ms, 99), 3);
+  cout << " max=" << doubleToString(solve_ms.back(), 3) << endl;
+
+  cout << "  Pieces:      mean=";
+  cout << doubleToString((double)(pcs_total)/iters, 1);
+  cout << " max=" << pcs_max << endl;
+
+  cout << "  Decisions checked: " << m_checked_iters;
+  cout << ", mismatched: " << m_mismatch_iters;
+  cout << " (tolerance " << doubleToStringX(m_tolerance, 6) << ")" << endl;
+  if(m_reps > 1)
+    cout << "  Decisions differing across reps: " << m_unstable_iters << endl;
+
+  if(!m_verbose)
+    return;
+
+  for(unsigned int i=0; i<iters; i++) {
+    if(m_match[i] == 0)
+      cout << "  Mismatch on iter " << m_iter_logged[i] << ": " <<
+	m_match_note[i] << endl;
+    if(m_unstable[i])
+      cout << "  Unstable on iter " << m_iter_logged[i] << ": " <<
+	m_dec_spec[i] << endl;
+  }
+}
+
+//-----------------------------------------------------------
+// Procedure: writeCSV()
+//   Purpose: One line per helm iteration, for plotting or for
+//            comparison against the run of another build.
+
+bool HelmReplay::writeCSV(string filename) const
+{
+  FILE *f = fopen(filename.c_str(), "w");
+  if(!f) {
+    cout << "Unable to open csv file: " << filename << endl;
+    return(false);
+  }
+
+  fprintf(f, "iter,time,create_ms,solve_ms,pcs,match\n");
+  for(unsigned int i=0; i<m_iter_start.size(); i++) {
+    double tstamp = m_entries[m_iter_start[i]].getTimeStamp();
+    fprintf(f, "%u,%.3f,%.4f,%.4f,%u,%d\n", m_iter_logged[i], tstamp,
+	    m_create_ms[i], m_solve_ms[i], m_pcs[i], m_match[i]);
+  }
+  fclose(f);
+  return(true);
+}
@@ -0,0 +1,142 @@
+/*****************************************************************/
+/*    NAME: agent                                                */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: HelmReplay.h                                         */
+/*    DATE: Oct 19th, 2026                                       */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#ifndef ALOG_HELM_REPLAY_HEADER
+#define ALOG_HELM_REPLAY_HEADER
+
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include "IvPDomain.h"
+#include "InfoBuffer.h"
+#include "LedgerSnap.h"
+#include "ContactLedger.h"
+#include "BehaviorSet.h"
+#include "HelmEngine.h"
+#include "PlatModelGenerator.h"
+#include "ALogEntry.h"
+
+// Re-runs the helm of a logged mission with no MOOSDB. The alog is
+// read into memory, cut into the helm's logged iterations, and the
+// mail of each iteration is applied to a fresh InfoBuffer before
+// the behavior set and HelmEngine are iterated, as fast as they
+// will go. The decisions reached are checked against the DESIRED_*
+// postings the helm logged on the same iteration.
+
+class HelmReplay
+{
+ public:
+  HelmReplay();
+  ~HelmReplay() {clearHelm();}
+
+  bool readALog(std::string alog_file);
+
+  void setBhvFile(std::string s)    {m_bhv_file=s;}
+  void addBhvDir(std::string s)     {m_bhv_dirs.push_back(s);}
+  bool addDomain(std::string);
+  void setVName(std::string s)      {m_vname=s;}
+  void setHelmApp(std::string s)    {m_helm_app=s;}
+  void setTolerance(double v)       {m_tolerance=v;}
+  void setReps(unsigned int v)      {m_reps=(v>0)?v:1;}
+  void setVerbose(bool v=true)      {m_verbose=v;}
+
+  bool run();
+  void printReport() const;
+  bool writeCSV(std::string filename) const;
+
+  unsigned int getMismatches() const {return(m_mismatch_iters);}
+
+ protected: // Preparing the log
+  void findIterations();
+  void findVName();
+  bool isHelmEntry(const ALogEntry&) const;
+
+ protected: // One replay of the whole log
+  bool runOnce(unsigned int rep);
+  bool initHelm();
+  void clearHelm();
+  void applyMail(const ALogEntry&);
+  void processNodeReportLocal(const std::string&);
+  HelmReport iterateHelm(double utc);
+  void handleInitialVars();
+  void updateLedgerSnap();
+  void updatePlatModel();
+  void postBehaviorMessages();
+  void postDefaultVariables();
+  void checkDecision(unsigned int ix, const HelmReport&);
+  std::string decisionSpec(const HelmReport&) const;
+
+ protected: // Configuration variables
+  std::string              m_bhv_file;
+  std::vector<std::string> m_bhv_dirs;
+  std::string              m_vname;
+  std::string              m_helm_app;
+  IvPDomain                m_ivp_domain;
+  double                   m_tolerance;
+  unsigned int             m_reps;
+  bool                     m_verbose;
+
+ protected: // The log
+  std::string            m_alog_file;
+  double                 m_log_start;
+  double                 m_start_utc;
+  std::vector<ALogEntry> m_entries;
+
+  // Per logged helm iteration, the entry index at which it began
+  // (mail before it was applied) and that of its IVPHELM_ITER post.
+  std::vector<unsigned int> m_iter_start;
+  std::vector<unsigned int> m_iter_post;
+  std::vector<unsigned int> m_iter_logged;
+
+ protected: // The helm of the current replay
+  InfoBuffer*        m_info_buffer;
+  LedgerSnap*        m_ledger_snap;
+  ContactLedger      m_ledger;
+  HelmEngine*        m_hengine;
+  BehaviorSet*       m_bhv_set;
+  PlatModelGenerator m_pmgen;
+
+  double                m_curr_time;
+  bool                  m_init_vars_done;
+  std::set<std::string> m_info_vars;
+  unsigned int          m_info_vars_tcount;
+
+ protected: // Results, per logged helm iteration
+  std::vector<double>       m_create_ms;
+  std::vector<double>       m_solve_ms;
+  std::vector<unsigned int> m_pcs;
+  std::vector<int>          m_match;   // -1 unchecked, 0 no, 1 yes
+  std::vector<std::string>  m_match_note;
+  std::vector<std::string>  m_dec_spec;
+  std::vector<bool>         m_unstable;
+
+  std::vector<double> m_rep_wall;
+  unsigned int        m_mismatch_iters;
+  unsigned int        m_checked_iters;
+  unsigned int        m_unstable_iters;
+
+  std::vector<std::string> m_warnings;
+};
+
+#endif
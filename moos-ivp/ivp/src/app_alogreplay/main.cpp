@@ -0,0 +1,142 @@
+/*****************************************************************/
+/*    NAME: agent                                                */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: main.cpp                                             */
+/*    DATE: Oct 19th, 2026                                       */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#include <string>
+#include <cstdlib>
+#include <iostream>
+#include "MBUtils.h"
+#include "ReleaseInfo.h"
+#include "HelmReplay.h"
+
+using namespace std;
+
+//--------------------------------------------------------
+// Procedure: main
+
+int main(int argc, char *argv[])
+{
+  // Look for a request for version information
+  if(scanArgs(argc, argv, "-v", "--version", "-version")) {
+    showReleaseInfo("alogreplay", "gpl");
+    return(0);
+  }
+
+  // Look for a request for usage information
+  if(scanArgs(argc, argv, "-h", "--help", "-help")) {
+    cout << "Usage: " << endl;
+    cout << "  alogreplay file.alog file.bhv [OPTIONS]                  " << endl;
+    cout << "                                                           " << endl;
+    cout << "Synopsis:                                                  " << endl;
+    cout << "  Replay the helm of a logged mission with no MOOSDB. The  " << endl;
+    cout << "  mail the helm had in hand on each of its logged          " << endl;
+    cout << "  iterations is applied from the alog, and the behaviors   " << endl;
+    cout << "  of the given .bhv file are run and solved as fast as they" << endl;
+    cout << "  will go. The create and solve time of each iteration is  " << endl;
+    cout << "  reported, and each decision is checked against the      " << endl;
+    cout << "  DESIRED_* values the helm logged. For use as a benchmark " << endl;
+    cout << "  of helm performance across builds on the same mission.  " << endl;
+    cout << "                                                           " << endl;
+    cout << "Options:                                                   " << endl;
+    cout << "  -h,--help        Displays this help message              " << endl;
+    cout << "  -v,--version     Displays the current release version    " << endl;
+    cout << "  --domain=<dom>   Add a decision domain, e.g.             " << endl;
+    cout << "                   course:0:359:360 (default is the domain " << endl;
+    cout << "                   the helm logged in IVPHELM_DOMAIN)      " << endl;
+    cout << "  --bhv_dir=<dir>  Directory of dynamically loaded         " << endl;
+    cout << "                   behaviors (may be given more than once) " << endl;
+    cout << "  --vname=<name>   Name of ownship (default is the name in " << endl;
+    cout << "                   the first NODE_REPORT_LOCAL)            " << endl;
+    cout << "  --helm=<app>     Name of the logged helm (default is     " << endl;
+    cout << "                   pHelmIvP)                               " << endl;
+    cout << "  --tol=<val>      Allowed difference from the logged      " << endl;
+    cout << "                   decision (default 0.001)                " << endl;
+    cout << "  --reps=<N>       Replay the log N times, keeping the     " << endl;
+    cout << "                   fastest time of each iteration          " << endl;
+    cout << "  --csv=<file>     Write per-iteration timings to file     " << endl;
+    cout << "  --verbose        List each mismatched decision           " << endl;
+    cout << "                                                           " << endl;
+    cout << "Further Notes:                                             " << endl;
+    cout << "  (1) Behavior files must be already expanded by nsplug.   " << endl;
+    cout << "  (2) Returns 0 if all checked decisions match, 1 if not.  " << endl;
+    cout << "  (3) Mail arriving while the helm iterated is applied on  " << endl;
+    cout << "      the following iteration, so decisions close to a    " << endl;
+    cout << "      mode change may differ from those logged.            " << endl;
+    cout << endl;
+    return(0);
+  }
+
+  HelmReplay replay;
+
+  string alog_file;
+  string bhv_file;
+  string csv_file;
+
+  for(int i=1; i<argc; i++) {
+    string argi = argv[i];
+    bool handled = true;
+    if(strBegins(argi, "--domain="))
+      handled = replay.addDomain(argi.substr(9));
+    else if(strBegins(argi, "--bhv_dir="))
+      replay.addBhvDir(argi.substr(10));
+    else if(strBegins(argi, "--vname="))
+      replay.setVName(argi.substr(8));
+    else if(strBegins(argi, "--helm="))
+      replay.setHelmApp(argi.substr(7));
+    else if(strBegins(argi, "--tol=") && isNumber(argi.substr(6)))
+      replay.setTolerance(atof(argi.substr(6).c_str()));
+    else if(strBegins(argi, "--reps=") && isNumber(argi.substr(7)))
+      replay.setReps(atoi(argi.substr(7).c_str()));
+    else if(strBegins(argi, "--csv="))
+      csv_file = argi.substr(6);
+    else if(argi == "--verbose")
+      replay.setVerbose();
+    else if(strEnds(argi, ".alog") && (alog_file == ""))
+      alog_file = argi;
+    else if(strEnds(argi, ".bhv") && (bhv_file == ""))
+      bhv_file = argi;
+    else
+      handled = false;
+
+    if(!handled) {
+      cout << "Unhandled argument: " << argi << endl;
+      return(1);
+    }
+  }
+
+  if((alog_file == "") || (bhv_file == "")) {
+    cout << "An alog file and a bhv file must be given - exiting" << endl;
+    return(1);
+  }
+
+  replay.setBhvFile(bhv_file);
+  if(!replay.readALog(alog_file))
+    return(1);
+  if(!replay.run())
+    return(1);
+
+  replay.printReport();
+  if(csv_file != "")
+    replay.writeCSV(csv_file);
+
+  return((replay.getMismatches() == 0) ? 0 : 1);
+}
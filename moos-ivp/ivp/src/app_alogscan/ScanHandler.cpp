@@ -28,6 +28,9 @@
 #include "ALogScanner.h"
 #include "ScanHandler.h"
 #include "ColorParse.h"
+#include "ALogBatch.h"
+#include "ACTable.h"
+#include "MBTimer.h"
 
 using namespace std;
 
@@ -51,6 +54,9 @@ ScanHandler::ScanHandler()
 
   m_use_colors = true;
   m_use_full_source = true;
+
+  m_batch_threads   = 0;
+  m_batch_wall_time = 0;
 }
 
 //--------------------------------------------------------
@@ -128,6 +134,72 @@ bool ScanHandler::handle(const string& alogfile, bool rate_only)
 }
 
 
+//--------------------------------------------------------
+// Procedure: handleBatch()
+//   Purpose: Scan several alog files in parallel, one scanner per
+//            file, and merge the results into one fleet report.
+//      Note: Reports are merged in file order after all scans are
+//            done so the output is the same for any thread count.
+
+bool ScanHandler::handleBatch(const vector<string>& alogfiles,
+			      bool rate_only, unsigned int threads)
+{
+  unsigned int total = alogfiles.size();
+  if(total == 0) {
+    cout << "No alog files found - Exiting." << endl;
+    return(false);
+  }
+
+  m_batch_files   = alogfiles;
+  m_batch_reports = vector<ScanReport>(total);
+  m_batch_ok      = vector<int>(total, 0);
+  m_batch_threads = batchThreadCount(threads, total);
+
+  cout << "Scanning " << total << " alog files on " << m_batch_threads;
+  cout << " thread(s)... " << flush;
+
+  MBTimer timer;
+  timer.start();
+
+  bool use_full_source = m_use_full_source;
+  runALogBatch(total, m_batch_threads, [&](unsigned int ix) {
+    ALogScanner scanner;
+    scanner.setUseFullSource(use_full_source);
+    scanner.setVerbose(false);
+    if(!scanner.openALogFile(alogfiles[ix]))
+      return;
+    if(rate_only)
+      m_batch_reports[ix] = scanner.scanRateOnly();
+    else
+      m_batch_reports[ix] = scanner.scan();
+    m_batch_ok[ix] = 1;
+  }, alogfiles);
+
+  timer.stop();
+  m_batch_wall_time = timer.get_float_wall_time();
+  cout << "done (" << doubleToString(m_batch_wall_time, 2) << " secs)" << endl;
+
+  m_report = ScanReport();
+  unsigned int ok_count = 0;
+  for(unsigned int i=0; i<total; i++) {
+    if(!m_batch_ok[i]) {
+      cout << "Unable to find or open " << alogfiles[i] << endl;
+      continue;
+    }
+    m_report.merge(m_batch_reports[i]);
+    ok_count++;
+  }
+
+  if(ok_count == 0)
+    return(false);
+  if(!rate_only && (m_report.size() == 0)) {
+    cout << "Empty log files - exiting." << endl;
+    return(false);
+  }
+  return(true);
+}
+
+
 //--------------------------------------------------------
 // Procedure: varStatReport()
 
@@ -299,6 +371,53 @@ void ScanHandler::appStatReport()
   }  
 }
 
+//--------------------------------------------------------
+// Procedure: fleetReport
+//     Notes: One line per alog file in a batch, followed by the
+//            fleet-wide totals.
+
+void ScanHandler::fleetReport()
+{
+  unsigned int total = m_batch_files.size();
+  if(total == 0)
+    return;
+
+  ACTable actab(7,2);
+  actab << "ALog File | Lines | Chars | Vars | Start | Stop | Rate (K/sec)";
+  actab.addHeaderLines();
+
+  for(unsigned int i=0; i<total; i++) {
+    string file = m_batch_files[i];
+    if(!m_batch_ok[i]) {
+      actab << file << "-" << "-" << "-" << "-" << "-" << "unreadable";
+      continue;
+    }
+    ScanReport& report = m_batch_reports[i];
+    actab << file;
+    actab << uintToCommaString(report.getTotalLines());
+    actab << uintToCommaString((unsigned int)(report.getTotalChars()));
+    actab << report.size();
+    actab << doubleToString(report.getTimeMin(), 2);
+    actab << doubleToString(report.getTimeMax(), 2);
+    actab << doubleToString(report.getDataRate()/1000, 2);
+  }
+  actab.addHeaderLines();
+  actab << "Fleet (" + uintToString(total) + " files)";
+  actab << uintToCommaString(m_report.getTotalLines());
+  actab << uintToCommaString((unsigned int)(m_report.getTotalChars()));
+  actab << m_report.size();
+  actab << doubleToString(m_report.getTimeMin(), 2);
+  actab << doubleToString(m_report.getTimeMax(), 2);
+  actab << doubleToString(m_report.getDataRate()/1000, 2);
+
+  cout << endl;
+  vector<string> lines = actab.getTableOutput();
+  for(unsigned int i=0; i<lines.size(); i++)
+    cout << lines[i] << endl;
+  cout << "Threads: " << m_batch_threads << "  Wall time: ";
+  cout << doubleToString(m_batch_wall_time, 2) << " secs" << endl;
+}
+
 //--------------------------------------------------------
 // Procedure: loglistReport
 //     Notes: 
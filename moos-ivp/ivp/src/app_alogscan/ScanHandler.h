@@ -24,6 +24,8 @@
 #ifndef SCAN_HANDLER_HEADER
 #define SCAN_HANDLER_HEADER
 
+#include <vector>
+#include <string>
 #include "ScanReport.h"
 
 class ScanHandler
@@ -34,11 +36,14 @@ class ScanHandler
 
   bool setParam(const std::string&, const std::string&);
   bool handle(const std::string& alogfile, bool rate_only=false);
+  bool handleBatch(const std::vector<std::string>& alogfiles,
+		   bool rate_only=false, unsigned int threads=0);
 
   void varStatReport();
   void appStatReport();
   void dataRateReport();
   void loglistReport();
+  void fleetReport();
   
   std::string procColor(std::string proc_name);
 
@@ -47,6 +52,13 @@ class ScanHandler
   std::string m_sort_style;
 
   ScanReport  m_report;
+
+  // Per-file reports, kept in file order, when run in batch mode
+  std::vector<std::string> m_batch_files;
+  std::vector<ScanReport>  m_batch_reports;
+  std::vector<int>         m_batch_ok;
+  unsigned int             m_batch_threads;
+  double                   m_batch_wall_time;
   bool        m_use_colors;
   bool        m_use_full_source;
   
@@ -21,6 +21,7 @@
 /* <http://www.gnu.org/licenses/>.                               */
 /*****************************************************************/
 
+#include <vector>
 #include <string>
 #include <cstring>
 #include <cstdlib>
@@ -29,6 +30,7 @@
 #include "OpenURL.h"
 #include "ReleaseInfo.h"
 #include "ScanHandler.h"
+#include "ALogBatch.h"
 
 using namespace std;
 
@@ -49,6 +51,8 @@ int main(int argc, char *argv[])
   if(scanArgs(argc, argv, "-h", "--help", "-help")) {
     cout << "Usage:                                               " << endl;
     cout << "  alogscan file.alog [OPTIONS]                       " << endl;
+    cout << "  alogscan a.alog b.alog ... [OPTIONS]               " << endl;
+    cout << "  alogscan logdir/ [OPTIONS]                         " << endl;
     cout << "                                                     " << endl;
     cout << "Synopsis:                                            " << endl;
     cout << "  Generate a summary report on contents of a given   " << endl;
@@ -57,6 +61,11 @@ int main(int argc, char *argv[])
     cout << "  time and total number of character and lines for   " << endl;
     cout << "  the variable.                                      " << endl;
     cout << "                                                     " << endl;
+    cout << "  Given several files, a directory (searched for     " << endl;
+    cout << "  .alog files) or a quoted glob, the files are       " << endl;
+    cout << "  scanned in parallel and merged into one fleet      " << endl;
+    cout << "  report, with a per-file summary table.             " << endl;
+    cout << "                                                     " << endl;
     cout << "Options:                                             " << endl;
     cout << "  --sort=type   Sort by one of SIX criteria:         " << endl;
     cout << "                start: sort by first post of a var   " << endl;
@@ -74,6 +83,8 @@ int main(int argc, char *argv[])
     cout << "  -v,--version  Displays the current release version " << endl;
     cout << "  --rate_only   Only report the data rate            " << endl;
     cout << "  --noaux       Ignore auxilliary source info        " << endl;
+    cout << "  --threads=N   Threads for multi-file scans         " << endl;
+    cout << "                (Default is one per CPU core)        " << endl;
     cout << "                                                     " << endl;
     cout << "  --web,-w   Open browser to:                        " << endl;
     cout << "             https://oceanai.mit.edu/ivpman/apps/alogscan " << endl;
@@ -90,7 +101,9 @@ int main(int argc, char *argv[])
   string proc_colors        = "true";
   string sort_style         = "bysrc_ascending";
 
-  string alogfile = "";
+  unsigned int   threads = 0;
+  vector<string> alogfiles;
+  bool           batch = false;
   for(int i=1; i<argc; i++) {
     string orig = argv[i];
     string sarg = tolower(argv[i]);
@@ -102,8 +115,16 @@ int main(int argc, char *argv[])
 
     //cout << "sarg:[" << sarg << "]" << endl;
 
-    if(strContains(sarg, ".alog"))
-      alogfile = orig;
+    if(strBegins(sarg, "--threads=") && isNumber(sarg.substr(10)))
+      threads = (unsigned int)(atoi(sarg.substr(10).c_str()));
+    else if(strContains(sarg, ".alog") && !strContains(orig, '*') &&
+	    !strContains(orig, '?'))
+      alogfiles.push_back(orig);
+    else if(strContains(sarg, ".alog") || !strBegins(sarg, "-")) {
+      vector<string> files = expandALogFiles(orig);
+      alogfiles.insert(alogfiles.end(), files.begin(), files.end());
+      batch = true;
+    }
     else if((sarg == "-c") || (sarg == "--chars") || (sort == "chars"))
       sort_style = "bychars_ascending";
     else if((sarg == "-l") || (sarg == "--lines") || (sort == "lines"))
@@ -145,10 +166,12 @@ int main(int argc, char *argv[])
       sort_style = "bysrc_descending";
   }
 
-  if(alogfile == "") {
+  if(alogfiles.size() == 0) {
     cout << "No alog file given - exiting" << endl;
     exit(1);
   }
+  if(alogfiles.size() > 1)
+    batch = true;
 
   bool ok = true;
   ScanHandler handler;
@@ -157,7 +180,10 @@ int main(int argc, char *argv[])
   ok = ok && handler.setParam("use_full_source",
 			      boolToString(use_full_source));
 
-  ok = ok && handler.handle(alogfile, data_rate_only);
+  if(batch)
+    ok = ok && handler.handleBatch(alogfiles, data_rate_only, threads);
+  else
+    ok = ok && handler.handle(alogfiles[0], data_rate_only);
 
   if(!ok)
     return(1);
@@ -169,6 +195,8 @@ int main(int argc, char *argv[])
   handler.dataRateReport();
   if(loglist_requested) 
     handler.loglistReport();
+  if(batch)
+    handler.fleetReport();
 
   return(0);
 }
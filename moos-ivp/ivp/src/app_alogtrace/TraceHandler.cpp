@@ -0,0 +1,301 @@
+/*****************************************************************/
+/*    NAME: agent                                                */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: TraceHandler.cpp                                     */
+/*    DATE: Oct 19th, 2026                                       */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#include <iostream>
+#include <algorithm>
+#include <cstdio>
+#include "MBUtils.h"
+#include "ACTable.h"
+#include "LogUtils.h"
+#include "TraceHandler.h"
+
+using namespace std;
+
+//--------------------------------------------------------
+// Procedure: getStats()
+//      Note: Values are returned in milliseconds
+
+static void getStats(vector<double> vals, double& mean, double& p50,
+		     double& p90, double& vmax)
+{
+  mean = p50 = p90 = vmax = 0;
+  if(vals.size() == 0)
+    return;
+
+  sort(vals.begin(), vals.end());
+
+  double total = 0;
+  for(unsigned int i=0; i<vals.size(); i++)
+    total += vals[i];
+
+  unsigned int ix50 = (unsigned int)(0.5 * (vals.size()-1));
+  unsigned int ix90 = (unsigned int)(0.9 * (vals.size()-1));
+
+  mean = 1000 * (total / (double)(vals.size()));
+  p50  = 1000 * vals[ix50];
+  p90  = 1000 * vals[ix90];
+  vmax = 1000 * vals[vals.size()-1];
+}
+
+//--------------------------------------------------------
+// Constructor()
+
+TraceHandler::TraceHandler()
+{
+  m_verbose = false;
+  m_format_aligned = true;
+
+  m_traces_total    = 0;
+  m_traces_invalid  = 0;
+  m_negative_deltas = 0;
+}
+
+//--------------------------------------------------------
+// Procedure: addALogFile()
+
+bool TraceHandler::addALogFile(string alogfile)
+{
+  FILE *f = fopen(alogfile.c_str(), "r");
+  if(!f) {
+    cout << "Could not open " << alogfile << endl;
+    return(false);
+  }
+  fclose(f);
+  
+  m_alog_files.push_back(alogfile);
+  return(true);
+}
+
+//--------------------------------------------------------
+// Procedure: handle()
+
+bool TraceHandler::handle()
+{
+  if(m_alog_files.size() == 0) {
+    cout << "No alog file(s) given. Use --help for usage." << endl;
+    return(false);
+  }
+
+  for(unsigned int i=0; i<m_alog_files.size(); i++) {
+    if(!handleALogFile(m_alog_files[i]))
+      return(false);
+  }
+
+  if(m_traces_total == 0) {
+    cout << "No MSG_TRACE entries found. Is TRACE_REPORT=true set" << endl;
+    cout << "for the receiving apps?" << endl;
+    return(true);
+  }
+  
+  printHopReport();
+  printEndToEndReport();
+
+  cout << endl;
+  cout << "Traces: " << m_traces_total;
+  cout << ", Invalid: " << m_traces_invalid;
+  cout << ", Negative deltas: " << m_negative_deltas << endl;
+  if(m_negative_deltas > 0) {
+    cout << "  Negative deltas indicate clock skew between machines" << endl;
+    cout << "  on the message path (e.g. across pShare)." << endl;
+  }
+  return(true);
+}
+
+//--------------------------------------------------------
+// Procedure: handleALogFile()
+
+bool TraceHandler::handleALogFile(const string& alogfile)
+{
+  FILE *f = fopen(alogfile.c_str(), "r");
+  if(!f)
+    return(false);
+
+  if(m_verbose)
+    cout << "Processing " << alogfile << endl;
+  
+  bool done = false;
+  while(!done) {
+    ALogEntry entry = getNextRawALogEntry(f, true);
+    string status = entry.getStatus();
+    if(status == "eof")
+      done = true;
+    else if(status != "invalid") {
+      if(entry.getVarName() == "MSG_TRACE")
+	handleTrace(entry.getStringVal());
+    }
+  }
+
+  fclose(f);
+  return(true);
+}
+
+//--------------------------------------------------------
+// Procedure: handleTrace()
+//   Example: id=abe/uSimMarineV23/17,var=NAV_X,app=pHelmIvP,
+//            rx=1234.56,hops=pub:NAV_X@1234.50;dbrx:abe@1234.51;
+//            dbtx:abe@1234.53
+
+bool TraceHandler::handleTrace(const string& trace)
+{
+  string id, var, app, hops;
+  double rx_time = 0;
+
+  // The hops field is last and holds no commas, take it whole
+  string str = trace;
+  string front = biteString(str, ',');
+  while(front != "") {
+    string param = biteStringX(front, '=');
+    string value = front;
+    if(param == "id")
+      id = value;
+    else if(param == "var")
+      var = value;
+    else if(param == "app")
+      app = value;
+    else if(param == "rx")
+      rx_time = atof(value.c_str());
+    else if(param == "hops")
+      hops = value;
+    front = biteString(str, ',');
+  }
+
+  if((id == "") || (var == "") || (app == "") || (hops == "") ||
+     (rx_time <= 0)) {
+    m_traces_invalid++;
+    return(false);
+  }
+  if((m_var_filter != "") && (var != m_var_filter))
+    return(true);
+  
+  vector<string> hop_names;
+  vector<double> hop_times;
+  vector<string> svector = parseString(hops, ';');
+  for(unsigned int i=0; i<svector.size(); i++) {
+    string hop_name = biteStringX(svector[i], '@');
+    string hop_time = svector[i];
+    if((hop_name == "") || !isNumber(hop_time)) {
+      m_traces_invalid++;
+      return(false);
+    }
+    hop_names.push_back(hop_name);
+    hop_times.push_back(atof(hop_time.c_str()));
+  }
+
+  // The final hop is the receipt by the reporting app
+  hop_names.push_back("rx:" + app);
+  hop_times.push_back(rx_time);
+  
+  m_traces_total++;
+
+  for(unsigned int i=1; i<hop_names.size(); i++) {
+    double delta = hop_times[i] - hop_times[i-1];
+    if(delta < 0)
+      m_negative_deltas++;
+    string key = var + "," + hop_names[i-1] + "," + hop_names[i];
+    if(m_hop_samples.count(key) == 0)
+      m_hop_keys.push_back(key);
+    addSample(m_hop_samples, key, delta);
+  }
+
+  // The origin community/app is the front of the trace id
+  string origin = id;
+  rbiteString(origin, '/');
+  
+  double e2e = rx_time - hop_times[0];
+  addSample(m_e2e_samples, var + "," + origin + "," + app, e2e);
+  return(true);
+}
+
+//--------------------------------------------------------
+// Procedure: addSample()
+
+void TraceHandler::addSample(map<string, vector<double> >& samples,
+			     const string& key, double delta)
+{
+  samples[key].push_back(delta);
+}
+
+//--------------------------------------------------------
+// Procedure: printHopReport()
+
+void TraceHandler::printHopReport()
+{
+  cout << endl;
+  cout << "Per-Hop Latency (ms)" << endl;
+  cout << "====================" << endl;
+
+  ACTable actab(8,2);
+  actab << "Var | From | To | N | Mean | P50 | P90 | Max";
+  actab.addHeaderLines();
+
+  // Report hops in the order first seen, i.e., along the path
+  for(unsigned int i=0; i<m_hop_keys.size(); i++) {
+    vector<double>& samples = m_hop_samples[m_hop_keys[i]];
+    vector<string> keys = parseString(m_hop_keys[i], ',');
+    double mean, p50, p90, vmax;
+    getStats(samples, mean, p50, p90, vmax);
+    actab << keys[0] << keys[1] << keys[2] << (unsigned int)(samples.size());
+    actab << doubleToString(mean,3) << doubleToString(p50,3);
+    actab << doubleToString(p90,3)  << doubleToString(vmax,3);
+  }
+  
+  vector<string> lines = actab.getTableOutput();
+  for(unsigned int i=0; i<lines.size(); i++) {
+    if(m_format_aligned)
+      cout << lines[i] << endl;
+    else
+      cout << compactConsecutive(lines[i], ' ') << endl;
+  }
+}
+
+//--------------------------------------------------------
+// Procedure: printEndToEndReport()
+
+void TraceHandler::printEndToEndReport()
+{
+  cout << endl;
+  cout << "End-to-End Latency (ms)" << endl;
+  cout << "=======================" << endl;
+
+  ACTable actab(8,2);
+  actab << "Var | Origin | Receiver | N | Mean | P50 | P90 | Max";
+  actab.addHeaderLines();
+
+  map<string, vector<double> >::iterator p;
+  for(p=m_e2e_samples.begin(); p!=m_e2e_samples.end(); p++) {
+    vector<string> keys = parseString(p->first, ',');
+    double mean, p50, p90, vmax;
+    getStats(p->second, mean, p50, p90, vmax);
+    actab << keys[0] << keys[1] << keys[2] << (unsigned int)(p->second.size());
+    actab << doubleToString(mean,3) << doubleToString(p50,3);
+    actab << doubleToString(p90,3)  << doubleToString(vmax,3);
+  }
+  
+  vector<string> lines = actab.getTableOutput();
+  for(unsigned int i=0; i<lines.size(); i++) {
+    if(m_format_aligned)
+      cout << lines[i] << endl;
+    else
+      cout << compactConsecutive(lines[i], ' ') << endl;
+  }
+}
@@ -0,0 +1,73 @@
+/*****************************************************************/
+/*    NAME: agent                                                */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: TraceHandler.h                                       */
+/*    DATE: Oct 19th, 2026                                       */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#ifndef ALOG_TRACE_HANDLER_HEADER
+#define ALOG_TRACE_HANDLER_HEADER
+
+#include <string>
+#include <vector>
+#include <map>
+
+class TraceHandler
+{
+ public:
+  TraceHandler();
+  ~TraceHandler() {}
+
+  bool handle();
+
+  bool addALogFile(std::string);
+  void setVarFilter(std::string s) {m_var_filter=s;}
+  void setVerbose()                {m_verbose=true;}
+  void setFormatAligned(bool v)    {m_format_aligned=v;}
+
+ protected:
+  bool handleALogFile(const std::string& alogfile);
+  bool handleTrace(const std::string& trace);
+
+  void addSample(std::map<std::string, std::vector<double> >&,
+		 const std::string& key, double delta);
+
+  void printHopReport();
+  void printEndToEndReport();
+
+ protected: // Config vars
+  std::vector<std::string> m_alog_files;
+  std::string m_var_filter;
+  bool        m_verbose;
+  bool        m_format_aligned;
+
+ protected: // State vars
+  unsigned int m_traces_total;
+  unsigned int m_traces_invalid;
+  unsigned int m_negative_deltas;
+
+  // Per-hop latency samples (secs). Key is var,from_hop,to_hop
+  std::map<std::string, std::vector<double> > m_hop_samples;
+  std::vector<std::string> m_hop_keys;
+
+  // End-to-end latency samples (secs). Key is var,origin,receiver
+  std::map<std::string, std::vector<double> > m_e2e_samples;
+};
+
+#endif 
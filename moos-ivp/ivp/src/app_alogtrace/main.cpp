@@ -0,0 +1,128 @@
+/*****************************************************************/
+/*    NAME: agent                                                */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: main.cpp                                             */
+/*    DATE: Oct 19th, 2026                                       */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#include <string>
+#include <cstdlib>
+#include <iostream>
+#include "MBUtils.h"
+#include "ReleaseInfo.h"
+#include "TraceHandler.h"
+
+using namespace std;
+
+void showHelpAndExit();
+
+//--------------------------------------------------------
+// Procedure: main
+
+int main(int argc, char *argv[])
+{
+  TraceHandler handler;
+
+  for(int i=1; i<argc; i++) {
+    bool handled = true;
+    string argi = argv[i];
+    if((argi=="-h") || (argi == "--help") || (argi=="-help"))
+      showHelpAndExit();
+    else if((argi=="-v") || (argi=="--version") || (argi=="-version")) {
+      showReleaseInfo("alogtrace", "gpl");
+      return(0);
+    }
+    else if(argi=="--verbose")
+      handler.setVerbose();
+    else if(argi=="--noformat")
+      handler.setFormatAligned(false);
+    else if(strBegins(argi, "--var="))
+      handler.setVarFilter(argi.substr(6));
+    else if(strEnds(argi, ".alog"))
+      handled = handler.addALogFile(argi);
+    else
+      handled = false;
+
+    if(!handled) {
+      cout << "Unhandled command line argument: " << argi << endl;
+      cout << "Use --help for usage. Exiting.   " << endl;
+      exit(1);
+    }
+  }
+
+  bool ok = handler.handle();
+  if(ok)
+    return(0);
+  else
+    return(1);
+}
+  
+//------------------------------------------------------------
+// Procedure: showHelpAndExit()  
+
+void showHelpAndExit()
+{
+  cout << "Usage: " << endl;
+  cout << "  alogtrace file.alog [file2.alog ...] [OPTIONS]           " << endl;
+  cout << "                                                           " << endl;
+  cout << "Synopsis:                                                  " << endl;
+  cout << "  Reconstruct end-to-end message latency from MSG_TRACE    " << endl;
+  cout << "  entries in one or more alog files. A publishing app      " << endl;
+  cout << "  configured with TRACE_VARS tags a sample of its posts.   " << endl;
+  cout << "  Each MOOSDB, pShare and uFldNodeComms on the path stamps " << endl;
+  cout << "  a hop, and apps configured with TRACE_REPORT=true post   " << endl;
+  cout << "  MSG_TRACE on receipt. The latency of each hop and the    " << endl;
+  cout << "  end-to-end latency are reported per variable.            " << endl;
+  cout << "                                                           " << endl;
+  cout << "  Hops: pub   - posted by the originating app              " << endl;
+  cout << "        dbrx  - received by a MOOSDB                       " << endl;
+  cout << "        dbtx  - sent to a client by a MOOSDB               " << endl;
+  cout << "        shtx  - sent over the network by pShare            " << endl;
+  cout << "        shrx  - received from the network by pShare        " << endl;
+  cout << "        fwd   - forwarded by an app, e.g. uFldNodeComms    " << endl;
+  cout << "        rx    - received by the reporting app              " << endl;
+  cout << "                                                           " << endl;
+  cout << "Standard Arguments:                                        " << endl;
+  cout << "  file.alog - One or more input alog files. Hops crossing  " << endl;
+  cout << "     vehicles are only complete if the alog of the         " << endl;
+  cout << "     receiving vehicle is given.                           " << endl;
+  cout << "                                                           " << endl;
+  cout << "Options:                                                   " << endl;
+  cout << "  -h,--help         Displays this help message             " << endl;
+  cout << "  -v,--version      Displays the current release version   " << endl;
+  cout << "  --var=NAV_X       Only report on traces of NAV_X         " << endl;
+  cout << "  --noformat        Do not align column output             " << endl;
+  cout << "  --verbose         Show progress while reading files      " << endl;
+  cout << "                                                           " << endl;
+  cout << "Further Notes:                                             " << endl;
+  cout << "  (1) Order of arguments is irrelevant.                    " << endl;
+  cout << "  (2) Hops across machines are only as accurate as the     " << endl;
+  cout << "      clock sync between them. Negative deltas are counted " << endl;
+  cout << "      and reported.                                        " << endl;
+  cout << "  (3) Example mission config:                              " << endl;
+  cout << "        TRACE_SAMPLE = 10      // global, 1 in 10 posts    " << endl;
+  cout << "        ProcessConfig = uSimMarineV22 {                    " << endl;
+  cout << "          trace_vars = NAV_X,NAV_Y                         " << endl;
+  cout << "        }                                                  " << endl;
+  cout << "        ProcessConfig = pHelmIvP {                         " << endl;
+  cout << "          trace_report = true                              " << endl;
+  cout << "        }                                                  " << endl;
+  cout << endl;
+  exit(0);
+}
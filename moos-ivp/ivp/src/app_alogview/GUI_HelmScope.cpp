@@ -82,6 +82,8 @@ GUI_HelmScope::~GUI_HelmScope()
     delete(m_but_gen_modetree);
   if(m_but_gen_levents)  
     delete(m_but_gen_levents);
+  if(m_but_gen_profile)  
+    delete(m_but_gen_profile);
 
   if(m_brw_active)  
     delete(m_brw_active);
@@ -160,6 +162,10 @@ void GUI_HelmScope::initWidgets()
   m_but_gen_levents->labelcolor(bcolor);
   m_but_gen_levents->callback((Fl_Callback*)GUI_HelmScope::cb_ButtonLifeEvents);
 
+  m_but_gen_profile = new Fl_Check_Button(0, 0, 0, 0, "Profile");
+  m_but_gen_profile->labelcolor(bcolor);
+  m_but_gen_profile->callback((Fl_Callback*)GUI_HelmScope::cb_ButtonProfile);
+
   m_fld_time = new Fl_Output(0, 0, 0, 0, "Time:"); 
   m_fld_time->clear_visible_focus();
 
@@ -222,6 +228,7 @@ void GUI_HelmScope::resizeWidgetsShape()
   m_but_gen_errors->resize(200, y_gen-25, 20, 20);
   m_but_gen_modetree->resize(320, y_gen-25, 20, 20);
   m_but_gen_levents->resize(440, y_gen-25, 20, 20);
+  m_but_gen_profile->resize(590, y_gen-25, 20, 20);
 
   m_fld_time->resize(60, 5, 95, 20);
   m_fld_iter->resize(410, 5, 50, 20);
@@ -263,6 +270,7 @@ void GUI_HelmScope::resizeWidgetsText()
   m_but_gen_errors->labelsize(blab_size);
   m_but_gen_modetree->labelsize(blab_size);
   m_but_gen_levents->labelsize(blab_size);
+  m_but_gen_profile->labelsize(blab_size);
 
   m_fld_time->textsize(info_size); 
   m_fld_time->labelsize(info_size);
@@ -381,6 +389,7 @@ inline void GUI_HelmScope::cb_ButtonWarnings_i() {
     m_but_gen_errors->value(0);
     m_but_gen_modetree->value(0);
     m_but_gen_levents->value(0);
+    m_but_gen_profile->value(0);
   }
   else
     m_but_gen_errors->value(1);
@@ -398,6 +407,7 @@ inline void GUI_HelmScope::cb_ButtonErrors_i() {
     m_but_gen_warnings->value(0);
     m_but_gen_modetree->value(0);
     m_but_gen_levents->value(0);
+    m_but_gen_profile->value(0);
   }
   else
     m_but_gen_warnings->value(1);
@@ -415,6 +425,7 @@ inline void GUI_HelmScope::cb_ButtonModeTree_i() {
     m_but_gen_errors->value(0);
     m_but_gen_warnings->value(0);
     m_but_gen_levents->value(0);
+    m_but_gen_profile->value(0);
   }
   m_brw_general->label("Behavior \n Mode \n History:"); 
   updateBotBrowser();
@@ -429,6 +440,7 @@ inline void GUI_HelmScope::cb_ButtonLifeEvents_i() {
     m_but_gen_errors->value(0);
     m_but_gen_warnings->value(0);
     m_but_gen_modetree->value(0);
+    m_but_gen_profile->value(0);
   }
   m_brw_general->label("Behavior \n Life \n Events:"); 
   updateBotBrowser();
@@ -437,6 +449,21 @@ void GUI_HelmScope::cb_ButtonLifeEvents(Fl_Widget* o) {
   ((GUI_HelmScope*)(o->parent()->user_data()))->cb_ButtonLifeEvents_i();
 }
 
+//----------------------------------------- ButtonProfile
+inline void GUI_HelmScope::cb_ButtonProfile_i() {
+  if(m_but_gen_profile->value()) {
+    m_but_gen_errors->value(0);
+    m_but_gen_warnings->value(0);
+    m_but_gen_modetree->value(0);
+    m_but_gen_levents->value(0);
+  }
+  m_brw_general->label("Helm \n Profile:"); 
+  updateBotBrowser();
+}
+void GUI_HelmScope::cb_ButtonProfile(Fl_Widget* o) {
+  ((GUI_HelmScope*)(o->parent()->user_data()))->cb_ButtonProfile_i();
+}
+
 //----------------------------------------- Step
 inline void GUI_HelmScope::cb_Step_i(int val) {
   if(m_parent_gui)
@@ -600,6 +627,8 @@ void GUI_HelmScope::updateBotBrowser()
       svector = mvector;
     else if(m_but_gen_levents->value())
       svector = lvector;
+    else if(m_but_gen_profile->value())
+      svector = m_hsmodel.getProfile();
     
     unsigned int i, vsize = svector.size();
     for(i=0; i<vsize; i++)
@@ -81,6 +81,9 @@ private:
   inline void cb_ButtonLifeEvents_i();
   static void cb_ButtonLifeEvents(Fl_Widget*);
 
+  inline void cb_ButtonProfile_i();
+  static void cb_ButtonProfile(Fl_Widget*);
+
   inline void cb_Step_i(int);
   static void cb_Step(Fl_Widget*, int);
 
@@ -102,6 +105,7 @@ protected:
   Fl_Check_Button  *m_but_gen_warnings;
   Fl_Check_Button  *m_but_gen_modetree;
   Fl_Check_Button  *m_but_gen_levents;
+  Fl_Check_Button  *m_but_gen_profile;
 
   Fl_Browser *m_brw_active;
   Fl_Browser *m_brw_running;
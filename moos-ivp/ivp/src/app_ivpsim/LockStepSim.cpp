@@ -0,0 +1,390 @@
+/*****************************************************************/
+/*    NAME: agent                                                */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: LockStepSim.cpp                                      */
+/*    DATE: Oct 19th, 2026                                       */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#include <cstdlib>
+#include <cmath>
+#include <iostream>
+#include <sys/stat.h>
+#include "LockStepSim.h"
+#include "MBUtils.h"
+#include "MBTimer.h"
+#include "FileBuffer.h"
+
+using namespace std;
+
+//-----------------------------------------------------------
+// Constructor()
+
+LockStepSim::LockStepSim()
+{
+  m_duration        = 600;
+  m_time_step       = 0.25;
+  m_start_utc       = 10000;  // non-zero: zero time reads as unset
+  m_jitter_pos      = 0;
+  m_jitter_hdg      = 0;
+  m_collision_range = 3;
+  m_runs            = 1;
+  m_seed            = 1;
+  m_verbose         = false;
+}
+
+//-----------------------------------------------------------
+// Procedure: readScenario()
+//   Example: duration  = 900
+//            time_step = 0.25
+//            alog_dir  = ./sim_logs
+//            vehicle   = abe
+//            {
+//              behaviors = targ_abe.bhv
+//              start_pos = x=0,y=-20,heading=180
+//              poke      = DEPLOY=true
+//            }
+
+bool LockStepSim::readScenario(string filename)
+{
+  vector<string> lines = fileBuffer(filename);
+  if(lines.size() == 0) {
+    cout << "Unable to read scenario file: " << filename << endl;
+    return(false);
+  }
+
+  string curr_vname;
+  bool   in_block = false;
+  bool   all_ok   = true;
+  for(unsigned int i=0; i<lines.size(); i++) {
+    string line = stripBlankEnds(stripComment(lines[i], "//"));
+    if(line == "")
+      continue;
+
+    if(line == "{") {
+      if((curr_vname == "") || in_block) {
+	cout << "Line " << i+1 << ": unexpected '{'" << endl;
+	return(false);
+      }
+      in_block = true;
+      continue;
+    }
+    if(line == "}") {
+      if(!in_block) {
+	cout << "Line " << i+1 << ": unexpected '}'" << endl;
+	return(false);
+      }
+      in_block   = false;
+      curr_vname = "";
+      continue;
+    }
+
+    string param = tolower(biteStringX(line, '='));
+    string value = line;
+    if(param == "vehicle") {
+      if(in_block || (value == "") || strContainsWhite(value) ||
+	 vectorContains(m_vnames, value)) {
+	cout << "Line " << i+1 << ": bad vehicle name: " << value << endl;
+	return(false);
+      }
+      curr_vname = value;
+      m_vnames.push_back(value);
+      m_vparams.push_back(vector<string>());
+      continue;
+    }
+
+    string vname = in_block ? curr_vname : "";
+    if(!handleParam(param, value, vname, i+1))
+      all_ok = false;
+  }
+
+  if(in_block) {
+    cout << "Missing '}' for vehicle " << curr_vname << endl;
+    return(false);
+  }
+  if(m_vnames.size() == 0) {
+    cout << "No vehicles specified in " << filename << endl;
+    return(false);
+  }
+  return(all_ok);
+}
+
+//-----------------------------------------------------------
+// Procedure: handleParam()
+
+bool LockStepSim::handleParam(string param, string value,
+			      string vname, unsigned int line_num)
+{
+  bool handled = false;
+  if(vname == "") {
+    if(param == "duration")
+      handled = setPosDoubleOnString(m_duration, value);
+    else if(param == "time_step")
+      handled = setPosDoubleOnString(m_time_step, value);
+    else if(param == "start_utc")
+      handled = setPosDoubleOnString(m_start_utc, value);
+    else if(param == "jitter_pos")
+      handled = setNonNegDoubleOnString(m_jitter_pos, value);
+    else if(param == "jitter_hdg")
+      handled = setNonNegDoubleOnString(m_jitter_hdg, value);
+    else if(param == "collision_range")
+      handled = setNonNegDoubleOnString(m_collision_range, value);
+    else if(param == "runs")
+      handled = setUIntOnString(m_runs, value);
+    else if(param == "seed")
+      handled = setUIntOnString(m_seed, value);
+    else if(param == "alog_dir")
+      handled = setNonWhiteVarOnString(m_alog_dir, value);
+    if(handled)
+      return(true);
+  }
+
+  // Validate vehicle params now so errors carry a line number
+  SimVehicle test_vehicle("test");
+  if(!test_vehicle.setParam(param, value)) {
+    cout << "Line " << line_num << ": unhandled param: ";
+    cout << param << " = " << value << endl;
+    return(false);
+  }
+
+  string entry = param + "=" + value;
+  if(vname == "")
+    m_global_params.push_back(entry);
+  else
+    m_vparams.back().push_back(entry);
+  return(true);
+}
+
+//-----------------------------------------------------------
+// Procedure: run()
+
+bool LockStepSim::run()
+{
+  if(m_alog_dir != "")
+    mkdir(m_alog_dir.c_str(), 0755);
+
+  for(unsigned int i=0; i<m_runs; i++) {
+    bool ok = runOnce(i);
+    clearVehicles();
+    if(!ok)
+      return(false);
+  }
+  return(true);
+}
+
+//-----------------------------------------------------------
+// Procedure: buildVehicles()
+//   Purpose: Create a fresh set of vehicles for one run. Nothing
+//            carries over from a previous run other than the
+//            scenario configuration.
+
+bool LockStepSim::buildVehicles(unsigned int run_ix)
+{
+  clearVehicles();
+
+  string run_dir = m_alog_dir;
+  if((m_alog_dir != "") && (m_runs > 1)) {
+    char buff[32];
+    sprintf(buff, "/run_%04u", run_ix);
+    run_dir += buff;
+    mkdir(run_dir.c_str(), 0755);
+  }
+
+  bool all_ok = true;
+  for(unsigned int i=0; i<m_vnames.size(); i++) {
+    SimVehicle *vehicle = new SimVehicle(m_vnames[i]);
+    m_vehicles.push_back(vehicle);
+
+    for(unsigned int j=0; j<m_global_params.size(); j++) {
+      string value = m_global_params[j];
+      string param = biteStringX(value, '=');
+      vehicle->setParam(param, value);
+    }
+    for(unsigned int j=0; j<m_vparams[i].size(); j++) {
+      string value = m_vparams[i][j];
+      string param = biteStringX(value, '=');
+      vehicle->setParam(param, value);
+    }
+
+    if((m_jitter_pos > 0) || (m_jitter_hdg > 0)) {
+      double rx = ((double)(rand() % 2001) / 1000.0) - 1;
+      double ry = ((double)(rand() % 2001) / 1000.0) - 1;
+      double rh = ((double)(rand() % 2001) / 1000.0) - 1;
+      vehicle->offsetStart(rx * m_jitter_pos, ry * m_jitter_pos,
+			   rh * m_jitter_hdg);
+    }
+
+    if(run_dir != "") {
+      string filename = run_dir + "/" + toupper(m_vnames[i]) + ".alog";
+      if(!vehicle->openLog(filename, m_start_utc)) {
+	cout << "Unable to open alog file: " << filename << endl;
+	all_ok = false;
+      }
+    }
+
+    bool ok = vehicle->initialize(m_start_utc);
+    vector<string> warnings = vehicle->getWarnings();
+    for(unsigned int j=0; j<warnings.size(); j++)
+      cout << "  Warning: " << warnings[j] << endl;
+    if(!ok)
+      all_ok = false;
+  }
+  return(all_ok);
+}
+
+//-----------------------------------------------------------
+// Procedure: runOnce()
+//   Purpose: Step all vehicles in lockstep for the full duration.
+//            On each tick every vehicle is first propagated, then
+//            node records are exchanged, then each helm and PID
+//            runs. No vehicle sees another's state from later in
+//            the same tick, so results do not depend on the order
+//            vehicles are listed.
+
+bool LockStepSim::runOnce(unsigned int run_ix)
+{
+  srand(m_seed + run_ix);
+
+  if(!buildVehicles(run_ix))
+    return(false);
+
+  MBTimer timer;
+  timer.start();
+
+  double min_range = -1;
+  double min_time  = 0;
+  string min_pair;
+
+  unsigned int vcnt  = m_vehicles.size();
+  unsigned int steps = (unsigned int)((m_duration / m_time_step) + 0.5);
+  vector<NodeRecord> records(vcnt);
+
+  for(unsigned int k=0; k<=steps; k++) {
+    double utc = m_start_utc + (k * m_time_step);
+
+    for(unsigned int i=0; i<vcnt; i++) {
+      m_vehicles[i]->propagate(utc);
+      records[i] = m_vehicles[i]->getNodeRecord();
+    }
+
+    for(unsigned int i=0; i<vcnt; i++) {
+      for(unsigned int j=0; j<vcnt; j++) {
+	if(i != j)
+	  m_vehicles[i]->handleNodeRecord(records[j]);
+      }
+      for(unsigned int j=i+1; j<vcnt; j++) {
+	double range = hypot(records[i].getX() - records[j].getX(),
+			     records[i].getY() - records[j].getY());
+	if((min_range < 0) || (range < min_range)) {
+	  min_range = range;
+	  min_time  = utc - m_start_utc;
+	  min_pair  = m_vnames[i] + ":" + m_vnames[j];
+	}
+      }
+    }
+
+    for(unsigned int i=0; i<vcnt; i++)
+      m_vehicles[i]->iterateHelm(utc);
+    for(unsigned int i=0; i<vcnt; i++)
+      m_vehicles[i]->iterateControl(utc);
+  }
+
+  timer.stop();
+
+  unsigned int allstops = 0;
+  for(unsigned int i=0; i<vcnt; i++)
+    allstops += m_vehicles[i]->getAllStopCount();
+
+  m_run_min_range.push_back(min_range);
+  m_run_min_time.push_back(min_time);
+  m_run_min_pair.push_back(min_pair);
+  m_run_wall_time.push_back(timer.get_float_wall_time());
+  m_run_allstops.push_back(allstops);
+
+  if(m_verbose) {
+    cout << "Run " << run_ix << ": ";
+    for(unsigned int i=0; i<vcnt; i++) {
+      NodeRecord record = m_vehicles[i]->getNodeRecord();
+      cout << m_vnames[i] << "=(" << doubleToString(record.getX(), 1);
+      cout << "," << doubleToString(record.getY(), 1) << ") ";
+    }
+    cout << "min_range=" << doubleToString(min_range, 2) << endl;
+  }
+  return(true);
+}
+
+//-----------------------------------------------------------
+// Procedure: clearVehicles()
+
+void LockStepSim::clearVehicles()
+{
+  for(unsigned int i=0; i<m_vehicles.size(); i++)
+    delete(m_vehicles[i]);
+  m_vehicles.clear();
+}
+
+//-----------------------------------------------------------
+// Procedure: printSummary()
+
+void LockStepSim::printSummary() const
+{
+  unsigned int runs = m_run_min_range.size();
+  if(runs == 0)
+    return;
+
+  double total_wall = 0;
+  double worst_range = -1;
+  unsigned int collisions = 0;
+  unsigned int allstops = 0;
+  for(unsigned int i=0; i<runs; i++) {
+    total_wall += m_run_wall_time[i];
+    allstops   += m_run_allstops[i];
+    double range = m_run_min_range[i];
+    if((range >= 0) && (range < m_collision_range))
+      collisions++;
+    if((range >= 0) && ((worst_range < 0) || (range < worst_range)))
+      worst_range = range;
+  }
+
+  double sim_time = m_duration * runs;
+  cout << "==============================================" << endl;
+  cout << "ivpsim Summary" << endl;
+  cout << "==============================================" << endl;
+  cout << "  Vehicles:        " << m_vnames.size() << endl;
+  cout << "  Runs:            " << runs << endl;
+  cout << "  Time step:       " << doubleToStringX(m_time_step, 3) << endl;
+  cout << "  Sim time (secs): " << doubleToStringX(sim_time, 1) << endl;
+  cout << "  Wall time(secs): " << doubleToStringX(total_wall, 3) << endl;
+  if(total_wall > 0)
+    cout << "  Speedup:         " << doubleToString(sim_time/total_wall, 1)
+	 << "x" << endl;
+  cout << "  All-stops:       " << allstops << endl;
+  if(m_vnames.size() > 1) {
+    cout << "  Min range:       " << doubleToString(worst_range, 2) << endl;
+    cout << "  Collisions:      " << collisions << " (range < ";
+    cout << doubleToStringX(m_collision_range, 2) << ")" << endl;
+    if(m_verbose) {
+      for(unsigned int i=0; i<runs; i++) {
+	cout << "    run " << i << ": min_range=";
+	cout << doubleToString(m_run_min_range[i], 2);
+	cout << " pair=" << m_run_min_pair[i];
+	cout << " time=" << doubleToString(m_run_min_time[i], 2) << endl;
+      }
+    }
+  }
+}
@@ -0,0 +1,82 @@
+/*****************************************************************/
+/*    NAME: agent                                                */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: LockStepSim.h                                        */
+/*    DATE: Oct 19th, 2026                                       */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#ifndef IVPSIM_LOCKSTEP_SIM_HEADER
+#define IVPSIM_LOCKSTEP_SIM_HEADER
+
+#include <string>
+#include <vector>
+#include "SimVehicle.h"
+
+class LockStepSim
+{
+ public:
+  LockStepSim();
+  ~LockStepSim() {clearVehicles();}
+
+  bool readScenario(std::string filename);
+
+  void setRuns(unsigned int v)     {m_runs=v;}
+  void setSeed(unsigned int v)     {m_seed=v;}
+  void setAlogDir(std::string s)   {m_alog_dir=s;}
+  void setVerbose(bool v=true)     {m_verbose=v;}
+
+  bool run();
+  void printSummary() const;
+
+ protected:
+  bool handleParam(std::string param, std::string value,
+		   std::string vname, unsigned int line_num);
+  bool buildVehicles(unsigned int run_ix);
+  bool runOnce(unsigned int run_ix);
+  void clearVehicles();
+
+ protected: // Configuration variables
+  double       m_duration;
+  double       m_time_step;
+  double       m_start_utc;
+  double       m_jitter_pos;
+  double       m_jitter_hdg;
+  double       m_collision_range;
+  unsigned int m_runs;
+  unsigned int m_seed;
+  bool         m_verbose;
+  std::string  m_alog_dir;
+
+  // Params given outside a vehicle block apply to all vehicles
+  std::vector<std::string> m_global_params;
+
+  std::vector<std::string> m_vnames;
+  std::vector<std::vector<std::string> > m_vparams;
+
+ protected: // State variables
+  std::vector<SimVehicle*> m_vehicles;
+
+  std::vector<double>      m_run_min_range;
+  std::vector<double>      m_run_min_time;
+  std::vector<std::string> m_run_min_pair;
+  std::vector<double>      m_run_wall_time;
+  std::vector<unsigned int> m_run_allstops;
+};
+
+#endif
@@ -0,0 +1,1177 @@
+/*****************************************************************/
+/*    NAME: agent                                                */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: SimVehicle.cpp                                       */
+/*    DATE: Oct 19th, 2026                                       */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#include <cmath>
+#include <cstdlib>
+#include <list>
+#include "SimVehicle.h"
+#include "MBUtils.h"
+#include "AngleUtils.h"
+#include "BuildUtils.h"
+#include "CPAEngineBatch.h"
+#include "Populator_BehaviorSet.h"
+
+using namespace std;
+
+//-----------------------------------------------------------
+// Constructor()
+
+SimVehicle::SimVehicle(string vname)
+{
+  m_vname  = vname;
+  m_vtype  = "kayak";
+  m_vcolor = "yellow";
+  m_length = 4;
+
+  m_info_buffer = 0;
+  m_ledger_snap = 0;
+  m_hengine     = 0;
+  m_bhv_set     = 0;
+
+  m_curr_time      = 0;
+  m_start_time     = 0;
+  m_helm_iteration = 0;
+  m_init_vars_done = false;
+  m_info_vars_tcount = 0;
+
+  m_allstop_count     = 0;
+  m_no_decisions      = 0;
+  m_no_goal_decisions = 0;
+
+  m_des_heading = 0;
+  m_des_speed   = 0;
+  m_des_depth   = 0;
+
+  m_odometry = 0;
+  m_prev_x   = 0;
+  m_prev_y   = 0;
+
+  m_log       = 0;
+  m_log_start = 0;
+
+  // Default PID gains, those of the stock marine vehicle missions.
+  // Any of these may be overridden with pid = param=value.
+  m_pid_params["yaw_pid_kp"] = "1.2";
+  m_pid_params["yaw_pid_kd"] = "0.0";
+  m_pid_params["yaw_pid_ki"] = "0.3";
+  m_pid_params["yaw_pid_integral_limit"] = "0.07";
+  m_pid_params["speed_pid_kp"] = "1.0";
+  m_pid_params["speed_pid_kd"] = "0.0";
+  m_pid_params["speed_pid_ki"] = "0.0";
+  m_pid_params["speed_pid_integral_limit"] = "0.07";
+  m_pid_params["maxrudder"]     = "100";
+  m_pid_params["maxthrust"]     = "100";
+  m_pid_params["speed_factor"]  = "20";
+  m_pid_params["depth_control"] = "false";
+  m_pid_params["simulation"]    = "true";
+}
+
+//-----------------------------------------------------------
+// Destructor()
+
+SimVehicle::~SimVehicle()
+{
+  closeLog();
+  delete(m_hengine);
+  delete(m_bhv_set);
+  delete(m_info_buffer);
+  delete(m_ledger_snap);
+}
+
+//-----------------------------------------------------------
+// Procedure: setParam()
+
+bool SimVehicle::setParam(string param, string value)
+{
+  param = tolower(param);
+  value = stripBlankEnds(value);
+  
+  bool handled = false;
+  if((param == "behaviors") || (param == "bhv")) {
+    m_bhv_file = value;
+    handled = (value != "");
+  }
+  else if(param == "ivp_behavior_dir") {
+    m_bhv_dirs.push_back(value);
+    handled = true;
+  }
+  else if(param == "domain")
+    handled = handleConfigDomain(value);
+  else if(param == "start_pos") {
+    m_start_pos = value;
+    handled = true;
+  }
+  else if(param == "type")
+    handled = setNonWhiteVarOnString(m_vtype, value);
+  else if(param == "color")
+    handled = setNonWhiteVarOnString(m_vcolor, value);
+  else if(param == "group")
+    handled = setNonWhiteVarOnString(m_group, value);
+  else if(param == "length")
+    handled = setPosDoubleOnString(m_length, value);
+  else if(param == "poke")
+    handled = handleConfigPoke(value);
+  else if(param == "alert")
+    handled = handleConfigAlert(value);
+  else if(param == "sim")
+    handled = handleConfigModelParam(value);
+  else if(param == "pid")
+    handled = handleConfigPIDParam(value);
+  else if(param == "pmgen")
+    handled = m_pmgen.setParams(value);
+
+  return(handled);
+}
+
+//-----------------------------------------------------------
+// Procedure: offsetStart()
+//   Purpose: Perturb the configured start position, used for
+//            generating Monte Carlo variations of one scenario.
+
+void SimVehicle::offsetStart(double dx, double dy, double dh)
+{
+  double x = 0, y = 0, h = 0;
+  string rest;
+  vector<string> svector = parseString(m_start_pos, ',');
+  for(unsigned int i=0; i<svector.size(); i++) {
+    string param = tolower(biteStringX(svector[i], '='));
+    string value = svector[i];
+    double dval  = atof(value.c_str());
+    if(param == "x")
+      x = dval;
+    else if(param == "y")
+      y = dval;
+    else if((param == "heading") || (param == "hdg") || (param == "deg"))
+      h = dval;
+    else
+      rest += "," + param + "=" + value;
+  }
+
+  m_start_pos  = "x=" + doubleToStringX(x+dx, 2);
+  m_start_pos += ",y=" + doubleToStringX(y+dy, 2);
+  m_start_pos += ",heading=" + doubleToStringX(angle360(h+dh), 2);
+  m_start_pos += rest;
+}
+
+//-----------------------------------------------------------
+// Procedure: initialize()
+//   Purpose: Build the helm, controller and vehicle model. This
+//            follows the start-up sequence of pHelmIvP, with the
+//            configuration coming from the scenario rather than
+//            a .moos file.
+
+bool SimVehicle::initialize(double start_utc)
+{
+  m_curr_time  = start_utc;
+  m_start_time = start_utc;
+
+  if(m_ivp_domain.size() == 0) {
+    m_ivp_domain.addDomain("course", 0, 359, 360);
+    m_ivp_domain.addDomain("speed", 0, 5, 26);
+  }
+
+  m_info_buffer = new InfoBuffer;
+  m_info_buffer->setCurrTime(start_utc);
+  m_info_buffer->setStartTime(start_utc);
+  m_ledger_snap = new LedgerSnap;
+
+  m_ledger.setCurrTimeUTC(start_utc);
+  m_ledger.setStaleThresh(10);
+
+  //=======================================================
+  // Part 1: Build the helm and populate the behavior set
+  //=======================================================
+  if(m_bhv_file == "") {
+    m_warnings.push_back(m_vname + ": no behavior file given");
+    return(false);
+  }
+
+  m_hengine = new HelmEngine(m_ivp_domain, m_info_buffer, m_ledger_snap);
+
+  Populator_BehaviorSet populator(m_ivp_domain, m_info_buffer,
+				  m_ledger_snap);
+  populator.setOwnship(m_vname);
+  for(unsigned int i=0; i<m_bhv_dirs.size(); i++)
+    populator.addBehaviorDir(m_bhv_dirs[i]);
+
+  set<string> bhv_files;
+  bhv_files.insert(m_bhv_file);
+  m_bhv_set = populator.populate(bhv_files);
+
+  vector<string> config_warnings = populator.getConfigWarnings();
+  for(unsigned int i=0; i<config_warnings.size(); i++)
+    m_warnings.push_back(m_vname + ": " + config_warnings[i]);
+
+  if(!m_bhv_set) {
+    m_warnings.push_back(m_vname + ": NULL behavior set");
+    return(false);
+  }
+  m_hengine->setBehaviorSet(m_bhv_set);
+
+  for(unsigned int i=0; i<m_bhv_set->size(); i++) {
+    m_bhv_set->getBehavior(i)->IvPBehavior::setParam("us", m_vname);
+    m_bhv_set->getBehavior(i)->onSetParamComplete();
+  }
+
+  // Template update vars are registered up front, as in the helm,
+  // so the mail that spawns a behavior is not itself filtered out.
+  vector<string> update_vars = m_bhv_set->getSpecUpdateVars();
+  m_info_vars.insert(update_vars.begin(), update_vars.end());
+
+  //=======================================================
+  // Part 2: Configure the vehicle model
+  //=======================================================
+  m_model.resetTime(start_utc);
+  if((m_start_pos != "") && !m_model.initPosition(m_start_pos))
+    m_warnings.push_back(m_vname + ": bad start_pos: " + m_start_pos);
+
+  for(unsigned int i=0; i<m_model_params.size(); i++) {
+    string value = m_model_params[i];
+    string param = tolower(biteStringX(value, '='));
+    double dval  = atof(value.c_str());
+
+    bool handled = false;
+    if(isNumber(value)) {
+      if(param == "drift_x")
+	handled = m_model.setDriftX(dval, "");
+      else if(param == "drift_y")
+	handled = m_model.setDriftY(dval, "");
+      else if(param == "max_rudder_degs_per_sec")
+	handled = m_model.setMaxRudderDegreesPerSec(dval);
+      else
+	handled = m_model.setParam(param, dval);
+    }
+    else if(param == "turn_spd_map_full_speed")
+      handled = m_model.setTSMapFullSpeed(value);
+    else if(param == "turn_spd_map_null_speed")
+      handled = m_model.setTSMapNullSpeed(value);
+    else if(param == "turn_spd_map_full_rate")
+      handled = m_model.setTSMapFullRate(value);
+    else if(param == "turn_spd_map_null_rate")
+      handled = m_model.setTSMapNullRate(value);
+    else if(param == "thrust_map")
+      handled = m_model.handleFullThrustMapping(value);
+    else if(param == "drift_vector")
+      handled = m_model.setDriftVector(value, "");
+    else
+      handled = m_model.setParam(param, value);
+
+    if(!handled)
+      m_warnings.push_back(m_vname + ": bad sim param: " + m_model_params[i]);
+  }
+
+  NodeRecord record = m_model.getNodeRecord();
+  m_prev_x = record.getX();
+  m_prev_y = record.getY();
+
+  //=======================================================
+  // Part 3: Configure the PID controller
+  //=======================================================
+  list<string> pid_lines;
+  map<string, string>::iterator p;
+  for(p=m_pid_params.begin(); p!=m_pid_params.end(); p++)
+    pid_lines.push_back(p->first + "=" + p->second);
+  m_pengine.setConfigParams(pid_lines);
+
+  if(!m_pengine.handleYawSettings() || !m_pengine.handleSpeedSettings() ||
+     !m_pengine.handleDepthSettings()) {
+    m_warnings.push_back(m_vname + ": improper PID settings");
+    return(false);
+  }
+  m_pengine.setPIDOverride(false);
+  m_pengine.setStartTime(start_utc);
+  m_pengine.updateTime(start_utc);
+
+  //=======================================================
+  // Part 4: Post the helm's initial and start-up variables
+  //=======================================================
+  vector<VarDataPair> init_vars = m_bhv_set->getInitialVariables();
+  for(unsigned int i=0; i<init_vars.size(); i++) {
+    VarDataPair msg = init_vars[i];
+    string var = stripBlankEnds(msg.get_var());
+    if(strContainsWhite(var) || (tolower(msg.get_key()) != "post"))
+      continue;
+    string sdata = stripBlankEnds(msg.get_sdata());
+    if(sdata != "") {
+      m_info_buffer->setValue(var, sdata);
+      notify(var, sdata, "pHelmIvP");
+    }
+    else {
+      m_info_buffer->setValue(var, msg.get_ddata());
+      notify(var, msg.get_ddata(), "pHelmIvP");
+    }
+  }
+
+  vector<VarDataPair> start_msgs = m_bhv_set->getHelmStartMessages();
+  for(unsigned int i=0; i<start_msgs.size(); i++) {
+    VarDataPair msg = start_msgs[i];
+    string var = stripBlankEnds(msg.get_var());
+    if(strContainsWhite(var))
+      continue;
+    string sdata = stripBlankEnds(msg.get_sdata());
+    if(sdata != "") {
+      m_info_buffer->setValue(var, sdata);
+      notify(var, sdata, "pHelmIvP");
+    }
+    else {
+      m_info_buffer->setValue(var, msg.get_ddata());
+      notify(var, msg.get_ddata(), "pHelmIvP");
+    }
+  }
+
+  notify("IVPHELM_DOMAIN", domainToString(m_ivp_domain), "pHelmIvP");
+  notify("IVPHELM_MODESET", m_bhv_set->getModeSetDefinition(), "pHelmIvP");
+  return(true);
+}
+
+//-----------------------------------------------------------
+// Procedure: propagate()
+//   Purpose: Advance the vehicle model to the given time using
+//            the actuator values set on the previous tick, and
+//            update the helm's info_buffer with the new nav state.
+
+void SimVehicle::propagate(double utc)
+{
+  m_curr_time = utc;
+  m_model.propagate(utc);
+
+  NodeRecord record = m_model.getNodeRecord();
+  double nav_x = record.getX();
+  double nav_y = record.getY();
+  double nav_h = record.getHeading();
+  double nav_v = snapToStep(record.getSpeed(), 0.01);
+  double nav_d = record.getDepth();
+
+  m_odometry += hypot(nav_x - m_prev_x, nav_y - m_prev_y);
+  m_prev_x = nav_x;
+  m_prev_y = nav_y;
+
+  m_info_buffer->setCurrTime(utc);
+  m_info_buffer->setValue("NAV_X", nav_x, utc);
+  m_info_buffer->setValue("NAV_Y", nav_y, utc);
+  m_info_buffer->setValue("NAV_HEADING", nav_h, utc);
+  m_info_buffer->setValue("NAV_SPEED", nav_v, utc);
+  m_info_buffer->setValue("NAV_DEPTH", nav_d, utc);
+
+  if(m_log) {
+    logEntry("NAV_X", "uSimMarineV23", doubleToStringX(nav_x, 5));
+    logEntry("NAV_Y", "uSimMarineV23", doubleToStringX(nav_y, 5));
+    logEntry("NAV_HEADING", "uSimMarineV23", doubleToStringX(nav_h, 5));
+    logEntry("NAV_SPEED", "uSimMarineV23", doubleToStringX(nav_v, 2));
+    logEntry("NAV_DEPTH", "uSimMarineV23", doubleToStringX(nav_d, 2));
+  }
+}
+
+//-----------------------------------------------------------
+// Procedure: getNodeRecord()
+
+NodeRecord SimVehicle::getNodeRecord() const
+{
+  NodeRecord record = m_model.getNodeRecord();
+  record.setName(m_vname);
+  record.setType(m_vtype);
+  record.setColor(m_vcolor);
+  record.setLength(m_length);
+  record.setTimeStamp(m_curr_time);
+  if(m_group != "")
+    record.setGroup(m_group);
+  return(record);
+}
+
+//-----------------------------------------------------------
+// Procedure: handleNodeRecord()
+//   Purpose: Take in the node record of another vehicle, as the
+//            helm would on receipt of a shared NODE_REPORT.
+
+void SimVehicle::handleNodeRecord(const NodeRecord& record)
+{
+  string whynot;
+  string vname = m_ledger.processNodeRecord(record, whynot);
+  if(vname == "") {
+    m_warnings.push_back(m_vname + ": bad node record: " + whynot);
+    return;
+  }
+
+  string uvname = toupper(vname);
+  m_info_buffer->setValue(uvname+"_NAV_GROUP", m_ledger.getGroup(vname));
+  m_info_buffer->setValue(uvname+"_NAV_TYPE", m_ledger.getType(vname));
+
+  if(m_log)
+    logEntry("NODE_REPORT", "pShare", record.getSpec());
+}
+
+//-----------------------------------------------------------
+// Procedure: iterateHelm()
+//   Purpose: One helm iteration, the counterpart of the decision
+//            portion of HelmIvP::Iterate().
+
+void SimVehicle::iterateHelm(double utc)
+{
+  if(!m_bhv_set || !m_hengine)
+    return;
+
+  m_curr_time = utc;
+  m_info_buffer->setCurrTime(utc);
+
+  handleMail();
+  handlePokes();
+  if(!m_init_vars_done)
+    handleInitialVars();
+
+  m_ledger.setCurrTimeUTC(utc);
+  vector<string> keep_vnames = m_bhv_set->getContactNames();
+  m_ledger.clearStaleNodes(keep_vnames);
+  m_ledger.extrapolate();
+  updateLedgerSnap();
+  checkForAlerts();
+
+  updatePlatModel();
+  HelmReport report = m_hengine->determineNextDecision(m_bhv_set, utc);
+  m_helm_iteration = report.getIteration();
+
+  postModeMessages();
+  postBehaviorMessages();
+  postLifeEvents();
+  postDefaultVariables();
+  postDecisions(report);
+
+  m_bhv_set->refreshMapUpdateVars();
+  m_info_buffer->clearDeltaVectors();
+}
+
+//-----------------------------------------------------------
+// Procedure: iterateControl()
+//   Purpose: Map the helm's desired heading and speed to rudder
+//            and thrust, and apply them to the vehicle model.
+
+void SimVehicle::iterateControl(double utc)
+{
+  NodeRecord record = m_model.getNodeRecord();
+
+  m_pengine.updateTime(utc);
+  m_pengine.setCurrHeading(record.getHeading());
+  m_pengine.setCurrSpeed(record.getSpeed());
+  m_pengine.setDesHeading(m_des_heading);
+  m_pengine.setDesSpeed(m_des_speed);
+  if(m_pengine.hasDepthControl()) {
+    m_pengine.setCurrDepth(record.getDepth());
+    m_pengine.setCurrPitch(record.getPitch());
+    m_pengine.setDesDepth(m_des_depth);
+  }
+  m_pengine.setDesiredValues();
+  m_pengine.clearPostings();
+
+  double rudder = m_pengine.getDesiredRudder();
+  double thrust = m_pengine.getDesiredThrust();
+
+  m_model.setRudder(rudder, utc);
+  m_model.setThrust(thrust);
+  if(m_pengine.hasDepthControl())
+    m_model.setElevator(m_pengine.getDesiredElevator());
+
+  if(m_log) {
+    logEntry("DESIRED_RUDDER", "pMarinePIDV22", doubleToStringX(rudder, 4));
+    logEntry("DESIRED_THRUST", "pMarinePIDV22", doubleToStringX(thrust, 4));
+  }
+}
+
+//-----------------------------------------------------------
+// Procedure: openLog()
+
+bool SimVehicle::openLog(string filename, double start_utc)
+{
+  closeLog();
+  m_log = fopen(filename.c_str(), "w");
+  if(!m_log)
+    return(false);
+
+  m_log_start = start_utc;
+
+  string hline = "%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%";
+  fprintf(m_log, "%s\n", hline.c_str());
+  fprintf(m_log, "%%%% LOG FILE:       %s\n", filename.c_str());
+  fprintf(m_log, "%%%% FILE OPENED ON  ivpsim lockstep simulation\n");
+  fprintf(m_log, "%%%% LOGSTART           %.3f\n", m_log_start);
+  fprintf(m_log, "%s\n", hline.c_str());
+  return(true);
+}
+
+//-----------------------------------------------------------
+// Procedure: closeLog()
+
+void SimVehicle::closeLog()
+{
+  if(m_log)
+    fclose(m_log);
+  m_log = 0;
+}
+
+//-----------------------------------------------------------
+// Procedure: handleConfigDomain()
+//   Example: "speed:0:5:26" or "speed:0:5:delta=0.2:optional"
+
+bool SimVehicle::handleConfigDomain(string entry)
+{
+  entry = findReplace(stripBlankEnds(entry), ',', ':');
+
+  vector<string> svector = parseString(entry, ':');
+  unsigned int vsize = svector.size();
+  if((vsize < 4) || (vsize > 5))
+    return(false);
+
+  string dname = svector[0];
+  double dlow  = atof(svector[1].c_str());
+  double dhgh  = atof(svector[2].c_str());
+  int    dcnt  = atoi(svector[3].c_str());
+  double dom_range = dhgh - dlow;
+
+  if(dhgh < dlow)
+    return(false);
+
+  if(strBegins(svector[3], "delta=") && (dom_range > 0)) {
+    double delta = atof(rbiteString(svector[3], '=').c_str());
+    if((delta > 0) && (delta <= dom_range))
+      dcnt = (int)((dom_range / delta) + 1);
+  }
+  if((dom_range == 0) && (dcnt != 1))
+    return(false);
+
+  if(vsize == 5)
+    m_optional_var[dname] = (tolower(svector[4]) == "optional");
+
+  return(m_ivp_domain.addDomain(dname.c_str(), dlow, dhgh, dcnt));
+}
+
+//-----------------------------------------------------------
+// Procedure: handleConfigPoke()
+//   Example: "DEPLOY=true"  or  "RETURN=true @ 300"
+
+bool SimVehicle::handleConfigPoke(string str)
+{
+  double ptime = 0;
+  size_t pos = str.rfind('@');
+  if(pos != string::npos) {
+    string tstr = stripBlankEnds(str.substr(pos+1));
+    if(!isNumber(tstr))
+      return(false);
+    ptime = atof(tstr.c_str());
+    str = str.substr(0, pos);
+  }
+
+  string var = biteStringX(str, '=');
+  string val = stripBlankEnds(str);
+  if((var == "") || strContainsWhite(var))
+    return(false);
+
+  if(isNumber(val))
+    m_pokes.push_back(VarDataPair(var, atof(val.c_str())));
+  else
+    m_pokes.push_back(VarDataPair(var, stripQuotes(val)));
+  m_poke_times.push_back(ptime);
+  return(true);
+}
+
+//-----------------------------------------------------------
+// Procedure: handleConfigAlert()
+//   Example: id=avd, var=CONTACT_INFO, val="name=$[VNAME] #
+//            contact=$[VNAME]", alert_range=40, cpa_range=45
+//      Note: Same format as a pContactMgrV20 alert or a
+//            BCM_ALERT_REQUEST posted by a behavior.
+
+bool SimVehicle::handleConfigAlert(string alert_str, string src)
+{
+  string alert_id = tokStringParse(alert_str, "id", ',', '=');
+  if(alert_id == "")
+    alert_id = "no_id";
+
+  if(src != "")
+    m_map_alerts[alert_id].setAlertSource(src);
+
+  string var, pattern;
+  vector<string> svector = parseStringQ(alert_str, ',');
+  for(unsigned int i=0; i<svector.size(); i++) {
+    string left  = tolower(biteStringX(svector[i], '='));
+    string right = svector[i];
+    double dval  = atof(right.c_str());
+    if(isQuoted(right))
+      right = stripQuotes(right);
+
+    bool ok = true;
+    if(left == "var")
+      var = right;
+    else if((left == "val") || (left == "pattern"))
+      pattern = right;
+    else if((left == "on_flag") || (left == "onflag"))
+      ok = m_map_alerts[alert_id].addAlertOnFlag(right);
+    else if((left == "off_flag") || (left == "offflag"))
+      ok = m_map_alerts[alert_id].addAlertOffFlag(right);
+    else if((left == "alert_range") && isNumber(right))
+      ok = m_map_alerts[alert_id].setAlertRange(dval);
+    else if((left == "cpa_range") && isNumber(right))
+      ok = m_map_alerts[alert_id].setAlertRangeFar(dval);
+    else if(strBegins(left, "match_") || strBegins(left, "ignore_") ||
+	    (left == "strict_ignore"))
+      ok = m_map_alerts[alert_id].configFilter(left, right);
+    else if(left != "id")
+      ok = false;
+
+    if(!ok)
+      return(false);
+  }
+
+  if((var != "") && (pattern != ""))
+    m_map_alerts[alert_id].addAlertOnFlag(var + "=" + pattern);
+
+  return(true);
+}
+
+//-----------------------------------------------------------
+// Procedure: handleConfigModelParam()
+//   Example: "max_acceleration=0.5"
+//      Note: Applied to the model in initialize() so that the
+//            start position is set first.
+
+bool SimVehicle::handleConfigModelParam(string str)
+{
+  if(!strContains(str, '='))
+    return(false);
+  m_model_params.push_back(stripBlankEnds(str));
+  return(true);
+}
+
+//-----------------------------------------------------------
+// Procedure: handleConfigPIDParam()
+//   Example: "yaw_pid_kp=1.5"
+
+bool SimVehicle::handleConfigPIDParam(string str)
+{
+  string param = tolower(biteStringX(str, '='));
+  string value = stripBlankEnds(str);
+  if((param == "") || (value == ""))
+    return(false);
+  m_pid_params[param] = value;
+  return(true);
+}
+
+//-----------------------------------------------------------
+// Procedure: updateLedgerSnap()
+
+void SimVehicle::updateLedgerSnap()
+{
+  m_ledger_snap->clear();
+
+  vector<string> vnames = m_ledger.getVNames();
+  for(unsigned int i=0; i<vnames.size(); i++) {
+    string v = vnames[i];
+    m_ledger_snap->setX(v, m_ledger.getX(v));
+    m_ledger_snap->setY(v, m_ledger.getY(v));
+    m_ledger_snap->setHdg(v, m_ledger.getHeading(v));
+    m_ledger_snap->setSpd(v, m_ledger.getSpeed(v));
+    m_ledger_snap->setDep(v, m_ledger.getDepth(v));
+    m_ledger_snap->setLat(v, m_ledger.getLat(v));
+    m_ledger_snap->setLon(v, m_ledger.getLon(v));
+    m_ledger_snap->setUTC(v, m_ledger.getUTC(v));
+    m_ledger_snap->setUTCAge(v, m_ledger.getUTCAge(v));
+    m_ledger_snap->setUTCReceived(v, m_ledger.getUTCReceived(v));
+    m_ledger_snap->setUTCAgeReceived(v, m_ledger.getUTCAgeReceived(v));
+  }
+  m_ledger_snap->setCurrTimeUTC(m_curr_time);
+}
+
+//-----------------------------------------------------------
+// Procedure: updatePlatModel()
+
+void SimVehicle::updatePlatModel()
+{
+  bool ok1, ok2, ok3, ok4;
+  double osx = m_info_buffer->dQuery("NAV_X", ok1);
+  double osy = m_info_buffer->dQuery("NAV_Y", ok2);
+  double osh = m_info_buffer->dQuery("NAV_HEADING", ok3);
+  double osv = m_info_buffer->dQuery("NAV_SPEED", ok4);
+  if(!ok1 || !ok2 || !ok3 || !ok4)
+    return;
+
+  m_pmgen.setCurrTime(m_curr_time);
+  m_hengine->setPlatModel(m_pmgen.generate(osx, osy, osh, osv));
+}
+
+//-----------------------------------------------------------
+// Procedure: handleInitialVars()
+//   Purpose: Apply deferred initial variables not otherwise set by
+//            the first helm iteration. Counterpart of phase 2 of
+//            the helm's handling of initialize directives.
+
+void SimVehicle::handleInitialVars()
+{
+  m_init_vars_done = true;
+
+  vector<VarDataPair> mvector = m_bhv_set->getInitialVariables();
+  for(unsigned int i=0; i<mvector.size(); i++) {
+    VarDataPair msg = mvector[i];
+    string var   = stripBlankEnds(msg.get_var());
+    string sdata = stripBlankEnds(msg.get_sdata());
+    if((tolower(msg.get_key()) != "defer") || m_info_buffer->isKnown(var))
+      continue;
+
+    if(sdata != "") {
+      m_info_buffer->setValue(var, sdata);
+      notify(var, sdata, "pHelmIvP");
+    }
+    else {
+      m_info_buffer->setValue(var, msg.get_ddata());
+      notify(var, msg.get_ddata(), "pHelmIvP");
+    }
+  }
+}
+
+//-----------------------------------------------------------
+// Procedure: handlePokes()
+//   Purpose: Apply scenario pokes that have come due, as if posted
+//            to the vehicle's MOOSDB by an operator or script.
+
+void SimVehicle::handlePokes()
+{
+  double elapsed = m_curr_time - m_start_time;
+  for(unsigned int i=0; i<m_pokes.size(); i++) {
+    if(m_poke_times[i] < 0)
+      continue;
+    if(m_poke_times[i] > elapsed)
+      continue;
+
+    VarDataPair poke = m_pokes[i];
+    if(poke.is_string()) {
+      m_info_buffer->setValue(poke.get_var(), poke.get_sdata());
+      logEntry(poke.get_var(), "ivpsim", poke.get_sdata());
+    }
+    else {
+      m_info_buffer->setValue(poke.get_var(), poke.get_ddata());
+      logEntry(poke.get_var(), "ivpsim", doubleToStringX(poke.get_ddata()));
+    }
+    m_poke_times[i] = -1;
+  }
+}
+
+//-----------------------------------------------------------
+// Procedure: handleMail()
+//   Purpose: Deliver last tick's postings back to the info_buffer
+//            for any variable the behavior set has registered for.
+//            The registered set is refreshed only when behaviors
+//            have been spawned. Alert requests are consumed here as
+//            pContactMgr would.
+
+void SimVehicle::handleMail()
+{
+  if(m_bhv_set->getTCount() != m_info_vars_tcount) {
+    m_info_vars_tcount = m_bhv_set->getTCount();
+    vector<string> info_vars = m_bhv_set->getInfoVars();
+    m_info_vars.insert(info_vars.begin(), info_vars.end());
+  }
+
+  for(unsigned int i=0; i<m_mail.size(); i++) {
+    string var = m_mail[i].get_var();
+    if(var == "BCM_ALERT_REQUEST")
+      handleConfigAlert(m_mail[i].get_sdata(), "helm");
+    if(m_info_vars.count(var) == 0)
+      continue;
+    if(m_mail[i].is_string())
+      m_info_buffer->setValue(var, m_mail[i].get_sdata());
+    else
+      m_info_buffer->setValue(var, m_mail[i].get_ddata());
+  }
+  m_mail.clear();
+}
+
+//-----------------------------------------------------------
+// Procedure: postModeMessages()
+
+void SimVehicle::postModeMessages()
+{
+  vector<VarDataPair> mvector = m_bhv_set->getModeVarDataPairs();
+  for(unsigned int j=0; j<mvector.size(); j++) {
+    VarDataPair msg = mvector[j];
+    string var  = msg.get_var();
+    string mkey = msg.get_key();
+    if(msg.is_string()) {
+      if(detectChangeOnKey(mkey, msg.get_sdata()))
+	notify(var, msg.get_sdata(), "pHelmIvP");
+    }
+    else {
+      if(detectChangeOnKey(mkey, msg.get_ddata()))
+	notify(var, msg.get_ddata(), "pHelmIvP");
+    }
+  }
+}
+
+//-----------------------------------------------------------
+// Procedure: postBehaviorMessages()
+
+void SimVehicle::postBehaviorMessages()
+{
+  m_bhv_set->clearWarnings();
+
+  // Posted on every iteration, as pHelmIvP does, so alogreplay can
+  // find the helm iterations in the logs written here
+  notify("IVPHELM_ITER", m_helm_iteration, "pHelmIvP");
+
+  unsigned int bhv_count = m_bhv_set->size();
+  for(unsigned int i=0; i<bhv_count; i++) {
+    vector<VarDataPair> mvector = m_bhv_set->getMessages(i);
+    for(unsigned int j=0; j<mvector.size(); j++) {
+      VarDataPair msg = mvector[j];
+      string var   = msg.get_var();
+      string sdata = msg.get_sdata();
+      double ddata = msg.get_ddata();
+      string mkey  = msg.get_key();
+
+      // IvP functions are only of use to a live viewer
+      if(var == "BHV_IPF")
+	continue;
+
+      bool key_change = true;
+      if(sdata == "")
+	key_change = detectChangeOnKey(mkey, ddata);
+      else
+	key_change = detectChangeOnKey(mkey, sdata);
+      if(mkey == "repeatable")
+	key_change = true;
+
+      if(msg.is_string()) {
+	m_info_buffer->setValue(var, sdata);
+	if(key_change)
+	  notify(var, sdata, "pHelmIvP");
+      }
+      else {
+	m_info_buffer->setValue(var, ddata);
+	if(key_change)
+	  notify(var, ddata, "pHelmIvP");
+      }
+    }
+  }
+  m_bhv_set->updateStateSpaceVars();
+  m_bhv_set->removeCompletedBehaviors();
+}
+
+//-----------------------------------------------------------
+// Procedure: postLifeEvents()
+
+void SimVehicle::postLifeEvents()
+{
+  vector<LifeEvent> events = m_bhv_set->getLifeEvents();
+  for(unsigned int i=0; i<events.size(); i++) {
+    string str = "time=" + doubleToString(m_curr_time - m_start_time, 2);
+    str += ", iter="  + uintToString(m_helm_iteration);
+    str += ", bname=" + events[i].getBehaviorName();
+    str += ", btype=" + events[i].getBehaviorType();
+    str += ", event=" + events[i].getEventType();
+    str += ", seed="  + events[i].getSpawnString();
+    str += ", posting_index=" + uintToString(i);
+    notify("IVPHELM_LIFE_EVENT", str, "pHelmIvP");
+  }
+  if(events.size() > 0)
+    m_bhv_set->clearLifeEvents();
+}
+
+//-----------------------------------------------------------
+// Procedure: postDefaultVariables()
+//   Purpose: Post default values for any variables not written by
+//            a behavior on this iteration.
+
+void SimVehicle::postDefaultVariables()
+{
+  set<string> message_vars;
+  for(unsigned int i=0; i<m_bhv_set->size(); i++) {
+    vector<VarDataPair> mvector = m_bhv_set->getMessages(i, false);
+    for(unsigned int j=0; j<mvector.size(); j++)
+      message_vars.insert(mvector[j].get_var());
+  }
+
+  vector<VarDataPair> dvector = m_bhv_set->getDefaultVariables();
+  for(unsigned int j=0; j<dvector.size(); j++) {
+    VarDataPair msg = dvector[j];
+    string var = msg.get_var();
+    if(message_vars.count(var))
+      continue;
+    if(msg.is_string()) {
+      m_info_buffer->setValue(var, msg.get_sdata());
+      notify(var, msg.get_sdata(), "pHelmIvP");
+    }
+    else {
+      m_info_buffer->setValue(var, msg.get_ddata());
+      notify(var, msg.get_ddata(), "pHelmIvP");
+    }
+  }
+}
+
+//-----------------------------------------------------------
+// Procedure: postDecisions()
+//   Purpose: Determine the all-stop status of this iteration and
+//            either set the new desired values or an all-stop.
+
+void SimVehicle::postDecisions(const HelmReport& report)
+{
+  string allstop_msg = "clear";
+  if(report.getHalted())
+    allstop_msg = "BehaviorError";
+  else if(report.getOFNUM() == 0)
+    allstop_msg = "NothingToDo";
+
+  if(allstop_msg == "clear") {
+    string missing_dec_vars;
+    for(unsigned int i=0; i<m_ivp_domain.size(); i++) {
+      string domain_var = m_ivp_domain.getVarName(i);
+      if(!report.hasDecision(domain_var) && !m_optional_var[domain_var]) {
+	if(missing_dec_vars != "")
+	  missing_dec_vars += ",";
+	missing_dec_vars += domain_var;
+      }
+    }
+    if(missing_dec_vars != "")
+      allstop_msg = "MissingDecVars:" + missing_dec_vars;
+  }
+
+  postAllStop(allstop_msg);
+  if(allstop_msg != "clear")
+    return;
+
+  for(unsigned int j=0; j<m_ivp_domain.size(); j++) {
+    string domain_var = m_ivp_domain.getVarName(j);
+    if(!report.hasDecision(domain_var))
+      continue;
+    double domain_val = report.getDecision(domain_var);
+    if(domain_var == "course") {
+      m_des_heading = domain_val;
+      notify("DESIRED_HEADING", domain_val, "pHelmIvP");
+    }
+    else {
+      if(domain_var == "speed")
+	m_des_speed = domain_val;
+      else if(domain_var == "depth")
+	m_des_depth = domain_val;
+      notify("DESIRED_" + toupper(domain_var), domain_val, "pHelmIvP");
+    }
+  }
+}
+
+//-----------------------------------------------------------
+// Procedure: postAllStop()
+//      Note: Like the helm, a single iteration without a decision
+//            is tolerated to allow for transitions between modes.
+
+void SimVehicle::postAllStop(string msg)
+{
+  if(msg == m_allstop_msg)
+    return;
+  m_allstop_msg = msg;
+
+  if((msg == "NothingToDo") || strBegins(msg, "MissingDecVars"))
+    m_no_decisions++;
+  else
+    m_no_decisions = 0;
+
+  notify("IVPHELM_ALLSTOP", m_allstop_msg, "pHelmIvP");
+  if(msg == "clear")
+    return;
+
+  if(m_no_decisions == 1) {
+    m_allstop_msg = "IncompleteOrEmptyDecision";
+    return;
+  }
+
+  m_allstop_count++;
+  m_des_heading = 0;
+  m_des_speed   = 0;
+  m_des_depth   = 0;
+  for(unsigned int j=0; j<m_ivp_domain.size(); j++) {
+    string post_alias = "DESIRED_" + toupper(m_ivp_domain.getVarName(j));
+    if(post_alias == "DESIRED_COURSE")
+      post_alias = "DESIRED_HEADING";
+    notify(post_alias, 0.0, "pHelmIvP");
+  }
+}
+
+//-----------------------------------------------------------
+// Procedure: checkForAlerts()
+//   Purpose: Post alert on/off flags as contacts enter or leave
+//            alert range, the subset of pContactMgrV20 needed to
+//            spawn contact behavior templates.
+
+void SimVehicle::checkForAlerts()
+{
+  if(m_map_alerts.size() == 0)
+    return;
+
+  NodeRecord own = m_model.getNodeRecord();
+  double osx = own.getX();
+  double osy = own.getY();
+  double osh = own.getHeading();
+  double osv = own.getSpeed();
+
+  vector<string> vnames = m_ledger.getVNames();
+
+  CPAEngineBatch cpa_batch(osy, osx);
+  for(unsigned int i=0; i<vnames.size(); i++) {
+    string contact = vnames[i];
+    cpa_batch.addContact(m_ledger.getY(contact), m_ledger.getX(contact),
+			 m_ledger.getHeading(contact),
+			 m_ledger.getSpeed(contact));
+  }
+  vector<double> cpas;
+  cpa_batch.evalCPA(osh, osv, 36000, cpas);
+
+  for(unsigned int i=0; i<vnames.size(); i++) {
+    string contact = vnames[i];
+    NodeRecord record = m_ledger.getRecord(contact);
+
+    double cnx = m_ledger.getX(contact);
+    double cny = m_ledger.getY(contact);
+    double range = hypot(osx - cnx, osy - cny);
+    double range_cpa = cpas[i];
+
+    map<string, CMAlert>::iterator q;
+    for(q=m_map_alerts.begin(); q!=m_map_alerts.end(); q++) {
+      string   id = q->first;
+      CMAlert& alert = q->second;
+      if(!alert.valid())
+	continue;
+
+      bool applies = alert.filterCheck(record, osx, osy);
+      double alert_range = alert.getAlertRange();
+      double alert_range_cpa = alert.getAlertRangeFar();
+      if(applies && (alert_range > 0)) {
+	if(range > alert_range_cpa)
+	  applies = false;
+	else if((range > alert_range) && (range_cpa > alert_range))
+	  applies = false;
+      }
+
+      bool alerted = (m_map_alerted[id].count(contact) > 0);
+      vector<VarDataPair> flags;
+      if(applies && !alerted) {
+	flags = alert.getAlertOnFlags();
+	m_map_alerted[id].insert(contact);
+      }
+      else if(!applies && alerted) {
+	flags = alert.getAlertOffFlags();
+	m_map_alerted[id].erase(contact);
+      }
+      for(unsigned int k=0; k<flags.size(); k++)
+	postAlert(record, flags[k]);
+    }
+  }
+}
+
+//-----------------------------------------------------------
+// Procedure: postAlert()
+
+void SimVehicle::postAlert(const NodeRecord& record, VarDataPair pair)
+{
+  string var = pair.get_var();
+  var = findReplace(var, "$[VNAME]", record.getName());
+  var = findReplace(var, "%[VNAME]", record.getName());
+  var = findReplace(var, "$[VTYPE]", record.getType());
+  var = findReplace(var, "%[VTYPE]", tolower(record.getType()));
+
+  if(!pair.is_string()) {
+    notify(var, pair.get_ddata(), "pContactMgrV20");
+    return;
+  }
+
+  string msg = pair.get_sdata();
+  msg = findReplace(msg, "$[X]", record.getStringValue("x"));
+  msg = findReplace(msg, "$[Y]", record.getStringValue("y"));
+  msg = findReplace(msg, "$[SPD]", record.getStringValue("speed"));
+  msg = findReplace(msg, "$[HDG]", record.getStringValue("heading"));
+  msg = findReplace(msg, "$[DEP]", record.getStringValue("depth"));
+  msg = findReplace(msg, "$[VNAME]", record.getName());
+  msg = findReplace(msg, "$[VTYPE]", record.getType());
+  msg = findReplace(msg, "$[GROUP]", record.getGroup());
+  msg = findReplace(msg, "$[UTIME]", record.getStringValue("time"));
+  msg = findReplace(msg, "%[VNAME]", record.getName());
+  msg = findReplace(msg, "%[VTYPE]", tolower(record.getType()));
+  msg = findReplace(msg, "%[GROUP]", tolower(record.getGroup()));
+  notify(var, msg, "pContactMgrV20");
+}
+
+//-----------------------------------------------------------
+// Procedure: detectChangeOnKey()
+
+bool SimVehicle::detectChangeOnKey(const string& key, const string& value)
+{
+  if(key == "")
+    return(true);
+  map<string, string>::iterator p = m_outgoing_key_strings.find(key);
+  if((p != m_outgoing_key_strings.end()) && (p->second == value))
+    return(false);
+  m_outgoing_key_strings[key] = value;
+  return(true);
+}
+
+//-----------------------------------------------------------
+// Procedure: detectChangeOnKey()
+
+bool SimVehicle::detectChangeOnKey(const string& key, double value)
+{
+  if(key == "")
+    return(true);
+  map<string, double>::iterator p = m_outgoing_key_doubles.find(key);
+  if((p != m_outgoing_key_doubles.end()) && (p->second == value))
+    return(false);
+  m_outgoing_key_doubles[key] = value;
+  return(true);
+}
+
+//-----------------------------------------------------------
+// Procedure: notify()
+//   Purpose: Stand-in for a MOOS Notify(). The posting is logged
+//            and queued for delivery on the next tick.
+
+void SimVehicle::notify(string var, string sval, string src)
+{
+  m_mail.push_back(VarDataPair(var, sval));
+  if(m_log)
+    logEntry(var, src, sval);
+}
+
+//-----------------------------------------------------------
+// Procedure: notify()
+
+void SimVehicle::notify(string var, double dval, string src)
+{
+  m_mail.push_back(VarDataPair(var, dval));
+  if(m_log)
+    logEntry(var, src, doubleToStringX(dval, 6));
+}
+
+//-----------------------------------------------------------
+// Procedure: logEntry()
+//   Purpose: Write one line in the column layout of pLogger so
+//            that the alog tools apply to simulator output.
+
+void SimVehicle::logEntry(const string& var, const string& src,
+			  const string& val)
+{
+  if(!m_log)
+    return;
+  fprintf(m_log, "%-15.3f %-20s %-10s %s\n", m_curr_time - m_log_start,
+	  var.c_str(), src.c_str(), val.c_str());
+}
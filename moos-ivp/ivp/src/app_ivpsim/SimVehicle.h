@@ -0,0 +1,179 @@
+/*****************************************************************/
+/*    NAME: agent                                                */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: SimVehicle.h                                         */
+/*    DATE: Oct 19th, 2026                                       */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#ifndef IVPSIM_SIM_VEHICLE_HEADER
+#define IVPSIM_SIM_VEHICLE_HEADER
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include "IvPDomain.h"
+#include "InfoBuffer.h"
+#include "LedgerSnap.h"
+#include "ContactLedger.h"
+#include "BehaviorSet.h"
+#include "HelmEngine.h"
+#include "PlatModelGenerator.h"
+#include "USM_Model.h"
+#include "PIDEngine.h"
+#include "VarDataPair.h"
+#include "NodeRecord.h"
+#include "CMAlert.h"
+
+// One simulated vehicle: the helm, contact ledger, PID controller
+// and vehicle model that would otherwise be pHelmIvP, pMarinePID,
+// uSimMarine and pContactMgr in a separate MOOS community. All
+// stepping is driven by the caller so N vehicles can be advanced in
+// lockstep without a MOOSDB.
+
+class SimVehicle
+{
+ public:
+  SimVehicle(std::string vname);
+  ~SimVehicle();
+
+ public: // Configuration
+  bool setParam(std::string param, std::string value);
+  void offsetStart(double dx, double dy, double dh);
+  bool initialize(double start_utc);
+
+  std::vector<std::string> getWarnings() const {return(m_warnings);}
+  std::string getName() const {return(m_vname);}
+
+ public: // Lockstep phases, called in this order each tick
+  void        propagate(double utc);
+  NodeRecord  getNodeRecord() const;
+  void        handleNodeRecord(const NodeRecord&);
+  void        iterateHelm(double utc);
+  void        iterateControl(double utc);
+
+ public: // Alog output
+  bool openLog(std::string filename, double start_utc);
+  void closeLog();
+
+ public: // Run statistics
+  unsigned int getHelmIterations() const {return(m_helm_iteration);}
+  unsigned int getAllStopCount() const   {return(m_allstop_count);}
+  double       getOdometry() const       {return(m_odometry);}
+  std::string  getAllStopMsg() const     {return(m_allstop_msg);}
+
+ protected: // Configuration utilities
+  bool handleConfigDomain(std::string);
+  bool handleConfigPoke(std::string);
+  bool handleConfigAlert(std::string, std::string src="");
+  bool handleConfigModelParam(std::string);
+  bool handleConfigPIDParam(std::string);
+
+ protected: // Helm utilities, mirroring those in HelmIvP
+  void updateLedgerSnap();
+  void updatePlatModel();
+  void handleInitialVars();
+  void handlePokes();
+  void handleMail();
+  void postModeMessages();
+  void postBehaviorMessages();
+  void postLifeEvents();
+  void postDefaultVariables();
+  void postAllStop(std::string);
+  void postDecisions(const HelmReport&);
+  void checkForAlerts();
+  void postAlert(const NodeRecord&, VarDataPair);
+
+  bool detectChangeOnKey(const std::string& key, const std::string& val);
+  bool detectChangeOnKey(const std::string& key, double val);
+
+ protected: // Posting and logging
+  void notify(std::string var, std::string sval, std::string src);
+  void notify(std::string var, double dval, std::string src);
+  void logEntry(const std::string& var, const std::string& src,
+		const std::string& val);
+
+ protected: // Configuration variables
+  std::string  m_vname;
+  std::string  m_vtype;
+  std::string  m_vcolor;
+  std::string  m_group;
+  double       m_length;
+
+  std::string               m_bhv_file;
+  std::vector<std::string>  m_bhv_dirs;
+  std::string               m_start_pos;
+  std::vector<std::string>  m_model_params;
+  std::map<std::string, std::string> m_pid_params;
+
+  IvPDomain                   m_ivp_domain;
+  std::map<std::string, bool> m_optional_var;
+
+  std::vector<double>      m_poke_times;
+  std::vector<VarDataPair> m_pokes;
+
+ protected: // Component engines
+  InfoBuffer*        m_info_buffer;
+  LedgerSnap*        m_ledger_snap;
+  ContactLedger      m_ledger;
+  HelmEngine*        m_hengine;
+  BehaviorSet*       m_bhv_set;
+  PlatModelGenerator m_pmgen;
+  USM_Model          m_model;
+  PIDEngine          m_pengine;
+
+  std::map<std::string, CMAlert>         m_map_alerts;
+  std::map<std::string, std::set<std::string> > m_map_alerted;
+
+ protected: // State variables
+  double       m_curr_time;
+  double       m_start_time;
+  unsigned int m_helm_iteration;
+  bool         m_init_vars_done;
+
+  // Postings made on one tick and delivered back to this vehicle's
+  // info_buffer at the start of the next, as a MOOSDB would.
+  std::vector<VarDataPair> m_mail;
+  std::set<std::string>    m_info_vars;
+  unsigned int             m_info_vars_tcount;
+
+  std::map<std::string, std::string> m_outgoing_key_strings;
+  std::map<std::string, double>      m_outgoing_key_doubles;
+
+  std::string  m_allstop_msg;
+  unsigned int m_allstop_count;
+  unsigned int m_no_decisions;
+  unsigned int m_no_goal_decisions;
+
+  double       m_des_heading;
+  double       m_des_speed;
+  double       m_des_depth;
+
+  double       m_odometry;
+  double       m_prev_x;
+  double       m_prev_y;
+
+  FILE*        m_log;
+  double       m_log_start;
+
+  std::vector<std::string> m_warnings;
+};
+
+#endif
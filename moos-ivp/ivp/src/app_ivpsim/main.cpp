@@ -0,0 +1,164 @@
+/*****************************************************************/
+/*    NAME: agent                                                */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: main.cpp                                             */
+/*    DATE: Oct 19th, 2026                                       */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#include <string>
+#include <cstdlib>
+#include <iostream>
+#include "MBUtils.h"
+#include "ReleaseInfo.h"
+#include "LockStepSim.h"
+
+using namespace std;
+
+void showExample();
+
+//--------------------------------------------------------
+// Procedure: main
+
+int main(int argc, char *argv[])
+{
+  // Look for a request for version information
+  if(scanArgs(argc, argv, "-v", "--version", "-version")) {
+    showReleaseInfo("ivpsim", "gpl");
+    return(0);
+  }
+  if(scanArgs(argc, argv, "-e", "--example", "-example")) {
+    showExample();
+    return(0);
+  }
+
+  // Look for a request for usage information
+  if(scanArgs(argc, argv, "-h", "--help", "-help")) {
+    cout << "Usage: " << endl;
+    cout << "  ivpsim file.sim [OPTIONS]                                " << endl;
+    cout << "                                                           " << endl;
+    cout << "Synopsis:                                                  " << endl;
+    cout << "  Run one or more vehicles in fast time in a single process" << endl;
+    cout << "  with no MOOSDB. Each vehicle has an IvP Helm, a marine   " << endl;
+    cout << "  PID controller and a uSimMarine vehicle model, all       " << endl;
+    cout << "  stepped in deterministic lockstep. Optionally an alog    " << endl;
+    cout << "  file is written per vehicle.                             " << endl;
+    cout << "                                                           " << endl;
+    cout << "Options:                                                   " << endl;
+    cout << "  -h,--help       Displays this help message               " << endl;
+    cout << "  -v,--version    Displays the current release version     " << endl;
+    cout << "  -e,--example    Show an example scenario file            " << endl;
+    cout << "  --runs=<N>      Number of Monte Carlo runs (default 1)   " << endl;
+    cout << "  --seed=<N>      Random seed of the first run (default 1) " << endl;
+    cout << "  --alog_dir=<d>  Write alog files to the given directory  " << endl;
+    cout << "  --noalog        Do not write alog files                  " << endl;
+    cout << "  --verbose       Report the outcome of each run           " << endl;
+    cout << "                                                           " << endl;
+    cout << "Further Notes:                                             " << endl;
+    cout << "  (1) Command line options override the scenario file.     " << endl;
+    cout << "  (2) Behavior files must be already expanded by nsplug.   " << endl;
+    cout << "  (3) Run k of N is seeded with seed+k, so any one run may " << endl;
+    cout << "      be reproduced on its own.                            " << endl;
+    cout << endl;
+    return(0);
+  }
+
+  string scenario_file;
+  string alog_dir;
+  string runs;
+  string seed;
+  bool   noalog  = false;
+  bool   verbose = false;
+
+  for(int i=1; i<argc; i++) {
+    string argi = argv[i];
+    if(strBegins(argi, "--runs="))
+      runs = argi.substr(7);
+    else if(strBegins(argi, "--seed="))
+      seed = argi.substr(7);
+    else if(strBegins(argi, "--alog_dir="))
+      alog_dir = argi.substr(11);
+    else if(argi == "--noalog")
+      noalog = true;
+    else if(argi == "--verbose")
+      verbose = true;
+    else if(scenario_file == "")
+      scenario_file = argi;
+    else {
+      cout << "Unhandled argument: " << argi << endl;
+      return(1);
+    }
+  }
+
+  if(scenario_file == "") {
+    cout << "No scenario file given - exiting" << endl;
+    return(1);
+  }
+
+  LockStepSim sim;
+  if(!sim.readScenario(scenario_file))
+    return(1);
+
+  if(isNumber(runs))
+    sim.setRuns(atoi(runs.c_str()));
+  if(isNumber(seed))
+    sim.setSeed(atoi(seed.c_str()));
+  if(alog_dir != "")
+    sim.setAlogDir(alog_dir);
+  if(noalog)
+    sim.setAlogDir("");
+  sim.setVerbose(verbose);
+
+  bool ok = sim.run();
+  sim.printSummary();
+  return(ok ? 0 : 1);
+}
+
+//--------------------------------------------------------
+// Procedure: showExample()
+
+void showExample()
+{
+  cout << "// Global params (all optional)                          " << endl;
+  cout << "duration        = 600      // seconds of sim time per run" << endl;
+  cout << "time_step       = 0.25     // seconds per lockstep tick  " << endl;
+  cout << "alog_dir        = sim_logs // no alogs if not given      " << endl;
+  cout << "runs            = 1                                    " << endl;
+  cout << "seed            = 1                                    " << endl;
+  cout << "jitter_pos      = 0        // start x,y jitter, meters   " << endl;
+  cout << "jitter_hdg      = 0        // start heading jitter, degs " << endl;
+  cout << "collision_range = 3                                    " << endl;
+  cout << "                                                       " << endl;
+  cout << "// Vehicle params given outside a block apply to all   " << endl;
+  cout << "domain = course:0:359:360                              " << endl;
+  cout << "domain = speed:0:5:26                                  " << endl;
+  cout << "pid    = speed_factor=20                               " << endl;
+  cout << "sim    = max_acceleration=0.5                          " << endl;
+  cout << "alert  = id=avd, var=CONTACT_INFO, val=\"name=$[VNAME] # " << endl;
+  cout << "         contact=$[VNAME]\", alert_range=40, cpa_range=45" << endl;
+  cout << "                                                       " << endl;
+  cout << "vehicle = abe                                          " << endl;
+  cout << "{                                                      " << endl;
+  cout << "  behaviors = targ_abe.bhv                             " << endl;
+  cout << "  start_pos = x=0,y=-20,heading=180,speed=0            " << endl;
+  cout << "  type      = kayak                                    " << endl;
+  cout << "  poke      = DEPLOY=true                              " << endl;
+  cout << "  poke      = RETURN=true @ 300                        " << endl;
+  cout << "  pid       = yaw_pid_kp=1.5                           " << endl;
+  cout << "}                                                      " << endl;
+}
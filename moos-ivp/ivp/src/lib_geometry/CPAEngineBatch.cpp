@@ -0,0 +1,519 @@
+/*****************************************************************/
+/*    NAME: agent                                                */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: CPAEngineBatch.cpp                                   */
+/*    DATE: Oct 19th, 2026                                       */
+/*                                                               */
+/* This file is part of IvP Helm Core Libs                       */
+/*                                                               */
+/* IvP Helm Core Libs is free software: you can redistribute it  */
+/* and/or modify it under the terms of the Lesser GNU General    */
+/* Public License as published by the Free Software Foundation,  */
+/* either version 3 of the License, or (at your option) any      */
+/* later version.                                                */
+/*                                                               */
+/* IvP Helm Core Libs is distributed in the hope that it will    */
+/* be useful but WITHOUT ANY WARRANTY; without even the implied  */
+/* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR       */
+/* PURPOSE. See the Lesser GNU General Public License for more   */
+/* details.                                                      */
+/*                                                               */
+/* You should have received a copy of the Lesser GNU General     */
+/* Public License along with MOOS-IvP.  If not, see              */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#include <cmath>
+#include "CPAEngineBatch.h"
+#include "AngleUtils.h"
+
+using namespace std;
+
+//----------------------------------------------------------
+// Procedure: degToRadiansX()
+//      Note: Same as CPAEngineRoot::degToRadiansX() so results
+//            agree with CPAEngine to the last bit.
+
+static double degToRadiansX(double deg)
+{
+  return((deg/180.0) * 3.14159265359);
+}
+
+//----------------------------------------------------------
+// Procedure: buildTrigCache()
+//   Purpose: One-degree ownship heading trig tables as built by
+//            CPAEngine::initTrigCache(). Built once and shared by
+//            every engine.
+
+static vector<double> buildTrigCache(bool cosine)
+{
+  vector<double> cache(360, 0);
+  for(unsigned int i=0; i<360; i++) {
+    double rad = degToRadiansX(i);
+    if(cosine)
+      cache[i] = cos((double)(rad));
+    else
+      cache[i] = sin((double)(rad));
+  }
+  return(cache);
+}
+
+static const vector<double>& osCosCache()
+{
+  static const vector<double> cache = buildTrigCache(true);
+  return(cache);
+}
+
+static const vector<double>& osSinCache()
+{
+  static const vector<double> cache = buildTrigCache(false);
+  return(cache);
+}
+
+//----------------------------------------------------------
+// Procedure: headingIndex()
+
+static unsigned int headingIndex(double osh)
+{
+  if((osh >= 360) || (osh < 0))
+    osh = angle360(osh);
+  return((unsigned int)(osh));
+}
+
+//----------------------------------------------------------
+// Procedure: Constructor
+
+CPAEngineBatch::CPAEngineBatch(double osy, double osx)
+{
+  m_osx = osx;
+  m_osy = osy;
+}
+
+//----------------------------------------------------------
+// Procedure: setOwnship()
+//      Note: All contact terms depend on ownship position so
+//            existing contacts are re-evaluated.
+
+void CPAEngineBatch::setOwnship(double osy, double osx)
+{
+  m_osx = osx;
+  m_osy = osy;
+  for(unsigned int i=0; i<m_cnx.size(); i++)
+    setStatic(i);
+}
+
+//----------------------------------------------------------
+// Procedure: clearContacts()
+
+void CPAEngineBatch::clearContacts()
+{
+  m_cnx.clear();
+  m_cny.clear();
+  m_cnh.clear();
+  m_cnv.clear();
+
+  m_stat_k2.clear();
+  m_stat_k1.clear();
+  m_stat_k0.clear();
+  m_stat_range.clear();
+  m_stat_cosCNH_x_cnSPD.clear();
+  m_stat_sinCNH_x_cnSPD.clear();
+  m_stat_cn_to_os_spd.clear();
+  m_stat_closing.clear();
+  m_stat_relang_vth.clear();
+  m_stat_relang_os_cn.clear();
+}
+
+//----------------------------------------------------------
+// Procedure: addContact()
+//   Returns: The index of the new contact
+
+unsigned int CPAEngineBatch::addContact(double cny, double cnx,
+					double cnh, double cnv)
+{
+  m_cnx.push_back(cnx);
+  m_cny.push_back(cny);
+  m_cnh.push_back(cnh);
+  m_cnv.push_back(cnv);
+
+  m_stat_k2.push_back(0);
+  m_stat_k1.push_back(0);
+  m_stat_k0.push_back(0);
+  m_stat_range.push_back(0);
+  m_stat_cosCNH_x_cnSPD.push_back(0);
+  m_stat_sinCNH_x_cnSPD.push_back(0);
+  m_stat_cn_to_os_spd.push_back(0);
+  m_stat_closing.push_back(0);
+  m_stat_relang_vth.push_back(0);
+  m_stat_relang_os_cn.push_back(0);
+
+  unsigned int cix = m_cnx.size() - 1;
+  setStatic(cix);
+  return(cix);
+}
+
+//----------------------------------------------------------
+// Procedure: setStatic()
+//   Purpose: The terms of CPAEngine::setStatic() and initRateCache()
+//            used by the CPA, time of CPA and ROC evaluations, in
+//            the same order of operations.
+
+void CPAEngineBatch::setStatic(unsigned int cix)
+{
+  double osx = m_osx;
+  double osy = m_osy;
+  double cnx = m_cnx[cix];
+  double cny = m_cny[cix];
+  double cnh = m_cnh[cix];
+  double cnv = m_cnv[cix];
+
+  double cnh_radians = degToRadiansX(cnh);
+  double cos_cnh = cos(cnh_radians);
+  double sin_cnh = sin(cnh_radians);
+
+  m_stat_cosCNH_x_cnSPD[cix] = -2 * cos_cnh * cnv;
+  m_stat_sinCNH_x_cnSPD[cix] = -2 * sin_cnh * cnv;
+
+  m_stat_k2[cix] = cnv * cnv;
+
+  double k1  = (-2.0) * osy * cos_cnh * cnv;
+  k1 += (-2.0) * osx * sin_cnh * cnv;
+  k1 += ( 2.0) * cny * cos_cnh * cnv;
+  k1 += ( 2.0) * cnx * sin_cnh * cnv;
+  m_stat_k1[cix] = k1;
+
+  double k0  =          osy * osy;
+  k0 +=          osx * osx;
+  k0 += (-2.0) * osy * cny;
+  k0 += (-2.0) * osx * cnx;
+  k0 +=          cny * cny;
+  k0 +=          cnx * cnx;
+  m_stat_k0[cix] = k0;
+  m_stat_range[cix] = sqrt(k0);
+
+  // Speed of the contact in the direction of ownship
+  double spd = 0;
+  double rel_bng_cn_os = relBearing(cnx, cny, cnh, osx, osy);
+  if(rel_bng_cn_os != 90)
+    spd = cnv * cos(degToRadiansX(rel_bng_cn_os));
+  m_stat_cn_to_os_spd[cix] = spd;
+
+  bool closing = (spd > 0);
+  m_stat_closing[cix] = closing ? 1 : 0;
+  if(closing)
+    m_stat_relang_vth[cix] = relAng(cnx, cny, osx, osy);
+  else
+    m_stat_relang_vth[cix] = relAng(osx, osy, cnx, cny);
+
+  m_stat_relang_os_cn[cix] = relAng(osx, osy, cnx, cny);
+}
+
+//----------------------------------------------------------
+// Procedure: k1Val(), k2Val(), vThresh()
+//   Purpose: The entries CPAEngine caches per ownship heading
+
+double CPAEngineBatch::k1Val(unsigned int cix, unsigned int hix) const
+{
+  double cos_osh = osCosCache()[hix];
+  double sin_osh = osSinCache()[hix];
+
+  double k1_val = ( 2.0) * cos_osh * m_osy;
+  k1_val += ( 2.0) * sin_osh * m_osx;
+  k1_val += (-2.0) * cos_osh * m_cny[cix];
+  k1_val += (-2.0) * sin_osh * m_cnx[cix];
+  return(k1_val);
+}
+
+double CPAEngineBatch::k2Val(unsigned int cix, unsigned int hix) const
+{
+  double cos_osh = osCosCache()[hix];
+  double sin_osh = osSinCache()[hix];
+
+  double k2_val = cos_osh * m_stat_cosCNH_x_cnSPD[cix];
+  k2_val += sin_osh * m_stat_sinCNH_x_cnSPD[cix];
+  return(k2_val);
+}
+
+double CPAEngineBatch::vThresh(unsigned int cix, unsigned int hix) const
+{
+  double delta = (double)(hix) - m_stat_relang_vth[cix];
+  double cos_delta = cos(degToRadiansX(delta));
+  if(cos_delta <= 0.0001)
+    return(999);
+
+  if(m_stat_closing[cix] != 0)
+    return(m_stat_cn_to_os_spd[cix] / cos_delta);
+  return(-m_stat_cn_to_os_spd[cix] / cos_delta);
+}
+
+//----------------------------------------------------------
+// Procedure: evalCPA()
+//   Purpose: Same as CPAEngine::evalCPA() for contact cix
+
+double CPAEngineBatch::evalCPA(unsigned int cix, double osh,
+			       double osv, double ostol) const
+{
+  if(cix >= m_cnx.size())
+    return(0);
+
+  unsigned int hix = headingIndex(osh);
+
+  if(m_stat_closing[cix] != 0) {
+    if(osv > m_stat_cn_to_os_spd[cix]) {
+      if(osv >= vThresh(cix, hix))
+	return(m_stat_range[cix]);
+    }
+  }
+  else {
+    if(osv <= vThresh(cix, hix))
+      return(m_stat_range[cix]);
+  }
+
+  double k2 = m_stat_k2[cix];
+  double k2_val = k2Val(cix, hix);
+  k2_val += osv;
+  k2 += k2_val * osv;
+  if(k2 < 0)
+    return(m_stat_range[cix]);
+
+  double k1 = m_stat_k1[cix] + (k1Val(cix, hix) * osv);
+
+  double minT = 0;
+  if(k2 != 0)
+    minT = k1 / (-2.0 * k2);
+  if(minT <= 0)
+    return(m_stat_range[cix]);
+  if(minT >= ostol)
+    minT = ostol;
+
+  double dist_squared = minT * ((k2 * minT) + k1) + m_stat_k0[cix];
+  if(dist_squared > 0)
+    return(sqrt(dist_squared));
+  return(0);
+}
+
+//----------------------------------------------------------
+// Procedure: evalTimeCPA()
+//   Purpose: Same as CPAEngine::evalTimeCPA() for contact cix
+
+double CPAEngineBatch::evalTimeCPA(unsigned int cix, double osh,
+				   double osv, double ostol) const
+{
+  if(cix >= m_cnx.size())
+    return(0);
+
+  unsigned int hix = headingIndex(osh);
+
+  if(m_stat_closing[cix] != 0) {
+    if(osv >= vThresh(cix, hix))
+      return(0);
+  }
+  else {
+    if(osv <= vThresh(cix, hix))
+      return(0);
+  }
+
+  double k2 = m_stat_k2[cix];
+  double k2_val = k2Val(cix, hix);
+  k2_val += osv;
+  k2 += k2_val * osv;
+  if(k2 < 0)
+    return(0);
+
+  double k1 = m_stat_k1[cix] + (k1Val(cix, hix) * osv);
+
+  double minT = 0;
+  if(k2 != 0)
+    minT = k1 / (-2.0 * k2);
+  if(minT <= 0)
+    minT = 0;
+  return(minT);
+}
+
+//----------------------------------------------------------
+// Procedure: evalROC()
+//   Purpose: Same as CPAEngine::evalROC() for contact cix
+
+double CPAEngineBatch::evalROC(unsigned int cix, double osh,
+			       double osv) const
+{
+  if(cix >= m_cnx.size())
+    return(0);
+
+  unsigned int hix = headingIndex(osh);
+
+  double rel_bng = m_stat_relang_os_cn[cix] - ((double)(hix));
+  if(rel_bng < 0)
+    rel_bng += 360;
+  else if(rel_bng >= 360)
+    rel_bng -= 360;
+
+  double rel_cos = 0;
+  if((rel_bng != 90) && (rel_bng != 270))
+    rel_cos = cos(degToRadiansX(rel_bng));
+
+  double os_to_cn_spd = rel_cos * osv;
+  return(os_to_cn_spd + m_stat_cn_to_os_spd[cix]);
+}
+
+//----------------------------------------------------------
+// Procedure: getRange()
+
+double CPAEngineBatch::getRange(unsigned int cix) const
+{
+  if(cix >= m_cnx.size())
+    return(0);
+  return(m_stat_range[cix]);
+}
+
+//----------------------------------------------------------
+// Procedure: evalCPA()
+//   Purpose: CPA of every contact for one ownship maneuver
+
+void CPAEngineBatch::evalCPA(double osh, double osv, double ostol,
+			     vector<double>& cpas) const
+{
+  unsigned int csize = m_cnx.size();
+  cpas.resize(csize);
+  if(csize == 0)
+    return;
+
+  vector<double> k1s, k2s, vths;
+  buildRows(headingIndex(osh), k1s, k2s, vths);
+  evalRow(k1s, k2s, vths, osv, ostol, &cpas[0]);
+}
+
+//----------------------------------------------------------
+// Procedure: evalROC()
+//   Purpose: Rate of closure of every contact for one maneuver
+
+void CPAEngineBatch::evalROC(double osh, double osv,
+			     vector<double>& rocs) const
+{
+  unsigned int csize = m_cnx.size();
+  rocs.resize(csize);
+  for(unsigned int c=0; c<csize; c++)
+    rocs[c] = evalROC(c, osh, osv);
+}
+
+//----------------------------------------------------------
+// Procedure: evalCPALattice()
+
+void CPAEngineBatch::evalCPALattice(const vector<double>& hdgs,
+				    const vector<double>& spds,
+				    double ostol,
+				    vector<double>& cpas) const
+{
+  unsigned int csize = m_cnx.size();
+  unsigned int hsize = hdgs.size();
+  unsigned int ssize = spds.size();
+
+  cpas.resize(hsize * ssize * csize);
+  if(csize == 0)
+    return;
+
+  vector<double> k1s, k2s, vths;
+  for(unsigned int h=0; h<hsize; h++) {
+    buildRows(headingIndex(hdgs[h]), k1s, k2s, vths);
+    for(unsigned int s=0; s<ssize; s++) {
+      double *row = &cpas[((h * ssize) + s) * csize];
+      evalRow(k1s, k2s, vths, spds[s], ostol, row);
+    }
+  }
+}
+
+//----------------------------------------------------------
+// Procedure: evalMinCPALattice()
+//   Purpose: For each heading/speed the CPA to the nearest contact,
+//            or -1 for each if there are no contacts.
+
+void CPAEngineBatch::evalMinCPALattice(const vector<double>& hdgs,
+				       const vector<double>& spds,
+				       double ostol,
+				       vector<double>& min_cpas) const
+{
+  unsigned int csize = m_cnx.size();
+  unsigned int hsize = hdgs.size();
+  unsigned int ssize = spds.size();
+
+  min_cpas.assign(hsize * ssize, -1);
+  if(csize == 0)
+    return;
+
+  vector<double> k1s, k2s, vths;
+  vector<double> row(csize);
+  for(unsigned int h=0; h<hsize; h++) {
+    buildRows(headingIndex(hdgs[h]), k1s, k2s, vths);
+    for(unsigned int s=0; s<ssize; s++) {
+      evalRow(k1s, k2s, vths, spds[s], ostol, &row[0]);
+      double min_cpa = row[0];
+      for(unsigned int c=1; c<csize; c++) {
+	if(row[c] < min_cpa)
+	  min_cpa = row[c];
+      }
+      min_cpas[(h * ssize) + s] = min_cpa;
+    }
+  }
+}
+
+//----------------------------------------------------------
+// Procedure: buildRows()
+//   Purpose: The per-heading terms of all contacts for heading
+//            index hix, one contiguous row per term.
+
+void CPAEngineBatch::buildRows(unsigned int hix, vector<double>& k1s,
+			       vector<double>& k2s,
+			       vector<double>& vths) const
+{
+  unsigned int csize = m_cnx.size();
+  k1s.resize(csize);
+  k2s.resize(csize);
+  vths.resize(csize);
+  for(unsigned int c=0; c<csize; c++) {
+    k1s[c]  = k1Val(c, hix);
+    k2s[c]  = k2Val(c, hix);
+    vths[c] = vThresh(c, hix);
+  }
+}
+
+//----------------------------------------------------------
+// Procedure: evalRow()
+//   Purpose: evalCPA() for every contact at one heading (given by
+//            the rows) and speed. Each early return of evalCPA() is
+//            folded into a select so the loop has no branches.
+
+void CPAEngineBatch::evalRow(const vector<double>& k1s,
+			     const vector<double>& k2s,
+			     const vector<double>& vths,
+			     double osv, double ostol, double *cpas) const
+{
+  unsigned int csize = m_cnx.size();
+
+  const double *stat_k2 = &m_stat_k2[0];
+  const double *stat_k1 = &m_stat_k1[0];
+  const double *stat_k0 = &m_stat_k0[0];
+  const double *range   = &m_stat_range[0];
+  const double *cn_spd  = &m_stat_cn_to_os_spd[0];
+  const double *closing = &m_stat_closing[0];
+  const double *k1_row  = &k1s[0];
+  const double *k2_row  = &k2s[0];
+  const double *vth_row = &vths[0];
+
+  for(unsigned int c=0; c<csize; c++) {
+    bool opening_early = (osv <= vth_row[c]);
+    bool closing_early = (osv > cn_spd[c]) && (osv >= vth_row[c]);
+    bool early = (closing[c] != 0) ? closing_early : opening_early;
+
+    double k2 = stat_k2[c] + ((k2_row[c] + osv) * osv);
+    double k1 = stat_k1[c] + (k1_row[c] * osv);
+
+    double denom = (k2 != 0) ? (-2.0 * k2) : 1.0;
+    double minT  = (k2 != 0) ? (k1 / denom) : 0.0;
+    early = early || (k2 < 0) || (minT <= 0);
+    minT  = (minT >= ostol) ? ostol : minT;
+
+    double dist_squared = minT * ((k2 * minT) + k1) + stat_k0[c];
+    dist_squared = (dist_squared > 0) ? dist_squared : 0.0;
+    cpas[c] = early ? range[c] : sqrt(dist_squared);
+  }
+}
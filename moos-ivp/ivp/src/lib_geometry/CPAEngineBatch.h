@@ -0,0 +1,113 @@
+/*****************************************************************/
+/*    NAME: agent                                                */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: CPAEngineBatch.h                                     */
+/*    DATE: Oct 19th, 2026                                       */
+/*                                                               */
+/* This file is part of IvP Helm Core Libs                       */
+/*                                                               */
+/* IvP Helm Core Libs is free software: you can redistribute it  */
+/* and/or modify it under the terms of the Lesser GNU General    */
+/* Public License as published by the Free Software Foundation,  */
+/* either version 3 of the License, or (at your option) any      */
+/* later version.                                                */
+/*                                                               */
+/* IvP Helm Core Libs is distributed in the hope that it will    */
+/* be useful but WITHOUT ANY WARRANTY; without even the implied  */
+/* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR       */
+/* PURPOSE. See the Lesser GNU General Public License for more   */
+/* details.                                                      */
+/*                                                               */
+/* You should have received a copy of the Lesser GNU General     */
+/* Public License along with MOOS-IvP.  If not, see              */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+ 
+#ifndef CPA_ENGINE_BATCH_HEADER
+#define CPA_ENGINE_BATCH_HEADER
+
+#include <vector>
+
+//---------------------------------------------------------------
+// A CPAEngineBatch holds one ownship position and many contacts,
+// and evaluates CPA for all of them together. Results are the
+// same as building one CPAEngine per contact, but only the terms
+// evalCPA(), evalTimeCPA() and evalROC() need are kept, per contact
+// in flat arrays, and the per-heading terms are computed only for
+// the headings asked for rather than cached for all 360.
+//
+// For a heading/speed lattice the per-heading terms are laid out
+// contiguously across contacts so the inner loop over contacts is
+// branch free and vectorizes.
+
+class CPAEngineBatch {
+public:
+  CPAEngineBatch(double osy=0, double osx=0);
+  ~CPAEngineBatch() {}
+
+  void   setOwnship(double osy, double osx);
+  void   clearContacts();
+  unsigned int addContact(double cny, double cnx, double cnh, double cnv);
+
+  unsigned int size() const  {return(m_cnx.size());}
+
+public: // One contact, same as CPAEngine for that contact
+  double evalCPA(unsigned int cix, double osh, double osv, double ostol) const;
+  double evalTimeCPA(unsigned int cix, double osh, double osv, double ostol) const;
+  double evalROC(unsigned int cix, double osh, double osv) const;
+  double getRange(unsigned int cix) const;
+
+public: // All contacts for one ownship maneuver
+  void   evalCPA(double osh, double osv, double ostol,
+		 std::vector<double>& cpas) const;
+  void   evalROC(double osh, double osv,
+		 std::vector<double>& rocs) const;
+
+public: // All contacts over a heading/speed lattice. Results are
+        // indexed ((h * spds.size()) + s) * size() + c for the full
+        // set, or (h * spds.size()) + s for the min over contacts.
+  void   evalCPALattice(const std::vector<double>& hdgs,
+			const std::vector<double>& spds, double ostol,
+			std::vector<double>& cpas) const;
+  void   evalMinCPALattice(const std::vector<double>& hdgs,
+			   const std::vector<double>& spds, double ostol,
+			   std::vector<double>& min_cpas) const;
+
+protected:
+  void   setStatic(unsigned int cix);
+  void   buildRows(unsigned int hix, std::vector<double>& k1s,
+		   std::vector<double>& k2s,
+		   std::vector<double>& vths) const;
+  void   evalRow(const std::vector<double>& k1s,
+		 const std::vector<double>& k2s,
+		 const std::vector<double>& vths,
+		 double osv, double ostol, double *cpas) const;
+
+  double k1Val(unsigned int cix, unsigned int hix) const;
+  double k2Val(unsigned int cix, unsigned int hix) const;
+  double vThresh(unsigned int cix, unsigned int hix) const;
+
+protected: // Ownship position
+  double m_osx;
+  double m_osy;
+
+  // Contact positions, headings and speeds
+  std::vector<double> m_cnx;
+  std::vector<double> m_cny;
+  std::vector<double> m_cnh;
+  std::vector<double> m_cnv;
+
+  // Per contact terms independent of ownship heading and speed
+  std::vector<double> m_stat_k2;
+  std::vector<double> m_stat_k1;
+  std::vector<double> m_stat_k0;
+  std::vector<double> m_stat_range;
+  std::vector<double> m_stat_cosCNH_x_cnSPD;
+  std::vector<double> m_stat_sinCNH_x_cnSPD;
+  std::vector<double> m_stat_cn_to_os_spd;
+  std::vector<double> m_stat_closing;     // 1 if closing, else 0
+  std::vector<double> m_stat_relang_vth;  // Angle for speed thresholds
+  std::vector<double> m_stat_relang_os_cn;
+};
+
+#endif
@@ -74,6 +74,7 @@ bool DubinsCache::buildCache(unsigned int hdg_choices)
   if((m_turn_radius < 0) || (hdg_choices < 12))
     return(false);
     
+  m_hdg_choices = hdg_choices;
   m_dturns.clear();
   for(unsigned int i=0; i<m_hdg_choices; i++) {
     double delta = 360.0 / (double)(m_hdg_choices);
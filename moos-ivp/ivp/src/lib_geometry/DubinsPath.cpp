@@ -0,0 +1,181 @@
+/*****************************************************************/
+/*    NAME: agent                                                */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: DubinsPath.cpp                                       */
+/*    DATE: Oct 19th, 2026                                       */
+/*                                                               */
+/* This file is part of IvP Helm Core Libs                       */
+/*                                                               */
+/* IvP Helm Core Libs is free software: you can redistribute it  */
+/* and/or modify it under the terms of the Lesser GNU General    */
+/* Public License as published by the Free Software Foundation,  */
+/* either version 3 of the License, or (at your option) any      */
+/* later version.                                                */
+/*                                                               */
+/* IvP Helm Core Libs is distributed in the hope that it will    */
+/* be useful but WITHOUT ANY WARRANTY; without even the implied  */
+/* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR       */
+/* PURPOSE. See the Lesser GNU General Public License for more   */
+/* details.                                                      */
+/*                                                               */
+/* You should have received a copy of the Lesser GNU General     */
+/* Public License along with MOOS-IvP.  If not, see              */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#include <cmath> 
+#include "DubinsPath.h"
+#include "GeomUtils.h"
+#include "AngleUtils.h"
+
+using namespace std;
+
+#define MPI 3.14159265359
+
+//----------------------------------------------------------
+// Procedure: Constructor
+
+DubinsPath::DubinsPath(double osx, double osy, double osh, double rad) 
+{
+  m_osx = osx;
+  m_osy = osy;
+  m_osh = angle360(osh);
+  m_rad = rad;
+
+  m_ax = osx;
+  m_ay = osy;
+  m_tx = osx;
+  m_ty = osy;
+  m_end_hdg = m_osh;
+  m_gx = osx;
+  m_gy = osy;
+
+  m_arc_length = 0;
+  m_ray_length = 0;
+  m_turn_type  = 0;    // 0 no turn, -1 port turn, +1 starboard
+}
+
+//----------------------------------------------------------------
+// Procedure: setGoal()
+//   Returns: false if the turn radius is negative
+
+bool DubinsPath::setGoal(double gx, double gy)
+{
+  if(m_rad < 0)
+    return(false);
+
+  m_ax = m_osx;
+  m_ay = m_osy;
+  m_tx = m_osx;
+  m_ty = m_osy;
+  m_end_hdg = m_osh;
+  m_gx = gx;
+  m_gy = gy;
+  m_arc_length = 0;
+  m_ray_length = 0;
+  m_turn_type  = 0;
+
+  double dist = hypot(gx - m_osx, gy - m_osy);
+  if(dist == 0)
+    return(true);
+
+  // Special case: with no turn radius the path is a straight line
+  if(m_rad == 0) {
+    m_end_hdg = relAng(m_osx, m_osy, gx, gy);
+    m_ray_length = dist;
+    return(true);
+  }
+
+  // General case: evaluate both turns and keep the shorter one. The
+  // goal can be inside at most one of the two turn circles.
+  DubinsPath star_path(*this);
+  bool star_ok = star_path.evalTurn(1, gx, gy);
+  bool port_ok = evalTurn(-1, gx, gy);
+
+  if(star_ok && (!port_ok || (star_path.getLength() < getLength())))
+    *this = star_path;
+
+  if(m_arc_length == 0)
+    m_turn_type = 0;
+
+  return(true);
+}
+
+//----------------------------------------------------------------
+// Procedure: evalTurn()
+//   Purpose: Build the path for one turn direction, where the turn
+//            circle center is on ownship's beam. On the circle, at
+//            compass angle theta from the center, a vehicle turning
+//            to starboard has heading theta+90, and turning to port
+//            has heading theta-90. The straight leg leaves the circle
+//            where the line to the goal is tangent to the circle.
+//   Returns: false if the goal is inside the turn circle
+
+bool DubinsPath::evalTurn(int turn_type, double gx, double gy)
+{
+  double beam = angle360(m_osh + (90 * turn_type));
+  projectPoint(beam, m_rad, m_osx, m_osy, m_ax, m_ay);
+
+  double dist = hypot(gx - m_ax, gy - m_ay);
+  if(dist < m_rad) {
+    // Allow for a goal on the circle, up to round-off
+    if(dist < m_rad * (1 - 1e-9))
+      return(false);
+    dist = m_rad;
+  }
+
+  double theta0 = angle360(beam + 180);
+  double beta   = relAng(m_ax, m_ay, gx, gy);
+  double alpha  = acos(m_rad / dist) * 180.0 / MPI;
+
+  double theta_tan = 0;
+  double sweep = 0;
+  if(turn_type == 1) {
+    theta_tan = angle360(beta - alpha);
+    sweep = angle360(theta_tan - theta0);
+  }
+  else {
+    theta_tan = angle360(beta + alpha);
+    sweep = angle360(theta0 - theta_tan);
+  }
+  // A goal dead ahead may round to a sweep of nearly 0 or 360
+  if((sweep < 1e-9) || (sweep > (360 - 1e-6)))
+    sweep = 0;
+
+  projectPoint(theta_tan, m_rad, m_ax, m_ay, m_tx, m_ty);
+  m_end_hdg = angle360(theta_tan + (90 * turn_type));
+  if(sweep == 0)
+    m_end_hdg = m_osh;
+
+  m_arc_length = m_rad * sweep * MPI / 180.0;
+  m_ray_length = sqrt((dist * dist) - (m_rad * m_rad));
+  m_turn_type  = turn_type;
+  return(true);
+}
+
+//----------------------------------------------------------------
+// Procedure: getSegList()
+//   Purpose: Ownship's position, points along the turn every
+//            step_deg degrees, the end of the turn and the goal.
+
+XYSegList DubinsPath::getSegList(double step_deg) const
+{
+  XYSegList segl;
+  segl.add_vertex(m_osx, m_osy);
+
+  if((m_turn_type != 0) && (m_rad > 0) && (step_deg > 0)) {
+    double theta0 = relAng(m_ax, m_ay, m_osx, m_osy);
+    double sweep  = (m_arc_length / m_rad) * 180.0 / MPI;
+    for(double delta=step_deg; delta<sweep; delta+=step_deg) {
+      double px, py;
+      projectPoint(theta0 + (m_turn_type * delta), m_rad, m_ax, m_ay, px, py);
+      segl.add_vertex(px, py);
+    }
+    segl.add_vertex(m_tx, m_ty);
+  }
+
+  if((m_gx != segl.get_vx(segl.size()-1)) ||
+     (m_gy != segl.get_vy(segl.size()-1)))
+    segl.add_vertex(m_gx, m_gy);
+  return(segl);
+}
@@ -0,0 +1,89 @@
+/*****************************************************************/
+/*    NAME: agent                                                */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: DubinsPath.h                                         */
+/*    DATE: Oct 19th, 2026                                       */
+/*                                                               */
+/* This file is part of IvP Helm Core Libs                       */
+/*                                                               */
+/* IvP Helm Core Libs is free software: you can redistribute it  */
+/* and/or modify it under the terms of the Lesser GNU General    */
+/* Public License as published by the Free Software Foundation,  */
+/* either version 3 of the License, or (at your option) any      */
+/* later version.                                                */
+/*                                                               */
+/* IvP Helm Core Libs is distributed in the hope that it will    */
+/* be useful but WITHOUT ANY WARRANTY; without even the implied  */
+/* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR       */
+/* PURPOSE. See the Lesser GNU General Public License for more   */
+/* details.                                                      */
+/*                                                               */
+/* You should have received a copy of the Lesser GNU General     */
+/* Public License along with MOOS-IvP.  If not, see              */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+ 
+#ifndef DUBINS_PATH_HEADER
+#define DUBINS_PATH_HEADER
+
+#include "XYSegList.h"
+
+// A Dubins path from ownship's present pose to a goal point with no
+// required arrival heading: a turn at the given radius, to port or
+// starboard, followed by a straight leg to the goal. Of the two turn
+// directions the shorter feasible path is chosen. A goal inside one
+// turn circle can only be reached by turning the other way.
+
+class DubinsPath {
+public:
+  DubinsPath(double osx=0, double osy=0, double osh=0, double rad=0);
+  ~DubinsPath() {};
+
+  bool setGoal(double gx, double gy);
+
+  double getLength() const {return(m_arc_length + m_ray_length);}
+  double getArcLen() const {return(m_arc_length);}
+  double getRayLen() const {return(m_ray_length);}
+
+  double getArcCX() const {return(m_ax);}
+  double getArcCY() const {return(m_ay);}
+  double getArcRad() const {return(m_rad);}
+
+  // The point where the turn ends and the straight leg begins
+  double getTanX() const {return(m_tx);}
+  double getTanY() const {return(m_ty);}
+  double getEndHdg() const {return(m_end_hdg);}
+
+  bool   starTurn() const {return(m_turn_type == 1);}
+  bool   portTurn() const {return(m_turn_type == -1);}
+  bool   noTurn()   const {return(m_turn_type == 0);}
+
+  // The path as vertices, the turn sampled every step_deg degrees
+  XYSegList getSegList(double step_deg=5) const;
+
+private:
+  bool evalTurn(int turn_type, double gx, double gy);
+
+private:
+  // configuration variables
+  double m_osx;
+  double m_osy;
+  double m_osh;
+  double m_rad;
+
+  // Variables dynamically determined
+  double m_ax;
+  double m_ay;
+  double m_tx;
+  double m_ty;
+  double m_end_hdg;
+  double m_gx;
+  double m_gy;
+
+  double m_arc_length;
+  double m_ray_length;
+
+  int    m_turn_type;
+};
+
+#endif
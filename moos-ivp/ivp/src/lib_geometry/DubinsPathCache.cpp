@@ -0,0 +1,141 @@
+/*****************************************************************/
+/*    NAME: agent                                                */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: DubinsPathCache.cpp                                  */
+/*    DATE: Oct 19th, 2026                                       */
+/*                                                               */
+/* This file is part of IvP Helm Core Libs                       */
+/*                                                               */
+/* IvP Helm Core Libs is free software: you can redistribute it  */
+/* and/or modify it under the terms of the Lesser GNU General    */
+/* Public License as published by the Free Software Foundation,  */
+/* either version 3 of the License, or (at your option) any      */
+/* later version.                                                */
+/*                                                               */
+/* IvP Helm Core Libs is distributed in the hope that it will    */
+/* be useful but WITHOUT ANY WARRANTY; without even the implied  */
+/* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR       */
+/* PURPOSE. See the Lesser GNU General Public License for more   */
+/* details.                                                      */
+/*                                                               */
+/* You should have received a copy of the Lesser GNU General     */
+/* Public License along with MOOS-IvP.  If not, see              */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#include <cstring> 
+#include "DubinsPathCache.h"
+
+using namespace std;
+
+//----------------------------------------------------------
+// Procedure: Constructor
+
+DubinsPathCache::DubinsPathCache(unsigned int max_fans) :
+  m_fans(max_fans)
+{
+  m_hits   = 0;
+  m_misses = 0;
+}
+
+//----------------------------------------------------------
+// Procedure: shared()
+//   Purpose: The one cache shared by all users in this process
+
+DubinsPathCache& DubinsPathCache::shared()
+{
+  static DubinsPathCache cache;
+  return(cache);
+}
+
+//----------------------------------------------------------
+// Procedure: setCapacity()
+
+void DubinsPathCache::setCapacity(unsigned int max_fans)
+{
+  lock_guard<mutex> lock(m_mutex);
+  m_fans.setCapacity(max_fans);
+}
+
+//----------------------------------------------------------
+// Procedure: clear()
+
+void DubinsPathCache::clear()
+{
+  lock_guard<mutex> lock(m_mutex);
+  m_fans.clear();
+  m_hits   = 0;
+  m_misses = 0;
+}
+
+//----------------------------------------------------------
+// Procedure: getTurnFan()
+//   Purpose: Return the DubinsCache of turns from the given pose,
+//            built once for all users asking with the same pose
+//            in the same helm iteration, e.g. one wall avoidance
+//            behavior per wall.
+
+shared_ptr<const DubinsCache>
+DubinsPathCache::getTurnFan(double osx, double osy, double osh,
+			    double rad, unsigned int hdg_choices)
+{
+  DubinsKey key;
+  key.m_v[0] = exactKey(osx);
+  key.m_v[1] = exactKey(osy);
+  key.m_v[2] = exactKey(osh);
+  key.m_v[3] = exactKey(rad);
+  key.m_v[4] = hdg_choices;
+
+  shared_ptr<const DubinsCache> fan;
+  {
+    lock_guard<mutex> lock(m_mutex);
+    if(m_fans.find(key, fan)) {
+      m_hits++;
+      return(fan);
+    }
+    m_misses++;
+  }
+
+  shared_ptr<DubinsCache> new_fan(new DubinsCache);
+  new_fan->setParams(osx, osy, osh, rad);
+  new_fan->buildCache(hdg_choices);
+  fan = new_fan;
+
+  lock_guard<mutex> lock(m_mutex);
+  m_fans.insert(key, fan);
+  return(fan);
+}
+
+//----------------------------------------------------------
+// Procedure: getHits(), getMisses(), getFanCount()
+
+unsigned long DubinsPathCache::getHits() const
+{
+  lock_guard<mutex> lock(m_mutex);
+  return(m_hits);
+}
+
+unsigned long DubinsPathCache::getMisses() const
+{
+  lock_guard<mutex> lock(m_mutex);
+  return(m_misses);
+}
+
+unsigned int DubinsPathCache::getFanCount() const
+{
+  lock_guard<mutex> lock(m_mutex);
+  return(m_fans.size());
+}
+
+//----------------------------------------------------------
+// Procedure: exactKey()
+
+long long DubinsPathCache::exactKey(double val) const
+{
+  if(val == 0)
+    val = 0;  // Treat -0 and +0 the same
+
+  long long key = 0;
+  memcpy(&key, &val, sizeof(key));
+  return(key);
+}
@@ -0,0 +1,128 @@
+/*****************************************************************/
+/*    NAME: agent                                                */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: DubinsPathCache.h                                    */
+/*    DATE: Oct 19th, 2026                                       */
+/*                                                               */
+/* This file is part of IvP Helm Core Libs                       */
+/*                                                               */
+/* IvP Helm Core Libs is free software: you can redistribute it  */
+/* and/or modify it under the terms of the Lesser GNU General    */
+/* Public License as published by the Free Software Foundation,  */
+/* either version 3 of the License, or (at your option) any      */
+/* later version.                                                */
+/*                                                               */
+/* IvP Helm Core Libs is distributed in the hope that it will    */
+/* be useful but WITHOUT ANY WARRANTY; without even the implied  */
+/* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR       */
+/* PURPOSE. See the Lesser GNU General Public License for more   */
+/* details.                                                      */
+/*                                                               */
+/* You should have received a copy of the Lesser GNU General     */
+/* Public License along with MOOS-IvP.  If not, see              */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+ 
+#ifndef DUBINS_PATH_CACHE_HEADER
+#define DUBINS_PATH_CACHE_HEADER
+
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include "DubinsCache.h"
+
+// A thread-safe, least-recently-used cache of turn fans, meant to
+// be shared by behaviors in one process through
+// DubinsPathCache::shared(). A turn fan (DubinsCache) is the set of
+// Dubins turns from one pose to each of a number of headings, e.g.
+// as needed by each wall avoidance behavior in a helm iteration.
+// Fans are keyed exactly since callers build further geometry from
+// them, and are handed out shared and read-only.
+//
+// Single Dubins paths (DubinsPath) are not cached. A path costs well
+// under a microsecond to build, about what a locked lookup costs.
+
+class DubinsKey {
+public:
+  DubinsKey() {for(int i=0; i<5; i++) m_v[i]=0;}
+  bool operator<(const DubinsKey& k) const {
+    for(int i=0; i<5; i++)
+      if(m_v[i] != k.m_v[i])
+	return(m_v[i] < k.m_v[i]);
+    return(false);
+  }
+  long long m_v[5];
+};
+
+template <class T> class DubinsLRU {
+public:
+  DubinsLRU(unsigned int capacity) {m_capacity=capacity;}
+
+  bool find(const DubinsKey& key, T& val) {
+    typename std::map<DubinsKey, Iter>::iterator p = m_index.find(key);
+    if(p == m_index.end())
+      return(false);
+    m_items.splice(m_items.begin(), m_items, p->second);
+    val = p->second->second;
+    return(true);
+  }
+  void insert(const DubinsKey& key, const T& val) {
+    if((m_capacity == 0) || (m_index.count(key) != 0))
+      return;
+    m_items.push_front(std::make_pair(key, val));
+    m_index[key] = m_items.begin();
+    trim();
+  }
+  void setCapacity(unsigned int capacity) {m_capacity=capacity; trim();}
+  void clear() {m_items.clear(); m_index.clear();}
+  unsigned int size() const {return(m_index.size());}
+
+private:
+  void trim() {
+    while(m_index.size() > m_capacity) {
+      m_index.erase(m_items.back().first);
+      m_items.pop_back();
+    }
+  }
+
+  typedef typename std::list<std::pair<DubinsKey, T> >::iterator Iter;
+
+  unsigned int m_capacity;
+  std::list<std::pair<DubinsKey, T> > m_items;
+  std::map<DubinsKey, Iter> m_index;
+};
+
+class DubinsPathCache {
+public:
+  DubinsPathCache(unsigned int max_fans=16);
+  ~DubinsPathCache() {};
+
+  static DubinsPathCache& shared();
+
+public: // Setters
+  void setCapacity(unsigned int max_fans);
+  void clear();
+
+public: // Getters
+  std::shared_ptr<const DubinsCache>
+  getTurnFan(double osx, double osy, double osh,
+	     double rad, unsigned int hdg_choices=360);
+
+  unsigned long getHits() const;
+  unsigned long getMisses() const;
+  unsigned int  getFanCount() const;
+
+private:
+  long long exactKey(double val) const;
+
+private:
+  unsigned long m_hits;
+  unsigned long m_misses;
+
+  DubinsLRU<std::shared_ptr<const DubinsCache> > m_fans;
+
+  mutable std::mutex m_mutex;
+};
+
+#endif
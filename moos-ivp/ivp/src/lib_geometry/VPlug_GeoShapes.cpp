@@ -529,11 +529,22 @@ bool VPlug_GeoShapes::updateGrid(const string& delta)
 //            handled in the call to the grid.
 
 bool VPlug_GeoShapes::updateConvexGrid(const string& delta)
+{
+  // Parse once here rather than once per grid
+  XYGridUpdate update = stringToGridUpdate(delta);
+  return(updateConvexGrid(update));
+}
+
+//-----------------------------------------------------------
+// Procedure: updateConvexGrid()
+//      Note: The update may have arrived in text or binary form
+
+bool VPlug_GeoShapes::updateConvexGrid(const XYGridUpdate& update)
 {
   bool ok = true;
 
   for(unsigned int i=0; i<m_convex_grids.size(); i++)
-    ok = ok && m_convex_grids[i].processDelta(delta);
+    ok = ok && m_convex_grids[i].processDelta(update);
 
   return(ok);
 }
@@ -112,6 +112,7 @@ public:
 
   bool updateGrid(const std::string&);
   bool updateConvexGrid(const std::string&);
+  bool updateConvexGrid(const XYGridUpdate&);
 
   unsigned int sizePolygons() const    {return(m_polygons.size());}
   unsigned int sizeSegLists() const    {return(m_seglists.size());}
@@ -136,6 +136,31 @@ bool VPlug_GeoShapesMap::addGeoShape(const string& param_orig,
   return(handled);
 }
 
+//----------------------------------------------------------------
+// Procedure: addGeoShape()
+//      Note: Binary valued geo shape mail. Currently only grid
+//            updates have a binary form (see XYGridUpdate).
+
+bool VPlug_GeoShapesMap::addGeoShape(const string& param_orig, 
+				     const vector<unsigned char>& value, 
+				     const string& vname)
+{
+  string param = toupper(param_orig);
+  if((param != "VIEW_GRID_DELTA") || (value.size() == 0))
+    return(false);
+
+  XYGridUpdate update;
+  if(!update.setFromBinary(value.data(), value.size()))
+    return(false);
+
+  unsigned int starting_map_size = m_geoshapes_map.size();
+  bool handled = m_geoshapes_map[vname].updateConvexGrid(update);
+  if(m_geoshapes_map.size() > starting_map_size)
+    refreshVehiNames();
+
+  return(handled);
+}
+
 //----------------------------------------------------------------
 // Procedure: manageMemory()
 
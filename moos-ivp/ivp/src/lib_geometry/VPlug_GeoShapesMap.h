@@ -44,6 +44,10 @@ public:
 		     const std::string& community, 
 		     double time=0);
 
+  bool   addGeoShape(const std::string& param, 
+		     const std::vector<unsigned char>& value, 
+		     const std::string& community);
+
   void   manageMemory(double curr_time);
   
   double getXMin() const {return(m_xmin);}
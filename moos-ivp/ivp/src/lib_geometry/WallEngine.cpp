@@ -27,6 +27,7 @@
 #include <cmath> 
 #include <algorithm>
 #include "WallEngine.h"
+#include "DubinsPathCache.h"
 #include "GeomUtils.h"
 #include "AngleUtils.h"
 #include "ArcUtils.h"
@@ -77,8 +78,9 @@ bool WallEngine::setEngine(double osx, double osy, double osh, double radius,
   m_hdg_choices = hdg_choices;
   m_walls = walls;
 
-  m_dcache.setParams(osx, osy, osh, radius);
-  m_dcache.buildCache(m_hdg_choices);
+  // Behaviors sharing ownship's pose share the same turns
+  m_dcache = DubinsPathCache::shared().getTurnFan(osx, osy, osh, radius,
+						  m_hdg_choices);
 
   //buildWallSegCache();
   buildBaseProxCache();
@@ -165,10 +167,10 @@ double WallEngine::getXCPA(double osh, double osv,
 
 void WallEngine::buildHitCacheDubins()
 {
-  if(!m_dcache.valid())
+  if(!m_dcache || !m_dcache->valid())
     return;
 
-  unsigned int dsize = m_dcache.size();
+  unsigned int dsize = m_dcache->size();
   for(unsigned int i=0; i<dsize; i++) {
     vector<double> vcpa;
     vector<double> vdcpa;
@@ -188,10 +190,10 @@ void WallEngine::buildHitCacheDubins()
   for(unsigned int i=0; i<dsize; i++) {
 
     double ax,ay,ar,lang,rang;
-    m_dcache.getArcIX(i, ax,ay,ar, lang,rang);
+    m_dcache->getArcIX(i, ax,ay,ar, lang,rang);
 
     bool langle_is_origin = true;
-    if(m_dcache.portTurnIX(i))
+    if(m_dcache->portTurnIX(i))
       langle_is_origin = false;
     
     for(unsigned int j=0; j<m_walls.size(); j++) {
@@ -215,9 +217,9 @@ void WallEngine::buildHitCacheDubins()
   for(unsigned int i=0; i<dsize; i++) {
     double ray_angle = hdg_delta * (double)(i);
     double rx, ry;
-    m_dcache.getRayIX(i, rx, ry);
+    m_dcache->getRayIX(i, rx, ry);
 
-    double arc_len = m_dcache.getArcLenIX(i);
+    double arc_len = m_dcache->getArcLenIX(i);
     
     for(unsigned int j=0; j<m_walls.size(); j++) {
       vector<double> vcpa;
@@ -243,14 +245,14 @@ void WallEngine::buildHitCacheDubins()
 vector<ProxPoint> WallEngine::getArcProxPoints(unsigned int ix)
 {
   vector<ProxPoint> ppts;
-  if(!m_dcache.valid())
+  if(!m_dcache || !m_dcache->valid())
     return(ppts);
 
-  if(ix >= m_dcache.size())
+  if(ix >= m_dcache->size())
     return(ppts);
   
-  double arc_len = m_dcache.getArcLenIX(ix);
-  bool port_turn = m_dcache.portTurnIX(ix);
+  double arc_len = m_dcache->getArcLenIX(ix);
+  bool port_turn = m_dcache->portTurnIX(ix);
 
   if(port_turn) {
     bool done = false;
@@ -280,25 +282,25 @@ vector<ProxPoint> WallEngine::getArcProxPoints(unsigned int ix)
 
 void WallEngine::buildProxCache()
 {
-  if(!m_dcache.valid())
+  if(!m_dcache || !m_dcache->valid())
     return;
 
-  for(unsigned int i=0; i<m_dcache.size(); i++) {
+  for(unsigned int i=0; i<m_dcache->size(); i++) {
     vector<ProxPoint> pcache;
     m_prox_cache.push_back(pcache);
   }
 
   // Part 1: Get the Arc prox points from the base prox caches
-  for(unsigned int i=0; i<m_dcache.size(); i++) 
+  for(unsigned int i=0; i<m_dcache->size(); i++) 
     m_prox_cache[i] = getArcProxPoints(i);
 
   // Part 2: Get the Ray prox points
-  for(unsigned int i=0; i<m_dcache.size(); i++) {
+  for(unsigned int i=0; i<m_dcache->size(); i++) {
     double rx, ry;
-    m_dcache.getRayIX(i, rx, ry);
-    double ray_angle = m_dcache.getTurnHdgIX(i);
+    m_dcache->getRayIX(i, rx, ry);
+    double ray_angle = m_dcache->getTurnHdgIX(i);
 
-    double arc_len = m_dcache.getArcLenIX(i);
+    double arc_len = m_dcache->getArcLenIX(i);
     
     for(unsigned int j=0; j<m_walls.size(); j++) {
       vector<double> vcpa;
@@ -317,7 +319,7 @@ void WallEngine::buildProxCache()
   }
 
   // Part 3: Make sure the prox cache for each turn is sorted
-  for(unsigned int i=0; i<m_dcache.size(); i++) {
+  for(unsigned int i=0; i<m_dcache->size(); i++) {
     if(m_prox_cache[i].size() > 0)
       sort(m_prox_cache[i].begin(), m_prox_cache[i].end());
   }
@@ -400,14 +402,14 @@ void WallEngine::buildBaseProxCache()
 {
   cout << "Make Base Prox Cache (START)" << endl;
   cout << "  m_prox_thresh:" << m_prox_thresh << endl;
-  if(!m_dcache.valid())
+  if(!m_dcache || !m_dcache->valid())
     return;
 
   // The arc representing the full turn(s)
   double ax,ay,ar,lang,rang;
 
   // Part 1: Make the Starboard ProxPoint Cache
-  m_dcache.getMaxStarTurn(ax,ay,ar, lang,rang);
+  m_dcache->getMaxStarTurn(ax,ay,ar, lang,rang);
 
 #if 0
   cout << "max_star_turn: " << endl;
@@ -436,7 +438,7 @@ void WallEngine::buildBaseProxCache()
   }
 
   // Part 2: Make the Port ProxPoint Cache
-  m_dcache.getMaxPortTurn(ax,ay,ar, lang,rang);
+  m_dcache->getMaxPortTurn(ax,ay,ar, lang,rang);
 
 #if 0
   cout << "max_port_turn: " << endl;
@@ -499,7 +501,7 @@ void WallEngine::print(unsigned int low_ix, unsigned int hgh_ix) const
 #if 0
   for(unsigned int i=low_ix; i<hgh_ix; i++) {
     cout << "Heading: " << i << endl;
-    cout << "arclen:  " << i << " = " << m_dcache.getArcLenIX(i) << endl;
+    cout << "arclen:  " << i << " = " << m_dcache->getArcLenIX(i) << endl;
     for(unsigned int j=0; j<m_cache_cpa[i].size(); j++) {
       cout << "cpa[" << j << "]: " << m_cache_cpa[i][j];
       cout << "   dcpa[" << j << "]: " << m_cache_dcpa[i][j] << endl;
@@ -509,7 +511,7 @@ void WallEngine::print(unsigned int low_ix, unsigned int hgh_ix) const
 
   for(unsigned int i=low_ix; i<=hgh_ix; i++) {
     cout << "Heading: " << i << endl;
-    cout << "arclen:  " << i << " = " << m_dcache.getArcLenIX(i) << endl;
+    cout << "arclen:  " << i << " = " << m_dcache->getArcLenIX(i) << endl;
     for(unsigned int j=0; j<m_prox_cache[i].size(); j++) {
       cout << "cpa[" << j << "]: " << m_prox_cache[i][j].getCPA();
       cout << "   dcpa[" << j << "]: " << m_prox_cache[i][j].getCPADist();
@@ -27,6 +27,7 @@
 #define WALL_ENGINE_HEADER
 
 #include <vector>
+#include <memory>
 #include "XYSegList.h"
 #include "DubinsCache.h"
 #include "ProxPoint.h"
@@ -69,7 +70,7 @@ private:  // Config vars
   void print(unsigned int, unsigned int) const;
   
 private:  // State vars
-  DubinsCache m_dcache;
+  std::shared_ptr<const DubinsCache> m_dcache;
 
   std::vector<double> m_port_wsegs_x1;
   std::vector<double> m_port_wsegs_y1;  
@@ -40,6 +40,11 @@ XYConvexGrid::XYConvexGrid()
 {
   m_pix_per_mtr_x = -1;
   m_pix_per_mtr_y = -1;
+
+  m_cols = 0;
+  m_rows = 0;
+  m_cell_len_x = 0;
+  m_cell_len_y = 0;
 }
 
 
@@ -112,6 +117,11 @@ bool XYConvexGrid::initialize(const XYPolygon& poly,
 
   unsigned int esize = m_elements.size();
 
+  // Elements were created column by column, so element i of the
+  // untrimmed set sits at col=i/m_rows, row=i%m_rows. Note where each
+  // kept element lands so cells may be found directly from x,y.
+  m_cell_map = vector<int>(esize, -1);
+
   for(i=0; i<esize; i++) {
     xlow  = m_elements[i].getVal(0,0);
     xhigh = m_elements[i].getVal(0,1);
@@ -122,8 +132,10 @@ bool XYConvexGrid::initialize(const XYPolygon& poly,
     spoly.add_vertex(xhigh, ylow);
     spoly.add_vertex(xhigh, yhigh);
     spoly.add_vertex(xlow,  yhigh);
-    if(spoly.intersects(poly))
+    if(spoly.intersects(poly)) {
+      m_cell_map[i] = (int)(int_elements.size());
       int_elements.push_back(m_elements[i]);
+    }
   }
 
   m_elements  = int_elements;
@@ -416,11 +428,56 @@ void XYConvexGrid::setMaxLimit(double max_limit, unsigned int cix)
 
 bool XYConvexGrid::ptIntersect(double x, double y) const
 {
-  unsigned int i, vsize = m_elements.size();
-  for(i=0; i<vsize; i++) 
-    if(m_elements[i].containsPoint(x, y))
-      return(true);
-  return(false);
+  return(getCellIX(x, y) >= 0);
+}
+
+//-------------------------------------------------------------
+// Procedure: getCellIX()
+//   Purpose: Return the index of the lowest indexed grid cell that
+//            contains the given point, or -1 if none.
+
+int XYConvexGrid::getCellIX(double x, double y) const
+{
+  vector<unsigned int> ixs = getCellIXs(x, y);
+  if(ixs.size() == 0)
+    return(-1);
+  return((int)(ixs[0]));
+}
+
+//-------------------------------------------------------------
+// Procedure: getCellIXs()
+//   Purpose: Return the indices, in ascending order, of all grid
+//            cells containing the given point. This is the same
+//            answer as testing each cell with ptIntersect(ix,x,y),
+//            but the row and column are computed directly and only
+//            the (at most 3x3) neighborhood is tested, to catch
+//            points on shared edges and rounding at cell borders.
+
+vector<unsigned int> XYConvexGrid::getCellIXs(double x, double y) const
+{
+  vector<unsigned int> ixs;
+  if((m_cell_map.size() == 0) || (m_cell_len_x <= 0) || (m_cell_len_y <= 0))
+    return(ixs);
+
+  double fcol = floor((x - m_bounding_square.getVal(0,0)) / m_cell_len_x);
+  double frow = floor((y - m_bounding_square.getVal(1,0)) / m_cell_len_y);
+  if((fcol < -1) || (fcol > m_cols) || (frow < -1) || (frow > m_rows))
+    return(ixs);
+
+  int col = (int)(fcol);
+  int row = (int)(frow);
+  for(int c=col-1; c<=col+1; c++) {
+    if((c < 0) || (c >= (int)(m_cols)))
+      continue;
+    for(int r=row-1; r<=row+1; r++) {
+      if((r < 0) || (r >= (int)(m_rows)))
+	continue;
+      int ix = m_cell_map[(c * m_rows) + r];
+      if((ix >= 0) && m_elements[ix].containsPoint(x, y))
+	ixs.push_back((unsigned int)(ix));
+    }
+  }
+  return(ixs);
 }
 
 //-------------------------------------------------------------
@@ -485,6 +542,11 @@ bool XYConvexGrid::initialize(const XYSquare& outer_square,
   }
 
   m_bounding_square = outer_square;
+
+  m_cols = (unsigned int)(x_count);
+  m_rows = (unsigned int)(y_count);
+  m_cell_len_x = unit_x_len;
+  m_cell_len_y = unit_y_len;
   return(true);
 }
 
@@ -633,6 +695,16 @@ string XYConvexGrid::getConfigStr() const
 bool XYConvexGrid::processDelta(string str)
 {
   XYGridUpdate update = stringToGridUpdate(str);
+  return(processDelta(update));
+}
+
+//-------------------------------------------------------------
+// Procedure: processDelta()
+//      Note: The update may have come from either the string or
+//            binary form. See XYGridUpdate.
+
+bool XYConvexGrid::processDelta(const XYGridUpdate& update)
+{
   if(!update.valid())
     return(false);
 
@@ -31,6 +31,7 @@
 #include "XYObject.h"
 #include "XYSquare.h"
 #include "XYPolygon.h"
+#include "XYGridUpdate.h"
 
 class XYConvexGrid : public XYObject {
 public:
@@ -53,6 +54,11 @@ public:
   XYSquare     getElement(unsigned int index) const;
   XYSquare     getSBound() const  {return(m_bounding_square);}
   bool         ptIntersect(double, double) const;
+
+  // Direct (non-scanning) lookup of the cell(s) containing a point.
+  // A point on a shared cell edge is contained by each neighbor.
+  int          getCellIX(double x, double y) const;
+  std::vector<unsigned int> getCellIXs(double x, double y) const;
   bool         ptIntersectBound(double, double) const;
   bool         segIntersectBound(double, double, double, double) const;
 
@@ -80,6 +86,7 @@ public:
   double  getCellSize() const {return(m_config_cell_size);}
 
   bool    processDelta(std::string);
+  bool    processDelta(const XYGridUpdate&);
 
   void    reset();
   void    reset(const std::string& cell_var);
@@ -114,6 +121,14 @@ protected:
  protected: // State variables
   std::vector<XYSquare> m_elements;
   XYSquare              m_bounding_square;
+
+  // Row/column layout of the full bounding box, and for each of its
+  // cells (col*m_rows + row) the element index or -1 if trimmed.
+  unsigned int          m_cols;
+  unsigned int          m_rows;
+  double                m_cell_len_x;
+  double                m_cell_len_y;
+  std::vector<int>      m_cell_map;
   
   // Outer IX: per grid element. Inner IX: per cellvar
   std::vector<std::vector<double> >     m_cell_vals;
@@ -32,6 +32,15 @@
 
 using namespace std;
 
+static const unsigned char gu_magic[3] = {'X', 'G', 'U'};
+static const unsigned char gu_version  = 1;
+
+static void putVarint(vector<unsigned char>&, unsigned long long);
+static bool getVarint(const unsigned char*, unsigned int len,
+		      unsigned int& pos, unsigned long long&);
+static unsigned long long zigzag(long long);
+static long long unzigzag(unsigned long long);
+
 //-------------------------------------------------------------
 // Constructor()
 
@@ -163,6 +172,231 @@ string XYGridUpdate::get_spec() const
   return(spec);
 }
 
+//-------------------------------------------------------------
+// Procedure: getBinary()
+//      Note: See XYGridUpdate.h for the format.
+
+vector<unsigned char> XYGridUpdate::getBinary() const
+{
+  vector<unsigned char> buff;
+  if(!valid())
+    return(buff);
+
+  for(unsigned int i=0; i<3; i++)
+    buff.push_back(gu_magic[i]);
+  buff.push_back(gu_version);
+
+  unsigned char utype = 0;
+  if(m_update_type_replace)
+    utype = 1;
+  else if(m_update_type_average)
+    utype = 2;
+  buff.push_back(utype);
+
+  string name = m_grid_name;
+  if(name.length() > 0xFF)
+    name = name.substr(0, 0xFF);
+  buff.push_back((unsigned char)(name.length()));
+  buff.insert(buff.end(), name.begin(), name.end());
+
+  // Build the table of distinct cell vars, in order of appearance
+  vector<string> vars;
+  vector<unsigned char> var_ixs;
+  for(unsigned int i=0; i<m_cell_var.size(); i++) {
+    unsigned int vix = 0;
+    while((vix < vars.size()) && (vars[vix] != m_cell_var[i]))
+      vix++;
+    if(vix == vars.size()) {
+      if(vars.size() == 0xFF)
+	return(vector<unsigned char>());
+      vars.push_back(m_cell_var[i]);
+    }
+    var_ixs.push_back((unsigned char)(vix));
+  }
+  buff.push_back((unsigned char)(vars.size()));
+  for(unsigned int i=0; i<vars.size(); i++) {
+    string var = vars[i];
+    if(var.length() > 0xFF)
+      var = var.substr(0, 0xFF);
+    buff.push_back((unsigned char)(var.length()));
+    buff.insert(buff.end(), var.begin(), var.end());
+  }
+
+  // Collapse consecutive cells with the same var and value into runs
+  vector<unsigned int> run_start, run_count;
+  vector<unsigned char> run_var;
+  vector<long long> run_val;
+  for(unsigned int i=0; i<m_cell_ix.size(); i++) {
+    long long qval = llround(m_cell_val[i] * 10000);
+    unsigned int k = run_start.size();
+    if((k > 0) && (run_var[k-1] == var_ixs[i]) && (run_val[k-1] == qval) &&
+       (m_cell_ix[i] == run_start[k-1] + run_count[k-1]))
+      run_count[k-1]++;
+    else {
+      run_start.push_back(m_cell_ix[i]);
+      run_count.push_back(1);
+      run_var.push_back(var_ixs[i]);
+      run_val.push_back(qval);
+    }
+  }
+
+  putVarint(buff, run_start.size());
+  long long next_ix = 0;
+  for(unsigned int k=0; k<run_start.size(); k++) {
+    putVarint(buff, zigzag((long long)(run_start[k]) - next_ix));
+    putVarint(buff, run_count[k]);
+    buff.push_back(run_var[k]);
+    putVarint(buff, zigzag(run_val[k]));
+    next_ix = (long long)(run_start[k]) + run_count[k];
+  }
+  return(buff);
+}
+
+//-------------------------------------------------------------
+// Procedure: setFromBinary()
+//   Returns: false if the data is not a well formed binary update,
+//            in which case this update is left empty (invalid).
+
+bool XYGridUpdate::setFromBinary(const unsigned char* data, unsigned int len)
+{
+  m_grid_name = "";
+  m_cell_ix.clear();
+  m_cell_var.clear();
+  m_cell_val.clear();
+  setUpdateTypeDelta();
+
+  if(!isBinaryGridUpdate(data, len) || (len < 7))
+    return(false);
+
+  unsigned int pos = 4;
+  unsigned char utype = data[pos++];
+  if(utype == 1)
+    setUpdateTypeReplace();
+  else if(utype == 2)
+    setUpdateTypeAverage();
+  else if(utype != 0)
+    return(false);
+
+  unsigned int name_len = data[pos++];
+  if(pos + name_len + 1 > len)
+    return(false);
+  string grid_name((const char*)(data + pos), name_len);
+  pos += name_len;
+
+  unsigned int num_vars = data[pos++];
+  vector<string> vars;
+  for(unsigned int i=0; i<num_vars; i++) {
+    if(pos + 1 > len)
+      return(false);
+    unsigned int var_len = data[pos++];
+    if(pos + var_len > len)
+      return(false);
+    vars.push_back(string((const char*)(data + pos), var_len));
+    pos += var_len;
+  }
+
+  unsigned long long num_runs = 0;
+  if(!getVarint(data, len, pos, num_runs))
+    return(false);
+
+  vector<unsigned int> cell_ix;
+  vector<string>       cell_var;
+  vector<double>       cell_val;
+  long long next_ix = 0;
+  for(unsigned long long k=0; k<num_runs; k++) {
+    unsigned long long gap, count, qval;
+    if(!getVarint(data, len, pos, gap) || !getVarint(data, len, pos, count))
+      return(false);
+    if(pos + 1 > len)
+      return(false);
+    unsigned int vix = data[pos++];
+    if((vix >= vars.size()) || !getVarint(data, len, pos, qval))
+      return(false);
+
+    long long start = next_ix + unzigzag(gap);
+    if((start < 0) || (count == 0) || (start + count > 0xFFFFFFFFULL))
+      return(false);
+    // Guard against a corrupt count expanding to an absurd update
+    if(cell_ix.size() + count > 0x4000000)
+      return(false);
+    double val = (double)(unzigzag(qval)) / 10000;
+    for(unsigned long long j=0; j<count; j++) {
+      cell_ix.push_back((unsigned int)(start + j));
+      cell_var.push_back(vars[vix]);
+      cell_val.push_back(val);
+    }
+    next_ix = start + count;
+  }
+
+  // Bytes left over mean the data was not one whole update
+  if(pos != len)
+    return(false);
+
+  m_grid_name = grid_name;
+  m_cell_ix   = cell_ix;
+  m_cell_var  = cell_var;
+  m_cell_val  = cell_val;
+  return(true);
+}
+
+//-------------------------------------------------------------
+// Procedure: isBinaryGridUpdate()
+
+bool XYGridUpdate::isBinaryGridUpdate(const unsigned char* data,
+				      unsigned int len)
+{
+  if(!data || (len < 4))
+    return(false);
+  if((data[0] != gu_magic[0]) || (data[1] != gu_magic[1]) ||
+     (data[2] != gu_magic[2]))
+    return(false);
+  return(data[3] == gu_version);
+}
+
+//-------------------------------------------------------------
+// Procedure: putVarint()
+
+static void putVarint(vector<unsigned char>& buff, unsigned long long val)
+{
+  while(val >= 0x80) {
+    buff.push_back((unsigned char)((val & 0x7F) | 0x80));
+    val >>= 7;
+  }
+  buff.push_back((unsigned char)(val));
+}
+
+//-------------------------------------------------------------
+// Procedure: getVarint()
+//   Returns: false if the data ran out, or the varint is too long.
+
+static bool getVarint(const unsigned char* data, unsigned int len,
+		      unsigned int& pos, unsigned long long& val)
+{
+  val = 0;
+  for(unsigned int shift=0; shift<64; shift+=7) {
+    if(pos >= len)
+      return(false);
+    unsigned char byte = data[pos++];
+    val |= ((unsigned long long)(byte & 0x7F)) << shift;
+    if((byte & 0x80) == 0)
+      return(true);
+  }
+  return(false);
+}
+
+//-------------------------------------------------------------
+// Procedure: zigzag(), unzigzag()
+
+static unsigned long long zigzag(long long val)
+{
+  return((((unsigned long long)(val)) << 1) ^ (unsigned long long)(val >> 63));
+}
+
+static long long unzigzag(unsigned long long val)
+{
+  return((long long)(val >> 1) ^ -((long long)(val & 1)));
+}
+
 //-------------------------------------------------------------
 // Procedure: stringToGridUpdate()
 
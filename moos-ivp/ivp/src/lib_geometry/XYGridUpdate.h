@@ -29,6 +29,23 @@
 #include <string>
 #include <vector>
 
+//---------------------------------------------------------------
+// XYGridUpdate holds a set of cell updates for a named grid.
+//
+// Text form:
+//   label @ [delta|replace|avg @] ix,var,val : ix,var,val : ...
+//
+// Binary form (run-length encoded, all integers little endian):
+//   "XGU" version(1)  type(u8)  name_len(u8) name
+//   num_vars(u8)  per var: var_len(u8) var
+//   num_runs(varint)
+//   per run: ix_gap(zvarint) count(varint) var_ix(u8) val(zvarint)
+// A run is a span of consecutive cell indices updating the same
+// var with the same value. The ix_gap is relative to the index
+// just past the previous run. Values are in 1/10000 units, the
+// same precision as the text form. Varints are LEB128, zvarints
+// are zigzag encoded signed varints.
+
 class XYGridUpdate {
 public:
   XYGridUpdate(std::string grid_name="");
@@ -57,6 +74,11 @@ public:
   double       getCellVal(unsigned int) const;
 
   std::string  get_spec() const;
+
+  std::vector<unsigned char> getBinary() const;
+  bool setFromBinary(const unsigned char*, unsigned int);
+
+  static bool isBinaryGridUpdate(const unsigned char*, unsigned int);
   
 protected:
   std::string  m_grid_name;
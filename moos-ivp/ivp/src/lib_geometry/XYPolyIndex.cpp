@@ -0,0 +1,504 @@
+/*****************************************************************/
+/*    NAME: agent                                                */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: XYPolyIndex.cpp                                      */
+/*    DATE: Oct 19th, 2026                                       */
+/*                                                               */
+/* This file is part of IvP Helm Core Libs                       */
+/*                                                               */
+/* IvP Helm Core Libs is free software: you can redistribute it  */
+/* and/or modify it under the terms of the Lesser GNU General    */
+/* Public License as published by the Free Software Foundation,  */
+/* either version 3 of the License, or (at your option) any      */
+/* later version.                                                */
+/*                                                               */
+/* IvP Helm Core Libs is distributed in the hope that it will    */
+/* be useful but WITHOUT ANY WARRANTY; without even the implied  */
+/* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR       */
+/* PURPOSE. See the Lesser GNU General Public License for more   */
+/* details.                                                      */
+/*                                                               */
+/* You should have received a copy of the Lesser GNU General     */
+/* Public License along with MOOS-IvP.  If not, see              */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#include <cmath>
+#include "XYPolyIndex.h"
+#include "GeomUtils.h"
+
+using namespace std;
+
+//---------------------------------------------------------------
+// Constructor()
+
+XYPolyIndex::XYPolyIndex()
+{
+  clear();
+}
+
+//---------------------------------------------------------------
+// Constructor()
+
+XYPolyIndex::XYPolyIndex(const XYPolygon& poly)
+{
+  setPoly(poly);
+}
+
+//---------------------------------------------------------------
+// Procedure: clear()
+
+void XYPolyIndex::clear()
+{
+  m_vx.clear();
+  m_vy.clear();
+  m_convex = false;
+
+  m_min_x = 0;
+  m_max_x = 0;
+  m_min_y = 0;
+  m_max_y = 0;
+  m_pad   = 0;
+
+  m_etype.clear();
+  m_em.clear();
+  m_eb.clear();
+  m_eside.clear();
+
+  m_emin_x.clear();
+  m_emax_x.clear();
+  m_emin_y.clear();
+  m_emax_y.clear();
+
+  m_bin_cols = 0;
+  m_bin_rows = 0;
+  m_bin_wid  = 0;
+  m_bin_hgt  = 0;
+  m_bin_start.clear();
+  m_bin_edges.clear();
+}
+
+//---------------------------------------------------------------
+// Procedure: setPoly()
+//   Purpose: Snapshot the polygon and precompute everything the
+//            queries need. The half-plane of each edge is built
+//            with the same arithmetic as XYPolygon::side() so the
+//            containment answers are identical.
+
+void XYPolyIndex::setPoly(const XYPolygon& poly)
+{
+  clear();
+
+  unsigned int vsize = poly.size();
+  for(unsigned int i=0; i<vsize; i++) {
+    m_vx.push_back(poly.get_vx(i));
+    m_vy.push_back(poly.get_vy(i));
+  }
+  m_convex = poly.is_convex();
+  if(vsize == 0)
+    return;
+
+  m_min_x = m_max_x = m_vx[0];
+  m_min_y = m_max_y = m_vy[0];
+  for(unsigned int i=1; i<vsize; i++) {
+    if(m_vx[i] < m_min_x) m_min_x = m_vx[i];
+    if(m_vx[i] > m_max_x) m_max_x = m_vx[i];
+    if(m_vy[i] < m_min_y) m_min_y = m_vy[i];
+    if(m_vy[i] > m_max_y) m_max_y = m_vy[i];
+  }
+
+  // Pad the box for rejection tests so points that are on an edge
+  // line to within rounding are still handed to the edge tests.
+  double extent = fabs(m_min_x);
+  if(fabs(m_max_x) > extent) extent = fabs(m_max_x);
+  if(fabs(m_min_y) > extent) extent = fabs(m_min_y);
+  if(fabs(m_max_y) > extent) extent = fabs(m_max_y);
+  m_pad = 1e-9 * (1 + extent);
+
+  // A two-vertex polygon has the one edge, otherwise it closes
+  unsigned int esize = vsize;
+  if(vsize == 1)
+    esize = 0;
+  else if(vsize == 2)
+    esize = 1;
+
+  for(unsigned int ix=0; ix<esize; ix++) {
+    unsigned int ixx = ix+1;
+    if(ixx == vsize)
+      ixx = 0;
+    double x1 = m_vx[ix];
+    double y1 = m_vy[ix];
+    double x2 = m_vx[ixx];
+    double y2 = m_vy[ixx];
+
+    int    etype = 0;
+    double m = 0;
+    double b = 0;
+    if(x1 == x2) {
+      etype = 1;
+      if(y1 == y2)
+	etype = 2;
+    }
+    else {
+      m = (y2 - y1) / (x2 - x1);
+      b = y2 - (m * x2);
+    }
+    m_etype.push_back(etype);
+    m_em.push_back(m);
+    m_eb.push_back(b);
+    m_eside.push_back(poly.get_side(ix));
+
+    m_emin_x.push_back((x1 < x2) ? x1 : x2);
+    m_emax_x.push_back((x1 < x2) ? x2 : x1);
+    m_emin_y.push_back((y1 < y2) ? y1 : y2);
+    m_emax_y.push_back((y1 < y2) ? y2 : y1);
+  }
+
+  buildBins();
+}
+
+//---------------------------------------------------------------
+// Procedure: buildBins()
+//   Purpose: For polygons with many edges, lay a grid over the
+//            bounding box with about one bin per edge, and note in
+//            each bin every edge whose box overlaps it.
+
+void XYPolyIndex::buildBins()
+{
+  unsigned int esize = m_etype.size();
+  if(esize < 32)
+    return;
+
+  double wid = m_max_x - m_min_x;
+  double hgt = m_max_y - m_min_y;
+  if((wid <= 0) || (hgt <= 0))
+    return;
+
+  unsigned int cols = (unsigned int)(ceil(sqrt(esize * wid / hgt)));
+  if(cols < 1)
+    cols = 1;
+  if(cols > esize)
+    cols = esize;
+  unsigned int rows = (esize + cols - 1) / cols;
+
+  m_bin_cols = cols;
+  m_bin_rows = rows;
+  m_bin_wid  = wid / cols;
+  m_bin_hgt  = hgt / rows;
+
+  // Two passes, first to count and then to fill
+  vector<unsigned int> counts(cols * rows, 0);
+  for(int pass=0; pass<2; pass++) {
+    if(pass == 1) {
+      m_bin_start.assign(cols * rows + 1, 0);
+      for(unsigned int b=0; b<counts.size(); b++)
+	m_bin_start[b+1] = m_bin_start[b] + counts[b];
+      m_bin_edges.resize(m_bin_start.back());
+      counts.assign(cols * rows, 0);
+    }
+    for(unsigned int ix=0; ix<esize; ix++) {
+      unsigned int c1 = (unsigned int)((m_emin_x[ix] - m_min_x) / m_bin_wid);
+      unsigned int c2 = (unsigned int)((m_emax_x[ix] - m_min_x) / m_bin_wid);
+      unsigned int r1 = (unsigned int)((m_emin_y[ix] - m_min_y) / m_bin_hgt);
+      unsigned int r2 = (unsigned int)((m_emax_y[ix] - m_min_y) / m_bin_hgt);
+      if(c2 >= cols) c2 = cols-1;
+      if(r2 >= rows) r2 = rows-1;
+      if(c1 > c2) c1 = c2;
+      if(r1 > r2) r1 = r2;
+      for(unsigned int c=c1; c<=c2; c++) {
+	for(unsigned int r=r1; r<=r2; r++) {
+	  unsigned int b = c*rows + r;
+	  if(pass == 1)
+	    m_bin_edges[m_bin_start[b] + counts[b]] = ix;
+	  counts[b]++;
+	}
+      }
+    }
+  }
+}
+
+//---------------------------------------------------------------
+// Procedure: contains()
+//   Purpose: Same answer as XYPolygon::contains(x,y), with points
+//            well outside the bounding box rejected up front.
+
+bool XYPolyIndex::contains(double x, double y) const
+{
+  if(!m_convex)
+    return(false);
+
+  if((x < m_min_x - m_pad) || (x > m_max_x + m_pad) ||
+     (y < m_min_y - m_pad) || (y > m_max_y + m_pad))
+    return(false);
+
+  unsigned int vsize = m_vx.size();
+  for(unsigned int ix=0; ix<vsize; ix++) {
+    if((x==m_vx[ix]) && (y==m_vy[ix]))
+      return(true);
+
+    int vside = 2;
+    if(m_etype[ix] == 1) {
+      if(x > m_vx[ix])
+	vside = 0;
+      else if(x < m_vx[ix])
+	vside = 1;
+    }
+    else if(m_etype[ix] == 0) {
+      double ly = (m_em[ix] * x) + m_eb[ix];
+      if(ly > y)
+	vside = 0;
+      else if(ly < y)
+	vside = 1;
+    }
+    if((vside != 2) && (vside != m_eside[ix]))
+      return(false);
+  }
+  return(true);
+}
+
+//---------------------------------------------------------------
+// Procedure: dist_to_bbox()
+//   Purpose: Distance to the bounding box, zero if inside. Never
+//            more than the distance to the polygon itself.
+
+double XYPolyIndex::dist_to_bbox(double x, double y) const
+{
+  double dx = 0;
+  if(x < m_min_x)
+    dx = m_min_x - x;
+  else if(x > m_max_x)
+    dx = x - m_max_x;
+
+  double dy = 0;
+  if(y < m_min_y)
+    dy = m_min_y - y;
+  else if(y > m_max_y)
+    dy = y - m_max_y;
+
+  return(hypot(dx, dy));
+}
+
+//---------------------------------------------------------------
+// Procedure: dist_to_poly()
+//   Purpose: Same answer as XYPolygon::dist_to_poly(x,y)
+
+double XYPolyIndex::dist_to_poly(double x, double y) const
+{
+  unsigned int vsize = m_vx.size();
+  if(vsize == 0)
+    return(-1);
+  if(vsize == 1)
+    return(distPointToPoint(x, y, m_vx[0], m_vy[0]));
+
+  if(m_bin_cols > 0)
+    return(distBinned(x, y));
+  return(distLinear(x, y));
+}
+
+//---------------------------------------------------------------
+// Procedure: within_dist()
+//   Purpose: Same answer as (dist_to_poly(x,y) <= dist), but stops
+//            at the first edge in range and skips edges whose box
+//            is already out of range.
+
+bool XYPolyIndex::within_dist(double x, double y, double dist) const
+{
+  unsigned int vsize = m_vx.size();
+  if(vsize == 0)
+    return(-1 <= dist);
+  if(vsize == 1)
+    return(distPointToPoint(x, y, m_vx[0], m_vy[0]) <= dist);
+
+  // Lower bounds are only trusted when clearly out of range
+  double slack = 1e-9 * (1 + fabs(dist));
+  if(dist_to_bbox(x, y) > dist + slack)
+    return(false);
+
+  unsigned int esize = m_etype.size();
+  for(unsigned int ix=0; ix<esize; ix++) {
+    if(edgeLowerBound(ix, x, y) > dist + slack)
+      continue;
+    if(edgeDist(ix, x, y) <= dist)
+      return(true);
+  }
+  return(false);
+}
+
+//---------------------------------------------------------------
+// Procedure: contains()  (batch)
+
+void XYPolyIndex::contains(const vector<double>& vx,
+			   const vector<double>& vy,
+			   vector<bool>& results) const
+{
+  unsigned int psize = vx.size();
+  if(vy.size() < psize)
+    psize = vy.size();
+
+  results.resize(psize);
+  for(unsigned int i=0; i<psize; i++)
+    results[i] = contains(vx[i], vy[i]);
+}
+
+//---------------------------------------------------------------
+// Procedure: dist_to_poly()  (batch)
+
+void XYPolyIndex::dist_to_poly(const vector<double>& vx,
+			       const vector<double>& vy,
+			       vector<double>& results) const
+{
+  unsigned int psize = vx.size();
+  if(vy.size() < psize)
+    psize = vy.size();
+
+  results.resize(psize);
+  for(unsigned int i=0; i<psize; i++)
+    results[i] = dist_to_poly(vx[i], vy[i]);
+}
+
+//---------------------------------------------------------------
+// Procedure: within_dist()  (batch)
+//   Returns: The number of points within range
+
+unsigned int XYPolyIndex::within_dist(const vector<double>& vx,
+				      const vector<double>& vy,
+				      double dist,
+				      vector<bool>& results) const
+{
+  unsigned int psize = vx.size();
+  if(vy.size() < psize)
+    psize = vy.size();
+
+  unsigned int count = 0;
+  results.resize(psize);
+  for(unsigned int i=0; i<psize; i++) {
+    results[i] = within_dist(vx[i], vy[i], dist);
+    if(results[i])
+      count++;
+  }
+  return(count);
+}
+
+//---------------------------------------------------------------
+// Procedure: edgeDist()
+//   Purpose: Distance to edge ix as XYPolygon::dist_to_poly() has
+//            it, which is always to a point inside the edge box.
+
+double XYPolyIndex::edgeDist(unsigned int ix, double x, double y) const
+{
+  unsigned int ixx = ix+1;
+  if(ixx == m_vx.size())
+    ixx = 0;
+  return(distPointToSeg(m_vx[ix], m_vy[ix], m_vx[ixx], m_vy[ixx], x, y));
+}
+
+//---------------------------------------------------------------
+// Procedure: edgeLowerBound()
+//   Purpose: Distance to the box of edge ix, a lower bound on the
+//            distance returned by edgeDist().
+
+double XYPolyIndex::edgeLowerBound(unsigned int ix, double x, double y) const
+{
+  double dx = 0;
+  if(x < m_emin_x[ix])
+    dx = m_emin_x[ix] - x;
+  else if(x > m_emax_x[ix])
+    dx = x - m_emax_x[ix];
+
+  double dy = 0;
+  if(y < m_emin_y[ix])
+    dy = m_emin_y[ix] - y;
+  else if(y > m_emax_y[ix])
+    dy = y - m_emax_y[ix];
+
+  return(hypot(dx, dy));
+}
+
+//---------------------------------------------------------------
+// Procedure: distLinear()
+//   Purpose: Min over all edges. With enough edges, skip any edge
+//            whose box is clearly farther than the best so far. On
+//            small polygons the check costs more than it saves.
+
+double XYPolyIndex::distLinear(double x, double y) const
+{
+  unsigned int esize = m_etype.size();
+  bool prune = (esize >= 16);
+
+  double dist = edgeDist(0, x, y);
+  for(unsigned int ix=1; ix<esize; ix++) {
+    if(prune && (edgeLowerBound(ix, x, y) > dist + (1e-9 * (1 + dist))))
+      continue;
+    double idist = edgeDist(ix, x, y);
+    if(idist < dist)
+      dist = idist;
+  }
+  return(dist);
+}
+
+//---------------------------------------------------------------
+// Procedure: distBinned()
+//   Purpose: Search the edge bins in rings of growing size around
+//            the bin nearest the query point. Once every bin within
+//            ring R has been searched, no unsearched edge can be
+//            nearer than (R-1) bin widths, so the search stops when
+//            the best distance found is clearly below that.
+
+double XYPolyIndex::distBinned(double x, double y) const
+{
+  // Far from the polygon the rings would cover every bin anyway
+  double wid = m_max_x - m_min_x;
+  double hgt = m_max_y - m_min_y;
+  double span = (wid > hgt) ? wid : hgt;
+  if(dist_to_bbox(x, y) > span)
+    return(distLinear(x, y));
+
+  // Start from the bin holding the point clamped to the box
+  double px = x;
+  double py = y;
+  if(px < m_min_x) px = m_min_x;
+  if(px > m_max_x) px = m_max_x;
+  if(py < m_min_y) py = m_min_y;
+  if(py > m_max_y) py = m_max_y;
+
+  int cols = (int)(m_bin_cols);
+  int rows = (int)(m_bin_rows);
+  int c0 = (int)((px - m_min_x) / m_bin_wid);
+  int r0 = (int)((py - m_min_y) / m_bin_hgt);
+  if(c0 >= cols) c0 = cols-1;
+  if(r0 >= rows) r0 = rows-1;
+
+  double bin_min = (m_bin_wid < m_bin_hgt) ? m_bin_wid : m_bin_hgt;
+  int    max_ring = (cols > rows) ? cols : rows;
+
+  double dist = -1;
+  for(int ring=0; ring<=max_ring; ring++) {
+    int cmin = c0 - ring;
+    int cmax = c0 + ring;
+    for(int c=cmin; c<=cmax; c++) {
+      if((c < 0) || (c >= cols))
+	continue;
+      // Interior columns of the ring only visit its top and bottom
+      int rstep = 1;
+      if((c != cmin) && (c != cmax))
+	rstep = (ring > 0) ? (2 * ring) : 1;
+      for(int r=r0-ring; r<=r0+ring; r+=rstep) {
+	if((r < 0) || (r >= rows))
+	  continue;
+	unsigned int b = (unsigned int)(c*rows + r);
+	for(unsigned int k=m_bin_start[b]; k<m_bin_start[b+1]; k++) {
+	  unsigned int ix = m_bin_edges[k];
+	  if((dist >= 0) &&
+	     (edgeLowerBound(ix, x, y) > dist + (1e-9 * (1 + dist))))
+	    continue;
+	  double idist = edgeDist(ix, x, y);
+	  if((dist < 0) || (idist < dist))
+	    dist = idist;
+	}
+      }
+    }
+    if((dist >= 0) && (((ring-1) * bin_min) > dist + (1e-9 * (1 + dist))))
+      break;
+  }
+  return(dist);
+}
@@ -0,0 +1,118 @@
+/*****************************************************************/
+/*    NAME: agent                                                */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: XYPolyIndex.h                                        */
+/*    DATE: Oct 19th, 2026                                       */
+/*                                                               */
+/* This file is part of IvP Helm Core Libs                       */
+/*                                                               */
+/* IvP Helm Core Libs is free software: you can redistribute it  */
+/* and/or modify it under the terms of the Lesser GNU General    */
+/* Public License as published by the Free Software Foundation,  */
+/* either version 3 of the License, or (at your option) any      */
+/* later version.                                                */
+/*                                                               */
+/* IvP Helm Core Libs is distributed in the hope that it will    */
+/* be useful but WITHOUT ANY WARRANTY; without even the implied  */
+/* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR       */
+/* PURPOSE. See the Lesser GNU General Public License for more   */
+/* details.                                                      */
+/*                                                               */
+/* You should have received a copy of the Lesser GNU General     */
+/* Public License along with MOOS-IvP.  If not, see              */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+ 
+#ifndef XY_POLYGON_INDEX_HEADER
+#define XY_POLYGON_INDEX_HEADER
+
+#include <vector>
+#include "XYPolygon.h"
+
+//---------------------------------------------------------------
+// An XYPolyIndex is a read-only snapshot of an XYPolygon built to
+// answer many contains() and dist_to_poly() queries cheaply. It
+// holds the bounding box, the precomputed half-plane of each edge
+// and, for polygons with many edges, a grid of edge bins. Results
+// are identical to the XYPolygon queries. If the polygon changes
+// the index must be rebuilt with setPoly().
+
+class XYPolyIndex {
+public:
+  XYPolyIndex();
+  XYPolyIndex(const XYPolygon& poly);
+  ~XYPolyIndex() {}
+
+  void   setPoly(const XYPolygon& poly);
+  void   clear();
+
+public: // Single point queries
+  bool   contains(double x, double y) const;
+  double dist_to_poly(double x, double y) const;
+  bool   within_dist(double x, double y, double dist) const;
+  double dist_to_bbox(double x, double y) const;
+
+public: // Batch queries over many points
+  void   contains(const std::vector<double>& vx,
+		  const std::vector<double>& vy,
+		  std::vector<bool>& results) const;
+  void   dist_to_poly(const std::vector<double>& vx,
+		      const std::vector<double>& vy,
+		      std::vector<double>& results) const;
+  unsigned int within_dist(const std::vector<double>& vx,
+			   const std::vector<double>& vy, double dist,
+			   std::vector<bool>& results) const;
+
+public: // Accessors
+  unsigned int size() const      {return(m_vx.size());}
+  bool   is_convex() const       {return(m_convex);}
+  bool   binned() const          {return(m_bin_cols > 0);}
+  double get_min_x() const       {return(m_min_x);}
+  double get_max_x() const       {return(m_max_x);}
+  double get_min_y() const       {return(m_min_y);}
+  double get_max_y() const       {return(m_max_y);}
+
+protected:
+  void   buildBins();
+  double edgeDist(unsigned int ix, double x, double y) const;
+  double edgeLowerBound(unsigned int ix, double x, double y) const;
+  double distLinear(double x, double y) const;
+  double distBinned(double x, double y) const;
+
+private: // Snapshot of the polygon vertices
+  std::vector<double> m_vx;
+  std::vector<double> m_vy;
+  bool   m_convex;
+
+  // Bounding box, and a small pad used for fast rejection
+  double m_min_x;
+  double m_max_x;
+  double m_min_y;
+  double m_max_y;
+  double m_pad;
+
+  // Per-edge half-plane y=mx+b, edge ix runs from vertex ix to
+  // ix+1. Type 0 is general, 1 vertical, 2 a zero-length edge.
+  std::vector<int>    m_etype;
+  std::vector<double> m_em;
+  std::vector<double> m_eb;
+  std::vector<int>    m_eside;
+
+  // Per-edge bounding boxes, used as distance lower bounds
+  std::vector<double> m_emin_x;
+  std::vector<double> m_emax_x;
+  std::vector<double> m_emin_y;
+  std::vector<double> m_emax_y;
+
+  // Edge bins over the bounding box, in compressed row form.
+  // The edges of bin (col,row) are m_bin_edges[m_bin_start[b]]
+  // up to m_bin_start[b+1] with b = col*m_bin_rows+row.
+  unsigned int m_bin_cols;
+  unsigned int m_bin_rows;
+  double       m_bin_wid;
+  double       m_bin_hgt;
+  std::vector<unsigned int> m_bin_start;
+  std::vector<unsigned int> m_bin_edges;
+};
+
+#endif
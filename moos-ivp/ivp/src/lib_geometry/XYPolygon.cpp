@@ -1137,6 +1137,19 @@ void XYPolygon::determine_convexity()
 }
 
 
+//---------------------------------------------------------------
+// Procedure: get_side()
+//   Purpose: Return the side (0 or 1) of edge ix that the rest of
+//            the polygon lies on, or -1 if undetermined.
+
+int XYPolygon::get_side(unsigned int ix) const
+{
+  if(ix >= m_side_xy.size())
+    return(-1);
+  return(m_side_xy[ix]);
+}
+
+
 //---------------------------------------------------------------
 // Procedure: area()
 
@@ -75,6 +75,7 @@ public:
   
   bool   vertex_is_viewable(unsigned int, double, double) const;
   bool   is_convex() const  {return(m_convex_state);}
+  int    get_side(unsigned int) const;
   void   determine_convexity();
 
   double area() const;
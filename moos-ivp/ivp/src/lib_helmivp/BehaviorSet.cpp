@@ -28,6 +28,7 @@
 #include "IvPFunction.h"
 #include "FunctionEncoder.h"
 #include "ColorParse.h"
+#include "BuildTally.h"
 
 using namespace std;
 
@@ -38,6 +39,7 @@ BehaviorSet::BehaviorSet()
 {
   m_report_ipf = true;
   m_curr_time  = -1;
+  m_ipf_encoding = "ascii";
   m_bfactory_dynamic.loadEnvVarDirectories("IVP_BEHAVIOR_DIRS");
 
   m_total_behaviors_ever = 0;
@@ -53,6 +55,25 @@ BehaviorSet::~BehaviorSet()
   clearBehaviors();
 }
 
+//------------------------------------------------------------
+// Procedure: setIPFEncoding()
+//      Note: The binary and delta encodings are decoded by the same
+//            StringToIvPFunction(). Delta strings first need to be
+//            resolved by an IPFBinCoder on the receiving side.
+
+bool BehaviorSet::setIPFEncoding(string encoding)
+{
+  encoding = tolower(encoding);
+  if((encoding != "ascii") && (encoding != "binary") &&
+     (encoding != "delta"))
+    return(false);
+
+  m_ipf_encoding = encoding;
+  m_ipf_coder.clear();
+  m_ipf_coder.setDeltas(encoding == "delta");
+  return(true);
+}
+
 //------------------------------------------------------------
 // Procedure: addBehaviorDir()
 
@@ -611,6 +632,14 @@ IvPFunction* BehaviorSet::produceOF(unsigned int ix,
   IvPFunction *ipf = 0;
   IvPBehavior *bhv = m_bhv_entry[ix].getBehavior();
 
+  // Phase times for the helm profile: pre runs until the behavior
+  // is asked for a function, run covers onRunStatePrior/onRunState,
+  // post the rest.
+  m_last_profile.clear();
+  m_last_profile.name = bhv->getDescriptor();
+  double phase_start = BuildTally::now();
+  bool   run_phase   = false;
+  
   bhv->incBhvIteration();
   
   // possible vals: "", "idle", "running", "active"
@@ -698,6 +727,12 @@ IvPFunction* BehaviorSet::produceOF(unsigned int ix,
       bhv->onIdleToRunState();
 
     // Step 1: Ask the behavior to build a IvP function
+    double run_start = BuildTally::now();
+    m_last_profile.pre_time = (run_start - phase_start) * 1000;
+    BuildTally& tally = BuildTally::local();
+    tally.reset();
+    run_phase = true;
+
     bool need_to_run = bhv->onRunStatePrior();
     ipf_reuse = !need_to_run;
     bhv->noteLastRunCheck(need_to_run, getCurrTime());
@@ -705,6 +740,11 @@ IvPFunction* BehaviorSet::produceOF(unsigned int ix,
     if(need_to_run)
       ipf = bhv->onRunState();
 
+    phase_start = BuildTally::now();
+    m_last_profile.run_time   = (phase_start - run_start) * 1000;
+    m_last_profile.build_time = tally.getReflectTime() * 1000;
+    m_last_profile.norm_time  = tally.getNormalizeTime() * 1000;
+
     // Step 2: If IvP function contains NaN components, report and abort
     if(ipf && !ipf->freeOfNan()) {
       bhv->postEMessage("NaN detected in IvP Function");
@@ -727,7 +767,11 @@ IvPFunction* BehaviorSet::produceOF(unsigned int ix,
       string iter_str = uintToString(iteration);
       string ctxt_str = iter_str + ":" + desc_str;
       ipf->setContextStr(ctxt_str);
-      string ipf_str = IvPFunctionToString(ipf);
+      string ipf_str;
+      if(m_ipf_encoding == "ascii")
+	ipf_str = IvPFunctionToString(ipf);
+      else
+	ipf_str = m_ipf_coder.encode(ipf);
       bhv->postMessage("BHV_IPF", ipf_str);
     }
     // Step 5: Handle normal case of healthy IvP function returned
@@ -745,6 +789,7 @@ IvPFunction* BehaviorSet::produceOF(unsigned int ix,
       bhv->onInactiveState();
     }
     bhv->updateStateDurations("running");
+    m_last_profile.pcs = pcs;
   }
 
   // Bug fix Jan 26th, 2016 mikerb
@@ -777,6 +822,13 @@ IvPFunction* BehaviorSet::produceOF(unsigned int ix,
   if(bhv->getBhvIteration() == 1)
     bhv->postFlags("spawnxflags", true);
 
+  // Whatever followed the run phase, or all of it if none
+  double post_time = (BuildTally::now() - phase_start) * 1000;
+  if(run_phase)
+    m_last_profile.post_time = post_time;
+  else
+    m_last_profile.pre_time = post_time;
+
   // Return either the IvP function or NULL
   return(ipf);
 }
@@ -839,8 +891,12 @@ BehaviorReport BehaviorSet::produceOFX(unsigned int ix,
 
       unsigned int i, vsize = bhv_report.size();
       for(i=0; i<vsize; i++) {
-	if(bhv_report.hasIPFString(i))
+	if(!bhv_report.hasIPFString(i))
+	  continue;
+	if(m_ipf_encoding == "ascii")
 	  bhv->postMessage("BHV_IPF", bhv_report.getIPFString(i));
+	else
+	  bhv->postMessage("BHV_IPF", m_ipf_coder.encode(bhv_report.getIPF(i)));
       }
 
       if(bhv_report.size() > 0) {
@@ -38,6 +38,8 @@
 #include "BFactoryDynamic.h"
 #include "BehaviorSetEntry.h"
 #include "LifeEvent.h"
+#include "FunctionEncoderBin.h"
+#include "HelmProfile.h"
 
 class IvPFunction;
 class BehaviorSet
@@ -73,10 +75,12 @@ public:
   unsigned int size()                   {return(m_bhv_entry.size());}
 
   void         setReportIPF(bool v)     {m_report_ipf=v;}
+  bool         setIPFEncoding(std::string);
   bool         stateOK(unsigned int);
   void         resetStateOK();
   IvPFunction* produceOF(unsigned int ix, unsigned int iter, 
 			 std::string& activity_state, bool& ipf_reuse);
+  BhvProfile   getLastProfile() const   {return(m_last_profile);}
 
   BehaviorReport produceOFX(unsigned int ix, unsigned int iter, 
 			    std::string& activity_state);
@@ -168,6 +172,12 @@ protected:
   std::string m_ownship;
 
   bool    m_report_ipf;
+
+  std::string m_ipf_encoding;  // ascii, binary or delta
+  IPFBinCoder m_ipf_coder;
+
+  // Phase times of the behavior of the last produceOF() call
+  BhvProfile  m_last_profile;
   double  m_curr_time;
   bool    m_completed_pending;
 
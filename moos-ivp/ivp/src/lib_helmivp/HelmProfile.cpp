@@ -0,0 +1,112 @@
+/*****************************************************************/
+/*    NAME: agent                                                */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: HelmProfile.cpp                                      */
+/*    DATE: Oct 19th, 2026                                       */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#include "HelmProfile.h"
+#include "MBUtils.h"
+
+using namespace std;
+
+//-----------------------------------------------------------
+// Procedure: clear()
+
+void BhvProfile::clear()
+{
+  name = "";
+  pre_time   = 0;
+  run_time   = 0;
+  build_time = 0;
+  norm_time  = 0;
+  post_time  = 0;
+  pcs    = 0;
+  nodes  = 0;
+  pruned = 0;
+}
+
+//-----------------------------------------------------------
+// Procedure: clear()
+
+void HelmProfile::clear()
+{
+  m_iteration   = 0;
+  m_create_time = 0;
+  m_solve_time  = 0;
+  m_leafs  = 0;
+  m_nodes  = 0;
+  m_pruned = 0;
+  m_bhvs.clear();
+}
+
+//-----------------------------------------------------------
+// Procedure: setSolveCounts()
+
+bool HelmProfile::setSolveCounts(const string& bhv_name,
+				 unsigned int nodes, unsigned int pruned)
+{
+  for(unsigned int i=0; i<m_bhvs.size(); i++) {
+    if(m_bhvs[i].name == bhv_name) {
+      m_bhvs[i].nodes  = nodes;
+      m_bhvs[i].pruned = pruned;
+      return(true);
+    }
+  }
+  return(false);
+}
+
+//-----------------------------------------------------------
+// Procedure: getBehavior()
+
+BhvProfile HelmProfile::getBehavior(unsigned int ix) const
+{
+  if(ix >= m_bhvs.size()) {
+    BhvProfile null_profile;
+    return(null_profile);
+  }
+  return(m_bhvs[ix]);
+}
+
+//-----------------------------------------------------------
+// Procedure: getSpec()
+
+string HelmProfile::getSpec() const
+{
+  string str = "iter=" + uintToString(m_iteration);
+  str += ",create=" + doubleToStringX(m_create_time, 3);
+  str += ",solve="  + doubleToStringX(m_solve_time, 3);
+  str += ",leafs="  + doubleToStringX(m_leafs, 0);
+  str += ",nodes="  + uintToString(m_nodes);
+  str += ",pruned=" + uintToString(m_pruned);
+
+  for(unsigned int i=0; i<m_bhvs.size(); i++) {
+    const BhvProfile& bhv = m_bhvs[i];
+    str += "#" + bhv.name + "=";
+    str += doubleToStringX(bhv.pre_time, 3) + ":";
+    str += doubleToStringX(bhv.run_time, 3) + ":";
+    str += doubleToStringX(bhv.build_time, 3) + ":";
+    str += doubleToStringX(bhv.norm_time, 3) + ":";
+    str += doubleToStringX(bhv.post_time, 3) + ":";
+    str += uintToString(bhv.pcs) + ":";
+    str += uintToString(bhv.nodes) + ":";
+    str += uintToString(bhv.pruned);
+  }
+  return(str);
+}
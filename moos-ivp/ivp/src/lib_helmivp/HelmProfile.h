@@ -0,0 +1,108 @@
+/*****************************************************************/
+/*    NAME: agent                                                */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: HelmProfile.h                                        */
+/*    DATE: Oct 19th, 2026                                       */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#ifndef HELM_PROFILE_HEADER
+#define HELM_PROFILE_HEADER
+
+#include <string>
+#include <vector>
+
+//---------------------------------------------------------------
+// Where one behavior's share of a helm iteration went. Times are
+// in milliseconds. The run time includes the build and normalize
+// times, which are what the OF_Reflector and PDMap normalization
+// cost while the behavior was in onRunState(). Nodes and pruned
+// are the branch and bound nodes the solver made at this
+// behavior's level, and how many of those were cut by the bound.
+
+class BhvProfile {
+public:
+  BhvProfile() {clear();}
+  ~BhvProfile() {}
+
+  void clear();
+
+  std::string  name;
+  double       pre_time;
+  double       run_time;
+  double       build_time;
+  double       norm_time;
+  double       post_time;
+  unsigned int pcs;
+  unsigned int nodes;
+  unsigned int pruned;
+
+  double totalTime() const {return(pre_time + run_time + post_time);}
+};
+
+//---------------------------------------------------------------
+// One record per helm iteration, posted by the helm as the compact
+// string from getSpec(), e.g.,
+//
+//   iter=12,create=4.512,solve=1.203,leafs=340,nodes=2000,pruned=1200
+//   #loiter=0.021:3.104:2.803:0.201:0.05:120:40:12#avoid_c=...
+//
+// where each behavior is pre:run:build:norm:post:pcs:nodes:pruned.
+
+class HelmProfile {
+public:
+  HelmProfile() {clear();}
+  ~HelmProfile() {}
+
+  void clear();
+
+  void setIteration(unsigned int v)  {m_iteration=v;}
+  void setCreateTime(double v)       {m_create_time=v;}
+  void setSolveTime(double v)        {m_solve_time=v;}
+  void setLeafs(double v)            {m_leafs=v;}
+  void setNodes(unsigned int v)      {m_nodes=v;}
+  void setPruned(unsigned int v)     {m_pruned=v;}
+
+  void addBehavior(const BhvProfile& bhv) {m_bhvs.push_back(bhv);}
+  bool setSolveCounts(const std::string& bhv_name,
+		      unsigned int nodes, unsigned int pruned);
+
+  unsigned int getIteration() const  {return(m_iteration);}
+  double       getCreateTime() const {return(m_create_time);}
+  double       getSolveTime() const  {return(m_solve_time);}
+  double       getLeafs() const      {return(m_leafs);}
+  unsigned int getNodes() const      {return(m_nodes);}
+  unsigned int getPruned() const     {return(m_pruned);}
+  unsigned int size() const          {return(m_bhvs.size());}
+
+  BhvProfile   getBehavior(unsigned int) const;
+
+  std::string  getSpec() const;
+
+protected:
+  unsigned int m_iteration;
+  double       m_create_time;
+  double       m_solve_time;
+  double       m_leafs;
+  unsigned int m_nodes;
+  unsigned int m_pruned;
+
+  std::vector<BhvProfile> m_bhvs;
+};
+
+#endif
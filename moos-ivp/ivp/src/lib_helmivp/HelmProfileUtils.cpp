@@ -0,0 +1,139 @@
+/*****************************************************************/
+/*    NAME: agent                                                */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: HelmProfileUtils.cpp                                 */
+/*    DATE: Oct 19th, 2026                                       */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#include "HelmProfile.h"
+#include <cstdlib>
+#include <algorithm>
+#include "HelmProfileUtils.h"
+#include "MBUtils.h"
+#include "ACTable.h"
+
+using namespace std;
+
+//-----------------------------------------------------------
+// Procedure: string2HelmProfile()
+//   Purpose: Rebuild a profile from the string made by getSpec().
+//            Unknown fields are ignored so records from newer
+//            helms can still be read.
+
+HelmProfile string2HelmProfile(const string& str)
+{
+  HelmProfile profile;
+
+  vector<string> svector = parseString(str, '#');
+  if(svector.size() == 0)
+    return(profile);
+
+  vector<string> fields = parseString(svector[0], ',');
+  for(unsigned int i=0; i<fields.size(); i++) {
+    string param = biteStringX(fields[i], '=');
+    string value = fields[i];
+    if(param == "iter")
+      profile.setIteration(atoi(value.c_str()));
+    else if(param == "create")
+      profile.setCreateTime(atof(value.c_str()));
+    else if(param == "solve")
+      profile.setSolveTime(atof(value.c_str()));
+    else if(param == "leafs")
+      profile.setLeafs(atof(value.c_str()));
+    else if(param == "nodes")
+      profile.setNodes(atoi(value.c_str()));
+    else if(param == "pruned")
+      profile.setPruned(atoi(value.c_str()));
+  }
+
+  for(unsigned int i=1; i<svector.size(); i++) {
+    BhvProfile bhv;
+    bhv.name = biteStringX(svector[i], '=');
+    vector<string> vals = parseString(svector[i], ':');
+    if((bhv.name == "") || (vals.size() < 8))
+      continue;
+    bhv.pre_time   = atof(vals[0].c_str());
+    bhv.run_time   = atof(vals[1].c_str());
+    bhv.build_time = atof(vals[2].c_str());
+    bhv.norm_time  = atof(vals[3].c_str());
+    bhv.post_time  = atof(vals[4].c_str());
+    bhv.pcs    = atoi(vals[5].c_str());
+    bhv.nodes  = atoi(vals[6].c_str());
+    bhv.pruned = atoi(vals[7].c_str());
+    profile.addBehavior(bhv);
+  }
+
+  return(profile);
+}
+
+//-----------------------------------------------------------
+// Procedure: helmProfileReport()
+//   Example:
+//
+//   Behavior  Total  Pre    Run    Build  Norm   Post   Pcs  Nodes  Pruned
+//   --------  -----  -----  -----  -----  -----  -----  ---  -----  ------
+//   avoid_c   4.102  0.010  4.071  3.902  0.110  0.021  640  5120   4800
+//   loiter    0.301  0.012  0.270  0.201  0.021  0.019  120  40     12
+
+static bool moreCostly(const BhvProfile& a, const BhvProfile& b)
+{
+  return(a.totalTime() > b.totalTime());
+}
+
+vector<string> helmProfileReport(const HelmProfile& profile, bool headers)
+{
+  vector<BhvProfile> bhvs;
+  for(unsigned int i=0; i<profile.size(); i++)
+    bhvs.push_back(profile.getBehavior(i));
+  stable_sort(bhvs.begin(), bhvs.end(), moreCostly);
+
+  ACTable actab(10,2);
+  if(headers) {
+    actab << "Behavior" << "Total" << "Pre" << "Run" << "Build";
+    actab << "Norm" << "Post" << "Pcs" << "Nodes" << "Pruned";
+    actab.addHeaderLines();
+  }
+
+  for(unsigned int i=0; i<bhvs.size(); i++) {
+    const BhvProfile& bhv = bhvs[i];
+    actab << bhv.name;
+    actab << doubleToString(bhv.totalTime(), 3);
+    actab << doubleToString(bhv.pre_time, 3);
+    actab << doubleToString(bhv.run_time, 3);
+    actab << doubleToString(bhv.build_time, 3);
+    actab << doubleToString(bhv.norm_time, 3);
+    actab << doubleToString(bhv.post_time, 3);
+    actab << uintToString(bhv.pcs);
+    actab << uintToString(bhv.nodes);
+    actab << uintToString(bhv.pruned);
+  }
+
+  vector<string> rvector = actab.getTableOutput();
+
+  string summary = "Iteration: " + uintToString(profile.getIteration());
+  summary += "  Create(ms): " + doubleToString(profile.getCreateTime(), 3);
+  summary += "  Solve(ms): "  + doubleToString(profile.getSolveTime(), 3);
+  summary += "  Leafs: "  + doubleToStringX(profile.getLeafs(), 0);
+  summary += "  Nodes: "  + uintToString(profile.getNodes());
+  summary += "  Pruned: " + uintToString(profile.getPruned());
+  rvector.insert(rvector.begin(), "");
+  rvector.insert(rvector.begin(), summary);
+
+  return(rvector);
+}
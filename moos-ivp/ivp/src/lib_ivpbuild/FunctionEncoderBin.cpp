@@ -0,0 +1,711 @@
+/*****************************************************************/
+/*    NAME: agent                                                */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: FunctionEncoderBin.cpp                               */
+/*    DATE: Oct 19th, 2026                                       */
+/*                                                               */
+/* This file is part of IvP Helm Core Libs                       */
+/*                                                               */
+/* IvP Helm Core Libs is free software: you can redistribute it  */
+/* and/or modify it under the terms of the Lesser GNU General    */
+/* Public License as published by the Free Software Foundation,  */
+/* either version 3 of the License, or (at your option) any      */
+/* later version.                                                */
+/*                                                               */
+/* IvP Helm Core Libs is distributed in the hope that it will    */
+/* be useful but WITHOUT ANY WARRANTY; without even the implied  */
+/* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR       */
+/* PURPOSE. See the Lesser GNU General Public License for more   */
+/* details.                                                      */
+/*                                                               */
+/* You should have received a copy of the Lesser GNU General     */
+/* Public License along with MOOS-IvP.  If not, see              */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#include <cstdlib>
+#include <cmath>
+#include "MBUtils.h"
+#include "BuildUtils.h"
+#include "FunctionEncoderBin.h"
+
+using namespace std;
+
+static const char *b64_chars = 
+  "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+//--------------------------------------------------------------
+// Procedure: putVarint, getVarint
+//      Note: Seven bits per byte, high bit set on all but the last.
+
+static void putVarint(string& buff, unsigned long long val)
+{
+  while(val >= 0x80) {
+    buff += (char)((val & 0x7f) | 0x80);
+    val >>= 7;
+  }
+  buff += (char)(val);
+}
+
+static bool getVarint(const string& buff, unsigned int& ix,
+		      unsigned long long& val)
+{
+  val = 0;
+  unsigned int shift = 0;
+  while((ix < buff.length()) && (shift < 64)) {
+    unsigned char c = (unsigned char)(buff[ix++]);
+    val |= ((unsigned long long)(c & 0x7f)) << shift;
+    if((c & 0x80) == 0)
+      return(true);
+    shift += 7;
+  }
+  return(false);
+}
+
+//--------------------------------------------------------------
+// Procedure: putSigned, getSigned
+//      Note: Zigzag coded so small negative values stay short.
+
+static void putSigned(string& buff, long long val)
+{
+  unsigned long long zval = ((unsigned long long)(val) << 1);
+  if(val < 0)
+    zval = ~zval;
+  putVarint(buff, zval);
+}
+
+static bool getSigned(const string& buff, unsigned int& ix,
+		      long long& val)
+{
+  unsigned long long zval;
+  if(!getVarint(buff, ix, zval))
+    return(false);
+  val = (long long)(zval >> 1);
+  if(zval & 1)
+    val = ~val;
+  return(true);
+}
+
+//--------------------------------------------------------------
+// Procedure: putDouble, getDouble
+//      Note: Raw IEEE bits, least significant byte first.
+
+static void putDouble(string& buff, double dval)
+{
+  union {double d; unsigned long long u;} bits;
+  bits.d = dval;
+  for(unsigned int i=0; i<8; i++)
+    buff += (char)((bits.u >> (8*i)) & 0xff);
+}
+
+static bool getDouble(const string& buff, unsigned int& ix, double& dval)
+{
+  if((ix + 8) > buff.length())
+    return(false);
+  union {double d; unsigned long long u;} bits;
+  bits.u = 0;
+  for(unsigned int i=0; i<8; i++)
+    bits.u |= ((unsigned long long)((unsigned char)(buff[ix++]))) << (8*i);
+  dval = bits.d;
+  return(true);
+}
+
+//--------------------------------------------------------------
+// Procedure: base64Encode, base64Decode
+//      Note: No padding, the body length is implied by the string.
+
+static void base64Encode(const string& buff, string& str)
+{
+  unsigned int len  = buff.length();
+  unsigned int six  = str.length();
+  str.resize(six + ((len * 4) + 2) / 3);
+
+  const unsigned char *src = (const unsigned char*)(buff.data());
+  unsigned int i = 0;
+  for(; i+2<len; i+=3) {
+    unsigned int n = (src[i] << 16) | (src[i+1] << 8) | src[i+2];
+    str[six++] = b64_chars[(n >> 18) & 63];
+    str[six++] = b64_chars[(n >> 12) & 63];
+    str[six++] = b64_chars[(n >> 6) & 63];
+    str[six++] = b64_chars[n & 63];
+  }
+  if(i < len) {
+    unsigned int n = (src[i] << 16);
+    if(i+1 < len)
+      n |= (src[i+1] << 8);
+    str[six++] = b64_chars[(n >> 18) & 63];
+    str[six++] = b64_chars[(n >> 12) & 63];
+    if(i+1 < len)
+      str[six++] = b64_chars[(n >> 6) & 63];
+  }
+}
+
+static bool base64Decode(const string& str, unsigned int start, string& buff)
+{
+  static int table[256];
+  static bool table_set = false;
+  if(!table_set) {
+    for(unsigned int i=0; i<256; i++)
+      table[i] = -1;
+    for(unsigned int i=0; i<64; i++)
+      table[(unsigned char)(b64_chars[i])] = i;
+    table_set = true;
+  }
+
+  unsigned int len = str.length() - start;
+  buff.resize((len * 3) / 4);
+
+  const unsigned char *src = (const unsigned char*)(str.data()) + start;
+  unsigned int bits = 0;
+  int nbits = 0;
+  unsigned int bix = 0;
+  for(unsigned int i=0; i<len; i++) {
+    int v = table[src[i]];
+    if(v < 0)
+      return(false);
+    bits = (bits << 6) | v;
+    nbits += 6;
+    if(nbits >= 8) {
+      nbits -= 8;
+      buff[bix++] = (char)((bits >> nbits) & 0xff);
+    }
+  }
+  return(true);
+}
+
+//--------------------------------------------------------------
+// Procedure: parseHeader
+//   Purpose: Split B,T,cstr_len,cstr,<body> into its parts.
+//   Returns: The index of the body, or 0 if malformed
+
+static unsigned int parseHeader(const string& str, char& type, string& cstr)
+{
+  if((str.length() < 6) || (str[0] != 'B') || (str[1] != ',') ||
+     (str[3] != ','))
+    return(0);
+  type = str[2];
+  
+  unsigned int cix = 4;
+  unsigned int cstr_len = 0;
+  while((cix < str.length()) && (str[cix] != ',')) {
+    if((str[cix] < '0') || (str[cix] > '9'))
+      return(0);
+    cstr_len = (cstr_len * 10) + (str[cix] - '0');
+    cix++;
+  }
+  cix++;
+  if((cix + cstr_len) >= str.length())
+    return(0);
+  cstr = str.substr(cix, cstr_len);
+  cix += cstr_len;
+  if(str[cix] != ',')
+    return(0);
+  return(cix+1);
+}
+
+//--------------------------------------------------------------
+// Procedure: buildString
+
+static string buildString(char type, const string& cstr, const string& body)
+{
+  string str = "B,";
+  str += type;
+  str += "," + uintToString(cstr.length()) + "," + cstr + ",";
+  base64Encode(body, str);
+  return(str);
+}
+
+//--------------------------------------------------------------
+// Constructor
+
+IPFBinFrame::IPFBinFrame()
+{
+  m_dim = 0;
+  m_deg = 0;
+  m_wtc = 0;
+  m_pcs = 0;
+  m_pwt = 0;
+}
+
+//--------------------------------------------------------------
+// Procedure: setFromIPF
+
+bool IPFBinFrame::setFromIPF(IvPFunction *ipf)
+{
+  m_pcs = 0;
+  if(!ipf || !ipf->getPDMap() || (ipf->getPDMap()->size() == 0))
+    return(false);
+
+  PDMap *pdmap = ipf->getPDMap();
+  m_cstr   = ipf->getContextStr();
+  m_domain = domainToString(pdmap->getDomain());
+  m_dim    = ipf->getDim();
+  m_deg    = pdmap->getDegree();
+  m_wtc    = pdmap->bx(0)->getWtc();
+  m_pwt    = ipf->getPWT();
+  
+  IvPBox gelbox = pdmap->getGelBox();
+  m_gel.resize(m_dim);
+  for(unsigned int d=0; d<m_dim; d++)
+    m_gel[d] = gelbox.pt(d,1);
+
+  unsigned int pcs = pdmap->size();
+  m_pts.resize(pcs * m_dim * 2);
+  m_bds.resize(pcs);
+  m_wts.resize(pcs * m_wtc);
+  for(unsigned int i=0; i<pcs; i++) {
+    const IvPBox *ibox = pdmap->bx(i);
+    unsigned int bds = 0;
+    for(unsigned int d=0; d<m_dim; d++) {
+      m_pts[(i*m_dim + d)*2]   = ibox->pt(d,0);
+      m_pts[(i*m_dim + d)*2+1] = ibox->pt(d,1);
+      if(ibox->bd(d,0) == 0)
+	bds |= (1 << (2*d));
+      if(ibox->bd(d,1) == 0)
+	bds |= (2 << (2*d));
+    }
+    m_bds[i] = bds;
+    for(unsigned int j=0; j<m_wtc; j++)
+      m_wts[i*m_wtc + j] = llround(ibox->wt(j) * 10000);
+  }
+  m_pcs = pcs;
+  return(true);
+}
+
+//--------------------------------------------------------------
+// Procedure: getKeyString
+//      Note: Box bounds are coded against the prior box in the same
+//            function, and weights against the prior box's weights,
+//            since neighboring pieces tend to be alike.
+
+string IPFBinFrame::getKeyString() const
+{
+  if(!valid())
+    return("");
+
+  string body;
+  body.reserve(64 + m_pcs * (m_dim*2 + m_wtc*2 + 1));
+
+  putVarint(body, m_dim);
+  putVarint(body, m_pcs);
+  putVarint(body, m_deg);
+  putVarint(body, m_wtc);
+  putDouble(body, m_pwt);
+  putVarint(body, m_domain.length());
+  body += m_domain;
+  for(unsigned int d=0; d<m_dim; d++)
+    putVarint(body, m_gel[d]);
+
+  for(unsigned int i=0; i<m_pcs; i++) {
+    putVarint(body, m_bds[i]);
+    for(unsigned int d=0; d<m_dim; d++) {
+      unsigned int ix = (i*m_dim + d)*2;
+      long long prev = 0;
+      if(i > 0)
+	prev = m_pts[ix - (m_dim*2)];
+      putSigned(body, m_pts[ix] - prev);
+      putSigned(body, m_pts[ix+1] - m_pts[ix]);
+    }
+    for(unsigned int j=0; j<m_wtc; j++) {
+      unsigned int ix = i*m_wtc + j;
+      long long prev = 0;
+      if(i > 0)
+	prev = m_wts[ix - m_wtc];
+      putSigned(body, m_wts[ix] - prev);
+    }
+  }
+  return(buildString('K', m_cstr, body));
+}
+
+//--------------------------------------------------------------
+// Procedure: setFromKey
+
+bool IPFBinFrame::setFromKey(const string& str)
+{
+  m_pcs = 0;
+
+  char   type;
+  string body;
+  unsigned int bix = parseHeader(str, type, m_cstr);
+  if((bix == 0) || (type != 'K') || !base64Decode(str, bix, body))
+    return(false);
+
+  unsigned int ix = 0;
+  unsigned long long dim, pcs, deg, wtc, dlen;
+  if(!getVarint(body, ix, dim) || !getVarint(body, ix, pcs) ||
+     !getVarint(body, ix, deg) || !getVarint(body, ix, wtc) ||
+     !getDouble(body, ix, m_pwt) || !getVarint(body, ix, dlen))
+    return(false);
+  if((dim == 0) || (dim > 16) || (pcs == 0) || ((ix + dlen) > body.length()))
+    return(false);
+  if(wtc != (deg*dim)+1)
+    return(false);
+  m_dim = dim;
+  m_deg = deg;
+  m_wtc = wtc;
+  m_domain = body.substr(ix, dlen);
+  ix += dlen;
+
+  m_gel.resize(m_dim);
+  for(unsigned int d=0; d<m_dim; d++) {
+    unsigned long long val;
+    if(!getVarint(body, ix, val))
+      return(false);
+    m_gel[d] = val;
+  }
+
+  // Each box takes at least one byte per field
+  if((body.length() - ix) < pcs * (1 + m_dim*2 + m_wtc))
+    return(false);
+  m_pts.resize(pcs * m_dim * 2);
+  m_bds.resize(pcs);
+  m_wts.resize(pcs * m_wtc);
+  for(unsigned int i=0; i<pcs; i++) {
+    unsigned long long bds;
+    if(!getVarint(body, ix, bds))
+      return(false);
+    m_bds[i] = bds;
+    for(unsigned int d=0; d<m_dim; d++) {
+      unsigned int pix = (i*m_dim + d)*2;
+      long long lo, span;
+      if(!getSigned(body, ix, lo) || !getSigned(body, ix, span))
+	return(false);
+      if(i > 0)
+	lo += m_pts[pix - (m_dim*2)];
+      m_pts[pix]   = lo;
+      m_pts[pix+1] = lo + span;
+    }
+    for(unsigned int j=0; j<m_wtc; j++) {
+      unsigned int wix = i*m_wtc + j;
+      long long wt;
+      if(!getSigned(body, ix, wt))
+	return(false);
+      if(i > 0)
+	wt += m_wts[wix - m_wtc];
+      m_wts[wix] = wt;
+    }
+  }
+  m_pcs = pcs;
+  return(true);
+}
+
+//--------------------------------------------------------------
+// Procedure: sameShape
+//   Purpose: True if a delta may be taken between the two frames:
+//            same domain, degree and piece count.
+
+bool IPFBinFrame::sameShape(const IPFBinFrame& frame) const
+{
+  return(valid() && (m_pcs == frame.m_pcs) && (m_dim == frame.m_dim) &&
+	 (m_deg == frame.m_deg) && (m_domain == frame.m_domain) &&
+	 (m_gel == frame.m_gel));
+}
+
+//--------------------------------------------------------------
+// Procedure: getDeltaString
+//      Note: Each box starts with a flags varint. Bit 0 is set if the
+//            box bounds differ from the base box, the remaining bits
+//            are the open bounds. Unchanged bounds cost nothing, and
+//            weights are coded against the base weights.
+//   Returns: "" if the frames do not share a shape
+
+string IPFBinFrame::getDeltaString(const IPFBinFrame& base) const
+{
+  if(!sameShape(base))
+    return("");
+
+  string body;
+  body.reserve(16 + m_pcs * (m_wtc + 1));
+
+  putVarint(body, base.getIteration());
+  putDouble(body, m_pwt);
+
+  for(unsigned int i=0; i<m_pcs; i++) {
+    unsigned int pix = i*m_dim*2;
+    bool moved = false;
+    for(unsigned int k=0; (k<m_dim*2) && !moved; k++)
+      moved = (m_pts[pix+k] != base.m_pts[pix+k]);
+
+    putVarint(body, (((unsigned long long)(m_bds[i])) << 1) | (moved?1:0));
+    if(moved) {
+      for(unsigned int k=0; k<m_dim*2; k++)
+	putSigned(body, m_pts[pix+k] - base.m_pts[pix+k]);
+    }
+    for(unsigned int j=0; j<m_wtc; j++) {
+      unsigned int wix = i*m_wtc + j;
+      putSigned(body, m_wts[wix] - base.m_wts[wix]);
+    }
+  }
+  return(buildString('D', m_cstr, body));
+}
+
+//--------------------------------------------------------------
+// Procedure: setFromDelta
+
+bool IPFBinFrame::setFromDelta(const string& str, const IPFBinFrame& base)
+{
+  m_pcs = 0;
+  if(!base.valid())
+    return(false);
+
+  char   type;
+  string body;
+  unsigned int bix = parseHeader(str, type, m_cstr);
+  if((bix == 0) || (type != 'D') || !base64Decode(str, bix, body))
+    return(false);
+
+  unsigned int ix = 0;
+  unsigned long long base_iter;
+  if(!getVarint(body, ix, base_iter) || !getDouble(body, ix, m_pwt))
+    return(false);
+  if(base_iter != base.getIteration())
+    return(false);
+
+  m_dim    = base.m_dim;
+  m_deg    = base.m_deg;
+  m_wtc    = base.m_wtc;
+  m_domain = base.m_domain;
+  m_gel    = base.m_gel;
+  m_pts    = base.m_pts;
+  m_bds    = base.m_bds;
+  m_wts    = base.m_wts;
+
+  for(unsigned int i=0; i<base.m_pcs; i++) {
+    unsigned long long flags;
+    if(!getVarint(body, ix, flags))
+      return(false);
+    m_bds[i] = (flags >> 1);
+    if(flags & 1) {
+      unsigned int pix = i*m_dim*2;
+      for(unsigned int k=0; k<m_dim*2; k++) {
+	long long diff;
+	if(!getSigned(body, ix, diff))
+	  return(false);
+	m_pts[pix+k] += diff;
+      }
+    }
+    for(unsigned int j=0; j<m_wtc; j++) {
+      long long diff;
+      if(!getSigned(body, ix, diff))
+	return(false);
+      m_wts[i*m_wtc + j] += diff;
+    }
+  }
+  m_pcs = base.m_pcs;
+  return(true);
+}
+
+//--------------------------------------------------------------
+// Procedure: getIPF
+//   Purpose: Build the function, in the same manner as the ascii
+//            decoder StringToIvPFunction.
+
+IvPFunction *IPFBinFrame::getIPF() const
+{
+  if(!valid())
+    return(0);
+
+  IvPDomain domain = stringToDomain(m_domain);
+  if(domain.size() != m_dim)
+    return(0);
+
+  IvPBox gelbox(m_dim,0);
+  for(unsigned int d=0; d<m_dim; d++)
+    gelbox.setPTS(d, 0, m_gel[d]);
+
+  PDMap *pdmap = new PDMap(m_pcs, domain, m_deg);
+  for(unsigned int i=0; i<m_pcs; i++) {
+    IvPBox *newbox = new IvPBox(m_dim, m_deg);
+    for(unsigned int d=0; d<m_dim; d++) {
+      unsigned int pix = (i*m_dim + d)*2;
+      newbox->setPTS(d, m_pts[pix], m_pts[pix+1]);
+      if(m_bds[i] & (1 << (2*d)))
+	newbox->bd(d,0) = 0;
+      if(m_bds[i] & (2 << (2*d)))
+	newbox->bd(d,1) = 0;
+    }
+    for(unsigned int j=0; j<m_wtc; j++)
+      newbox->wt(j) = (double)(m_wts[i*m_wtc + j]) / 10000.0;
+    pdmap->bx(i) = newbox;
+  }
+
+  pdmap->setGelBox(gelbox);
+  pdmap->updateGrid(1,1);
+  IvPFunction *new_of = new IvPFunction(pdmap);
+  new_of->setPWT(m_pwt);
+  new_of->setContextStr(m_cstr);
+  return(new_of);
+}
+
+//--------------------------------------------------------------
+// Procedure: getIteration
+//      Note: The context string is of the form NUM:SOURCE
+
+unsigned int IPFBinFrame::getIteration() const
+{
+  return(atoi(m_cstr.c_str()));
+}
+
+//--------------------------------------------------------------
+// Procedure: getSource
+
+string IPFBinFrame::getSource() const
+{
+  size_t pos = m_cstr.find(':');
+  if(pos == string::npos)
+    return(m_cstr);
+  return(m_cstr.substr(pos+1));
+}
+
+//--------------------------------------------------------------
+// Constructor
+
+IPFBinCoder::IPFBinCoder()
+{
+  m_deltas  = true;
+  m_key_gap = 20;
+
+  m_key_count   = 0;
+  m_delta_count = 0;
+}
+
+//--------------------------------------------------------------
+// Procedure: clear
+
+void IPFBinCoder::clear()
+{
+  m_frames.clear();
+  m_since_key.clear();
+  m_key_count   = 0;
+  m_delta_count = 0;
+}
+
+//--------------------------------------------------------------
+// Procedure: encode
+//      Note: A keyframe is sent every m_key_gap functions from a
+//            source so a late joining decoder will catch up.
+
+string IPFBinCoder::encode(IvPFunction *ipf)
+{
+  IPFBinFrame frame;
+  if(!frame.setFromIPF(ipf))
+    return("");
+
+  string source = frame.getSource();
+  string str;
+  if(m_deltas && (m_since_key[source] < m_key_gap)) {
+    map<string, IPFBinFrame>::iterator p = m_frames.find(source);
+    if(p != m_frames.end())
+      str = frame.getDeltaString(p->second);
+  }
+
+  if(str != "") {
+    m_since_key[source]++;
+    m_delta_count++;
+  }
+  else {
+    str = frame.getKeyString();
+    m_since_key[source] = 1;
+    m_key_count++;
+  }
+
+  if(m_deltas)
+    m_frames[source] = frame;
+  return(str);
+}
+
+//--------------------------------------------------------------
+// Procedure: resolve
+
+string IPFBinCoder::resolve(const string& str)
+{
+  if(!isBinIPFString(str))
+    return(str);
+
+  IPFBinFrame frame;
+  if(!isBinIPFDelta(str)) {
+    if(!frame.setFromKey(str))
+      return("");
+    m_frames[frame.getSource()] = frame;
+    m_key_count++;
+    return(str);
+  }
+
+  char   type;
+  string cstr;
+  if(parseHeader(str, type, cstr) == 0)
+    return("");
+  string source = cstr;
+  size_t pos = cstr.find(':');
+  if(pos != string::npos)
+    source = cstr.substr(pos+1);
+
+  map<string, IPFBinFrame>::iterator p = m_frames.find(source);
+  if((p == m_frames.end()) || !frame.setFromDelta(str, p->second))
+    return("");
+
+  p->second = frame;
+  m_delta_count++;
+  return(frame.getKeyString());
+}
+
+//--------------------------------------------------------------
+// Procedure: IvPFunctionToBinString
+
+string IvPFunctionToBinString(IvPFunction *ipf)
+{
+  IPFBinFrame frame;
+  if(!frame.setFromIPF(ipf))
+    return("");
+  return(frame.getKeyString());
+}
+
+//--------------------------------------------------------------
+// Procedure: BinStringToIvPFunction
+
+IvPFunction *BinStringToIvPFunction(const string& str)
+{
+  IPFBinFrame frame;
+  if(!frame.setFromKey(str))
+    return(0);
+  return(frame.getIPF());
+}
+
+//--------------------------------------------------------------
+// Procedure: BinStringToIvPContext
+
+string BinStringToIvPContext(const string& str)
+{
+  char   type;
+  string cstr;
+  parseHeader(str, type, cstr);
+  return(cstr);
+}
+
+//--------------------------------------------------------------
+// Procedure: BinStringToIvPDomain
+
+IvPDomain BinStringToIvPDomain(const string& str)
+{
+  IPFBinFrame frame;
+  if(!frame.setFromKey(str))
+    return(IvPDomain());
+  return(stringToDomain(frame.getDomain()));
+}
+
+//--------------------------------------------------------------
+// Procedure: isBinIPFString
+
+bool isBinIPFString(const string& str)
+{
+  return((str.length() > 4) && (str[0] == 'B') && (str[1] == ',') &&
+	 ((str[2] == 'K') || (str[2] == 'D')) && (str[3] == ','));
+}
+
+//--------------------------------------------------------------
+// Procedure: isBinIPFDelta
+
+bool isBinIPFDelta(const string& str)
+{
+  return(isBinIPFString(str) && (str[2] == 'D'));
+}
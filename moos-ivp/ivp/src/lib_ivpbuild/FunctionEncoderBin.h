@@ -0,0 +1,133 @@
+/*****************************************************************/
+/*    NAME: agent                                                */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: FunctionEncoderBin.h                                 */
+/*    DATE: Oct 19th, 2026                                       */
+/*                                                               */
+/* This file is part of IvP Helm Core Libs                       */
+/*                                                               */
+/* IvP Helm Core Libs is free software: you can redistribute it  */
+/* and/or modify it under the terms of the Lesser GNU General    */
+/* Public License as published by the Free Software Foundation,  */
+/* either version 3 of the License, or (at your option) any      */
+/* later version.                                                */
+/*                                                               */
+/* IvP Helm Core Libs is distributed in the hope that it will    */
+/* be useful but WITHOUT ANY WARRANTY; without even the implied  */
+/* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR       */
+/* PURPOSE. See the Lesser GNU General Public License for more   */
+/* details.                                                      */
+/*                                                               */
+/* You should have received a copy of the Lesser GNU General     */
+/* Public License along with MOOS-IvP.  If not, see              */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#ifndef FUNCTION_ENCODER_BIN_HEADER
+#define FUNCTION_ENCODER_BIN_HEADER
+
+#include <string>
+#include <vector>
+#include <map>
+#include "IvPFunction.h"
+
+// A binary IPF string keeps the context string in plain text, so the
+// helm iteration and source can be read without decoding the body.
+// The body is varint coded and then base64 coded to survive MOOS
+// strings and alog files:
+//
+//   B,K,cstr_len,cstr,<body>   Keyframe, self contained
+//   B,D,cstr_len,cstr,<body>   Delta against the previous function
+//                              from the same source
+//
+// Weights are kept in units of 0.0001, the same precision as the
+// ascii encoding in FunctionEncoder.
+
+class IPFBinFrame
+{
+public:
+  IPFBinFrame();
+  ~IPFBinFrame() {}
+
+  bool  setFromIPF(IvPFunction*);
+  bool  setFromKey(const std::string&);
+  bool  setFromDelta(const std::string&, const IPFBinFrame& base);
+
+  IvPFunction *getIPF() const;
+  std::string  getKeyString() const;
+  std::string  getDeltaString(const IPFBinFrame& base) const;
+
+  bool  sameShape(const IPFBinFrame&) const;
+  bool  valid() const           {return(m_pcs > 0);}
+
+  std::string  getContext() const {return(m_cstr);}
+  std::string  getDomain() const  {return(m_domain);}
+  unsigned int getIteration() const;
+  std::string  getSource() const;
+
+protected:
+  std::string  m_cstr;
+  std::string  m_domain;
+  unsigned int m_dim;
+  unsigned int m_deg;
+  unsigned int m_wtc;
+  unsigned int m_pcs;
+  double       m_pwt;
+
+  std::vector<int>          m_gel;  // gelbox upper pt per dim
+  std::vector<int>          m_pts;  // lo,hi per dim per box
+  std::vector<unsigned int> m_bds;  // open bound bits per box
+  std::vector<long long>    m_wts;  // weights per box
+};
+
+class IPFBinCoder
+{
+public:
+  IPFBinCoder();
+  ~IPFBinCoder() {}
+
+  void  setDeltas(bool v)          {m_deltas=v;}
+  void  setKeyGap(unsigned int v)  {m_key_gap=v;}
+  void  clear();
+
+  // Encoder side: serialize against the last function from the
+  // same source, if deltas are enabled.
+  std::string encode(IvPFunction*);
+
+  // Decoder side: return a self-contained string for any IPF string.
+  // Ascii and keyframe strings pass through, delta strings are
+  // expanded to keyframes. Returns "" if the base is missing.
+  std::string resolve(const std::string&);
+
+  unsigned int getKeyCount() const   {return(m_key_count);}
+  unsigned int getDeltaCount() const {return(m_delta_count);}
+
+protected:
+  bool         m_deltas;
+  unsigned int m_key_gap;
+  unsigned int m_key_count;
+  unsigned int m_delta_count;
+
+  std::map<std::string, IPFBinFrame>  m_frames;
+  std::map<std::string, unsigned int> m_since_key;
+};
+
+// Convert an IvPFunction to a binary keyframe string
+std::string IvPFunctionToBinString(IvPFunction*);
+
+// Create an IvPFunction from a binary keyframe string
+IvPFunction *BinStringToIvPFunction(const std::string&);
+
+// Get the context string of a binary key or delta string
+std::string BinStringToIvPContext(const std::string&);
+
+// Get the IvPDomain of a binary keyframe string
+IvPDomain BinStringToIvPDomain(const std::string&);
+
+// True if the string is in the binary encoding, key or delta
+bool isBinIPFString(const std::string&);
+
+// True if the string is a binary delta needing a prior function
+bool isBinIPFDelta(const std::string&);
+
+#endif
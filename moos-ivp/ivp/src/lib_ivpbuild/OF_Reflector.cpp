@@ -36,6 +36,7 @@
 #include "RT_Evaluator.h"
 #include "RT_AutoPeak.h"
 #include "MBUtils.h"
+#include "BuildTally.h"
 
 using namespace std;
 
@@ -89,6 +90,7 @@ OF_Reflector::~OF_Reflector()
   delete(m_rt_uniformx);
   delete(m_rt_smart);
   delete(m_rt_directed);
+  delete(m_rt_evaluator);
   delete(m_rt_autopeak);
 }
 
@@ -381,6 +383,11 @@ bool OF_Reflector::setParam(string param, string value)
       return(addWarning("auto_peak_max_pcs value must be > 0"));
     m_auto_peak_max_pcs = ival;
   }
+  else if((param == "threads") && isNumber(value)) {
+    if(ival < 0) 
+      return(addWarning("threads value must be >= 0"));
+    m_rt_evaluator->setThreads(ival);
+  }
   else 
     return(addWarning(param + ": unhandled parameter"));
 
@@ -425,6 +432,11 @@ bool OF_Reflector::setParam(string param, double value)
       return(addWarning(param + " value must be in range [0,1]"));
     m_pcheck_thresh = value;
   }
+  else if(param == "threads") {
+    if(value < 0) 
+      return(addWarning(param + " value must be >= 0"));
+    m_rt_evaluator->setThreads((unsigned int)(value));
+  }
   else 
     return(addWarning(param + ": undefined parameter"));
   
@@ -514,8 +526,24 @@ bool OF_Reflector::setParam(string param, IvPBox gbox)
 
 //-------------------------------------------------------------
 // Procedure: create
+//      Note: The time taken and pieces made are added to the
+//            BuildTally of this thread for the helm profiler.
 
 int OF_Reflector::create(int unif_amt, int smart_amt, double smart_thresh)
+{
+  double start_time = BuildTally::now();
+
+  int pcs = createPieces(unif_amt, smart_amt, smart_thresh);
+
+  BuildTally::local().addReflect(BuildTally::now() - start_time, pcs);
+  return(pcs);
+}
+
+//-------------------------------------------------------------
+// Procedure: createPieces
+
+int OF_Reflector::createPieces(int unif_amt, int smart_amt,
+			       double smart_thresh)
 {
   if(m_verbose) 
     cout << "========== Begin OF_Reflector::create() ===========" << endl;
@@ -76,6 +76,7 @@ public:
   double checkBasins(bool verbose=false) const;
 
  protected:
+  int    createPieces(int unif_amt, int smart_amt, double thresh);
   void   clearPDMap();
   bool   addWarning(std::string);
 
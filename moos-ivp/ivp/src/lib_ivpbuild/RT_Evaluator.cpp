@@ -25,6 +25,8 @@
 /*****************************************************************/
 
 #include <iostream>
+#include <atomic>
+#include <thread>
 #include "RT_Evaluator.h"
 #include "BuildUtils.h"
 #include "Regressor.h"
@@ -37,6 +39,7 @@ using namespace std;
 RT_Evaluator::RT_Evaluator(Regressor *regressor) 
 {
   m_regressor = regressor;
+  m_threads   = 1;
 }
 
 //-------------------------------------------------------------
@@ -58,19 +61,82 @@ void RT_Evaluator::evaluate(PDMap *pdmap, PQueue& pqueue)
   if(pdmap->getDomain().size() != m_regressor->getAOF()->getDim())
     return;
 
+  // Threads are only brought in when each has enough pieces to
+  // be worth the cost of starting it
+  int psize = pdmap->size();
+  unsigned int threads = m_threads;
+  if(threads == 0)
+    threads = thread::hardware_concurrency();
+  if(threads > (unsigned int)(psize / 64))
+    threads = psize / 64;
+
+  if(threads > 1) {
+    vector<double> deltas(psize, 0);
+    evaluateThreaded(pdmap, deltas, !pqueue.null(), threads);
+    if(!pqueue.null()) {
+      for(int i=0; i<psize; i++)
+	pqueue.insert(i, deltas[i]);
+    }
+    return;
+  }
+
   // If PQueue is null, just set piece weights
   if(pqueue.null()) {
-    for(int i=0; i<pdmap->size(); i++) 
+    for(int i=0; i<psize; i++) 
       m_regressor->setWeight(pdmap->bx(i), false);
   }
   // If PQueue is not null, set weights, calc delta, add to PQueue
   else {
-    for(int i=0; i<pdmap->size(); i++) {
+    for(int i=0; i<psize; i++) {
       double delta = m_regressor->setWeight(pdmap->bx(i), true);
       pqueue.insert(i, delta);
     }
   }
 }
 
+//-------------------------------------------------------------
+// Procedure: evaluateThreaded()
+//   Purpose: Set the piece weights on several threads, each with
+//            its own Regressor over the same AOF. Pieces are taken
+//            in blocks, and the weight of a piece depends only on
+//            the piece, so the result is the same as that of the
+//            serial loop. The deltas are returned by piece index to
+//            be queued in order by the caller.
+//      Note: The AOF must be safe to evaluate from several threads
+//            at once, which is why threads must be asked for.
+
+void RT_Evaluator::evaluateThreaded(PDMap *pdmap, vector<double>& deltas,
+				    bool feedback, unsigned int threads)
+{
+  const int block = 64;
+  int psize   = pdmap->size();
+  int blocks  = (psize + block - 1) / block;
+
+  vector<unsigned int> setwts(threads, 0);
+  vector<unsigned int> evals(threads, 0);
 
+  atomic<int> next(0);
+  auto worker = [&](unsigned int ix) {
+    Regressor *regressor = m_regressor->cloneConfig();
+    int k;
+    while((k = next.fetch_add(1)) < blocks) {
+      int end = (k+1) * block;
+      if(end > psize)
+	end = psize;
+      for(int i=k*block; i<end; i++)
+	deltas[i] = regressor->setWeight(pdmap->bx(i), feedback);
+    }
+    setwts[ix] = regressor->getTotalSetWts();
+    evals[ix]  = regressor->getTotalEvals();
+    delete(regressor);
+  };
+
+  vector<thread> pool;
+  for(unsigned int i=0; i<threads; i++)
+    pool.push_back(thread(worker, i));
+  for(unsigned int i=0; i<pool.size(); i++)
+    pool[i].join();
 
+  for(unsigned int i=0; i<threads; i++)
+    m_regressor->addTotals(setwts[i], evals[i]);
+}
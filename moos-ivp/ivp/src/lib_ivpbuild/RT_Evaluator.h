@@ -41,8 +41,16 @@ public:
 public: 
   void evaluate(PDMap*, PQueue&);
 
+  // Zero threads means one per available core
+  void setThreads(unsigned int v) {m_threads=v;}
+
+protected:
+  void evaluateThreaded(PDMap*, std::vector<double>&, bool feedback,
+			unsigned int threads);
+
 protected:
-  Regressor* m_regressor;
+  Regressor*   m_regressor;
+  unsigned int m_threads;
 };
 
 #endif
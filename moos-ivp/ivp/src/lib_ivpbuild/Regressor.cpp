@@ -95,6 +95,20 @@ Regressor::Regressor(const AOF *g_aof, int g_degree)
 
 }
 
+//-------------------------------------------------------------
+// Procedure: cloneConfig()
+//   Purpose: Make a regressor over the same AOF, with the same
+//            settings, for use by another thread. The working
+//            memory is the new regressor's own, and the totals
+//            start at zero.
+
+Regressor* Regressor::cloneConfig() const
+{
+  Regressor *regressor = new Regressor(m_aof, m_degree);
+  regressor->m_strict_range = m_strict_range;
+  return(regressor);
+}
+
 //-------------------------------------------------------------
 // Procedure: Destructor
 
@@ -35,11 +35,16 @@ public:
   Regressor(const AOF*, int deg=1);
   virtual ~Regressor();
 
+  // A new regressor over the same AOF with the same settings, but
+  // its own working memory and zero totals. Caller owns the result.
+  virtual Regressor* cloneConfig() const;
+
 public:  
   int     getDegree() const   {return(m_degree);}
 
   double  setWeight(IvPBox*, bool feedback=false);
   void    setStrictRange(bool val) {m_strict_range = val;}
+  bool    getStrictRange() const   {return(m_strict_range);}
 
   unsigned int getMessageCnt() const {return(m_messages.size());}
   std::string  getMessage(unsigned int);
@@ -48,6 +53,10 @@ public:
 
   unsigned int getTotalSetWts() const {return(m_total_setwts);}
   unsigned int getTotalEvals() const {return(m_total_evals);}
+
+  // Totals of other regressors working on the same function
+  void addTotals(unsigned int setwts, unsigned int evals)
+  {m_total_setwts += setwts; m_total_evals += evals;}
   
 protected:
   void    setCorners(IvPBox*);
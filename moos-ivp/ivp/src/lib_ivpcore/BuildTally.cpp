@@ -0,0 +1,67 @@
+/*****************************************************************/
+/*    NAME: agent                                                */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: BuildTally.cpp                                       */
+/*    DATE: Oct 19th, 2026                                       */
+/*                                                               */
+/* This file is part of IvP Helm Core Libs                       */
+/*                                                               */
+/* IvP Helm Core Libs is free software: you can redistribute it  */
+/* and/or modify it under the terms of the Lesser GNU General    */
+/* Public License as published by the Free Software Foundation,  */
+/* either version 3 of the License, or (at your option) any      */
+/* later version.                                                */
+/*                                                               */
+/* IvP Helm Core Libs is distributed in the hope that it will    */
+/* be useful but WITHOUT ANY WARRANTY; without even the implied  */
+/* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR       */
+/* PURPOSE. See the Lesser GNU General Public License for more   */
+/* details.                                                      */
+/*                                                               */
+/* You should have received a copy of the Lesser GNU General     */
+/* Public License along with MOOS-IvP.  If not, see              */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#include <chrono>
+#include "BuildTally.h"
+
+//-------------------------------------------------------------
+// Procedure: local()
+
+BuildTally& BuildTally::local()
+{
+  static thread_local BuildTally tally;
+  return(tally);
+}
+
+//-------------------------------------------------------------
+// Procedure: now()
+
+double BuildTally::now()
+{
+  std::chrono::steady_clock::duration since;
+  since = std::chrono::steady_clock::now().time_since_epoch();
+  return(std::chrono::duration<double>(since).count());
+}
+
+//-------------------------------------------------------------
+// Procedure: reset()
+
+void BuildTally::reset()
+{
+  m_reflect_time   = 0;
+  m_reflect_calls  = 0;
+  m_reflect_pcs    = 0;
+  m_normalize_time = 0;
+}
+
+//-------------------------------------------------------------
+// Procedure: addReflect()
+
+void BuildTally::addReflect(double secs, unsigned int pcs)
+{
+  m_reflect_time += secs;
+  m_reflect_calls++;
+  m_reflect_pcs += pcs;
+}
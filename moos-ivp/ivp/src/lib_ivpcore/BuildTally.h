@@ -0,0 +1,63 @@
+/*****************************************************************/
+/*    NAME: agent                                                */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: BuildTally.h                                         */
+/*    DATE: Oct 19th, 2026                                       */
+/*                                                               */
+/* This file is part of IvP Helm Core Libs                       */
+/*                                                               */
+/* IvP Helm Core Libs is free software: you can redistribute it  */
+/* and/or modify it under the terms of the Lesser GNU General    */
+/* Public License as published by the Free Software Foundation,  */
+/* either version 3 of the License, or (at your option) any      */
+/* later version.                                                */
+/*                                                               */
+/* IvP Helm Core Libs is distributed in the hope that it will    */
+/* be useful but WITHOUT ANY WARRANTY; without even the implied  */
+/* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR       */
+/* PURPOSE. See the Lesser GNU General Public License for more   */
+/* details.                                                      */
+/*                                                               */
+/* You should have received a copy of the Lesser GNU General     */
+/* Public License along with MOOS-IvP.  If not, see              */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+ 
+#ifndef IVP_BUILD_TALLY_HEADER
+#define IVP_BUILD_TALLY_HEADER
+
+//---------------------------------------------------------------
+// A BuildTally accumulates the time spent building IvP functions
+// on one thread: OF_Reflector::create() calls and the pieces they
+// made, and PDMap normalization. A caller (the helm, per behavior)
+// resets the tally of its thread, lets the builder run, and reads
+// back what the build cost without the builder knowing about it.
+
+class BuildTally {
+public:
+  BuildTally() {reset();}
+  ~BuildTally() {}
+
+  // The tally of the calling thread
+  static BuildTally& local();
+
+  // Seconds on a monotonic clock, microsecond resolution or better
+  static double now();
+
+  void   reset();
+  void   addReflect(double secs, unsigned int pcs);
+  void   addNormalize(double secs) {m_normalize_time += secs;}
+
+  double       getReflectTime() const   {return(m_reflect_time);}
+  unsigned int getReflectCalls() const  {return(m_reflect_calls);}
+  unsigned int getReflectPieces() const {return(m_reflect_pcs);}
+  double       getNormalizeTime() const {return(m_normalize_time);}
+
+protected:
+  double       m_reflect_time;
+  unsigned int m_reflect_calls;
+  unsigned int m_reflect_pcs;
+  double       m_normalize_time;
+};
+
+#endif
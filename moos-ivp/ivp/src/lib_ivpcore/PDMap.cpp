@@ -30,6 +30,7 @@
 #include "PDMap.h"
 #include "BoxSet.h"
 #include "IvPGrid.h"
+#include "BuildTally.h"
 
 #ifdef _WIN32
 #   include <float.h>
@@ -168,18 +169,22 @@ void PDMap::applyScalar(double scalar_val)
 
 void PDMap::normalize(double target_base, double target_range)
 {
+  double start_time = BuildTally::now();
+
   double existing_base = getMinWT();
   double existing_max  = getMaxWT();
   double existing_range = existing_max - existing_base;
 
-  if(existing_range <= 0)
-    return;
-
-  double base_adjustment  = target_base - existing_base; 
-  double range_adjustment = target_range / existing_range;
-
-  applyScalar(base_adjustment);
-  applyWeight(range_adjustment);
+  // A flat function is left as is, but the time spent finding
+  // that out is still tallied.
+  if(existing_range > 0) {
+    double base_adjustment  = target_base - existing_base; 
+    double range_adjustment = target_range / existing_range;
+    
+    applyScalar(base_adjustment);
+    applyWeight(range_adjustment);
+  }
+  BuildTally::local().addNormalize(BuildTally::now() - start_time);
 }
 
 //-------------------------------------------------------------
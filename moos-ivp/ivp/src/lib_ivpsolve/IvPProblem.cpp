@@ -110,6 +110,9 @@ void IvPProblem::solvePrior(const IvPBox *isolBox)
   for(int i=0; (i < m_ofnum+1); i++)
     nodeBox[i] = m_ofs[0]->getPDMap()->getUniverse().copy();
   nodeBox[0]->setWT(0.0);
+
+  m_level_nodes.assign(m_ofnum, 0);
+  m_level_pruned.assign(m_ofnum, 0);
   
   if(isolBox)
     processInitSol(isolBox);
@@ -155,8 +158,11 @@ bool IvPProblem::solve(const IvPBox *isolBox)
   int boxCount = pdmap->size();
   for(int i=0; i<boxCount; i++) {
     nodeBox[1]->copy(pdmap->bx(i));
+    m_level_nodes[0]++;
     if(!m_maxbox || (upperCheapBound(1, nodeBox[1]) > (m_maxwt + m_epsilon)))
       solveRecurse(1);
+    else
+      m_level_pruned[0]++;
   }    
  
   solvePost();
@@ -202,9 +208,12 @@ void IvPProblem::solveRecurse(int level)
     result = nodeBox[level]->intersect(cbox, nodeBox[level+1]);
     
     if(result) {
+      m_level_nodes[level]++;
       double upperBound = upperCheapBound(level+1, nodeBox[level+1]);
       if(!m_maxbox || (upperBound > (m_maxwt + m_epsilon)))
 	solveRecurse(level+1);
+      else
+	m_level_pruned[level]++;
     }
 
     levBSN = nextLevBSN;
@@ -256,8 +265,47 @@ double IvPProblem::upperCheapBound(int level, IvPBox *box)
   return(bound);
 }
 
+//---------------------------------------------------------------
+// Procedure: getLevelNodes()
+//   Purpose: Number of branch and bound nodes formed by intersecting
+//            with the pieces of the given level's function.
 
+unsigned int IvPProblem::getLevelNodes(unsigned int level) const
+{
+  if(level >= m_level_nodes.size())
+    return(0);
+  return(m_level_nodes[level]);
+}
 
+//---------------------------------------------------------------
+// Procedure: getLevelPruned()
+//   Purpose: Number of those nodes cut off by the upper bound.
 
+unsigned int IvPProblem::getLevelPruned(unsigned int level) const
+{
+  if(level >= m_level_pruned.size())
+    return(0);
+  return(m_level_pruned[level]);
+}
 
+//---------------------------------------------------------------
+// Procedure: getNodesVisited()
 
+unsigned int IvPProblem::getNodesVisited() const
+{
+  unsigned int total = 0;
+  for(unsigned int i=0; i<m_level_nodes.size(); i++)
+    total += m_level_nodes[i];
+  return(total);
+}
+
+//---------------------------------------------------------------
+// Procedure: getNodesPruned()
+
+unsigned int IvPProblem::getNodesPruned() const
+{
+  unsigned int total = 0;
+  for(unsigned int i=0; i<m_level_pruned.size(); i++)
+    total += m_level_pruned[i];
+  return(total);
+}
@@ -26,6 +26,7 @@
 #ifndef IVPPROBLEM_HEADER
 #define IVPPROBLEM_HEADER
 
+#include <vector>
 #include "Problem.h"
 #include "Compactor.h"
 
@@ -38,6 +39,13 @@ public:
   bool   solve(const IvPBox *isolbox=0);
   double getLeafsVisited() const {return(m_leafs_visited);}
 
+  // Branch and bound counts of the last solve, by level. Level i
+  // is the i-th objective function added.
+  unsigned int getLevelNodes(unsigned int) const;
+  unsigned int getLevelPruned(unsigned int) const;
+  unsigned int getNodesVisited() const;
+  unsigned int getNodesPruned() const;
+
 protected:
   void   solvePrior(const IvPBox *b=0);
   void   solveRecurse(int);
@@ -51,6 +59,9 @@ protected:
   bool       ownCompactor;
 
   double     m_leafs_visited;
+
+  std::vector<unsigned int> m_level_nodes;
+  std::vector<unsigned int> m_level_pruned;
 };  
 
 #endif
@@ -0,0 +1,180 @@
+/*****************************************************************/
+/*    NAME: agent                                                */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: ALogBatch.cpp                                        */
+/*    DATE: Oct 19th, 2026                                       */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <sys/types.h>
+#include <sys/stat.h>
+#ifndef _WIN32
+#include <dirent.h>
+#include <glob.h>
+#endif
+#include "MBUtils.h"
+#include "ALogBatch.h"
+
+using namespace std;
+
+//--------------------------------------------------------
+// Procedure: fileSize()
+
+static double fileSize(const string& filename)
+{
+  struct stat buf;
+  if(stat(filename.c_str(), &buf) != 0)
+    return(0);
+  return((double)(buf.st_size));
+}
+
+//--------------------------------------------------------
+// Procedure: isDir()
+
+static bool isDir(const string& filename)
+{
+  struct stat buf;
+  if(stat(filename.c_str(), &buf) != 0)
+    return(false);
+  return((buf.st_mode & S_IFMT) == S_IFDIR);
+}
+
+//--------------------------------------------------------
+// Procedure: findALogFiles()
+//   Purpose: Recursively collect all .alog files under dir
+
+static void findALogFiles(const string& dir, vector<string>& files)
+{
+#ifndef _WIN32
+  DIR *dp = opendir(dir.c_str());
+  if(!dp)
+    return;
+
+  struct dirent *dirp;
+  while((dirp = readdir(dp)) != NULL) {
+    string name = dirp->d_name;
+    if((name == ".") || (name == ".."))
+      continue;
+    string path = dir + "/" + name;
+    if(isDir(path))
+      findALogFiles(path, files);
+    else if(strEnds(name, ".alog"))
+      files.push_back(path);
+  }
+  closedir(dp);
+#endif
+}
+
+//--------------------------------------------------------
+// Procedure: expandALogFiles()
+
+vector<string> expandALogFiles(const string& arg)
+{
+  vector<string> files;
+
+  if(isDir(arg)) {
+    string dir = arg;
+    while((dir.length() > 1) && (dir.at(dir.length()-1) == '/'))
+      dir = dir.substr(0, dir.length()-1);
+    findALogFiles(dir, files);
+  }
+#ifndef _WIN32
+  else if(strContains(arg, '*') || strContains(arg, '?') ||
+	  strContains(arg, '[')) {
+    glob_t gbuf;
+    if(glob(arg.c_str(), 0, NULL, &gbuf) == 0) {
+      for(size_t i=0; i<gbuf.gl_pathc; i++) {
+	string path = gbuf.gl_pathv[i];
+	if(isDir(path))
+	  findALogFiles(path, files);
+	else if(strEnds(path, ".alog"))
+	  files.push_back(path);
+      }
+    }
+    globfree(&gbuf);
+  }
+#endif
+  else if(strEnds(arg, ".alog"))
+    files.push_back(arg);
+
+  sort(files.begin(), files.end());
+  return(files);
+}
+
+//--------------------------------------------------------
+// Procedure: batchThreadCount()
+
+unsigned int batchThreadCount(unsigned int requested, unsigned int jobs)
+{
+  unsigned int threads = requested;
+  if(threads == 0)
+    threads = thread::hardware_concurrency();
+  if(threads == 0)
+    threads = 1;
+  if(threads > jobs)
+    threads = jobs;
+  return(threads);
+}
+
+//--------------------------------------------------------
+// Procedure: runALogBatch()
+//      Note: Workers pull the next job from a shared counter, so a
+//            short file never waits behind a long one. With the
+//            largest files dispatched first, the total run time is
+//            close to that of the single slowest file.
+
+void runALogBatch(unsigned int jobs, unsigned int threads,
+		  const function<void(unsigned int)>& job,
+		  const vector<string>& files)
+{
+  if(jobs == 0)
+    return;
+
+  // Part 1: Order the jobs, largest file first
+  vector<pair<double, unsigned int> > order;
+  for(unsigned int i=0; i<jobs; i++) {
+    double size = 0;
+    if(i < files.size())
+      size = fileSize(files[i]);
+    order.push_back(make_pair(-size, i));
+  }
+  stable_sort(order.begin(), order.end());
+
+  // Part 2: Hand out jobs to the pool
+  atomic<unsigned int> next(0);
+  auto worker = [&]() {
+    unsigned int k;
+    while((k = next.fetch_add(1)) < jobs)
+      job(order[k].second);
+  };
+
+  threads = batchThreadCount(threads, jobs);
+  if(threads <= 1) {
+    worker();
+    return;
+  }
+
+  vector<thread> pool;
+  for(unsigned int i=0; i<threads; i++)
+    pool.push_back(thread(worker));
+  for(unsigned int i=0; i<pool.size(); i++)
+    pool[i].join();
+}
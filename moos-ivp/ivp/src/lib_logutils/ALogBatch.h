@@ -0,0 +1,49 @@
+/*****************************************************************/
+/*    NAME: agent                                                */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: ALogBatch.h                                          */
+/*    DATE: Oct 19th, 2026                                       */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#ifndef ALOG_BATCH_HEADER
+#define ALOG_BATCH_HEADER
+
+#include <vector>
+#include <string>
+#include <functional>
+
+// Expand a command line argument into a list of alog files. The
+// argument may be a single .alog file, a directory (searched
+// recursively for .alog files) or a quoted glob pattern such as
+// "logs/*/*.alog". Results are sorted by name for stable output.
+std::vector<std::string> expandALogFiles(const std::string& arg);
+
+// Number of worker threads to use for the given number of jobs. A
+// request of zero means one thread per hardware core.
+unsigned int batchThreadCount(unsigned int requested, unsigned int jobs);
+
+// Run job(ix) for every ix in [0, jobs) on a pool of worker threads.
+// Jobs are handed out largest file first (by the sizes given, if
+// any) so the batch finishes in about the time of the slowest file.
+// Returns when all jobs are complete.
+void runALogBatch(unsigned int jobs, unsigned int threads,
+		  const std::function<void(unsigned int)>& job,
+		  const std::vector<std::string>& files=std::vector<std::string>());
+
+#endif
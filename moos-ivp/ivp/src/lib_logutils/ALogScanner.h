@@ -24,6 +24,7 @@
 #ifndef ALOG_SCANNER_HEADER
 #define ALOG_SCANNER_HEADER
 
+#include <cstdio>
 #include <vector>
 #include <map>
 #include <string>
@@ -33,7 +34,7 @@ class ALogScanner
 {
  public:
   ALogScanner() {m_file=0; m_use_full_source=true; m_verbose=true;}
-  ~ALogScanner() {}
+  ~ALogScanner() {if(m_file) fclose(m_file);}
 
   bool       openALogFile(std::string);
   ScanReport scan();
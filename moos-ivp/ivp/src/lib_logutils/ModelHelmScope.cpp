@@ -28,6 +28,7 @@
 #include "MBUtils.h"
 #include "BuildUtils.h"
 #include "ACTable.h"
+#include "HelmProfileUtils.h"
 
 using namespace std;
 
@@ -62,6 +63,7 @@ void ModelHelmScope::setDataBroker(ALogDataBroker dbroker, string vname)
   unsigned int mix4 = m_dbroker.getMixFromVNameVarName(vname, "BHV_WARNING");
   unsigned int mix5 = m_dbroker.getMixFromVNameVarName(vname, "BHV_ERROR");
   unsigned int mix6 = m_dbroker.getMixFromVNameVarName(vname, "IVPHELM_LIFE_EVENT");
+  unsigned int mix7 = m_dbroker.getMixFromVNameVarName(vname, "IVPHELM_PROFILE");
 
   m_vplot_helm_state   = m_dbroker.getVarPlot(mix1);
   m_vplot_helm_modeset = m_dbroker.getVarPlot(mix2);
@@ -69,6 +71,7 @@ void ModelHelmScope::setDataBroker(ALogDataBroker dbroker, string vname)
   m_vplot_bhv_warning  = m_dbroker.getVarPlot(mix4, true); // true:incSourceInfo
   m_vplot_bhv_error    = m_dbroker.getVarPlot(mix5, true); // true:incSourceInfo
   m_vplot_life_event   = m_dbroker.getVarPlot(mix6);
+  m_vplot_helm_profile = m_dbroker.getVarPlot(mix7);
 }
 
 //-------------------------------------------------------------
@@ -120,6 +123,8 @@ unsigned int ModelHelmScope::getVPlotSize(string ptype) const
     return(m_vplot_helm_modeset.size());
   else if(ptype == "life_event")
     return(m_vplot_life_event.size());
+  else if(ptype == "helm_profile")
+    return(m_vplot_helm_profile.size());
   
   return(0);
 }
@@ -323,6 +328,25 @@ vector<string> ModelHelmScope::getModes() const
 }
 
 
+//-------------------------------------------------------------
+// Procedure: getProfile()
+//      Note: IVPHELM_PROFILE is only logged from a helm configured
+//            with profile=true.
+
+vector<string> ModelHelmScope::getProfile() const
+{
+  vector<string> rvector;
+  if(m_vplot_helm_profile.size() == 0) {
+    rvector.push_back("No IVPHELM_PROFILE logged. Was the helm profile=true?");
+    return(rvector);
+  }
+
+  string spec = m_vplot_helm_profile.getEntryByTime(m_curr_time);
+  HelmProfile profile = string2HelmProfile(spec);
+  return(helmProfileReport(profile, m_headers_bhv));
+}
+
+
 //-------------------------------------------------------------
 // Procedure: getLifeEveents
 //  Examples: iter=1, bname=loiter, btype=BHV_Loiter, event=spawn, seed=helm_startup 
@@ -59,6 +59,7 @@ class ModelHelmScope
   std::vector<std::string>  getErrors() const;
   std::vector<std::string>  getModes() const;
   std::vector<std::string>  getLifeEvents() const;
+  std::vector<std::string>  getProfile() const;
 
  protected:
   std::vector<std::string>  getErrWarnings(const VarPlot& vplot) const;
@@ -89,6 +90,7 @@ private:
   VarPlot      m_vplot_helm_mode;
   VarPlot      m_vplot_helm_modeset;
   VarPlot      m_vplot_life_event;
+  VarPlot      m_vplot_helm_profile;
 };
 
 #endif
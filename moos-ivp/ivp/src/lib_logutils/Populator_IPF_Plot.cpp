@@ -98,7 +98,13 @@ bool Populator_IPF_Plot::setIvPDomain(const string& domain_str)
 
 void Populator_IPF_Plot::handleEntry(double g_time, const string& g_ipf_str)
 {
-  IvPFunction *ipf = StringToIvPFunction(g_ipf_str);
+  // Delta coded functions are expanded here, in log order, so each
+  // plot entry may be decoded on its own later.
+  string ipf_str = m_ipf_coder.resolve(g_ipf_str);
+  if(ipf_str == "")
+    return;
+
+  IvPFunction *ipf = StringToIvPFunction(ipf_str);
   if(!ipf) {
     cout << "Unable to create IvPFunction from string" << endl;
     return;
@@ -139,7 +145,7 @@ void Populator_IPF_Plot::handleEntry(double g_time, const string& g_ipf_str)
     index = vsize;
   }
   
-  m_ipf_plots[index].addEntry(g_time, g_ipf_str, ipf_iteration, ipf_pieces,
+  m_ipf_plots[index].addEntry(g_time, ipf_str, ipf_iteration, ipf_pieces,
 			      ipf_pwt, ivp_domain);
 }
 
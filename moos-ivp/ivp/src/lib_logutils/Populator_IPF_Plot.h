@@ -28,6 +28,7 @@
 #include "IPF_Plot.h"
 #include "Demuxer.h"
 #include "ALogEntry.h"
+#include "FunctionEncoderBin.h"
 
 class Populator_IPF_Plot 
 {
@@ -54,6 +55,7 @@ protected:
   std::vector<std::string> m_ipf_tags;
   std::vector<IPF_Plot>    m_ipf_plots;
   Demuxer                  m_demuxer;
+  IPFBinCoder              m_ipf_coder;
 
   IvPDomain                m_ivp_domain;
 };
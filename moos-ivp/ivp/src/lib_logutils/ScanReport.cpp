@@ -79,6 +79,62 @@ void ScanReport::addLineRateOnly(const ALogEntry& entry)
   m_total_chars += entry.getVarName().length();
   m_total_chars += entry.getStringVal().length();
   m_total_chars += entry.getSource().length();
+  m_lines++;
+}
+
+//--------------------------------------------------------
+// Procedure: merge()
+//      Note: Var first/last times are the min/max over both reports.
+//            Sources are unioned. Lines and chars are summed. The
+//            result does not depend on the order reports are merged
+//            in, other than the order vars are first listed.
+
+void ScanReport::merge(const ScanReport& report)
+{
+  bool empty_self  = (m_lines == 0);
+  bool empty_other = (report.m_lines == 0);
+  if(empty_other)
+    return;
+
+  if(empty_self || (report.m_time_min < m_time_min))
+    m_time_min = report.m_time_min;
+  if(empty_self || (report.m_time_max > m_time_max))
+    m_time_max = report.m_time_max;
+
+  m_lines += report.m_lines;
+  m_total_chars += report.m_total_chars;
+
+  for(unsigned int i=0; i<report.m_var_names.size(); i++) {
+    string varname = report.m_var_names[i];
+    map<string,int>::iterator p = m_vmap.find(varname);
+    if(p == m_vmap.end()) {
+      m_var_names.push_back(varname);
+      m_var_sources.push_back(report.m_var_sources[i]);
+      m_var_first.push_back(report.m_var_first[i]);
+      m_var_last.push_back(report.m_var_last[i]);
+      m_var_lines.push_back(report.m_var_lines[i]);
+      m_var_chars.push_back(report.m_var_chars[i]);
+      m_vmap[varname] = m_var_names.size()-1;
+      continue;
+    }
+
+    int index = p->second;
+    if(report.m_var_first[i] < m_var_first[index])
+      m_var_first[index] = report.m_var_first[i];
+    if(report.m_var_last[i] > m_var_last[index])
+      m_var_last[index] = report.m_var_last[i];
+    m_var_lines[index] += report.m_var_lines[i];
+    m_var_chars[index] += report.m_var_chars[i];
+
+    vector<string> sources = parseString(m_var_sources[index], ',');
+    vector<string> others  = parseString(report.m_var_sources[i], ',');
+    for(unsigned int j=0; j<others.size(); j++) {
+      if(!vectorContains(sources, others[j])) {
+	sources.push_back(others[j]);
+	m_var_sources[index] += ("," + others[j]);
+      }
+    }
+  }
 }
 
 //--------------------------------------------------------
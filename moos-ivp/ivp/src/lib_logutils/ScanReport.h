@@ -41,6 +41,9 @@ class ScanReport
 
   void addLineRateOnly(const ALogEntry& entry);
 
+  // Fold another report (e.g. another vehicle's log) into this one
+  void merge(const ScanReport& report);
+
   bool         containsVar(const std::string& varname);
   int          getVarIndex(const std::string& varname);
   unsigned int size() {return(m_var_names.size());}
@@ -54,6 +57,11 @@ class ScanReport
   double getVarLastTime(unsigned int index);
 
   double getDataRate() const;
+
+  unsigned int getTotalLines() const {return(m_lines);}
+  double       getTotalChars() const {return(m_total_chars);}
+  double       getTimeMin() const    {return(m_time_min);}
+  double       getTimeMax() const    {return(m_time_max);}
   
   double getVarFirstTime(const std::string& varname)
     {return(getVarFirstTime(getVarIndex(varname)));}
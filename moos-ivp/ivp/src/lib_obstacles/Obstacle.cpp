@@ -38,6 +38,8 @@ Obstacle::Obstacle()
 
   m_pts_total  = 0;
   m_changed    = false;
+  m_hull_stale = false;
+  m_clustered  = false;
   m_updates_total = 0;
   m_min_range  = -1;
 }
@@ -58,9 +60,26 @@ bool Obstacle::addPoint(XYPoint point)
   m_duration = 0;
 
   m_changed = true;
+  m_hull_stale = true;
   m_pts_total++;
   return(true);
 }
+
+//---------------------------------------------------------
+// Procedure: setPoints()
+//      Note: Used when the points are managed externally, e.g.,
+//            by a clusterer. Replaces all points and ignores
+//            the max points limit.
+
+void Obstacle::setPoints(const vector<XYPoint>& points)
+{
+  m_points.assign(points.begin(), points.end());
+  if(m_points.size() > 0)
+    m_duration = 0;
+
+  m_changed = true;
+  m_hull_stale = true;
+}
   
 //---------------------------------------------------------
 // Procedure: setPoly
@@ -81,6 +100,7 @@ bool Obstacle::setPoly(XYPolygon new_poly)
   
   m_polygon   = new_poly;
   m_poly_spec = new_spec;
+  m_poly_index.setPoly(new_poly);
   
   m_changed = true;
   m_updates_total++;
@@ -98,6 +118,19 @@ void Obstacle::setRange(double dval)
 }
 
 
+//---------------------------------------------------------
+// Procedure: getPolyDist()
+//      Note: The index only pays off on polygons large enough for
+//            its edge bins (32 or more edges). Below that it walks
+//            every edge as XYPolygon does, and is no faster.
+
+double Obstacle::getPolyDist(double x, double y) const
+{
+  if(!m_poly_index.binned())
+    return(m_polygon.dist_to_poly(x,y));
+  return(m_poly_index.dist_to_poly(x,y));
+}
+
 //---------------------------------------------------------
 // Procedure: getTimeToLive()
 //      Note: -1 indicates this obstacle does not have a duration
@@ -194,6 +227,7 @@ bool Obstacle::pruneByAge(double max_age, double curr_time)
     double age = curr_time - pt.get_time();
     if(age > max_age) {
       m_changed = true;
+      m_hull_stale = true;
       p = m_points.erase(p);
     }
     else
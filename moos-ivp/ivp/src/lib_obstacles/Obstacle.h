@@ -25,6 +25,7 @@
 #define MANAGED_OBSTACLE_HEADER
 
 #include "XYPolygon.h"
+#include "XYPolyIndex.h"
 #include "XYPoint.h"
 #include <list>
 #include <vector>
@@ -37,6 +38,7 @@ public:
 
   bool addPoint(XYPoint);
   bool setPoly(XYPolygon);
+  void setPoints(const std::vector<XYPoint>&);
 
   bool pruneByAge(double max_time, double curr_time);
   
@@ -45,6 +47,8 @@ public:
   void setTStamp(double v)       {m_tstamp=v;}
   void setMaxPts(unsigned int v) {m_max_points=v;}
   void setChanged(bool v=true)   {m_changed=v;}
+  void setHullStale(bool v=true) {m_hull_stale=v;}
+  void setClustered(bool v=true) {m_clustered=v;}
   void incUpdatesTotal()         {m_updates_total++;}
   
   unsigned int size() const            {return(m_points.size());}
@@ -52,11 +56,16 @@ public:
   XYPolygon    getPoly() const         {return(m_polygon);}
   double       getRange() const        {return(m_range);}
   bool         hasChanged() const      {return(m_changed);}
+  bool         isHullStale() const     {return(m_hull_stale);}
+  bool         isClustered() const     {return(m_clustered);}
   double       getDuration() const     {return(m_duration);}
   double       getTStamp() const       {return(m_tstamp);}
   unsigned int getUpdatesTotal() const {return(m_updates_total);}
   unsigned int getMaxPoints() const    {return(m_max_points);}
   double       getMinRange() const     {return(m_min_range);}
+  bool         isPolyConvex() const    {return(m_poly_index.is_convex());}
+  
+  double       getPolyDist(double x, double y) const;
   
   double       getTimeToLive(double curr_time) const;
 
@@ -69,6 +78,7 @@ public:
 protected: // set externally
   std::list<XYPoint> m_points;
   XYPolygon          m_polygon;
+  XYPolyIndex        m_poly_index;
   double             m_range;
   double             m_duration;
   double             m_tstamp;
@@ -77,6 +87,8 @@ protected: // set externally
 private:  // set internally
   unsigned int   m_pts_total;
   bool           m_changed;  
+  bool           m_hull_stale;
+  bool           m_clustered;
   unsigned int   m_updates_total;
   double         m_min_range;
   std::string    m_poly_spec;
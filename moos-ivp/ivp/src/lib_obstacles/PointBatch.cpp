@@ -0,0 +1,273 @@
+/*****************************************************************/
+/*    NAME: agent                                                */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: PointBatch.cpp                                       */
+/*    DATE: Oct 19th, 2026                                       */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#include <cmath>
+#include <cstdlib>
+#include "MBUtils.h"
+#include "PointBatch.h"
+
+using namespace std;
+
+static const unsigned char pb_magic[3] = {'O', 'P', 'B'};
+static const unsigned char pb_version  = 1;
+
+//---------------------------------------------------------
+// Procedure: addPoint()
+
+void PointBatch::addPoint(double x, double y, const string& key)
+{
+  unsigned int ix = groupIndex(key);
+  m_xs[ix].push_back(x);
+  m_ys[ix].push_back(y);
+}
+
+//---------------------------------------------------------
+// Procedure: clear()
+
+void PointBatch::clear()
+{
+  m_keys.clear();
+  m_xs.clear();
+  m_ys.clear();
+  m_key_ix.clear();
+}
+
+//---------------------------------------------------------
+// Procedure: size()
+
+unsigned int PointBatch::size() const
+{
+  unsigned int total = 0;
+  for(unsigned int i=0; i<m_xs.size(); i++)
+    total += m_xs[i].size();
+  return(total);
+}
+
+//---------------------------------------------------------
+// Procedure: getSpec()
+
+string PointBatch::getSpec() const
+{
+  string spec;
+  for(unsigned int i=0; i<m_keys.size(); i++) {
+    if(m_xs[i].size() == 0)
+      continue;
+    if(spec != "")
+      spec += "#";
+    spec += "pts={";
+    for(unsigned int j=0; j<m_xs[i].size(); j++) {
+      if(j > 0)
+	spec += ":";
+      spec += doubleToStringX(m_xs[i][j],2) + ",";
+      spec += doubleToStringX(m_ys[i][j],2);
+    }
+    spec += "}";
+    if(m_keys[i] != "")
+      spec += ",label=" + m_keys[i];
+  }
+  return(spec);
+}
+
+//---------------------------------------------------------
+// Procedure: getBinary()
+
+vector<unsigned char> PointBatch::getBinary() const
+{
+  vector<unsigned char> buff;
+  buff.reserve(6 + (m_keys.size() * 16) + (size() * 8));
+
+  for(unsigned int i=0; i<3; i++)
+    buff.push_back(pb_magic[i]);
+  buff.push_back(pb_version);
+
+  unsigned int num_groups = m_keys.size();
+  if(num_groups > 0xFFFF)
+    num_groups = 0xFFFF;
+  buff.push_back(num_groups & 0xFF);
+  buff.push_back((num_groups >> 8) & 0xFF);
+
+  for(unsigned int i=0; i<num_groups; i++) {
+    string key = m_keys[i];
+    if(key.length() > 0xFF)
+      key = key.substr(0, 0xFF);
+    buff.push_back((unsigned char)(key.length()));
+    buff.insert(buff.end(), key.begin(), key.end());
+
+    unsigned int npts = m_xs[i].size();
+    for(unsigned int b=0; b<4; b++)
+      buff.push_back((npts >> (8*b)) & 0xFF);
+
+    for(unsigned int j=0; j<npts; j++) {
+      long vals[2];
+      vals[0] = lround(m_xs[i][j] * 100);
+      vals[1] = lround(m_ys[i][j] * 100);
+      for(unsigned int k=0; k<2; k++) {
+	unsigned int uval = (unsigned int)((int)(vals[k]));
+	for(unsigned int b=0; b<4; b++)
+	  buff.push_back((uval >> (8*b)) & 0xFF);
+      }
+    }
+  }
+  return(buff);
+}
+
+//---------------------------------------------------------
+// Procedure: setFromSpec()
+//   Returns: false if any group or point was malformed. Well
+//            formed points are kept regardless.
+
+bool PointBatch::setFromSpec(const string& spec)
+{
+  clear();
+
+  bool all_ok = true;
+  vector<string> gvector = parseString(spec, '#');
+  for(unsigned int i=0; i<gvector.size(); i++) {
+    string group = gvector[i];
+
+    // The pts={...} component contains commas, so pull it out first
+    size_t start = group.find("pts={");
+    size_t end   = group.find('}', start);
+    if((start == string::npos) || (end == string::npos)) {
+      all_ok = false;
+      continue;
+    }
+    string pts_str = group.substr(start+5, end-start-5);
+    string rest = group.substr(0, start) + group.substr(end+1);
+
+    string key;
+    vector<string> fields = parseString(rest, ',');
+    for(unsigned int j=0; j<fields.size(); j++) {
+      string param = biteStringX(fields[j], '=');
+      if((param == "key") || (param == "label"))
+	key = fields[j];
+    }
+
+    vector<string> svector = parseString(pts_str, ':');
+    for(unsigned int j=0; j<svector.size(); j++) {
+      string ystr = svector[j];
+      string xstr = biteStringX(ystr, ',');
+      ystr = stripBlankEnds(ystr);
+      if(!isNumber(xstr) || !isNumber(ystr)) {
+	all_ok = false;
+	continue;
+      }
+      addPoint(atof(xstr.c_str()), atof(ystr.c_str()), key);
+    }
+  }
+  return(all_ok);
+}
+
+//---------------------------------------------------------
+// Procedure: setFromBinary()
+
+bool PointBatch::setFromBinary(const unsigned char* data, unsigned int len)
+{
+  clear();
+  if(!isBinaryBatch(data, len) || (len < 6))
+    return(false);
+
+  unsigned int pos = 4;
+  unsigned int num_groups = data[pos] | (data[pos+1] << 8);
+  pos += 2;
+
+  for(unsigned int i=0; i<num_groups; i++) {
+    if(pos + 1 > len)
+      return(false);
+    unsigned int key_len = data[pos++];
+    if(pos + key_len + 4 > len)
+      return(false);
+    string key((const char*)(data + pos), key_len);
+    pos += key_len;
+
+    unsigned int npts = 0;
+    for(unsigned int b=0; b<4; b++)
+      npts |= ((unsigned int)(data[pos++])) << (8*b);
+    if((len - pos) / 8 < npts)
+      return(false);
+
+    unsigned int ix = groupIndex(key);
+    m_xs[ix].reserve(m_xs[ix].size() + npts);
+    m_ys[ix].reserve(m_ys[ix].size() + npts);
+    for(unsigned int j=0; j<npts; j++) {
+      int vals[2];
+      for(unsigned int k=0; k<2; k++) {
+	unsigned int uval = 0;
+	for(unsigned int b=0; b<4; b++)
+	  uval |= ((unsigned int)(data[pos++])) << (8*b);
+	vals[k] = (int)(uval);
+      }
+      m_xs[ix].push_back(vals[0] / 100.0);
+      m_ys[ix].push_back(vals[1] / 100.0);
+    }
+  }
+  return(true);
+}
+
+//---------------------------------------------------------
+// Procedure: getPoints()
+
+vector<XYPoint> PointBatch::getPoints() const
+{
+  vector<XYPoint> points;
+  points.reserve(size());
+  for(unsigned int i=0; i<m_keys.size(); i++) {
+    for(unsigned int j=0; j<m_xs[i].size(); j++) {
+      XYPoint point(m_xs[i][j], m_ys[i][j]);
+      if(m_keys[i] != "")
+	point.set_msg(m_keys[i]);
+      points.push_back(point);
+    }
+  }
+  return(points);
+}
+
+//---------------------------------------------------------
+// Procedure: isBinaryBatch()
+
+bool PointBatch::isBinaryBatch(const unsigned char* data, unsigned int len)
+{
+  if(!data || (len < 4))
+    return(false);
+  if((data[0] != pb_magic[0]) || (data[1] != pb_magic[1]) ||
+     (data[2] != pb_magic[2]))
+    return(false);
+  return(data[3] == pb_version);
+}
+
+//---------------------------------------------------------
+// Procedure: groupIndex()
+
+unsigned int PointBatch::groupIndex(const string& key)
+{
+  map<string, unsigned int>::iterator p = m_key_ix.find(key);
+  if(p != m_key_ix.end())
+    return(p->second);
+
+  unsigned int ix = m_keys.size();
+  m_key_ix[key] = ix;
+  m_keys.push_back(key);
+  m_xs.push_back(vector<double>());
+  m_ys.push_back(vector<double>());
+  return(ix);
+}
@@ -0,0 +1,79 @@
+/*****************************************************************/
+/*    NAME: agent                                                */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: PointBatch.h                                         */
+/*    DATE: Oct 19th, 2026                                       */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#ifndef POINT_BATCH_HEADER
+#define POINT_BATCH_HEADER
+
+#include <string>
+#include <vector>
+#include <map>
+#include "XYPoint.h"
+
+//---------------------------------------------------------------
+// PointBatch holds many sensor points, grouped by obstacle key,
+// for posting in a single message rather than one per point.
+// Points without a key form their own (unlabeled) group.
+//
+// Text form, groups separated by '#', label optional:
+//   pts={23,99:24.5,98},label=ob_a#pts={3,4:5,6.2}
+//
+// Binary form (all integers little endian):
+//   "OPB" version(1)  num_groups(u16)
+//   per group: key_len(u8) key  num_pts(u32)  num_pts*(x,y)
+//   with x,y as i32 centimeters, the same precision as the text.
+
+class PointBatch
+{
+public:
+  PointBatch() {};
+  ~PointBatch() {};
+
+  void addPoint(double x, double y, const std::string& key="");
+  void clear();
+
+  unsigned int size() const;
+  unsigned int groups() const {return(m_keys.size());}
+
+  std::string               getSpec() const;
+  std::vector<unsigned char> getBinary() const;
+
+  bool setFromSpec(const std::string&);
+  bool setFromBinary(const unsigned char*, unsigned int);
+
+  // Points returned with the obstacle key (if any) set as msg
+  std::vector<XYPoint> getPoints() const;
+
+  static bool isBinaryBatch(const unsigned char*, unsigned int);
+
+protected:
+  unsigned int groupIndex(const std::string& key);
+
+protected:
+  std::vector<std::string> m_keys;
+  std::vector<std::vector<double> > m_xs;
+  std::vector<std::vector<double> > m_ys;
+
+  std::map<std::string, unsigned int> m_key_ix;
+};
+
+#endif
@@ -0,0 +1,580 @@
+/*****************************************************************/
+/*    NAME: agent                                                */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: PointClusterer.cpp                                   */
+/*    DATE: Oct 19th, 2026                                       */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#include <cmath>
+#include <algorithm>
+#include <iterator>
+#include "PointClusterer.h"
+
+using namespace std;
+
+// Scratch labels used while re-clustering a region
+#define PC_OUTSIDE   -1
+#define PC_UNVISITED -2
+#define PC_NOISE     -3
+
+//---------------------------------------------------------
+// Constructor
+
+PointClusterer::PointClusterer()
+{
+  m_eps     = 5;
+  m_min_pts = 3;
+
+  m_point_count = 0;
+  m_next_id     = 0;
+  m_region_size = 0;
+}
+
+//---------------------------------------------------------
+// Procedure: setClusterDist()
+//      Note: The grid cell size is tied to the cluster distance
+//            so any points held so far are dropped.
+
+bool PointClusterer::setClusterDist(double dval)
+{
+  if(dval <= 0)
+    return(false);
+
+  if(dval != m_eps)
+    clear();
+  m_eps = dval;
+  return(true);
+}
+
+//---------------------------------------------------------
+// Procedure: setMinPoints()
+
+bool PointClusterer::setMinPoints(unsigned int ival)
+{
+  if(ival == 0)
+    return(false);
+
+  m_min_pts = ival;
+  return(true);
+}
+
+//---------------------------------------------------------
+// Procedure: clear()
+
+void PointClusterer::clear()
+{
+  m_px.clear();
+  m_py.clear();
+  m_pt.clear();
+  m_plabel.clear();
+  m_palive.clear();
+  m_ptmp.clear();
+  m_free.clear();
+  m_arrivals.clear();
+  m_grid.clear();
+  m_dirty.clear();
+  m_touched.clear();
+  m_clusters.clear();
+  m_changed.clear();
+  m_removed.clear();
+
+  m_point_count = 0;
+  m_region_size = 0;
+}
+
+//---------------------------------------------------------
+// Procedure: addPoint()
+//      Note: The point is unclassified (noise) until the next
+//            call to update().
+//      Note: Arrivals are kept in time order. A point older than
+//            the newest one held is placed by scanning back from
+//            the end, so in-order points cost O(1).
+
+void PointClusterer::addPoint(double x, double y, double utc)
+{
+  unsigned int pid = m_px.size();
+  if(m_free.size() > 0) {
+    pid = m_free.back();
+    m_free.pop_back();
+  }
+  else {
+    m_px.push_back(0);
+    m_py.push_back(0);
+    m_pt.push_back(0);
+    m_plabel.push_back(-1);
+    m_palive.push_back(false);
+    m_ptmp.push_back(PC_OUTSIDE);
+  }
+
+  m_px[pid] = x;
+  m_py[pid] = y;
+  m_pt[pid] = utc;
+  m_plabel[pid] = -1;
+  m_palive[pid] = true;
+  m_point_count++;
+
+  CellKey key = cellKey(x, y);
+  m_grid[key].push_back(pid);
+  list<unsigned int>::reverse_iterator p = m_arrivals.rbegin();
+  while((p != m_arrivals.rend()) && (m_pt[*p] > utc))
+    p++;
+  m_arrivals.insert(p.base(), pid);
+  markDirty(key);
+}
+
+//---------------------------------------------------------
+// Procedure: update()
+//   Purpose: Expire points older than max_age (a negative age
+//            means points never expire) and re-cluster the
+//            neighborhood of any added or expired points.
+
+void PointClusterer::update(double curr_time, double max_age)
+{
+  m_changed.clear();
+  m_removed.clear();
+  m_region_size = 0;
+
+  // Part 1: Arrivals are held in time order, oldest in front
+  if(max_age >= 0) {
+    while(m_arrivals.size() > 0) {
+      unsigned int pid = m_arrivals.front();
+      if((curr_time - m_pt[pid]) <= max_age)
+	break;
+      m_arrivals.pop_front();
+      removePoint(pid);
+    }
+  }
+
+  // Part 2: Nothing added or expired, nothing can have changed
+  if(m_dirty.empty() && m_touched.empty())
+    return;
+
+  recluster();
+
+  m_dirty.clear();
+  m_touched.clear();
+}
+
+//---------------------------------------------------------
+// Procedure: getNoiseCount()
+
+unsigned int PointClusterer::getNoiseCount() const
+{
+  unsigned int clustered = 0;
+  map<unsigned int, Cluster>::const_iterator p;
+  for(p=m_clusters.begin(); p!=m_clusters.end(); p++)
+    clustered += p->second.members.size();
+
+  if(clustered > m_point_count)
+    return(0);
+  return(m_point_count - clustered);
+}
+
+//---------------------------------------------------------
+// Procedure: getClusterIDs()
+
+vector<unsigned int> PointClusterer::getClusterIDs() const
+{
+  vector<unsigned int> ids;
+  map<unsigned int, Cluster>::const_iterator p;
+  for(p=m_clusters.begin(); p!=m_clusters.end(); p++)
+    ids.push_back(p->first);
+  return(ids);
+}
+
+//---------------------------------------------------------
+// Procedure: getClusterPoints()
+
+vector<XYPoint> PointClusterer::getClusterPoints(unsigned int id) const
+{
+  vector<XYPoint> points;
+  map<unsigned int, Cluster>::const_iterator p = m_clusters.find(id);
+  if(p == m_clusters.end())
+    return(points);
+
+  const vector<unsigned int>& members = p->second.members;
+  for(unsigned int i=0; i<members.size(); i++) {
+    unsigned int pid = members[i];
+    XYPoint point(m_px[pid], m_py[pid]);
+    point.set_time(m_pt[pid]);
+    points.push_back(point);
+  }
+  return(points);
+}
+
+//---------------------------------------------------------
+// Procedure: getClusterHull()
+//   Returns: The cluster points on its convex hull, in counter-
+//            clockwise order. Collinear clusters return just the
+//            two end points.
+
+vector<XYPoint> PointClusterer::getClusterHull(unsigned int id) const
+{
+  vector<XYPoint> points;
+  map<unsigned int, Cluster>::const_iterator p = m_clusters.find(id);
+  if(p == m_clusters.end())
+    return(points);
+
+  const vector<unsigned int>& hull = p->second.hull;
+  for(unsigned int i=0; i<hull.size(); i++) {
+    unsigned int pid = hull[i];
+    XYPoint point(m_px[pid], m_py[pid]);
+    point.set_time(m_pt[pid]);
+    points.push_back(point);
+  }
+  return(points);
+}
+
+//---------------------------------------------------------
+// Procedure: cellKey()
+
+PointClusterer::CellKey PointClusterer::cellKey(double x, double y) const
+{
+  long cx = (long)(floor(x / m_eps));
+  long cy = (long)(floor(y / m_eps));
+  return(CellKey(cx, cy));
+}
+
+//---------------------------------------------------------
+// Procedure: markDirty()
+
+void PointClusterer::markDirty(const CellKey& key)
+{
+  m_dirty.insert(key);
+}
+
+//---------------------------------------------------------
+// Procedure: removePoint()
+//      Note: The point id is not reused until the next call to
+//            addPoint(), so stale ids held in cluster member and
+//            hull lists are safe to compare against until the
+//            re-clustering in update() is done.
+
+void PointClusterer::removePoint(unsigned int pid)
+{
+  if((pid >= m_palive.size()) || !m_palive[pid])
+    return;
+
+  CellKey key = cellKey(m_px[pid], m_py[pid]);
+  map<CellKey, vector<unsigned int> >::iterator p = m_grid.find(key);
+  if(p != m_grid.end()) {
+    vector<unsigned int>& cell = p->second;
+    for(unsigned int i=0; i<cell.size(); i++) {
+      if(cell[i] == pid) {
+	cell[i] = cell.back();
+	cell.pop_back();
+	break;
+      }
+    }
+    if(cell.size() == 0)
+      m_grid.erase(p);
+  }
+
+  if(m_plabel[pid] >= 0)
+    m_touched.insert((unsigned int)(m_plabel[pid]));
+
+  m_palive[pid] = false;
+  m_plabel[pid] = -1;
+  m_free.push_back(pid);
+  m_point_count--;
+  markDirty(key);
+}
+
+//---------------------------------------------------------
+// Procedure: neighbors()
+//   Purpose: All points (including pid itself) within the
+//            cluster distance of point pid.
+
+void PointClusterer::neighbors(unsigned int pid,
+			       vector<unsigned int>& result) const
+{
+  result.clear();
+
+  double x = m_px[pid];
+  double y = m_py[pid];
+  double eps_sq = m_eps * m_eps;
+  CellKey key = cellKey(x, y);
+
+  for(long dx=-1; dx<=1; dx++) {
+    for(long dy=-1; dy<=1; dy++) {
+      CellKey nkey(key.first + dx, key.second + dy);
+      map<CellKey, vector<unsigned int> >::const_iterator p;
+      p = m_grid.find(nkey);
+      if(p == m_grid.end())
+	continue;
+      const vector<unsigned int>& cell = p->second;
+      for(unsigned int i=0; i<cell.size(); i++) {
+	double ddx = m_px[cell[i]] - x;
+	double ddy = m_py[cell[i]] - y;
+	if(((ddx*ddx) + (ddy*ddy)) <= eps_sq)
+	  result.push_back(cell[i]);
+      }
+    }
+  }
+}
+
+//---------------------------------------------------------
+// Procedure: recluster()
+//   Purpose: Re-run DBSCAN over the region affected by the
+//            points added or expired since the last update.
+//      Note: A point can only change core status if a point
+//            within eps of it was added or removed, so it lies
+//            within one cell of a dirty cell. Its cluster (or
+//            border points) can be reached within one more cell.
+//            So the region is every point within two cells of a
+//            dirty cell, plus all members of any cluster seen
+//            there. All other clusters are unaffected.
+
+void PointClusterer::recluster()
+{
+  // Part 1: Gather the affected clusters and the region
+  set<unsigned int> affected = m_touched;
+  vector<unsigned int> region;
+
+  set<CellKey>::iterator d;
+  for(d=m_dirty.begin(); d!=m_dirty.end(); d++) {
+    for(long dx=-2; dx<=2; dx++) {
+      for(long dy=-2; dy<=2; dy++) {
+	CellKey nkey(d->first + dx, d->second + dy);
+	map<CellKey, vector<unsigned int> >::iterator p = m_grid.find(nkey);
+	if(p == m_grid.end())
+	  continue;
+	const vector<unsigned int>& cell = p->second;
+	for(unsigned int i=0; i<cell.size(); i++) {
+	  unsigned int pid = cell[i];
+	  if(m_ptmp[pid] != PC_OUTSIDE)
+	    continue;
+	  if(m_plabel[pid] >= 0)
+	    affected.insert((unsigned int)(m_plabel[pid]));
+	  else {
+	    m_ptmp[pid] = PC_UNVISITED;
+	    region.push_back(pid);
+	  }
+	}
+      }
+    }
+  }
+
+  set<unsigned int>::iterator a;
+  for(a=affected.begin(); a!=affected.end(); a++) {
+    map<unsigned int, Cluster>::iterator c = m_clusters.find(*a);
+    if(c == m_clusters.end())
+      continue;
+    const vector<unsigned int>& members = c->second.members;
+    for(unsigned int i=0; i<members.size(); i++) {
+      unsigned int pid = members[i];
+      if(m_palive[pid] && (m_ptmp[pid] == PC_OUTSIDE)) {
+	m_ptmp[pid] = PC_UNVISITED;
+	region.push_back(pid);
+      }
+    }
+  }
+
+  // Visit in id order so results do not depend on set ordering
+  sort(region.begin(), region.end());
+
+  // Part 2: DBSCAN over the region. Points outside the region
+  // that belong to an unaffected cluster are left alone.
+  vector<vector<unsigned int> > comps;
+  vector<unsigned int> extras;
+  vector<unsigned int> nbrs, queue;
+  for(unsigned int i=0; i<region.size(); i++) {
+    unsigned int pid = region[i];
+    if(m_ptmp[pid] != PC_UNVISITED)
+      continue;
+
+    neighbors(pid, nbrs);
+    if(nbrs.size() < m_min_pts) {
+      m_ptmp[pid] = PC_NOISE;
+      continue;
+    }
+
+    int cix = (int)(comps.size());
+    comps.push_back(vector<unsigned int>(1, pid));
+    m_ptmp[pid] = cix;
+
+    queue = nbrs;
+    for(unsigned int k=0; k<queue.size(); k++) {
+      unsigned int qid = queue[k];
+      int tmp = m_ptmp[qid];
+      if(tmp == PC_OUTSIDE) {
+	// Outside noise can only ever be a border point here
+	if(m_plabel[qid] >= 0)
+	  continue;
+	extras.push_back(qid);
+	m_ptmp[qid] = cix;
+	comps[cix].push_back(qid);
+      }
+      else if(tmp == PC_NOISE) {
+	m_ptmp[qid] = cix;
+	comps[cix].push_back(qid);
+      }
+      else if(tmp == PC_UNVISITED) {
+	m_ptmp[qid] = cix;
+	comps[cix].push_back(qid);
+	neighbors(qid, nbrs);
+	if(nbrs.size() >= m_min_pts)
+	  queue.insert(queue.end(), nbrs.begin(), nbrs.end());
+      }
+    }
+  }
+
+  // Part 3: Assign stable ids. Largest components choose first,
+  // each taking the previous id held by most of its members.
+  vector<pair<unsigned int, unsigned int> > order;
+  for(unsigned int i=0; i<comps.size(); i++)
+    order.push_back(make_pair(comps[i].size(), i));
+  sort(order.begin(), order.end(), 
+       [](const pair<unsigned int, unsigned int>& a,
+	  const pair<unsigned int, unsigned int>& b) {
+	 if(a.first != b.first)
+	   return(a.first > b.first);
+	 return(a.second < b.second);
+       });
+
+  set<unsigned int> claimed;
+  vector<unsigned int> comp_ids(comps.size(), 0);
+  for(unsigned int i=0; i<order.size(); i++) {
+    const vector<unsigned int>& comp = comps[order[i].second];
+    map<unsigned int, unsigned int> votes;
+    for(unsigned int j=0; j<comp.size(); j++) {
+      int prev = m_plabel[comp[j]];
+      if((prev >= 0) && affected.count((unsigned int)(prev)))
+	votes[(unsigned int)(prev)]++;
+    }
+    bool found = false;
+    unsigned int best_id = 0;
+    unsigned int best_votes = 0;
+    map<unsigned int, unsigned int>::iterator v;
+    for(v=votes.begin(); v!=votes.end(); v++) {
+      if(claimed.count(v->first) || (v->second <= best_votes))
+	continue;
+      best_id = v->first;
+      best_votes = v->second;
+      found = true;
+    }
+    if(!found)
+      best_id = m_next_id++;
+    claimed.insert(best_id);
+    comp_ids[order[i].second] = best_id;
+  }
+
+  // Part 4: Affected clusters that were not claimed are gone
+  for(a=affected.begin(); a!=affected.end(); a++) {
+    if(claimed.count(*a))
+      continue;
+    if(m_clusters.erase(*a))
+      m_removed.push_back(*a);
+  }
+
+  // Part 5: Update labels, membership and hulls
+  for(unsigned int i=0; i<region.size(); i++)
+    m_plabel[region[i]] = -1;
+  for(unsigned int i=0; i<comps.size(); i++) {
+    unsigned int id = comp_ids[i];
+    vector<unsigned int>& comp = comps[i];
+    sort(comp.begin(), comp.end());
+    for(unsigned int j=0; j<comp.size(); j++)
+      m_plabel[comp[j]] = (int)(id);
+
+    bool existed = (m_clusters.count(id) > 0);
+    Cluster& cluster = m_clusters[id];
+    if(existed && (cluster.members == comp))
+      continue;
+
+    // If every old hull vertex survived, the new hull is the hull
+    // of the old hull vertices plus the added points. Otherwise
+    // rebuild from all the members.
+    bool hull_kept = existed;
+    for(unsigned int j=0; hull_kept && (j<cluster.hull.size()); j++)
+      hull_kept = binary_search(comp.begin(), comp.end(), cluster.hull[j]);
+
+    if(hull_kept) {
+      vector<unsigned int> candidates = cluster.hull;
+      set_difference(comp.begin(), comp.end(),
+		     cluster.members.begin(), cluster.members.end(),
+		     back_inserter(candidates));
+      cluster.hull = buildHull(candidates);
+    }
+    else
+      cluster.hull = buildHull(comp);
+
+    cluster.members = comp;
+    m_changed.push_back(id);
+  }
+  sort(m_changed.begin(), m_changed.end());
+
+  // Part 6: Reset the scratch labels
+  for(unsigned int i=0; i<region.size(); i++)
+    m_ptmp[region[i]] = PC_OUTSIDE;
+  for(unsigned int i=0; i<extras.size(); i++)
+    m_ptmp[extras[i]] = PC_OUTSIDE;
+
+  m_region_size = region.size() + extras.size();
+}
+
+//---------------------------------------------------------
+// Procedure: buildHull()
+//   Purpose: Convex hull (monotone chain) of the given points,
+//            returned counter-clockwise without collinear points.
+
+vector<unsigned int> PointClusterer::buildHull(const vector<unsigned int>& ids) const
+{
+  vector<unsigned int> pts = ids;
+  sort(pts.begin(), pts.end(), [this](unsigned int a, unsigned int b) {
+      if(m_px[a] != m_px[b])
+	return(m_px[a] < m_px[b]);
+      return(m_py[a] < m_py[b]);
+    });
+
+  if(pts.size() < 3)
+    return(pts);
+
+  vector<unsigned int> hull(2 * pts.size());
+  unsigned int k = 0;
+
+  // Lower chain, then upper chain
+  for(unsigned int i=0; i<pts.size(); i++) {
+    while((k >= 2) && (cross(hull[k-2], hull[k-1], pts[i]) <= 0))
+      k--;
+    hull[k++] = pts[i];
+  }
+  for(unsigned int i=pts.size()-1, t=k+1; i>0; i--) {
+    while((k >= t) && (cross(hull[k-2], hull[k-1], pts[i-1]) <= 0))
+      k--;
+    hull[k++] = pts[i-1];
+  }
+
+  hull.resize(k-1);
+  return(hull);
+}
+
+//---------------------------------------------------------
+// Procedure: cross()
+//   Returns: Positive if a->b->c turns counter-clockwise
+
+double PointClusterer::cross(unsigned int a, unsigned int b,
+			     unsigned int c) const
+{
+  double abx = m_px[b] - m_px[a];
+  double aby = m_py[b] - m_py[a];
+  double acx = m_px[c] - m_px[a];
+  double acy = m_py[c] - m_py[a];
+  return((abx * acy) - (aby * acx));
+}
@@ -0,0 +1,119 @@
+/*****************************************************************/
+/*    NAME: agent                                                */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: PointClusterer.h                                     */
+/*    DATE: Oct 19th, 2026                                       */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#ifndef POINT_CLUSTERER_HEADER
+#define POINT_CLUSTERER_HEADER
+
+#include <string>
+#include <vector>
+#include <list>
+#include <map>
+#include <set>
+#include "XYPoint.h"
+
+//---------------------------------------------------------------
+// PointClusterer groups a stream of unlabeled points into
+// clusters with DBSCAN (eps = cluster distance, min_pts). Points
+// are kept in a uniform grid of eps-sized cells so that neighbor
+// queries only visit the 3x3 surrounding cells. On each update
+// only the region near new or expired points is re-clustered,
+// and clusters keep their id across updates by majority vote of
+// their members' previous ids. The convex hull vertices of each
+// cluster are maintained incrementally.
+
+class PointClusterer
+{
+public:
+  PointClusterer();
+  ~PointClusterer() {};
+
+  bool setClusterDist(double);
+  bool setMinPoints(unsigned int);
+
+  void addPoint(double x, double y, double utc);
+  void update(double curr_time, double max_age);
+  void clear();
+
+  double       getClusterDist() const {return(m_eps);}
+  unsigned int getMinPoints() const   {return(m_min_pts);}
+  unsigned int size() const           {return(m_clusters.size());}
+  unsigned int getPointCount() const  {return(m_point_count);}
+  unsigned int getNoiseCount() const;
+
+  // Results of the most recent update()
+  std::vector<unsigned int> getChangedClusters() const {return(m_changed);}
+  std::vector<unsigned int> getRemovedClusters() const {return(m_removed);}
+  unsigned int getRegionSize() const {return(m_region_size);}
+
+  std::vector<unsigned int> getClusterIDs() const;
+  std::vector<XYPoint> getClusterPoints(unsigned int id) const;
+  std::vector<XYPoint> getClusterHull(unsigned int id) const;
+
+protected:
+  typedef std::pair<long,long> CellKey;
+
+  struct Cluster {
+    std::vector<unsigned int> members;   // sorted point ids
+    std::vector<unsigned int> hull;      // hull vertex point ids
+    bool hull_lost;                      // a hull vertex expired
+    Cluster() : hull_lost(false) {};
+  };
+
+  CellKey cellKey(double x, double y) const;
+  void    markDirty(const CellKey&);
+  void    removePoint(unsigned int pid);
+  void    neighbors(unsigned int pid, std::vector<unsigned int>&) const;
+  void    recluster();
+
+  std::vector<unsigned int> buildHull(const std::vector<unsigned int>&) const;
+  double cross(unsigned int, unsigned int, unsigned int) const;
+
+protected: // Configuration
+  double       m_eps;
+  unsigned int m_min_pts;
+
+protected: // Point storage, indexed by point id. Freed ids reused.
+  std::vector<double>       m_px;
+  std::vector<double>       m_py;
+  std::vector<double>       m_pt;
+  std::vector<int>          m_plabel;
+  std::vector<bool>         m_palive;
+  std::vector<int>          m_ptmp;    // scratch label in recluster
+  std::vector<unsigned int> m_free;
+  unsigned int              m_point_count;
+
+  std::list<unsigned int>   m_arrivals;  // alive ids, by time stamp
+
+  std::map<CellKey, std::vector<unsigned int> > m_grid;
+  std::set<CellKey>      m_dirty;    // cells with added/expired pts
+  std::set<unsigned int> m_touched;  // clusters that lost a point
+
+  std::map<unsigned int, Cluster> m_clusters;
+  unsigned int m_next_id;
+
+  std::vector<unsigned int> m_changed;
+  std::vector<unsigned int> m_removed;
+  unsigned int              m_region_size;
+};
+
+#endif
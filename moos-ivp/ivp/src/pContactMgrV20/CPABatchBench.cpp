@@ -0,0 +1,197 @@
+/*****************************************************************/
+/*    NAME: agent                                                */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: CPABatchBench.cpp                                    */
+/*    DATE: Oct 19th, 2026                                       */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+// Benchmark of CPAEngineBatch against one CPAEngine per contact, as
+// the number of contacts grows. Two workloads are timed:
+//
+//   tick:    CPA and rate of closure of every contact for ownship's
+//            present heading and speed, as pContactMgrV20 does on
+//            each iteration.
+//   lattice: CPA of every contact over a heading/speed lattice, as
+//            a collision avoidance objective function would need,
+//            reduced to the closest CPA at each lattice point.
+//
+// Every batch answer is checked against its CPAEngine.
+//
+//   cpabatch_bench
+//   cpabatch_bench --reps=10 --speeds=21
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include "MBUtils.h"
+#include "MBTimer.h"
+#include "ACTable.h"
+#include "CPAEngine.h"
+#include "CPAEngineBatch.h"
+
+using namespace std;
+
+//--------------------------------------------------------
+// Procedure: main
+
+int main(int argc, char *argv[])
+{
+  unsigned int reps   = 5;
+  unsigned int speeds = 21;
+
+  for(int i=1; i<argc; i++) {
+    string argi = argv[i];
+    if(strBegins(argi, "--reps="))
+      reps = atoi(argi.substr(7).c_str());
+    else if(strBegins(argi, "--speeds="))
+      speeds = atoi(argi.substr(9).c_str());
+    else {
+      cout << "Usage: cpabatch_bench [--reps=N] [--speeds=N]" << endl;
+      return(1);
+    }
+  }
+  if(reps == 0)
+    reps = 1;
+
+  vector<double> hdgs, spds;
+  for(unsigned int h=0; h<360; h++)
+    hdgs.push_back(h);
+  for(unsigned int s=0; s<speeds; s++)
+    spds.push_back(s * 0.25);
+
+  double ostol = 60;
+  double osx = 0;
+  double osy = 0;
+  double osh = 45;
+  double osv = 2;
+
+  unsigned int contact_amts[] = {1, 5, 20, 50, 100, 200};
+  unsigned int cases = 6;
+
+  srand(1);
+  bool all_match = true;
+
+  ACTable actab(7,2);
+  actab << "Contacts | Tick (us) | Batch | Speedup | Lattice (ms) | Batch | Speedup";
+  actab.addHeaderLines();
+
+  for(unsigned int k=0; k<cases; k++) {
+    unsigned int amt = contact_amts[k];
+    vector<double> cnx, cny, cnh, cnv;
+    for(unsigned int c=0; c<amt; c++) {
+      cnx.push_back((rand() % 2001) - 1000);
+      cny.push_back((rand() % 2001) - 1000);
+      cnh.push_back((rand() % 3600) / 10.0);
+      cnv.push_back((rand() % 60) / 10.0);
+    }
+
+    // Part 1: Per-tick contact manager work. MBTimer has millisecond
+    // resolution so repeat enough ticks to measure, many more of them
+    // for the batch.
+    unsigned int eng_ticks = reps * (200 / amt + 1);
+    unsigned int bat_ticks = eng_ticks * 100;
+    vector<double> eng_cpas(amt), eng_rocs(amt);
+    MBTimer eng_tick;
+    eng_tick.start();
+    for(unsigned int t=0; t<eng_ticks; t++) {
+      for(unsigned int c=0; c<amt; c++) {
+	CPAEngine engine(cny[c], cnx[c], cnh[c], cnv[c], osy, osx);
+	eng_cpas[c] = engine.evalCPA(osh, osv, 36000);
+	eng_rocs[c] = engine.evalROC(osh, osv);
+      }
+    }
+    eng_tick.stop();
+
+    vector<double> bat_cpas, bat_rocs;
+    MBTimer bat_tick;
+    bat_tick.start();
+    for(unsigned int t=0; t<bat_ticks; t++) {
+      CPAEngineBatch batch(osy, osx);
+      for(unsigned int c=0; c<amt; c++)
+	batch.addContact(cny[c], cnx[c], cnh[c], cnv[c]);
+      batch.evalCPA(osh, osv, 36000, bat_cpas);
+      batch.evalROC(osh, osv, bat_rocs);
+    }
+    bat_tick.stop();
+
+    if((eng_cpas != bat_cpas) || (eng_rocs != bat_rocs))
+      all_match = false;
+
+    // Part 2: Closest CPA over the heading/speed lattice
+    unsigned int eng_reps = reps * (50 / amt + 1);
+    unsigned int bat_reps = eng_reps * 4;
+    vector<double> eng_min(hdgs.size() * spds.size());
+    MBTimer eng_lat;
+    eng_lat.start();
+    for(unsigned int r=0; r<eng_reps; r++) {
+      vector<CPAEngine> engines;
+      for(unsigned int c=0; c<amt; c++)
+	engines.push_back(CPAEngine(cny[c], cnx[c], cnh[c], cnv[c], osy, osx));
+      for(unsigned int h=0; h<hdgs.size(); h++) {
+	for(unsigned int s=0; s<spds.size(); s++) {
+	  double min_cpa = engines[0].evalCPA(hdgs[h], spds[s], ostol);
+	  for(unsigned int c=1; c<amt; c++) {
+	    double cpa = engines[c].evalCPA(hdgs[h], spds[s], ostol);
+	    if(cpa < min_cpa)
+	      min_cpa = cpa;
+	  }
+	  eng_min[(h * spds.size()) + s] = min_cpa;
+	}
+      }
+    }
+    eng_lat.stop();
+
+    vector<double> bat_min;
+    MBTimer bat_lat;
+    bat_lat.start();
+    for(unsigned int r=0; r<bat_reps; r++) {
+      CPAEngineBatch batch(osy, osx);
+      for(unsigned int c=0; c<amt; c++)
+	batch.addContact(cny[c], cnx[c], cnh[c], cnv[c]);
+      batch.evalMinCPALattice(hdgs, spds, ostol, bat_min);
+    }
+    bat_lat.stop();
+
+    if(eng_min != bat_min)
+      all_match = false;
+
+    double eng_tick_us = 1e6 * eng_tick.get_float_wall_time() / eng_ticks;
+    double bat_tick_us = 1e6 * bat_tick.get_float_wall_time() / bat_ticks;
+    double eng_lat_ms  = 1e3 * eng_lat.get_float_wall_time() / eng_reps;
+    double bat_lat_ms  = 1e3 * bat_lat.get_float_wall_time() / bat_reps;
+
+    actab << amt;
+    actab << doubleToString(eng_tick_us, 1) << doubleToString(bat_tick_us, 1);
+    actab << doubleToString(eng_tick_us / (bat_tick_us + 1e-3), 1);
+    actab << doubleToString(eng_lat_ms, 2) << doubleToString(bat_lat_ms, 2);
+    actab << doubleToString(eng_lat_ms / (bat_lat_ms + 1e-3), 1);
+  }
+
+  cout << "Lattice: 360 headings x " << speeds << " speeds, ";
+  cout << "Reps: " << reps << endl << endl;
+  cout << actab.getFormattedString() << endl << endl;
+
+  if(!all_match) {
+    cout << "MISMATCH: batch answers differ from CPAEngine" << endl;
+    return(1);
+  }
+  cout << "Batch answers match CPAEngine." << endl;
+  return(0);
+}
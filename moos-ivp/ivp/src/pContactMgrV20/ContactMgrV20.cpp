@@ -29,7 +29,7 @@
 #include "MBUtils.h"
 #include "AngleUtils.h"
 #include "ColorParse.h"
-#include "CPAEngine.h"
+#include "CPAEngineBatch.h"
 #include "NodeRecordUtils.h"
 #include "XYCircle.h"
 #include "ACTable.h"
@@ -1474,6 +1474,9 @@ void ContactMgrV20::updateRanges()
 {
   double alert_range_cpa_time = 36000; // 10 hours
 
+  // CPA for all contacts is evaluated together after the loop
+  CPAEngineBatch cpa_batch(m_osy, m_osx);
+
   vector<string> vnames = m_ledger.getVNames();
   for(unsigned int i=0; i<vnames.size(); i++) {
     string     contact = vnames[i];
@@ -1516,15 +1519,19 @@ void ContactMgrV20::updateRanges()
     }
     m_map_node_ranges_extrap[contact] = range_extrap;
 
-    // #3 Determine and store the cpa range between ownship and the
-    // contact position determined by the contact's extrapolated position
-    // and it's last known heading and speed.
-    CPAEngine engine(cny, cnx, cnh, cns, m_osy, m_osx);      
-    double range_cpa = engine.evalCPA(m_osh, m_osv,
-				      alert_range_cpa_time);
-    double roc = engine.evalROC(m_osh, m_osv);
-    m_map_node_cpa[contact] = range_cpa;
-    m_map_node_roc[contact] = roc;
+    // #3 Queue the contact position determined by the contact's
+    // extrapolated position and it's last known heading and speed.
+    cpa_batch.addContact(cny, cnx, cnh, cns);
+  }
+
+  // #4 Determine and store the cpa range and rate of closure between
+  // ownship and each queued contact.
+  vector<double> cpas, rocs;
+  cpa_batch.evalCPA(m_osh, m_osv, alert_range_cpa_time, cpas);
+  cpa_batch.evalROC(m_osh, m_osv, rocs);
+  for(unsigned int i=0; i<vnames.size(); i++) {
+    m_map_node_cpa[vnames[i]] = cpas[i];
+    m_map_node_roc[vnames[i]] = rocs[i];
   }
 }
 
@@ -0,0 +1,347 @@
+/*****************************************************************/
+/*    NAME: agent                                                */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: DubinsCacheBench.cpp                                 */
+/*    DATE: Oct 19th, 2026                                       */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+// Benchmark of Dubins bids and the shared turn fan cache. Two
+// workloads are timed:
+//
+//   bid:   Task bid rounds as run by the Dubins task behaviors
+//          (BHV_TaskWaypoint3, BHV_TaskConvoy3). Each round every
+//          vehicle bids on each announced task, building the
+//          predicted trajectory posted as VIEW_SEGLIST and bidding
+//          its length. The prior discretized bid is compared with
+//          the exact DubinsPath bid. Vehicles are underway, with
+//          new poses every round.
+//   walls: Several wall avoidance behaviors per helm iteration, each
+//          needing the fan of Dubins turns from ownship's pose,
+//          built by each or shared through DubinsPathCache.
+//
+//   dubins_bench
+//   dubins_bench --vehicles=8 --reps=10
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <cmath>
+#include <memory>
+#include <chrono>
+#include "MBUtils.h"
+#include "ACTable.h"
+#include "XYSegList.h"
+#include "DubinsPath.h"
+#include "DubinsCache.h"
+#include "DubinsPathCache.h"
+
+using namespace std;
+
+//--------------------------------------------------------
+// Procedure: nowMsecs()
+
+double nowMsecs()
+{
+  using namespace std::chrono;
+  return(duration<double, milli>(steady_clock::now().time_since_epoch()).count());
+}
+
+//--------------------------------------------------------
+// Procedure: pmod()
+
+double pmod(double a, double b)
+{
+  double r = fmod(a,b);
+  if(r < 0)
+    r += b;
+  return(r);
+}
+
+//--------------------------------------------------------
+// Procedure: oldTaskBid()
+//   Purpose: The task bid as computed by BHV_TaskWaypoint3 before
+//            it used DubinsPath. The turn side is chosen
+//            by bearing, and the turn walked in 5 degree steps.
+
+double oldTaskBid(double osx, double osy, double osh, double rad,
+		  double ptx, double pty, string& spec)
+{
+  XYSegList predicted_trajectory;
+
+  double dx = ptx - osx;
+  double dy = pty - osy;
+
+  double heading = pmod(450-osh, 360)*M_PI/180;
+  double psi = pmod(atan2(dy, dx) - heading + M_PI, 2 * M_PI) - M_PI;
+
+  double ang_to_cor = heading;
+  double cw = -1;
+  if(psi < 0) {
+    ang_to_cor -= M_PI / 2;
+    cw = -1;
+  }
+  else {
+    ang_to_cor += M_PI / 2;
+    cw = 1;
+  }
+
+  double current_x = osx;
+  double current_y = osy;
+  double current_heading = heading;
+
+  double center_x = current_x + rad * cos(ang_to_cor);
+  double center_y = current_y + rad * sin(ang_to_cor);
+
+  predicted_trajectory.add_vertex(current_x, current_y);
+
+  double step_size = 0.5;
+  while(hypot(pty - center_y, ptx - center_x) < rad) {
+    current_x += step_size * cos(current_heading);
+    current_y += step_size * sin(current_heading);
+    center_x = current_x + rad * cos(ang_to_cor);
+    center_y = current_y + rad * sin(ang_to_cor);
+  }
+  if(hypot(current_y - osy, current_x - osx) > step_size / 2)
+    predicted_trajectory.add_vertex(current_x, current_y);
+
+  int steps = 1;
+  double ang_step_size = 5*M_PI/180;
+  while(true) {
+    double nang = ang_to_cor + M_PI + (cw * steps * ang_step_size);
+    double next_point_x = center_x + rad * cos(nang);
+    double next_point_y = center_y + rad * sin(nang);
+
+    double dv_x = ptx - current_x;
+    double dv_y = pty - current_y;
+    double du_y = next_point_y - current_y;
+    double du_x = next_point_x - current_x;
+
+    double phi = atan2(dv_y, dv_x) - atan2(du_y, du_x);
+    phi = pmod(phi + M_PI, 2 * M_PI) - M_PI;
+    if(cw*phi+ang_step_size < 0 || steps > 1000)
+      break;
+
+    current_x = next_point_x;
+    current_y = next_point_y;
+    predicted_trajectory.add_vertex(current_x,current_y);
+    steps++;
+  }
+
+  predicted_trajectory.add_vertex(ptx,pty);
+  predicted_trajectory.set_color("edge","red");
+  predicted_trajectory.set_label("abe_dubins_wpt");
+  predicted_trajectory.set_label_color("invisible");
+  spec = predicted_trajectory.get_spec();
+  return(predicted_trajectory.length());
+}
+
+//--------------------------------------------------------
+// Procedure: newTaskBid()
+//   Purpose: The task bid as computed by BHV_TaskWaypoint3 now.
+
+double newTaskBid(double osx, double osy, double osh, double rad,
+		  double ptx, double pty, string& spec)
+{
+  DubinsPath path(osx, osy, osh, rad);
+  path.setGoal(ptx, pty);
+  XYSegList predicted_trajectory = path.getSegList(5);
+  predicted_trajectory.set_color("edge","red");
+  predicted_trajectory.set_label("abe_dubins_wpt");
+  predicted_trajectory.set_label_color("invisible");
+  spec = predicted_trajectory.get_spec();
+  return(path.getLength());
+}
+
+//--------------------------------------------------------
+// Procedure: bidRound()
+//   Purpose: Every vehicle bids on every task from its pose.
+//   Returns: The sum of the bids
+
+double bidRound(const vector<double>& vx, const vector<double>& vy,
+		const vector<double>& vh, double rad,
+		const vector<double>& tx, const vector<double>& ty,
+		bool use_new, vector<double>& bids)
+{
+  bids.clear();
+  double total = 0;
+  string spec;
+  for(unsigned int v=0; v<vx.size(); v++) {
+    for(unsigned int t=0; t<tx.size(); t++) {
+      double bid = 0;
+      if(use_new)
+	bid = newTaskBid(vx[v], vy[v], vh[v], rad, tx[t], ty[t], spec);
+      else
+	bid = oldTaskBid(vx[v], vy[v], vh[v], rad, tx[t], ty[t], spec);
+      bids.push_back(bid);
+      total += bid;
+    }
+  }
+  return(total);
+}
+
+//--------------------------------------------------------
+// Procedure: main
+
+int main(int argc, char *argv[])
+{
+  unsigned int vehicles = 8;
+  unsigned int reps     = 10;
+
+  for(int i=1; i<argc; i++) {
+    string argi = argv[i];
+    if(strBegins(argi, "--vehicles="))
+      vehicles = atoi(argi.substr(11).c_str());
+    else if(strBegins(argi, "--reps="))
+      reps = atoi(argi.substr(7).c_str());
+    else {
+      cout << "Usage: dubins_bench [--vehicles=N] [--reps=N]" << endl;
+      return(1);
+    }
+  }
+  if(vehicles == 0)
+    vehicles = 1;
+  if(reps == 0)
+    reps = 1;
+
+  // The BHV_TaskWaypoint3 default turn radius
+  double rad = 3;
+  srand(1);
+
+  //=============================================================
+  // Part 1: Task bid rounds
+  ACTable actab(7,2);
+  actab << "Tasks | Vehicles | Old (ms) | New (ms) | Speedup | Mean Diff (m) | Max Diff (m)";
+  actab.addHeaderLines();
+
+  unsigned int task_amts[] = {1, 4, 16};
+  for(unsigned int k=0; k<3; k++) {
+    unsigned int amt = task_amts[k];
+    vector<double> tx, ty;
+    for(unsigned int t=0; t<amt; t++) {
+      tx.push_back((rand() % 401) - 200);
+      ty.push_back((rand() % 401) - 200);
+    }
+    vector<double> vx, vy, vh;
+    for(unsigned int v=0; v<vehicles; v++) {
+      vx.push_back(((rand() % 40001) - 20000) / 100.0);
+      vy.push_back(((rand() % 40001) - 20000) / 100.0);
+      vh.push_back((rand() % 36000) / 100.0);
+    }
+
+    // Poses for each round. The vehicles move on at 2 m/s between
+    // one second rounds.
+    unsigned int rounds = reps * 100;
+    vector<vector<double> > rx(rounds), ry(rounds);
+    for(unsigned int r=0; r<rounds; r++) {
+      double dist = 2.0 * r;
+      for(unsigned int v=0; v<vehicles; v++) {
+	rx[r].push_back(vx[v] + (dist * sin(vh[v] * M_PI / 180)));
+	ry[r].push_back(vy[v] + (dist * cos(vh[v] * M_PI / 180)));
+      }
+    }
+
+    vector<double> old_bids, new_bids;
+    double old_start = nowMsecs();
+    for(unsigned int r=0; r<rounds; r++)
+      bidRound(rx[r], ry[r], vh, rad, tx, ty, false, old_bids);
+    double old_ms = (nowMsecs() - old_start) / rounds;
+
+    double new_start = nowMsecs();
+    for(unsigned int r=0; r<rounds; r++)
+      bidRound(rx[r], ry[r], vh, rad, tx, ty, true, new_bids);
+    double new_ms = (nowMsecs() - new_start) / rounds;
+
+    // Difference of the last round's bids, old against new. The
+    // new bid is the shortest feasible Dubins path.
+    double sum_diff = 0;
+    double max_diff = 0;
+    for(unsigned int i=0; i<old_bids.size(); i++) {
+      double diff = fabs(old_bids[i] - new_bids[i]);
+      sum_diff += diff;
+      if(diff > max_diff)
+	max_diff = diff;
+    }
+    double mean_diff = sum_diff / old_bids.size();
+
+    actab << amt << vehicles;
+    actab << doubleToString(old_ms, 3) << doubleToString(new_ms, 3);
+    actab << doubleToString(old_ms / new_ms, 1);
+    actab << doubleToString(mean_diff, 2) << doubleToString(max_diff, 2);
+  }
+
+  cout << "Task bid rounds: turn radius " << rad << "m, ";
+  cout << "time per round, Reps: " << reps << endl << endl;
+  cout << actab.getFormattedString() << endl << endl;
+
+  //=============================================================
+  // Part 2: Turn fans shared by wall avoidance behaviors
+  ACTable wtab(4,2);
+  wtab << "Behaviors | Own Fan (us) | Shared (us) | Speedup";
+  wtab.addHeaderLines();
+
+  bool fans_match = true;
+  unsigned int bhv_amts[] = {1, 4, 16};
+  for(unsigned int k=0; k<3; k++) {
+    unsigned int amt = bhv_amts[k];
+    unsigned int iters = reps * 100;
+
+    double own_start = nowMsecs();
+    for(unsigned int i=0; i<iters; i++) {
+      for(unsigned int b=0; b<amt; b++) {
+	DubinsCache dcache;
+	dcache.setParams(i, 0, 45, rad);
+	dcache.buildCache(360);
+      }
+    }
+    double own_us = 1e3 * (nowMsecs() - own_start) / iters;
+
+    DubinsPathCache cache;
+    double shr_start = nowMsecs();
+    for(unsigned int i=0; i<iters; i++) {
+      for(unsigned int b=0; b<amt; b++)
+	shared_ptr<const DubinsCache> dcache =
+	  cache.getTurnFan(i, 0, 45, rad, 360);
+    }
+    double shr_us = 1e3 * (nowMsecs() - shr_start) / iters;
+
+    DubinsCache own;
+    own.setParams(0, 0, 45, rad);
+    own.buildCache(360);
+    shared_ptr<const DubinsCache> shr = cache.getTurnFan(0, 0, 45, rad, 360);
+    for(unsigned int j=0; j<360; j++) {
+      if((own.getArcLenIX(j) != shr->getArcLenIX(j)) ||
+	 (own.getTurnHdgIX(j) != shr->getTurnHdgIX(j)))
+	fans_match = false;
+    }
+
+    wtab << amt << doubleToString(own_us, 1) << doubleToString(shr_us, 1);
+    wtab << doubleToString(own_us / shr_us, 1);
+  }
+
+  cout << "Wall avoidance: 360 turns per fan, per helm iteration" << endl;
+  cout << endl << wtab.getFormattedString() << endl << endl;
+
+  if(!fans_match) {
+    cout << "MISMATCH: shared turn fan differs from DubinsCache" << endl;
+    return(1);
+  }
+  cout << "Shared turn fans match DubinsCache." << endl;
+  return(0);
+}
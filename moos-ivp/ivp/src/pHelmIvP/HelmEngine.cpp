@@ -33,6 +33,7 @@
 #include "IO_Utilities.h"
 #include "IvPProblem.h"
 #include "BehaviorSet.h"
+#include "BuildTally.h"
 
 using namespace std;
 
@@ -96,6 +97,8 @@ HelmReport HelmEngine::determineNextDecision(BehaviorSet *bhv_set,
   m_bhv_set     = bhv_set;
   m_curr_time   = curr_time;
   m_helm_report.clear();
+  m_helm_profile.clear();
+  m_helm_profile.setIteration(m_iteration);
   m_map_ipfs.clear();
 
   vector<string> templating_summary = m_bhv_set->getTemplatingSummary();
@@ -228,6 +231,7 @@ bool HelmEngine::part2_GetFunctionsFromBehaviorSet(int filter_level)
   
   // get all the objective functions and add time info to helm report
   m_create_timer.start();
+  double create_start = BuildTally::now();
   for(bhv_ix=0; bhv_ix<bhv_cnt; bhv_ix++) {
     if(m_bhv_set->getFilterLevel(bhv_ix) == filter_level) {
       string bhv_state;
@@ -236,6 +240,7 @@ bool HelmEngine::part2_GetFunctionsFromBehaviorSet(int filter_level)
 
       IvPFunction *newof = m_bhv_set->produceOF(bhv_ix, m_iteration,
 						bhv_state, ipf_reuse);
+      m_helm_profile.addBehavior(m_bhv_set->getLastProfile());
       
       //cout << "********************************************" << endl;
       //string bname = m_bhv_set->getDescriptor(bhv_ix);
@@ -275,6 +280,7 @@ bool HelmEngine::part2_GetFunctionsFromBehaviorSet(int filter_level)
 	  bhv_error_str = " - unknown - ";
 	m_helm_report.setHaltMsg("BHV_ERROR: " + bhv_error_str);
 	m_create_timer.stop();
+	noteCreateTime(create_start);
 	return(false);
       }
       
@@ -339,6 +345,7 @@ bool HelmEngine::part2_GetFunctionsFromBehaviorSet(int filter_level)
     }
   }
   m_create_timer.stop();
+  noteCreateTime(create_start);
 
   m_helm_report.setUpdateResults(m_bhv_set->getUpdateResults());
 
@@ -470,6 +477,7 @@ bool HelmEngine::part4_BuildAndSolveIvPProblem(string phase)
   m_ivp_problem = new IvPProblem;
   m_ivp_problem->setOwnerIPFs(false);
   m_solve_timer.start();
+  double solve_start = BuildTally::now();
   map<string, IvPFunction*>::iterator p;
   for(p=m_map_ipfs.begin(); p!=m_map_ipfs.end(); p++) {
     if(p->second != 0)
@@ -479,6 +487,7 @@ bool HelmEngine::part4_BuildAndSolveIvPProblem(string phase)
   m_ivp_problem->alignOFs();
   m_ivp_problem->solve();
   m_solve_timer.stop();
+  noteSolveCounts(solve_start);
   
   unsigned int dsize = m_sub_domain.size();
   for(unsigned int i=0; i<dsize; i++) {
@@ -521,6 +530,48 @@ bool HelmEngine::part5_FreeMemoryIPFs()
   return(true);
 }
 
+//------------------------------------------------------------------
+// Procedure: noteCreateTime()
+//   Purpose: Add the wall time since create_start, in ms, to the
+//            profile. Both filter levels may build functions.
+
+void HelmEngine::noteCreateTime(double create_start)
+{
+  double elapsed = (BuildTally::now() - create_start) * 1000;
+  m_helm_profile.setCreateTime(m_helm_profile.getCreateTime() + elapsed);
+}
+
+//------------------------------------------------------------------
+// Procedure: noteSolveCounts()
+//   Purpose: Add the solve time and branch and bound counts of the
+//            problem just solved to the profile. The problem holds
+//            the functions in the order of m_map_ipfs, so level i
+//            belongs to the i-th behavior with a function there.
+
+void HelmEngine::noteSolveCounts(double solve_start)
+{
+  double elapsed = (BuildTally::now() - solve_start) * 1000;
+  m_helm_profile.setSolveTime(m_helm_profile.getSolveTime() + elapsed);
+
+  double leafs = m_ivp_problem->getLeafsVisited();
+  unsigned int nodes  = m_ivp_problem->getNodesVisited();
+  unsigned int pruned = m_ivp_problem->getNodesPruned();
+  m_helm_profile.setLeafs(m_helm_profile.getLeafs() + leafs);
+  m_helm_profile.setNodes(m_helm_profile.getNodes() + nodes);
+  m_helm_profile.setPruned(m_helm_profile.getPruned() + pruned);
+
+  unsigned int level = 0;
+  map<string, IvPFunction*>::iterator p;
+  for(p=m_map_ipfs.begin(); p!=m_map_ipfs.end(); p++) {
+    if(p->second == 0)
+      continue;
+    m_helm_profile.setSolveCounts(p->first,
+				  m_ivp_problem->getLevelNodes(level),
+				  m_ivp_problem->getLevelPruned(level));
+    level++;
+  }
+}
+
 //------------------------------------------------------------------
 // Procedure: part6_FinishHelmReport()
 
@@ -29,6 +29,7 @@
 #include <vector>
 #include "IvPDomain.h"
 #include "HelmReport.h"
+#include "HelmProfile.h"
 #include "MBTimer.h"
 #include "PlatModelGenerator.h"
 #include "PlatModel.h"
@@ -50,6 +51,9 @@ public:
   HelmReport determineNextDecision(BehaviorSet *bset, double curr_time);
   bool addAbleFilterMsg(std::string);
   bool applyAbleFilterMsgs();
+
+  // Where the time of the last decision went, by behavior
+  HelmProfile getProfile() const {return(m_helm_profile);}
   
   unsigned long int size() const;
   
@@ -63,6 +67,9 @@ protected:
   bool   part5_FreeMemoryIPFs();
   bool   part6_FinishHelmReport();
 
+  void   noteCreateTime(double create_start);
+  void   noteSolveCounts(double solve_start);
+
 protected:
   IvPDomain  m_ivp_domain;
   IvPDomain  m_sub_domain;
@@ -70,6 +77,7 @@ protected:
   // Intermediate structures while determining next decision
   unsigned int m_iteration;
   HelmReport   m_helm_report;
+  HelmProfile  m_helm_profile;
   BehaviorSet *m_bhv_set;
   double       m_curr_time;
   unsigned int m_total_pcs_formed;
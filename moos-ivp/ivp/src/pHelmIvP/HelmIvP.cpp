@@ -83,6 +83,8 @@ HelmIvP::HelmIvP()
 
   m_allow_override  = true;
   m_park_on_allstop = false;
+  m_profile         = false;
+  m_ipf_encoding    = "ascii";
 
   m_ibuffer_curr_time_updated = false;
 
@@ -464,6 +466,8 @@ bool HelmIvP::Iterate()
     report = m_helm_report.getReportAsString(m_prev_helm_report); 
   
   Notify("IVPHELM_SUMMARY", report);
+  if(m_profile)
+    Notify("IVPHELM_PROFILE", m_hengine->getProfile().getSpec());
   Notify("IVPHELM_IPF_CNT", m_helm_report.getOFNUM());
   Notify("IVPHELM_TOTAL_PCS_FORMED", m_helm_report.getTotalPcsFormed());
   Notify("IVPHELM_TOTAL_PCS_CACHED", m_helm_report.getTotalPcsCached());
@@ -1316,6 +1320,10 @@ bool HelmIvP::OnStartUp()
       handled = handleConfigPMGen(value);
     else if(param == "OTHER_OVERRIDE_VAR") 
       handled = setNonWhiteVarOnString(m_additional_override, value);
+    else if(param == "IPF_ENCODING") 
+      handled = handleConfigIPFEncoding(value);
+    else if(param == "PROFILE") 
+      handled = setBooleanOnString(m_profile, value);
 
     if(!handled)
       reportUnhandledConfigWarning(orig);
@@ -1367,6 +1375,8 @@ bool HelmIvP::OnStartUp()
   else // added nov1724
     m_hengine->setBehaviorSet(m_bhv_set);
 
+  m_bhv_set->setIPFEncoding(m_ipf_encoding);
+
   // Set the "ownship" parameter for all behaviors
   unsigned int i, bsize = m_bhv_set->size();
   for(i=0; i<bsize; i++) {
@@ -1533,6 +1543,19 @@ bool HelmIvP::handleConfigPMGen(string str)
   return(m_plat_model_generator.setParams(str));
 }
 
+//--------------------------------------------------------------------
+// Procedure: handleConfigIPFEncoding()
+//   Example: ipf_encoding = delta
+
+bool HelmIvP::handleConfigIPFEncoding(string str)
+{
+  str = tolower(stripBlankEnds(str));
+  if((str != "ascii") && (str != "binary") && (str != "delta"))
+    return(false);
+  m_ipf_encoding = str;
+  return(true);
+}
+
 //--------------------------------------------------------------------
 // Procedure: checkHoldOnApps()
 //     Notes: If any hold_on_apps have been specified, check DB_CLIENTS
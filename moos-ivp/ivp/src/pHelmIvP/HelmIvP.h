@@ -58,6 +58,7 @@ public:
   bool handleConfigDomain(const std::string&);
   bool handleConfigHoldOnApp(std::string);
   bool handleConfigPMGen(std::string);
+  bool handleConfigIPFEncoding(std::string);
   
  protected:
   bool handleHeartBeat(const std::string&);
@@ -106,6 +107,8 @@ protected:
   
   bool          m_allow_override;
   bool          m_park_on_allstop;
+  bool          m_profile;
+  std::string   m_ipf_encoding;
   std::string   m_allstop_msg;
   IvPDomain     m_ivp_domain;
   BehaviorSet*  m_bhv_set;
@@ -130,6 +130,13 @@ void showExampleConfigAndExit()
   blk("  // Name apps to wait on before posting onHelmStart messages.  ");
   blk("  hold_on_apps = pBasicContactMgr, pTaskManager                 ");
   blk("                                                                ");
+  blk("  // Encoding of posted BHV_IPF functions. Binary and delta are  ");
+  blk("  // compact, delta codes against the behavior's prior function. ");
+  blk("  ipf_encoding = ascii  "," // or {binary,delta}                ");
+  blk("                                                                ");
+  blk("  // Post IVPHELM_PROFILE, where each iteration's time went.     ");
+  blk("  profile      = false  "," // or {true}                         ");
+  blk("                                                                ");
   blk("  app_logging = true  // {true or file} By default disabled     ");
   blk("}                                                               ");
   blk("                                                                ");
@@ -195,6 +202,8 @@ void showInterfaceAndExit()
   blk("  IVPHELM_UPDATEVARS    = MOOS vars involved in behavior updates");
   blk("  IVPHELM_UPDATE_RESULT = Report on attempted behavior update   ");
   blk("  IVPHELM_SUMMARY       = A helm snapshot for use in uHelmScope ");
+  blk("  IVPHELM_PROFILE       = Per behavior create and solve times,  ");
+  blk("                          when profile = true                   ");
   blk("  IVPHELM_RESTARTED     = true when/if helm is RE-started       ");
   blk("  PLOGGER_CMD           = Request pLogger to copy the bhv file  ");
   blk("                                                                ");
@@ -0,0 +1,210 @@
+/*****************************************************************/
+/*    NAME: agent                                                */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: IPFEncodingBench.cpp                                 */
+/*    DATE: Oct 19th, 2026                                       */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+// Benchmark of the BHV_IPF encodings. A behavior's objective function
+// is built each helm iteration from a gaussian that drifts a little
+// each time, as a behavior tracking a moving contact would. Each
+// sequence of functions is encoded ascii, binary and binary with
+// deltas against the prior function, and decoded again.
+//
+//   ipf_bench
+//   ipf_bench --iters=40 --reps=10
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include "MBUtils.h"
+#include "MBTimer.h"
+#include "ACTable.h"
+#include "BuildUtils.h"
+#include "AOF_Gaussian.h"
+#include "OF_Reflector.h"
+#include "FunctionEncoder.h"
+#include "FunctionEncoderBin.h"
+
+using namespace std;
+
+//--------------------------------------------------------
+// Procedure: buildSequence()
+//   Purpose: One function per helm iteration, the gaussian center
+//            moving a little each iteration.
+
+vector<IvPFunction*> buildSequence(unsigned int pcs, unsigned int iters)
+{
+  IvPDomain domain = stringToDomain("x,-100,100,201:y,-100,100,201");
+
+  vector<IvPFunction*> ipfs;
+  double xc = 0;
+  double yc = 0;
+  for(unsigned int i=0; i<iters; i++) {
+    xc += (rand() % 5) - 2;
+    yc += (rand() % 5) - 2;
+    AOF_Gaussian aof(domain);
+    aof.setParam("xcent", xc);
+    aof.setParam("ycent", yc);
+    aof.setParam("sigma", 40);
+    aof.setParam("range", 100);
+
+    OF_Reflector reflector(&aof, 1);
+    reflector.create(pcs);
+    IvPFunction *ipf = reflector.extractIvPFunction();
+    ipf->setPWT(100);
+    ipf->setContextStr(uintToString(i) + ":gauss_bhv");
+    ipfs.push_back(ipf);
+  }
+  return(ipfs);
+}
+
+//--------------------------------------------------------
+// Procedure: main
+
+int main(int argc, char *argv[])
+{
+  unsigned int iters = 40;
+  unsigned int reps  = 5;
+
+  for(int i=1; i<argc; i++) {
+    string argi = argv[i];
+    if(strBegins(argi, "--iters="))
+      iters = atoi(argi.substr(8).c_str());
+    else if(strBegins(argi, "--reps="))
+      reps = atoi(argi.substr(7).c_str());
+    else {
+      cout << "Usage: ipf_bench [--iters=N] [--reps=N]" << endl;
+      return(1);
+    }
+  }
+  if(iters == 0)
+    iters = 1;
+  if(reps == 0)
+    reps = 1;
+
+  srand(1);
+
+  ACTable btab(5,2);
+  btab << "Pieces | Ascii (B) | Binary (B) | Delta (B) | Ascii/Delta";
+  btab.addHeaderLines();
+
+  ACTable ttab(7,2);
+  ttab << "Pieces | Enc Ascii | Enc Bin | Enc Delta | Dec Ascii | Dec Bin | Dec Delta";
+  ttab.addHeaderLines();
+
+  unsigned int pcs_amts[] = {100, 400, 1600, 6400};
+  for(unsigned int k=0; k<4; k++) {
+    unsigned int pcs = pcs_amts[k];
+    vector<IvPFunction*> ipfs = buildSequence(pcs, iters);
+
+    // Smaller functions run more reps to be measurable
+    unsigned int runs = reps * (6400 / pcs);
+    double funcs = runs * iters;
+
+    // Part 1: Encoding
+    vector<string> ascii_strs, bin_strs, delta_strs;
+    MBTimer enc_ascii;
+    enc_ascii.start();
+    for(unsigned int r=0; r<runs; r++) {
+      ascii_strs.clear();
+      for(unsigned int i=0; i<iters; i++)
+	ascii_strs.push_back(IvPFunctionToString(ipfs[i]));
+    }
+    enc_ascii.stop();
+
+    MBTimer enc_bin;
+    enc_bin.start();
+    for(unsigned int r=0; r<runs; r++) {
+      bin_strs.clear();
+      for(unsigned int i=0; i<iters; i++)
+	bin_strs.push_back(IvPFunctionToBinString(ipfs[i]));
+    }
+    enc_bin.stop();
+
+    MBTimer enc_delta;
+    enc_delta.start();
+    for(unsigned int r=0; r<runs; r++) {
+      IPFBinCoder encoder;
+      delta_strs.clear();
+      for(unsigned int i=0; i<iters; i++)
+	delta_strs.push_back(encoder.encode(ipfs[i]));
+    }
+    enc_delta.stop();
+
+    // Part 2: Decoding
+    unsigned int ascii_bytes = 0;
+    unsigned int bin_bytes   = 0;
+    unsigned int delta_bytes = 0;
+    for(unsigned int i=0; i<iters; i++) {
+      ascii_bytes += ascii_strs[i].length();
+      bin_bytes   += bin_strs[i].length();
+      delta_bytes += delta_strs[i].length();
+    }
+
+    MBTimer dec_ascii;
+    dec_ascii.start();
+    for(unsigned int r=0; r<runs; r++) {
+      for(unsigned int i=0; i<iters; i++)
+	delete(StringToIvPFunction(ascii_strs[i]));
+    }
+    dec_ascii.stop();
+
+    MBTimer dec_bin;
+    dec_bin.start();
+    for(unsigned int r=0; r<runs; r++) {
+      for(unsigned int i=0; i<iters; i++)
+	delete(StringToIvPFunction(bin_strs[i]));
+    }
+    dec_bin.stop();
+
+    MBTimer dec_delta;
+    dec_delta.start();
+    for(unsigned int r=0; r<runs; r++) {
+      IPFBinCoder decoder;
+      for(unsigned int i=0; i<iters; i++)
+	delete(StringToIvPFunction(decoder.resolve(delta_strs[i])));
+    }
+    dec_delta.stop();
+
+    btab << pcs;
+    btab << (ascii_bytes / iters) << (bin_bytes / iters);
+    btab << (delta_bytes / iters);
+    btab << doubleToString((double)(ascii_bytes) / delta_bytes, 1);
+
+    ttab << pcs;
+    ttab << doubleToString(1e6 * enc_ascii.get_float_wall_time() / funcs, 1);
+    ttab << doubleToString(1e6 * enc_bin.get_float_wall_time() / funcs, 1);
+    ttab << doubleToString(1e6 * enc_delta.get_float_wall_time() / funcs, 1);
+    ttab << doubleToString(1e6 * dec_ascii.get_float_wall_time() / funcs, 1);
+    ttab << doubleToString(1e6 * dec_bin.get_float_wall_time() / funcs, 1);
+    ttab << doubleToString(1e6 * dec_delta.get_float_wall_time() / funcs, 1);
+
+    for(unsigned int i=0; i<iters; i++)
+      delete(ipfs[i]);
+  }
+
+  cout << "Bytes per IPF: drifting gaussian, " << iters;
+  cout << " helm iterations, keyframe every 20" << endl << endl;
+  cout << btab.getFormattedString() << endl << endl;
+  cout << "Time per IPF (us), Reps: " << reps << endl << endl;
+  cout << ttab.getFormattedString() << endl;
+  return(0);
+}
@@ -486,7 +486,10 @@ void PMV_MOOSApp::handleNewMail(const MOOS_event &e)
       handled = m_gui->mviewer->handleNodeReport(sval, why_not);
     }
 
-    if (key == "PHI_HOST_IP")
+    if (msg.IsBinary())
+      handled = m_gui->mviewer->addGeoShape(key, msg.GetBinaryDataAsVector(),
+                                            community);
+    else if (key == "PHI_HOST_IP")
       handled = m_gui->augmentTitleWithIP(sval);
     else if (key == "PMV_CLEAR")
       handled = handleMailClear(sval);
@@ -326,6 +326,17 @@ bool PMV_Viewer::addGeoShape(string param, string value, string community,
   return(m_geoshapes_map.addGeoShape(param, value, community, timestamp));
 }
 
+//-------------------------------------------------------------
+// Procedure: addGeoShape()
+//      Note: Binary form, e.g., VIEW_GRID_DELTA from pSearchGrid
+//            with delta_format=binary
+
+bool PMV_Viewer::addGeoShape(string param, const vector<unsigned char>& value,
+			     string community)
+{
+  return(m_geoshapes_map.addGeoShape(param, value, community));
+}
+
 
 //-------------------------------------------------------------
 // Procedure: setParam()
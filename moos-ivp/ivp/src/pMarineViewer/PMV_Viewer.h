@@ -52,6 +52,8 @@ class PMV_Viewer : public MarineViewer
   bool  handleNodeReport(std::string, std::string&);
 
   bool  addGeoShape(std::string p, std::string v, std::string c, double=0);
+  bool  addGeoShape(std::string p, const std::vector<unsigned char>& v,
+		    std::string c);
   bool  addScopeVariable(std::string);
   bool  updateScopeVariable(std::string varname, std::string value, 
 			    std::string vtime, std::string vsource);
@@ -47,6 +47,9 @@ ObstacleManager::ObstacleManager()
   m_max_pts_per_cluster = 20;
   m_max_age_per_point   = 20;
 
+  m_cluster_dist    = -1;  // meters (neg value means off)
+  m_cluster_min_pts = 3;
+
   m_poly_label_thresh = 25;
   m_poly_shade_thresh = 100;
   m_poly_vertex_thresh = 150;
@@ -74,6 +77,7 @@ ObstacleManager::ObstacleManager()
   m_points_total   = 0;
   m_points_ignored = 0;
   m_points_invalid = 0;
+  m_batches_total  = 0;
   m_obstacles_released = 0;
   m_obstacles_ever = 0;
 
@@ -124,6 +128,10 @@ bool ObstacleManager::OnNewMail(MOOSMSG_LIST &NewMail)
       m_nav_y = dval;
       handled = true;
     }
+    else if((key == m_points_var) && msg.IsBinary())
+      handled = handleMailNewPoints(msg.GetBinaryDataAsVector());
+    else if(key == m_points_var)
+      handled = handleMailNewPoints(sval);
     else if(key == "GIVEN_OBSTACLE") 
       handled = handleGivenObstacle(sval);
     else if(key == "OBM_ALERT_REQUEST") 
@@ -159,6 +167,7 @@ bool ObstacleManager::Iterate()
 {
   AppCastingMOOSApp::Iterate();
 
+  updateClusters();
   manageMemory();
   updatePointHulls();
   updatePolyRanges();
@@ -190,6 +199,8 @@ bool ObstacleManager::OnStartUp()
     bool handled = false;
     if((param == "point_var") && (toupper(value) != "GIVEN_OBSTABLE")) 
       handled = setNonWhiteVarOnString(m_point_var, value);
+    else if(param == "points_var") 
+      handled = setNonWhiteVarOnString(m_points_var, value);
     else if((param == "given_obstable") || (param == "given_obstacle"))
       handled = handleGivenObstacle(value, "mission");
     else if(param == "alert_range")
@@ -200,6 +211,15 @@ bool ObstacleManager::OnStartUp()
       handled = setUIntOnString(m_max_pts_per_cluster, value);
     else if(param == "max_age_per_point")
       handled = setPosDoubleOnString(m_max_age_per_point, value);
+    else if(param == "cluster_dist")
+      handled = setDoubleOnString(m_cluster_dist, value);
+    else if(param == "cluster_min_pts") {
+      handled = setUIntOnString(m_cluster_min_pts, value);
+      if(m_cluster_min_pts < 1) {
+	reportConfigWarning("cluster_min_pts must be at least 1");
+	m_cluster_min_pts = 1;
+      }
+    }
     else if(param == "post_dist_to_polys")
       handled = handleConfigPostDistToPolys(value);
     else if(param == "post_view_polys")
@@ -249,6 +269,13 @@ bool ObstacleManager::OnStartUp()
   // actually need
   if(m_point_var == "")
     m_point_var = "TRACKED_FEATURE";
+  if(m_points_var == "")
+    m_points_var = "TRACKED_FEATURES";
+
+  if(m_cluster_dist > 0) {
+    m_clusterer.setClusterDist(m_cluster_dist);
+    m_clusterer.setMinPoints(m_cluster_min_pts);
+  }
 
   Notify("OBM_CONNECT", "true");
   reportEvent("OBM_CONNECT=true");
@@ -265,6 +292,8 @@ void ObstacleManager::registerVariables()
   AppCastingMOOSApp::RegisterVariables();
   if(m_point_var != "")
     Register(m_point_var, 0);
+  if(m_points_var != "")
+    Register(m_points_var, 0);
 
   Register("NAV_X", 0);
   Register("NAV_Y", 0);
@@ -286,6 +315,8 @@ void ObstacleManager::registerVariables()
 //            currently is consistent with an XYPoint, but we custom parse
 //            here to decouple from the geometry string parsing library.
 //   Example: TRACKED_FEATURE = "x=23,y=99,key=b"
+//      Note: The key is optional. Unlabeled points are clustered
+//            if clustering is enabled, otherwise rejected.
 
 XYPoint ObstacleManager::customStringToPoint(string point_str)
 {
@@ -308,7 +339,7 @@ XYPoint ObstacleManager::customStringToPoint(string point_str)
       obstacle_key_str = value;
   }
 
-  if((x_str == "") || (y_str == "") || (obstacle_key_str == ""))
+  if((x_str == "") || (y_str == ""))
     return(null_pt);
 
   double x = atof(x_str.c_str());
@@ -390,15 +421,82 @@ bool ObstacleManager::handleGivenObstacle(string poly, string source)
 
 bool ObstacleManager::handleMailNewPoint(string value)
 {
-  // Part 1: Build the new point and check its validity
+  // Build the new point and check its validity
   XYPoint newpt = customStringToPoint(value);
-  if(!newpt.valid()) {
+  if(!newpt.valid() || ((newpt.get_msg() == "") && (m_cluster_dist <= 0))) {
     m_points_invalid++;
     reportRunWarning("Invalid point:" + value);
     return(false);
   }
-    
-  // Part 2: Check the range of point to ownship, perhaps ignore it
+
+  return(handleNewPoint(newpt));
+}
+
+//------------------------------------------------------------
+// Procedure: handleMailNewPoints()
+//   Purpose: Handle a batch of points in one posting, grouped by
+//            obstacle key. Unlabeled groups will be clustered.
+//   Example: TRACKED_FEATURES = "pts={23,99:24.5,98},label=b#pts={3,4}"
+
+bool ObstacleManager::handleMailNewPoints(string value)
+{
+  m_batches_total++;
+
+  PointBatch batch;
+  bool ok = batch.setFromSpec(value);
+  if(!ok)
+    reportRunWarning("Invalid point(s) in batch:" + value);
+
+  return(handlePointBatch(batch) && ok);
+}
+
+//------------------------------------------------------------
+// Procedure: handleMailNewPoints()
+//   Purpose: Same as above for a binary packed batch. 
+
+bool ObstacleManager::handleMailNewPoints(const vector<unsigned char>& data)
+{
+  m_batches_total++;
+
+  PointBatch batch;
+  if(!batch.setFromBinary(data.data(), data.size())) {
+    reportRunWarning("Invalid binary point batch");
+    return(false);
+  }
+  return(handlePointBatch(batch));
+}
+
+//------------------------------------------------------------
+// Procedure: handlePointBatch()
+//   Purpose: Handle each point just as if it arrived on its own
+
+bool ObstacleManager::handlePointBatch(const PointBatch& batch)
+{
+  unsigned int rejected = 0;
+  vector<XYPoint> points = batch.getPoints();
+  for(unsigned int i=0; i<points.size(); i++) {
+    if((points[i].get_msg() == "") && (m_cluster_dist <= 0)) {
+      m_points_invalid++;
+      rejected++;
+      continue;
+    }
+    handleNewPoint(points[i]);
+  }
+
+  if(rejected > 0) {
+    string msg = "Unlabeled batch points and clustering is off: ";
+    reportRunWarning(msg + uintToString(rejected));
+    return(false);
+  }
+  return(true);
+}
+
+//------------------------------------------------------------
+// Procedure: handleNewPoint()
+
+bool ObstacleManager::handleNewPoint(XYPoint newpt)
+{
+  // Part 1: Check the range of point to ownship, perhaps ignore it
   if(m_ignore_range > 0) {
     double ptx = newpt.get_vx();
     double pty = newpt.get_vy();
@@ -412,15 +510,30 @@ bool ObstacleManager::handleMailNewPoint(string value)
   m_points_total++;
   newpt.set_time(m_curr_time);
   
-  // Part 3: Get the obstacle key. Contained in the msg=key parameter, or
+  // Part 2: Get the obstacle key. Contained in the msg=key parameter, or
   //         if no msg=key parameter then in the label=key parameter. 
   string key = newpt.get_msg();
   if(key == "")
     key = newpt.get_label();
+
+  // Part 3: Unlabeled points are handed to the clusterer. Obstacles
+  //         are made from the clusters in updateClusters().
+  if((key == "") && (m_cluster_dist > 0)) {
+    m_clusterer.addPoint(newpt.x(), newpt.y(), m_curr_time);
+    return(true);
+  }
   if(key == "") 
     key = "generic";
 
-  // Part 4: Add the new point to the points associated with that key
+  // Part 4: A labeled point may not join an obstacle made by the
+  //         clusterer, even if its key happens to match.
+  if(m_cluster_ids.count(key)) {
+    m_points_invalid++;
+    reportRunWarning("Point key in use by a cluster: " + key);
+    return(false);
+  }
+
+  // Part 5: Add the new point to the points associated with that key
   m_map_obstacles[key].addPoint(newpt);
   m_map_obstacles[key].setChanged(true);
   m_map_obstacles[key].setMaxPts(m_max_pts_per_cluster);
@@ -434,6 +547,9 @@ bool ObstacleManager::handleMailNewPoint(string value)
 //   Purpose: Go through each obstacle and if the points of the
 //            obstacle have changed, either new one arrived or
 //            an older one has dropped, update the hull.
+//      Note: For clustered obstacles the clusterer already keeps
+//            the hull vertices, so only those are handed to the
+//            hull generator.
 
 bool ObstacleManager::updatePointHulls()
 {
@@ -456,12 +572,13 @@ bool ObstacleManager::updatePointHulls()
   
   map<string,Obstacle>::iterator p;
   for(p=m_map_obstacles.begin(); p!=m_map_obstacles.end(); p++) {
-    if(!p->second.hasChanged() && !thresh_crossed)
+    if(!p->second.isHullStale() && !thresh_crossed)
       continue;
     string key = p->first;
     vector<XYPoint> points = p->second.getPoints();
     if(points.size() == 0)
       continue;
+    p->second.setHullStale(false);
     
     XYPolygon poly;
     if(m_lasso) {
@@ -469,6 +586,9 @@ bool ObstacleManager::updatePointHulls()
       poly = genPseudoHull(points, m_lasso_radius);
     }
     else {
+      map<string, unsigned int>::iterator q = m_cluster_ids.find(key);
+      if(q != m_cluster_ids.end())
+	points = m_clusterer.getClusterHull(q->second);
       ConvexHullGenerator chgen;
       for(unsigned int i=0; i<points.size(); i++) 
 	chgen.addPoint(points[i].x(), points[i].y(), points[i].get_label());
@@ -623,13 +743,12 @@ void ObstacleManager::postConvexHullUpdates()
   map<string, Obstacle>::iterator p;
   // For all obstacles that have a convex hull
   for(p=m_map_obstacles.begin(); p!=m_map_obstacles.end(); p++) {
-    string   key = p->first;
-    Obstacle obs = p->second;
-    XYPolygon poly = obs.getPoly();
+    string key = p->first;
+    const Obstacle& obs = p->second;
 
     // Double check it is convex
-    if(poly.is_convex()) {
-      double dist = poly.dist_to_poly(m_nav_x, m_nav_y);
+    if(obs.isPolyConvex()) {
+      double dist = obs.getPolyDist(m_nav_x, m_nav_y);
       bool close_range = (dist <= m_alert_range);
 
       bool post_this_dist_to_poly = false;
@@ -768,9 +887,8 @@ void ObstacleManager::updatePolyRanges()
 {
   map<string,Obstacle>::iterator p;
   for(p=m_map_obstacles.begin(); p!=m_map_obstacles.end(); p++) {
-    string    key   = p->first;
-    XYPolygon poly  = p->second.getPoly();
-    double    range = poly.dist_to_poly(m_nav_x, m_nav_y);
+    string key   = p->first;
+    double range = p->second.getPolyDist(m_nav_x, m_nav_y);
 
     // Also keep track of closest range ever to any obstacle
     if((m_min_dist_ever < 0) || (range < m_min_dist_ever)) {
@@ -788,6 +906,64 @@ void ObstacleManager::updatePolyRanges()
   }
 }
 
+//------------------------------------------------------------
+// Procedure: updateClusters()
+//   Purpose: Re-cluster unlabeled points and refresh the obstacles
+//            made from any clusters that changed or vanished.
+
+void ObstacleManager::updateClusters()
+{
+  if(m_cluster_dist <= 0)
+    return;
+
+  m_clusterer.update(m_curr_time, m_max_age_per_point);
+
+  vector<unsigned int> removed = m_clusterer.getRemovedClusters();
+  for(unsigned int i=0; i<removed.size(); i++) {
+    map<unsigned int, string>::iterator q = m_cluster_keys.find(removed[i]);
+    if(q == m_cluster_keys.end())
+      continue;
+    string key = q->second;
+    if(m_map_obstacles.count(key))
+      releaseObstacle(key);
+    m_cluster_ids.erase(key);
+    m_cluster_keys.erase(q);
+  }
+
+  vector<unsigned int> changed = m_clusterer.getChangedClusters();
+  for(unsigned int i=0; i<changed.size(); i++) {
+    string key = clusterKey(changed[i]);
+    bool is_new = (m_map_obstacles.count(key) == 0);
+
+    Obstacle& obstacle = m_map_obstacles[key];
+    obstacle.setClustered(true);
+    obstacle.setPoints(m_clusterer.getClusterPoints(changed[i]));
+    if(is_new)
+      onNewObstacle("points");
+  }
+}
+
+//------------------------------------------------------------
+// Procedure: clusterKey()
+//   Purpose: The obstacle key of a cluster, made on first use. It
+//            is clst_<id>, with a suffix if a labeled obstacle
+//            already has that key.
+
+string ObstacleManager::clusterKey(unsigned int id)
+{
+  map<unsigned int, string>::iterator p = m_cluster_keys.find(id);
+  if(p != m_cluster_keys.end())
+    return(p->second);
+
+  string key = "clst_" + uintToString(id);
+  for(unsigned int i=1; m_map_obstacles.count(key); i++)
+    key = "clst_" + uintToString(id) + "_" + uintToString(i);
+
+  m_cluster_keys[id] = key;
+  m_cluster_ids[key] = id;
+  return(key);
+}
+
 //------------------------------------------------------------
 // Procedure: manageMemory()
 
@@ -809,25 +985,36 @@ void ObstacleManager::manageMemory()
     
   // Part 2: Free memory for obstacles flagged above
   set<string>::iterator q;
-  for(q=keys_to_forget.begin(); q!=keys_to_forget.end(); q++) {
-    string key = *q;
+  for(q=keys_to_forget.begin(); q!=keys_to_forget.end(); q++)
+    releaseObstacle(*q);
+}
 
-    // Post inactive view poly to erase this poly
-    if(m_post_view_polys) {
-      XYPolygon poly = m_map_obstacles[key].getPoly();
-      string spec = poly.get_spec_inactive();
-      Notify("VIEW_POLYGON", spec);
-    }
+//------------------------------------------------------------
+// Procedure: releaseObstacle()
 
-    // Post to alert variabe that this obstacle is resolved
-    Notify("OBM_RESOLVED", key);
-    m_alerts_resolved++;
-    reportEvent("OBM_RESOLVED=" + key);
+void ObstacleManager::releaseObstacle(string key)
+{
+  // Post inactive view poly to erase this poly
+  if(m_post_view_polys) {
+    XYPolygon poly = m_map_obstacles[key].getPoly();
+    string spec = poly.get_spec_inactive();
+    Notify("VIEW_POLYGON", spec);
+  }
 
-    
-    // Update key obstacle manager state
-    m_map_obstacles.erase(key);
-    m_obstacles_released++;
+  // Post to alert variabe that this obstacle is resolved
+  Notify("OBM_RESOLVED", key);
+  m_alerts_resolved++;
+  reportEvent("OBM_RESOLVED=" + key);
+
+  // Update key obstacle manager state. A cluster obstacle released
+  // here, e.g. by age, gets its key made again if it changes.
+  m_map_obstacles.erase(key);
+  m_obstacles_released++;
+
+  map<string, unsigned int>::iterator p = m_cluster_ids.find(key);
+  if(p != m_cluster_ids.end()) {
+    m_cluster_keys.erase(p->second);
+    m_cluster_ids.erase(p);
   }
 }
 
@@ -938,6 +1125,10 @@ bool ObstacleManager::buildReport()
   string str_max_pts_per = uintToString(m_max_pts_per_cluster);
   string str_max_age_per = doubleToStringX(m_max_age_per_point);
 
+  string str_cluster_dist = "off";
+  if(m_cluster_dist > 0)
+    str_cluster_dist = doubleToStringX(m_cluster_dist,1);
+
   string str_navx = doubleToStringX(m_nav_x,1);
   string str_navy = doubleToStringX(m_nav_y,1);
   string str_nav = "(" + str_navx + "," + str_navy + ")";
@@ -948,9 +1139,12 @@ bool ObstacleManager::buildReport()
   
   m_msgs << "Configuration (point handling):             " << endl;
   m_msgs << "  point_var:    " << m_point_var              << endl;
+  m_msgs << "  points_var:   " << m_points_var             << endl;
   m_msgs << "  max_pts_per_cluster: " << str_max_pts_per   << endl;
   m_msgs << "  max_age_per_point:   " << str_max_age_per   << endl;
   m_msgs << "  ignore_range:        " << str_ignore_rng    << endl;
+  m_msgs << "  cluster_dist:        " << str_cluster_dist  << endl;
+  m_msgs << "  cluster_min_pts:     " << m_cluster_min_pts << endl;
   m_msgs << "Configuration (given_obstacles):            " << endl;
   m_msgs << "  given_max_duration: " << m_given_max_duration << endl;
   m_msgs << "Configuration (viewing):                    " << endl;
@@ -976,6 +1170,14 @@ bool ObstacleManager::buildReport()
   m_msgs << "  Points Received:   " << m_points_total      << endl;
   m_msgs << "  Points Invalid:    " << m_points_invalid    << endl;
   m_msgs << "  Points Ignored:    " << m_points_ignored    << endl;
+  m_msgs << "  Point Batches:     " << m_batches_total     << endl;
+  if(m_cluster_dist > 0) {
+    m_msgs << "State: (clusters):                          " << endl;
+    m_msgs << "  Clusters:          " << m_clusterer.size()  << endl;
+    m_msgs << "  Clustered Points:  " << m_clusterer.getPointCount() << endl;
+    m_msgs << "  Noise Points:      " << m_clusterer.getNoiseCount() << endl;
+    m_msgs << "  Last Region Size:  " << m_clusterer.getRegionSize() << endl;
+  }
   m_msgs << "State: (given_obstacles):                   " << endl;
   m_msgs << "  Given Obstacles (mail) ever: " << m_given_mail_ever << endl;
   m_msgs << "  Given Obstacles (mail) good: " << m_given_mail_good << endl;
@@ -1008,6 +1210,8 @@ bool ObstacleManager::buildReport()
     string type_str = "points";
     if(obstacle.isGiven())
       type_str = "given";
+    else if(obstacle.isClustered())
+      type_str = "cluster";
 
     string duration_str = "n/a";
     string time_to_live_str = "n/a";
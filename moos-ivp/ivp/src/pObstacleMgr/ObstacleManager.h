@@ -27,6 +27,8 @@
 #include "MOOS/libMOOS/Thirdparty/AppCasting/AppCastingMOOSApp.h"
 #include "XYPolygon.h"
 #include "Obstacle.h"
+#include "PointClusterer.h"
+#include "PointBatch.h"
 #include "VarDataPair.h"
 #include "MailFlagSet.h"
 #include <set>
@@ -55,6 +57,10 @@ protected:
   bool handleConfigGeneralAlert(std::string);
 
   bool handleMailNewPoint(std::string);
+  bool handleMailNewPoints(std::string);
+  bool handleMailNewPoints(const std::vector<unsigned char>&);
+  bool handlePointBatch(const PointBatch&);
+  bool handleNewPoint(XYPoint);
   bool handleMailAlertRequest(std::string);
 
   bool handleGivenObstacle(std::string, std::string src="mail");
@@ -71,7 +77,11 @@ protected:
 
   bool updatePointHulls();
   void updatePolyRanges();
+  void updateClusters();
   void manageMemory();
+  void releaseObstacle(std::string key);
+
+  std::string clusterKey(unsigned int id);
 
   void postFlags(const std::vector<VarDataPair>& flags);
   
@@ -79,6 +89,7 @@ protected:
   
 private: // Configuration variables
   std::string  m_point_var;            // incoming points
+  std::string  m_points_var;           // incoming point batches
 
   std::string  m_alert_var;
   std::string  m_alert_name;
@@ -102,6 +113,10 @@ private: // Configuration variables
   unsigned int m_max_pts_per_cluster;
   double       m_max_age_per_point;
 
+  // Clustering of unlabeled points (off if dist <= 0)
+  double       m_cluster_dist;
+  unsigned int m_cluster_min_pts;
+
   // Configuring Lasso option
   bool         m_lasso;
   unsigned int m_lasso_points;
@@ -128,6 +143,7 @@ private: // State variables
   unsigned int  m_points_total;
   unsigned int  m_points_invalid;
   unsigned int  m_points_ignored;
+  unsigned int  m_batches_total;
   unsigned int  m_obstacles_released;
 
   unsigned int  m_alerts_posted;
@@ -140,6 +156,13 @@ private: // State variables
   unsigned int m_obstacles_ever;
   
   std::map<std::string, Obstacle> m_map_obstacles;
+
+  PointClusterer m_clusterer;
+
+  // Obstacle keys of the clusters, both ways. A cluster key is
+  // clst_<id> unless a labeled obstacle already has that key.
+  std::map<unsigned int, std::string> m_cluster_keys;
+  std::map<std::string, unsigned int> m_cluster_ids;
 };
 
 #endif 
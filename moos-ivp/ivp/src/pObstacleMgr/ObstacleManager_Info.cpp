@@ -90,7 +90,8 @@ void showExampleConfigAndExit()
   blk("  AppTick   = 4                                                 ");
   blk("  CommsTick = 4                                                 ");
   blk("                                                                ");
-  blk("  point_var = TRACKED_FEATURE  // default is TRACKED_FEATURE    ");
+  blk("  point_var  = TRACKED_FEATURE   // default TRACKED_FEATURE     ");
+  blk("  points_var = TRACKED_FEATURES  // default TRACKED_FEATURES    ");
   blk("                                                                ");
   blk("  given_obstacle = pts={90.2,-80.4:...:85.4,-80.4},label=ob_23  ");
   blk("                                                                ");
@@ -104,6 +105,10 @@ void showExampleConfigAndExit()
   blk("  alert_range  = 20          // (meters) default is 20          ");
   blk("  ignore_range = -1          // (meters) default is -1, (off)   ");
   blk("                                                                ");
+  blk("  // Cluster unlabeled points into obstacles (DBSCAN)           ");
+  blk("  cluster_dist    = 5        // (meters) default is -1, (off)   ");
+  blk("  cluster_min_pts = 3        // default is 3                    ");
+  blk("                                                                ");
   blk("  lasso = true               // default is false                ");
   blk("  lasso_points = 6           // default is 6                    ");
   blk("  lasso_radius = 5           // (meters) default is 5           ");
@@ -140,7 +145,11 @@ void showInterfaceAndExit()
   blk("                                                                ");
   blk("SUBSCRIPTIONS:                                                  ");
   blk("------------------------------------                            ");
-  blk("  TRACKED_FEATURE = x=5,y=8,label=a,size=4,color=1              ");
+  blk("  TRACKED_FEATURE  = x=5,y=8,label=a,size=4,color=1             ");
+  blk("  TRACKED_FEATURES = pts={5,8:5.5,9:6,8.2},label=a              ");
+  blk("                     (label optional if cluster_dist is set)    ");
+  blk("                     Groups may be joined with '#', and the     ");
+  blk("                     batch may also arrive binary packed.       ");
   blk("  GIVEN_OBSTACLE  = pts={90.2,-80.4:...:85.4,-80.4},label=ob_23 ");
   blk("                                                                ");
   blk("  NAV_X = 103.0                                                 ");
@@ -38,8 +38,12 @@ using namespace std;
 SearchGrid::SearchGrid()
 {
   m_report_deltas = true;
+  m_delta_format  = "text";
   m_grid_label    = "psg";
   m_grid_var_name = "VIEW_GRID";
+
+  m_delta_msgs_posted  = 0;
+  m_delta_bytes_posted = 0;
 }
 
 //---------------------------------------------------------
@@ -133,6 +137,13 @@ bool SearchGrid::OnStartUp()
       }	
       else if(param == "report_deltas") 
 	handled = setBooleanOnString(m_report_deltas, value);
+      else if(param == "delta_format") {
+	value = tolower(value);
+	if((value == "text") || (value == "binary")) {
+	  m_delta_format = value;
+	  handled = true;
+	}
+      }
       else if(param == "ignore_name") 
 	handled = m_filter_set.addIgnoreName(value);
       else if(param == "match_name") 
@@ -182,14 +193,13 @@ void SearchGrid::handleMailNodeReport(string str)
   double posx = record.getX();
   double posy = record.getY();
 
-  for(unsigned int ix=0; ix<m_grid.size(); ix++) {
-    bool contained = m_grid.ptIntersect(ix, posx, posy);
-    if(contained) {
-      m_map_deltas[ix] = m_map_deltas[ix] + 1;
-      m_grid.incVal(ix, 1);
-    }
+  // Cells computed directly from x,y rather than testing every cell
+  vector<unsigned int> ixs = m_grid.getCellIXs(posx, posy);
+  for(unsigned int i=0; i<ixs.size(); i++) {
+    unsigned int ix = ixs[i];
+    m_map_deltas[ix] = m_map_deltas[ix] + 1;
+    m_grid.incVal(ix, 1);
   }
-
 }
 
 //------------------------------------------------------------
@@ -219,12 +229,20 @@ void SearchGrid::postGridUpdates()
     double delta = p->second;
     update.addUpdate(ix, "x", delta);
   }
-  string msg = update.get_spec();
-
   m_map_deltas.clear();
   
   // By default m_grid_var_name="VIEW_GRID"
-  Notify(m_grid_var_name+"_DELTA", msg);
+  if(m_delta_format == "binary") {
+    vector<unsigned char> data = update.getBinary();
+    Notify(m_grid_var_name+"_DELTA", data);
+    m_delta_bytes_posted += data.size();
+  }
+  else {
+    string msg = update.get_spec();
+    Notify(m_grid_var_name+"_DELTA", msg);
+    m_delta_bytes_posted += msg.length();
+  }
+  m_delta_msgs_posted++;
 }
 
 //------------------------------------------------------------
@@ -285,6 +303,11 @@ bool SearchGrid::buildReport()
       cell_min_limit << cell_max_limit;
   }
   m_msgs << actab.getFormattedString();
+  m_msgs << endl << endl;
+
+  m_msgs << "Delta Format: " << m_delta_format << endl;
+  m_msgs << "Deltas Sent:  " << m_delta_msgs_posted << " (";
+  m_msgs << m_delta_bytes_posted << " bytes)" << endl;
 
   return(true);
 }
@@ -49,6 +49,7 @@ class SearchGrid : public AppCastingMOOSApp
   
 protected: // Config vars
   bool        m_report_deltas;
+  std::string m_delta_format;
   std::string m_grid_label;
   std::string m_grid_var_name;
 
@@ -60,6 +61,9 @@ protected: // State vars
 
   std::map<unsigned int, double> m_map_deltas;
 
+  unsigned int m_delta_msgs_posted;
+  unsigned int m_delta_bytes_posted;
+
 };
 
 #endif 
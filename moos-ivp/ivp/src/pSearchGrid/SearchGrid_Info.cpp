@@ -89,6 +89,7 @@ void showExampleConfigAndExit()
   blk("  CommsTick = 4                                                 ");
   blk("                                                                ");
   blk("  report_deltas = true         // default                       ");
+  blk("  delta_format  = text         // default (text or binary)      ");
   blk("  grid_var_name = VIEW_GRID    // default                       ");
   blk("  grid_label    = psg          // default                       ");
   blk("  match_name    = abe                                           ");
@@ -134,6 +135,9 @@ void showInterfaceAndExit()
   blk("              cell_size=5, cell_vars=x:0:y:0:z:0,cell_min=x:0,  ");
   blk("              cell_max=x:50,cell=211:x:50, cell=212:x:50,       ");
   blk("              cell=237:x:50,cell=238:x:50,label=psg             ");
+  blk("  VIEW_GRID_DELTA = psg@211,x,1:212,x,1                         ");
+  blk("                    (binary run-length form if delta_format=    ");
+  blk("                    binary. See XYGridUpdate.h)                 ");
   blk("                                                                ");
   exit(0);
 }
@@ -25,6 +25,7 @@
 #include <iostream>
 #include <cstdlib>
 #include <cmath>
+#include <algorithm>
 #include "MBUtils.h"
 #include "AngleUtils.h"
 #include "CPAMonitor.h"
@@ -41,6 +42,7 @@ CPAMonitor::CPAMonitor()
   m_report_range = 50;      // meters
   m_swing_range  = 1;       // meters
   m_verbose      = false;
+  m_broad_phase  = true;
 
   m_closest_range = -1;
   m_closest_range_ever = -1;
@@ -205,6 +207,9 @@ bool CPAMonitor::examineAndReport()
 {
   m_closest_range = -1;
 
+  if(m_broad_phase && (m_ignore_range > 0))
+    return(examineAndReportGrid());
+  
   map<string, bool>::iterator p;
   for(p=m_map_updated.begin(); p!=m_map_updated.end(); p++) {
     string vname = p->first;
@@ -216,6 +221,151 @@ bool CPAMonitor::examineAndReport()
   return(true);
 }
 
+//---------------------------------------------------------
+// Procedure: examineAndReportGrid()
+//   Purpose: Same result as the all-pairs examineAndReport(), but
+//            vehicles are first binned into a uniform grid with
+//            cells the size of the ignore range. Only pairs in the
+//            same or adjacent cells can be within the ignore range,
+//            so only these, plus pairs still holding range state
+//            from an earlier round, get the detailed pair check.
+//      Note: Pairs are examined in the same order, and with the
+//            same vname/contact roles, as the all-pairs version,
+//            so events are posted identically.
+
+bool CPAMonitor::examineAndReportGrid()
+{
+  // Part 1: Snapshot positions, in the same (name) order as the
+  //         m_map_updated map, of all vehicles in the ledger
+  vector<string> vnames;
+  vector<double> vx, vy;
+  vector<bool>   updated;
+  map<string, unsigned int> vindex;
+  
+  map<string, bool>::iterator p;
+  for(p=m_map_updated.begin(); p!=m_map_updated.end(); p++) {
+    string vname = p->first;
+    if(!m_ledger.hasVName(vname))
+      continue;
+    double x = m_ledger.getX(vname);
+    double y = m_ledger.getY(vname);
+    // Positions off the grid, fall back to checking all pairs
+    if(!std::isfinite(x) || !std::isfinite(y) ||
+       (fabs(x/m_ignore_range) > 1e15) || (fabs(y/m_ignore_range) > 1e15)) {
+      m_broad_phase = false;
+      examineAndReport();
+      m_broad_phase = true;
+      return(true);
+    }
+    vindex[vname] = vnames.size();
+    vnames.push_back(vname);
+    vx.push_back(x);
+    vy.push_back(y);
+    updated.push_back(p->second);
+  }
+
+  // Part 2: Bin each vehicle into a grid cell
+  map<pair<long,long>, vector<unsigned int> > grid;
+  vector<pair<long,long> > cells;
+  for(unsigned int i=0; i<vnames.size(); i++) {
+    long cx = (long)(floor(vx[i] / m_ignore_range));
+    long cy = (long)(floor(vy[i] / m_ignore_range));
+    cells.push_back(make_pair(cx, cy));
+    grid[cells[i]].push_back(i);
+  }
+  
+  // Part 3: For each updated vehicle, examine candidate contacts in
+  //         the 3x3 neighborhood and those with ongoing pair state
+  for(unsigned int i=0; i<vnames.size(); i++) {
+    if(!updated[i])
+      continue;
+
+    vector<unsigned int> candidates;
+    for(long dx=-1; dx<=1; dx++) {
+      for(long dy=-1; dy<=1; dy++) {
+	pair<long,long> cell(cells[i].first+dx, cells[i].second+dy);
+	map<pair<long,long>, vector<unsigned int> >::iterator q;
+	q = grid.find(cell);
+	if(q != grid.end())
+	  candidates.insert(candidates.end(), q->second.begin(),
+			    q->second.end());
+      }
+    }
+    const set<string>& active = m_map_active_contacts[vnames[i]];
+    set<string>::const_iterator r;
+    for(r=active.begin(); r!=active.end(); r++) {
+      map<string, unsigned int>::iterator q = vindex.find(*r);
+      if(q != vindex.end())
+	candidates.push_back(q->second);
+    }
+
+    sort(candidates.begin(), candidates.end());
+    candidates.erase(unique(candidates.begin(), candidates.end()),
+		     candidates.end());
+
+    for(unsigned int k=0; k<candidates.size(); k++) {
+      unsigned int j = candidates[k];
+      if(j != i)
+	examineAndReport(vnames[i], vnames[j]);
+    }
+  }
+
+  // Part 4: The closest range is over all pairs, not just those in
+  //         range. If no pair was found within the ignore range,
+  //         search outward ring by ring until no closer pair is
+  //         possible.
+  if((m_closest_range >= 0) && (m_closest_range <= m_ignore_range))
+    return(true);
+
+  long min_cx=0, max_cx=0, min_cy=0, max_cy=0;
+  for(unsigned int i=0; i<cells.size(); i++) {
+    if((i==0) || (cells[i].first  < min_cx)) min_cx = cells[i].first;
+    if((i==0) || (cells[i].first  > max_cx)) max_cx = cells[i].first;
+    if((i==0) || (cells[i].second < min_cy)) min_cy = cells[i].second;
+    if((i==0) || (cells[i].second > max_cy)) max_cy = cells[i].second;
+  }
+  long max_ring = max(max_cx - min_cx, max_cy - min_cy);
+
+  double best = m_closest_range;
+  for(unsigned int i=0; i<vnames.size(); i++) {
+    if(!updated[i])
+      continue;
+    bool i_ignored = vectorContains(m_ignore_groups,
+				    m_ledger.getGroup(vnames[i]));
+    for(long ring=2; ring<=max_ring; ring++) {
+      // Every vehicle in this ring is at least this far away
+      if((best >= 0) && (((ring-1) * m_ignore_range) >= best))
+	break;
+      for(long dx=-ring; dx<=ring; dx++) {
+	for(long dy=-ring; dy<=ring; dy++) {
+	  if((labs(dx) != ring) && (labs(dy) != ring))
+	    continue;
+	  pair<long,long> cell(cells[i].first+dx, cells[i].second+dy);
+	  map<pair<long,long>, vector<unsigned int> >::iterator q;
+	  q = grid.find(cell);
+	  if(q == grid.end())
+	    continue;
+	  for(unsigned int k=0; k<q->second.size(); k++) {
+	    unsigned int j = q->second[k];
+	    if(i_ignored && vectorContains(m_ignore_groups,
+					   m_ledger.getGroup(vnames[j])))
+	      continue;
+	    double dist = hypot(vx[i]-vx[j], vy[i]-vy[j]);
+	    if((best < 0) || (dist < best))
+	      best = dist;
+	  }
+	}
+      }
+    }
+  }
+
+  m_closest_range = best;
+  if((best >= 0) && ((m_closest_range_ever < 0) || (best < m_closest_range_ever)))
+    m_closest_range_ever = best;
+
+  return(true);
+}
+
 //---------------------------------------------------------
 // Procedure: examineAndReport(vname)
 
@@ -340,6 +490,8 @@ bool CPAMonitor::updatePairRangeAndRate(string vname, string contact)
   // then remove all data for this tag and return.
   if(dist > m_ignore_range) {
     m_map_pair_dist.erase(tag);
+    m_map_active_contacts[vname].erase(contact);
+    m_map_active_contacts[contact].erase(vname);
     m_map_pair_closing[tag] = false;
     m_map_pair_valid[tag] = false;
     m_map_pair_midx[tag] = 0;
@@ -347,6 +499,13 @@ bool CPAMonitor::updatePairRangeAndRate(string vname, string contact)
     return(true);
   }
   
+  // The pair now holds range state, so the broad phase must keep
+  // examining it until it is beyond the ignore range again. This is
+  // done here, not just for a first distance, since the caller has
+  // already made the pair dist entry by the time we get here.
+  m_map_active_contacts[vname].insert(contact);
+  m_map_active_contacts[contact].insert(vname);
+
   // Handle case where this is the first distance noted for this pair
   if(m_map_pair_dist.count(tag) == 0) {
     m_map_pair_dist[tag] = dist;
@@ -26,7 +26,9 @@
 
 #include <string>
 #include <map>
+#include <set>
 #include <list>
+#include <vector>
 #include "ContactLedger.h"
 #include "MOOS/libMOOSGeodesy/MOOSGeodesy.h"
 #include "CPAEvent.h"
@@ -47,6 +49,7 @@ class CPAMonitor
   void setReportRange(double);
   void setSwingRange(double);
   void setVerbose(bool bval=true)   {m_verbose = bval;}
+  void setBroadPhase(bool bval=true) {m_broad_phase = bval;}
   void resetClosestRangeEver()      {m_closest_range_ever=-1;}
   
   void setIteration(unsigned int v) {m_iteration = v;}
@@ -76,6 +79,7 @@ class CPAMonitor
 
   bool   examineAndReport(std::string);
   bool   examineAndReport(std::string, std::string);
+  bool   examineAndReportGrid();
   bool   updatePairRangeAndRate(std::string, std::string); 
 
   double relBng(std::string vname1, std::string vname2);
@@ -85,6 +89,7 @@ class CPAMonitor
   double  m_report_range;
   double  m_swing_range;
   bool    m_verbose;
+  bool    m_broad_phase;
 
   // ignore encounters where both vehicles are in an ignore group 
   std::vector<std::string>  m_ignore_groups; 
@@ -106,6 +111,9 @@ class CPAMonitor
   std::map<std::string, bool>   m_map_pair_closing;
   std::map<std::string, bool>   m_map_pair_valid;
   std::map<std::string, bool>   m_map_pair_examined;
+
+ protected: // map keyed on vname, contacts with a pair dist entry
+  std::map<std::string, std::set<std::string> > m_map_active_contacts;
   
  protected: // Indexed on event (cpa occurrence)
   std::vector<CPAEvent>  m_events;
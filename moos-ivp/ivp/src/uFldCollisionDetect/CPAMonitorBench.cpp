@@ -0,0 +1,212 @@
+/*****************************************************************/
+/*    NAME: agent                                                */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: CPAMonitorBench.cpp                                  */
+/*    DATE: Oct 19th, 2026                                       */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+// Scaling benchmark for the CPAMonitor broad phase. A swarm of N
+// vehicles random-walks in a square sized for a fixed density. Each
+// step every vehicle sends a node report to two monitors, one with
+// the broad phase grid and one checking all pairs. The per-step
+// events and closest ranges of the two must match exactly.
+//
+//   cpamon_bench                   (sweep 25 to 300 vehicles)
+//   cpamon_bench --vehicles=300 --steps=500 --spacing=40
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <cmath>
+#include "MBUtils.h"
+#include "MBTimer.h"
+#include "AngleUtils.h"
+#include "ACTable.h"
+#include "CPAMonitor.h"
+
+using namespace std;
+
+//--------------------------------------------------------
+// Procedure: eventString()
+
+string eventString(const CPAEvent& event)
+{
+  string str = event.getVName1() + "," + event.getVName2();
+  str += "," + doubleToString(event.getCPA(), 9);
+  str += "," + doubleToString(event.getX(), 9);
+  str += "," + doubleToString(event.getY(), 9);
+  str += "," + doubleToString(event.getAlpha(), 9);
+  str += "," + doubleToString(event.getBeta(), 9);
+  return(str);
+}
+
+//--------------------------------------------------------
+// Procedure: runTrial()
+//   Returns: false if the two monitors ever disagree
+
+bool runTrial(unsigned int vehicles, unsigned int steps, double spacing,
+	      double& brute_secs, double& grid_secs, unsigned int& events)
+{
+  double side = spacing * sqrt((double)(vehicles));
+  srand(vehicles);
+
+  vector<double> x, y, hdg, spd;
+  for(unsigned int i=0; i<vehicles; i++) {
+    x.push_back(side * (double)(rand()) / RAND_MAX);
+    y.push_back(side * (double)(rand()) / RAND_MAX);
+    hdg.push_back(360.0 * (double)(rand()) / RAND_MAX);
+    spd.push_back(1 + 2 * (double)(rand()) / RAND_MAX);
+  }
+
+  CPAMonitor brute, grid;
+  brute.setBroadPhase(false);
+  grid.setBroadPhase(true);
+  brute.setReportRange(10);
+  brute.setIgnoreRange(15);
+  grid.setReportRange(10);
+  grid.setIgnoreRange(15);
+
+  MBTimer brute_timer, grid_timer;
+  events = 0;
+  bool match = true;
+  for(unsigned int k=0; k<steps; k++) {
+    double utc = 1000 + k;
+    vector<string> reports;
+    for(unsigned int i=0; i<vehicles; i++) {
+      if((rand() % 20) == 0)
+	hdg[i] = angle360(hdg[i] + 90 - (rand() % 180));
+      double rads = (90 - hdg[i]) * M_PI / 180.0;
+      x[i] += spd[i] * cos(rads);
+      y[i] += spd[i] * sin(rads);
+      if((x[i] < 0) || (x[i] > side) || (y[i] < 0) || (y[i] > side))
+	hdg[i] = angle360(hdg[i] + 180);
+
+      string report = "NAME=v" + uintToString(i);
+      report += ",X=" + doubleToString(x[i], 3);
+      report += ",Y=" + doubleToString(y[i], 3);
+      report += ",LAT=0,LON=0";
+      report += ",SPD=" + doubleToString(spd[i], 2);
+      report += ",HDG=" + doubleToString(hdg[i], 2);
+      report += ",TIME=" + doubleToString(utc, 2);
+      reports.push_back(report);
+    }
+
+    string whynot;
+    brute_timer.start();
+    for(unsigned int i=0; i<reports.size(); i++)
+      brute.handleNodeReport(reports[i], whynot);
+    brute.examineAndReport();
+    brute_timer.stop();
+
+    grid_timer.start();
+    for(unsigned int i=0; i<reports.size(); i++)
+      grid.handleNodeReport(reports[i], whynot);
+    grid.examineAndReport();
+    grid_timer.stop();
+
+    if(brute.getClosestRange() != grid.getClosestRange())
+      match = false;
+    if(brute.getEventCount() != grid.getEventCount())
+      match = false;
+    for(unsigned int j=0; match && (j<brute.getEventCount()); j++) {
+      if(eventString(brute.getEvent(j)) != eventString(grid.getEvent(j)))
+	match = false;
+    }
+    events += brute.getEventCount();
+    
+    if(!match) {
+      cout << "Mismatch at step " << k << ": closest range ";
+      cout << brute.getClosestRange() << " vs " << grid.getClosestRange();
+      cout << ", events " << brute.getEventCount() << " vs ";
+      cout << grid.getEventCount() << endl;
+      break;
+    }
+    brute.clear();
+    grid.clear();
+  }
+  if(brute.getClosestRangeEver() != grid.getClosestRangeEver())
+    match = false;
+
+  brute_secs = brute_timer.get_float_wall_time();
+  grid_secs  = grid_timer.get_float_wall_time();
+  return(match);
+}
+
+//--------------------------------------------------------
+// Procedure: main
+
+int main(int argc, char *argv[])
+{
+  vector<unsigned int> sizes;
+  unsigned int steps = 200;
+  double spacing = 40;
+
+  for(int i=1; i<argc; i++) {
+    string argi = argv[i];
+    if(strBegins(argi, "--vehicles="))
+      sizes.push_back(atoi(argi.substr(11).c_str()));
+    else if(strBegins(argi, "--steps="))
+      steps = atoi(argi.substr(8).c_str());
+    else if(strBegins(argi, "--spacing="))
+      spacing = atof(argi.substr(10).c_str());
+    else {
+      cout << "Usage: cpamon_bench [--vehicles=N] [--steps=N] ";
+      cout << "[--spacing=meters]" << endl;
+      return(1);
+    }
+  }
+  if(sizes.size() == 0) {
+    unsigned int sweep[] = {25, 50, 100, 200, 300};
+    sizes.assign(sweep, sweep+5);
+  }
+  
+  ACTable actab(6,2);
+  actab << "Vehicles | Steps | Events | All Pairs (ms/step) | Grid (ms/step) | Speedup";
+  actab.addHeaderLines();
+
+  bool all_match = true;
+  for(unsigned int i=0; i<sizes.size(); i++) {
+    double brute_secs = 0;
+    double grid_secs  = 0;
+    unsigned int events = 0;
+    bool match = runTrial(sizes[i], steps, spacing,
+			  brute_secs, grid_secs, events);
+    all_match = all_match && match;
+
+    double speedup = 0;
+    if(grid_secs > 0)
+      speedup = brute_secs / grid_secs;
+    actab << sizes[i] << steps << events;
+    actab << doubleToString(1000 * brute_secs / steps, 3);
+    actab << doubleToString(1000 * grid_secs / steps, 3);
+    actab << doubleToString(speedup, 1) + (match ? "" : " MISMATCH");
+  }
+
+  vector<string> lines = actab.getTableOutput();
+  for(unsigned int i=0; i<lines.size(); i++)
+    cout << lines[i] << endl;
+
+  if(!all_match) {
+    cout << "Grid and all-pairs results differ" << endl;
+    return(1);
+  }
+  cout << "Grid and all-pairs results identical" << endl;
+  return(0);
+}
@@ -352,6 +352,11 @@ bool CollisionDetector::OnStartUp()
       handled = setBooleanOnString(m_post_closest_range_ever, value);
     else if(param == "report_all_encounters") 
       handled = setBooleanOnString(m_report_all_encounters, value);
+    else if(param == "broad_phase") {
+      bool broad_phase = true;
+      handled = setBooleanOnString(broad_phase, value);
+      m_cpa_monitor.setBroadPhase(broad_phase);
+    }
     else if(param == "ignore_group") 
       handled = m_cpa_monitor.addIgnoreGroup(value);
     else if(param == "reject_group") 
@@ -124,6 +124,8 @@ void showExampleConfigAndExit()
   blk("                                                                ");
   blk("  report_all_encounters = true  // default is false             ");
   blk("                                                                ");
+  blk("  broad_phase = true            // default is true              ");
+  blk("                                                                ");
   blk("  app_logging = true  // {true or file} By default disabled     ");
   blk("}                                                               ");  
 
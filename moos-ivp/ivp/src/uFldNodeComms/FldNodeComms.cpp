@@ -25,6 +25,7 @@
 #include <set>
 #include <iterator>
 #include "FldNodeComms.h"
+#include "MOOS/libMOOS/Comms/MsgTrace.h"
 #include "MBUtils.h"
 #include "NodeRecordUtils.h"
 #include "NodeMessageUtils.h"
@@ -109,7 +110,8 @@ bool FldNodeComms::OnNewMail(MOOSMSG_LIST &NewMail)
     string whynot;
 
     if((key == "NODE_REPORT") || (key == "NODE_REPORT_LOCAL")) 
-      handled = handleMailNodeReport(sval, whynot);
+      handled = handleMailNodeReport(sval, whynot,
+				     MOOS::MsgTrace::Instance().HeldTrace(msg));
     else if((key == "NODE_MESSAGE") || (key == "MEDIATED_MESSAGE"))
       handled = handleMailNodeMessage(sval, msrc);
     else if(key == "ACK_MESSAGE") 
@@ -192,6 +194,7 @@ bool FldNodeComms::Iterate()
   }
 
   m_map_newrecord.clear();
+  m_map_trace.clear();
 
   m_map_newmessage.clear();
   m_map_newackmessage.clear();
@@ -311,7 +314,8 @@ void FldNodeComms::registerVariables()
 //------------------------------------------------------------
 // Procedure: handleMailNodeReport()
 
-bool FldNodeComms::handleMailNodeReport(const string& str, string& whynot)
+bool FldNodeComms::handleMailNodeReport(const string& str, string& whynot,
+					const string& trace)
 {
   string vname = m_ledger.processNodeReport(str, whynot);
   if(whynot != "")
@@ -319,6 +323,11 @@ bool FldNodeComms::handleMailNodeReport(const string& str, string& whynot)
 
   m_map_newrecord[vname] = true;
 
+  // If the report carries a message trace, keep it so the trace
+  // follows the report on to the receiving vehicles
+  if(trace != "")
+    m_map_trace[vname] = trace;
+
   return(true);
 }
 
@@ -566,7 +575,14 @@ void FldNodeComms::distributeNodeReportInfo(const string& us_vname)
 void FldNodeComms::postNodeReport(string us_vname, string vname,
 				  string node_report)
 {
-  Notify("NODE_REPORT_" + toupper(vname), node_report);
+  map<string, string>::iterator p = m_map_trace.find(us_vname);
+  if(p == m_map_trace.end())
+    Notify("NODE_REPORT_" + toupper(vname), node_report);
+  else {
+    string src_aux = p->second;
+    MOOS::MsgTrace::AddHop(src_aux, "fwd:" + GetAppName(), MOOSTime());
+    Notify("NODE_REPORT_" + toupper(vname), node_report, src_aux);
+  }
   if(m_view_node_rpt_pulses)
     postViewCommsPulse(us_vname, vname);
   m_total_reports_sent++;
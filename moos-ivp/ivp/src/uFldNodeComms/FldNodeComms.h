@@ -50,7 +50,8 @@ class FldNodeComms : public AppCastingMOOSApp
 
  protected:
   void registerVariables();
-  bool handleMailNodeReport(const std::string& str, std::string& whynot);
+  bool handleMailNodeReport(const std::string& str, std::string& whynot,
+			    const std::string& trace="");
   bool handleMailNodeMessage(const std::string& str, const std::string& src);
   bool handleMailAckMessage(const std::string& str);
   bool handleMailCommsRange(double);
@@ -130,6 +131,8 @@ protected:
   
   // True if last node report for vehicle vname has not been sent out
   std::map<std::string, bool>  m_map_newrecord;  
+  // Message trace (MSG_TRACE) carried by last node report, if sampled
+  std::map<std::string, std::string>  m_map_trace;
   // True if last node message for vehicle vname has not been sent out
   std::map<std::string, bool>  m_map_newmessage; 
   // True if last ack message for vehicle vname has not been sent out
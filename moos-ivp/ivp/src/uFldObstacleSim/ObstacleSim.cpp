@@ -30,6 +30,7 @@
 #include "ColorParse.h"
 #include "XYFormatUtilsPoly.h"
 #include "ObstacleFieldGenerator.h"
+#include "PointBatch.h"
 
 using namespace std;
 
@@ -60,6 +61,7 @@ ObstacleSim::ObstacleSim()
   m_post_points = false;
   m_rate_points = 5;
   m_point_size  = 2;
+  m_points_format = "single";
   
   m_min_duration = -1;
   m_max_duration = -1;
@@ -86,6 +88,9 @@ ObstacleSim::ObstacleSim()
   m_obstacles_posted = 0;
   m_obstacles_made   = 0;
 
+  m_point_msgs_posted  = 0;
+  m_point_bytes_posted = 0;
+
   m_sensor_range = 50;
 }
 
@@ -235,6 +240,8 @@ bool ObstacleSim::OnStartUp()
       handled = setNonNegDoubleOnString(m_rate_points, value);
     else if(param == "point_size")
       handled = setNonNegDoubleOnString(m_point_size, value);
+    else if(param == "points_format")
+      handled = handleConfigPointsFormat(value);
 
     else if(param == "sensor_range")
       handled = setNonNegDoubleOnString(m_sensor_range, value);
@@ -331,6 +338,19 @@ bool ObstacleSim::handleMailPointSize(string str)
   return(true);
 }
 
+//------------------------------------------------------------
+// Procedure: handleConfigPointsFormat()
+
+bool ObstacleSim::handleConfigPointsFormat(string str)
+{
+  str = tolower(stripBlankEnds(str));
+  if((str != "single") && (str != "batch") && (str != "binary"))
+    return(false);
+
+  m_points_format = str;
+  return(true);
+}
+
 //------------------------------------------------------------
 // Procedure: handleConfigMinDuration()
 
@@ -400,6 +420,7 @@ bool ObstacleSim::handleConfigObstacleFile(string filename)
       m_poly_region.set_label("obs_region");
       m_poly_region.set_color("edge", m_region_edge_color);
       m_poly_region.set_vertex_color(m_region_vert_color);
+      m_poly_region_ix.setPoly(m_poly_region);
     }
     else if(left == "min_range") {
       bool ok = setNonNegDoubleOnString(m_min_range, right);
@@ -431,6 +452,7 @@ bool ObstacleSim::handleConfigObstacleFile(string filename)
       poly.set_edge_size(m_poly_edge_size);
       poly.set_transparency(m_poly_transparency);
       m_obstacles.push_back(poly);
+      m_obstacle_ixs.push_back(XYPolyIndex(poly));
       m_durations.push_back(-1);
       m_obstacles_made++;
     }
@@ -489,9 +511,9 @@ void ObstacleSim::updateVRanges()
     double vx = m_ledger.getX(vname);
     double vy = m_ledger.getY(vname);
     
-    if(m_poly_region.is_convex()) {
-      if(!m_poly_region.contains(vx, vy)) {
-	double range = m_poly_region.dist_to_poly(vx, vy);
+    if(m_poly_region_ix.is_convex()) {
+      if(!m_poly_region_ix.contains(vx, vy)) {
+	double range = m_poly_region_ix.dist_to_poly(vx, vy);
 	m_map_vrange[vname] = range;
 	if((min_vrange < 0) || (range < min_vrange))
 	  min_vrange = range;
@@ -581,6 +603,11 @@ void ObstacleSim::updateObstaclesField()
     m_obstacles[i].set_edge_size(m_poly_edge_size);
     m_obstacles[i].set_transparency(m_poly_transparency);
   }
+
+  // Query indices are snapshots, so rebuild them for the new field
+  m_obstacle_ixs.clear();
+  for(unsigned int i=0; i<m_obstacles.size(); i++)
+    m_obstacle_ixs.push_back(XYPolyIndex(m_obstacles[i]));
   
   m_obs_refresh_needed = true;
   m_reset_pending = false;
@@ -668,11 +695,17 @@ void ObstacleSim::postObstaclesErase()
 
 //------------------------------------------------------------
 // Procedure: postPoints()
-//      Note: Points are published as:
+//      Note: Points are published (points_format=single) as:
 //            TRACKED_FEATURE = x=5,y=8,label=key,size=4,color=1
+//      Note: Or with points_format=batch, once per vehicle as:
+//            TRACKED_FEATURES = pts={5,8:6,9},label=key#pts=...
+//            and with points_format=binary the same batch is
+//            posted binary packed (see PointBatch).
 
 void ObstacleSim::postPoints()
 {
+  bool batched = (m_points_format != "single");
+
   vector<string> vnames = m_ledger.getVNames();
   for(unsigned int i=0; i<vnames.size(); i++) {
   
@@ -681,18 +714,26 @@ void ObstacleSim::postPoints()
     double osx    = m_ledger.getX(vname);
     double osy    = m_ledger.getY(vname);
     string vcolor = m_ledger.getColor(vname);
+
+    PointBatch batch;
     
     for(unsigned int i=0; i<m_obstacles.size(); i++) {
-      if(m_obstacles[i].dist_to_poly(osx,osy) <= m_sensor_range) {
+      if(m_obstacle_ixs[i].within_dist(osx, osy, m_sensor_range)) {
 	for(unsigned int j=0; j<m_rate_points; j++) {
 	  double x, y;
 	  bool ok = randPointOnPoly(osx, osy, m_obstacles[i], x, y);
 	  if(ok) {
 	    string key = m_obstacles[i].get_label();
-	    string msg = "x=" + doubleToStringX(x,2);
-	    msg += ",y=" + doubleToStringX(y,2);
-	    msg += ",key=" + key;
-	    Notify("TRACKED_FEATURE_"+uvname, msg);
+	    if(batched)
+	      batch.addPoint(x, y, key);
+	    else {
+	      string msg = "x=" + doubleToStringX(x,2);
+	      msg += ",y=" + doubleToStringX(y,2);
+	      msg += ",key=" + key;
+	      Notify("TRACKED_FEATURE_"+uvname, msg);
+	      m_point_msgs_posted++;
+	      m_point_bytes_posted += msg.length();
+	    }
 	    m_map_pts_published[key]++;
 
 	    int label_index = (int)(m_map_pts_published[key]) % 100;
@@ -711,6 +752,22 @@ void ObstacleSim::postPoints()
 	}
       }
     }
+
+    if(!batched || (batch.size() == 0))
+      continue;
+
+    string var = "TRACKED_FEATURES_" + uvname;
+    if(m_points_format == "binary") {
+      vector<unsigned char> data = batch.getBinary();
+      Notify(var, data);
+      m_point_bytes_posted += data.size();
+    }
+    else {
+      string msg = batch.getSpec();
+      Notify(var, msg);
+      m_point_bytes_posted += msg.length();
+    }
+    m_point_msgs_posted++;
   }
 
 #if 0
@@ -759,6 +816,7 @@ bool ObstacleSim::buildReport()
   m_msgs << "Config (Points)  " << endl;
   m_msgs << "  Post Points:   " << boolToString(m_post_points) << endl;
   m_msgs << "  Rate Points:   " << doubleToStringX(m_rate_points) << endl;
+  m_msgs << "  Points Format: " << m_points_format << endl;
   m_msgs << "Config (Duration)" << endl;
   m_msgs << "  Min Duration:  " << min_dur_str << endl;
   m_msgs << "  Max Duration:  " << max_dur_str << endl;
@@ -769,6 +827,9 @@ bool ObstacleSim::buildReport()
   m_msgs << "================================" << endl;
   m_msgs << "State (Obstacles)               " << endl;
   m_msgs << "  Obstacles Posted: " << uintToString(m_obstacles_posted) << endl;
+  m_msgs << "State (Points)                  " << endl;
+  m_msgs << "  Point Msgs Posted:  " << uintToString(m_point_msgs_posted) << endl;
+  m_msgs << "  Point Bytes Posted: " << uintToString(m_point_bytes_posted) << endl;
   m_msgs << "State (resetting)   " << endl;
   m_msgs << "  Min Poly Range: " << doubleToString(m_min_vrange_to_region,0) << endl;
   m_msgs << "  Reset Pending:  " << boolToString(m_reset_pending) << endl;
@@ -29,6 +29,7 @@
 #include <map>
 #include "MOOS/libMOOS/Thirdparty/AppCasting/AppCastingMOOSApp.h"
 #include "XYPolygon.h"
+#include "XYPolyIndex.h"
 #include "ContactLedger.h"
 #include "VarDataPair.h"
 
@@ -58,6 +59,7 @@ class ObstacleSim : public AppCastingMOOSApp
 
   bool handleMailNodeReport(std::string, std::string& whynot);
   bool handleMailPointSize(std::string);
+  bool handleConfigPointsFormat(std::string);
 
   void postObstaclesRefresh();
   void postObstaclesErase();
@@ -71,7 +73,8 @@ class ObstacleSim : public AppCastingMOOSApp
  private: // Configuration variables
 
   // Parameters if we're creating obstacles as we go
-  XYPolygon m_poly_region;
+  XYPolygon   m_poly_region;
+  XYPolyIndex m_poly_region_ix;
   double    m_min_range;
   double    m_min_poly_size;
   double    m_max_poly_size;
@@ -95,6 +98,7 @@ class ObstacleSim : public AppCastingMOOSApp
   bool    m_post_points;
   double  m_rate_points;
   double  m_point_size;
+  std::string m_points_format;  // single, batch or binary
   
   // Params for random durations
   double  m_min_duration;
@@ -114,8 +118,9 @@ class ObstacleSim : public AppCastingMOOSApp
 private: // State variables
 
   // Core list of obtacles
-  std::vector<XYPolygon> m_obstacles;
-  std::vector<double>    m_durations;
+  std::vector<XYPolygon>   m_obstacles;
+  std::vector<XYPolyIndex> m_obstacle_ixs;
+  std::vector<double>      m_durations;
 
   // Maps keyed on vnames. 
   std::map<std::string, double>      m_map_vrange;
@@ -139,6 +144,8 @@ private: // State variables
   double  m_obs_refresh_tstamp;
 
   unsigned int m_obstacles_made;  
+  unsigned int m_point_msgs_posted;
+  unsigned int m_point_bytes_posted;
   unsigned int m_obstacles_posted;
 };
 
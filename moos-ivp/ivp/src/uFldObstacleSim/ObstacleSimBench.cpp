@@ -0,0 +1,292 @@
+/*****************************************************************/
+/*    NAME: agent                                                */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: ObstacleSimBench.cpp                                 */
+/*    DATE: Oct 19th, 2026                                       */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+// Message rate benchmark for the simulated range sensor output. The
+// same sensor returns, from V vehicles among N obstacles, are posted
+// as one TRACKED_FEATURE per point (single), or one batch message per
+// vehicle per iteration as text (batch) or binary packed (binary).
+// Each is decoded as pObstacleMgr would, and the decoded points of
+// the batched formats are checked against the single format.
+//
+//   obsim_bench
+//   obsim_bench --vehicles=10 --obstacles=20 --rate=5 --steps=400
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <cmath>
+#include "MBUtils.h"
+#include "MBTimer.h"
+#include "ACTable.h"
+#include "GeomUtils.h"
+#include "XYFormatUtilsPoly.h"
+#include "PointBatch.h"
+
+using namespace std;
+
+//--------------------------------------------------------
+// Procedure: parseSingle()
+//      Note: Same parsing as ObstacleManager::customStringToPoint()
+
+XYPoint parseSingle(const string& str)
+{
+  string x_str, y_str, key;
+  vector<string> svector = parseString(str, ',');
+  for(unsigned int i=0; i<svector.size(); i++) {
+    string param = biteStringX(svector[i], '=');
+    string value = svector[i];
+    if(param == "x")
+      x_str = value;
+    else if(param == "y")
+      y_str = value;
+    else if((param == "key") || (param == "label"))
+      key = value;
+  }
+
+  XYPoint point(atof(x_str.c_str()), atof(y_str.c_str()));
+  point.set_msg(key);
+  return(point);
+}
+
+//--------------------------------------------------------
+// Procedure: samePoints()
+
+bool samePoints(vector<XYPoint> a, vector<XYPoint> b)
+{
+  if(a.size() != b.size())
+    return(false);
+  for(unsigned int i=0; i<a.size(); i++) {
+    if(a[i].get_msg() != b[i].get_msg())
+      return(false);
+    if((fabs(a[i].x() - b[i].x()) > 0.006) ||
+       (fabs(a[i].y() - b[i].y()) > 0.006))
+      return(false);
+  }
+  return(true);
+}
+
+//--------------------------------------------------------
+// Procedure: main
+
+int main(int argc, char *argv[])
+{
+  unsigned int vehicles  = 10;
+  unsigned int obstacles = 20;
+  unsigned int rate      = 5;
+  unsigned int steps     = 400;
+  double       apptick   = 4;
+  double       sensor_range = 50;
+
+  for(int i=1; i<argc; i++) {
+    string argi = argv[i];
+    if(strBegins(argi, "--vehicles="))
+      vehicles = atoi(argi.substr(11).c_str());
+    else if(strBegins(argi, "--obstacles="))
+      obstacles = atoi(argi.substr(12).c_str());
+    else if(strBegins(argi, "--rate="))
+      rate = atoi(argi.substr(7).c_str());
+    else if(strBegins(argi, "--steps="))
+      steps = atoi(argi.substr(8).c_str());
+    else if(strBegins(argi, "--range="))
+      sensor_range = atof(argi.substr(8).c_str());
+    else {
+      cout << "Usage: obsim_bench [--vehicles=N] [--obstacles=N] ";
+      cout << "[--rate=N] [--steps=N] [--range=meters]" << endl;
+      return(1);
+    }
+  }
+
+  // Part 1: Obstacles in a square region, vehicles wander among them
+  srand(1);
+  double side = 30 * sqrt((double)(obstacles)) + 50;
+  vector<XYPolygon> polys;
+  for(unsigned int i=0; i<obstacles; i++) {
+    string spec = "format=radial,x=" + doubleToString(side * rand() / RAND_MAX, 1);
+    spec += ",y=" + doubleToString(side * rand() / RAND_MAX, 1);
+    spec += ",radius=" + doubleToString(3 + 5.0 * rand() / RAND_MAX, 1);
+    spec += ",pts=6,label=ob_" + uintToString(i);
+    polys.push_back(string2Poly(spec));
+  }
+  vector<double> vx, vy;
+  for(unsigned int i=0; i<vehicles; i++) {
+    vx.push_back(side * rand() / RAND_MAX);
+    vy.push_back(side * rand() / RAND_MAX);
+  }
+
+  // Part 2: Generate all sensor returns up front, one set per
+  // vehicle per iteration, so only encoding/decoding is timed.
+  // MBTimer has millisecond resolution so time whole passes.
+  vector<vector<double> > px, py;
+  vector<vector<string> > pk;
+  unsigned int total_pts = 0;
+  for(unsigned int k=0; k<steps; k++) {
+    for(unsigned int v=0; v<vehicles; v++) {
+      vx[v] += (rand() % 3) - 1;
+      vy[v] += (rand() % 3) - 1;
+      vector<double> xs, ys;
+      vector<string> ks;
+      for(unsigned int i=0; i<polys.size(); i++) {
+	if(polys[i].dist_to_poly(vx[v], vy[v]) > sensor_range)
+	  continue;
+	for(unsigned int j=0; j<rate; j++) {
+	  double x, y;
+	  if(randPointOnPoly(vx[v], vy[v], polys[i], x, y)) {
+	    xs.push_back(x);
+	    ys.push_back(y);
+	    ks.push_back(polys[i].get_label());
+	  }
+	}
+      }
+      if(xs.size() == 0)
+	continue;
+      px.push_back(xs);
+      py.push_back(ys);
+      pk.push_back(ks);
+      total_pts += xs.size();
+    }
+  }
+  unsigned int sets = px.size();
+
+  const char* modes[] = {"single", "batch", "binary"};
+  unsigned int msgs[3]  = {0, 0, 0};
+  unsigned int bytes[3] = {0, 0, 0};
+  MBTimer enc_timer[3], dec_timer[3];
+
+  // Part 3a: One message per point
+  vector<vector<string> > singles(sets);
+  enc_timer[0].start();
+  for(unsigned int s=0; s<sets; s++) {
+    for(unsigned int j=0; j<px[s].size(); j++) {
+      string msg = "x=" + doubleToStringX(px[s][j],2);
+      msg += ",y=" + doubleToStringX(py[s][j],2);
+      msg += ",key=" + pk[s][j];
+      singles[s].push_back(msg);
+    }
+  }
+  enc_timer[0].stop();
+
+  vector<vector<XYPoint> > pts_single(sets);
+  dec_timer[0].start();
+  for(unsigned int s=0; s<sets; s++) {
+    for(unsigned int j=0; j<singles[s].size(); j++)
+      pts_single[s].push_back(parseSingle(singles[s][j]));
+  }
+  dec_timer[0].stop();
+
+  for(unsigned int s=0; s<sets; s++) {
+    msgs[0] += singles[s].size();
+    for(unsigned int j=0; j<singles[s].size(); j++)
+      bytes[0] += singles[s][j].length();
+  }
+
+  // Part 3b: One text batch per vehicle per iteration
+  vector<string> specs(sets);
+  enc_timer[1].start();
+  for(unsigned int s=0; s<sets; s++) {
+    PointBatch batch;
+    for(unsigned int j=0; j<px[s].size(); j++)
+      batch.addPoint(px[s][j], py[s][j], pk[s][j]);
+    specs[s] = batch.getSpec();
+  }
+  enc_timer[1].stop();
+
+  vector<vector<XYPoint> > pts_batch(sets);
+  dec_timer[1].start();
+  for(unsigned int s=0; s<sets; s++) {
+    PointBatch batch;
+    batch.setFromSpec(specs[s]);
+    pts_batch[s] = batch.getPoints();
+  }
+  dec_timer[1].stop();
+
+  for(unsigned int s=0; s<sets; s++) {
+    msgs[1]++;
+    bytes[1] += specs[s].length();
+  }
+
+  // Part 3c: One binary batch per vehicle per iteration
+  vector<vector<unsigned char> > datas(sets);
+  enc_timer[2].start();
+  for(unsigned int s=0; s<sets; s++) {
+    PointBatch batch;
+    for(unsigned int j=0; j<px[s].size(); j++)
+      batch.addPoint(px[s][j], py[s][j], pk[s][j]);
+    datas[s] = batch.getBinary();
+  }
+  enc_timer[2].stop();
+
+  vector<vector<XYPoint> > pts_binary(sets);
+  dec_timer[2].start();
+  for(unsigned int s=0; s<sets; s++) {
+    PointBatch batch;
+    batch.setFromBinary(datas[s].data(), datas[s].size());
+    pts_binary[s] = batch.getPoints();
+  }
+  dec_timer[2].stop();
+
+  for(unsigned int s=0; s<sets; s++) {
+    msgs[2]++;
+    bytes[2] += datas[s].size();
+  }
+
+  // Part 3d: Batches are grouped by key, so compare in that order
+  bool match = true;
+  for(unsigned int s=0; match && (s<sets); s++) {
+    PointBatch regroup;
+    for(unsigned int j=0; j<pts_single[s].size(); j++) {
+      XYPoint pt = pts_single[s][j];
+      regroup.addPoint(pt.x(), pt.y(), pt.get_msg());
+    }
+    vector<XYPoint> ref = regroup.getPoints();
+    if(!samePoints(ref, pts_batch[s]) || !samePoints(ref, pts_binary[s]))
+      match = false;
+  }
+
+  // Part 4: Report
+  double secs = steps / apptick;
+  cout << "Vehicles: " << vehicles << ", Obstacles: " << obstacles;
+  cout << ", Rate: " << rate << ", Steps: " << steps << " (";
+  cout << doubleToStringX(secs, 1) << " secs at AppTick=4)" << endl;
+  cout << "Points: " << total_pts << endl << endl;
+
+  ACTable actab(6,2);
+  actab << "Format | Msgs | Msgs/sec | Bytes/sec | Encode (us/pt) | Decode (us/pt)";
+  actab.addHeaderLines();
+  for(unsigned int i=0; i<3; i++) {
+    double npts = (total_pts > 0) ? total_pts : 1;
+    actab << modes[i] << msgs[i];
+    actab << doubleToString(msgs[i] / secs, 1);
+    actab << doubleToString(bytes[i] / secs, 0);
+    actab << doubleToString(1e6 * enc_timer[i].get_float_wall_time() / npts, 3);
+    actab << doubleToString(1e6 * dec_timer[i].get_float_wall_time() / npts, 3);
+  }
+  cout << actab.getFormattedString() << endl << endl;
+
+  if(!match) {
+    cout << "MISMATCH: batched points differ from single points" << endl;
+    return(1);
+  }
+  cout << "Batched points match single points." << endl;
+  return(0);
+}
@@ -109,6 +109,8 @@ void showExampleConfigAndExit()
   blk("  post_points      = true     (default is false)                ");
   blk("  rate_points      = 5        (default is 5)                    ");
   blk("  point_size       = 5        (default is 2)                    ");
+  blk("  points_format    = batch    (single, batch or binary)         ");
+  blk("                              (default is single)               ");
   blk("                                                                ");
   blk("  min_duration     = 10       (default is -1)                   ");
   blk("  max_duration     = 15       (default is -1)                   ");
@@ -152,7 +154,8 @@ void showInterfaceAndExit()
   blk("  VIEW_POLYGON                                                  ");
   blk("  KNOWN_OBSTACLE                                                ");
   blk("  GIVEN_OBSTACLE                                                ");
-  blk("  TRACKED_FEATURE                                               ");
+  blk("  TRACKED_FEATURE_<VNAME>   (points_format=single)              ");
+  blk("  TRACKED_FEATURES_<VNAME>  (points_format=batch or binary)     ");
   exit(0);
 }
 
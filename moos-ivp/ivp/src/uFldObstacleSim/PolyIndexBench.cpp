@@ -0,0 +1,212 @@
+/*****************************************************************/
+/*    NAME: agent                                                */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: PolyIndexBench.cpp                                   */
+/*    DATE: Oct 19th, 2026                                       */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+// Benchmark of XYPolyIndex against the plain XYPolygon queries over
+// obstacle fields of increasing size. Each vehicle position is tested
+// against every obstacle with contains(), dist_to_poly() and a sensor
+// range check, as uFldObstacleSim and pObstacleMgr do each iteration.
+// Answers from the index must match the polygon answers exactly. A
+// last row uses one large many-sided polygon where edge bins apply.
+//
+//   polyindex_bench
+//   polyindex_bench --vehicles=20 --steps=200 --range=50
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <cmath>
+#include "MBUtils.h"
+#include "MBTimer.h"
+#include "ACTable.h"
+#include "XYFormatUtilsPoly.h"
+#include "XYPolyIndex.h"
+
+using namespace std;
+
+//--------------------------------------------------------
+// Procedure: makeField()
+//   Purpose: Obstacles scattered over a square sized so the density
+//            is about the same regardless of the number of them.
+
+vector<XYPolygon> makeField(unsigned int amt, unsigned int pts, double& side)
+{
+  side = 30 * sqrt((double)(amt)) + 50;
+  vector<XYPolygon> polys;
+  for(unsigned int i=0; i<amt; i++) {
+    string spec = "format=radial,x=" + doubleToString(side * rand() / RAND_MAX, 1);
+    spec += ",y=" + doubleToString(side * rand() / RAND_MAX, 1);
+    spec += ",radius=" + doubleToString(3 + 5.0 * rand() / RAND_MAX, 1);
+    spec += ",pts=" + uintToString(pts) + ",label=ob_" + uintToString(i);
+    polys.push_back(string2Poly(spec));
+  }
+  return(polys);
+}
+
+//--------------------------------------------------------
+// Procedure: main
+
+int main(int argc, char *argv[])
+{
+  unsigned int vehicles = 20;
+  unsigned int steps    = 200;
+  double       range    = 50;
+
+  for(int i=1; i<argc; i++) {
+    string argi = argv[i];
+    if(strBegins(argi, "--vehicles="))
+      vehicles = atoi(argi.substr(11).c_str());
+    else if(strBegins(argi, "--steps="))
+      steps = atoi(argi.substr(8).c_str());
+    else if(strBegins(argi, "--range="))
+      range = atof(argi.substr(8).c_str());
+    else {
+      cout << "Usage: polyindex_bench [--vehicles=N] [--steps=N] ";
+      cout << "[--range=meters]" << endl;
+      return(1);
+    }
+  }
+
+  unsigned int field_sizes[] = {10, 50, 200, 1000, 1};
+  unsigned int field_verts[] = {8,  8,  12,  12,   400};
+  unsigned int cases = 5;
+
+  srand(1);
+  bool all_match = true;
+
+  ACTable actab(9,2);
+  actab << "Obstacles | Verts | Queries | Contains (ns) | Idx | Dist (ns) | Idx | In Range (ns) | Idx";
+  actab.addHeaderLines();
+
+  for(unsigned int c=0; c<cases; c++) {
+    double side = 0;
+    vector<XYPolygon> polys;
+    if(field_sizes[c] > 1)
+      polys = makeField(field_sizes[c], field_verts[c], side);
+    else {
+      side = 400;
+      string spec = "format=radial,x=200,y=200,radius=150,pts=";
+      spec += uintToString(field_verts[c]) + ",label=big";
+      polys.push_back(string2Poly(spec));
+    }
+    vector<XYPolyIndex> ixs;
+    for(unsigned int i=0; i<polys.size(); i++)
+      ixs.push_back(XYPolyIndex(polys[i]));
+
+    // Vehicle positions, some inside obstacles, most in between.
+    // MBTimer has millisecond resolution so ask for enough of them.
+    unsigned int qsize = steps * vehicles;
+    unsigned int edges = polys.size() * field_verts[c];
+    if(qsize * edges < 40000000)
+      qsize = 40000000 / edges;
+    vector<double> vx, vy;
+    for(unsigned int k=0; k<qsize; k++) {
+      vx.push_back(side * rand() / RAND_MAX);
+      vy.push_back(side * rand() / RAND_MAX);
+    }
+    double queries = (double)(qsize) * polys.size();
+
+    // Part 1: contains, plain and indexed
+    MBTimer tpc, tic;
+    unsigned int npc = 0, nic = 0;
+    tpc.start();
+    for(unsigned int k=0; k<qsize; k++)
+      for(unsigned int i=0; i<polys.size(); i++)
+	npc += polys[i].contains(vx[k], vy[k]);
+    tpc.stop();
+    tic.start();
+    for(unsigned int k=0; k<qsize; k++)
+      for(unsigned int i=0; i<ixs.size(); i++)
+	nic += ixs[i].contains(vx[k], vy[k]);
+    tic.stop();
+
+    // Part 2: dist_to_poly, plain and indexed
+    MBTimer tpd, tid;
+    vector<double> pdist(qsize * polys.size());
+    vector<double> idist(qsize * polys.size());
+    tpd.start();
+    for(unsigned int k=0; k<qsize; k++)
+      for(unsigned int i=0; i<polys.size(); i++)
+	pdist[k*polys.size()+i] = polys[i].dist_to_poly(vx[k], vy[k]);
+    tpd.stop();
+    tid.start();
+    for(unsigned int k=0; k<qsize; k++)
+      for(unsigned int i=0; i<ixs.size(); i++)
+	idist[k*ixs.size()+i] = ixs[i].dist_to_poly(vx[k], vy[k]);
+    tid.stop();
+
+    // Part 3: sensor range check, plain and indexed
+    MBTimer tpr, tir;
+    unsigned int npr = 0, nir = 0;
+    tpr.start();
+    for(unsigned int k=0; k<qsize; k++)
+      for(unsigned int i=0; i<polys.size(); i++)
+	npr += (polys[i].dist_to_poly(vx[k], vy[k]) <= range);
+    tpr.stop();
+    tir.start();
+    for(unsigned int k=0; k<qsize; k++)
+      for(unsigned int i=0; i<ixs.size(); i++)
+	nir += ixs[i].within_dist(vx[k], vy[k], range);
+    tir.stop();
+
+    // Part 4: Answers must agree point by point, batch API included
+    bool match = (npc == nic) && (npr == nir) && (pdist == idist);
+    for(unsigned int i=0; match && (i<polys.size()); i++) {
+      vector<bool>   bcon, brng;
+      vector<double> bdist;
+      ixs[i].contains(vx, vy, bcon);
+      ixs[i].dist_to_poly(vx, vy, bdist);
+      ixs[i].within_dist(vx, vy, range, brng);
+      for(unsigned int k=0; match && (k<qsize); k++) {
+	double pd = polys[i].dist_to_poly(vx[k], vy[k]);
+	if((bcon[k] != polys[i].contains(vx[k], vy[k])) ||
+	   (bdist[k] != pd) || (brng[k] != (pd <= range)))
+	  match = false;
+      }
+    }
+    if(!match) {
+      cout << "MISMATCH: obstacles=" << field_sizes[c] << endl;
+      all_match = false;
+    }
+
+    double ns = 1e9 / queries;
+    actab << field_sizes[c] << field_verts[c] << (unsigned int)(queries);
+    actab << doubleToString(ns * tpc.get_float_wall_time(), 1);
+    actab << doubleToString(ns * tic.get_float_wall_time(), 1);
+    actab << doubleToString(ns * tpd.get_float_wall_time(), 1);
+    actab << doubleToString(ns * tid.get_float_wall_time(), 1);
+    actab << doubleToString(ns * tpr.get_float_wall_time(), 1);
+    actab << doubleToString(ns * tir.get_float_wall_time(), 1);
+  }
+
+  cout << "Vehicles: " << vehicles << ", Steps: " << steps;
+  cout << ", Range: " << doubleToStringX(range, 1) << endl << endl;
+  cout << actab.getFormattedString() << endl << endl;
+
+  if(!all_match) {
+    cout << "MISMATCH: indexed answers differ from XYPolygon" << endl;
+    return(1);
+  }
+  cout << "Indexed answers match XYPolygon." << endl;
+  return(0);
+}
@@ -115,8 +115,12 @@ void FV_MOOSApp::process_demuxer_content()
     DemuxedResult result = m_demuxer.getDemuxedResult();
     while(!result.isEmpty()) {
       redraw_needed = true;
-      string ipf_str = result.getString();
       string community_src = result.getSource();
+      string ipf_str = m_ipf_coders[community_src].resolve(result.getString());
+      if(ipf_str == "") {
+	result = m_demuxer.getDemuxedResult();
+	continue;
+      }
 
       //cout << "FV_MOOSApp:process_demuxer_content():" << endl;
       //cout << "str:" << ipf_str << endl;
@@ -29,6 +29,7 @@
 #include "FV_Model.h"
 #include "FV_GUI.h"
 #include "Demuxer.h"
+#include "FunctionEncoderBin.h"
 
 class FV_MOOSApp : public CMOOSApp
 {
@@ -69,6 +70,9 @@ class FV_MOOSApp : public CMOOSApp
   /// which is the safest way to use FLTK.  
   Demuxer m_demuxer;
 
+  /// Delta coded IPFs are resolved per community, in arrival order.
+  std::map<std::string, IPFBinCoder> m_ipf_coders;
+
   /// Hold this lock whenever invoking a method on 'demuxer'.
   CMOOSLock m_demuxer_lock;
 };
@@ -26,6 +26,7 @@
 #include "HelmScope.h"
 #include "MBUtils.h"
 #include "HelmReportUtils.h"
+#include "HelmProfileUtils.h"
 #include "ColorParse.h"
 #include "ACTable.h"
 
@@ -133,6 +134,8 @@ bool HelmScope::OnNewMail(MOOSMSG_LIST &NewMail)
       addScopeVariables(sval); 
     else if(key == "IVPHELM_LIFE_EVENT") 
       m_life_event_history.addLifeEvent(sval);
+    else if(key == "IVPHELM_PROFILE") 
+      m_helm_profile = string2HelmProfile(sval);
     else if(key == "IVPHELM_STATE") 
       updateEngaged(sval);
     else if(key == "PHELMIVP_STATUS") 
@@ -191,6 +194,10 @@ bool HelmScope::Iterate()
     if(m_update_pending || !m_paused)
       printLifeEventHistory();
   }
+  else if(m_display_mode == "profile") {
+    if(m_update_pending || !m_paused)
+      printProfile();
+  }
   else if(m_display_mode == "normal") {
     if(m_update_pending || !m_paused)
       printReport();
@@ -310,6 +317,11 @@ void HelmScope::handleCommand(char c)
     m_display_mode = "warnings";
     m_update_pending = true;
     break;
+  case 'p':
+  case 'P':
+    m_display_mode = "profile";
+    m_update_pending = true;
+    break;
   case 'b':
   case 'B':
     m_concise_bhv_list = !m_concise_bhv_list;
@@ -456,6 +468,7 @@ void HelmScope::registerVariables()
   Register("IVPHELM_MODESET", 0);
   Register("IVPHELM_STATE", 0);
   Register("IVPHELM_LIFE_EVENT", 0);
+  Register("IVPHELM_PROFILE", 0);
   Register("PHELMIVP_STATUS", 0);
 }
 
@@ -579,6 +592,7 @@ void HelmScope::printHelp()
   printf("    w      Content Mode: Show behavior warnings             \n");
   printf("    l      Content Mode: Show life events                   \n");
   printf("    m      Content Mode: Show hierarchical mode structure   \n");
+  printf("    p      Content Mode: Show helm profile (profile=true)   \n");
   printf("                                                            \n");
   printf("Modifying the Content Format or Filtering:                  \n");
   printf("    b      Toggle Show Idle/Completed Behavior Details      \n");
@@ -861,6 +875,45 @@ void HelmScope::printWarnings()
   m_update_pending = false;
 }
 
+//------------------------------------------------------------
+// Procedure: printProfile()
+//      Note: IVPHELM_PROFILE is only posted by a helm configured
+//            with profile=true.
+
+void HelmScope::printProfile()
+{  
+  printf("\n\n\n\n\n\n\n\n\n\n\n\n\n\n\n");
+
+  string community;
+  community += termColor("reverseblue");
+  community += "(" + m_community + ")" + termColor();
+  printf("%s", community.c_str());
+
+  string refresh_mode;
+  if(m_paused) {
+    refresh_mode += termColor("reversered");
+    refresh_mode += "(PAUSED)" + termColor();
+  }
+  else {
+    refresh_mode += termColor("reversegreen");
+    refresh_mode += "(STREAMING)" + termColor();
+  }
+  printf("%s", refresh_mode.c_str());
+       
+  printf("===============   uHelmScope Report (Profile) ============== ");
+  printf("(%d)\n", m_iteration); 
+
+  if(m_helm_profile.getIteration() == 0)
+    printf(" No IVPHELM_PROFILE received. Is the helm profile=true? \n");
+  else {
+    vector<string> lines = helmProfileReport(m_helm_profile);
+    for(unsigned int i=0; i<lines.size(); i++)
+      printf("%s\n", lines[i].c_str());
+  }
+
+  m_update_pending = false;
+}
+
 
 
 
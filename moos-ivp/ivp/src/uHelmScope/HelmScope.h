@@ -32,6 +32,7 @@
 
 #include "MOOS/libMOOS/Thirdparty/AppCasting/AppCastingMOOSApp.h"
 #include "HelmReport.h"
+#include "HelmProfile.h"
 #include "StringTree.h"
 #include "LifeEventHistory.h"
 #include "ScopeEntry.h"
@@ -82,6 +83,7 @@ class HelmScope : public AppCastingMOOSApp
   void printDBReport();
   void printPostingReport();
   void printWarnings();
+  void printProfile();
  
   // An overloading of the CMOOSApp ConfigureComms function
   bool ConfigureComms();
@@ -101,6 +103,7 @@ class HelmScope : public AppCastingMOOSApp
   std::map<std::string, ScopeEntry> m_map_posts;
 
   HelmReport       m_helm_report;
+  HelmProfile      m_helm_profile;
   LifeEventHistory m_life_event_history;
 
   std::string  m_helm_engaged_primary;
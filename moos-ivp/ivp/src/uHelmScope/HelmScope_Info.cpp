@@ -154,6 +154,7 @@ void showInterfaceAndExit()
   blk("  IVPHELM_LIFE_EVENT = time=2.25, iter=1, bname=hsline,         ");
   blk("                       btype=BHV_HSLine, event=spawn,           ");
   blk("                       seed=helm_startup                        ");
+  blk("  IVPHELM_PROFILE    = iter=12,create=4.512,solve=1.203,...     ");
   blk("                                                                ");
   blk("PUBLICATIONS:                                                   ");
   blk("------------------------------------                            ");
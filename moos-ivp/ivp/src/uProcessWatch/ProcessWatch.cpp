@@ -84,6 +84,8 @@ bool ProcessWatch::OnNewMail(MOOSMSG_LIST &NewMail)
     }
     else if(strEnds(key, "_STATUS"))
       handleMailStatusUpdate(msg.GetString());    
+    else if(key == "APP_PERF")
+      handleMailAppPerf(msg.GetString());
     else if(key == "EXITED_NORMALLY")
       m_excused_list.push_back(msg.GetString());
     else
@@ -109,6 +111,7 @@ void ProcessWatch::registerVariables()
   AppCastingMOOSApp::RegisterVariables();
   Register("DB_CLIENTS", 0);
   Register("EXITED_NORMALLY", 0);
+  Register("APP_PERF", 0);
 }
 
 
@@ -323,6 +326,31 @@ bool ProcessWatch::buildReport()
   }
   m_msgs << actab.getFormattedString();
 
+  // Part 3: If any apps are publishing APP_PERF, show latencies (ms)
+  if(m_map_app_perf.size() == 0)
+    return(true);
+
+  ACTable petab(8,2);
+  petab.setColumnMaxWidth(0,30);
+  petab << "         | Iterate |        | OnNewMail |        | Mail Age |        |         ";
+  petab << "ProcName | p50     | p99    | p50       | p99    | p50      | p99    | Notifies";
+  petab.addHeaderLines();
+
+  map<string, string>::iterator q;
+  for(q=m_map_app_perf.begin(); q!=m_map_app_perf.end(); q++) {
+    string perf = q->second;
+    petab << q->first;
+    petab << tokStringParse(perf, "iter_p50", ',', '=');
+    petab << tokStringParse(perf, "iter_p99", ',', '=');
+    petab << tokStringParse(perf, "mail_p50", ',', '=');
+    petab << tokStringParse(perf, "mail_p99", ',', '=');
+    petab << tokStringParse(perf, "age_p50", ',', '=');
+    petab << tokStringParse(perf, "age_p99", ',', '=');
+    petab << tokStringParse(perf, "notifies", ',', '=');
+  }
+  m_msgs << endl << "App Performance (ms, from APP_PERF):" << endl;
+  m_msgs << petab.getFormattedString();
+
   return(true);
 }
 
@@ -403,6 +431,21 @@ void ProcessWatch::handleMailStatusUpdate(string status)
     m_map_max_cpuload[procname] = d_cpuload;
 }
 
+//------------------------------------------------------------
+// Procedure: handleMailAppPerf
+//   Example: app=pHelmIvP,win=5.0,iter_n=20,iter_p50=0.91,iter_p99=3.4,
+//            iter_max=3.4,mail_n=20,...,age_p99=12.2,notifies=140,msgs=80
+
+void ProcessWatch::handleMailAppPerf(string perf)
+{
+  string procname = tokStringParse(perf, "app", ',', '=');
+  if(procname == "") {
+    reportRunWarning("Unhandled APP_PERF update: Missing app name.");
+    return;
+  }
+  m_map_app_perf[procname] = perf;
+}
+
 //-----------------------------------------------------------------
 // Procedure: isAlive
 //   Purpose: Check the given process name against the current list
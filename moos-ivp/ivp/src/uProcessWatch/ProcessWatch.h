@@ -46,6 +46,7 @@ public:
 protected:
   void handleMailNewDBClients();
   void handleMailStatusUpdate(std::string);
+  void handleMailAppPerf(std::string);
 
   bool handleConfigWatchList(std::string);
   bool handleConfigWatchItem(std::string);
@@ -91,6 +92,9 @@ protected:
   std::map<std::string, double>       m_map_now_cpuload;
   std::map<std::string, double>       m_map_max_cpuload;
 
+  // Most recent APP_PERF latency summary, keyed on proc name
+  std::map<std::string, std::string>  m_map_app_perf;
+
   std::set<std::string> m_set_db_clients;
   std::set<std::string> m_set_watch_clients;
   std::set<std::string> m_set_antler_clients;
@@ -133,6 +133,10 @@ void showInterfaceAndExit()
   blk("  DB_CLIENTS  = uXMS_419,pMarineViewer,pHelmIvP,pMarinePID,     ");
   blk("                uSimMarine,uProcessWatch,pNodeReporter,pLogger, ");
   blk("                DBWebServer,                                    ");
+  blk("  APP_PERF    = app=pHelmIvP,win=5.0,iter_n=20,iter_p50=0.91,   ");
+  blk("                iter_p99=3.36,iter_max=3.36,mail_n=20,...,      ");
+  blk("                notifies=140,msgs=80                            ");
+  blk("                (Published by apps with APP_PERF_INTERVAL set)  ");
   blk("                                                                ");
   blk("PUBLICATIONS:                                                   ");
   blk("------------------------------------                            ");
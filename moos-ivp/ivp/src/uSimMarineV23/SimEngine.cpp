@@ -28,6 +28,15 @@
 
 using namespace std;
 
+//--------------------------------------------------------------------
+// Constructor()
+
+SimEngine::SimEngine()
+{
+  m_thrust_mode_reverse = false;
+  m_verbose = false;
+}
+
 //--------------------------------------------------------------------
 // Procedure: propagate
 
@@ -131,7 +140,6 @@ void SimEngine::propagateSpeed(NodeRecord& record, const ThrustMap& tmap,
 			       double rudder, double max_accel, 
 			       double max_decel)
 {
-  m_verbose = true;
   if(delta_time <= 0)
     return;
 
@@ -31,7 +31,7 @@
 class SimEngine
 {
 public:
-  SimEngine() {}
+  SimEngine();
   ~SimEngine() {}
 
 public:
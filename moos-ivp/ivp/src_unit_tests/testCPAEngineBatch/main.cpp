@@ -0,0 +1,180 @@
+/*****************************************************************/
+/*    NAME: agent                                                */
+/*    FILE: main.cpp (testCPAEngineBatch)                        */
+/*    DATE: Oct 19th, 2026                                       */
+/*****************************************************************/
+
+#include <iostream>
+#include <cstdlib>
+#include <vector>
+#include "MBUtils.h"
+#include "CPAEngine.h"
+#include "CPAEngineBatch.h"
+
+using namespace std;
+
+int cmdLineErr(string msg) {cout << msg << endl; return(1);}
+
+//--------------------------------------------------------
+// Procedure: sweep()
+//   Purpose: Random encounters of several contacts each, every
+//            contact compared to its own CPAEngine over the whole
+//            one-degree heading lattice and a range of speeds.
+//   Returns: The number of evaluations that differ
+
+unsigned int sweep(unsigned int cases, unsigned int& evals)
+{
+  vector<double> hdgs, spds;
+  for(unsigned int h=0; h<360; h++)
+    hdgs.push_back(h);
+  for(unsigned int s=0; s<=20; s++)
+    spds.push_back(s * 0.25);
+  double ostol = 60;
+
+  unsigned int diffs = 0;
+  for(unsigned int k=0; k<cases; k++) {
+    double osx = (rand() % 2001) - 1000;
+    double osy = (rand() % 2001) - 1000;
+    CPAEngineBatch batch(osy, osx);
+    vector<CPAEngine> engines;
+
+    unsigned int contacts = 1 + (rand() % 8);
+    for(unsigned int c=0; c<contacts; c++) {
+      double cnx = osx + (rand() % 401) - 200;
+      double cny = osy + (rand() % 401) - 200;
+      double cnh = (rand() % 3600) / 10.0;
+      double cnv = (rand() % 60) / 10.0;
+      batch.addContact(cny, cnx, cnh, cnv);
+      engines.push_back(CPAEngine(cny, cnx, cnh, cnv, osy, osx));
+    }
+
+    vector<double> cpas, min_cpas;
+    batch.evalCPALattice(hdgs, spds, ostol, cpas);
+    batch.evalMinCPALattice(hdgs, spds, ostol, min_cpas);
+
+    for(unsigned int h=0; h<hdgs.size(); h++) {
+      for(unsigned int s=0; s<spds.size(); s++) {
+	double min_cpa = -1;
+	for(unsigned int c=0; c<contacts; c++) {
+	  double osh = hdgs[h];
+	  double osv = spds[s];
+	  double cpa = engines[c].evalCPA(osh, osv, ostol);
+	  unsigned int ix = ((h * spds.size()) + s) * contacts + c;
+	  if((cpa != cpas[ix]) ||
+	     (cpa != batch.evalCPA(c, osh, osv, ostol)) ||
+	     (engines[c].evalTimeCPA(osh, osv, ostol) !=
+	      batch.evalTimeCPA(c, osh, osv, ostol)) ||
+	     (engines[c].evalROC(osh, osv) != batch.evalROC(c, osh, osv)))
+	    diffs++;
+	  if((min_cpa < 0) || (cpa < min_cpa))
+	    min_cpa = cpa;
+	  evals++;
+	}
+	if(min_cpa != min_cpas[(h * spds.size()) + s])
+	  diffs++;
+      }
+    }
+  }
+  return(diffs);
+}
+
+//--------------------------------------------------------
+// Procedure: main
+
+int main(int argc, char** argv) 
+{
+  double cnx = 0;   bool cnx_set=false;
+  double cny = 0;   bool cny_set=false;
+  double cnh = 0;   bool cnh_set=false;
+  double cnv = 0;   bool cnv_set=false;
+  double osx = 0;   bool osx_set=false;
+  double osy = 0;   bool osy_set=false;
+  double osh = 0;   bool osh_set=false;
+  double osv = 0;   bool osv_set=false;
+  double tol = 60;
+  int    cases = 0;
+  
+  for(int i=1; i<argc; i++) {
+    string argi = argv[i];
+    if(strBegins(argi, "cnx="))
+      cnx_set = setDoubleOnString(cnx, argi.substr(4));
+    else if(strBegins(argi, "cny="))
+      cny_set = setDoubleOnString(cny, argi.substr(4));
+    else if(strBegins(argi, "cnh="))
+      cnh_set = setDoubleOnString(cnh, argi.substr(4));
+    else if(strBegins(argi, "cnv="))
+      cnv_set = setDoubleOnString(cnv, argi.substr(4));
+    else if(strBegins(argi, "osx="))
+      osx_set = setDoubleOnString(osx, argi.substr(4));
+    else if(strBegins(argi, "osy="))
+      osy_set = setDoubleOnString(osy, argi.substr(4));
+    else if(strBegins(argi, "osh="))
+      osh_set = setDoubleOnString(osh, argi.substr(4));
+    else if(strBegins(argi, "osv="))
+      osv_set = setDoubleOnString(osv, argi.substr(4));
+    else if(strBegins(argi, "tol="))
+      setDoubleOnString(tol, argi.substr(4));
+    else if(strBegins(argi, "sweep="))
+      cases = atoi(argi.substr(6).c_str());
+    
+    else if((argi=="-h") || (argi=="--help")) {
+      cout << "testCPAEngineBatch: test CPAEngineBatch against CPAEngine" << endl;
+      cout << "Example:                                              " << endl;
+      cout << "$ testCPAEngineBatch cnx=0 cny=100 cnh=180 cnv=2 ";
+      cout << "osx=0 osy=0 osh=0 osv=2 tol=60  " << endl;
+      cout << "cpa=0,tcpa=25,roc=4,same=true" << endl;
+      cout << "$ testCPAEngineBatch sweep=50" << endl;
+      cout << "diffs=0" << endl;
+      return(0);
+    }
+    else if(strBegins(argi, "id="))
+      argi = "just ignore id fields";
+    else {
+      cout << "Error: arg[" << argi << "] Exiting." << endl;
+      return(1);
+    }  
+  }  
+
+  if(cases > 0) {
+    unsigned int evals = 0;
+    unsigned int diffs = sweep(cases, evals);
+    cout << "diffs=" << diffs;
+    return(0);
+  }
+     
+  if(!cnx_set || !cny_set)
+    return(cmdLineErr("cnx,cny is not set. Exiting."));
+  if(!cnh_set || !cnv_set)
+    return(cmdLineErr("cnh,cnv is not set. Exiting."));
+  if(!osx_set || !osy_set)
+    return(cmdLineErr("osx,osy is not set. Exiting."));
+  if(!osh_set || !osv_set)
+    return(cmdLineErr("osh,osv is not set. Exiting."));
+
+  CPAEngine engine(cny, cnx, cnh, cnv, osy, osx);
+  double cpa  = engine.evalCPA(osh, osv, tol);
+  double tcpa = engine.evalTimeCPA(osh, osv, tol);
+  double roc  = engine.evalROC(osh, osv);
+
+  // Put the contact second among others to exercise the batch
+  CPAEngineBatch batch(osy, osx);
+  batch.addContact(cny+50, cnx-50, cnh+90, cnv+1);
+  batch.addContact(cny, cnx, cnh, cnv);
+  batch.addContact(cny-50, cnx+50, cnh+180, cnv);
+
+  vector<double> cpas, rocs;
+  batch.evalCPA(osh, osv, tol, cpas);
+  batch.evalROC(osh, osv, rocs);
+
+  bool same = ((cpa == batch.evalCPA(1, osh, osv, tol)) &&
+	       (cpa == cpas[1]) &&
+	       (tcpa == batch.evalTimeCPA(1, osh, osv, tol)) &&
+	       (roc == batch.evalROC(1, osh, osv)) &&
+	       (roc == rocs[1]));
+
+  cout << "cpa=" << doubleToStringX(cpa,2);
+  cout << ",tcpa=" << doubleToStringX(tcpa,2);
+  cout << ",roc=" << doubleToStringX(roc,2);
+  cout << ",same=" << boolToString(same);
+  return(0);
+}
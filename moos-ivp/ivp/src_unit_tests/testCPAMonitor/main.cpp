@@ -0,0 +1,116 @@
+/*****************************************************************/
+/*    NAME: agent                                                */
+/*    FILE: main.cpp (testCPAMonitor)                            */
+/*    DATE: Oct 19th, 2026                                       */
+/*****************************************************************/
+
+#include <iostream>
+#include <cstdlib>
+#include <vector>
+#include "MBUtils.h"
+#include "CPAMonitor.h"
+
+using namespace std;
+
+int cmdLineErr(string msg) {cout << msg << endl; return(1);}
+
+//--------------------------------------------------------
+// Procedure: nodeReport()
+
+string nodeReport(string vname, double x, double y, double utc)
+{
+  string report = "NAME=" + vname;
+  report += ",X=" + doubleToString(x, 3);
+  report += ",Y=" + doubleToString(y, 3);
+  report += ",LAT=0,LON=0,SPD=1,HDG=0";
+  report += ",TIME=" + doubleToString(utc, 2);
+  return(report);
+}
+
+//--------------------------------------------------------
+// Procedure: main
+//   Purpose: Vehicle a holds still at (ax,ay) while vehicle b
+//            steps through the given x positions at y=by. The
+//            same reports go to a monitor with the broad phase
+//            grid and to one checking all pairs. The events of
+//            the grid monitor are counted, and same is true if
+//            the two monitors posted the same events each step.
+
+int main(int argc, char** argv)
+{
+  double ax = 0;
+  double ay = 0;
+  double by = 0;
+  double ignore_range = 15;
+  double report_range = 10;
+  vector<double> bxs;
+
+  for(int i=1; i<argc; i++) {
+    string argi = argv[i];
+    if(strBegins(argi, "ax="))
+      ax = atof(argi.substr(3).c_str());
+    else if(strBegins(argi, "ay="))
+      ay = atof(argi.substr(3).c_str());
+    else if(strBegins(argi, "by="))
+      by = atof(argi.substr(3).c_str());
+    else if(strBegins(argi, "ignore="))
+      ignore_range = atof(argi.substr(7).c_str());
+    else if(strBegins(argi, "report="))
+      report_range = atof(argi.substr(7).c_str());
+    else if(strBegins(argi, "bx=")) {
+      vector<string> svector = parseString(argi.substr(3), ',');
+      for(unsigned int j=0; j<svector.size(); j++) {
+	if(!isNumber(svector[j]))
+	  return(cmdLineErr("Bad bx value: " + svector[j]));
+	bxs.push_back(atof(svector[j].c_str()));
+      }
+    }
+
+    else if((argi=="-h") || (argi=="--help")) {
+      cout << "testCPAMonitor: grid and all-pairs monitors on one track" << endl;
+      cout << "Example:                                              " << endl;
+      cout << "$ testCPAMonitor ax=14.9 bx=29,27,22,31,26             " << endl;
+      cout << "events=0,same=true                                    " << endl;
+      return(0);
+    }
+    else if(strBegins(argi, "id="))
+      argi = "just ignore id fields";
+    else
+      return(cmdLineErr("Error: arg[" + argi + "] Exiting."));
+  }
+
+  CPAMonitor brute, grid;
+  brute.setBroadPhase(false);
+  grid.setBroadPhase(true);
+  brute.setIgnoreRange(ignore_range);
+  brute.setReportRange(report_range);
+  grid.setIgnoreRange(ignore_range);
+  grid.setReportRange(report_range);
+
+  unsigned int events = 0;
+  bool same = true;
+  for(unsigned int k=0; k<bxs.size(); k++) {
+    double utc = 1000 + k;
+    string whynot;
+    brute.handleNodeReport(nodeReport("a", ax, ay, utc), whynot);
+    brute.handleNodeReport(nodeReport("b", bxs[k], by, utc), whynot);
+    grid.handleNodeReport(nodeReport("a", ax, ay, utc), whynot);
+    grid.handleNodeReport(nodeReport("b", bxs[k], by, utc), whynot);
+    brute.examineAndReport();
+    grid.examineAndReport();
+
+    if(brute.getEventCount() != grid.getEventCount())
+      same = false;
+    for(unsigned int j=0; same && (j<grid.getEventCount()); j++) {
+      if(brute.getEvent(j).getCPA() != grid.getEvent(j).getCPA())
+	same = false;
+    }
+    events += grid.getEventCount();
+    brute.clear();
+    grid.clear();
+  }
+
+  cout << "events=" << events;
+  cout << ",same=" << boolToString(same);
+  return(0);
+}
@@ -0,0 +1,196 @@
+/*****************************************************************/
+/*    NAME: agent                                                */
+/*    FILE: main.cpp (testDubinsPath)                            */
+/*    DATE: Oct 19th, 2026                                       */
+/*****************************************************************/
+
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <memory>
+#include "MBUtils.h"
+#include "AngleUtils.h"
+#include "DubinsPath.h"
+#include "DubinsCache.h"
+#include "DubinsPathCache.h"
+
+using namespace std;
+
+int cmdLineErr(string msg) {cout << msg << endl; return(1);}
+
+//--------------------------------------------------------
+// Procedure: pathOK()
+//   Purpose: Check the geometry of a path: the turn starts at
+//            ownship and ends on the turn circle, the straight leg
+//            leaves on the end heading and reaches the goal. The
+//            seglist of the path starts at ownship, ends at the
+//            goal, keeps the turn on the circle, and is a little
+//            shorter than the path since the turn is cut in chords.
+
+bool pathOK(const DubinsPath& path, double osx, double osy,
+	    double rad, double gx, double gy)
+{
+  double tol = 1e-6 * (1 + rad);
+  double cx = path.getArcCX();
+  double cy = path.getArcCY();
+  double tx = path.getTanX();
+  double ty = path.getTanY();
+
+  if(!path.noTurn()) {
+    if(fabs(hypot(osx-cx, osy-cy) - rad) > tol)
+      return(false);
+    if(fabs(hypot(tx-cx, ty-cy) - rad) > tol)
+      return(false);
+  }
+  double ray_len = hypot(gx-tx, gy-ty);
+  if(fabs(ray_len - path.getRayLen()) > tol)
+    return(false);
+  if(ray_len > tol) {
+    double hdg_to_goal = relAng(tx, ty, gx, gy);
+    if(angleDiff(hdg_to_goal, path.getEndHdg()) > 1e-4)
+      return(false);
+  }
+
+  XYSegList segl = path.getSegList(5);
+  unsigned int vsize = segl.size();
+  if((segl.get_vx(0) != osx) || (segl.get_vy(0) != osy))
+    return(false);
+  if((segl.get_vx(vsize-1) != gx) || (segl.get_vy(vsize-1) != gy))
+    return(false);
+  if(!path.noTurn()) {
+    for(unsigned int i=1; i+1<vsize; i++) {
+      if(fabs(hypot(segl.get_vx(i)-cx, segl.get_vy(i)-cy) - rad) > tol)
+	return(false);
+    }
+  }
+  double segl_len = segl.length();
+  if((segl_len > path.getLength() + tol) ||
+     (segl_len < (0.999 * path.getLength()) - tol))
+    return(false);
+  return(true);
+}
+
+//--------------------------------------------------------
+// Procedure: sweep()
+//   Purpose: Random poses and goals. Each path has its geometry
+//            checked, and the turn fan from each pose must come
+//            back from the cache the same as one built directly.
+//   Returns: The number of bad paths and fans
+
+unsigned int sweep(unsigned int cases)
+{
+  DubinsPathCache cache;
+
+  unsigned int bad = 0;
+  for(unsigned int k=0; k<cases; k++) {
+    double osx = (rand() % 2001) - 1000;
+    double osy = (rand() % 2001) - 1000;
+    double osh = (rand() % 3600) / 10.0;
+    double rad = (rand() % 500) / 10.0;
+    double gx  = osx + (rand() % 401) - 200;
+    double gy  = osy + (rand() % 401) - 200;
+
+    DubinsPath path(osx, osy, osh, rad);
+    path.setGoal(gx, gy);
+    if(!pathOK(path, osx, osy, rad, gx, gy))
+      bad++;
+
+    DubinsCache own;
+    own.setParams(osx, osy, osh, rad + 1);
+    own.buildCache(36);
+
+    // Ask twice, to get both the miss and the hit
+    for(unsigned int i=0; i<2; i++) {
+      shared_ptr<const DubinsCache> fan;
+      fan = cache.getTurnFan(osx, osy, osh, rad + 1, 36);
+      if(!fan || (fan->size() != own.size()))
+	bad++;
+      for(unsigned int j=0; fan && (j<own.size()); j++) {
+	if((fan->getArcLenIX(j) != own.getArcLenIX(j)) ||
+	   (fan->getTurnHdgIX(j) != own.getTurnHdgIX(j)))
+	  bad++;
+      }
+    }
+  }
+  if(cache.getHits() != cases)
+    bad++;
+  return(bad);
+}
+
+//--------------------------------------------------------
+// Procedure: main
+
+int main(int argc, char** argv)
+{
+  double osx = 0;   bool osx_set=false;
+  double osy = 0;   bool osy_set=false;
+  double osh = 0;   bool osh_set=false;
+  double rad = 0;   bool rad_set=false;
+  double gx  = 0;   bool gx_set=false;
+  double gy  = 0;   bool gy_set=false;
+  int    cases = 0;
+
+  for(int i=1; i<argc; i++) {
+    string argi = argv[i];
+    if(strBegins(argi, "osx="))
+      osx_set = setDoubleOnString(osx, argi.substr(4));
+    else if(strBegins(argi, "osy="))
+      osy_set = setDoubleOnString(osy, argi.substr(4));
+    else if(strBegins(argi, "osh="))
+      osh_set = setDoubleOnString(osh, argi.substr(4));
+    else if(strBegins(argi, "rad="))
+      rad_set = setDoubleOnString(rad, argi.substr(4));
+    else if(strBegins(argi, "gx="))
+      gx_set = setDoubleOnString(gx, argi.substr(3));
+    else if(strBegins(argi, "gy="))
+      gy_set = setDoubleOnString(gy, argi.substr(3));
+    else if(strBegins(argi, "sweep="))
+      cases = atoi(argi.substr(6).c_str());
+
+    else if((argi=="-h") || (argi=="--help")) {
+      cout << "testDubinsPath: test DubinsPath and DubinsPathCache" << endl;
+      cout << "Example:                                              " << endl;
+      cout << "$ testDubinsPath osx=0 osy=0 osh=0 rad=10 gx=20 gy=0" << endl;
+      cout << "len=31.42,arc=31.42,turn=star,hdg=180,ok=true" << endl;
+      cout << "$ testDubinsPath sweep=500" << endl;
+      cout << "bad=0" << endl;
+      return(0);
+    }
+    else if(strBegins(argi, "id="))
+      argi = "just ignore id fields";
+    else {
+      cout << "Error: arg[" << argi << "] Exiting." << endl;
+      return(1);
+    }
+  }
+
+  if(cases > 0) {
+    cout << "bad=" << sweep(cases);
+    return(0);
+  }
+
+  if(!osx_set || !osy_set || !osh_set)
+    return(cmdLineErr("osx,osy,osh is not set. Exiting."));
+  if(!rad_set)
+    return(cmdLineErr("rad is not set. Exiting."));
+  if(!gx_set || !gy_set)
+    return(cmdLineErr("gx,gy is not set. Exiting."));
+
+  DubinsPath path(osx, osy, osh, rad);
+  path.setGoal(gx, gy);
+
+  string turn = "none";
+  if(path.starTurn())
+    turn = "star";
+  else if(path.portTurn())
+    turn = "port";
+
+  bool ok = pathOK(path, osx, osy, rad, gx, gy);
+
+  cout << "len=" << doubleToStringX(path.getLength(),2);
+  cout << ",arc=" << doubleToStringX(path.getArcLen(),2);
+  cout << ",turn=" << turn;
+  cout << ",hdg=" << doubleToStringX(path.getEndHdg(),2);
+  cout << ",ok=" << boolToString(ok);
+  return(0);
+}
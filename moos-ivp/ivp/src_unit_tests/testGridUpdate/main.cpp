@@ -0,0 +1,133 @@
+/*****************************************************************/
+/*    NAME: agent                                                */
+/*    FILE: main.cpp (testGridUpdate)                            */
+/*    DATE: Oct 19th, 2026                                       */
+/*****************************************************************/
+
+#include <iostream>
+#include <cstdlib>
+#include <vector>
+#include "MBUtils.h"
+#include "XYGridUpdate.h"
+
+using namespace std;
+
+int cmdLineErr(string msg) {cout << msg << endl; return(1);}
+
+//--------------------------------------------------------
+// Procedure: randomUpdate()
+//   Purpose: An update with runs of equal values on consecutive
+//            cells, as a grid sweep makes, mixed with scattered
+//            cells. Values have at most four decimals, the
+//            precision of both the text and binary forms.
+
+XYGridUpdate randomUpdate()
+{
+  XYGridUpdate update("psg");
+  int type = rand() % 3;
+  if(type == 1)
+    update.setUpdateTypeReplace();
+  else if(type == 2)
+    update.setUpdateTypeAverage();
+
+  const char* vars[] = {"", "depth", "temp"};
+  unsigned int ix = rand() % 50;
+  unsigned int runs = 1 + (rand() % 20);
+  for(unsigned int k=0; k<runs; k++) {
+    string var = vars[rand() % 3];
+    double val = (double)((rand() % 2000001) - 1000000) / 10000;
+    unsigned int count = 1 + (rand() % 8);
+    for(unsigned int j=0; j<count; j++)
+      update.addUpdate(ix++, var, val);
+    ix += rand() % 100;
+  }
+  return(update);
+}
+
+//--------------------------------------------------------
+// Procedure: main
+//   Purpose: Encode the given update to binary, optionally damage
+//            the bytes, and decode. Reports whether decoding was
+//            accepted and whether the decoded update has the same
+//            spec as the original. With sweep=N, N random updates
+//            are round tripped and every truncation of each must
+//            be rejected.
+
+int main(int argc, char** argv)
+{
+  string spec;
+  unsigned int trim  = 0;
+  unsigned int pad   = 0;
+  int          flip  = -1;
+  unsigned int sweep = 0;
+
+  for(int i=1; i<argc; i++) {
+    string argi = argv[i];
+    if(strBegins(argi, "update="))
+      spec = argi.substr(7);
+    else if(strBegins(argi, "trim="))
+      trim = atoi(argi.substr(5).c_str());
+    else if(strBegins(argi, "pad="))
+      pad = atoi(argi.substr(4).c_str());
+    else if(strBegins(argi, "flip="))
+      flip = atoi(argi.substr(5).c_str());
+    else if(strBegins(argi, "sweep="))
+      sweep = atoi(argi.substr(6).c_str());
+
+    else if((argi=="-h") || (argi=="--help")) {
+      cout << "testGridUpdate: binary grid update round trip      " << endl;
+      cout << "Example:                                           " << endl;
+      cout << "$ testGridUpdate update=psg@replace@3,depth,2:4,depth,2" << endl;
+      cout << "ok=true,same=true,size=2,bytes=23                  " << endl;
+      return(0);
+    }
+    else if(strBegins(argi, "id="))
+      argi = "just ignore id fields";
+    else
+      return(cmdLineErr("Error: arg[" + argi + "] Exiting."));
+  }
+
+  if(sweep > 0) {
+    srand(1);
+    unsigned int bad = 0;
+    unsigned int accepted = 0;
+    for(unsigned int k=0; k<sweep; k++) {
+      XYGridUpdate update = randomUpdate();
+      vector<unsigned char> buff = update.getBinary();
+      XYGridUpdate decoded;
+      if(!decoded.setFromBinary(&buff[0], buff.size()) ||
+	 (decoded.get_spec() != update.get_spec()))
+	bad++;
+      for(unsigned int len=0; len<buff.size(); len++) {
+	if(decoded.setFromBinary(&buff[0], len))
+	  accepted++;
+      }
+    }
+    cout << "bad=" << bad << ",short=" << accepted;
+    return(0);
+  }
+
+  XYGridUpdate update = stringToGridUpdate(spec);
+  if(!update.valid())
+    return(cmdLineErr("Bad update: " + spec));
+
+  vector<unsigned char> buff = update.getBinary();
+  unsigned int bytes = buff.size();
+  if((flip >= 0) && ((unsigned int)(flip) < buff.size()))
+    buff[flip] ^= 0xFF;
+  if(trim > buff.size())
+    trim = buff.size();
+  buff.resize(buff.size() - trim);
+  for(unsigned int i=0; i<pad; i++)
+    buff.push_back(0);
+
+  XYGridUpdate decoded;
+  bool ok = decoded.setFromBinary(buff.size() ? &buff[0] : 0, buff.size());
+  bool same = ok && (decoded.get_spec() == update.get_spec());
+
+  cout << "ok=" << boolToString(ok);
+  cout << ",same=" << boolToString(same);
+  cout << ",size=" << decoded.size();
+  cout << ",bytes=" << bytes;
+  return(0);
+}
@@ -0,0 +1,212 @@
+/*****************************************************************/
+/*    NAME: agent                                                */
+/*    FILE: main.cpp (testIPFEncoding)                           */
+/*    DATE: Oct 19th, 2026                                       */
+/*****************************************************************/
+
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include "MBUtils.h"
+#include "BuildUtils.h"
+#include "AOF_Gaussian.h"
+#include "OF_Reflector.h"
+#include "FunctionEncoder.h"
+#include "FunctionEncoderBin.h"
+
+using namespace std;
+
+//--------------------------------------------------------
+// Procedure: buildIPF()
+//   Purpose: A gaussian over a 2D x,y domain, with uniform pieces.
+
+IvPFunction *buildIPF(double xc, double yc, double sigma,
+		      unsigned int pcs, unsigned int iter)
+{
+  IvPDomain domain = stringToDomain("x,-50,50,101:y,-50,50,101");
+  AOF_Gaussian aof(domain);
+  aof.setParam("xcent", xc);
+  aof.setParam("ycent", yc);
+  aof.setParam("sigma", sigma);
+  aof.setParam("range", 100);
+
+  OF_Reflector reflector(&aof, 1);
+  reflector.create(pcs);
+  IvPFunction *ipf = reflector.extractIvPFunction();
+  if(ipf) {
+    ipf->setPWT(100);
+    ipf->setContextStr(uintToString(iter) + ":gauss_bhv");
+  }
+  return(ipf);
+}
+
+//--------------------------------------------------------
+// Procedure: sameIPF()
+//   Purpose: True if two functions have the same boxes, and the
+//            weights and priority agree within the given tolerance.
+
+bool sameIPF(IvPFunction *a, IvPFunction *b, double tol)
+{
+  if(!a || !b)
+    return(false);
+  if(a->getContextStr() != b->getContextStr())
+    return(false);
+  if(fabs(a->getPWT() - b->getPWT()) > tol)
+    return(false);
+
+  PDMap *amap = a->getPDMap();
+  PDMap *bmap = b->getPDMap();
+  if((amap->size() != bmap->size()) || (a->getDim() != b->getDim()))
+    return(false);
+  if(amap->getDomain().getVarName(0) != bmap->getDomain().getVarName(0))
+    return(false);
+
+  int dim = a->getDim();
+  for(int i=0; i<amap->size(); i++) {
+    IvPBox *abox = amap->bx(i);
+    IvPBox *bbox = bmap->bx(i);
+    for(int d=0; d<dim; d++) {
+      for(int e=0; e<2; e++) {
+	if((abox->pt(d,e) != bbox->pt(d,e)) || (abox->bd(d,e) != bbox->bd(d,e)))
+	  return(false);
+      }
+    }
+    for(int j=0; j<abox->getWtc(); j++)
+      if(fabs(abox->wt(j) - bbox->wt(j)) > tol)
+	return(false);
+  }
+  return(true);
+}
+
+//--------------------------------------------------------
+// Procedure: sweep()
+//   Purpose: A drifting gaussian encoded with deltas. Every string is
+//            resolved and decoded on the receiving side and compared
+//            to the ascii encoding of the same function. One delta
+//            is dropped along the way, and the next delta from that
+//            source must then fail to resolve rather than decode to
+//            the wrong function.
+//   Returns: The number of failed checks
+
+unsigned int sweep(unsigned int cases)
+{
+  IPFBinCoder encoder;
+  encoder.setKeyGap(8);
+  IPFBinCoder decoder;
+
+  unsigned int bad = 0;
+  unsigned int pcs = 100;
+  double xc = 0;
+  double yc = 0;
+  bool   dropped = false;
+  for(unsigned int k=0; k<cases; k++) {
+    xc += (rand() % 5) - 2;
+    yc += (rand() % 5) - 2;
+    if((rand() % 10) == 0)
+      pcs = 50 + (rand() % 200);
+    IvPFunction *ipf = buildIPF(xc, yc, 5 + (rand() % 20), pcs, k);
+
+    string bin_str = encoder.encode(ipf);
+    IvPFunction *ascii_ipf = StringToIvPFunction(IvPFunctionToString(ipf));
+
+    if((k == cases/2) && isBinIPFDelta(bin_str)) {
+      dropped = true;
+      delete(ipf);
+      delete(ascii_ipf);
+      continue;
+    }
+
+    string key_str = decoder.resolve(bin_str);
+    if(dropped && isBinIPFDelta(bin_str)) {
+      if(key_str != "")
+	bad++;
+    }
+    else {
+      IvPFunction *bin_ipf = StringToIvPFunction(key_str);
+      if(!sameIPF(bin_ipf, ascii_ipf, 1e-9))
+	bad++;
+      if(!sameIPF(bin_ipf, ipf, 0.00005))
+	bad++;
+      if(StringToIvPContext(bin_str) != ipf->getContextStr())
+	bad++;
+      delete(bin_ipf);
+    }
+    if(!isBinIPFDelta(bin_str))
+      dropped = false;
+
+    delete(ipf);
+    delete(ascii_ipf);
+  }
+  if((encoder.getDeltaCount() == 0) || (encoder.getKeyCount() == 0))
+    bad++;
+  return(bad);
+}
+
+//--------------------------------------------------------
+// Procedure: main
+
+int main(int argc, char** argv)
+{
+  double xc = 0;
+  double yc = 0;
+  double sigma = 10;
+  int    pcs   = 100;
+  int    cases = 0;
+
+  for(int i=1; i<argc; i++) {
+    string argi = argv[i];
+    if(strBegins(argi, "xc="))
+      setDoubleOnString(xc, argi.substr(3));
+    else if(strBegins(argi, "yc="))
+      setDoubleOnString(yc, argi.substr(3));
+    else if(strBegins(argi, "sigma="))
+      setDoubleOnString(sigma, argi.substr(6));
+    else if(strBegins(argi, "pcs="))
+      pcs = atoi(argi.substr(4).c_str());
+    else if(strBegins(argi, "sweep="))
+      cases = atoi(argi.substr(6).c_str());
+
+    else if((argi=="-h") || (argi=="--help")) {
+      cout << "testIPFEncoding: test the binary IPF encoding" << endl;
+      cout << "Example:                                              " << endl;
+      cout << "$ testIPFEncoding xc=10 yc=-5 sigma=10 pcs=100" << endl;
+      cout << "pcs=100,same=true,smaller=true" << endl;
+      cout << "$ testIPFEncoding sweep=100" << endl;
+      cout << "bad=0" << endl;
+      return(0);
+    }
+    else if(strBegins(argi, "id="))
+      argi = "just ignore id fields";
+    else {
+      cout << "Error: arg[" << argi << "] Exiting." << endl;
+      return(1);
+    }
+  }
+
+  if(cases > 0) {
+    cout << "bad=" << sweep(cases);
+    return(0);
+  }
+
+  IvPFunction *ipf = buildIPF(xc, yc, sigma, pcs, 1);
+  if(!ipf) {
+    cout << "Unable to build the IvP function. Exiting." << endl;
+    return(1);
+  }
+
+  string ascii_str = IvPFunctionToString(ipf);
+  string bin_str   = IvPFunctionToBinString(ipf);
+
+  IvPFunction *ascii_ipf = StringToIvPFunction(ascii_str);
+  IvPFunction *bin_ipf   = StringToIvPFunction(bin_str);
+  bool same = sameIPF(ascii_ipf, bin_ipf, 1e-9);
+
+  cout << "pcs=" << ipf->size();
+  cout << ",same=" << boolToString(same);
+  cout << ",smaller=" << boolToString(bin_str.length() < ascii_str.length());
+
+  delete(ipf);
+  delete(ascii_ipf);
+  delete(bin_ipf);
+  return(0);
+}
@@ -0,0 +1,99 @@
+/*****************************************************************/
+/*    NAME: agent                                                */
+/*    FILE: main.cpp (testPointClusterer)                        */
+/*    DATE: Oct 19th, 2026                                       */
+/*****************************************************************/
+
+#include <iostream>
+#include <cstdlib>
+#include <vector>
+#include "MBUtils.h"
+#include "PointClusterer.h"
+
+using namespace std;
+
+int cmdLineErr(string msg) {cout << msg << endl; return(1);}
+
+//--------------------------------------------------------
+// Procedure: idsToString()
+
+string idsToString(const vector<unsigned int>& ids)
+{
+  string str;
+  for(unsigned int i=0; i<ids.size(); i++) {
+    if(i > 0)
+      str += ":";
+    str += uintToString(ids[i]);
+  }
+  if(str == "")
+    str = "none";
+  return(str);
+}
+
+//--------------------------------------------------------
+// Procedure: main
+//   Purpose: Arguments are applied in order. A line adds n
+//            evenly spaced points from (x1,y1) to (x2,y2) with
+//            time stamp utc. An update re-clusters at the given
+//            time, expiring points older than the max age. The
+//            final clusters, and the ids changed or removed on
+//            the last update, are reported.
+
+int main(int argc, char** argv)
+{
+  PointClusterer clusterer;
+
+  for(int i=1; i<argc; i++) {
+    string argi = argv[i];
+    if(strBegins(argi, "dist=")) {
+      if(!clusterer.setClusterDist(atof(argi.substr(5).c_str())))
+	return(cmdLineErr("Bad dist: " + argi));
+    }
+    else if(strBegins(argi, "min=")) {
+      if(!clusterer.setMinPoints(atoi(argi.substr(4).c_str())))
+	return(cmdLineErr("Bad min: " + argi));
+    }
+    else if(strBegins(argi, "line=")) {
+      // line=x1,y1,x2,y2,n,utc
+      vector<string> svector = parseString(argi.substr(5), ',');
+      if(svector.size() != 6)
+	return(cmdLineErr("Bad line: " + argi));
+      double x1  = atof(svector[0].c_str());
+      double y1  = atof(svector[1].c_str());
+      double x2  = atof(svector[2].c_str());
+      double y2  = atof(svector[3].c_str());
+      int    n   = atoi(svector[4].c_str());
+      double utc = atof(svector[5].c_str());
+      for(int j=0; j<n; j++) {
+	double pct = (n > 1) ? (double)(j) / (double)(n-1) : 0;
+	clusterer.addPoint(x1 + pct*(x2-x1), y1 + pct*(y2-y1), utc);
+      }
+    }
+    else if(strBegins(argi, "update=")) {
+      // update=curr_time,max_age
+      string curr_time = biteStringX(argi, ',');
+      curr_time = curr_time.substr(7);
+      clusterer.update(atof(curr_time.c_str()), atof(argi.c_str()));
+    }
+
+    else if((argi=="-h") || (argi=="--help")) {
+      cout << "testPointClusterer: incremental clustering of points" << endl;
+      cout << "Example:                                             " << endl;
+      cout << "$ testPointClusterer line=0,0,8,0,5,0 update=0,-1    " << endl;
+      cout << "clusters=1,ids=0,points=5,noise=0,changed=0,removed=none" << endl;
+      return(0);
+    }
+    else if(strBegins(argi, "id="))
+      argi = "just ignore id fields";
+    else
+      return(cmdLineErr("Error: arg[" + argi + "] Exiting."));
+  }
+
+  cout << "clusters=" << clusterer.size();
+  cout << ",ids=" << idsToString(clusterer.getClusterIDs());
+  cout << ",points=" << clusterer.getPointCount();
+  cout << ",noise=" << clusterer.getNoiseCount();
+  cout << ",changed=" << idsToString(clusterer.getChangedClusters());
+  cout << ",removed=" << idsToString(clusterer.getRemovedClusters());
+  return(0);
+}
@@ -0,0 +1,138 @@
+/*****************************************************************/
+/*    NAME: agent                                                */
+/*    FILE: main.cpp (testReflectorThreads)                      */
+/*    DATE: Oct 19th, 2026                                       */
+/*****************************************************************/
+
+#include <iostream>
+#include <cstdlib>
+#include "MBUtils.h"
+#include "BuildUtils.h"
+#include "AOF_Gaussian.h"
+#include "OF_Reflector.h"
+#include "IvPFunction.h"
+
+using namespace std;
+
+//--------------------------------------------------------
+// Procedure: buildIPF()
+//   Purpose: A gaussian over a 2D x,y domain built with the given
+//            reflector settings and number of threads. The smart
+//            stage queue picks leaves at random once full, so the
+//            random seed is the same for every build.
+
+IvPFunction *buildIPF(int degree, string piece, int smart, string strict,
+		      unsigned int threads, unsigned int& evals)
+{
+  IvPDomain domain = stringToDomain("x,-100,100,201:y,-100,100,201");
+  AOF_Gaussian aof(domain);
+  aof.setParam("xcent", 20);
+  aof.setParam("ycent", -35);
+  aof.setParam("sigma", 30);
+  aof.setParam("range", 100);
+
+  OF_Reflector reflector(&aof, degree);
+  reflector.setParam("uniform_piece", piece);
+  reflector.setParam("strict_range", strict);
+  if(smart > 0)
+    reflector.setParam("smart_amount", smart);
+  reflector.setParam("threads", threads);
+
+  srand(1);
+  reflector.create();
+  evals = reflector.getTotalEvals();
+  return(reflector.extractIvPFunction(false));
+}
+
+//--------------------------------------------------------
+// Procedure: samePieces()
+//   Purpose: True if two functions have exactly the same boxes
+//            with exactly the same weights, in the same order.
+
+bool samePieces(IvPFunction *a, IvPFunction *b)
+{
+  if(!a || !b)
+    return(false);
+
+  PDMap *amap = a->getPDMap();
+  PDMap *bmap = b->getPDMap();
+  if((amap->size() != bmap->size()) || (a->getDim() != b->getDim()))
+    return(false);
+
+  int dim = a->getDim();
+  for(int i=0; i<amap->size(); i++) {
+    IvPBox *abox = amap->bx(i);
+    IvPBox *bbox = bmap->bx(i);
+    for(int d=0; d<dim; d++) {
+      for(int e=0; e<2; e++) {
+	if((abox->pt(d,e) != bbox->pt(d,e)) || (abox->bd(d,e) != bbox->bd(d,e)))
+	  return(false);
+      }
+    }
+    if(abox->getWtc() != bbox->getWtc())
+      return(false);
+    for(int j=0; j<abox->getWtc(); j++)
+      if(abox->wt(j) != bbox->wt(j))
+	return(false);
+  }
+  return(true);
+}
+
+//--------------------------------------------------------
+// Procedure: main
+
+int main(int argc, char** argv)
+{
+  int    degree  = 1;
+  int    smart   = 0;
+  int    threads = 4;
+  string piece   = "discrete@x:5,y:5";
+  string strict  = "true";
+
+  for(int i=1; i<argc; i++) {
+    string argi = argv[i];
+    if(strBegins(argi, "degree="))
+      degree = atoi(argi.substr(7).c_str());
+    else if(strBegins(argi, "smart="))
+      smart = atoi(argi.substr(6).c_str());
+    else if(strBegins(argi, "threads="))
+      threads = atoi(argi.substr(8).c_str());
+    else if(strBegins(argi, "piece="))
+      piece = argi.substr(6);
+    else if(strBegins(argi, "strict="))
+      strict = argi.substr(7);
+
+    else if((argi=="-h") || (argi=="--help")) {
+      cout << "testReflectorThreads: compare threaded and serial builds" << endl;
+      cout << "Example:                                              " << endl;
+      cout << "$ testReflectorThreads degree=1 piece=discrete@x:1,y:1 threads=4" << endl;
+      cout << "pcs=40401,same=true,evals=true" << endl;
+      return(0);
+    }
+    else if(strBegins(argi, "id="))
+      argi = "just ignore id fields";
+    else {
+      cout << "Error: arg[" << argi << "] Exiting." << endl;
+      return(1);
+    }
+  }
+
+  unsigned int serial_evals = 0;
+  unsigned int thread_evals = 0;
+  IvPFunction *serial_ipf = buildIPF(degree, piece, smart, strict, 1,
+					serial_evals);
+  IvPFunction *thread_ipf = buildIPF(degree, piece, smart, strict, threads,
+				     thread_evals);
+  if(!serial_ipf || !thread_ipf) {
+    cout << "Unable to build the IvP function. Exiting." << endl;
+    return(1);
+  }
+
+  cout << "pcs=" << serial_ipf->size();
+  cout << ",same=" << boolToString(samePieces(serial_ipf, thread_ipf));
+  cout << ",evals=" << boolToString(serial_evals == thread_evals);
+
+  delete(serial_ipf);
+  delete(thread_ipf);
+  return(0);
+}